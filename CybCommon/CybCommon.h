@@ -30,6 +30,13 @@
     #define CYBAPI extern
 #endif
 
+//Inline Functions
+#ifdef _MSC_VER
+    #define CYB_INLINE static __inline
+#else
+    #define CYB_INLINE static inline
+#endif
+
 //TRUE and FALSE (some compilers don't define these)
 #ifndef TRUE
     #define TRUE  1
@@ -6,8 +6,16 @@ LOCAL_C_INCLUDES := \
     ../CybCommon
 LOCAL_SRC_FILES := \
     src/CybBox.c \
+    src/CybBroadPhase.c \
+    src/CybBVH.c \
+    src/CybFastMath.c \
+    src/CybFrustum.c \
     src/CybMatrix.c \
+    src/CybNoise.c \
+    src/CybOBB.c \
     src/CybQuat.c \
+    src/CybRandom.c \
+    src/CybRay.c \
     src/CybSphere.c \
     src/CybVec.c
 LOCAL_LDFLAGS += \
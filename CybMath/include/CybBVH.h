@@ -0,0 +1,133 @@
+#ifndef CYBBVH_H
+#define CYBBVH_H
+
+/** @file
+ * @brief CybMath - Bounding Volume Hierarchy API
+ */
+ 
+#include "CybCommon.h"
+#include "CybBox.h"
+#include "CybRay.h"
+#include "CybVec.h"
+
+ 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Types
+//=================================================================================
+/** @brief Bounding volume hierarchy.
+ *
+ * Nodes are stored in a single array in depth-first order. The left child of
+ * a node always follows its parent, so a traversal mostly walks forward
+ * through memory.
+ */
+typedef struct Cyb_BVH Cyb_BVH;
+
+/** @brief Exact ray test callback used by closest-hit queries.
+ *
+ * @param data User data passed to the query.
+ * @param index Index of the item whose box was hit.
+ * @param ray Pointer to the ray.
+ * @param t Pointer to the distance. On entry it holds the distance to the
+ * item's box. Set it to the exact hit distance if the item is hit.
+ *
+ * @return TRUE if the item is hit.
+ */
+typedef int (*Cyb_BVHRayProc)(void *data, int index, const Cyb_Ray *ray, 
+    float *t);
+
+
+//Functions
+//=================================================================================
+/** @brief Build a bounding volume hierarchy using the surface area heuristic.
+ *
+ * @param boxes Pointer to the item boxes.
+ * @param count The number of boxes.
+ *
+ * @return Pointer to the new hierarchy or NULL if out of memory.
+ */
+CYBAPI Cyb_BVH *Cyb_CreateBVH(const Cyb_Box *boxes, int count);
+
+/** @brief Free a bounding volume hierarchy.
+ *
+ * @param bvh Pointer to the hierarchy.
+ */
+CYBAPI void Cyb_FreeBVH(Cyb_BVH *bvh);
+
+/** @brief Update the node bounds after the items have moved.
+ *
+ * The tree topology is kept, so query speed slowly degrades as items move
+ * far from where they were when the tree was built. Rebuild the tree when
+ * that happens.
+ *
+ * @param bvh Pointer to the hierarchy.
+ * @param boxes Pointer to the new item boxes. The count and order must match
+ * the boxes the hierarchy was built from.
+ */
+CYBAPI void Cyb_RefitBVH(Cyb_BVH *bvh, const Cyb_Box *boxes);
+
+/** @brief Get the bounds of all items in a hierarchy.
+ *
+ * @param bvh Pointer to the hierarchy.
+ * @param box Pointer to the resulting box.
+ */
+CYBAPI void Cyb_GetBVHBounds(const Cyb_BVH *bvh, Cyb_Box *box);
+
+/** @brief Find all items that intersect a given box.
+ *
+ * @param bvh Pointer to the hierarchy.
+ * @param box Pointer to the box.
+ * @param hits Pointer to an array which receives the item indices.
+ * @param maxHits The size of the array.
+ *
+ * @return The total number of items hit. Only the first maxHits are stored.
+ */
+CYBAPI int Cyb_QueryBVH(const Cyb_BVH *bvh, const Cyb_Box *box, int *hits, 
+    int maxHits);
+
+/** @brief Find all items whose boxes are hit by a ray.
+ *
+ * @param bvh Pointer to the hierarchy.
+ * @param ray Pointer to the ray.
+ * @param maxDist The maximum distance along the ray.
+ * @param hits Pointer to an array which receives the item indices.
+ * @param maxHits The size of the array.
+ *
+ * @return The total number of items hit. Only the first maxHits are stored.
+ */
+CYBAPI int Cyb_RayCastBVH(const Cyb_BVH *bvh, const Cyb_Ray *ray, 
+    float maxDist, int *hits, int maxHits);
+
+/** @brief Find the closest item hit by a ray.
+ *
+ * Nodes are visited front to back and skipped once they are further away
+ * than the closest hit found so far.
+ *
+ * @param bvh Pointer to the hierarchy.
+ * @param ray Pointer to the ray.
+ * @param maxDist The maximum distance along the ray.
+ * @param proc Exact ray test for the items or NULL to use the item boxes.
+ * @param data User data passed to the callback.
+ * @param t Pointer to a float which receives the hit distance. May be NULL.
+ *
+ * @return The index of the closest item or -1 if nothing was hit.
+ */
+CYBAPI int Cyb_RayClosestBVH(const Cyb_BVH *bvh, const Cyb_Ray *ray, 
+    float maxDist, Cyb_BVHRayProc proc, void *data, float *t);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -40,9 +40,11 @@ typedef struct
 /** @brief Calculate the smallest box that some given geometry will fit into.
  *
  * @param box Pointer to the resulting box.
- * @param verts Pointer to some vertex data.
+ * @param verts Pointer to some vertex data. Each vertex must start with its
+ * position.
  * @param stride The size of each vertex.
- * @param count The number of vertices.
+ * @param count The number of vertices. If 0 the box is empty and centered at
+ * the origin.
  */
 CYBAPI void Cyb_BoxFromGeometry(Cyb_Box *box, void *verts, int stride, int count);
 
@@ -0,0 +1,197 @@
+#ifndef CYBBROADPHASE_H
+#define CYBBROADPHASE_H
+
+/** @file
+ * @brief CybMath - Broad Phase API
+ */
+
+#include "CybCommon.h"
+#include "CybBox.h"
+#include "CybSphere.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Types
+//=================================================================================
+/** @brief Spatial hash broad phase.
+ *
+ * Objects are stored in every grid cell their box touches. Cells are hashed
+ * into a fixed number of buckets, so the grid is unbounded and only occupied
+ * cells use memory. Works best when the cell size is close to the size of a
+ * typical object.
+ */
+typedef struct Cyb_SpatialHash Cyb_SpatialHash;
+
+/** @brief Sort and sweep broad phase.
+ *
+ * Objects are kept sorted by the lower bound of their boxes along one axis.
+ * The order is reused between updates, so objects that move a little each
+ * frame are re-sorted in close to linear time.
+ */
+typedef struct Cyb_SweepAndPrune Cyb_SweepAndPrune;
+
+
+//Structures
+//=================================================================================
+/** @brief A pair of potentially colliding objects.
+ */
+typedef struct
+{
+    int a; /**< The first object ID. Always less than b. */
+    int b; /**< The second object ID. */
+} Cyb_Pair;
+
+
+//Functions
+//=================================================================================
+/** @brief Create a new spatial hash.
+ *
+ * @param cellSize The size of each grid cell.
+ *
+ * @return Pointer to the spatial hash or NULL if out of memory.
+ */
+CYBAPI Cyb_SpatialHash *Cyb_CreateSpatialHash(float cellSize);
+
+/** @brief Free a spatial hash.
+ *
+ * @param hash Pointer to the spatial hash.
+ */
+CYBAPI void Cyb_FreeSpatialHash(Cyb_SpatialHash *hash);
+
+/** @brief Insert or move an object in a spatial hash.
+ *
+ * Objects that stay within the same cells are updated without touching the
+ * grid.
+ *
+ * @param hash Pointer to the spatial hash.
+ * @param id The object ID. IDs are array indices, so keep them small.
+ * @param box Pointer to the object's box.
+ *
+ * @return CYB_NO_ERROR on success or CYB_ERROR if out of memory.
+ */
+CYBAPI int Cyb_SetSpatialHashBox(Cyb_SpatialHash *hash, int id,
+    const Cyb_Box *box);
+
+/** @brief Insert or move an object in a spatial hash using its bounding sphere.
+ *
+ * @param hash Pointer to the spatial hash.
+ * @param id The object ID.
+ * @param sphere Pointer to the object's sphere.
+ *
+ * @return CYB_NO_ERROR on success or CYB_ERROR if out of memory.
+ */
+CYBAPI int Cyb_SetSpatialHashSphere(Cyb_SpatialHash *hash, int id,
+    const Cyb_Sphere *sphere);
+
+/** @brief Insert or move many objects in a spatial hash.
+ *
+ * @param hash Pointer to the spatial hash.
+ * @param boxes Pointer to the boxes. Box n is stored as object ID n.
+ * @param count The number of boxes.
+ *
+ * @return CYB_NO_ERROR on success or CYB_ERROR if out of memory.
+ */
+CYBAPI int Cyb_UpdateSpatialHash(Cyb_SpatialHash *hash, const Cyb_Box *boxes,
+    int count);
+
+/** @brief Remove an object from a spatial hash.
+ *
+ * @param hash Pointer to the spatial hash.
+ * @param id The object ID.
+ */
+CYBAPI void Cyb_RemoveSpatialHashObject(Cyb_SpatialHash *hash, int id);
+
+/** @brief Find all pairs of overlapping objects in a spatial hash.
+ *
+ * Each pair is reported once and only if the boxes overlap according to the
+ * same rules as Cyb_BoxHitBox.
+ *
+ * @param hash Pointer to the spatial hash.
+ * @param pairs Pointer to an array which receives the pairs.
+ * @param maxPairs The size of the array.
+ *
+ * @return The total number of pairs found. Only the first maxPairs are stored.
+ */
+CYBAPI int Cyb_FindSpatialHashPairs(Cyb_SpatialHash *hash, Cyb_Pair *pairs,
+    int maxPairs);
+
+/** @brief Find all objects in a spatial hash that overlap a given box.
+ *
+ * @param hash Pointer to the spatial hash.
+ * @param box Pointer to the box.
+ * @param hits Pointer to an array which receives the object IDs.
+ * @param maxHits The size of the array.
+ *
+ * @return The total number of objects found. Only the first maxHits are
+ * stored.
+ */
+CYBAPI int Cyb_QuerySpatialHash(Cyb_SpatialHash *hash, const Cyb_Box *box,
+    int *hits, int maxHits);
+
+/** @brief Create a new sort and sweep broad phase.
+ *
+ * @return Pointer to the broad phase or NULL if out of memory.
+ */
+CYBAPI Cyb_SweepAndPrune *Cyb_CreateSweepAndPrune(void);
+
+/** @brief Free a sort and sweep broad phase.
+ *
+ * @param sap Pointer to the broad phase.
+ */
+CYBAPI void Cyb_FreeSweepAndPrune(Cyb_SweepAndPrune *sap);
+
+/** @brief Update the objects in a sort and sweep broad phase.
+ *
+ * The sweep axis is chosen by the spread of the object centers. Objects are
+ * added or removed when the count changes.
+ *
+ * @param sap Pointer to the broad phase.
+ * @param boxes Pointer to the boxes. Box n is stored as object ID n.
+ * @param count The number of boxes.
+ *
+ * @return CYB_NO_ERROR on success or CYB_ERROR if out of memory.
+ */
+CYBAPI int Cyb_UpdateSweepAndPrune(Cyb_SweepAndPrune *sap,
+    const Cyb_Box *boxes, int count);
+
+/** @brief Update the objects in a sort and sweep broad phase using their
+ * bounding spheres.
+ *
+ * @param sap Pointer to the broad phase.
+ * @param spheres Pointer to the spheres. Sphere n is stored as object ID n.
+ * @param count The number of spheres.
+ *
+ * @return CYB_NO_ERROR on success or CYB_ERROR if out of memory.
+ */
+CYBAPI int Cyb_UpdateSweepAndPruneSpheres(Cyb_SweepAndPrune *sap,
+    const Cyb_Sphere *spheres, int count);
+
+/** @brief Find all pairs of overlapping objects in a sort and sweep broad
+ * phase.
+ *
+ * @param sap Pointer to the broad phase.
+ * @param pairs Pointer to an array which receives the pairs.
+ * @param maxPairs The size of the array.
+ *
+ * @return The total number of pairs found. Only the first maxPairs are stored.
+ */
+CYBAPI int Cyb_FindSweepAndPrunePairs(const Cyb_SweepAndPrune *sap,
+    Cyb_Pair *pairs, int maxPairs);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
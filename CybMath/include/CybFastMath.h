@@ -0,0 +1,210 @@
+#ifndef CYBFASTMATH_H
+#define CYBFASTMATH_H
+
+/** @file
+ * @brief CybMath - Fast Math API
+ *
+ * Polynomial approximations of the trigonometric functions and a fast
+ * reciprocal square root. The scalar functions use the same 4-lane kernels as
+ * the array functions, so both give identical results. Angles are in radians.
+ *
+ * Precision (measured against double precision libm):
+ * - sine and cosine: absolute error below 1e-7 for |x| <= 8192
+ * - arc cosine: absolute error below 4e-7 for -1 <= x <= 1
+ * - reciprocal square root: relative error below 1e-6
+ */
+
+#include "CybCommon.h"
+#include "CybSIMD.h"
+#include "CybVec.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Functions
+//=================================================================================
+/** @brief Compute the sine and cosine of 4 angles at once.
+ *
+ * @param x The angles.
+ * @param c Pointer to the resulting cosines.
+ *
+ * @return The sines.
+ */
+CYB_INLINE Cyb_F4 Cyb_F4SinCos(Cyb_F4 x, Cyb_F4 *c)
+{
+    //Reduce to [-pi/4, pi/4] in 3 steps to keep the low bits of pi/2
+    Cyb_F4 q = Cyb_F4Round(Cyb_F4Mul(x, Cyb_F4Set1(.636619772f)));
+    Cyb_F4 r = Cyb_F4MulAdd(q, Cyb_F4Set1(-1.5703125f), x);
+    r = Cyb_F4MulAdd(q, Cyb_F4Set1(-4.83751297e-4f), r);
+    r = Cyb_F4MulAdd(q, Cyb_F4Set1(-7.54978995e-8f), r);
+    Cyb_F4 r2 = Cyb_F4Mul(r, r);
+
+    //Minimax polynomials for sine and cosine
+    Cyb_F4 s = Cyb_F4MulAdd(Cyb_F4Set1(-1.9515295891e-4f), r2,
+        Cyb_F4Set1(8.3321608736e-3f));
+    s = Cyb_F4MulAdd(s, r2, Cyb_F4Set1(-1.6666654611e-1f));
+    s = Cyb_F4MulAdd(Cyb_F4Mul(s, r2), r, r);
+    Cyb_F4 k = Cyb_F4MulAdd(Cyb_F4Set1(2.443315711809948e-5f), r2,
+        Cyb_F4Set1(-1.388731625493765e-3f));
+    k = Cyb_F4MulAdd(k, r2, Cyb_F4Set1(4.166664568298827e-2f));
+    k = Cyb_F4MulAdd(Cyb_F4Mul(k, r2), r2,
+        Cyb_F4MulAdd(Cyb_F4Set1(-.5f), r2, Cyb_F4Set1(1.0f)));
+
+    //The quadrant is q mod 4, recovered from the fraction of q / 4 which is
+    //one of 0, .25, +-.5 or -.25
+    Cyb_F4 f = Cyb_F4Mul(q, Cyb_F4Set1(.25f));
+    f = Cyb_F4Sub(f, Cyb_F4Round(f));
+    Cyb_F4 absF = Cyb_F4Abs(f);
+    Cyb_F4 swap = Cyb_F4And(Cyb_F4CmpGt(absF, Cyb_F4Set1(.125f)),
+        Cyb_F4CmpLt(absF, Cyb_F4Set1(.375f)));
+    Cyb_F4 negSin = Cyb_F4Or(Cyb_F4CmpLt(f, Cyb_F4Set1(-.125f)),
+        Cyb_F4CmpGt(f, Cyb_F4Set1(.375f)));
+    Cyb_F4 negCos = Cyb_F4Or(Cyb_F4CmpGt(f, Cyb_F4Set1(.125f)),
+        Cyb_F4CmpLt(f, Cyb_F4Set1(-.375f)));
+    Cyb_F4 sinR = Cyb_F4Select(swap, k, s);
+    Cyb_F4 cosR = Cyb_F4Select(swap, s, k);
+    *c = Cyb_F4Select(negCos, Cyb_F4Sub(Cyb_F4Set1(0.0f), cosR), cosR);
+    return Cyb_F4Select(negSin, Cyb_F4Sub(Cyb_F4Set1(0.0f), sinR), sinR);
+}
+
+/** @brief Compute the arc cosine of 4 values at once.
+ *
+ * @param x The values. Must be in [-1, 1].
+ *
+ * @return The angles in [0, pi].
+ */
+CYB_INLINE Cyb_F4 Cyb_F4Acos(Cyb_F4 x)
+{
+    //Above .5 use acos(a) = 2 * asin(sqrt((1 - a) / 2)), below it use
+    //acos(a) = pi / 2 - asin(a)
+    Cyb_F4 half = Cyb_F4Set1(.5f);
+    Cyb_F4 a = Cyb_F4Abs(x);
+    Cyb_F4 big = Cyb_F4CmpGt(a, half);
+    Cyb_F4 z = Cyb_F4Select(big, Cyb_F4Mul(Cyb_F4Sub(Cyb_F4Set1(1.0f), a),
+        half), Cyb_F4Mul(a, a));
+    Cyb_F4 s = Cyb_F4Select(big, Cyb_F4Sqrt(z), a);
+
+    //Minimax polynomial for asin on [0, .5]
+    Cyb_F4 p = Cyb_F4MulAdd(Cyb_F4Set1(4.2163199048e-2f), z,
+        Cyb_F4Set1(2.4181311049e-2f));
+    p = Cyb_F4MulAdd(p, z, Cyb_F4Set1(4.5470025998e-2f));
+    p = Cyb_F4MulAdd(p, z, Cyb_F4Set1(7.4953002686e-2f));
+    p = Cyb_F4MulAdd(p, z, Cyb_F4Set1(1.6666752422e-1f));
+    p = Cyb_F4MulAdd(Cyb_F4Mul(p, z), s, s);
+
+    //Reflect negative values with acos(-a) = pi - acos(a)
+    Cyb_F4 r = Cyb_F4Select(big, Cyb_F4Add(p, p),
+        Cyb_F4Sub(Cyb_F4Set1(1.57079632679f), p));
+    return Cyb_F4Select(Cyb_F4CmpLt(x, Cyb_F4Set1(0.0f)),
+        Cyb_F4Sub(Cyb_F4Set1(3.14159265359f), r), r);
+}
+
+/** @brief Normalize 4 3D vectors stored as separate x, y, and z lanes.
+ *
+ * Zero length vectors are left unchanged.
+ *
+ * @param x Pointer to the x components.
+ * @param y Pointer to the y components.
+ * @param z Pointer to the z components.
+ */
+CYB_INLINE void Cyb_F4Normalize3(Cyb_F4 *x, Cyb_F4 *y, Cyb_F4 *z)
+{
+    Cyb_F4 len2 = Cyb_F4MulAdd(*x, *x, Cyb_F4MulAdd(*y, *y,
+        Cyb_F4Mul(*z, *z)));
+    Cyb_F4 one = Cyb_F4Set1(1.0f);
+    Cyb_F4 scale = Cyb_F4Select(Cyb_F4CmpGt(len2, Cyb_F4Set1(0.0f)),
+        Cyb_F4Rsqrt(len2), one);
+    *x = Cyb_F4Mul(*x, scale);
+    *y = Cyb_F4Mul(*y, scale);
+    *z = Cyb_F4Mul(*z, scale);
+}
+
+/** @brief Compute the sine and cosine of an angle.
+ *
+ * @param x The angle.
+ * @param s Pointer to the resulting sine.
+ * @param c Pointer to the resulting cosine.
+ */
+CYBAPI void Cyb_FastSinCos(float x, float *s, float *c);
+
+/** @brief Compute the arc cosine of a value.
+ *
+ * @param x The value. Values outside of [-1, 1] are clamped.
+ *
+ * @return The angle in [0, pi].
+ */
+CYBAPI float Cyb_FastAcos(float x);
+
+/** @brief Compute the reciprocal square root of a value.
+ *
+ * @param x The value. Must be greater than 0.
+ *
+ * @return 1 / sqrt(x)
+ */
+CYBAPI float Cyb_FastRsqrt(float x);
+
+/** @brief Normalize a 3D vector.
+ *
+ * Zero length vectors are left unchanged.
+ *
+ * @param v Pointer to the vector.
+ */
+CYBAPI void Cyb_FastNormalizeVec3(Cyb_Vec3 *v);
+
+/** @brief Normalize a 4D vector.
+ *
+ * Zero length vectors are left unchanged.
+ *
+ * @param v Pointer to the vector.
+ */
+CYBAPI void Cyb_FastNormalizeVec4(Cyb_Vec4 *v);
+
+/** @brief Compute the sine and cosine of an array of angles.
+ *
+ * @param x Pointer to the angles.
+ * @param s Pointer to the resulting sines. May be the same as x.
+ * @param c Pointer to the resulting cosines.
+ * @param count The number of angles.
+ */
+CYBAPI void Cyb_FastSinCosArray(const float *x, float *s, float *c,
+    int count);
+
+/** @brief Compute the arc cosine of an array of values.
+ *
+ * @param x Pointer to the values. Values outside of [-1, 1] are clamped.
+ * @param y Pointer to the resulting angles. May be the same as x.
+ * @param count The number of values.
+ */
+CYBAPI void Cyb_FastAcosArray(const float *x, float *y, int count);
+
+/** @brief Compute the reciprocal square root of an array of values.
+ *
+ * @param x Pointer to the values.
+ * @param y Pointer to the results. May be the same as x.
+ * @param count The number of values.
+ */
+CYBAPI void Cyb_FastRsqrtArray(const float *x, float *y, int count);
+
+/** @brief Normalize an array of 3D vectors.
+ *
+ * @param v Pointer to the vectors.
+ * @param count The number of vectors.
+ */
+CYBAPI void Cyb_FastNormalizeVec3Array(Cyb_Vec3 *v, int count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifndef CYBFRUSTUM_H
+#define CYBFRUSTUM_H
+
+/** @file
+ * @brief CybMath - Frustum API
+ */
+
+#include "CybCommon.h"
+#include "CybBox.h"
+#include "CybMatrix.h"
+#include "CybSphere.h"
+#include "CybVec.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Enums
+//=================================================================================
+/** @brief Frustum plane indices.
+ */
+enum Cyb_FrustumPlane
+{
+    CYB_FRUSTUM_LEFT,   /**< Left plane. */
+    CYB_FRUSTUM_RIGHT,  /**< Right plane. */
+    CYB_FRUSTUM_BOTTOM, /**< Bottom plane. */
+    CYB_FRUSTUM_TOP,    /**< Top plane. */
+    CYB_FRUSTUM_NEAR,   /**< Near plane. */
+    CYB_FRUSTUM_FAR     /**< Far plane. */
+};
+
+//Structures
+//=================================================================================
+/** @brief A view frustum.
+ *
+ * Each plane is stored as (x, y, z, w) where (x, y, z) is the unit normal
+ * pointing into the frustum and w is the plane distance. A point p is on the
+ * inner side of a plane when dot(normal, p) + w >= 0.
+ */
+typedef struct
+{
+    Cyb_Vec4 planes[6]; /**< Frustum planes. */
+} Cyb_Frustum;
+
+
+//Functions
+//=================================================================================
+/** @brief Extract the frustum planes from a view-projection matrix.
+ *
+ * @param frustum Pointer to the resulting frustum.
+ * @param m Pointer to the combined projection * view matrix. A projection
+ * matrix alone yields a frustum in view space and a projection * view * model
+ * matrix yields a frustum in model space.
+ */
+CYBAPI void Cyb_FrustumFromMatrix(Cyb_Frustum *frustum, const Cyb_Mat4 *m);
+
+/** @brief Test if a given point is inside a given frustum.
+ *
+ * @param a Pointer to the point.
+ * @param b Pointer to the frustum.
+ *
+ * @return TRUE if the point is inside the frustum.
+ */
+CYBAPI int Cyb_PointInFrustum(const Cyb_Vec3 *a, const Cyb_Frustum *b);
+
+/** @brief Test if a given sphere is inside or intersecting a given frustum.
+ *
+ * @param a Pointer to the sphere.
+ * @param b Pointer to the frustum.
+ *
+ * @return TRUE if the sphere is at least partially inside the frustum.
+ */
+CYBAPI int Cyb_SphereInFrustum(const Cyb_Sphere *a, const Cyb_Frustum *b);
+
+/** @brief Test if a given box is inside or intersecting a given frustum.
+ *
+ * @param a Pointer to the box.
+ * @param b Pointer to the frustum.
+ *
+ * @return TRUE if the box is at least partially inside the frustum.
+ */
+CYBAPI int Cyb_BoxInFrustum(const Cyb_Box *a, const Cyb_Frustum *b);
+
+/** @brief Cull an array of spheres against a frustum.
+ *
+ * Spheres are tested 8 at a time using the 4-lane SIMD path.
+ *
+ * @param frustum Pointer to the frustum.
+ * @param spheres Pointer to the spheres.
+ * @param count The number of spheres.
+ * @param visible Pointer to a bit array of at least (count + 7) / 8 bytes. Bit
+ * (n % 8) of byte (n / 8) is set if sphere n is visible.
+ */
+CYBAPI void Cyb_CullSpheres(const Cyb_Frustum *frustum,
+    const Cyb_Sphere *spheres, int count, unsigned char *visible);
+
+/** @brief Cull an array of boxes against a frustum.
+ *
+ * Boxes are tested 8 at a time using the 4-lane SIMD path.
+ *
+ * @param frustum Pointer to the frustum.
+ * @param boxes Pointer to the boxes.
+ * @param count The number of boxes.
+ * @param visible Pointer to a bit array of at least (count + 7) / 8 bytes. Bit
+ * (n % 8) of byte (n / 8) is set if box n is visible.
+ */
+CYBAPI void Cyb_CullBoxes(const Cyb_Frustum *frustum, const Cyb_Box *boxes,
+    int count, unsigned char *visible);
+
+/** @brief Cull an array of spheres against a frustum and compact the results.
+ *
+ * @param frustum Pointer to the frustum.
+ * @param spheres Pointer to the spheres.
+ * @param count The number of spheres.
+ * @param indices Pointer to an array of at least count ints which receives the
+ * indices of the visible spheres in ascending order.
+ *
+ * @return The number of visible spheres.
+ */
+CYBAPI int Cyb_CullSpheresIndexed(const Cyb_Frustum *frustum,
+    const Cyb_Sphere *spheres, int count, int *indices);
+
+/** @brief Cull an array of boxes against a frustum and compact the results.
+ *
+ * @param frustum Pointer to the frustum.
+ * @param boxes Pointer to the boxes.
+ * @param count The number of boxes.
+ * @param indices Pointer to an array of at least count ints which receives the
+ * indices of the visible boxes in ascending order.
+ *
+ * @return The number of visible boxes.
+ */
+CYBAPI int Cyb_CullBoxesIndexed(const Cyb_Frustum *frustum,
+    const Cyb_Box *boxes, int count, int *indices);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
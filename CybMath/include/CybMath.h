@@ -6,9 +6,20 @@
  */
 
 #include "CybBox.h"
+#include "CybBroadPhase.h"
+#include "CybBVH.h"
+#include "CybFastMath.h"
+#include "CybFrustum.h"
+#include "CybMathInline.h"
 #include "CybMatrix.h"
+#include "CybNoise.h"
+#include "CybOBB.h"
 #include "CybQuat.h"
+#include "CybRandom.h"
+#include "CybRay.h"
+#include "CybSIMD.h"
 #include "CybSphere.h"
 #include "CybVec.h"
+#include "CybWide.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,406 @@
+#ifndef CYBMATHINLINE_H
+#define CYBMATHINLINE_H
+
+/** @file
+ * @brief CybMath - Inline API
+ *
+ * Header-only versions of the vector, matrix, and quaternion functions that
+ * are small enough to benefit from inlining. Each Cyb_InlineX function has the
+ * same behavior as the exported Cyb_X function, which simply wraps it.
+ *
+ * Define CYB_MATH_INLINE before including any CybMath header to replace the
+ * exported functions with the inline versions in the including code. The
+ * exported symbols remain available for code that doesn't opt in.
+ */
+
+#include "CybCommon.h"
+#include "CybMatrix.h"
+#include "CybQuat.h"
+#include "CybSIMD.h"
+#include "CybVec.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Functions
+//=================================================================================
+/** @brief Inline version of Cyb_AddVec2. */
+CYB_INLINE void Cyb_InlineAddVec2(Cyb_Vec2 *c, const Cyb_Vec2 *a,
+    const Cyb_Vec2 *b)
+{
+    c->x = a->x + b->x;
+    c->y = a->y + b->y;
+}
+
+/** @brief Inline version of Cyb_SubVec2. */
+CYB_INLINE void Cyb_InlineSubVec2(Cyb_Vec2 *c, const Cyb_Vec2 *a,
+    const Cyb_Vec2 *b)
+{
+    c->x = a->x - b->x;
+    c->y = a->y - b->y;
+}
+
+/** @brief Inline version of Cyb_MulVec2. */
+CYB_INLINE void Cyb_InlineMulVec2(Cyb_Vec2 *c, const Cyb_Vec2 *a,
+    const Cyb_Vec2 *b)
+{
+    c->x = a->x * b->x;
+    c->y = a->y * b->y;
+}
+
+/** @brief Inline version of Cyb_DivVec2. */
+CYB_INLINE void Cyb_InlineDivVec2(Cyb_Vec2 *c, const Cyb_Vec2 *a,
+    const Cyb_Vec2 *b)
+{
+    c->x = a->x / b->x;
+    c->y = a->y / b->y;
+}
+
+/** @brief Inline version of Cyb_AddVec3. */
+CYB_INLINE void Cyb_InlineAddVec3(Cyb_Vec3 *c, const Cyb_Vec3 *a,
+    const Cyb_Vec3 *b)
+{
+    c->x = a->x + b->x;
+    c->y = a->y + b->y;
+    c->z = a->z + b->z;
+}
+
+/** @brief Inline version of Cyb_SubVec3. */
+CYB_INLINE void Cyb_InlineSubVec3(Cyb_Vec3 *c, const Cyb_Vec3 *a,
+    const Cyb_Vec3 *b)
+{
+    c->x = a->x - b->x;
+    c->y = a->y - b->y;
+    c->z = a->z - b->z;
+}
+
+/** @brief Inline version of Cyb_MulVec3. */
+CYB_INLINE void Cyb_InlineMulVec3(Cyb_Vec3 *c, const Cyb_Vec3 *a,
+    const Cyb_Vec3 *b)
+{
+    c->x = a->x * b->x;
+    c->y = a->y * b->y;
+    c->z = a->z * b->z;
+}
+
+/** @brief Inline version of Cyb_DivVec3. */
+CYB_INLINE void Cyb_InlineDivVec3(Cyb_Vec3 *c, const Cyb_Vec3 *a,
+    const Cyb_Vec3 *b)
+{
+    c->x = a->x / b->x;
+    c->y = a->y / b->y;
+    c->z = a->z / b->z;
+}
+
+/** @brief Inline version of Cyb_Lerp. */
+CYB_INLINE void Cyb_InlineLerp(Cyb_Vec3 *c, const Cyb_Vec3 *a,
+    const Cyb_Vec3 *b, double progress)
+{
+    //Calculate increment
+    Cyb_Vec3 inc;
+    Cyb_InlineSubVec3(&inc, b, a);
+    inc.x *= progress;
+    inc.y *= progress;
+    inc.z *= progress;
+    
+    //Calculate current position
+    Cyb_InlineAddVec3(c, a, &inc);
+}
+
+/** @brief Inline version of Cyb_AddVec4. */
+CYB_INLINE void Cyb_InlineAddVec4(Cyb_Vec4 *c, const Cyb_Vec4 *a,
+    const Cyb_Vec4 *b)
+{
+    Cyb_F4Store(&c->x, Cyb_F4Add(Cyb_F4Load(&a->x), Cyb_F4Load(&b->x)));
+}
+
+/** @brief Inline version of Cyb_SubVec4. */
+CYB_INLINE void Cyb_InlineSubVec4(Cyb_Vec4 *c, const Cyb_Vec4 *a,
+    const Cyb_Vec4 *b)
+{
+    Cyb_F4Store(&c->x, Cyb_F4Sub(Cyb_F4Load(&a->x), Cyb_F4Load(&b->x)));
+}
+
+/** @brief Inline version of Cyb_MulVec4. */
+CYB_INLINE void Cyb_InlineMulVec4(Cyb_Vec4 *c, const Cyb_Vec4 *a,
+    const Cyb_Vec4 *b)
+{
+    Cyb_F4Store(&c->x, Cyb_F4Mul(Cyb_F4Load(&a->x), Cyb_F4Load(&b->x)));
+}
+
+/** @brief Inline version of Cyb_DivVec4. */
+CYB_INLINE void Cyb_InlineDivVec4(Cyb_Vec4 *c, const Cyb_Vec4 *a,
+    const Cyb_Vec4 *b)
+{
+    Cyb_F4Store(&c->x, Cyb_F4Div(Cyb_F4Load(&a->x), Cyb_F4Load(&b->x)));
+}
+
+/** @brief Inline version of Cyb_MulMat4.
+ *
+ * Works one column at a time, so c may be the same as a or b.
+ */
+CYB_INLINE void Cyb_InlineMulMat4(Cyb_Mat4 *c, const Cyb_Mat4 *a,
+    const Cyb_Mat4 *b)
+{
+    //Matrices are stored a column at a time, so each column of c is a sum of
+    //the columns of a scaled by one column of b
+    const float *bp = &b->a;
+    float *cp = &c->a;
+    Cyb_F4 col0 = Cyb_F4Load(&a->a);
+    Cyb_F4 col1 = Cyb_F4Load(&a->b);
+    Cyb_F4 col2 = Cyb_F4Load(&a->c);
+    Cyb_F4 col3 = Cyb_F4Load(&a->d);
+    
+    for(int j = 0; j < 4; j++)
+    {
+        Cyb_F4 r = Cyb_F4Mul(col0, Cyb_F4Set1(bp[j * 4]));
+        r = Cyb_F4MulAdd(col1, Cyb_F4Set1(bp[j * 4 + 1]), r);
+        r = Cyb_F4MulAdd(col2, Cyb_F4Set1(bp[j * 4 + 2]), r);
+        r = Cyb_F4MulAdd(col3, Cyb_F4Set1(bp[j * 4 + 3]), r);
+        Cyb_F4Store(&cp[j * 4], r);
+    }
+}
+
+/** @brief Inline version of Cyb_Transpose. */
+CYB_INLINE void Cyb_InlineTranspose(Cyb_Mat4 *out, const Cyb_Mat4 *in)
+{
+    out->a = in->a;
+    out->b = in->e;
+    out->c = in->i;
+    out->d = in->m;
+    
+    out->e = in->b;
+    out->f = in->f;
+    out->g = in->j;
+    out->h = in->n;
+    
+    out->i = in->c;
+    out->j = in->g;
+    out->k = in->k;
+    out->l = in->o;
+    
+    out->m = in->d;
+    out->n = in->h;
+    out->o = in->l;
+    out->p = in->p;
+}
+
+/** @brief Inline version of Cyb_Determinant.
+ *
+ * Based on the matrix determinant code in Assimp. Adapted to work with the
+ * Cybermals column-major matrices.
+ */
+CYB_INLINE float Cyb_InlineDeterminant(const Cyb_Mat4 *m)
+{
+    return m->a * m->f * m->k * m->p -
+        m->a * m->f * m->l * m->o +
+        m->a * m->g * m->l * m->n -
+        m->a * m->g * m->j * m->p +
+        m->a * m->h * m->j * m->o -
+        m->a * m->h * m->k * m->n -
+        m->b * m->g * m->l * m->m +
+        m->b * m->g * m->i * m->p -
+        m->b * m->h * m->i * m->o +
+        m->b * m->h * m->k * m->m -
+        m->b * m->e * m->k * m->p +
+        m->b * m->e * m->l * m->o +
+        m->c * m->h * m->i * m->n -
+        m->c * m->h * m->j * m->m +
+        m->c * m->e * m->j * m->p -
+        m->c * m->e * m->l * m->n +
+        m->c * m->f * m->l * m->m -
+        m->c * m->f * m->i * m->p -
+        m->d * m->e * m->j * m->o +
+        m->d * m->e * m->k * m->n -
+        m->d * m->f * m->k * m->m +
+        m->d * m->f * m->i * m->o -
+        m->d * m->g * m->i * m->n +
+        m->d * m->g * m->j * m->m;
+}
+
+/** @brief Inline version of Cyb_Invert.
+ *
+ * Based on the matrix inversion code in Assimp. Adapted to work with the
+ * Cybermals column-major matrices.
+ */
+CYB_INLINE void Cyb_InlineInvert(Cyb_Mat4 *out, const Cyb_Mat4 *in)
+{
+    //Calculate the determinant
+    const float det = Cyb_InlineDeterminant(in);
+    
+    if(det == 0.0f)
+    {
+        return;
+    }
+    
+    //Calculate the inverse determinant
+    const float invdet = 1.0f / det;
+    
+    //Calculate the inverse matrix
+    out->a = invdet * (in->f * (in->k * in->p - in->l * in->o) + in->g * (in->l * in->n - in->j * in->p) + in->h * (in->j * in->o - in->k * in->n));
+    out->b = -invdet * (in->b * (in->k *in->p - in->l * in->o) + in->c * (in->l * in->n - in->j * in->p) + in->d * (in->j * in->o - in->k * in->n));
+    out->c = invdet * (in->b * (in->g * in->p - in->h * in->o) + in->c * (in->h * in->n - in->f * in->p) + in->d * (in->f * in->o - in->g * in->n));
+    out->d = -invdet * (in->b * (in->g * in->l -in->h * in->k) + in->c * (in->h * in->j - in->f * in->l) + in->d * (in->f * in->k - in->g * in->j));
+    
+    out->e = -invdet * (in->e * (in->k * in->p - in->l * in->o) + in->g * (in->l * in->m - in->i * in->p) + in->h * (in->i * in->o - in->k * in->m));
+    out->f = invdet * (in->a * (in->k * in->p - in->l * in->o) + in->c * (in->l * in->m - in->i * in->p) + in->d * (in->i * in->o - in->k * in->m));
+    out->g = -invdet * (in->a * (in->g * in->p - in->h * in->o) + in->c * (in->h * in->m - in->e * in->p) + in->d *(in->e * in->o - in->g * in->m));
+    out->h = invdet * (in->a * (in->g * in->l - in->h * in->k) + in->c * (in->h * in->i - in->e * in->l) + in->d * (in->e * in->k - in->g * in->i));
+    
+    out->i = invdet * (in->e * (in->j * in->p - in->l * in->n) + in->f * (in->l * in->m - in->i * in->p) + in->h * (in->i * in->n - in->j * in->m));
+    out->j = -invdet * (in->a * (in->j * in->p - in->l * in->n) + in->b * (in->l * in->m - in->i * in->p) + in->d * (in->i * in->n - in->j * in->m));
+    out->k = invdet * (in->a * (in->f * in->p - in->h * in->n) + in->b * (in->h * in->m - in->e * in->p) + in->d * (in->e * in->n - in->f * in->m));
+    out->l = -invdet * (in->a * (in->f * in->l - in->h * in->j) + in->b * (in->h * in->i - in->e * in->l) + in->d * (in->e * in->j - in->f * in->i));
+    
+    out->m = -invdet * (in->e * (in->j * in->o - in->k * in->n) + in->f * (in->k * in->m - in->i * in->o) + in->g * (in->i * in->n - in->j * in->m));
+    out->n = invdet * (in->a * (in->j * in->o - in->k * in->n) + in->b * (in->k * in->m - in->i * in->o) + in->c * (in->i * in->n - in->j * in->m));
+    out->o = -invdet * (in->a * (in->f * in->o - in->g * in->n) + in->b * (in->g * in->m - in->e * in->o) + in->c * (in->e * in->n - in->f * in->m));
+    out->p = invdet * (in->a * (in->f * in->k - in->g * in->j) + in->b * (in->g * in->i - in->e * in->k) + in->c * (in->e * in->j - in->f * in->i));
+}
+
+/** @brief Inline version of Cyb_Transform. */
+CYB_INLINE void Cyb_InlineTransform(Cyb_Vec3 *c, const Cyb_Mat4 *a,
+    const Cyb_Vec3 *b)
+{
+    float x = b->x;
+    float y = b->y;
+    float z = b->z;
+    c->x = a->a * x + a->b * y + a->c * z + a->d;
+    c->y = a->e * x + a->f * y + a->g * z + a->h;
+    c->z = a->i * x + a->j * y + a->k * z + a->l;
+}
+
+/** @brief Inline version of Cyb_Identity. */
+CYB_INLINE void Cyb_InlineIdentity(Cyb_Mat4 *m)
+{
+    Cyb_F4 zero = Cyb_F4Set1(0.0f);
+    Cyb_F4Store(&m->a, zero);
+    Cyb_F4Store(&m->b, zero);
+    Cyb_F4Store(&m->c, zero);
+    Cyb_F4Store(&m->d, zero);
+    m->a = 1.0f;
+    m->f = 1.0f;
+    m->k = 1.0f;
+    m->p = 1.0f;
+}
+
+/** @brief Inline version of Cyb_Translate. */
+CYB_INLINE void Cyb_InlineTranslate(Cyb_Mat4 *m, float x, float y, float z)
+{
+    //Start with the identity matrix
+    Cyb_InlineIdentity(m);
+    
+    //Modify column 4
+    m->d = x;
+    m->h = y;
+    m->l = z;
+}
+
+/** @brief Inline version of Cyb_Scale. */
+CYB_INLINE void Cyb_InlineScale(Cyb_Mat4 *m, float x, float y, float z)
+{
+    //Start with the identity matrix
+    Cyb_InlineIdentity(m);
+    
+    //Modify first 3 diagonal values
+    m->a = x;
+    m->f = y;
+    m->k = z;
+}
+
+/** @brief Inline version of Cyb_MulQuat. */
+CYB_INLINE void Cyb_InlineMulQuat(Cyb_Vec4 *c, const Cyb_Vec4 *a,
+    const Cyb_Vec4 *b)
+{
+    float x = a->w * b->x + a->x * b->w + a->y * b->z - a->z * b->y;
+    float y = a->w * b->y - a->x * b->z + a->y * b->w + a->z * b->x;
+    float z = a->w * b->z + a->x * b->y - a->y * b->x + a->z * b->w;
+    float w = a->w * b->w - a->x * b->x - a->y * b->y - a->z * b->z;
+    c->x = x;
+    c->y = y;
+    c->z = z;
+    c->w = w;
+}
+
+/** @brief Inline version of Cyb_NormalizeQuat. */
+CYB_INLINE void Cyb_InlineNormalizeQuat(Cyb_Vec4 *quat)
+{
+    Cyb_F4 q = Cyb_F4Load(&quat->x);
+    float len2 = quat->x * quat->x + quat->y * quat->y + quat->z * quat->z +
+        quat->w * quat->w;
+    
+    //Zero length?
+    if(len2 == 0.0f)
+    {
+        return;
+    }
+    
+    Cyb_F4Store(&quat->x, Cyb_F4Mul(q, Cyb_F4Rsqrt(Cyb_F4Set1(len2))));
+}
+
+/** @brief Inline version of Cyb_QuatToMatrix. */
+CYB_INLINE void Cyb_InlineQuatToMatrix(Cyb_Mat4 *mat, const Cyb_Vec4 *quat)
+{
+    //Start with the identity matrix
+    Cyb_InlineIdentity(mat);
+    
+    //Row 1
+    mat->a = 1.0f - 2.0f * (quat->y * quat->y + quat->z * quat->z);
+    mat->b = 2.0f * (quat->x * quat->y - quat->w * quat->z);
+    mat->c = 2.0f * (quat->x * quat->z + quat->w * quat->y);
+    
+    //Row 2
+    mat->e = 2.0f * (quat->x * quat->y + quat->w * quat->z);
+    mat->f = 1.0f - 2.0f * (quat->x * quat->x + quat->z * quat->z);
+    mat->g = 2.0f * (quat->y * quat->z - quat->w * quat->x);
+    
+    //Row 3
+    mat->i = 2.0f * (quat->x * quat->z - quat->w * quat->y);
+    mat->j = 2.0f * (quat->y * quat->z + quat->w * quat->x);
+    mat->k = 1.0f - 2.0f * (quat->x * quat->x + quat->y * quat->y);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+//Replace the exported functions with the inline versions
+#ifdef CYB_MATH_INLINE
+    #define Cyb_AddVec2 Cyb_InlineAddVec2
+    #define Cyb_SubVec2 Cyb_InlineSubVec2
+    #define Cyb_MulVec2 Cyb_InlineMulVec2
+    #define Cyb_DivVec2 Cyb_InlineDivVec2
+    #define Cyb_AddVec3 Cyb_InlineAddVec3
+    #define Cyb_SubVec3 Cyb_InlineSubVec3
+    #define Cyb_MulVec3 Cyb_InlineMulVec3
+    #define Cyb_DivVec3 Cyb_InlineDivVec3
+    #define Cyb_Lerp Cyb_InlineLerp
+    #define Cyb_AddVec4 Cyb_InlineAddVec4
+    #define Cyb_SubVec4 Cyb_InlineSubVec4
+    #define Cyb_MulVec4 Cyb_InlineMulVec4
+    #define Cyb_DivVec4 Cyb_InlineDivVec4
+    #define Cyb_MulMat4 Cyb_InlineMulMat4
+    #define Cyb_Transpose Cyb_InlineTranspose
+    #define Cyb_Determinant Cyb_InlineDeterminant
+    #define Cyb_Invert Cyb_InlineInvert
+    #define Cyb_Transform Cyb_InlineTransform
+    #define Cyb_Identity Cyb_InlineIdentity
+    #define Cyb_Translate Cyb_InlineTranslate
+    #define Cyb_Scale Cyb_InlineScale
+    #define Cyb_MulQuat Cyb_InlineMulQuat
+    #define Cyb_NormalizeQuat Cyb_InlineNormalizeQuat
+    #define Cyb_QuatToMatrix Cyb_InlineQuatToMatrix
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,832 @@
+#ifndef CYBNOISE_H
+#define CYBNOISE_H
+
+/** @file
+ * @brief CybMath - Noise API
+ *
+ * Seeded gradient (simplex) and value noise in 2, 3, and 4 dimensions for
+ * procedural terrain, textures, and particle motion. The noise is
+ * deterministic: the same seed and coordinates give the same result on every
+ * platform up to floating point rounding. Results are in [-1, 1].
+ *
+ * The Cyb_F4 and Cyb_F8 functions evaluate 4 or 8 points at once. The scalar
+ * functions use the same 4-lane kernels, so all widths give identical
+ * results. Fractal Brownian motion (fBm) sums several octaves of noise and is
+ * available for single points, arrays of points, and whole images. Images
+ * are filled 8 samples at a time and may be split into bands of rows which
+ * are filled in parallel.
+ *
+ * Coordinates must stay below 2^31 after scaling by the frequency.
+ */
+
+#include "CybCommon.h"
+#include "CybSIMD.h"
+#include "CybVec.h"
+#include "CybWide.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Enums
+//=================================================================================
+/** @brief Noise types.
+ */
+typedef enum
+{
+    CYB_NOISE_SIMPLEX, /**< Simplex gradient noise. */
+    CYB_NOISE_VALUE    /**< Value noise with quintic interpolation. */
+} Cyb_NoiseType;
+
+
+//Structures
+//=================================================================================
+/** @brief Fractal Brownian motion parameters.
+ */
+typedef struct
+{
+    Cyb_NoiseType type; /**< The type of noise to sum. */
+    unsigned int seed;  /**< The seed. Each octave uses seed + octave. */
+    int octaves;        /**< The number of octaves. */
+    float frequency;    /**< The frequency of the first octave. */
+    float lacunarity;   /**< The frequency multiplier between octaves. */
+    float gain;         /**< The amplitude multiplier between octaves. */
+} Cyb_NoiseParams;
+
+
+//Functions
+//=================================================================================
+//Lattice hashing
+#define CYB_NOISE_PRIME_X ((int)0x9e3779b1u)
+#define CYB_NOISE_PRIME_Y ((int)0x85ebca77u)
+#define CYB_NOISE_PRIME_Z ((int)0xc2b2ae3du)
+#define CYB_NOISE_PRIME_W ((int)0x27d4eb2fu)
+
+//Simplex noise scales which map the largest possible sum to 1
+#define CYB_NOISE_SCALE_2 70.1f
+#define CYB_NOISE_SCALE_3 76.8f
+#define CYB_NOISE_SCALE_4 62.7f
+
+CYB_INLINE Cyb_I4 Cyb_NoiseSeed_(unsigned int seed)
+{
+    return Cyb_I4Set1((int)(seed * 0x632be5abu));
+}
+
+CYB_INLINE Cyb_I4 Cyb_NoiseHash_(Cyb_I4 h)
+{
+    h = Cyb_I4Mul(Cyb_I4Xor(h, Cyb_I4ShiftRight(h, 16)),
+        Cyb_I4Set1(0x7feb352d));
+    return Cyb_I4Xor(h, Cyb_I4ShiftRight(h, 15));
+}
+
+CYB_INLINE Cyb_I4 Cyb_NoiseStep_(Cyb_I4 h, Cyb_F4 mask, int prime)
+{
+    //Move to the next lattice point along an axis where mask is set
+    return Cyb_I4Add(h, Cyb_I4And(Cyb_F4AsI4(mask), Cyb_I4Set1(prime)));
+}
+
+CYB_INLINE Cyb_F4 Cyb_NoiseSign_(Cyb_I4 h, int bit)
+{
+    //Move a hash bit into the sign bit
+    return Cyb_I4AsF4(Cyb_I4And(Cyb_I4ShiftLeft(h, 31 - bit),
+        Cyb_F4AsI4(Cyb_F4Set1(-0.0f))));
+}
+
+CYB_INLINE Cyb_F4 Cyb_NoiseValue_(Cyb_I4 h)
+{
+    //Map the top 24 bits of a hash to [-1, 1]
+    return Cyb_F4MulAdd(Cyb_I4ToF4(Cyb_I4ShiftRight(h, 8)),
+        Cyb_F4Set1(1.0f / 8388608.0f), Cyb_F4Set1(-1.0f));
+}
+
+CYB_INLINE Cyb_F4 Cyb_NoiseFade_(Cyb_F4 t)
+{
+    //6t^5 - 15t^4 + 10t^3
+    Cyb_F4 f = Cyb_F4MulAdd(t, Cyb_F4Set1(6.0f), Cyb_F4Set1(-15.0f));
+    f = Cyb_F4MulAdd(f, t, Cyb_F4Set1(10.0f));
+    return Cyb_F4Mul(Cyb_F4Mul(Cyb_F4Mul(f, t), t), t);
+}
+
+CYB_INLINE Cyb_F4 Cyb_NoiseLerp_(Cyb_F4 a, Cyb_F4 b, Cyb_F4 t)
+{
+    return Cyb_F4MulAdd(Cyb_F4Sub(b, a), t, a);
+}
+
+//Gradients
+CYB_INLINE Cyb_F4 Cyb_NoiseGrad2_(Cyb_I4 h, Cyb_F4 x, Cyb_F4 y)
+{
+    //4 axes and 4 diagonals
+    Cyb_I4 one = Cyb_I4Set1(1);
+    Cyb_I4 two = Cyb_I4Set1(2);
+    Cyb_F4 swap = Cyb_I4CmpEq(Cyb_I4And(h, one), one);
+    Cyb_F4 u = Cyb_F4Select(swap, y, x);
+    Cyb_F4 v = Cyb_F4And(Cyb_F4Select(swap, x, y),
+        Cyb_I4CmpEq(Cyb_I4And(h, two), two));
+    return Cyb_F4Add(Cyb_F4Xor(u, Cyb_NoiseSign_(h, 2)),
+        Cyb_F4Xor(v, Cyb_NoiseSign_(h, 3)));
+}
+
+CYB_INLINE Cyb_F4 Cyb_NoiseGrad3_(Cyb_I4 h, Cyb_F4 x, Cyb_F4 y, Cyb_F4 z)
+{
+    //The 12 edges of a cube, with 4 of them repeated
+    Cyb_I4 h4 = Cyb_I4And(h, Cyb_I4Set1(15));
+    Cyb_F4 u = Cyb_F4Select(Cyb_I4CmpLt(h4, Cyb_I4Set1(8)), x, y);
+    Cyb_F4 xz = Cyb_F4Select(Cyb_F4Or(Cyb_I4CmpEq(h4, Cyb_I4Set1(12)),
+        Cyb_I4CmpEq(h4, Cyb_I4Set1(14))), x, z);
+    Cyb_F4 v = Cyb_F4Select(Cyb_I4CmpLt(h4, Cyb_I4Set1(4)), y, xz);
+    return Cyb_F4Add(Cyb_F4Xor(u, Cyb_NoiseSign_(h, 0)),
+        Cyb_F4Xor(v, Cyb_NoiseSign_(h, 1)));
+}
+
+CYB_INLINE Cyb_F4 Cyb_NoiseGrad4_(Cyb_I4 h, Cyb_F4 x, Cyb_F4 y, Cyb_F4 z,
+    Cyb_F4 w)
+{
+    //The 32 edges of a tesseract
+    Cyb_I4 h5 = Cyb_I4And(h, Cyb_I4Set1(31));
+    Cyb_F4 u = Cyb_F4Select(Cyb_I4CmpLt(h5, Cyb_I4Set1(24)), x, y);
+    Cyb_F4 v = Cyb_F4Select(Cyb_I4CmpLt(h5, Cyb_I4Set1(16)), y, z);
+    Cyb_F4 t = Cyb_F4Select(Cyb_I4CmpLt(h5, Cyb_I4Set1(8)), z, w);
+    return Cyb_F4Add(Cyb_F4Add(Cyb_F4Xor(u, Cyb_NoiseSign_(h, 0)),
+        Cyb_F4Xor(v, Cyb_NoiseSign_(h, 1))), Cyb_F4Xor(t, Cyb_NoiseSign_(h, 2)));
+}
+
+CYB_INLINE Cyb_F4 Cyb_NoiseFalloff_(Cyb_F4 d2)
+{
+    //(r^2 - d^2)^4 with r^2 = .5 keeps each corner inside its simplex
+    Cyb_F4 t = Cyb_F4Max(Cyb_F4Sub(Cyb_F4Set1(.5f), d2), Cyb_F4Set1(0.0f));
+    t = Cyb_F4Mul(t, t);
+    return Cyb_F4Mul(t, t);
+}
+
+/** @brief Compute 2D simplex noise at 4 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F4 Cyb_F4SimplexNoise2(Cyb_F4 x, Cyb_F4 y, unsigned int seed)
+{
+    const float G2 = .211324865405f;
+    Cyb_F4 one = Cyb_F4Set1(1.0f);
+    
+    //Skew to the simplex grid, find the cell, and unskew its origin
+    Cyb_F4 s = Cyb_F4Mul(Cyb_F4Add(x, y), Cyb_F4Set1(.366025403784f));
+    Cyb_F4 i = Cyb_F4Floor(Cyb_F4Add(x, s));
+    Cyb_F4 j = Cyb_F4Floor(Cyb_F4Add(y, s));
+    Cyb_F4 t = Cyb_F4Mul(Cyb_F4Add(i, j), Cyb_F4Set1(G2));
+    Cyb_F4 x0 = Cyb_F4Add(Cyb_F4Sub(x, i), t);
+    Cyb_F4 y0 = Cyb_F4Add(Cyb_F4Sub(y, j), t);
+    
+    //The middle corner depends on which half of the cell we are in
+    Cyb_F4 stepX = Cyb_F4CmpGt(x0, y0);
+    Cyb_F4 i1 = Cyb_F4And(stepX, one);
+    Cyb_F4 x1 = Cyb_F4Add(Cyb_F4Sub(x0, i1), Cyb_F4Set1(G2));
+    Cyb_F4 y1 = Cyb_F4Add(Cyb_F4Sub(y0, Cyb_F4Sub(one, i1)), Cyb_F4Set1(G2));
+    Cyb_F4 x2 = Cyb_F4Add(x0, Cyb_F4Set1(2.0f * G2 - 1.0f));
+    Cyb_F4 y2 = Cyb_F4Add(y0, Cyb_F4Set1(2.0f * G2 - 1.0f));
+    
+    //Hash the corners
+    Cyb_I4 hx = Cyb_I4Mul(Cyb_F4ToI4(i), Cyb_I4Set1(CYB_NOISE_PRIME_X));
+    Cyb_I4 hy = Cyb_I4Mul(Cyb_F4ToI4(j), Cyb_I4Set1(CYB_NOISE_PRIME_Y));
+    Cyb_I4 h0 = Cyb_I4Xor(Cyb_NoiseSeed_(seed), Cyb_I4Xor(hx, hy));
+    Cyb_I4 h1 = Cyb_I4Xor(Cyb_NoiseSeed_(seed), Cyb_I4Xor(
+        Cyb_NoiseStep_(hx, stepX, CYB_NOISE_PRIME_X),
+        Cyb_NoiseStep_(hy, Cyb_F4CmpLe(x0, y0), CYB_NOISE_PRIME_Y)));
+    Cyb_I4 h2 = Cyb_I4Xor(Cyb_NoiseSeed_(seed), Cyb_I4Xor(
+        Cyb_I4Add(hx, Cyb_I4Set1(CYB_NOISE_PRIME_X)),
+        Cyb_I4Add(hy, Cyb_I4Set1(CYB_NOISE_PRIME_Y))));
+    
+    //Sum the corner contributions
+    Cyb_F4 n = Cyb_F4Mul(Cyb_NoiseFalloff_(Cyb_F4MulAdd(x0, x0,
+        Cyb_F4Mul(y0, y0))), Cyb_NoiseGrad2_(Cyb_NoiseHash_(h0), x0, y0));
+    n = Cyb_F4MulAdd(Cyb_NoiseFalloff_(Cyb_F4MulAdd(x1, x1,
+        Cyb_F4Mul(y1, y1))), Cyb_NoiseGrad2_(Cyb_NoiseHash_(h1), x1, y1), n);
+    n = Cyb_F4MulAdd(Cyb_NoiseFalloff_(Cyb_F4MulAdd(x2, x2,
+        Cyb_F4Mul(y2, y2))), Cyb_NoiseGrad2_(Cyb_NoiseHash_(h2), x2, y2), n);
+    return Cyb_F4Mul(n, Cyb_F4Set1(CYB_NOISE_SCALE_2));
+}
+
+/** @brief Compute 3D simplex noise at 4 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param z The z coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F4 Cyb_F4SimplexNoise3(Cyb_F4 x, Cyb_F4 y, Cyb_F4 z,
+    unsigned int seed)
+{
+    const float G3 = 1.0f / 6.0f;
+    Cyb_F4 one = Cyb_F4Set1(1.0f);
+    
+    //Skew to the simplex grid, find the cell, and unskew its origin
+    Cyb_F4 s = Cyb_F4Mul(Cyb_F4Add(Cyb_F4Add(x, y), z),
+        Cyb_F4Set1(1.0f / 3.0f));
+    Cyb_F4 i = Cyb_F4Floor(Cyb_F4Add(x, s));
+    Cyb_F4 j = Cyb_F4Floor(Cyb_F4Add(y, s));
+    Cyb_F4 k = Cyb_F4Floor(Cyb_F4Add(z, s));
+    Cyb_F4 t = Cyb_F4Mul(Cyb_F4Add(Cyb_F4Add(i, j), k), Cyb_F4Set1(G3));
+    Cyb_F4 x0 = Cyb_F4Add(Cyb_F4Sub(x, i), t);
+    Cyb_F4 y0 = Cyb_F4Add(Cyb_F4Sub(y, j), t);
+    Cyb_F4 z0 = Cyb_F4Add(Cyb_F4Sub(z, k), t);
+    
+    //Rank the offsets to find the order in which the corners are visited
+    Cyb_F4 xy = Cyb_F4And(Cyb_F4CmpGt(x0, y0), one);
+    Cyb_F4 xz = Cyb_F4And(Cyb_F4CmpGt(x0, z0), one);
+    Cyb_F4 yz = Cyb_F4And(Cyb_F4CmpGt(y0, z0), one);
+    Cyb_F4 rx = Cyb_F4Add(xy, xz);
+    Cyb_F4 ry = Cyb_F4Add(Cyb_F4Sub(one, xy), yz);
+    Cyb_F4 rz = Cyb_F4Sub(Cyb_F4Set1(2.0f), Cyb_F4Add(xz, yz));
+    Cyb_F4 two = Cyb_F4Set1(2.0f);
+    Cyb_F4 i1 = Cyb_F4CmpGe(rx, two);
+    Cyb_F4 j1 = Cyb_F4CmpGe(ry, two);
+    Cyb_F4 k1 = Cyb_F4CmpGe(rz, two);
+    Cyb_F4 i2 = Cyb_F4CmpGe(rx, one);
+    Cyb_F4 j2 = Cyb_F4CmpGe(ry, one);
+    Cyb_F4 k2 = Cyb_F4CmpGe(rz, one);
+    
+    //Offsets from the other corners
+    Cyb_F4 g1 = Cyb_F4Set1(G3);
+    Cyb_F4 g2 = Cyb_F4Set1(2.0f * G3);
+    Cyb_F4 g3 = Cyb_F4Set1(3.0f * G3 - 1.0f);
+    Cyb_F4 x1 = Cyb_F4Add(Cyb_F4Sub(x0, Cyb_F4And(i1, one)), g1);
+    Cyb_F4 y1 = Cyb_F4Add(Cyb_F4Sub(y0, Cyb_F4And(j1, one)), g1);
+    Cyb_F4 z1 = Cyb_F4Add(Cyb_F4Sub(z0, Cyb_F4And(k1, one)), g1);
+    Cyb_F4 x2 = Cyb_F4Add(Cyb_F4Sub(x0, Cyb_F4And(i2, one)), g2);
+    Cyb_F4 y2 = Cyb_F4Add(Cyb_F4Sub(y0, Cyb_F4And(j2, one)), g2);
+    Cyb_F4 z2 = Cyb_F4Add(Cyb_F4Sub(z0, Cyb_F4And(k2, one)), g2);
+    Cyb_F4 x3 = Cyb_F4Add(x0, g3);
+    Cyb_F4 y3 = Cyb_F4Add(y0, g3);
+    Cyb_F4 z3 = Cyb_F4Add(z0, g3);
+    
+    //Hash the corners
+    Cyb_I4 seedH = Cyb_NoiseSeed_(seed);
+    Cyb_I4 hx = Cyb_I4Mul(Cyb_F4ToI4(i), Cyb_I4Set1(CYB_NOISE_PRIME_X));
+    Cyb_I4 hy = Cyb_I4Mul(Cyb_F4ToI4(j), Cyb_I4Set1(CYB_NOISE_PRIME_Y));
+    Cyb_I4 hz = Cyb_I4Mul(Cyb_F4ToI4(k), Cyb_I4Set1(CYB_NOISE_PRIME_Z));
+    Cyb_I4 h0 = Cyb_I4Xor(seedH, Cyb_I4Xor(Cyb_I4Xor(hx, hy), hz));
+    Cyb_I4 h1 = Cyb_I4Xor(seedH, Cyb_I4Xor(Cyb_I4Xor(
+        Cyb_NoiseStep_(hx, i1, CYB_NOISE_PRIME_X),
+        Cyb_NoiseStep_(hy, j1, CYB_NOISE_PRIME_Y)),
+        Cyb_NoiseStep_(hz, k1, CYB_NOISE_PRIME_Z)));
+    Cyb_I4 h2 = Cyb_I4Xor(seedH, Cyb_I4Xor(Cyb_I4Xor(
+        Cyb_NoiseStep_(hx, i2, CYB_NOISE_PRIME_X),
+        Cyb_NoiseStep_(hy, j2, CYB_NOISE_PRIME_Y)),
+        Cyb_NoiseStep_(hz, k2, CYB_NOISE_PRIME_Z)));
+    Cyb_I4 h3 = Cyb_I4Xor(seedH, Cyb_I4Xor(Cyb_I4Xor(
+        Cyb_I4Add(hx, Cyb_I4Set1(CYB_NOISE_PRIME_X)),
+        Cyb_I4Add(hy, Cyb_I4Set1(CYB_NOISE_PRIME_Y))),
+        Cyb_I4Add(hz, Cyb_I4Set1(CYB_NOISE_PRIME_Z))));
+    
+    //Sum the corner contributions
+    Cyb_F4 n = Cyb_F4Mul(Cyb_NoiseFalloff_(Cyb_F4MulAdd(x0, x0,
+        Cyb_F4MulAdd(y0, y0, Cyb_F4Mul(z0, z0)))),
+        Cyb_NoiseGrad3_(Cyb_NoiseHash_(h0), x0, y0, z0));
+    n = Cyb_F4MulAdd(Cyb_NoiseFalloff_(Cyb_F4MulAdd(x1, x1,
+        Cyb_F4MulAdd(y1, y1, Cyb_F4Mul(z1, z1)))),
+        Cyb_NoiseGrad3_(Cyb_NoiseHash_(h1), x1, y1, z1), n);
+    n = Cyb_F4MulAdd(Cyb_NoiseFalloff_(Cyb_F4MulAdd(x2, x2,
+        Cyb_F4MulAdd(y2, y2, Cyb_F4Mul(z2, z2)))),
+        Cyb_NoiseGrad3_(Cyb_NoiseHash_(h2), x2, y2, z2), n);
+    n = Cyb_F4MulAdd(Cyb_NoiseFalloff_(Cyb_F4MulAdd(x3, x3,
+        Cyb_F4MulAdd(y3, y3, Cyb_F4Mul(z3, z3)))),
+        Cyb_NoiseGrad3_(Cyb_NoiseHash_(h3), x3, y3, z3), n);
+    return Cyb_F4Mul(n, Cyb_F4Set1(CYB_NOISE_SCALE_3));
+}
+
+/** @brief Compute 4D simplex noise at 4 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param z The z coordinates.
+ * @param w The w coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F4 Cyb_F4SimplexNoise4(Cyb_F4 x, Cyb_F4 y, Cyb_F4 z, Cyb_F4 w,
+    unsigned int seed)
+{
+    const float G4 = .138196601125f;
+    Cyb_F4 one = Cyb_F4Set1(1.0f);
+    
+    //Skew to the simplex grid, find the cell, and unskew its origin
+    Cyb_F4 s = Cyb_F4Mul(Cyb_F4Add(Cyb_F4Add(x, y), Cyb_F4Add(z, w)),
+        Cyb_F4Set1(.309016994375f));
+    Cyb_F4 c[4];
+    Cyb_F4 d[4];
+    c[0] = Cyb_F4Floor(Cyb_F4Add(x, s));
+    c[1] = Cyb_F4Floor(Cyb_F4Add(y, s));
+    c[2] = Cyb_F4Floor(Cyb_F4Add(z, s));
+    c[3] = Cyb_F4Floor(Cyb_F4Add(w, s));
+    Cyb_F4 t = Cyb_F4Mul(Cyb_F4Add(Cyb_F4Add(c[0], c[1]),
+        Cyb_F4Add(c[2], c[3])), Cyb_F4Set1(G4));
+    d[0] = Cyb_F4Add(Cyb_F4Sub(x, c[0]), t);
+    d[1] = Cyb_F4Add(Cyb_F4Sub(y, c[1]), t);
+    d[2] = Cyb_F4Add(Cyb_F4Sub(z, c[2]), t);
+    d[3] = Cyb_F4Add(Cyb_F4Sub(w, c[3]), t);
+    
+    //Rank the offsets to find the order in which the corners are visited
+    Cyb_F4 rank[4];
+    
+    for(int a = 0; a < 4; a++)
+    {
+        rank[a] = Cyb_F4Set1(0.0f);
+    }
+    
+    for(int a = 0; a < 4; a++)
+    {
+        for(int b = a + 1; b < 4; b++)
+        {
+            Cyb_F4 gt = Cyb_F4And(Cyb_F4CmpGt(d[a], d[b]), one);
+            rank[a] = Cyb_F4Add(rank[a], gt);
+            rank[b] = Cyb_F4Add(rank[b], Cyb_F4Sub(one, gt));
+        }
+    }
+    
+    //Hash the corners and sum their contributions
+    static const int primes[4] = {
+        CYB_NOISE_PRIME_X,
+        CYB_NOISE_PRIME_Y,
+        CYB_NOISE_PRIME_Z,
+        CYB_NOISE_PRIME_W
+    };
+    Cyb_I4 seedH = Cyb_NoiseSeed_(seed);
+    Cyb_I4 base[4];
+    
+    for(int a = 0; a < 4; a++)
+    {
+        base[a] = Cyb_I4Mul(Cyb_F4ToI4(c[a]), Cyb_I4Set1(primes[a]));
+    }
+    
+    Cyb_F4 n = Cyb_F4Set1(0.0f);
+    
+    for(int corner = 0; corner < 5; corner++)
+    {
+        //Corner 1 steps along the axis ranked 3, corner 2 along the axes
+        //ranked 2 or more and so on
+        Cyb_F4 minRank = Cyb_F4Set1((float)(4 - corner));
+        Cyb_F4 offset = Cyb_F4Set1(corner * G4);
+        Cyb_F4 p[4];
+        Cyb_I4 h = seedH;
+        Cyb_F4 d2 = Cyb_F4Set1(0.0f);
+        
+        for(int a = 0; a < 4; a++)
+        {
+            Cyb_F4 step = Cyb_F4CmpGe(rank[a], minRank);
+            p[a] = Cyb_F4Add(Cyb_F4Sub(d[a], Cyb_F4And(step, one)), offset);
+            h = Cyb_I4Xor(h, Cyb_NoiseStep_(base[a], step, primes[a]));
+            d2 = Cyb_F4MulAdd(p[a], p[a], d2);
+        }
+        
+        n = Cyb_F4MulAdd(Cyb_NoiseFalloff_(d2), Cyb_NoiseGrad4_(
+            Cyb_NoiseHash_(h), p[0], p[1], p[2], p[3]), n);
+    }
+    
+    return Cyb_F4Mul(n, Cyb_F4Set1(CYB_NOISE_SCALE_4));
+}
+
+/** @brief Compute 2D value noise at 4 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F4 Cyb_F4ValueNoise2(Cyb_F4 x, Cyb_F4 y, unsigned int seed)
+{
+    Cyb_F4 i = Cyb_F4Floor(x);
+    Cyb_F4 j = Cyb_F4Floor(y);
+    Cyb_F4 u = Cyb_NoiseFade_(Cyb_F4Sub(x, i));
+    Cyb_F4 v = Cyb_NoiseFade_(Cyb_F4Sub(y, j));
+    
+    //Hash the 4 corners of the cell
+    Cyb_I4 seedH = Cyb_NoiseSeed_(seed);
+    Cyb_I4 hx0 = Cyb_I4Mul(Cyb_F4ToI4(i), Cyb_I4Set1(CYB_NOISE_PRIME_X));
+    Cyb_I4 hy0 = Cyb_I4Mul(Cyb_F4ToI4(j), Cyb_I4Set1(CYB_NOISE_PRIME_Y));
+    Cyb_I4 hx1 = Cyb_I4Add(hx0, Cyb_I4Set1(CYB_NOISE_PRIME_X));
+    Cyb_I4 hy1 = Cyb_I4Add(hy0, Cyb_I4Set1(CYB_NOISE_PRIME_Y));
+    hy0 = Cyb_I4Xor(hy0, seedH);
+    hy1 = Cyb_I4Xor(hy1, seedH);
+    Cyb_F4 v00 = Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hx0, hy0)));
+    Cyb_F4 v10 = Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hx1, hy0)));
+    Cyb_F4 v01 = Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hx0, hy1)));
+    Cyb_F4 v11 = Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hx1, hy1)));
+    return Cyb_NoiseLerp_(Cyb_NoiseLerp_(v00, v10, u),
+        Cyb_NoiseLerp_(v01, v11, u), v);
+}
+
+/** @brief Compute 3D value noise at 4 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param z The z coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F4 Cyb_F4ValueNoise3(Cyb_F4 x, Cyb_F4 y, Cyb_F4 z,
+    unsigned int seed)
+{
+    Cyb_F4 i = Cyb_F4Floor(x);
+    Cyb_F4 j = Cyb_F4Floor(y);
+    Cyb_F4 k = Cyb_F4Floor(z);
+    Cyb_F4 u = Cyb_NoiseFade_(Cyb_F4Sub(x, i));
+    Cyb_F4 v = Cyb_NoiseFade_(Cyb_F4Sub(y, j));
+    Cyb_F4 w = Cyb_NoiseFade_(Cyb_F4Sub(z, k));
+    
+    //Interpolate the 8 corners of the cell along x, then y, then z
+    Cyb_I4 hx0 = Cyb_I4Mul(Cyb_F4ToI4(i), Cyb_I4Set1(CYB_NOISE_PRIME_X));
+    Cyb_I4 hx1 = Cyb_I4Add(hx0, Cyb_I4Set1(CYB_NOISE_PRIME_X));
+    Cyb_I4 hy = Cyb_I4Mul(Cyb_F4ToI4(j), Cyb_I4Set1(CYB_NOISE_PRIME_Y));
+    Cyb_I4 hz = Cyb_I4Mul(Cyb_F4ToI4(k), Cyb_I4Set1(CYB_NOISE_PRIME_Z));
+    Cyb_I4 seedH = Cyb_NoiseSeed_(seed);
+    Cyb_F4 planes[2];
+    
+    for(int c = 0; c < 2; c++)
+    {
+        Cyb_I4 hzs = Cyb_I4Xor(hz, seedH);
+        Cyb_I4 hyz0 = Cyb_I4Xor(hy, hzs);
+        Cyb_I4 hyz1 = Cyb_I4Xor(Cyb_I4Add(hy, Cyb_I4Set1(CYB_NOISE_PRIME_Y)),
+            hzs);
+        Cyb_F4 row0 = Cyb_NoiseLerp_(
+            Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hx0, hyz0))),
+            Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hx1, hyz0))), u);
+        Cyb_F4 row1 = Cyb_NoiseLerp_(
+            Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hx0, hyz1))),
+            Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hx1, hyz1))), u);
+        planes[c] = Cyb_NoiseLerp_(row0, row1, v);
+        hz = Cyb_I4Add(hz, Cyb_I4Set1(CYB_NOISE_PRIME_Z));
+    }
+    
+    return Cyb_NoiseLerp_(planes[0], planes[1], w);
+}
+
+/** @brief Compute 4D value noise at 4 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param z The z coordinates.
+ * @param w The w coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F4 Cyb_F4ValueNoise4(Cyb_F4 x, Cyb_F4 y, Cyb_F4 z, Cyb_F4 w,
+    unsigned int seed)
+{
+    static const int primes[4] = {
+        CYB_NOISE_PRIME_X,
+        CYB_NOISE_PRIME_Y,
+        CYB_NOISE_PRIME_Z,
+        CYB_NOISE_PRIME_W
+    };
+    Cyb_F4 p[4] = {x, y, z, w};
+    Cyb_F4 fade[4];
+    Cyb_I4 h[4][2];
+    
+    for(int a = 0; a < 4; a++)
+    {
+        Cyb_F4 c = Cyb_F4Floor(p[a]);
+        fade[a] = Cyb_NoiseFade_(Cyb_F4Sub(p[a], c));
+        h[a][0] = Cyb_I4Mul(Cyb_F4ToI4(c), Cyb_I4Set1(primes[a]));
+        h[a][1] = Cyb_I4Add(h[a][0], Cyb_I4Set1(primes[a]));
+    }
+    
+    //Hash the 16 corners of the cell, with bit a of the corner index
+    //selecting the side along axis a
+    Cyb_I4 seedH = Cyb_NoiseSeed_(seed);
+    Cyb_F4 values[16];
+    
+    for(int corner = 0; corner < 16; corner++)
+    {
+        Cyb_I4 hc = Cyb_I4Xor(Cyb_I4Xor(h[0][corner & 1],
+            h[1][(corner >> 1) & 1]), Cyb_I4Xor(h[2][(corner >> 2) & 1],
+            h[3][corner >> 3]));
+        values[corner] = Cyb_NoiseValue_(Cyb_NoiseHash_(Cyb_I4Xor(hc, seedH)));
+    }
+    
+    //Interpolate along one axis at a time
+    for(int a = 0, count = 16; a < 4; a++)
+    {
+        count /= 2;
+        
+        for(int c = 0; c < count; c++)
+        {
+            values[c] = Cyb_NoiseLerp_(values[c * 2], values[c * 2 + 1],
+                fade[a]);
+        }
+    }
+    
+    return values[0];
+}
+
+/** @brief Compute 2D simplex noise at 8 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F8 Cyb_F8SimplexNoise2(Cyb_F8 x, Cyb_F8 y, unsigned int seed)
+{
+    Cyb_F8 r = {Cyb_F4SimplexNoise2(x.lo, y.lo, seed),
+        Cyb_F4SimplexNoise2(x.hi, y.hi, seed)};
+    return r;
+}
+
+/** @brief Compute 3D simplex noise at 8 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param z The z coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F8 Cyb_F8SimplexNoise3(Cyb_F8 x, Cyb_F8 y, Cyb_F8 z,
+    unsigned int seed)
+{
+    Cyb_F8 r = {Cyb_F4SimplexNoise3(x.lo, y.lo, z.lo, seed),
+        Cyb_F4SimplexNoise3(x.hi, y.hi, z.hi, seed)};
+    return r;
+}
+
+/** @brief Compute 4D simplex noise at 8 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param z The z coordinates.
+ * @param w The w coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F8 Cyb_F8SimplexNoise4(Cyb_F8 x, Cyb_F8 y, Cyb_F8 z, Cyb_F8 w,
+    unsigned int seed)
+{
+    Cyb_F8 r = {Cyb_F4SimplexNoise4(x.lo, y.lo, z.lo, w.lo, seed),
+        Cyb_F4SimplexNoise4(x.hi, y.hi, z.hi, w.hi, seed)};
+    return r;
+}
+
+/** @brief Compute 2D value noise at 8 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F8 Cyb_F8ValueNoise2(Cyb_F8 x, Cyb_F8 y, unsigned int seed)
+{
+    Cyb_F8 r = {Cyb_F4ValueNoise2(x.lo, y.lo, seed),
+        Cyb_F4ValueNoise2(x.hi, y.hi, seed)};
+    return r;
+}
+
+/** @brief Compute 3D value noise at 8 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param z The z coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F8 Cyb_F8ValueNoise3(Cyb_F8 x, Cyb_F8 y, Cyb_F8 z,
+    unsigned int seed)
+{
+    Cyb_F8 r = {Cyb_F4ValueNoise3(x.lo, y.lo, z.lo, seed),
+        Cyb_F4ValueNoise3(x.hi, y.hi, z.hi, seed)};
+    return r;
+}
+
+/** @brief Compute 4D value noise at 8 points.
+ *
+ * @param x The x coordinates.
+ * @param y The y coordinates.
+ * @param z The z coordinates.
+ * @param w The w coordinates.
+ * @param seed The seed.
+ *
+ * @return The noise values in [-1, 1].
+ */
+CYB_INLINE Cyb_F8 Cyb_F8ValueNoise4(Cyb_F8 x, Cyb_F8 y, Cyb_F8 z, Cyb_F8 w,
+    unsigned int seed)
+{
+    Cyb_F8 r = {Cyb_F4ValueNoise4(x.lo, y.lo, z.lo, w.lo, seed),
+        Cyb_F4ValueNoise4(x.hi, y.hi, z.hi, w.hi, seed)};
+    return r;
+}
+
+/** @brief Compute 2D simplex noise at a point.
+ *
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @param seed The seed.
+ *
+ * @return The noise value in [-1, 1].
+ */
+CYBAPI float Cyb_SimplexNoise2(float x, float y, unsigned int seed);
+
+/** @brief Compute 3D simplex noise at a point.
+ *
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @param z The z coordinate.
+ * @param seed The seed.
+ *
+ * @return The noise value in [-1, 1].
+ */
+CYBAPI float Cyb_SimplexNoise3(float x, float y, float z, unsigned int seed);
+
+/** @brief Compute 4D simplex noise at a point.
+ *
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @param z The z coordinate.
+ * @param w The w coordinate.
+ * @param seed The seed.
+ *
+ * @return The noise value in [-1, 1].
+ */
+CYBAPI float Cyb_SimplexNoise4(float x, float y, float z, float w,
+    unsigned int seed);
+
+/** @brief Compute 2D value noise at a point.
+ *
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @param seed The seed.
+ *
+ * @return The noise value in [-1, 1].
+ */
+CYBAPI float Cyb_ValueNoise2(float x, float y, unsigned int seed);
+
+/** @brief Compute 3D value noise at a point.
+ *
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @param z The z coordinate.
+ * @param seed The seed.
+ *
+ * @return The noise value in [-1, 1].
+ */
+CYBAPI float Cyb_ValueNoise3(float x, float y, float z, unsigned int seed);
+
+/** @brief Compute 4D value noise at a point.
+ *
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @param z The z coordinate.
+ * @param w The w coordinate.
+ * @param seed The seed.
+ *
+ * @return The noise value in [-1, 1].
+ */
+CYBAPI float Cyb_ValueNoise4(float x, float y, float z, float w,
+    unsigned int seed);
+
+/** @brief Initialize fBm parameters to 1 octave of simplex noise with seed 0,
+ * frequency 1, lacunarity 2, and gain .5.
+ *
+ * @param params Pointer to the parameters.
+ */
+CYBAPI void Cyb_InitNoiseParams(Cyb_NoiseParams *params);
+
+/** @brief Compute 2D fBm at a point.
+ *
+ * The octaves are normalized so that the result stays in [-1, 1].
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ *
+ * @return The fBm value in [-1, 1].
+ */
+CYBAPI float Cyb_FBM2(const Cyb_NoiseParams *params, float x, float y);
+
+/** @brief Compute 3D fBm at a point.
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @param z The z coordinate.
+ *
+ * @return The fBm value in [-1, 1].
+ */
+CYBAPI float Cyb_FBM3(const Cyb_NoiseParams *params, float x, float y,
+    float z);
+
+/** @brief Compute 4D fBm at a point.
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param x The x coordinate.
+ * @param y The y coordinate.
+ * @param z The z coordinate.
+ * @param w The w coordinate.
+ *
+ * @return The fBm value in [-1, 1].
+ */
+CYBAPI float Cyb_FBM4(const Cyb_NoiseParams *params, float x, float y,
+    float z, float w);
+
+/** @brief Compute 2D fBm at an array of points.
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param points Pointer to the points.
+ * @param out Pointer to the resulting values.
+ * @param count The number of points.
+ */
+CYBAPI void Cyb_FBMArray2(const Cyb_NoiseParams *params,
+    const Cyb_Vec2 *points, float *out, int count);
+
+/** @brief Compute 3D fBm at an array of points.
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param points Pointer to the points.
+ * @param out Pointer to the resulting values.
+ * @param count The number of points.
+ */
+CYBAPI void Cyb_FBMArray3(const Cyb_NoiseParams *params,
+    const Cyb_Vec3 *points, float *out, int count);
+
+/** @brief Compute 4D fBm at an array of points.
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param points Pointer to the points.
+ * @param out Pointer to the resulting values.
+ * @param count The number of points.
+ */
+CYBAPI void Cyb_FBMArray4(const Cyb_NoiseParams *params,
+    const Cyb_Vec4 *points, float *out, int count);
+
+/** @brief Fill an image with 2D fBm.
+ *
+ * The sample in column c of row r is taken at (x + c * step, y + r * step).
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param out Pointer to the image (width * height floats, row by row).
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param x The x coordinate of the first sample.
+ * @param y The y coordinate of the first sample.
+ * @param step The distance between neighboring samples.
+ */
+CYBAPI void Cyb_FillFBM2(const Cyb_NoiseParams *params, float *out, int width,
+    int height, float x, float y, float step);
+
+/** @brief Fill an image with a slice of 3D fBm.
+ *
+ * Same as Cyb_FillFBM2 with a constant z coordinate, which gives animated
+ * textures when z is time.
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param out Pointer to the image (width * height floats, row by row).
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param x The x coordinate of the first sample.
+ * @param y The y coordinate of the first sample.
+ * @param z The z coordinate of the slice.
+ * @param step The distance between neighboring samples.
+ */
+CYBAPI void Cyb_FillFBM3(const Cyb_NoiseParams *params, float *out, int width,
+    int height, float x, float y, float z, float step);
+
+/** @brief Fill an image with a slice of 4D fBm.
+ *
+ * @param params Pointer to the fBm parameters.
+ * @param out Pointer to the image (width * height floats, row by row).
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param x The x coordinate of the first sample.
+ * @param y The y coordinate of the first sample.
+ * @param z The z coordinate of the slice.
+ * @param w The w coordinate of the slice.
+ * @param step The distance between neighboring samples.
+ */
+CYBAPI void Cyb_FillFBM4(const Cyb_NoiseParams *params, float *out, int width,
+    int height, float x, float y, float z, float w, float step);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef CYBOBB_H
+#define CYBOBB_H
+
+/** @file
+ * @brief CybMath - Oriented Box API
+ */
+
+#include "CybCommon.h"
+#include "CybBox.h"
+#include "CybMatrix.h"
+#include "CybVec.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Structures
+//=================================================================================
+/** @brief Oriented bounding box (OBB).
+ */
+typedef struct
+{
+    Cyb_Vec3 center;  /**< The center of the box. */
+    Cyb_Vec3 axes[3]; /**< The local X, Y, and Z axes. Must be orthonormal. */
+    Cyb_Vec3 size;    /**< The size of the box along each local axis. */
+} Cyb_OBB;
+
+
+//Functions
+//=================================================================================
+/** @brief Calculate an oriented box that some given geometry will fit into.
+ *
+ * The axes are the principal axes of the vertex positions, so the box is
+ * usually much tighter than an axis-aligned box for long or tilted shapes.
+ *
+ * @param obb Pointer to the resulting box.
+ * @param verts Pointer to some vertex data. Each vertex must start with its
+ * position.
+ * @param stride The size of each vertex.
+ * @param count The number of vertices.
+ */
+CYBAPI void Cyb_OBBFromGeometry(Cyb_OBB *obb, const void *verts, int stride,
+    int count);
+
+/** @brief Transform an axis-aligned box into an oriented box.
+ *
+ * @param obb Pointer to the resulting box.
+ * @param box Pointer to the axis-aligned box.
+ * @param m Pointer to a matrix made of rotation, translation, and scaling.
+ * Scaling is moved into the box size.
+ */
+CYBAPI void Cyb_OBBFromBox(Cyb_OBB *obb, const Cyb_Box *box,
+    const Cyb_Mat4 *m);
+
+/** @brief Calculate the smallest axis-aligned box that an oriented box will
+ * fit into.
+ *
+ * @param box Pointer to the resulting box.
+ * @param obb Pointer to the oriented box.
+ */
+CYBAPI void Cyb_BoxFromOBB(Cyb_Box *box, const Cyb_OBB *obb);
+
+/** @brief Test if a given point lies within a given oriented box.
+ *
+ * @param a Pointer to the point.
+ * @param b Pointer to the box.
+ *
+ * @return TRUE if the point is inside the box.
+ */
+CYBAPI int Cyb_PointInOBB(const Cyb_Vec3 *a, const Cyb_OBB *b);
+
+/** @brief Test if 2 oriented boxes are intersecting.
+ *
+ * Uses the separating axis test on the 15 candidate axes.
+ *
+ * @param a Pointer to the first box.
+ * @param b Pointer to the second box.
+ *
+ * @return TRUE if the boxes are intersecting.
+ */
+CYBAPI int Cyb_OBBHitOBB(const Cyb_OBB *a, const Cyb_OBB *b);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
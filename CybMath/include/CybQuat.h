@@ -41,6 +41,8 @@ CYBAPI void Cyb_QuatFromAxisAndAngle(Cyb_Vec4 *quat, float x, float y, float z,
 CYBAPI void Cyb_MulQuat(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b);
 
 /** @brief Normalize a quaternion.
+ *
+ * A zero quaternion is left unchanged.
  *
  * @param quat Pointer to the quaternion.
  */
@@ -57,6 +59,59 @@ CYBAPI void Cyb_NormalizeQuat(Cyb_Vec4 *quat);
 CYBAPI void Cyb_Slerp(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
     double progress);
 
+/** @brief Calculate the quaternion that lies between a and b given the progression
+ * between the 2 quaternions by using normalized linear interpolation.
+ *
+ * Much cheaper than Cyb_Slerp and follows the same path, but the rotation speed
+ * is not constant. The angle between the result and the slerp result is below
+ * .15 radians in the worst case and shrinks quickly as a and b get closer.
+ *
+ * @param c Pointer to the resulting quaternion.
+ * @param a Pointer to the start quaternion.
+ * @param b Pointer to the end quaternion.
+ * @param progress The amount of progress between a and b (between 0.0 and 1.0).
+ */
+CYBAPI void Cyb_Nlerp(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
+    float progress);
+
+/** @brief Calculate the quaternion that lies between a and b given the progression
+ * between the 2 quaternions by using approximated spherical linear
+ * interpolation.
+ *
+ * Corrects the progress with a cubic before using normalized linear
+ * interpolation. The angle between the result and the Cyb_Slerp result is below
+ * .001 radians (.06 degrees) for any pair of unit quaternions.
+ *
+ * @param c Pointer to the resulting quaternion.
+ * @param a Pointer to the start quaternion.
+ * @param b Pointer to the end quaternion.
+ * @param progress The amount of progress between a and b (between 0.0 and 1.0).
+ */
+CYBAPI void Cyb_FastSlerp(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
+    float progress);
+
+/** @brief Interpolate between arrays of quaternions with Cyb_Nlerp.
+ *
+ * @param c Pointer to the resulting quaternions. May be the same as a or b.
+ * @param a Pointer to the start quaternions.
+ * @param b Pointer to the end quaternions.
+ * @param progress Pointer to the amount of progress for each pair.
+ * @param count The number of quaternions.
+ */
+CYBAPI void Cyb_NlerpArray(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
+    const float *progress, int count);
+
+/** @brief Interpolate between arrays of quaternions with Cyb_FastSlerp.
+ *
+ * @param c Pointer to the resulting quaternions. May be the same as a or b.
+ * @param a Pointer to the start quaternions.
+ * @param b Pointer to the end quaternions.
+ * @param progress Pointer to the amount of progress for each pair.
+ * @param count The number of quaternions.
+ */
+CYBAPI void Cyb_FastSlerpArray(Cyb_Vec4 *c, const Cyb_Vec4 *a,
+    const Cyb_Vec4 *b, const float *progress, int count);
+
 /** @brief Convert a quaternion to a matrix.
  *
  * @param Pointer to the resulting matrix.
@@ -0,0 +1,112 @@
+#ifndef CYBRANDOM_H
+#define CYBRANDOM_H
+
+/** @file
+ * @brief CybMath - Random Number API
+ *
+ * A small, fast pseudo random number generator (xoshiro128**) for procedural
+ * content. The same seed gives the same sequence on every platform. It is not
+ * suitable for cryptography.
+ */
+
+#include "CybCommon.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Structures
+//=================================================================================
+/** @brief Random number generator state.
+ */
+typedef struct
+{
+    unsigned int s[4]; /**< Generator state. Must not be all zeros. */
+} Cyb_Random;
+
+
+//Functions
+//=================================================================================
+/** @brief Get the next 32-bit random number.
+ *
+ * @param rng Pointer to the random number generator.
+ *
+ * @return The random number.
+ */
+CYB_INLINE unsigned int Cyb_NextRandom(Cyb_Random *rng)
+{
+    unsigned int *s = rng->s;
+    unsigned int x = s[1] * 5;
+    unsigned int result = ((x << 7) | (x >> 25)) * 9;
+    unsigned int t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+}
+
+/** @brief Get a random float in [0, 1).
+ *
+ * @param rng Pointer to the random number generator.
+ *
+ * @return The random float.
+ */
+CYB_INLINE float Cyb_RandomFloat(Cyb_Random *rng)
+{
+    //The top 24 bits fill the mantissa exactly
+    return (Cyb_NextRandom(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+/** @brief Get a random float in [min, max).
+ *
+ * @param rng Pointer to the random number generator.
+ * @param min The lower bound.
+ * @param max The upper bound.
+ *
+ * @return The random float.
+ */
+CYB_INLINE float Cyb_RandomRange(Cyb_Random *rng, float min, float max)
+{
+    return min + (max - min) * Cyb_RandomFloat(rng);
+}
+
+/** @brief Seed a random number generator.
+ *
+ * @param rng Pointer to the random number generator.
+ * @param seed The seed. Every value including 0 is valid.
+ */
+CYBAPI void Cyb_SeedRandom(Cyb_Random *rng, unsigned long long seed);
+
+/** @brief Fill an array with random floats in [min, max).
+ *
+ * Runs 4 generators side by side which are seeded from the given generator,
+ * so the results differ from calling Cyb_RandomRange in a loop. The given
+ * generator is advanced, so consecutive calls give different results.
+ *
+ * @param rng Pointer to the random number generator.
+ * @param out Pointer to the resulting floats.
+ * @param count The number of floats.
+ * @param min The lower bound.
+ * @param max The upper bound.
+ */
+CYBAPI void Cyb_FillRandom(Cyb_Random *rng, float *out, int count, float min,
+    float max);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
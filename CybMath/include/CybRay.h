@@ -0,0 +1,273 @@
+#ifndef CYBRAY_H
+#define CYBRAY_H
+
+/** @file
+ * @brief CybMath - Ray API
+ */
+ 
+#include "CybCommon.h"
+#include "CybBox.h"
+#include "CybOBB.h"
+#include "CybSphere.h"
+#include "CybVec.h"
+
+ 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Structures
+//=================================================================================
+/** @brief A ray.
+ */
+typedef struct
+{
+    Cyb_Vec3 origin; /**< Ray origin. */
+    Cyb_Vec3 dir;    /**< Ray direction. Distances are measured in multiples of
+                          this vector. */
+} Cyb_Ray;
+
+
+/** @brief 4 rays stored as separate component arrays.
+ */
+typedef struct
+{
+    float ox[4]; /**< Origin x components. */
+    float oy[4]; /**< Origin y components. */
+    float oz[4]; /**< Origin z components. */
+    float dx[4]; /**< Direction x components. */
+    float dy[4]; /**< Direction y components. */
+    float dz[4]; /**< Direction z components. */
+} Cyb_RayPacket4;
+
+
+/** @brief 8 rays stored as separate component arrays.
+ */
+typedef struct
+{
+    float ox[8]; /**< Origin x components. */
+    float oy[8]; /**< Origin y components. */
+    float oz[8]; /**< Origin z components. */
+    float dx[8]; /**< Direction x components. */
+    float dy[8]; /**< Direction y components. */
+    float dz[8]; /**< Direction z components. */
+} Cyb_RayPacket8;
+
+
+//Functions
+//=================================================================================
+/** @brief Calculate the point at a given distance along a ray.
+ *
+ * @param point Pointer to the resulting point.
+ * @param ray Pointer to the ray.
+ * @param t The distance along the ray.
+ */
+CYBAPI void Cyb_PointOnRay(Cyb_Vec3 *point, const Cyb_Ray *ray, float t);
+
+/** @brief Test if a ray hits a given box.
+ *
+ * @param a Pointer to the ray.
+ * @param b Pointer to the box.
+ * @param t Pointer to a float which receives the distance to the entry point.
+ * If the ray starts inside the box the distance is 0. May be NULL.
+ *
+ * @return TRUE if the ray hits the box.
+ */
+CYBAPI int Cyb_RayHitBox(const Cyb_Ray *a, const Cyb_Box *b, float *t);
+
+/** @brief Test if a ray hits a given oriented box.
+ *
+ * @param a Pointer to the ray.
+ * @param b Pointer to the box.
+ * @param t Pointer to a float which receives the distance to the entry point.
+ * If the ray starts inside the box the distance is 0. May be NULL.
+ *
+ * @return TRUE if the ray hits the box.
+ */
+CYBAPI int Cyb_RayHitOBB(const Cyb_Ray *a, const Cyb_OBB *b, float *t);
+
+/** @brief Test if a ray hits a given sphere.
+ *
+ * @param a Pointer to the ray.
+ * @param b Pointer to the sphere.
+ * @param t Pointer to a float which receives the distance to the entry point.
+ * If the ray starts inside the sphere the distance is 0. May be NULL.
+ *
+ * @return TRUE if the ray hits the sphere.
+ */
+CYBAPI int Cyb_RayHitSphere(const Cyb_Ray *a, const Cyb_Sphere *b, float *t);
+
+/** @brief Test if a ray hits a given triangle (Moller-Trumbore).
+ *
+ * Both sides of the triangle can be hit.
+ *
+ * @param a Pointer to the ray.
+ * @param v0 Pointer to the first vertex.
+ * @param v1 Pointer to the second vertex.
+ * @param v2 Pointer to the third vertex.
+ * @param t Pointer to a float which receives the hit distance. May be NULL.
+ *
+ * @return TRUE if the ray hits the triangle.
+ */
+CYBAPI int Cyb_RayHitTriangle(const Cyb_Ray *a, const Cyb_Vec3 *v0, 
+    const Cyb_Vec3 *v1, const Cyb_Vec3 *v2, float *t);
+
+/** @brief Find the closest triangle of an indexed triangle list hit by a ray.
+ *
+ * Triangles are tested 4 at a time.
+ *
+ * @param a Pointer to the ray.
+ * @param verts Pointer to the vertex positions.
+ * @param indices Pointer to the triangle indices (3 per triangle).
+ * @param triCount The number of triangles.
+ * @param t Pointer to a float. On entry it holds the maximum distance. On 
+ * exit it holds the distance to the closest hit.
+ *
+ * @return The index of the closest triangle or -1 if nothing was hit.
+ */
+CYBAPI int Cyb_RayHitTriangles(const Cyb_Ray *a, const Cyb_Vec3 *verts,
+    const unsigned int *indices, int triCount, float *t);
+
+/** @brief Build a 4-ray packet.
+ *
+ * @param packet Pointer to the resulting packet.
+ * @param rays Pointer to an array of 4 rays.
+ */
+CYBAPI void Cyb_MakeRayPacket4(Cyb_RayPacket4 *packet, const Cyb_Ray *rays);
+
+/** @brief Build an 8-ray packet.
+ *
+ * @param packet Pointer to the resulting packet.
+ * @param rays Pointer to an array of 8 rays.
+ */
+CYBAPI void Cyb_MakeRayPacket8(Cyb_RayPacket8 *packet, const Cyb_Ray *rays);
+
+/** @brief Test if 4 rays hit a given box.
+ *
+ * @param a Pointer to the ray packet.
+ * @param b Pointer to the box.
+ * @param t Pointer to an array of 4 floats which receives the entry distances.
+ * May be NULL.
+ *
+ * @return A bit mask with bit n set if ray n hits the box.
+ */
+CYBAPI int Cyb_RayPacket4HitBox(const Cyb_RayPacket4 *a, const Cyb_Box *b,
+    float *t);
+
+/** @brief Test if 8 rays hit a given box.
+ *
+ * @param a Pointer to the ray packet.
+ * @param b Pointer to the box.
+ * @param t Pointer to an array of 8 floats which receives the entry distances.
+ * May be NULL.
+ *
+ * @return A bit mask with bit n set if ray n hits the box.
+ */
+CYBAPI int Cyb_RayPacket8HitBox(const Cyb_RayPacket8 *a, const Cyb_Box *b,
+    float *t);
+
+/** @brief Test if 4 rays hit a given sphere.
+ *
+ * @param a Pointer to the ray packet.
+ * @param b Pointer to the sphere.
+ * @param t Pointer to an array of 4 floats which receives the entry distances.
+ * May be NULL.
+ *
+ * @return A bit mask with bit n set if ray n hits the sphere.
+ */
+CYBAPI int Cyb_RayPacket4HitSphere(const Cyb_RayPacket4 *a, 
+    const Cyb_Sphere *b, float *t);
+
+/** @brief Test if 8 rays hit a given sphere.
+ *
+ * @param a Pointer to the ray packet.
+ * @param b Pointer to the sphere.
+ * @param t Pointer to an array of 8 floats which receives the entry distances.
+ * May be NULL.
+ *
+ * @return A bit mask with bit n set if ray n hits the sphere.
+ */
+CYBAPI int Cyb_RayPacket8HitSphere(const Cyb_RayPacket8 *a, 
+    const Cyb_Sphere *b, float *t);
+
+/** @brief Test if 4 rays hit a given triangle.
+ *
+ * @param a Pointer to the ray packet.
+ * @param v0 Pointer to the first vertex.
+ * @param v1 Pointer to the second vertex.
+ * @param v2 Pointer to the third vertex.
+ * @param t Pointer to an array of 4 floats which receives the hit distances.
+ * May be NULL.
+ *
+ * @return A bit mask with bit n set if ray n hits the triangle.
+ */
+CYBAPI int Cyb_RayPacket4HitTriangle(const Cyb_RayPacket4 *a, 
+    const Cyb_Vec3 *v0, const Cyb_Vec3 *v1, const Cyb_Vec3 *v2, float *t);
+
+/** @brief Test if 8 rays hit a given triangle.
+ *
+ * @param a Pointer to the ray packet.
+ * @param v0 Pointer to the first vertex.
+ * @param v1 Pointer to the second vertex.
+ * @param v2 Pointer to the third vertex.
+ * @param t Pointer to an array of 8 floats which receives the hit distances.
+ * May be NULL.
+ *
+ * @return A bit mask with bit n set if ray n hits the triangle.
+ */
+CYBAPI int Cyb_RayPacket8HitTriangle(const Cyb_RayPacket8 *a, 
+    const Cyb_Vec3 *v0, const Cyb_Vec3 *v1, const Cyb_Vec3 *v2, float *t);
+
+/** @brief Find the closest triangle of an indexed triangle list hit by each 
+ * of 4 rays.
+ *
+ * Useful for visibility checks: set each distance to the distance to the
+ * target and any ray in the returned mask is blocked.
+ *
+ * @param a Pointer to the ray packet.
+ * @param verts Pointer to the vertex positions.
+ * @param indices Pointer to the triangle indices (3 per triangle).
+ * @param triCount The number of triangles.
+ * @param t Pointer to an array of 4 floats. On entry it holds the maximum 
+ * distance for each ray. On exit it holds the distance to the closest hit.
+ * @param tris Pointer to an array of 4 ints which receives the closest 
+ * triangle index for each ray or -1. May be NULL.
+ *
+ * @return A bit mask with bit n set if ray n hits any triangle.
+ */
+CYBAPI int Cyb_RayPacket4HitTriangles(const Cyb_RayPacket4 *a, 
+    const Cyb_Vec3 *verts, const unsigned int *indices, int triCount, 
+    float *t, int *tris);
+
+/** @brief Find the closest triangle of an indexed triangle list hit by each 
+ * of 8 rays.
+ *
+ * @param a Pointer to the ray packet.
+ * @param verts Pointer to the vertex positions.
+ * @param indices Pointer to the triangle indices (3 per triangle).
+ * @param triCount The number of triangles.
+ * @param t Pointer to an array of 8 floats. On entry it holds the maximum 
+ * distance for each ray. On exit it holds the distance to the closest hit.
+ * @param tris Pointer to an array of 8 ints which receives the closest 
+ * triangle index for each ray or -1. May be NULL.
+ *
+ * @return A bit mask with bit n set if ray n hits any triangle.
+ */
+CYBAPI int Cyb_RayPacket8HitTriangles(const Cyb_RayPacket8 *a, 
+    const Cyb_Vec3 *verts, const unsigned int *indices, int triCount, 
+    float *t, int *tris);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
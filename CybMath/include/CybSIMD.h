@@ -0,0 +1,564 @@
+#ifndef CYBSIMD_H
+#define CYBSIMD_H
+
+/** @file
+ * @brief CybMath - SIMD API
+ *
+ * A thin 4-lane float abstraction used by the batch functions in CybMath. It
+ * maps to SSE2 on x86, NEON on ARM, and a plain C structure everywhere else.
+ * Comparison functions return lane masks which are either all ones or all
+ * zeros in each lane. Cyb_F4Rsqrt has a relative error below 1e-6 and is
+ * undefined for 0. Cyb_F4Round is only valid for values below 2^22, and ties
+ * may round either way.
+ *
+ * Cyb_I4 holds 4 32-bit integer lanes for hashing and bit manipulation.
+ * Arithmetic wraps around, shifts are logical, and the shift count must be
+ * between 0 and 31. Cyb_F4Floor and Cyb_F4ToI4 are only valid for values
+ * below 2^31. The As functions reinterpret the bits of a register.
+ */
+
+#include "CybCommon.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CYB_SIMD_SSE2
+    #include <emmintrin.h>
+    
+    #if defined(__SSE4_1__)
+        #include <smmintrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define CYB_SIMD_NEON
+    #include <arm_neon.h>
+#else
+    #define CYB_SIMD_SCALAR
+    #include <math.h>
+    #include <string.h>
+#endif
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Structures
+//=================================================================================
+#if defined(CYB_SIMD_SSE2)
+typedef __m128 Cyb_F4;
+typedef __m128i Cyb_I4;
+#elif defined(CYB_SIMD_NEON)
+typedef float32x4_t Cyb_F4;
+typedef int32x4_t Cyb_I4;
+#else
+/** @brief 4 packed floats.
+ */
+typedef struct
+{
+    float v[4]; /**< Lane values. */
+} Cyb_F4;
+
+/** @brief 4 packed 32-bit integers.
+ */
+typedef struct
+{
+    int v[4]; /**< Lane values. */
+} Cyb_I4;
+#endif
+
+
+//Functions
+//=================================================================================
+#if defined(CYB_SIMD_SSE2)
+CYB_INLINE Cyb_F4 Cyb_F4Load(const float *p) {return _mm_loadu_ps(p);}
+CYB_INLINE void Cyb_F4Store(float *p, Cyb_F4 a) {_mm_storeu_ps(p, a);}
+CYB_INLINE Cyb_F4 Cyb_F4Set1(float a) {return _mm_set1_ps(a);}
+CYB_INLINE Cyb_F4 Cyb_F4Set(float a, float b, float c, float d)
+{
+    return _mm_setr_ps(a, b, c, d);
+}
+CYB_INLINE Cyb_F4 Cyb_F4Add(Cyb_F4 a, Cyb_F4 b) {return _mm_add_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Sub(Cyb_F4 a, Cyb_F4 b) {return _mm_sub_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Mul(Cyb_F4 a, Cyb_F4 b) {return _mm_mul_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Div(Cyb_F4 a, Cyb_F4 b) {return _mm_div_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Min(Cyb_F4 a, Cyb_F4 b) {return _mm_min_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Max(Cyb_F4 a, Cyb_F4 b) {return _mm_max_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Sqrt(Cyb_F4 a) {return _mm_sqrt_ps(a);}
+CYB_INLINE Cyb_F4 Cyb_F4Rsqrt(Cyb_F4 a)
+{
+    //12-bit estimate refined with 1 Newton-Raphson step
+    __m128 r = _mm_rsqrt_ps(a);
+    __m128 ar2 = _mm_mul_ps(_mm_mul_ps(a, r), r);
+    return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(.5f), r),
+        _mm_sub_ps(_mm_set1_ps(3.0f), ar2));
+}
+CYB_INLINE Cyb_F4 Cyb_F4Round(Cyb_F4 a)
+{
+    return _mm_cvtepi32_ps(_mm_cvtps_epi32(a));
+}
+CYB_INLINE Cyb_F4 Cyb_F4Abs(Cyb_F4 a)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+CYB_INLINE Cyb_F4 Cyb_F4CmpLt(Cyb_F4 a, Cyb_F4 b) {return _mm_cmplt_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4CmpLe(Cyb_F4 a, Cyb_F4 b) {return _mm_cmple_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4CmpGt(Cyb_F4 a, Cyb_F4 b) {return _mm_cmpgt_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4CmpGe(Cyb_F4 a, Cyb_F4 b) {return _mm_cmpge_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4And(Cyb_F4 a, Cyb_F4 b) {return _mm_and_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Or(Cyb_F4 a, Cyb_F4 b) {return _mm_or_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Select(Cyb_F4 mask, Cyb_F4 a, Cyb_F4 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+CYB_INLINE int Cyb_F4MoveMask(Cyb_F4 mask) {return _mm_movemask_ps(mask);}
+
+#elif defined(CYB_SIMD_NEON)
+CYB_INLINE Cyb_F4 Cyb_F4Load(const float *p) {return vld1q_f32(p);}
+CYB_INLINE void Cyb_F4Store(float *p, Cyb_F4 a) {vst1q_f32(p, a);}
+CYB_INLINE Cyb_F4 Cyb_F4Set1(float a) {return vdupq_n_f32(a);}
+CYB_INLINE Cyb_F4 Cyb_F4Set(float a, float b, float c, float d)
+{
+    float tmp[4] = {a, b, c, d};
+    return vld1q_f32(tmp);
+}
+CYB_INLINE Cyb_F4 Cyb_F4Add(Cyb_F4 a, Cyb_F4 b) {return vaddq_f32(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Sub(Cyb_F4 a, Cyb_F4 b) {return vsubq_f32(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Mul(Cyb_F4 a, Cyb_F4 b) {return vmulq_f32(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Div(Cyb_F4 a, Cyb_F4 b)
+{
+#if defined(__aarch64__)
+    return vdivq_f32(a, b);
+#else
+    //Reciprocal estimate refined with 2 Newton-Raphson steps
+    float32x4_t r = vrecpeq_f32(b);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    return vmulq_f32(a, r);
+#endif
+}
+CYB_INLINE Cyb_F4 Cyb_F4Min(Cyb_F4 a, Cyb_F4 b) {return vminq_f32(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Max(Cyb_F4 a, Cyb_F4 b) {return vmaxq_f32(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Sqrt(Cyb_F4 a)
+{
+#if defined(__aarch64__)
+    return vsqrtq_f32(a);
+#else
+    //sqrt(a) = a * rsqrt(a), with 0 mapped to 0
+    float32x4_t r = vrsqrteq_f32(a);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    uint32x4_t zero = vceqq_f32(a, vdupq_n_f32(0.0f));
+    return vbslq_f32(zero, a, vmulq_f32(a, r));
+#endif
+}
+CYB_INLINE Cyb_F4 Cyb_F4Rsqrt(Cyb_F4 a)
+{
+    //8-bit estimate refined with 2 Newton-Raphson steps
+    float32x4_t r = vrsqrteq_f32(a);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    return vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+}
+CYB_INLINE Cyb_F4 Cyb_F4Round(Cyb_F4 a)
+{
+#if defined(__aarch64__)
+    return vrndnq_f32(a);
+#else
+    //Round half away from zero
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(a),
+        vdupq_n_u32(0x80000000u));
+    float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(sign,
+        vreinterpretq_u32_f32(vdupq_n_f32(.5f))));
+    return vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(a, half)));
+#endif
+}
+CYB_INLINE Cyb_F4 Cyb_F4Abs(Cyb_F4 a) {return vabsq_f32(a);}
+CYB_INLINE Cyb_F4 Cyb_F4CmpLt(Cyb_F4 a, Cyb_F4 b)
+{
+    return vreinterpretq_f32_u32(vcltq_f32(a, b));
+}
+CYB_INLINE Cyb_F4 Cyb_F4CmpLe(Cyb_F4 a, Cyb_F4 b)
+{
+    return vreinterpretq_f32_u32(vcleq_f32(a, b));
+}
+CYB_INLINE Cyb_F4 Cyb_F4CmpGt(Cyb_F4 a, Cyb_F4 b)
+{
+    return vreinterpretq_f32_u32(vcgtq_f32(a, b));
+}
+CYB_INLINE Cyb_F4 Cyb_F4CmpGe(Cyb_F4 a, Cyb_F4 b)
+{
+    return vreinterpretq_f32_u32(vcgeq_f32(a, b));
+}
+CYB_INLINE Cyb_F4 Cyb_F4And(Cyb_F4 a, Cyb_F4 b)
+{
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a),
+        vreinterpretq_u32_f32(b)));
+}
+CYB_INLINE Cyb_F4 Cyb_F4Or(Cyb_F4 a, Cyb_F4 b)
+{
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a),
+        vreinterpretq_u32_f32(b)));
+}
+CYB_INLINE Cyb_F4 Cyb_F4Select(Cyb_F4 mask, Cyb_F4 a, Cyb_F4 b)
+{
+    return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+}
+CYB_INLINE int Cyb_F4MoveMask(Cyb_F4 mask)
+{
+    static const int32_t shifts[4] = {0, 1, 2, 3};
+    uint32x4_t bits = vshlq_u32(vshrq_n_u32(vreinterpretq_u32_f32(mask), 31),
+        vld1q_s32(shifts));
+    uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return (int)(vget_lane_u32(sum, 0) | vget_lane_u32(sum, 1));
+}
+
+#else
+CYB_INLINE Cyb_F4 Cyb_F4Load(const float *p)
+{
+    Cyb_F4 r = {{p[0], p[1], p[2], p[3]}};
+    return r;
+}
+CYB_INLINE void Cyb_F4Store(float *p, Cyb_F4 a)
+{
+    p[0] = a.v[0];
+    p[1] = a.v[1];
+    p[2] = a.v[2];
+    p[3] = a.v[3];
+}
+CYB_INLINE Cyb_F4 Cyb_F4Set1(float a)
+{
+    Cyb_F4 r = {{a, a, a, a}};
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_F4Set(float a, float b, float c, float d)
+{
+    Cyb_F4 r = {{a, b, c, d}};
+    return r;
+}
+
+#define CYB_F4_OP(name, expr) \
+    CYB_INLINE Cyb_F4 name(Cyb_F4 a, Cyb_F4 b) \
+    { \
+        Cyb_F4 r; \
+        int n; \
+        for(n = 0; n < 4; n++) {r.v[n] = (expr);} \
+        return r; \
+    }
+
+CYB_INLINE float Cyb_F4Mask_(int cond)
+{
+    unsigned int bits = cond ? 0xffffffffu : 0u;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+CYB_INLINE unsigned int Cyb_F4Bits_(float f)
+{
+    unsigned int bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+CYB_INLINE float Cyb_F4FromBits_(unsigned int bits)
+{
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+CYB_F4_OP(Cyb_F4Add, a.v[n] + b.v[n])
+CYB_F4_OP(Cyb_F4Sub, a.v[n] - b.v[n])
+CYB_F4_OP(Cyb_F4Mul, a.v[n] * b.v[n])
+CYB_F4_OP(Cyb_F4Div, a.v[n] / b.v[n])
+CYB_F4_OP(Cyb_F4Min, a.v[n] < b.v[n] ? a.v[n] : b.v[n])
+CYB_F4_OP(Cyb_F4Max, a.v[n] > b.v[n] ? a.v[n] : b.v[n])
+CYB_F4_OP(Cyb_F4CmpLt, Cyb_F4Mask_(a.v[n] < b.v[n]))
+CYB_F4_OP(Cyb_F4CmpLe, Cyb_F4Mask_(a.v[n] <= b.v[n]))
+CYB_F4_OP(Cyb_F4CmpGt, Cyb_F4Mask_(a.v[n] > b.v[n]))
+CYB_F4_OP(Cyb_F4CmpGe, Cyb_F4Mask_(a.v[n] >= b.v[n]))
+CYB_F4_OP(Cyb_F4And,
+    Cyb_F4FromBits_(Cyb_F4Bits_(a.v[n]) & Cyb_F4Bits_(b.v[n])))
+CYB_F4_OP(Cyb_F4Or,
+    Cyb_F4FromBits_(Cyb_F4Bits_(a.v[n]) | Cyb_F4Bits_(b.v[n])))
+
+#undef CYB_F4_OP
+
+CYB_INLINE Cyb_F4 Cyb_F4Sqrt(Cyb_F4 a)
+{
+    Cyb_F4 r = {{sqrtf(a.v[0]), sqrtf(a.v[1]), sqrtf(a.v[2]), sqrtf(a.v[3])}};
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_F4Rsqrt(Cyb_F4 a)
+{
+    Cyb_F4 r = {{1.0f / sqrtf(a.v[0]), 1.0f / sqrtf(a.v[1]),
+        1.0f / sqrtf(a.v[2]), 1.0f / sqrtf(a.v[3])}};
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_F4Round(Cyb_F4 a)
+{
+    Cyb_F4 r = {{floorf(a.v[0] + .5f), floorf(a.v[1] + .5f),
+        floorf(a.v[2] + .5f), floorf(a.v[3] + .5f)}};
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_F4Abs(Cyb_F4 a)
+{
+    Cyb_F4 r = {{fabsf(a.v[0]), fabsf(a.v[1]), fabsf(a.v[2]), fabsf(a.v[3])}};
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_F4Select(Cyb_F4 mask, Cyb_F4 a, Cyb_F4 b)
+{
+    Cyb_F4 r;
+    int n;
+    
+    for(n = 0; n < 4; n++)
+    {
+        r.v[n] = Cyb_F4Bits_(mask.v[n]) ? a.v[n] : b.v[n];
+    }
+    
+    return r;
+}
+CYB_INLINE int Cyb_F4MoveMask(Cyb_F4 mask)
+{
+    return (int)((Cyb_F4Bits_(mask.v[0]) >> 31) |
+        ((Cyb_F4Bits_(mask.v[1]) >> 31) << 1) |
+        ((Cyb_F4Bits_(mask.v[2]) >> 31) << 2) |
+        ((Cyb_F4Bits_(mask.v[3]) >> 31) << 3));
+}
+#endif
+
+/** @brief Compute a * b + c in each lane.
+ */
+CYB_INLINE Cyb_F4 Cyb_F4MulAdd(Cyb_F4 a, Cyb_F4 b, Cyb_F4 c)
+{
+    return Cyb_F4Add(Cyb_F4Mul(a, b), c);
+}
+
+//Integer lanes
+#if defined(CYB_SIMD_SSE2)
+CYB_INLINE Cyb_I4 Cyb_I4Load(const int *p)
+{
+    return _mm_loadu_si128((const __m128i*)p);
+}
+CYB_INLINE void Cyb_I4Store(int *p, Cyb_I4 a) {_mm_storeu_si128((__m128i*)p, a);}
+CYB_INLINE Cyb_I4 Cyb_I4Set1(int a) {return _mm_set1_epi32(a);}
+CYB_INLINE Cyb_I4 Cyb_I4Add(Cyb_I4 a, Cyb_I4 b) {return _mm_add_epi32(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4Sub(Cyb_I4 a, Cyb_I4 b) {return _mm_sub_epi32(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4Mul(Cyb_I4 a, Cyb_I4 b)
+{
+#if defined(__SSE4_1__)
+    return _mm_mullo_epi32(a, b);
+#else
+    //Multiply the even and odd lanes separately and keep the low halves
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+        _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+CYB_INLINE Cyb_I4 Cyb_I4And(Cyb_I4 a, Cyb_I4 b) {return _mm_and_si128(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4Or(Cyb_I4 a, Cyb_I4 b) {return _mm_or_si128(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4Xor(Cyb_I4 a, Cyb_I4 b) {return _mm_xor_si128(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4ShiftLeft(Cyb_I4 a, int n)
+{
+    return _mm_sll_epi32(a, _mm_cvtsi32_si128(n));
+}
+CYB_INLINE Cyb_I4 Cyb_I4ShiftRight(Cyb_I4 a, int n)
+{
+    return _mm_srl_epi32(a, _mm_cvtsi32_si128(n));
+}
+CYB_INLINE Cyb_F4 Cyb_I4CmpEq(Cyb_I4 a, Cyb_I4 b)
+{
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b));
+}
+CYB_INLINE Cyb_F4 Cyb_I4CmpLt(Cyb_I4 a, Cyb_I4 b)
+{
+    return _mm_castsi128_ps(_mm_cmplt_epi32(a, b));
+}
+CYB_INLINE Cyb_I4 Cyb_F4ToI4(Cyb_F4 a) {return _mm_cvttps_epi32(a);}
+CYB_INLINE Cyb_F4 Cyb_I4ToF4(Cyb_I4 a) {return _mm_cvtepi32_ps(a);}
+CYB_INLINE Cyb_I4 Cyb_F4AsI4(Cyb_F4 a) {return _mm_castps_si128(a);}
+CYB_INLINE Cyb_F4 Cyb_I4AsF4(Cyb_I4 a) {return _mm_castsi128_ps(a);}
+CYB_INLINE Cyb_F4 Cyb_F4Xor(Cyb_F4 a, Cyb_F4 b) {return _mm_xor_ps(a, b);}
+CYB_INLINE Cyb_F4 Cyb_F4Floor(Cyb_F4 a)
+{
+#if defined(__SSE4_1__)
+    return _mm_floor_ps(a);
+#else
+    //Truncate and step down where that rounded up
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+#endif
+}
+
+#elif defined(CYB_SIMD_NEON)
+CYB_INLINE Cyb_I4 Cyb_I4Load(const int *p) {return vld1q_s32((const int32_t*)p);}
+CYB_INLINE void Cyb_I4Store(int *p, Cyb_I4 a) {vst1q_s32((int32_t*)p, a);}
+CYB_INLINE Cyb_I4 Cyb_I4Set1(int a) {return vdupq_n_s32(a);}
+CYB_INLINE Cyb_I4 Cyb_I4Add(Cyb_I4 a, Cyb_I4 b) {return vaddq_s32(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4Sub(Cyb_I4 a, Cyb_I4 b) {return vsubq_s32(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4Mul(Cyb_I4 a, Cyb_I4 b) {return vmulq_s32(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4And(Cyb_I4 a, Cyb_I4 b) {return vandq_s32(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4Or(Cyb_I4 a, Cyb_I4 b) {return vorrq_s32(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4Xor(Cyb_I4 a, Cyb_I4 b) {return veorq_s32(a, b);}
+CYB_INLINE Cyb_I4 Cyb_I4ShiftLeft(Cyb_I4 a, int n)
+{
+    return vshlq_s32(a, vdupq_n_s32(n));
+}
+CYB_INLINE Cyb_I4 Cyb_I4ShiftRight(Cyb_I4 a, int n)
+{
+    //A negative count shifts to the right
+    return vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(a),
+        vdupq_n_s32(-n)));
+}
+CYB_INLINE Cyb_F4 Cyb_I4CmpEq(Cyb_I4 a, Cyb_I4 b)
+{
+    return vreinterpretq_f32_u32(vceqq_s32(a, b));
+}
+CYB_INLINE Cyb_F4 Cyb_I4CmpLt(Cyb_I4 a, Cyb_I4 b)
+{
+    return vreinterpretq_f32_u32(vcltq_s32(a, b));
+}
+CYB_INLINE Cyb_I4 Cyb_F4ToI4(Cyb_F4 a) {return vcvtq_s32_f32(a);}
+CYB_INLINE Cyb_F4 Cyb_I4ToF4(Cyb_I4 a) {return vcvtq_f32_s32(a);}
+CYB_INLINE Cyb_I4 Cyb_F4AsI4(Cyb_F4 a) {return vreinterpretq_s32_f32(a);}
+CYB_INLINE Cyb_F4 Cyb_I4AsF4(Cyb_I4 a) {return vreinterpretq_f32_s32(a);}
+CYB_INLINE Cyb_F4 Cyb_F4Xor(Cyb_F4 a, Cyb_F4 b)
+{
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a),
+        vreinterpretq_u32_f32(b)));
+}
+CYB_INLINE Cyb_F4 Cyb_F4Floor(Cyb_F4 a)
+{
+#if defined(__aarch64__)
+    return vrndmq_f32(a);
+#else
+    //Truncate and step down where that rounded up
+    float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(a));
+    uint32x4_t up = vcgtq_f32(t, a);
+    return vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(up,
+        vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+#endif
+}
+
+#else
+CYB_INLINE Cyb_I4 Cyb_I4Load(const int *p)
+{
+    Cyb_I4 r = {{p[0], p[1], p[2], p[3]}};
+    return r;
+}
+CYB_INLINE void Cyb_I4Store(int *p, Cyb_I4 a)
+{
+    memcpy(p, a.v, sizeof(a.v));
+}
+CYB_INLINE Cyb_I4 Cyb_I4Set1(int a)
+{
+    Cyb_I4 r = {{a, a, a, a}};
+    return r;
+}
+
+//Integer math is done unsigned so that it wraps around
+#define CYB_I4_OP(name, expr) \
+    CYB_INLINE Cyb_I4 name(Cyb_I4 a, Cyb_I4 b) \
+    { \
+        Cyb_I4 r; \
+        int n; \
+        for(n = 0; n < 4; n++) \
+        { \
+            unsigned int x = (unsigned int)a.v[n]; \
+            unsigned int y = (unsigned int)b.v[n]; \
+            r.v[n] = (int)(expr); \
+        } \
+        return r; \
+    }
+
+CYB_I4_OP(Cyb_I4Add, x + y)
+CYB_I4_OP(Cyb_I4Sub, x - y)
+CYB_I4_OP(Cyb_I4Mul, x * y)
+CYB_I4_OP(Cyb_I4And, x & y)
+CYB_I4_OP(Cyb_I4Or, x | y)
+CYB_I4_OP(Cyb_I4Xor, x ^ y)
+
+#undef CYB_I4_OP
+
+CYB_INLINE Cyb_I4 Cyb_I4ShiftLeft(Cyb_I4 a, int n)
+{
+    Cyb_I4 r;
+    int i;
+    
+    for(i = 0; i < 4; i++)
+    {
+        r.v[i] = (int)((unsigned int)a.v[i] << n);
+    }
+    
+    return r;
+}
+CYB_INLINE Cyb_I4 Cyb_I4ShiftRight(Cyb_I4 a, int n)
+{
+    Cyb_I4 r;
+    int i;
+    
+    for(i = 0; i < 4; i++)
+    {
+        r.v[i] = (int)((unsigned int)a.v[i] >> n);
+    }
+    
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_I4CmpEq(Cyb_I4 a, Cyb_I4 b)
+{
+    Cyb_F4 r = {{Cyb_F4Mask_(a.v[0] == b.v[0]), Cyb_F4Mask_(a.v[1] == b.v[1]),
+        Cyb_F4Mask_(a.v[2] == b.v[2]), Cyb_F4Mask_(a.v[3] == b.v[3])}};
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_I4CmpLt(Cyb_I4 a, Cyb_I4 b)
+{
+    Cyb_F4 r = {{Cyb_F4Mask_(a.v[0] < b.v[0]), Cyb_F4Mask_(a.v[1] < b.v[1]),
+        Cyb_F4Mask_(a.v[2] < b.v[2]), Cyb_F4Mask_(a.v[3] < b.v[3])}};
+    return r;
+}
+CYB_INLINE Cyb_I4 Cyb_F4ToI4(Cyb_F4 a)
+{
+    Cyb_I4 r = {{(int)a.v[0], (int)a.v[1], (int)a.v[2], (int)a.v[3]}};
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_I4ToF4(Cyb_I4 a)
+{
+    Cyb_F4 r = {{(float)a.v[0], (float)a.v[1], (float)a.v[2], (float)a.v[3]}};
+    return r;
+}
+CYB_INLINE Cyb_I4 Cyb_F4AsI4(Cyb_F4 a)
+{
+    Cyb_I4 r;
+    memcpy(r.v, a.v, sizeof(r.v));
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_I4AsF4(Cyb_I4 a)
+{
+    Cyb_F4 r;
+    memcpy(r.v, a.v, sizeof(r.v));
+    return r;
+}
+CYB_INLINE Cyb_F4 Cyb_F4Xor(Cyb_F4 a, Cyb_F4 b)
+{
+    return Cyb_I4AsF4(Cyb_I4Xor(Cyb_F4AsI4(a), Cyb_F4AsI4(b)));
+}
+CYB_INLINE Cyb_F4 Cyb_F4Floor(Cyb_F4 a)
+{
+    Cyb_F4 r = {{floorf(a.v[0]), floorf(a.v[1]), floorf(a.v[2]),
+        floorf(a.v[3])}};
+    return r;
+}
+#endif
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
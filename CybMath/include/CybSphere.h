@@ -17,6 +17,24 @@ extern "C" {
  * @brief Cybermals Engine - 3D Math Library
  */
 
+//Enums
+//=================================================================================
+/** @brief Bounding sphere construction methods.
+ *
+ * All methods make a single pass to find an initial sphere and another to grow
+ * it until it contains every vertex. EPOS methods seed the sphere with the
+ * most distant pair of extremal points along 3, 7, or 13 directions. More
+ * directions give tighter spheres at a higher cost. The results are typically
+ * within 1 to 10 percent of the minimum sphere.
+ */
+enum Cyb_SphereMethod
+{
+    CYB_SPHERE_RITTER, /**< Ritter's method. Fastest. */
+    CYB_SPHERE_EPOS6,  /**< Extremal points along the 3 coordinate axes. */
+    CYB_SPHERE_EPOS14, /**< Adds the 4 corner diagonals. */
+    CYB_SPHERE_EPOS26  /**< Adds the 6 edge diagonals. Tightest. */
+};
+
 //Structures
 //=================================================================================
 /** @brief A sphere.
@@ -30,6 +48,18 @@ typedef struct
 
 //Functions
 //=================================================================================
+/** @brief Calculate a sphere that some given geometry will fit into.
+ *
+ * @param sphere Pointer to the resulting sphere.
+ * @param verts Pointer to some vertex data. Each vertex must start with its
+ * position.
+ * @param stride The size of each vertex.
+ * @param count The number of vertices.
+ * @param method The construction method (see Cyb_SphereMethod).
+ */
+CYBAPI void Cyb_SphereFromGeometry(Cyb_Sphere *sphere, const void *verts,
+    int stride, int count, int method);
+
 /** @brief Test if a given point is inside a given sphere.
  *
  * @param a Pointer to the point.
@@ -0,0 +1,458 @@
+#ifndef CYBWIDE_H
+#define CYBWIDE_H
+
+/** @file
+ * @brief CybMath - Wide Vector API
+ *
+ * Structure of arrays (SoA) vector types which hold 4 or 8 vectors with one
+ * SIMD register per component. They are built on the Cyb_F4 layer in CybSIMD.h
+ * and are meant for code that processes many vectors at once such as culling,
+ * skinning, particles, and physics.
+ *
+ * Each wide type provides Load and Store functions which convert to and from
+ * ordinary arrays of Cyb_Vec3 or Cyb_Vec4 (AoS). Masks returned by comparisons
+ * have the same format as in CybSIMD.h and can be passed to the Select
+ * functions.
+ *
+ * Cyb_F8 is a pair of Cyb_F4 which provides the same operations as Cyb_F4 for
+ * 8 lanes. Its MoveMask returns 8 bits.
+ *
+ * Cyb_Vec3x4 and Cyb_Vec3x8 provide the same set of functions, named
+ * Cyb_Vec3x4X and Cyb_Vec3x8X:
+ * - Load, Store, Set1
+ * - Add, Sub, Mul, Min, Max, Scale, MulAdd, Lerp
+ * - Dot, Cross, LengthSq, Length, Normalize
+ * - Select
+ */
+
+#include "CybCommon.h"
+#include "CybFastMath.h"
+#include "CybSIMD.h"
+#include "CybVec.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybMath
+ * @brief Cybermals Engine - 3D Math Library
+ * @{
+ */
+
+//Structures
+//=================================================================================
+/** @brief 8 packed floats.
+ */
+typedef struct
+{
+    Cyb_F4 lo; /**< Lanes 0 to 3. */
+    Cyb_F4 hi; /**< Lanes 4 to 7. */
+} Cyb_F8;
+
+/** @brief 4 3D vectors in SoA form.
+ */
+typedef struct
+{
+    Cyb_F4 x; /**< The X components. */
+    Cyb_F4 y; /**< The Y components. */
+    Cyb_F4 z; /**< The Z components. */
+} Cyb_Vec3x4;
+
+/** @brief 8 3D vectors in SoA form.
+ */
+typedef struct
+{
+    Cyb_F8 x; /**< The X components. */
+    Cyb_F8 y; /**< The Y components. */
+    Cyb_F8 z; /**< The Z components. */
+} Cyb_Vec3x8;
+
+/** @brief 4 quaternions in SoA form.
+ */
+typedef struct
+{
+    Cyb_F4 x; /**< The X components. */
+    Cyb_F4 y; /**< The Y components. */
+    Cyb_F4 z; /**< The Z components. */
+    Cyb_F4 w; /**< The W components. */
+} Cyb_QuatX4;
+
+
+//Functions
+//=================================================================================
+//8 lane floats
+CYB_INLINE Cyb_F8 Cyb_F8Load(const float *p)
+{
+    Cyb_F8 r = {Cyb_F4Load(p), Cyb_F4Load(p + 4)};
+    return r;
+}
+CYB_INLINE void Cyb_F8Store(float *p, Cyb_F8 a)
+{
+    Cyb_F4Store(p, a.lo);
+    Cyb_F4Store(p + 4, a.hi);
+}
+CYB_INLINE Cyb_F8 Cyb_F8Set1(float a)
+{
+    Cyb_F8 r = {Cyb_F4Set1(a), Cyb_F4Set1(a)};
+    return r;
+}
+
+#define CYB_F8_OP1(name) \
+    CYB_INLINE Cyb_F8 Cyb_F8##name(Cyb_F8 a) \
+    { \
+        Cyb_F8 r = {Cyb_F4##name(a.lo), Cyb_F4##name(a.hi)}; \
+        return r; \
+    }
+#define CYB_F8_OP2(name) \
+    CYB_INLINE Cyb_F8 Cyb_F8##name(Cyb_F8 a, Cyb_F8 b) \
+    { \
+        Cyb_F8 r = {Cyb_F4##name(a.lo, b.lo), Cyb_F4##name(a.hi, b.hi)}; \
+        return r; \
+    }
+#define CYB_F8_OP3(name) \
+    CYB_INLINE Cyb_F8 Cyb_F8##name(Cyb_F8 a, Cyb_F8 b, Cyb_F8 c) \
+    { \
+        Cyb_F8 r = {Cyb_F4##name(a.lo, b.lo, c.lo), \
+            Cyb_F4##name(a.hi, b.hi, c.hi)}; \
+        return r; \
+    }
+
+CYB_F8_OP2(Add)
+CYB_F8_OP2(Sub)
+CYB_F8_OP2(Mul)
+CYB_F8_OP2(Div)
+CYB_F8_OP2(Min)
+CYB_F8_OP2(Max)
+CYB_F8_OP1(Sqrt)
+CYB_F8_OP1(Rsqrt)
+CYB_F8_OP1(Abs)
+CYB_F8_OP1(Round)
+CYB_F8_OP2(CmpLt)
+CYB_F8_OP2(CmpLe)
+CYB_F8_OP2(CmpGt)
+CYB_F8_OP2(CmpGe)
+CYB_F8_OP2(And)
+CYB_F8_OP2(Or)
+CYB_F8_OP3(Select)
+CYB_F8_OP3(MulAdd)
+
+#undef CYB_F8_OP1
+#undef CYB_F8_OP2
+#undef CYB_F8_OP3
+
+CYB_INLINE int Cyb_F8MoveMask(Cyb_F8 mask)
+{
+    return Cyb_F4MoveMask(mask.lo) | (Cyb_F4MoveMask(mask.hi) << 4);
+}
+
+//Normalize 3 component lanes in place
+CYB_INLINE void Cyb_F8Normalize3(Cyb_F8 *x, Cyb_F8 *y, Cyb_F8 *z)
+{
+    Cyb_F4Normalize3(&x->lo, &y->lo, &z->lo);
+    Cyb_F4Normalize3(&x->hi, &y->hi, &z->hi);
+}
+
+//Wide 3D vectors
+#define CYB_VEC3XN_OPS(V, F, N) \
+    CYB_INLINE V V##Load(const Cyb_Vec3 *v) \
+    { \
+        float tmp[3][N]; \
+        int n; \
+        V r; \
+        for(n = 0; n < N; n++) \
+        { \
+            tmp[0][n] = v[n].x; \
+            tmp[1][n] = v[n].y; \
+            tmp[2][n] = v[n].z; \
+        } \
+        r.x = F##Load(tmp[0]); \
+        r.y = F##Load(tmp[1]); \
+        r.z = F##Load(tmp[2]); \
+        return r; \
+    } \
+    CYB_INLINE void V##Store(Cyb_Vec3 *v, V a) \
+    { \
+        float tmp[3][N]; \
+        int n; \
+        F##Store(tmp[0], a.x); \
+        F##Store(tmp[1], a.y); \
+        F##Store(tmp[2], a.z); \
+        for(n = 0; n < N; n++) \
+        { \
+            v[n].x = tmp[0][n]; \
+            v[n].y = tmp[1][n]; \
+            v[n].z = tmp[2][n]; \
+        } \
+    } \
+    CYB_INLINE V V##Set1(const Cyb_Vec3 *v) \
+    { \
+        V r = {F##Set1(v->x), F##Set1(v->y), F##Set1(v->z)}; \
+        return r; \
+    } \
+    CYB_INLINE V V##Add(V a, V b) \
+    { \
+        V r = {F##Add(a.x, b.x), F##Add(a.y, b.y), F##Add(a.z, b.z)}; \
+        return r; \
+    } \
+    CYB_INLINE V V##Sub(V a, V b) \
+    { \
+        V r = {F##Sub(a.x, b.x), F##Sub(a.y, b.y), F##Sub(a.z, b.z)}; \
+        return r; \
+    } \
+    CYB_INLINE V V##Mul(V a, V b) \
+    { \
+        V r = {F##Mul(a.x, b.x), F##Mul(a.y, b.y), F##Mul(a.z, b.z)}; \
+        return r; \
+    } \
+    CYB_INLINE V V##Min(V a, V b) \
+    { \
+        V r = {F##Min(a.x, b.x), F##Min(a.y, b.y), F##Min(a.z, b.z)}; \
+        return r; \
+    } \
+    CYB_INLINE V V##Max(V a, V b) \
+    { \
+        V r = {F##Max(a.x, b.x), F##Max(a.y, b.y), F##Max(a.z, b.z)}; \
+        return r; \
+    } \
+    CYB_INLINE V V##Scale(V a, F s) \
+    { \
+        V r = {F##Mul(a.x, s), F##Mul(a.y, s), F##Mul(a.z, s)}; \
+        return r; \
+    } \
+    CYB_INLINE V V##MulAdd(V a, F s, V b) \
+    { \
+        V r = {F##MulAdd(a.x, s, b.x), F##MulAdd(a.y, s, b.y), \
+            F##MulAdd(a.z, s, b.z)}; \
+        return r; \
+    } \
+    CYB_INLINE V V##Lerp(V a, V b, F t) \
+    { \
+        return V##MulAdd(V##Sub(b, a), t, a); \
+    } \
+    CYB_INLINE F V##Dot(V a, V b) \
+    { \
+        return F##MulAdd(a.x, b.x, F##MulAdd(a.y, b.y, F##Mul(a.z, b.z))); \
+    } \
+    CYB_INLINE V V##Cross(V a, V b) \
+    { \
+        V r = { \
+            F##Sub(F##Mul(a.y, b.z), F##Mul(a.z, b.y)), \
+            F##Sub(F##Mul(a.z, b.x), F##Mul(a.x, b.z)), \
+            F##Sub(F##Mul(a.x, b.y), F##Mul(a.y, b.x)) \
+        }; \
+        return r; \
+    } \
+    CYB_INLINE F V##LengthSq(V a) \
+    { \
+        return V##Dot(a, a); \
+    } \
+    CYB_INLINE F V##Length(V a) \
+    { \
+        return F##Sqrt(V##Dot(a, a)); \
+    } \
+    CYB_INLINE V V##Normalize(V a) \
+    { \
+        F##Normalize3(&a.x, &a.y, &a.z); \
+        return a; \
+    } \
+    CYB_INLINE V V##Select(F mask, V a, V b) \
+    { \
+        V r = {F##Select(mask, a.x, b.x), F##Select(mask, a.y, b.y), \
+            F##Select(mask, a.z, b.z)}; \
+        return r; \
+    }
+
+CYB_VEC3XN_OPS(Cyb_Vec3x4, Cyb_F4, 4)
+CYB_VEC3XN_OPS(Cyb_Vec3x8, Cyb_F8, 8)
+
+#undef CYB_VEC3XN_OPS
+
+/** @brief Load 4 quaternions.
+ *
+ * @param q Pointer to 4 quaternions.
+ *
+ * @return The quaternions in SoA form.
+ */
+CYB_INLINE Cyb_QuatX4 Cyb_QuatX4Load(const Cyb_Vec4 *q)
+{
+    Cyb_QuatX4 r = {
+        Cyb_F4Set(q[0].x, q[1].x, q[2].x, q[3].x),
+        Cyb_F4Set(q[0].y, q[1].y, q[2].y, q[3].y),
+        Cyb_F4Set(q[0].z, q[1].z, q[2].z, q[3].z),
+        Cyb_F4Set(q[0].w, q[1].w, q[2].w, q[3].w)
+    };
+    return r;
+}
+
+/** @brief Store 4 quaternions.
+ *
+ * @param q Pointer to an array of 4 quaternions which receives the result.
+ * @param a The quaternions in SoA form.
+ */
+CYB_INLINE void Cyb_QuatX4Store(Cyb_Vec4 *q, Cyb_QuatX4 a)
+{
+    float tmp[4][4];
+    Cyb_F4Store(tmp[0], a.x);
+    Cyb_F4Store(tmp[1], a.y);
+    Cyb_F4Store(tmp[2], a.z);
+    Cyb_F4Store(tmp[3], a.w);
+    
+    for(int n = 0; n < 4; n++)
+    {
+        q[n].x = tmp[0][n];
+        q[n].y = tmp[1][n];
+        q[n].z = tmp[2][n];
+        q[n].w = tmp[3][n];
+    }
+}
+
+/** @brief Copy a quaternion into all 4 lanes.
+ *
+ * @param q Pointer to the quaternion.
+ *
+ * @return The quaternions in SoA form.
+ */
+CYB_INLINE Cyb_QuatX4 Cyb_QuatX4Set1(const Cyb_Vec4 *q)
+{
+    Cyb_QuatX4 r = {Cyb_F4Set1(q->x), Cyb_F4Set1(q->y), Cyb_F4Set1(q->z),
+        Cyb_F4Set1(q->w)};
+    return r;
+}
+
+/** @brief Multiply 4 pairs of quaternions. Same as Cyb_MulQuat.
+ */
+CYB_INLINE Cyb_QuatX4 Cyb_QuatX4Mul(Cyb_QuatX4 a, Cyb_QuatX4 b)
+{
+    Cyb_QuatX4 r;
+    r.x = Cyb_F4Sub(Cyb_F4MulAdd(a.w, b.x, Cyb_F4MulAdd(a.x, b.w,
+        Cyb_F4Mul(a.y, b.z))), Cyb_F4Mul(a.z, b.y));
+    r.y = Cyb_F4Add(Cyb_F4Sub(Cyb_F4Mul(a.w, b.y), Cyb_F4Mul(a.x, b.z)),
+        Cyb_F4MulAdd(a.y, b.w, Cyb_F4Mul(a.z, b.x)));
+    r.z = Cyb_F4MulAdd(a.z, b.w, Cyb_F4Sub(Cyb_F4MulAdd(a.w, b.z,
+        Cyb_F4Mul(a.x, b.y)), Cyb_F4Mul(a.y, b.x)));
+    r.w = Cyb_F4Sub(Cyb_F4Mul(a.w, b.w), Cyb_F4MulAdd(a.x, b.x,
+        Cyb_F4MulAdd(a.y, b.y, Cyb_F4Mul(a.z, b.z))));
+    return r;
+}
+
+/** @brief Calculate the dot products of 4 pairs of quaternions.
+ */
+CYB_INLINE Cyb_F4 Cyb_QuatX4Dot(Cyb_QuatX4 a, Cyb_QuatX4 b)
+{
+    return Cyb_F4MulAdd(a.x, b.x, Cyb_F4MulAdd(a.y, b.y,
+        Cyb_F4MulAdd(a.z, b.z, Cyb_F4Mul(a.w, b.w))));
+}
+
+/** @brief Normalize 4 quaternions. Zero quaternions are left unchanged.
+ */
+CYB_INLINE Cyb_QuatX4 Cyb_QuatX4Normalize(Cyb_QuatX4 a)
+{
+    Cyb_F4 len2 = Cyb_QuatX4Dot(a, a);
+    Cyb_F4 scale = Cyb_F4Select(Cyb_F4CmpGt(len2, Cyb_F4Set1(0.0f)),
+        Cyb_F4Rsqrt(len2), Cyb_F4Set1(1.0f));
+    Cyb_QuatX4 r = {Cyb_F4Mul(a.x, scale), Cyb_F4Mul(a.y, scale),
+        Cyb_F4Mul(a.z, scale), Cyb_F4Mul(a.w, scale)};
+    return r;
+}
+
+/** @brief Calculate the conjugates (inverse rotations) of 4 quaternions.
+ */
+CYB_INLINE Cyb_QuatX4 Cyb_QuatX4Conjugate(Cyb_QuatX4 a)
+{
+    Cyb_F4 zero = Cyb_F4Set1(0.0f);
+    Cyb_QuatX4 r = {Cyb_F4Sub(zero, a.x), Cyb_F4Sub(zero, a.y),
+        Cyb_F4Sub(zero, a.z), a.w};
+    return r;
+}
+
+/** @brief Choose between 2 sets of quaternions per lane.
+ *
+ * @param mask The lane mask.
+ * @param a The quaternions to use where the mask is set.
+ * @param b The quaternions to use where the mask is clear.
+ */
+CYB_INLINE Cyb_QuatX4 Cyb_QuatX4Select(Cyb_F4 mask, Cyb_QuatX4 a,
+    Cyb_QuatX4 b)
+{
+    Cyb_QuatX4 r = {Cyb_F4Select(mask, a.x, b.x), Cyb_F4Select(mask, a.y, b.y),
+        Cyb_F4Select(mask, a.z, b.z), Cyb_F4Select(mask, a.w, b.w)};
+    return r;
+}
+
+/** @brief Rotate 4 vectors by 4 unit quaternions.
+ *
+ * Uses v' = v + 2w(u x v) + 2(u x (u x v)) where u is the vector part of the
+ * quaternion.
+ */
+CYB_INLINE Cyb_Vec3x4 Cyb_QuatX4Rotate(Cyb_QuatX4 q, Cyb_Vec3x4 v)
+{
+    Cyb_Vec3x4 u = {q.x, q.y, q.z};
+    Cyb_Vec3x4 t = Cyb_Vec3x4Cross(u, v);
+    t = Cyb_Vec3x4Add(t, t);
+    return Cyb_Vec3x4Add(Cyb_Vec3x4MulAdd(t, q.w, v), Cyb_Vec3x4Cross(u, t));
+}
+
+/** @brief Interpolate between 4 pairs of quaternions with normalized linear
+ * interpolation. Same as Cyb_Nlerp.
+ *
+ * @param a The start quaternions.
+ * @param b The end quaternions.
+ * @param t The amount of progress between a and b in each lane.
+ *
+ * @return The interpolated quaternions.
+ */
+CYB_INLINE Cyb_QuatX4 Cyb_QuatX4Nlerp(Cyb_QuatX4 a, Cyb_QuatX4 b, Cyb_F4 t)
+{
+    //Follow the shortest path
+    Cyb_F4 zero = Cyb_F4Set1(0.0f);
+    Cyb_F4 bt = Cyb_F4Select(Cyb_F4CmpLt(Cyb_QuatX4Dot(a, b), zero),
+        Cyb_F4Sub(zero, t), t);
+    Cyb_F4 at = Cyb_F4Sub(Cyb_F4Set1(1.0f), t);
+    Cyb_QuatX4 r = {
+        Cyb_F4MulAdd(a.x, at, Cyb_F4Mul(b.x, bt)),
+        Cyb_F4MulAdd(a.y, at, Cyb_F4Mul(b.y, bt)),
+        Cyb_F4MulAdd(a.z, at, Cyb_F4Mul(b.z, bt)),
+        Cyb_F4MulAdd(a.w, at, Cyb_F4Mul(b.w, bt))
+    };
+    return Cyb_QuatX4Normalize(r);
+}
+
+/** @brief Interpolate between 4 pairs of quaternions with approximated
+ * spherical linear interpolation. Same as Cyb_FastSlerp.
+ *
+ * @param a The start quaternions.
+ * @param b The end quaternions.
+ * @param t The amount of progress between a and b in each lane.
+ *
+ * @return The interpolated quaternions.
+ */
+CYB_INLINE Cyb_QuatX4 Cyb_QuatX4FastSlerp(Cyb_QuatX4 a, Cyb_QuatX4 b,
+    Cyb_F4 t)
+{
+    //Nlerp moves too slowly near the ends and too fast in the middle. Correct
+    //the progress with a cubic in t whose shape depends on the angle between
+    //a and b, then nlerp with it.
+    Cyb_F4 d = Cyb_F4Abs(Cyb_QuatX4Dot(a, b));
+    Cyb_F4 k1 = Cyb_F4MulAdd(d, Cyb_F4Set1(-1.43519f),
+        Cyb_F4Set1(3.55645f));
+    k1 = Cyb_F4MulAdd(d, k1, Cyb_F4Set1(-3.2452f));
+    k1 = Cyb_F4MulAdd(d, k1, Cyb_F4Set1(1.0904f));
+    Cyb_F4 k0 = Cyb_F4MulAdd(d, Cyb_F4Set1(.215638f),
+        Cyb_F4Set1(-1.06021f));
+    k0 = Cyb_F4MulAdd(d, k0, Cyb_F4Set1(.848013f));
+    Cyb_F4 h = Cyb_F4Sub(t, Cyb_F4Set1(.5f));
+    Cyb_F4 k = Cyb_F4MulAdd(Cyb_F4Mul(k1, h), h, k0);
+    Cyb_F4 c = Cyb_F4Mul(Cyb_F4Mul(t, h), Cyb_F4Sub(t, Cyb_F4Set1(1.0f)));
+    return Cyb_QuatX4Nlerp(a, b, Cyb_F4MulAdd(c, k, t));
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
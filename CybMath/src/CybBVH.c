@@ -0,0 +1,648 @@
+/*
+CybMath - Bounding Volume Hierarchy API
+*/
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "CybBVH.h"
+
+#define CYB_BVH_BINS        12
+#define CYB_BVH_LEAF_SIZE   2
+#define CYB_BVH_MAX_LEAF    8
+#define CYB_BVH_SAH_DEPTH   32
+#define CYB_BVH_STACK_SIZE  96
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    Cyb_Vec3 min;
+    Cyb_Vec3 max;
+} Cyb_Bounds;
+
+
+typedef struct
+{
+    Cyb_Vec3 min;
+    int offset; //right child for interior nodes, first item for leaves
+    Cyb_Vec3 max;
+    int count;  //0 for interior nodes
+} Cyb_BVHNode;
+
+
+struct Cyb_BVH
+{
+    int count;
+    int nodeCount;
+    Cyb_BVHNode *nodes;
+    Cyb_Bounds *bounds;
+    int *indices;
+};
+
+
+typedef struct
+{
+    Cyb_BVH *bvh;
+    Cyb_Bounds *itemBounds;
+    Cyb_Vec3 *centroids;
+} Cyb_BVHBuilder;
+
+
+typedef struct
+{
+    Cyb_Vec3 origin;
+    Cyb_Vec3 invDir;
+} Cyb_RayInv;
+
+
+//Functions
+//=================================================================================
+static void Cyb_EmptyBounds(Cyb_Bounds *b)
+{
+    b->min.x = b->min.y = b->min.z = INFINITY;
+    b->max.x = b->max.y = b->max.z = -INFINITY;
+}
+
+
+static void Cyb_BoundsFromBox(Cyb_Bounds *b, const Cyb_Box *box)
+{
+    b->min.x = box->center.x - box->size.x / 2.0f;
+    b->min.y = box->center.y - box->size.y / 2.0f;
+    b->min.z = box->center.z - box->size.z / 2.0f;
+    b->max.x = box->center.x + box->size.x / 2.0f;
+    b->max.y = box->center.y + box->size.y / 2.0f;
+    b->max.z = box->center.z + box->size.z / 2.0f;
+}
+
+
+static void Cyb_GrowBounds(Cyb_Bounds *b, const Cyb_Vec3 *lo,
+    const Cyb_Vec3 *hi)
+{
+    b->min.x = lo->x < b->min.x ? lo->x : b->min.x;
+    b->min.y = lo->y < b->min.y ? lo->y : b->min.y;
+    b->min.z = lo->z < b->min.z ? lo->z : b->min.z;
+    b->max.x = hi->x > b->max.x ? hi->x : b->max.x;
+    b->max.y = hi->y > b->max.y ? hi->y : b->max.y;
+    b->max.z = hi->z > b->max.z ? hi->z : b->max.z;
+}
+
+
+static float Cyb_BoundsArea(const Cyb_Bounds *b)
+{
+    float x = b->max.x - b->min.x;
+    float y = b->max.y - b->min.y;
+    float z = b->max.z - b->min.z;
+    return x * y + y * z + z * x;
+}
+
+
+static int Cyb_RayHitNode(const Cyb_RayInv *ray, const Cyb_Vec3 *lo,
+    const Cyb_Vec3 *hi, float tmax, float *t)
+{
+    float tx0 = (lo->x - ray->origin.x) * ray->invDir.x;
+    float tx1 = (hi->x - ray->origin.x) * ray->invDir.x;
+    float ty0 = (lo->y - ray->origin.y) * ray->invDir.y;
+    float ty1 = (hi->y - ray->origin.y) * ray->invDir.y;
+    float tz0 = (lo->z - ray->origin.z) * ray->invDir.z;
+    float tz1 = (hi->z - ray->origin.z) * ray->invDir.z;
+    float tnear = min(tx0, tx1);
+    float tfar = max(tx0, tx1);
+    tnear = max(tnear, min(ty0, ty1));
+    tfar = min(tfar, max(ty0, ty1));
+    tnear = max(tnear, min(tz0, tz1));
+    tfar = min(tfar, max(tz0, tz1));
+    tnear = max(tnear, 0.0f);
+    tfar = min(tfar, tmax);
+    *t = tnear;
+    return tnear <= tfar;
+}
+
+
+static void Cyb_InvertRay(Cyb_RayInv *out, const Cyb_Ray *ray)
+{
+    //Avoid 0 * inf when the origin lies on a slab boundary
+    out->origin = ray->origin;
+    out->invDir.x = 1.0f / (ray->dir.x != 0.0f ? ray->dir.x : 1e-30f);
+    out->invDir.y = 1.0f / (ray->dir.y != 0.0f ? ray->dir.y : 1e-30f);
+    out->invDir.z = 1.0f / (ray->dir.z != 0.0f ? ray->dir.z : 1e-30f);
+}
+
+
+static int Cyb_BuildNode(Cyb_BVHBuilder *builder, int first, int count,
+    int depth)
+{
+    Cyb_BVH *bvh = builder->bvh;
+    int *indices = bvh->indices;
+    int nodeIndex = bvh->nodeCount++;
+    
+    //Calculate node and centroid bounds
+    Cyb_Bounds bounds;
+    Cyb_Bounds centroidBounds;
+    Cyb_EmptyBounds(&bounds);
+    Cyb_EmptyBounds(&centroidBounds);
+    
+    for(int i = first; i < first + count; i++)
+    {
+        const Cyb_Bounds *item = &builder->itemBounds[indices[i]];
+        const Cyb_Vec3 *c = &builder->centroids[indices[i]];
+        Cyb_GrowBounds(&bounds, &item->min, &item->max);
+        Cyb_GrowBounds(&centroidBounds, c, c);
+    }
+    
+    bvh->nodes[nodeIndex].min = bounds.min;
+    bvh->nodes[nodeIndex].max = bounds.max;
+    
+    //Small enough for a leaf?
+    if(count <= CYB_BVH_LEAF_SIZE)
+    {
+        bvh->nodes[nodeIndex].offset = first;
+        bvh->nodes[nodeIndex].count = count;
+        return nodeIndex;
+    }
+    
+    //Find the cheapest binned split on any axis
+    int bestAxis = -1;
+    int bestBin = 0;
+    float bestCost = INFINITY;
+    const float *cmin = &centroidBounds.min.x;
+    const float *cmax = &centroidBounds.max.x;
+    
+    for(int axis = 0; axis < 3 && depth < CYB_BVH_SAH_DEPTH; axis++)
+    {
+        float extent = cmax[axis] - cmin[axis];
+        
+        if(extent <= 0.0f)
+        {
+            continue;
+        }
+        
+        //Bin the items
+        Cyb_Bounds bins[CYB_BVH_BINS];
+        int binCounts[CYB_BVH_BINS] = {0};
+        float scale = CYB_BVH_BINS / extent;
+        
+        for(int b = 0; b < CYB_BVH_BINS; b++)
+        {
+            Cyb_EmptyBounds(&bins[b]);
+        }
+        
+        for(int i = first; i < first + count; i++)
+        {
+            const float *c = &builder->centroids[indices[i]].x;
+            const Cyb_Bounds *item = &builder->itemBounds[indices[i]];
+            int b = (int)((c[axis] - cmin[axis]) * scale);
+            b = min(b, CYB_BVH_BINS - 1);
+            binCounts[b]++;
+            Cyb_GrowBounds(&bins[b], &item->min, &item->max);
+        }
+        
+        //Sweep from the right to get the cost of each right side
+        float rightArea[CYB_BVH_BINS];
+        int rightCount[CYB_BVH_BINS];
+        Cyb_Bounds acc;
+        int accCount = 0;
+        Cyb_EmptyBounds(&acc);
+        
+        for(int b = CYB_BVH_BINS - 1; b > 0; b--)
+        {
+            Cyb_GrowBounds(&acc, &bins[b].min, &bins[b].max);
+            accCount += binCounts[b];
+            rightArea[b] = accCount ? Cyb_BoundsArea(&acc) : 0.0f;
+            rightCount[b] = accCount;
+        }
+        
+        //Sweep from the left and evaluate each split plane
+        Cyb_EmptyBounds(&acc);
+        accCount = 0;
+        
+        for(int b = 0; b < CYB_BVH_BINS - 1; b++)
+        {
+            Cyb_GrowBounds(&acc, &bins[b].min, &bins[b].max);
+            accCount += binCounts[b];
+            
+            if(!accCount || !rightCount[b + 1])
+            {
+                continue;
+            }
+            
+            float cost = Cyb_BoundsArea(&acc) * accCount +
+                rightArea[b + 1] * rightCount[b + 1];
+            
+            if(cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = b;
+            }
+        }
+    }
+    
+    //Is a leaf cheaper than the best split?
+    float leafCost = Cyb_BoundsArea(&bounds) * count;
+    
+    if(count <= CYB_BVH_MAX_LEAF && (bestAxis < 0 || bestCost >= leafCost))
+    {
+        bvh->nodes[nodeIndex].offset = first;
+        bvh->nodes[nodeIndex].count = count;
+        return nodeIndex;
+    }
+    
+    //Partition the items
+    int mid = first;
+    
+    if(bestAxis >= 0)
+    {
+        float scale = CYB_BVH_BINS / (cmax[bestAxis] - cmin[bestAxis]);
+        int j = first + count - 1;
+        
+        while(mid <= j)
+        {
+            const float *c = &builder->centroids[indices[mid]].x;
+            int b = (int)((c[bestAxis] - cmin[bestAxis]) * scale);
+            
+            if(min(b, CYB_BVH_BINS - 1) <= bestBin)
+            {
+                mid++;
+            }
+            else
+            {
+                int tmp = indices[mid];
+                indices[mid] = indices[j];
+                indices[j--] = tmp;
+            }
+        }
+    }
+    
+    //Fall back to splitting the items in half if the split failed or the tree
+    //is too deep
+    if(mid == first || mid == first + count)
+    {
+        mid = first + count / 2;
+    }
+    
+    //Build children (the left child is always the next node)
+    Cyb_BuildNode(builder, first, mid - first, depth + 1);
+    int right = Cyb_BuildNode(builder, mid, first + count - mid, depth + 1);
+    bvh->nodes[nodeIndex].offset = right;
+    bvh->nodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+
+Cyb_BVH *Cyb_CreateBVH(const Cyb_Box *boxes, int count)
+{
+    //Allocate new BVH
+    Cyb_BVH *bvh = (Cyb_BVH*)calloc(1, sizeof(Cyb_BVH));
+    
+    if(!bvh)
+    {
+        return NULL;
+    }
+    
+    int maxNodes = count > 0 ? count * 2 - 1 : 1;
+    bvh->count = count;
+    bvh->nodes = (Cyb_BVHNode*)malloc(sizeof(Cyb_BVHNode) * maxNodes);
+    bvh->bounds = (Cyb_Bounds*)malloc(sizeof(Cyb_Bounds) * (count + 1));
+    bvh->indices = (int*)malloc(sizeof(int) * (count + 1));
+    
+    //Allocate temp build data
+    Cyb_BVHBuilder builder;
+    builder.bvh = bvh;
+    builder.itemBounds = (Cyb_Bounds*)malloc(sizeof(Cyb_Bounds) *
+        (count + 1));
+    builder.centroids = (Cyb_Vec3*)malloc(sizeof(Cyb_Vec3) * (count + 1));
+    
+    if(!bvh->nodes || !bvh->bounds || !bvh->indices || !builder.itemBounds ||
+        !builder.centroids)
+    {
+        free(builder.itemBounds);
+        free(builder.centroids);
+        Cyb_FreeBVH(bvh);
+        return NULL;
+    }
+    
+    //Empty tree?
+    if(count <= 0)
+    {
+        bvh->nodes[0].min.x = bvh->nodes[0].min.y = bvh->nodes[0].min.z = 0.0f;
+        bvh->nodes[0].max = bvh->nodes[0].min;
+        bvh->nodes[0].offset = 0;
+        bvh->nodes[0].count = 0;
+        bvh->nodeCount = 1;
+        bvh->count = 0;
+        free(builder.itemBounds);
+        free(builder.centroids);
+        return bvh;
+    }
+    
+    //Calculate item bounds and centroids
+    for(int i = 0; i < count; i++)
+    {
+        Cyb_BoundsFromBox(&builder.itemBounds[i], &boxes[i]);
+        builder.centroids[i] = boxes[i].center;
+        bvh->indices[i] = i;
+    }
+    
+    //Build the tree
+    Cyb_BuildNode(&builder, 0, count, 0);
+    
+    //Store the item bounds in leaf order
+    for(int i = 0; i < count; i++)
+    {
+        bvh->bounds[i] = builder.itemBounds[bvh->indices[i]];
+    }
+    
+    free(builder.itemBounds);
+    free(builder.centroids);
+    return bvh;
+}
+
+
+void Cyb_FreeBVH(Cyb_BVH *bvh)
+{
+    if(!bvh)
+    {
+        return;
+    }
+    
+    free(bvh->nodes);
+    free(bvh->bounds);
+    free(bvh->indices);
+    free(bvh);
+}
+
+
+void Cyb_RefitBVH(Cyb_BVH *bvh, const Cyb_Box *boxes)
+{
+    //Update the item bounds
+    for(int i = 0; i < bvh->count; i++)
+    {
+        Cyb_BoundsFromBox(&bvh->bounds[i], &boxes[bvh->indices[i]]);
+    }
+    
+    //Children always follow their parents, so a reverse sweep updates the
+    //tree from the bottom up
+    for(int i = bvh->nodeCount - 1; i >= 0 && bvh->count > 0; i--)
+    {
+        Cyb_BVHNode *node = &bvh->nodes[i];
+        Cyb_Bounds bounds;
+        Cyb_EmptyBounds(&bounds);
+        
+        if(node->count)
+        {
+            for(int j = node->offset; j < node->offset + node->count; j++)
+            {
+                Cyb_GrowBounds(&bounds, &bvh->bounds[j].min,
+                    &bvh->bounds[j].max);
+            }
+        }
+        else
+        {
+            const Cyb_BVHNode *left = &bvh->nodes[i + 1];
+            const Cyb_BVHNode *right = &bvh->nodes[node->offset];
+            Cyb_GrowBounds(&bounds, &left->min, &left->max);
+            Cyb_GrowBounds(&bounds, &right->min, &right->max);
+        }
+        
+        node->min = bounds.min;
+        node->max = bounds.max;
+    }
+}
+
+
+void Cyb_GetBVHBounds(const Cyb_BVH *bvh, Cyb_Box *box)
+{
+    const Cyb_BVHNode *root = &bvh->nodes[0];
+    box->size.x = root->max.x - root->min.x;
+    box->size.y = root->max.y - root->min.y;
+    box->size.z = root->max.z - root->min.z;
+    box->center.x = root->min.x + box->size.x / 2.0f;
+    box->center.y = root->min.y + box->size.y / 2.0f;
+    box->center.z = root->min.z + box->size.z / 2.0f;
+}
+
+
+int Cyb_QueryBVH(const Cyb_BVH *bvh, const Cyb_Box *box, int *hits,
+    int maxHits)
+{
+    Cyb_Bounds query;
+    Cyb_BoundsFromBox(&query, box);
+    int stack[CYB_BVH_STACK_SIZE];
+    int top = 0;
+    int hitCount = 0;
+    
+    if(!bvh->count)
+    {
+        return 0;
+    }
+    
+    stack[top++] = 0;
+    
+    while(top)
+    {
+        const Cyb_BVHNode *node = &bvh->nodes[stack[--top]];
+        
+        //Skip nodes that don't overlap the query box
+        if(node->min.x > query.max.x || node->max.x < query.min.x ||
+            node->min.y > query.max.y || node->max.y < query.min.y ||
+            node->min.z > query.max.z || node->max.z < query.min.z)
+        {
+            continue;
+        }
+        
+        //Interior node?
+        if(!node->count)
+        {
+            stack[top++] = node->offset;
+            stack[top++] = (int)(node - bvh->nodes) + 1;
+            continue;
+        }
+        
+        //Test the items (same rules as Cyb_BoxHitBox)
+        for(int i = node->offset; i < node->offset + node->count; i++)
+        {
+            const Cyb_Bounds *item = &bvh->bounds[i];
+            
+            if(item->min.x < query.max.x && item->max.x > query.min.x &&
+                item->min.y < query.max.y && item->max.y > query.min.y &&
+                item->min.z < query.max.z && item->max.z > query.min.z)
+            {
+                if(hitCount < maxHits)
+                {
+                    hits[hitCount] = bvh->indices[i];
+                }
+                
+                hitCount++;
+            }
+        }
+    }
+    
+    return hitCount;
+}
+
+
+int Cyb_RayCastBVH(const Cyb_BVH *bvh, const Cyb_Ray *ray,
+    float maxDist, int *hits, int maxHits)
+{
+    Cyb_RayInv inv;
+    Cyb_InvertRay(&inv, ray);
+    int stack[CYB_BVH_STACK_SIZE];
+    int top = 0;
+    int hitCount = 0;
+    float t;
+    
+    if(!bvh->count)
+    {
+        return 0;
+    }
+    
+    stack[top++] = 0;
+    
+    while(top)
+    {
+        const Cyb_BVHNode *node = &bvh->nodes[stack[--top]];
+        
+        if(!Cyb_RayHitNode(&inv, &node->min, &node->max, maxDist, &t))
+        {
+            continue;
+        }
+        
+        //Interior node?
+        if(!node->count)
+        {
+            stack[top++] = node->offset;
+            stack[top++] = (int)(node - bvh->nodes) + 1;
+            continue;
+        }
+        
+        //Test the items
+        for(int i = node->offset; i < node->offset + node->count; i++)
+        {
+            if(Cyb_RayHitNode(&inv, &bvh->bounds[i].min, &bvh->bounds[i].max,
+                maxDist, &t))
+            {
+                if(hitCount < maxHits)
+                {
+                    hits[hitCount] = bvh->indices[i];
+                }
+                
+                hitCount++;
+            }
+        }
+    }
+    
+    return hitCount;
+}
+
+
+int Cyb_RayClosestBVH(const Cyb_BVH *bvh, const Cyb_Ray *ray,
+    float maxDist, Cyb_BVHRayProc proc, void *data, float *t)
+{
+    Cyb_RayInv inv;
+    Cyb_InvertRay(&inv, ray);
+    int stack[CYB_BVH_STACK_SIZE];
+    float stackDist[CYB_BVH_STACK_SIZE];
+    int top = 0;
+    int closest = -1;
+    float best = maxDist;
+    float tnode;
+    
+    if(!bvh->count ||
+        !Cyb_RayHitNode(&inv, &bvh->nodes[0].min, &bvh->nodes[0].max, best,
+        &tnode))
+    {
+        return -1;
+    }
+    
+    stack[top] = 0;
+    stackDist[top++] = tnode;
+    
+    while(top)
+    {
+        //Skip nodes that are further away than the closest hit
+        top--;
+        
+        if(stackDist[top] > best)
+        {
+            continue;
+        }
+        
+        const Cyb_BVHNode *node = &bvh->nodes[stack[top]];
+        
+        //Interior node?
+        if(!node->count)
+        {
+            //Push the far child first so the near child is visited first
+            int left = (int)(node - bvh->nodes) + 1;
+            int right = node->offset;
+            float tleft;
+            float tright;
+            int hitLeft = Cyb_RayHitNode(&inv, &bvh->nodes[left].min,
+                &bvh->nodes[left].max, best, &tleft);
+            int hitRight = Cyb_RayHitNode(&inv, &bvh->nodes[right].min,
+                &bvh->nodes[right].max, best, &tright);
+            
+            if(hitLeft && hitRight)
+            {
+                if(tleft <= tright)
+                {
+                    stack[top] = right;
+                    stackDist[top++] = tright;
+                    stack[top] = left;
+                    stackDist[top++] = tleft;
+                }
+                else
+                {
+                    stack[top] = left;
+                    stackDist[top++] = tleft;
+                    stack[top] = right;
+                    stackDist[top++] = tright;
+                }
+            }
+            else if(hitLeft)
+            {
+                stack[top] = left;
+                stackDist[top++] = tleft;
+            }
+            else if(hitRight)
+            {
+                stack[top] = right;
+                stackDist[top++] = tright;
+            }
+            
+            continue;
+        }
+        
+        //Test the items
+        for(int i = node->offset; i < node->offset + node->count; i++)
+        {
+            float titem;
+            
+            if(!Cyb_RayHitNode(&inv, &bvh->bounds[i].min, &bvh->bounds[i].max,
+                best, &titem))
+            {
+                continue;
+            }
+            
+            if(proc && !proc(data, bvh->indices[i], ray, &titem))
+            {
+                continue;
+            }
+            
+            if(titem <= best)
+            {
+                best = titem;
+                closest = bvh->indices[i];
+            }
+        }
+    }
+    
+    if(closest >= 0 && t)
+    {
+        *t = best;
+    }
+    
+    return closest;
+}
\ No newline at end of file
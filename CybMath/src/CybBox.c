@@ -6,40 +6,48 @@ CybMath - Box API
 #include <string.h>
 
 #include "CybBox.h"
+#include "CybSIMD.h"
 
 
 //Functions
 //=================================================================================
 void Cyb_BoxFromGeometry(Cyb_Box *box, void *verts, int stride, int count)
 {
-    //Calculate minimum and maximum x, y, and z values
-    float xmin = 0;
-    float xmax = 0;
-    float ymin = 0;
-    float ymax = 0;
-    float zmin = 0;
-    float zmax = 0;
-    Cyb_Vec3 *vert = (Cyb_Vec3*)verts;
+    //No vertices?
+    if(count <= 0)
+    {
+        memset(box, 0, sizeof(Cyb_Box));
+        return;
+    }
+    
+    //Calculate minimum and maximum x, y, and z values in a single pass. Every
+    //vertex but the last is followed by at least 1 more float, so it can be
+    //loaded as 4 lanes with the 4th lane ignored.
+    const char *vert = (const char*)verts;
+    const Cyb_Vec3 *last = (const Cyb_Vec3*)(vert + (count - 1) * stride);
+    Cyb_F4 lo = Cyb_F4Set(last->x, last->y, last->z, 0.0f);
+    Cyb_F4 hi = lo;
     
-    for(int i = 0; i < count; i++)
+    for(int i = 0; i < count - 1; i++)
     {
         //Process next vertex
-        xmin = min(xmin, vert->x);
-        xmax = max(xmax, vert->x);
-        ymin = min(ymin, vert->y);
-        ymax = max(ymax, vert->y);
-        zmin = min(zmin, vert->z);
-        zmax = max(zmax, vert->z);
-        vert = (Cyb_Vec3*)((char*)vert + stride);
+        Cyb_F4 p = Cyb_F4Load((const float*)vert);
+        lo = Cyb_F4Min(lo, p);
+        hi = Cyb_F4Max(hi, p);
+        vert += stride;
     }
     
     //Calculate size and center
-    box->size.x = xmax - xmin;
-    box->size.y = ymax - ymin;
-    box->size.z = zmax - zmin;
-    box->center.x = xmin + box->size.x / 2.0f;
-    box->center.y = ymin + box->size.y / 2.0f;
-    box->center.z = zmin + box->size.z / 2.0f;
+    float loXYZ[4];
+    float hiXYZ[4];
+    Cyb_F4Store(loXYZ, lo);
+    Cyb_F4Store(hiXYZ, hi);
+    box->size.x = hiXYZ[0] - loXYZ[0];
+    box->size.y = hiXYZ[1] - loXYZ[1];
+    box->size.z = hiXYZ[2] - loXYZ[2];
+    box->center.x = loXYZ[0] + box->size.x / 2.0f;
+    box->center.y = loXYZ[1] + box->size.y / 2.0f;
+    box->center.z = loXYZ[2] + box->size.z / 2.0f;
 }
 
 
@@ -85,7 +93,7 @@ void Cyb_GenerateBoxGeometry(Cyb_Vec3 *verts, int *indices,
     verts[2].z = front;
     verts[3].x = right;
     verts[3].y = bottom;
-    verts[3].y = front;
+    verts[3].z = front;
     
     verts[4].x = left;
     verts[4].y = top;
@@ -98,7 +106,7 @@ void Cyb_GenerateBoxGeometry(Cyb_Vec3 *verts, int *indices,
     verts[6].z = back;
     verts[7].x = right;
     verts[7].y = bottom;
-    verts[7].y = back;
+    verts[7].z = back;
     
     //Generate indices
     if(!indices)
@@ -153,21 +161,19 @@ void Cyb_GenerateBoxGeometry(Cyb_Vec3 *verts, int *indices,
 void Cyb_RotateBox(Cyb_Box *out, const Cyb_Box *in, 
     float x, float y, float z, int rotOrder)
 {
-    //Generate box geometry and rotate it
-    Cyb_Vec3 verts[8];
-    Cyb_GenerateBoxGeometry(verts, NULL, in);
+    //Rotate the center and project the rotated extents back onto each axis
+    //(Arvo's method). This gives the same box as rotating all 8 corners.
     Cyb_Mat4 r;
     Cyb_Rotate(&r, x, y, z, rotOrder);
-    
-    for(int i = 0; i < sizeof(verts) / sizeof(verts[0]); i++)
-    {
-        //Transform next vertex
-        Cyb_Vec3 tmp;
-        Cyb_Transform(&tmp, &r, &verts[i]);
-        memcpy(&verts[i], &tmp, sizeof(tmp));
-    }
-    
-    //Generate new bounding box
-    Cyb_BoxFromGeometry(out, verts, sizeof(Cyb_Vec3), 
-        sizeof(verts) / sizeof(verts[0]));
+    Cyb_Vec3 center = in->center;
+    Cyb_Vec3 size = in->size;
+    out->center.x = r.a * center.x + r.b * center.y + r.c * center.z;
+    out->center.y = r.e * center.x + r.f * center.y + r.g * center.z;
+    out->center.z = r.i * center.x + r.j * center.y + r.k * center.z;
+    out->size.x = fabsf(r.a) * size.x + fabsf(r.b) * size.y + 
+        fabsf(r.c) * size.z;
+    out->size.y = fabsf(r.e) * size.x + fabsf(r.f) * size.y + 
+        fabsf(r.g) * size.z;
+    out->size.z = fabsf(r.i) * size.x + fabsf(r.j) * size.y + 
+        fabsf(r.k) * size.z;
 }
\ No newline at end of file
@@ -0,0 +1,802 @@
+/*
+CybMath - Broad Phase API
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CybBroadPhase.h"
+
+#define CYB_HASH_MIN_BUCKETS 1024
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    float min[3];
+    float max[3];
+} Cyb_BPBounds;
+
+
+typedef struct
+{
+    Cyb_BPBounds bounds;
+    int lo[3];
+    int hi[3];
+    int firstEntry;
+    int active;
+} Cyb_HashObject;
+
+
+typedef struct
+{
+    int object;
+    int cell[3];
+    int bucket;
+    int prev;
+    int next;
+    int objNext;
+} Cyb_HashEntry;
+
+
+struct Cyb_SpatialHash
+{
+    float cellSize;
+    float invCellSize;
+    Cyb_HashObject *objects;
+    int objectCapacity;
+    Cyb_HashEntry *entries;
+    int entryCapacity;
+    int entryCount;
+    int freeEntry;
+    int *buckets;
+    int bucketCount;
+    unsigned int *stamps;
+    unsigned int stamp;
+};
+
+
+typedef struct
+{
+    float key;
+    int id;
+} Cyb_SortKey;
+
+
+struct Cyb_SweepAndPrune
+{
+    int count;
+    int capacity;
+    int axis;
+    Cyb_BPBounds *bounds;
+    Cyb_BPBounds *sorted;
+    int *order;
+    Cyb_SortKey *keys;
+};
+
+
+//Functions
+//=================================================================================
+static void Cyb_BPBoundsFromBox(Cyb_BPBounds *b, const Cyb_Box *box)
+{
+    b->min[0] = box->center.x - box->size.x / 2.0f;
+    b->min[1] = box->center.y - box->size.y / 2.0f;
+    b->min[2] = box->center.z - box->size.z / 2.0f;
+    b->max[0] = box->center.x + box->size.x / 2.0f;
+    b->max[1] = box->center.y + box->size.y / 2.0f;
+    b->max[2] = box->center.z + box->size.z / 2.0f;
+}
+
+
+static void Cyb_BoxFromSphere(Cyb_Box *box, const Cyb_Sphere *sphere)
+{
+    box->center = sphere->center;
+    box->size.x = box->size.y = box->size.z = sphere->radius * 2.0f;
+}
+
+
+static int Cyb_BPBoundsOverlap(const Cyb_BPBounds *a, const Cyb_BPBounds *b)
+{
+    //Same rules as Cyb_BoxHitBox
+    return (a->min[0] < b->max[0] && a->max[0] > b->min[0] &&
+        a->min[1] < b->max[1] && a->max[1] > b->min[1] &&
+        a->min[2] < b->max[2] && a->max[2] > b->min[2]);
+}
+
+
+static int Cyb_HashCell(const Cyb_SpatialHash *hash, const int *cell)
+{
+    unsigned int h = (unsigned int)cell[0] * 73856093u ^
+        (unsigned int)cell[1] * 19349663u ^ (unsigned int)cell[2] * 83492791u;
+    return (int)(h & (unsigned int)(hash->bucketCount - 1));
+}
+
+
+static int Cyb_AllocHashEntry(Cyb_SpatialHash *hash)
+{
+    //Reuse a free entry?
+    if(hash->freeEntry >= 0)
+    {
+        int entry = hash->freeEntry;
+        hash->freeEntry = hash->entries[entry].next;
+        return entry;
+    }
+    
+    //Grow entry pool?
+    if(hash->entryCount == hash->entryCapacity)
+    {
+        int capacity = hash->entryCapacity ? hash->entryCapacity * 2 : 1024;
+        Cyb_HashEntry *entries = (Cyb_HashEntry*)realloc(hash->entries,
+            sizeof(Cyb_HashEntry) * capacity);
+        
+        if(!entries)
+        {
+            return -1;
+        }
+        
+        hash->entries = entries;
+        hash->entryCapacity = capacity;
+    }
+    
+    return hash->entryCount++;
+}
+
+
+static void Cyb_LinkHashEntry(Cyb_SpatialHash *hash, int entry)
+{
+    Cyb_HashEntry *e = &hash->entries[entry];
+    e->bucket = Cyb_HashCell(hash, e->cell);
+    e->prev = -1;
+    e->next = hash->buckets[e->bucket];
+    
+    if(e->next >= 0)
+    {
+        hash->entries[e->next].prev = entry;
+    }
+    
+    hash->buckets[e->bucket] = entry;
+}
+
+
+static int Cyb_GrowBuckets(Cyb_SpatialHash *hash)
+{
+    //Keep roughly 1 entry per bucket
+    int live = hash->entryCount;
+    
+    if(live <= hash->bucketCount)
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    int count = hash->bucketCount;
+    
+    while(count < live)
+    {
+        count *= 2;
+    }
+    
+    int *buckets = (int*)malloc(sizeof(int) * count);
+    
+    if(!buckets)
+    {
+        return CYB_ERROR;
+    }
+    
+    free(hash->buckets);
+    hash->buckets = buckets;
+    hash->bucketCount = count;
+    memset(buckets, 0xff, sizeof(int) * count);
+    
+    //Relink all live entries
+    for(int i = 0; i < hash->objectCapacity; i++)
+    {
+        for(int e = hash->objects[i].firstEntry; e >= 0;
+            e = hash->entries[e].objNext)
+        {
+            Cyb_LinkHashEntry(hash, e);
+        }
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+static void Cyb_UnlinkHashObject(Cyb_SpatialHash *hash, Cyb_HashObject *obj)
+{
+    int entry = obj->firstEntry;
+    
+    while(entry >= 0)
+    {
+        Cyb_HashEntry *e = &hash->entries[entry];
+        int objNext = e->objNext;
+        
+        //Remove from bucket chain
+        if(e->prev >= 0)
+        {
+            hash->entries[e->prev].next = e->next;
+        }
+        else
+        {
+            hash->buckets[e->bucket] = e->next;
+        }
+        
+        if(e->next >= 0)
+        {
+            hash->entries[e->next].prev = e->prev;
+        }
+        
+        //Add to free list
+        e->next = hash->freeEntry;
+        hash->freeEntry = entry;
+        entry = objNext;
+    }
+    
+    obj->firstEntry = -1;
+}
+
+
+static void Cyb_CellRange(const Cyb_SpatialHash *hash, const Cyb_BPBounds *b,
+    int *lo, int *hi)
+{
+    for(int i = 0; i < 3; i++)
+    {
+        lo[i] = (int)floorf(b->min[i] * hash->invCellSize);
+        hi[i] = (int)floorf(b->max[i] * hash->invCellSize);
+    }
+}
+
+
+Cyb_SpatialHash *Cyb_CreateSpatialHash(float cellSize)
+{
+    //Allocate new spatial hash
+    Cyb_SpatialHash *hash = (Cyb_SpatialHash*)calloc(1,
+        sizeof(Cyb_SpatialHash));
+    
+    if(!hash)
+    {
+        return NULL;
+    }
+    
+    hash->buckets = (int*)malloc(sizeof(int) * CYB_HASH_MIN_BUCKETS);
+    
+    if(!hash->buckets)
+    {
+        free(hash);
+        return NULL;
+    }
+    
+    //Initialize the spatial hash
+    hash->cellSize = cellSize;
+    hash->invCellSize = 1.0f / cellSize;
+    hash->bucketCount = CYB_HASH_MIN_BUCKETS;
+    hash->freeEntry = -1;
+    memset(hash->buckets, 0xff, sizeof(int) * CYB_HASH_MIN_BUCKETS);
+    return hash;
+}
+
+
+void Cyb_FreeSpatialHash(Cyb_SpatialHash *hash)
+{
+    if(!hash)
+    {
+        return;
+    }
+    
+    free(hash->objects);
+    free(hash->entries);
+    free(hash->buckets);
+    free(hash->stamps);
+    free(hash);
+}
+
+
+int Cyb_SetSpatialHashBox(Cyb_SpatialHash *hash, int id, const Cyb_Box *box)
+{
+    //Grow object array?
+    if(id >= hash->objectCapacity)
+    {
+        int capacity = hash->objectCapacity ? hash->objectCapacity : 64;
+        
+        while(capacity <= id)
+        {
+            capacity *= 2;
+        }
+        
+        Cyb_HashObject *objects = (Cyb_HashObject*)realloc(hash->objects,
+            sizeof(Cyb_HashObject) * capacity);
+        
+        if(!objects)
+        {
+            return CYB_ERROR;
+        }
+        
+        hash->objects = objects;
+        unsigned int *stamps = (unsigned int*)realloc(hash->stamps,
+            sizeof(unsigned int) * capacity);
+        
+        if(!stamps)
+        {
+            return CYB_ERROR;
+        }
+        
+        hash->stamps = stamps;
+        
+        for(int i = hash->objectCapacity; i < capacity; i++)
+        {
+            objects[i].firstEntry = -1;
+            objects[i].active = FALSE;
+            stamps[i] = 0;
+        }
+        
+        hash->objectCapacity = capacity;
+    }
+    
+    //Calculate the new cell range
+    Cyb_HashObject *obj = &hash->objects[id];
+    int lo[3];
+    int hi[3];
+    Cyb_BPBoundsFromBox(&obj->bounds, box);
+    Cyb_CellRange(hash, &obj->bounds, lo, hi);
+    
+    //Still in the same cells?
+    if(obj->active && !memcmp(lo, obj->lo, sizeof(lo)) &&
+        !memcmp(hi, obj->hi, sizeof(hi)))
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    //Move the object to its new cells
+    Cyb_UnlinkHashObject(hash, obj);
+    memcpy(obj->lo, lo, sizeof(lo));
+    memcpy(obj->hi, hi, sizeof(hi));
+    obj->active = TRUE;
+    
+    for(int z = lo[2]; z <= hi[2]; z++)
+    {
+        for(int y = lo[1]; y <= hi[1]; y++)
+        {
+            for(int x = lo[0]; x <= hi[0]; x++)
+            {
+                int entry = Cyb_AllocHashEntry(hash);
+                
+                if(entry < 0)
+                {
+                    Cyb_UnlinkHashObject(hash, obj);
+                    obj->active = FALSE;
+                    return CYB_ERROR;
+                }
+                
+                Cyb_HashEntry *e = &hash->entries[entry];
+                e->object = id;
+                e->cell[0] = x;
+                e->cell[1] = y;
+                e->cell[2] = z;
+                e->objNext = obj->firstEntry;
+                obj->firstEntry = entry;
+                Cyb_LinkHashEntry(hash, entry);
+            }
+        }
+    }
+    
+    return Cyb_GrowBuckets(hash);
+}
+
+
+int Cyb_SetSpatialHashSphere(Cyb_SpatialHash *hash, int id,
+    const Cyb_Sphere *sphere)
+{
+    Cyb_Box box;
+    Cyb_BoxFromSphere(&box, sphere);
+    return Cyb_SetSpatialHashBox(hash, id, &box);
+}
+
+
+int Cyb_UpdateSpatialHash(Cyb_SpatialHash *hash, const Cyb_Box *boxes,
+    int count)
+{
+    for(int i = 0; i < count; i++)
+    {
+        if(Cyb_SetSpatialHashBox(hash, i, &boxes[i]))
+        {
+            return CYB_ERROR;
+        }
+    }
+    
+    //Remove objects past the end of the array
+    for(int i = count; i < hash->objectCapacity; i++)
+    {
+        Cyb_RemoveSpatialHashObject(hash, i);
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+void Cyb_RemoveSpatialHashObject(Cyb_SpatialHash *hash, int id)
+{
+    if(id < 0 || id >= hash->objectCapacity || !hash->objects[id].active)
+    {
+        return;
+    }
+    
+    Cyb_UnlinkHashObject(hash, &hash->objects[id]);
+    hash->objects[id].active = FALSE;
+}
+
+
+int Cyb_FindSpatialHashPairs(Cyb_SpatialHash *hash, Cyb_Pair *pairs,
+    int maxPairs)
+{
+    int pairCount = 0;
+    
+    for(int bucket = 0; bucket < hash->bucketCount; bucket++)
+    {
+        for(int i = hash->buckets[bucket]; i >= 0; i = hash->entries[i].next)
+        {
+            const Cyb_HashEntry *ei = &hash->entries[i];
+            const Cyb_HashObject *a = &hash->objects[ei->object];
+            
+            for(int j = ei->next; j >= 0; j = hash->entries[j].next)
+            {
+                const Cyb_HashEntry *ej = &hash->entries[j];
+                const Cyb_HashObject *b = &hash->objects[ej->object];
+                
+                //Skip entries from other cells that share this bucket
+                if(ei->cell[0] != ej->cell[0] || ei->cell[1] != ej->cell[1] ||
+                    ei->cell[2] != ej->cell[2] || ei->object == ej->object)
+                {
+                    continue;
+                }
+                
+                //Only report the pair in the first cell both objects share
+                if(ei->cell[0] != max(a->lo[0], b->lo[0]) ||
+                    ei->cell[1] != max(a->lo[1], b->lo[1]) ||
+                    ei->cell[2] != max(a->lo[2], b->lo[2]))
+                {
+                    continue;
+                }
+                
+                if(!Cyb_BPBoundsOverlap(&a->bounds, &b->bounds))
+                {
+                    continue;
+                }
+                
+                if(pairCount < maxPairs)
+                {
+                    pairs[pairCount].a = min(ei->object, ej->object);
+                    pairs[pairCount].b = max(ei->object, ej->object);
+                }
+                
+                pairCount++;
+            }
+        }
+    }
+    
+    return pairCount;
+}
+
+
+int Cyb_QuerySpatialHash(Cyb_SpatialHash *hash, const Cyb_Box *box,
+    int *hits, int maxHits)
+{
+    Cyb_BPBounds query;
+    int lo[3];
+    int hi[3];
+    int cell[3];
+    int hitCount = 0;
+    Cyb_BPBoundsFromBox(&query, box);
+    Cyb_CellRange(hash, &query, lo, hi);
+    
+    //Stamps mark objects already tested by this query
+    if(++hash->stamp == 0)
+    {
+        memset(hash->stamps, 0, sizeof(unsigned int) * hash->objectCapacity);
+        hash->stamp = 1;
+    }
+    
+    for(cell[2] = lo[2]; cell[2] <= hi[2]; cell[2]++)
+    {
+        for(cell[1] = lo[1]; cell[1] <= hi[1]; cell[1]++)
+        {
+            for(cell[0] = lo[0]; cell[0] <= hi[0]; cell[0]++)
+            {
+                int bucket = Cyb_HashCell(hash, cell);
+                
+                for(int i = hash->buckets[bucket]; i >= 0;
+                    i = hash->entries[i].next)
+                {
+                    const Cyb_HashEntry *e = &hash->entries[i];
+                    
+                    if(hash->stamps[e->object] == hash->stamp ||
+                        e->cell[0] != cell[0] || e->cell[1] != cell[1] ||
+                        e->cell[2] != cell[2])
+                    {
+                        continue;
+                    }
+                    
+                    hash->stamps[e->object] = hash->stamp;
+                    
+                    if(!Cyb_BPBoundsOverlap(&hash->objects[e->object].bounds,
+                        &query))
+                    {
+                        continue;
+                    }
+                    
+                    if(hitCount < maxHits)
+                    {
+                        hits[hitCount] = e->object;
+                    }
+                    
+                    hitCount++;
+                }
+            }
+        }
+    }
+    
+    return hitCount;
+}
+
+
+static int Cyb_CompareSortKeys(const void *a, const void *b)
+{
+    float ka = ((const Cyb_SortKey*)a)->key;
+    float kb = ((const Cyb_SortKey*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+
+static void Cyb_FullSortSweepAndPrune(Cyb_SweepAndPrune *sap)
+{
+    for(int i = 0; i < sap->count; i++)
+    {
+        sap->keys[i].key = sap->bounds[i].min[sap->axis];
+        sap->keys[i].id = i;
+    }
+    
+    qsort(sap->keys, sap->count, sizeof(Cyb_SortKey), &Cyb_CompareSortKeys);
+    
+    for(int i = 0; i < sap->count; i++)
+    {
+        sap->order[i] = sap->keys[i].id;
+    }
+}
+
+
+Cyb_SweepAndPrune *Cyb_CreateSweepAndPrune(void)
+{
+    return (Cyb_SweepAndPrune*)calloc(1, sizeof(Cyb_SweepAndPrune));
+}
+
+
+void Cyb_FreeSweepAndPrune(Cyb_SweepAndPrune *sap)
+{
+    if(!sap)
+    {
+        return;
+    }
+    
+    free(sap->bounds);
+    free(sap->sorted);
+    free(sap->order);
+    free(sap->keys);
+    free(sap);
+}
+
+
+int Cyb_UpdateSweepAndPrune(Cyb_SweepAndPrune *sap, const Cyb_Box *boxes,
+    int count)
+{
+    //Grow arrays?
+    if(count > sap->capacity)
+    {
+        Cyb_BPBounds *bounds = (Cyb_BPBounds*)realloc(sap->bounds,
+            sizeof(Cyb_BPBounds) * count);
+        
+        if(!bounds)
+        {
+            return CYB_ERROR;
+        }
+        
+        sap->bounds = bounds;
+        bounds = (Cyb_BPBounds*)realloc(sap->sorted,
+            sizeof(Cyb_BPBounds) * count);
+        
+        if(!bounds)
+        {
+            return CYB_ERROR;
+        }
+        
+        sap->sorted = bounds;
+        int *order = (int*)realloc(sap->order, sizeof(int) * count);
+        
+        if(!order)
+        {
+            return CYB_ERROR;
+        }
+        
+        sap->order = order;
+        Cyb_SortKey *keys = (Cyb_SortKey*)realloc(sap->keys,
+            sizeof(Cyb_SortKey) * count);
+        
+        if(!keys)
+        {
+            return CYB_ERROR;
+        }
+        
+        sap->keys = keys;
+        sap->capacity = count;
+    }
+    
+    //Update bounds and measure the spread of the centers on each axis
+    float sum[3] = {0, 0, 0};
+    float sumSq[3] = {0, 0, 0};
+    
+    for(int i = 0; i < count; i++)
+    {
+        Cyb_BPBoundsFromBox(&sap->bounds[i], &boxes[i]);
+        const float *c = &boxes[i].center.x;
+        
+        for(int j = 0; j < 3; j++)
+        {
+            sum[j] += c[j];
+            sumSq[j] += c[j] * c[j];
+        }
+    }
+    
+    int axis = 0;
+    float variance[3];
+    
+    for(int j = 0; j < 3; j++)
+    {
+        variance[j] = count ? sumSq[j] - sum[j] * sum[j] / count : 0.0f;
+        axis = variance[j] > variance[axis] ? j : axis;
+    }
+    
+    //Switch axes only when the new one is clearly better, since that needs a
+    //full sort
+    int fullSort = FALSE;
+    
+    if(axis != sap->axis && variance[axis] > variance[sap->axis] * 1.5f)
+    {
+        sap->axis = axis;
+        fullSort = TRUE;
+    }
+    
+    //Objects added or removed?
+    if(count != sap->count)
+    {
+        //Many new objects are cheaper to place with a full sort
+        if(count - sap->count > count / 4)
+        {
+            fullSort = TRUE;
+        }
+        else
+        {
+            int n = 0;
+            
+            for(int i = 0; i < sap->count; i++)
+            {
+                if(sap->order[i] < count)
+                {
+                    sap->order[n++] = sap->order[i];
+                }
+            }
+            
+            for(int i = sap->count; i < count; i++)
+            {
+                sap->order[n++] = i;
+            }
+        }
+        
+        sap->count = count;
+    }
+    
+    int *order = sap->order;
+    const Cyb_BPBounds *bounds = sap->bounds;
+    int a = sap->axis;
+    
+    if(fullSort)
+    {
+        Cyb_FullSortSweepAndPrune(sap);
+    }
+    else
+    {
+        //Insertion sort is close to linear when the order barely changed
+        for(int i = 1; i < count; i++)
+        {
+            int id = order[i];
+            float key = bounds[id].min[a];
+            int j = i - 1;
+            
+            while(j >= 0 && bounds[order[j]].min[a] > key)
+            {
+                order[j + 1] = order[j];
+                j--;
+            }
+            
+            order[j + 1] = id;
+        }
+    }
+    
+    //Store the bounds in sorted order so the sweep reads memory linearly
+    for(int i = 0; i < count; i++)
+    {
+        sap->sorted[i] = bounds[order[i]];
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+int Cyb_UpdateSweepAndPruneSpheres(Cyb_SweepAndPrune *sap,
+    const Cyb_Sphere *spheres, int count)
+{
+    //Convert the spheres to boxes
+    Cyb_Box boxes[256];
+    Cyb_Box *all = count > 256 ? (Cyb_Box*)malloc(sizeof(Cyb_Box) * count) :
+        boxes;
+    
+    if(!all)
+    {
+        return CYB_ERROR;
+    }
+    
+    for(int i = 0; i < count; i++)
+    {
+        Cyb_BoxFromSphere(&all[i], &spheres[i]);
+    }
+    
+    int result = Cyb_UpdateSweepAndPrune(sap, all, count);
+    
+    if(all != boxes)
+    {
+        free(all);
+    }
+    
+    return result;
+}
+
+
+int Cyb_FindSweepAndPrunePairs(const Cyb_SweepAndPrune *sap,
+    Cyb_Pair *pairs, int maxPairs)
+{
+    const int *order = sap->order;
+    const Cyb_BPBounds *sorted = sap->sorted;
+    int a = sap->axis;
+    int b = (a + 1) % 3;
+    int c = (a + 2) % 3;
+    int pairCount = 0;
+    
+    for(int i = 0; i < sap->count; i++)
+    {
+        const Cyb_BPBounds *bi = &sorted[i];
+        
+        //Sweep forward until the next box starts past the end of this one
+        for(int j = i + 1; j < sap->count; j++)
+        {
+            const Cyb_BPBounds *bj = &sorted[j];
+            
+            if(bj->min[a] >= bi->max[a])
+            {
+                break;
+            }
+            
+            if(bi->min[a] < bj->max[a] &&
+                bi->min[b] < bj->max[b] && bi->max[b] > bj->min[b] &&
+                bi->min[c] < bj->max[c] && bi->max[c] > bj->min[c])
+            {
+                if(pairCount < maxPairs)
+                {
+                    pairs[pairCount].a = min(order[i], order[j]);
+                    pairs[pairCount].b = max(order[i], order[j]);
+                }
+                
+                pairCount++;
+            }
+        }
+    }
+    
+    return pairCount;
+}
\ No newline at end of file
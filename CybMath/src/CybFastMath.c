@@ -0,0 +1,183 @@
+/*
+CybMath - Fast Math API
+*/
+
+#include <string.h>
+
+#include "CybFastMath.h"
+
+
+//Functions
+//=================================================================================
+void Cyb_FastSinCos(float x, float *s, float *c)
+{
+    float sines[4];
+    float cosines[4];
+    Cyb_F4 cosX;
+    Cyb_F4Store(sines, Cyb_F4SinCos(Cyb_F4Set1(x), &cosX));
+    Cyb_F4Store(cosines, cosX);
+    *s = sines[0];
+    *c = cosines[0];
+}
+
+
+float Cyb_FastAcos(float x)
+{
+    float angles[4];
+    Cyb_F4 a = Cyb_F4Max(Cyb_F4Min(Cyb_F4Set1(x), Cyb_F4Set1(1.0f)),
+        Cyb_F4Set1(-1.0f));
+    Cyb_F4Store(angles, Cyb_F4Acos(a));
+    return angles[0];
+}
+
+
+float Cyb_FastRsqrt(float x)
+{
+    float r[4];
+    Cyb_F4Store(r, Cyb_F4Rsqrt(Cyb_F4Set1(x)));
+    return r[0];
+}
+
+
+void Cyb_FastNormalizeVec3(Cyb_Vec3 *v)
+{
+    float len2 = v->x * v->x + v->y * v->y + v->z * v->z;
+    
+    //Zero length?
+    if(len2 == 0.0f)
+    {
+        return;
+    }
+    
+    float scale = Cyb_FastRsqrt(len2);
+    v->x *= scale;
+    v->y *= scale;
+    v->z *= scale;
+}
+
+
+void Cyb_FastNormalizeVec4(Cyb_Vec4 *v)
+{
+    float len2 = v->x * v->x + v->y * v->y + v->z * v->z + v->w * v->w;
+    
+    //Zero length?
+    if(len2 == 0.0f)
+    {
+        return;
+    }
+    
+    float scale = Cyb_FastRsqrt(len2);
+    v->x *= scale;
+    v->y *= scale;
+    v->z *= scale;
+    v->w *= scale;
+}
+
+
+void Cyb_FastSinCosArray(const float *x, float *s, float *c, int count)
+{
+    Cyb_F4 cosX;
+    int i = 0;
+    
+    //Process 4 angles at a time
+    for(; i + 4 <= count; i += 4)
+    {
+        Cyb_F4 sinX = Cyb_F4SinCos(Cyb_F4Load(&x[i]), &cosX);
+        Cyb_F4Store(&s[i], sinX);
+        Cyb_F4Store(&c[i], cosX);
+    }
+    
+    //Process remaining angles
+    if(i < count)
+    {
+        float tmp[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float tmpCos[4];
+        memcpy(tmp, &x[i], (count - i) * sizeof(float));
+        Cyb_F4Store(tmp, Cyb_F4SinCos(Cyb_F4Load(tmp), &cosX));
+        Cyb_F4Store(tmpCos, cosX);
+        memcpy(&s[i], tmp, (count - i) * sizeof(float));
+        memcpy(&c[i], tmpCos, (count - i) * sizeof(float));
+    }
+}
+
+
+void Cyb_FastAcosArray(const float *x, float *y, int count)
+{
+    Cyb_F4 one = Cyb_F4Set1(1.0f);
+    Cyb_F4 minusOne = Cyb_F4Set1(-1.0f);
+    int i = 0;
+    
+    //Process 4 values at a time
+    for(; i + 4 <= count; i += 4)
+    {
+        Cyb_F4 a = Cyb_F4Max(Cyb_F4Min(Cyb_F4Load(&x[i]), one), minusOne);
+        Cyb_F4Store(&y[i], Cyb_F4Acos(a));
+    }
+    
+    //Process remaining values
+    if(i < count)
+    {
+        float tmp[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        memcpy(tmp, &x[i], (count - i) * sizeof(float));
+        Cyb_F4 a = Cyb_F4Max(Cyb_F4Min(Cyb_F4Load(tmp), one), minusOne);
+        Cyb_F4Store(tmp, Cyb_F4Acos(a));
+        memcpy(&y[i], tmp, (count - i) * sizeof(float));
+    }
+}
+
+
+void Cyb_FastRsqrtArray(const float *x, float *y, int count)
+{
+    int i = 0;
+    
+    //Process 4 values at a time
+    for(; i + 4 <= count; i += 4)
+    {
+        Cyb_F4Store(&y[i], Cyb_F4Rsqrt(Cyb_F4Load(&x[i])));
+    }
+    
+    //Process remaining values
+    if(i < count)
+    {
+        float tmp[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        memcpy(tmp, &x[i], (count - i) * sizeof(float));
+        Cyb_F4Store(tmp, Cyb_F4Rsqrt(Cyb_F4Load(tmp)));
+        memcpy(&y[i], tmp, (count - i) * sizeof(float));
+    }
+}
+
+
+void Cyb_FastNormalizeVec3Array(Cyb_Vec3 *v, int count)
+{
+    int i = 0;
+    
+    //Process 4 vectors at a time
+    for(; i + 4 <= count; i += 4)
+    {
+        Cyb_F4 x = Cyb_F4Set(v[i].x, v[i + 1].x, v[i + 2].x, v[i + 3].x);
+        Cyb_F4 y = Cyb_F4Set(v[i].y, v[i + 1].y, v[i + 2].y, v[i + 3].y);
+        Cyb_F4 z = Cyb_F4Set(v[i].z, v[i + 1].z, v[i + 2].z, v[i + 3].z);
+        Cyb_F4Normalize3(&x, &y, &z);
+        
+        //Scatter the results back
+        float xs[4];
+        float ys[4];
+        float zs[4];
+        Cyb_F4Store(xs, x);
+        Cyb_F4Store(ys, y);
+        Cyb_F4Store(zs, z);
+        
+        for(int j = 0; j < 4; j++)
+        {
+            v[i + j].x = xs[j];
+            v[i + j].y = ys[j];
+            v[i + j].z = zs[j];
+        }
+    }
+    
+    //Process remaining vectors
+    for(; i < count; i++)
+    {
+        Cyb_FastNormalizeVec3(&v[i]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,318 @@
+/*
+CybMath - Frustum API
+*/
+
+#include <math.h>
+
+#include "CybFrustum.h"
+#include "CybSIMD.h"
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    Cyb_F4 x[6];
+    Cyb_F4 y[6];
+    Cyb_F4 z[6];
+    Cyb_F4 w[6];
+    Cyb_F4 absX[6];
+    Cyb_F4 absY[6];
+    Cyb_F4 absZ[6];
+} Cyb_FrustumF4;
+
+
+//Functions
+//=================================================================================
+static void Cyb_SetPlane(Cyb_Vec4 *plane, float x, float y, float z, float w)
+{
+    float len = sqrtf(x * x + y * y + z * z);
+    
+    //Degenerate plane?
+    if(len == 0.0f)
+    {
+        len = 1.0f;
+    }
+    
+    plane->x = x / len;
+    plane->y = y / len;
+    plane->z = z / len;
+    plane->w = w / len;
+}
+
+
+static void Cyb_SplatFrustum(Cyb_FrustumF4 *out, const Cyb_Frustum *frustum)
+{
+    for(int i = 0; i < 6; i++)
+    {
+        const Cyb_Vec4 *plane = &frustum->planes[i];
+        out->x[i] = Cyb_F4Set1(plane->x);
+        out->y[i] = Cyb_F4Set1(plane->y);
+        out->z[i] = Cyb_F4Set1(plane->z);
+        out->w[i] = Cyb_F4Set1(plane->w);
+        out->absX[i] = Cyb_F4Set1(fabsf(plane->x));
+        out->absY[i] = Cyb_F4Set1(fabsf(plane->y));
+        out->absZ[i] = Cyb_F4Set1(fabsf(plane->z));
+    }
+}
+
+
+static int Cyb_CullSpheres4(const Cyb_FrustumF4 *frustum,
+    const Cyb_Sphere *spheres)
+{
+    //Transpose 4 spheres into lanes
+    Cyb_F4 x = Cyb_F4Set(spheres[0].center.x, spheres[1].center.x,
+        spheres[2].center.x, spheres[3].center.x);
+    Cyb_F4 y = Cyb_F4Set(spheres[0].center.y, spheres[1].center.y,
+        spheres[2].center.y, spheres[3].center.y);
+    Cyb_F4 z = Cyb_F4Set(spheres[0].center.z, spheres[1].center.z,
+        spheres[2].center.z, spheres[3].center.z);
+    Cyb_F4 r = Cyb_F4Set(-spheres[0].radius, -spheres[1].radius,
+        -spheres[2].radius, -spheres[3].radius);
+    Cyb_F4 outside = Cyb_F4Set1(0.0f);
+    
+    //A sphere is culled if its center is further than its radius behind any
+    //plane
+    for(int i = 0; i < 6; i++)
+    {
+        Cyb_F4 d = Cyb_F4MulAdd(frustum->x[i], x, frustum->w[i]);
+        d = Cyb_F4MulAdd(frustum->y[i], y, d);
+        d = Cyb_F4MulAdd(frustum->z[i], z, d);
+        outside = Cyb_F4Or(outside, Cyb_F4CmpLt(d, r));
+    }
+    
+    return ~Cyb_F4MoveMask(outside) & 0xf;
+}
+
+
+static int Cyb_CullBoxes4(const Cyb_FrustumF4 *frustum, const Cyb_Box *boxes)
+{
+    //Transpose 4 boxes into lanes
+    Cyb_F4 half = Cyb_F4Set1(.5f);
+    Cyb_F4 x = Cyb_F4Set(boxes[0].center.x, boxes[1].center.x,
+        boxes[2].center.x, boxes[3].center.x);
+    Cyb_F4 y = Cyb_F4Set(boxes[0].center.y, boxes[1].center.y,
+        boxes[2].center.y, boxes[3].center.y);
+    Cyb_F4 z = Cyb_F4Set(boxes[0].center.z, boxes[1].center.z,
+        boxes[2].center.z, boxes[3].center.z);
+    Cyb_F4 hx = Cyb_F4Mul(Cyb_F4Set(boxes[0].size.x, boxes[1].size.x,
+        boxes[2].size.x, boxes[3].size.x), half);
+    Cyb_F4 hy = Cyb_F4Mul(Cyb_F4Set(boxes[0].size.y, boxes[1].size.y,
+        boxes[2].size.y, boxes[3].size.y), half);
+    Cyb_F4 hz = Cyb_F4Mul(Cyb_F4Set(boxes[0].size.z, boxes[1].size.z,
+        boxes[2].size.z, boxes[3].size.z), half);
+    Cyb_F4 zero = Cyb_F4Set1(0.0f);
+    Cyb_F4 outside = zero;
+    
+    //A box is culled if its corner furthest along the plane normal is behind
+    //any plane
+    for(int i = 0; i < 6; i++)
+    {
+        Cyb_F4 d = Cyb_F4MulAdd(frustum->x[i], x, frustum->w[i]);
+        d = Cyb_F4MulAdd(frustum->y[i], y, d);
+        d = Cyb_F4MulAdd(frustum->z[i], z, d);
+        d = Cyb_F4MulAdd(frustum->absX[i], hx, d);
+        d = Cyb_F4MulAdd(frustum->absY[i], hy, d);
+        d = Cyb_F4MulAdd(frustum->absZ[i], hz, d);
+        outside = Cyb_F4Or(outside, Cyb_F4CmpLt(d, zero));
+    }
+    
+    return ~Cyb_F4MoveMask(outside) & 0xf;
+}
+
+
+void Cyb_FrustumFromMatrix(Cyb_Frustum *frustum, const Cyb_Mat4 *m)
+{
+    //Each plane is the sum or difference of row 4 and one of the other rows
+    Cyb_SetPlane(&frustum->planes[CYB_FRUSTUM_LEFT],
+        m->m + m->a, m->n + m->b, m->o + m->c, m->p + m->d);
+    Cyb_SetPlane(&frustum->planes[CYB_FRUSTUM_RIGHT],
+        m->m - m->a, m->n - m->b, m->o - m->c, m->p - m->d);
+    Cyb_SetPlane(&frustum->planes[CYB_FRUSTUM_BOTTOM],
+        m->m + m->e, m->n + m->f, m->o + m->g, m->p + m->h);
+    Cyb_SetPlane(&frustum->planes[CYB_FRUSTUM_TOP],
+        m->m - m->e, m->n - m->f, m->o - m->g, m->p - m->h);
+    Cyb_SetPlane(&frustum->planes[CYB_FRUSTUM_NEAR],
+        m->m + m->i, m->n + m->j, m->o + m->k, m->p + m->l);
+    Cyb_SetPlane(&frustum->planes[CYB_FRUSTUM_FAR],
+        m->m - m->i, m->n - m->j, m->o - m->k, m->p - m->l);
+}
+
+
+int Cyb_PointInFrustum(const Cyb_Vec3 *a, const Cyb_Frustum *b)
+{
+    for(int i = 0; i < 6; i++)
+    {
+        const Cyb_Vec4 *plane = &b->planes[i];
+        
+        if(plane->x * a->x + plane->y * a->y + plane->z * a->z + plane->w < 0)
+        {
+            return FALSE;
+        }
+    }
+    
+    return TRUE;
+}
+
+
+int Cyb_SphereInFrustum(const Cyb_Sphere *a, const Cyb_Frustum *b)
+{
+    for(int i = 0; i < 6; i++)
+    {
+        const Cyb_Vec4 *plane = &b->planes[i];
+        
+        if(plane->x * a->center.x + plane->y * a->center.y +
+            plane->z * a->center.z + plane->w < -a->radius)
+        {
+            return FALSE;
+        }
+    }
+    
+    return TRUE;
+}
+
+
+int Cyb_BoxInFrustum(const Cyb_Box *a, const Cyb_Frustum *b)
+{
+    for(int i = 0; i < 6; i++)
+    {
+        const Cyb_Vec4 *plane = &b->planes[i];
+        float d = plane->x * a->center.x + plane->y * a->center.y +
+            plane->z * a->center.z + plane->w;
+        float r = (fabsf(plane->x) * a->size.x + fabsf(plane->y) * a->size.y +
+            fabsf(plane->z) * a->size.z) * .5f;
+        
+        if(d + r < 0)
+        {
+            return FALSE;
+        }
+    }
+    
+    return TRUE;
+}
+
+
+void Cyb_CullSpheres(const Cyb_Frustum *frustum,
+    const Cyb_Sphere *spheres, int count, unsigned char *visible)
+{
+    Cyb_FrustumF4 planes;
+    Cyb_SplatFrustum(&planes, frustum);
+    int i = 0;
+    
+    //Test 8 spheres per output byte
+    for(; i + 8 <= count; i += 8)
+    {
+        visible[i / 8] = (unsigned char)(Cyb_CullSpheres4(&planes,
+            &spheres[i]) | (Cyb_CullSpheres4(&planes, &spheres[i + 4]) << 4));
+    }
+    
+    //Test remaining spheres
+    if(i < count)
+    {
+        unsigned char bits = 0;
+        
+        for(int j = 0; i + j < count; j++)
+        {
+            bits |= (unsigned char)(Cyb_SphereInFrustum(&spheres[i + j],
+                frustum) << j);
+        }
+        
+        visible[i / 8] = bits;
+    }
+}
+
+
+void Cyb_CullBoxes(const Cyb_Frustum *frustum, const Cyb_Box *boxes,
+    int count, unsigned char *visible)
+{
+    Cyb_FrustumF4 planes;
+    Cyb_SplatFrustum(&planes, frustum);
+    int i = 0;
+    
+    //Test 8 boxes per output byte
+    for(; i + 8 <= count; i += 8)
+    {
+        visible[i / 8] = (unsigned char)(Cyb_CullBoxes4(&planes, &boxes[i]) |
+            (Cyb_CullBoxes4(&planes, &boxes[i + 4]) << 4));
+    }
+    
+    //Test remaining boxes
+    if(i < count)
+    {
+        unsigned char bits = 0;
+        
+        for(int j = 0; i + j < count; j++)
+        {
+            bits |= (unsigned char)(Cyb_BoxInFrustum(&boxes[i + j],
+                frustum) << j);
+        }
+        
+        visible[i / 8] = bits;
+    }
+}
+
+
+int Cyb_CullSpheresIndexed(const Cyb_Frustum *frustum,
+    const Cyb_Sphere *spheres, int count, int *indices)
+{
+    Cyb_FrustumF4 planes;
+    Cyb_SplatFrustum(&planes, frustum);
+    int visibleCount = 0;
+    int i = 0;
+    
+    //Test 4 spheres at a time and append the visible ones
+    for(; i + 4 <= count; i += 4)
+    {
+        int bits = Cyb_CullSpheres4(&planes, &spheres[i]);
+        
+        for(int j = 0; bits; j++, bits >>= 1)
+        {
+            indices[visibleCount] = i + j;
+            visibleCount += bits & 1;
+        }
+    }
+    
+    //Test remaining spheres
+    for(; i < count; i++)
+    {
+        if(Cyb_SphereInFrustum(&spheres[i], frustum))
+        {
+            indices[visibleCount++] = i;
+        }
+    }
+    
+    return visibleCount;
+}
+
+
+int Cyb_CullBoxesIndexed(const Cyb_Frustum *frustum,
+    const Cyb_Box *boxes, int count, int *indices)
+{
+    Cyb_FrustumF4 planes;
+    Cyb_SplatFrustum(&planes, frustum);
+    int visibleCount = 0;
+    int i = 0;
+    
+    //Test 4 boxes at a time and append the visible ones
+    for(; i + 4 <= count; i += 4)
+    {
+        int bits = Cyb_CullBoxes4(&planes, &boxes[i]);
+        
+        for(int j = 0; bits; j++, bits >>= 1)
+        {
+            indices[visibleCount] = i + j;
+            visibleCount += bits & 1;
+        }
+    }
+    
+    //Test remaining boxes
+    for(; i < count; i++)
+    {
+        if(Cyb_BoxInFrustum(&boxes[i], frustum))
+        {
+            indices[visibleCount++] = i;
+        }
+    }
+    
+    return visibleCount;
+}
\ No newline at end of file
@@ -0,0 +1,325 @@
+/*
+CybMath - Noise API
+*/
+
+#include <string.h>
+
+#include "CybNoise.h"
+
+
+//Macros
+//=================================================================================
+#define CYB_NOISE_LANES 8 //points evaluated at once by the array functions
+
+
+//Functions
+//=================================================================================
+static Cyb_F4 Cyb_NoiseX4(const Cyb_NoiseParams *params, int dims,
+    const Cyb_F4 *p, float freq, unsigned int seed)
+{
+    Cyb_F4 f = Cyb_F4Set1(freq);
+    
+    switch(dims)
+    {
+    case 2:
+        if(params->type == CYB_NOISE_VALUE)
+        {
+            return Cyb_F4ValueNoise2(Cyb_F4Mul(p[0], f), Cyb_F4Mul(p[1], f),
+                seed);
+        }
+        
+        return Cyb_F4SimplexNoise2(Cyb_F4Mul(p[0], f), Cyb_F4Mul(p[1], f),
+            seed);
+    
+    case 3:
+        if(params->type == CYB_NOISE_VALUE)
+        {
+            return Cyb_F4ValueNoise3(Cyb_F4Mul(p[0], f), Cyb_F4Mul(p[1], f),
+                Cyb_F4Mul(p[2], f), seed);
+        }
+        
+        return Cyb_F4SimplexNoise3(Cyb_F4Mul(p[0], f), Cyb_F4Mul(p[1], f),
+            Cyb_F4Mul(p[2], f), seed);
+    
+    default:
+        if(params->type == CYB_NOISE_VALUE)
+        {
+            return Cyb_F4ValueNoise4(Cyb_F4Mul(p[0], f), Cyb_F4Mul(p[1], f),
+                Cyb_F4Mul(p[2], f), Cyb_F4Mul(p[3], f), seed);
+        }
+        
+        return Cyb_F4SimplexNoise4(Cyb_F4Mul(p[0], f), Cyb_F4Mul(p[1], f),
+            Cyb_F4Mul(p[2], f), Cyb_F4Mul(p[3], f), seed);
+    }
+}
+
+
+static Cyb_F8 Cyb_FBMX8(const Cyb_NoiseParams *params, int dims,
+    const Cyb_F8 *p)
+{
+    //Both halves are evaluated in the same loop so that their independent
+    //instructions can be interleaved
+    Cyb_F4 lo[4];
+    Cyb_F4 hi[4];
+    
+    for(int a = 0; a < dims; a++)
+    {
+        lo[a] = p[a].lo;
+        hi[a] = p[a].hi;
+    }
+    
+    Cyb_F8 sum = Cyb_F8Set1(0.0f);
+    float freq = params->frequency;
+    float amp = 1.0f;
+    float total = 0.0f;
+    
+    for(int octave = 0; octave < params->octaves; octave++)
+    {
+        unsigned int seed = params->seed + (unsigned int)octave;
+        Cyb_F8 n;
+        n.lo = Cyb_NoiseX4(params, dims, lo, freq, seed);
+        n.hi = Cyb_NoiseX4(params, dims, hi, freq, seed);
+        sum = Cyb_F8MulAdd(n, Cyb_F8Set1(amp), sum);
+        total += amp;
+        freq *= params->lacunarity;
+        amp *= params->gain;
+    }
+    
+    return Cyb_F8Mul(sum, Cyb_F8Set1(total > 0.0f ? 1.0f / total : 0.0f));
+}
+
+
+static float Cyb_FBM(const Cyb_NoiseParams *params, int dims, const float *p)
+{
+    //Evaluate a single point in all 4 lanes
+    Cyb_F4 lanes[4];
+    Cyb_F4 sum = Cyb_F4Set1(0.0f);
+    float freq = params->frequency;
+    float amp = 1.0f;
+    float total = 0.0f;
+    float result[4];
+    
+    for(int a = 0; a < dims; a++)
+    {
+        lanes[a] = Cyb_F4Set1(p[a]);
+    }
+    
+    for(int octave = 0; octave < params->octaves; octave++)
+    {
+        Cyb_F4 n = Cyb_NoiseX4(params, dims, lanes, freq,
+            params->seed + (unsigned int)octave);
+        sum = Cyb_F4MulAdd(n, Cyb_F4Set1(amp), sum);
+        total += amp;
+        freq *= params->lacunarity;
+        amp *= params->gain;
+    }
+    
+    Cyb_F4Store(result, Cyb_F4Mul(sum, Cyb_F4Set1(total > 0.0f ?
+        1.0f / total : 0.0f)));
+    return result[0];
+}
+
+
+static void Cyb_FBMArray(const Cyb_NoiseParams *params, int dims,
+    const float *points, int stride, float *out, int count)
+{
+    //Transpose each group of points into lanes, padding the last group with
+    //copies of the last point
+    for(int i = 0; i < count; i += CYB_NOISE_LANES)
+    {
+        float soa[4][CYB_NOISE_LANES];
+        float result[CYB_NOISE_LANES];
+        Cyb_F8 lanes[4];
+        int n = count - i < CYB_NOISE_LANES ? count - i : CYB_NOISE_LANES;
+        
+        for(int lane = 0; lane < CYB_NOISE_LANES; lane++)
+        {
+            const float *point = &points[(i + (lane < n ? lane : n - 1)) *
+                stride];
+            
+            for(int a = 0; a < dims; a++)
+            {
+                soa[a][lane] = point[a];
+            }
+        }
+        
+        for(int a = 0; a < dims; a++)
+        {
+            lanes[a] = Cyb_F8Load(soa[a]);
+        }
+        
+        Cyb_F8Store(result, Cyb_FBMX8(params, dims, lanes));
+        memcpy(&out[i], result, n * sizeof(float));
+    }
+}
+
+
+static void Cyb_FillFBM(const Cyb_NoiseParams *params, int dims, float *out,
+    int width, int height, const float *origin, float step)
+{
+    Cyb_F8 lanes[4];
+    Cyb_F8 laneOffsets = {Cyb_F4Set(0.0f, 1.0f, 2.0f, 3.0f),
+        Cyb_F4Set(4.0f, 5.0f, 6.0f, 7.0f)};
+    Cyb_F8 x = Cyb_F8Set1(origin[0]);
+    Cyb_F8 steps = Cyb_F8Set1(step);
+    
+    for(int a = 2; a < dims; a++)
+    {
+        lanes[a] = Cyb_F8Set1(origin[a]);
+    }
+    
+    for(int row = 0; row < height; row++)
+    {
+        float *dst = &out[row * width];
+        lanes[1] = Cyb_F8Set1(origin[1] + row * step);
+        
+        for(int col = 0; col < width; col += CYB_NOISE_LANES)
+        {
+            //Sample columns col to col + 7
+            Cyb_F8 cols = Cyb_F8Add(Cyb_F8Set1((float)col), laneOffsets);
+            lanes[0] = Cyb_F8MulAdd(cols, steps, x);
+            Cyb_F8 result = Cyb_FBMX8(params, dims, lanes);
+            
+            if(col + CYB_NOISE_LANES <= width)
+            {
+                Cyb_F8Store(&dst[col], result);
+            }
+            else
+            {
+                float tmp[CYB_NOISE_LANES];
+                Cyb_F8Store(tmp, result);
+                memcpy(&dst[col], tmp, (width - col) * sizeof(float));
+            }
+        }
+    }
+}
+
+
+float Cyb_SimplexNoise2(float x, float y, unsigned int seed)
+{
+    float r[4];
+    Cyb_F4Store(r, Cyb_F4SimplexNoise2(Cyb_F4Set1(x), Cyb_F4Set1(y), seed));
+    return r[0];
+}
+
+
+float Cyb_SimplexNoise3(float x, float y, float z, unsigned int seed)
+{
+    float r[4];
+    Cyb_F4Store(r, Cyb_F4SimplexNoise3(Cyb_F4Set1(x), Cyb_F4Set1(y),
+        Cyb_F4Set1(z), seed));
+    return r[0];
+}
+
+
+float Cyb_SimplexNoise4(float x, float y, float z, float w, unsigned int seed)
+{
+    float r[4];
+    Cyb_F4Store(r, Cyb_F4SimplexNoise4(Cyb_F4Set1(x), Cyb_F4Set1(y),
+        Cyb_F4Set1(z), Cyb_F4Set1(w), seed));
+    return r[0];
+}
+
+
+float Cyb_ValueNoise2(float x, float y, unsigned int seed)
+{
+    float r[4];
+    Cyb_F4Store(r, Cyb_F4ValueNoise2(Cyb_F4Set1(x), Cyb_F4Set1(y), seed));
+    return r[0];
+}
+
+
+float Cyb_ValueNoise3(float x, float y, float z, unsigned int seed)
+{
+    float r[4];
+    Cyb_F4Store(r, Cyb_F4ValueNoise3(Cyb_F4Set1(x), Cyb_F4Set1(y),
+        Cyb_F4Set1(z), seed));
+    return r[0];
+}
+
+
+float Cyb_ValueNoise4(float x, float y, float z, float w, unsigned int seed)
+{
+    float r[4];
+    Cyb_F4Store(r, Cyb_F4ValueNoise4(Cyb_F4Set1(x), Cyb_F4Set1(y),
+        Cyb_F4Set1(z), Cyb_F4Set1(w), seed));
+    return r[0];
+}
+
+
+void Cyb_InitNoiseParams(Cyb_NoiseParams *params)
+{
+    params->type = CYB_NOISE_SIMPLEX;
+    params->seed = 0;
+    params->octaves = 1;
+    params->frequency = 1.0f;
+    params->lacunarity = 2.0f;
+    params->gain = .5f;
+}
+
+
+float Cyb_FBM2(const Cyb_NoiseParams *params, float x, float y)
+{
+    float p[2] = {x, y};
+    return Cyb_FBM(params, 2, p);
+}
+
+
+float Cyb_FBM3(const Cyb_NoiseParams *params, float x, float y, float z)
+{
+    float p[3] = {x, y, z};
+    return Cyb_FBM(params, 3, p);
+}
+
+
+float Cyb_FBM4(const Cyb_NoiseParams *params, float x, float y, float z,
+    float w)
+{
+    float p[4] = {x, y, z, w};
+    return Cyb_FBM(params, 4, p);
+}
+
+
+void Cyb_FBMArray2(const Cyb_NoiseParams *params, const Cyb_Vec2 *points,
+    float *out, int count)
+{
+    Cyb_FBMArray(params, 2, &points->x, 2, out, count);
+}
+
+
+void Cyb_FBMArray3(const Cyb_NoiseParams *params, const Cyb_Vec3 *points,
+    float *out, int count)
+{
+    Cyb_FBMArray(params, 3, &points->x, 3, out, count);
+}
+
+
+void Cyb_FBMArray4(const Cyb_NoiseParams *params, const Cyb_Vec4 *points,
+    float *out, int count)
+{
+    Cyb_FBMArray(params, 4, &points->x, 4, out, count);
+}
+
+
+void Cyb_FillFBM2(const Cyb_NoiseParams *params, float *out, int width,
+    int height, float x, float y, float step)
+{
+    float origin[2] = {x, y};
+    Cyb_FillFBM(params, 2, out, width, height, origin, step);
+}
+
+
+void Cyb_FillFBM3(const Cyb_NoiseParams *params, float *out, int width,
+    int height, float x, float y, float z, float step)
+{
+    float origin[3] = {x, y, z};
+    Cyb_FillFBM(params, 3, out, width, height, origin, step);
+}
+
+
+void Cyb_FillFBM4(const Cyb_NoiseParams *params, float *out, int width,
+    int height, float x, float y, float z, float w, float step)
+{
+    float origin[4] = {x, y, z, w};
+    Cyb_FillFBM(params, 4, out, width, height, origin, step);
+}
\ No newline at end of file
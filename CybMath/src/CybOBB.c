@@ -0,0 +1,335 @@
+/*
+CybMath - Oriented Box API
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "CybOBB.h"
+
+
+//Functions
+//=================================================================================
+static float Cyb_Dot(const Cyb_Vec3 *a, const Cyb_Vec3 *b)
+{
+    return a->x * b->x + a->y * b->y + a->z * b->z;
+}
+
+
+static void Cyb_Cross(Cyb_Vec3 *c, const Cyb_Vec3 *a, const Cyb_Vec3 *b)
+{
+    c->x = a->y * b->z - a->z * b->y;
+    c->y = a->z * b->x - a->x * b->z;
+    c->z = a->x * b->y - a->y * b->x;
+}
+
+
+static void Cyb_Jacobi(float a[3][3], float v[3][3])
+{
+    //Start with the identity matrix
+    memset(v, 0, sizeof(float) * 9);
+    v[0][0] = v[1][1] = v[2][2] = 1.0f;
+    
+    //Repeatedly zero the largest off-diagonal element with a plane rotation
+    for(int n = 0; n < 50; n++)
+    {
+        int p = 0;
+        int q = 1;
+        
+        for(int i = 0; i < 3; i++)
+        {
+            for(int j = i + 1; j < 3; j++)
+            {
+                if(fabsf(a[i][j]) > fabsf(a[p][q]))
+                {
+                    p = i;
+                    q = j;
+                }
+            }
+        }
+        
+        //Converged?
+        if(fabsf(a[p][q]) <= 1e-9f * (fabsf(a[p][p]) + fabsf(a[q][q])) ||
+            a[p][q] == 0.0f)
+        {
+            return;
+        }
+        
+        //Calculate the rotation that zeroes a[p][q]
+        float theta = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+        float t = 1.0f / (fabsf(theta) + sqrtf(theta * theta + 1.0f));
+        
+        if(theta < 0.0f)
+        {
+            t = -t;
+        }
+        
+        float c = 1.0f / sqrtf(t * t + 1.0f);
+        float s = t * c;
+        
+        //Apply it to the rows and columns p and q
+        for(int k = 0; k < 3; k++)
+        {
+            float akp = a[k][p];
+            float akq = a[k][q];
+            a[k][p] = c * akp - s * akq;
+            a[k][q] = s * akp + c * akq;
+        }
+        
+        for(int k = 0; k < 3; k++)
+        {
+            float apk = a[p][k];
+            float aqk = a[q][k];
+            a[p][k] = c * apk - s * aqk;
+            a[q][k] = s * apk + c * aqk;
+        }
+        
+        for(int k = 0; k < 3; k++)
+        {
+            float vkp = v[k][p];
+            float vkq = v[k][q];
+            v[k][p] = c * vkp - s * vkq;
+            v[k][q] = s * vkp + c * vkq;
+        }
+    }
+}
+
+
+void Cyb_OBBFromGeometry(Cyb_OBB *obb, const void *verts, int stride,
+    int count)
+{
+    //No vertices?
+    if(count <= 0)
+    {
+        memset(obb, 0, sizeof(Cyb_OBB));
+        obb->axes[0].x = obb->axes[1].y = obb->axes[2].z = 1.0f;
+        return;
+    }
+    
+    //Calculate the mean
+    const char *vert = (const char*)verts;
+    float mx = 0.0f;
+    float my = 0.0f;
+    float mz = 0.0f;
+    
+    for(int i = 0; i < count; i++)
+    {
+        const Cyb_Vec3 *p = (const Cyb_Vec3*)(vert + i * stride);
+        mx += p->x;
+        my += p->y;
+        mz += p->z;
+    }
+    
+    mx /= count;
+    my /= count;
+    mz /= count;
+    
+    //Calculate the covariance matrix
+    float cov[3][3] = {{0}};
+    
+    for(int i = 0; i < count; i++)
+    {
+        const Cyb_Vec3 *p = (const Cyb_Vec3*)(vert + i * stride);
+        float dx = p->x - mx;
+        float dy = p->y - my;
+        float dz = p->z - mz;
+        cov[0][0] += dx * dx;
+        cov[0][1] += dx * dy;
+        cov[0][2] += dx * dz;
+        cov[1][1] += dy * dy;
+        cov[1][2] += dy * dz;
+        cov[2][2] += dz * dz;
+    }
+    
+    cov[1][0] = cov[0][1];
+    cov[2][0] = cov[0][2];
+    cov[2][1] = cov[1][2];
+    
+    //The eigenvectors of the covariance matrix are the principal axes
+    float v[3][3];
+    Cyb_Jacobi(cov, v);
+    
+    for(int i = 0; i < 2; i++)
+    {
+        Cyb_Vec3 *axis = &obb->axes[i];
+        axis->x = v[0][i];
+        axis->y = v[1][i];
+        axis->z = v[2][i];
+        float len = sqrtf(Cyb_Dot(axis, axis));
+        axis->x /= len;
+        axis->y /= len;
+        axis->z /= len;
+    }
+    
+    Cyb_Cross(&obb->axes[2], &obb->axes[0], &obb->axes[1]);
+    
+    //Project the vertices onto each axis to find the extents
+    float lo[3];
+    float hi[3];
+    
+    for(int j = 0; j < 3; j++)
+    {
+        lo[j] = hi[j] = Cyb_Dot((const Cyb_Vec3*)vert, &obb->axes[j]);
+    }
+    
+    for(int i = 1; i < count; i++)
+    {
+        const Cyb_Vec3 *p = (const Cyb_Vec3*)(vert + i * stride);
+        
+        for(int j = 0; j < 3; j++)
+        {
+            float d = Cyb_Dot(p, &obb->axes[j]);
+            lo[j] = min(lo[j], d);
+            hi[j] = max(hi[j], d);
+        }
+    }
+    
+    //Calculate size and center
+    obb->size.x = hi[0] - lo[0];
+    obb->size.y = hi[1] - lo[1];
+    obb->size.z = hi[2] - lo[2];
+    obb->center.x = 0.0f;
+    obb->center.y = 0.0f;
+    obb->center.z = 0.0f;
+    
+    for(int j = 0; j < 3; j++)
+    {
+        float mid = (lo[j] + hi[j]) / 2.0f;
+        obb->center.x += obb->axes[j].x * mid;
+        obb->center.y += obb->axes[j].y * mid;
+        obb->center.z += obb->axes[j].z * mid;
+    }
+}
+
+
+void Cyb_OBBFromBox(Cyb_OBB *obb, const Cyb_Box *box, const Cyb_Mat4 *m)
+{
+    //Transform the center
+    Cyb_Transform(&obb->center, m, &box->center);
+    
+    //The columns of the upper 3 x 3 are the scaled local axes
+    const float columns[3][3] = {
+        {m->a, m->e, m->i},
+        {m->b, m->f, m->j},
+        {m->c, m->g, m->k}
+    };
+    const float *size = &box->size.x;
+    float *obbSize = &obb->size.x;
+    
+    for(int j = 0; j < 3; j++)
+    {
+        Cyb_Vec3 *axis = &obb->axes[j];
+        axis->x = columns[j][0];
+        axis->y = columns[j][1];
+        axis->z = columns[j][2];
+        float len = sqrtf(Cyb_Dot(axis, axis));
+        obbSize[j] = size[j] * len;
+        
+        if(len > 0.0f)
+        {
+            axis->x /= len;
+            axis->y /= len;
+            axis->z /= len;
+        }
+    }
+}
+
+
+void Cyb_BoxFromOBB(Cyb_Box *box, const Cyb_OBB *obb)
+{
+    box->center = obb->center;
+    box->size.x = fabsf(obb->axes[0].x) * obb->size.x +
+        fabsf(obb->axes[1].x) * obb->size.y +
+        fabsf(obb->axes[2].x) * obb->size.z;
+    box->size.y = fabsf(obb->axes[0].y) * obb->size.x +
+        fabsf(obb->axes[1].y) * obb->size.y +
+        fabsf(obb->axes[2].y) * obb->size.z;
+    box->size.z = fabsf(obb->axes[0].z) * obb->size.x +
+        fabsf(obb->axes[1].z) * obb->size.y +
+        fabsf(obb->axes[2].z) * obb->size.z;
+}
+
+
+int Cyb_PointInOBB(const Cyb_Vec3 *a, const Cyb_OBB *b)
+{
+    Cyb_Vec3 d = {a->x - b->center.x, a->y - b->center.y, a->z - b->center.z};
+    return (fabsf(Cyb_Dot(&d, &b->axes[0])) < b->size.x / 2.0f &&
+        fabsf(Cyb_Dot(&d, &b->axes[1])) < b->size.y / 2.0f &&
+        fabsf(Cyb_Dot(&d, &b->axes[2])) < b->size.z / 2.0f);
+}
+
+
+int Cyb_OBBHitOBB(const Cyb_OBB *a, const Cyb_OBB *b)
+{
+    //Express b in the frame of a. An epsilon is added to the absolute rotation
+    //so that near parallel edges don't produce a bogus cross product axis.
+    float r[3][3];
+    float absR[3][3];
+    
+    for(int i = 0; i < 3; i++)
+    {
+        for(int j = 0; j < 3; j++)
+        {
+            r[i][j] = Cyb_Dot(&a->axes[i], &b->axes[j]);
+            absR[i][j] = fabsf(r[i][j]) + 1e-6f;
+        }
+    }
+    
+    Cyb_Vec3 d = {b->center.x - a->center.x, b->center.y - a->center.y,
+        b->center.z - a->center.z};
+    float t[3] = {
+        Cyb_Dot(&d, &a->axes[0]),
+        Cyb_Dot(&d, &a->axes[1]),
+        Cyb_Dot(&d, &a->axes[2])
+    };
+    float ea[3] = {a->size.x / 2.0f, a->size.y / 2.0f, a->size.z / 2.0f};
+    float eb[3] = {b->size.x / 2.0f, b->size.y / 2.0f, b->size.z / 2.0f};
+    
+    //Test the axes of a
+    for(int i = 0; i < 3; i++)
+    {
+        float rb = eb[0] * absR[i][0] + eb[1] * absR[i][1] +
+            eb[2] * absR[i][2];
+        
+        if(fabsf(t[i]) >= ea[i] + rb)
+        {
+            return FALSE;
+        }
+    }
+    
+    //Test the axes of b
+    for(int j = 0; j < 3; j++)
+    {
+        float ra = ea[0] * absR[0][j] + ea[1] * absR[1][j] +
+            ea[2] * absR[2][j];
+        float tb = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+        
+        if(fabsf(tb) >= ra + eb[j])
+        {
+            return FALSE;
+        }
+    }
+    
+    //Test the 9 cross products of an axis of a with an axis of b
+    for(int i = 0; i < 3; i++)
+    {
+        int i1 = (i + 1) % 3;
+        int i2 = (i + 2) % 3;
+        
+        for(int j = 0; j < 3; j++)
+        {
+            int j1 = (j + 1) % 3;
+            int j2 = (j + 2) % 3;
+            float ra = ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j];
+            float rb = eb[j1] * absR[i][j2] + eb[j2] * absR[i][j1];
+            float tc = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+            
+            if(fabsf(tc) >= ra + rb)
+            {
+                return FALSE;
+            }
+        }
+    }
+    
+    return TRUE;
+}
\ No newline at end of file
@@ -4,7 +4,13 @@ CybRender - Quaternion API
 
 #include <string.h>
 
+//The exported functions wrap the inline versions
+#undef CYB_MATH_INLINE
+
+#include "CybFastMath.h"
+#include "CybMathInline.h"
 #include "CybQuat.h"
+#include "CybWide.h"
 
 
 //Functions
@@ -12,29 +18,25 @@ CybRender - Quaternion API
 void Cyb_QuatFromAxisAndAngle(Cyb_Vec4 *quat, float x, float y, float z,
     float angle)
 {
-    quat->x = x * sinf(radians(angle) / 2.0f);
-    quat->y = y * sinf(radians(angle) / 2.0f);
-    quat->z = z * sinf(radians(angle) / 2.0f);
-    quat->w = cosf(radians(angle) / 2.0f);
+    float s;
+    float c;
+    Cyb_FastSinCos(radians(angle) / 2.0f, &s, &c);
+    quat->x = x * s;
+    quat->y = y * s;
+    quat->z = z * s;
+    quat->w = c;
 }
 
 
 void Cyb_MulQuat(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b)
 {
-    c->x = a->w * b->x + a->x * b->w + a->y * b->z - a->z * b->y;
-    c->y = a->w * b->y - a->x * b->z + a->y * b->w + a->z * b->x;
-    c->z = a->w * b->z + a->x * b->y - a->y * b->x + a->z * b->w;
-    c->w = a->w * b->w - a->x * b->x - a->y * b->y - a->z * b->z;
+    Cyb_InlineMulQuat(c, a, b);
 }
 
 
 void Cyb_NormalizeQuat(Cyb_Vec4 *quat)
 {
-    float magnitude = sqrt(quat->x * quat->x + quat->y * quat->y + quat->z * quat->z + quat->w * quat->w);
-    quat->x /= magnitude;
-    quat->y /= magnitude;
-    quat->z /= magnitude;
-    quat->w /= magnitude;
+    Cyb_InlineNormalizeQuat(quat);
 }
 
 
@@ -42,9 +44,10 @@ void Cyb_Slerp(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
     double progress)
 {
     //Calculate angle between a and b
-    double cosHalfTheta = a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w;
+    float t = (float)progress;
+    float cosHalfTheta = a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w;
     
-    if(fabs(cosHalfTheta) >= 1.0)
+    if(fabsf(cosHalfTheta) >= 1.0f)
     {
         memcpy(c, a, sizeof(Cyb_Vec4));
         return;
@@ -59,35 +62,41 @@ void Cyb_Slerp(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
         cosHalfTheta = -cosHalfTheta;
     }
     
-    //Calculate temp values
-    const double halfTheta = acos(cosHalfTheta);
-    const double sinHalfTheta = sqrt(1.0 - (cosHalfTheta * cosHalfTheta));
+    //Calculate temp values. sin(halfTheta), sin((1 - t) * halfTheta), and
+    //sin(t * halfTheta) are computed together in one 4-lane call.
+    const float halfTheta = Cyb_FastAcos(cosHalfTheta);
+    float sines[4];
+    Cyb_F4 cosines;
+    Cyb_F4Store(sines, Cyb_F4SinCos(Cyb_F4Mul(Cyb_F4Set1(halfTheta),
+        Cyb_F4Set(1.0f, 1.0f - t, t, 0.0f)), &cosines));
+    const float sinHalfTheta = sines[0];
     
     //If theta is 180 degrees, then the result is not fully defined since we could
     //rotate either direction to get there
-    if(fabs(sinHalfTheta) < .001)
+    if(fabsf(sinHalfTheta) < .001f)
     {
         if(!reverseB)
         {
-            c->x = (1.0 - progress) * a->x + progress * b->x;
-            c->y = (1.0 - progress) * a->y + progress * b->y;
-            c->z = (1.0 - progress) * a->z + progress * b->z;
-            c->w = (1.0 - progress) * a->w + progress * b->w;
+            c->x = (1.0f - t) * a->x + t * b->x;
+            c->y = (1.0f - t) * a->y + t * b->y;
+            c->z = (1.0f - t) * a->z + t * b->z;
+            c->w = (1.0f - t) * a->w + t * b->w;
         }
         else
         {
-            c->x = (1.0 - progress) * a->x - progress * b->x;
-            c->y = (1.0 - progress) * a->y - progress * b->y;
-            c->z = (1.0 - progress) * a->z - progress * b->z;
-            c->w = (1.0 - progress) * a->w - progress * b->w;
+            c->x = (1.0f - t) * a->x - t * b->x;
+            c->y = (1.0f - t) * a->y - t * b->y;
+            c->z = (1.0f - t) * a->z - t * b->z;
+            c->w = (1.0f - t) * a->w - t * b->w;
         }
         
         return;
     }
     
     //All other cases
-    const double tmp1 = sin((1.0 - progress) * halfTheta) / sinHalfTheta;
-    const double tmp2 = sin(progress * halfTheta) / sinHalfTheta;
+    const float invSinHalfTheta = 1.0f / sinHalfTheta;
+    const float tmp1 = sines[1] * invSinHalfTheta;
+    const float tmp2 = sines[2] * invSinHalfTheta;
     
     if(!reverseB)
     {
@@ -106,23 +115,71 @@ void Cyb_Slerp(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
 }
 
 
-void Cyb_QuatToMatrix(Cyb_Mat4 *mat, const Cyb_Vec4 *quat)
+void Cyb_Nlerp(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
+    float progress)
+{
+    //Run the 4-lane kernel on one lane so that the scalar and array versions
+    //give identical results
+    Cyb_Vec4 tmp[4];
+    Cyb_QuatX4Store(tmp, Cyb_QuatX4Nlerp(Cyb_QuatX4Set1(a),
+        Cyb_QuatX4Set1(b), Cyb_F4Set1(progress)));
+    *c = tmp[0];
+}
+
+
+void Cyb_FastSlerp(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
+    float progress)
+{
+    //Run the 4-lane kernel on one lane so that the scalar and array versions
+    //give identical results
+    Cyb_Vec4 tmp[4];
+    Cyb_QuatX4Store(tmp, Cyb_QuatX4FastSlerp(Cyb_QuatX4Set1(a),
+        Cyb_QuatX4Set1(b), Cyb_F4Set1(progress)));
+    *c = tmp[0];
+}
+
+
+void Cyb_NlerpArray(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
+    const float *progress, int count)
 {
-    //Start with the identity matrix
-    Cyb_Identity(mat);
+    //Interpolate 4 quaternions at a time
+    int i = 0;
     
-    //Row 1
-    mat->a = 1.0f - 2.0f * (quat->y * quat->y + quat->z * quat->z);
-    mat->b = 2.0f * (quat->x * quat->y - quat->w * quat->z);
-    mat->c = 2.0f * (quat->x * quat->z + quat->w * quat->y);
+    for(; i + 4 <= count; i += 4)
+    {
+        Cyb_QuatX4Store(c + i, Cyb_QuatX4Nlerp(Cyb_QuatX4Load(a + i),
+            Cyb_QuatX4Load(b + i), Cyb_F4Load(progress + i)));
+    }
+    
+    //Interpolate the rest
+    for(; i < count; i++)
+    {
+        Cyb_Nlerp(c + i, a + i, b + i, progress[i]);
+    }
+}
+
+
+void Cyb_FastSlerpArray(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b,
+    const float *progress, int count)
+{
+    //Interpolate 4 quaternions at a time
+    int i = 0;
     
-    //Row 2
-    mat->e = 2.0f * (quat->x * quat->y + quat->w * quat->z);
-    mat->f = 1.0f - 2.0f * (quat->x * quat->x + quat->z * quat->z);
-    mat->g = 2.0f * (quat->y * quat->z - quat->w * quat->x);
+    for(; i + 4 <= count; i += 4)
+    {
+        Cyb_QuatX4Store(c + i, Cyb_QuatX4FastSlerp(Cyb_QuatX4Load(a + i),
+            Cyb_QuatX4Load(b + i), Cyb_F4Load(progress + i)));
+    }
     
-    //Row 3
-    mat->i = 2.0f * (quat->x * quat->z - quat->w * quat->y);
-    mat->j = 2.0f * (quat->y * quat->z + quat->w * quat->x);
-    mat->k = 1.0f - 2.0f * (quat->x * quat->x + quat->y * quat->y);
+    //Interpolate the rest
+    for(; i < count; i++)
+    {
+        Cyb_FastSlerp(c + i, a + i, b + i, progress[i]);
+    }
+}
+
+
+void Cyb_QuatToMatrix(Cyb_Mat4 *mat, const Cyb_Vec4 *quat)
+{
+    Cyb_InlineQuatToMatrix(mat, quat);
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+/*
+CybMath - Random Number API
+*/
+
+#include <string.h>
+
+#include "CybRandom.h"
+#include "CybSIMD.h"
+
+
+//Functions
+//=================================================================================
+void Cyb_SeedRandom(Cyb_Random *rng, unsigned long long seed)
+{
+    //Expand the seed with splitmix64, which never gives an all zero state
+    for(int i = 0; i < 4; i += 2)
+    {
+        seed += 0x9e3779b97f4a7c15ull;
+        unsigned long long z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z ^= z >> 31;
+        rng->s[i] = (unsigned int)z;
+        rng->s[i + 1] = (unsigned int)(z >> 32);
+    }
+}
+
+
+void Cyb_FillRandom(Cyb_Random *rng, float *out, int count, float min,
+    float max)
+{
+    //Seed 4 generators in SoA form from the given one
+    int seeds[4][4];
+    
+    for(int i = 0; i < 4; i++)
+    {
+        Cyb_Random lane;
+        Cyb_SeedRandom(&lane, ((unsigned long long)Cyb_NextRandom(rng) << 32) |
+            Cyb_NextRandom(rng));
+        
+        for(int j = 0; j < 4; j++)
+        {
+            seeds[j][i] = (int)lane.s[j];
+        }
+    }
+    
+    Cyb_I4 s0 = Cyb_I4Load(seeds[0]);
+    Cyb_I4 s1 = Cyb_I4Load(seeds[1]);
+    Cyb_I4 s2 = Cyb_I4Load(seeds[2]);
+    Cyb_I4 s3 = Cyb_I4Load(seeds[3]);
+    Cyb_F4 scale = Cyb_F4Set1((max - min) / 16777216.0f);
+    Cyb_F4 offset = Cyb_F4Set1(min);
+    
+    for(int i = 0; i < count; i += 4)
+    {
+        //xoshiro128** with the multiplications by 5 and 9 done as shifts
+        Cyb_I4 x = Cyb_I4Add(s1, Cyb_I4ShiftLeft(s1, 2));
+        x = Cyb_I4Or(Cyb_I4ShiftLeft(x, 7), Cyb_I4ShiftRight(x, 25));
+        x = Cyb_I4Add(x, Cyb_I4ShiftLeft(x, 3));
+        Cyb_I4 t = Cyb_I4ShiftLeft(s1, 9);
+        s2 = Cyb_I4Xor(s2, s0);
+        s3 = Cyb_I4Xor(s3, s1);
+        s1 = Cyb_I4Xor(s1, s2);
+        s0 = Cyb_I4Xor(s0, s3);
+        s2 = Cyb_I4Xor(s2, t);
+        s3 = Cyb_I4Or(Cyb_I4ShiftLeft(s3, 11), Cyb_I4ShiftRight(s3, 21));
+        
+        //Map the top 24 bits to [min, max)
+        Cyb_F4 f = Cyb_F4MulAdd(Cyb_I4ToF4(Cyb_I4ShiftRight(x, 8)), scale,
+            offset);
+        
+        if(i + 4 <= count)
+        {
+            Cyb_F4Store(&out[i], f);
+        }
+        else
+        {
+            float tmp[4];
+            Cyb_F4Store(tmp, f);
+            memcpy(&out[i], tmp, (count - i) * sizeof(float));
+        }
+    }
+}
\ No newline at end of file
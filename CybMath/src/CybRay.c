@@ -0,0 +1,688 @@
+/*
+CybMath - Ray API
+*/
+
+#include <math.h>
+
+#include "CybRay.h"
+#include "CybSIMD.h"
+
+#define CYB_TRI_EPSILON 1e-12f
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    Cyb_F4 x;
+    Cyb_F4 y;
+    Cyb_F4 z;
+} Cyb_F4Vec3;
+
+
+typedef struct
+{
+    Cyb_F4Vec3 origin;
+    Cyb_F4Vec3 dir;
+} Cyb_F4Ray;
+
+
+//Functions
+//=================================================================================
+static void Cyb_LoadF4Ray(Cyb_F4Ray *r, const float *ox, const float *oy,
+    const float *oz, const float *dx, const float *dy, const float *dz)
+{
+    r->origin.x = Cyb_F4Load(ox);
+    r->origin.y = Cyb_F4Load(oy);
+    r->origin.z = Cyb_F4Load(oz);
+    r->dir.x = Cyb_F4Load(dx);
+    r->dir.y = Cyb_F4Load(dy);
+    r->dir.z = Cyb_F4Load(dz);
+}
+
+
+static void Cyb_SplatF4Ray(Cyb_F4Ray *r, const Cyb_Ray *ray)
+{
+    r->origin.x = Cyb_F4Set1(ray->origin.x);
+    r->origin.y = Cyb_F4Set1(ray->origin.y);
+    r->origin.z = Cyb_F4Set1(ray->origin.z);
+    r->dir.x = Cyb_F4Set1(ray->dir.x);
+    r->dir.y = Cyb_F4Set1(ray->dir.y);
+    r->dir.z = Cyb_F4Set1(ray->dir.z);
+}
+
+
+static Cyb_F4 Cyb_F4Dot3(const Cyb_F4Vec3 *a, const Cyb_F4Vec3 *b)
+{
+    return Cyb_F4MulAdd(a->x, b->x, Cyb_F4MulAdd(a->y, b->y, 
+        Cyb_F4Mul(a->z, b->z)));
+}
+
+
+static void Cyb_F4Cross3(Cyb_F4Vec3 *c, const Cyb_F4Vec3 *a, 
+    const Cyb_F4Vec3 *b)
+{
+    c->x = Cyb_F4Sub(Cyb_F4Mul(a->y, b->z), Cyb_F4Mul(a->z, b->y));
+    c->y = Cyb_F4Sub(Cyb_F4Mul(a->z, b->x), Cyb_F4Mul(a->x, b->z));
+    c->z = Cyb_F4Sub(Cyb_F4Mul(a->x, b->y), Cyb_F4Mul(a->y, b->x));
+}
+
+
+static void Cyb_SplatF4Vec3(Cyb_F4Vec3 *out, const Cyb_Vec3 *v)
+{
+    out->x = Cyb_F4Set1(v->x);
+    out->y = Cyb_F4Set1(v->y);
+    out->z = Cyb_F4Set1(v->z);
+}
+
+
+static Cyb_F4 Cyb_F4RayHitBox(const Cyb_F4Ray *r, const Cyb_Box *b, 
+    Cyb_F4 *t)
+{
+    Cyb_F4 zero = Cyb_F4Set1(0.0f);
+    Cyb_F4 one = Cyb_F4Set1(1.0f);
+    const Cyb_F4 *origin = &r->origin.x;
+    const Cyb_F4 *dir = &r->dir.x;
+    const float *center = &b->center.x;
+    const float *size = &b->size.x;
+    Cyb_F4 tnear = zero;
+    Cyb_F4 tfar = Cyb_F4Set1(INFINITY);
+    Cyb_F4 miss = zero;
+    
+    //Clip the rays against each pair of slabs
+    for(int i = 0; i < 3; i++)
+    {
+        Cyb_F4 lo = Cyb_F4Set1(center[i] - size[i] / 2.0f);
+        Cyb_F4 hi = Cyb_F4Set1(center[i] + size[i] / 2.0f);
+        Cyb_F4 parallel = Cyb_F4CmpLe(Cyb_F4Abs(dir[i]), zero);
+        Cyb_F4 invDir = Cyb_F4Div(one, Cyb_F4Select(parallel, one, dir[i]));
+        Cyb_F4 t0 = Cyb_F4Mul(Cyb_F4Sub(lo, origin[i]), invDir);
+        Cyb_F4 t1 = Cyb_F4Mul(Cyb_F4Sub(hi, origin[i]), invDir);
+        
+        //Rays parallel to the slab miss if they start outside of it
+        miss = Cyb_F4Or(miss, Cyb_F4And(parallel, Cyb_F4Or(
+            Cyb_F4CmpLt(origin[i], lo), Cyb_F4CmpGt(origin[i], hi))));
+        tnear = Cyb_F4Select(parallel, tnear, 
+            Cyb_F4Max(tnear, Cyb_F4Min(t0, t1)));
+        tfar = Cyb_F4Select(parallel, tfar, 
+            Cyb_F4Min(tfar, Cyb_F4Max(t0, t1)));
+    }
+    
+    *t = tnear;
+    return Cyb_F4Select(miss, zero, Cyb_F4CmpLe(tnear, tfar));
+}
+
+
+static Cyb_F4 Cyb_F4RayHitSphere(const Cyb_F4Ray *r, const Cyb_Sphere *s,
+    Cyb_F4 *t)
+{
+    //Solve |o + d * t - c|^2 = r^2
+    Cyb_F4Vec3 center;
+    Cyb_F4Vec3 oc;
+    Cyb_SplatF4Vec3(&center, &s->center);
+    oc.x = Cyb_F4Sub(r->origin.x, center.x);
+    oc.y = Cyb_F4Sub(r->origin.y, center.y);
+    oc.z = Cyb_F4Sub(r->origin.z, center.z);
+    Cyb_F4 a = Cyb_F4Dot3(&r->dir, &r->dir);
+    Cyb_F4 b = Cyb_F4Dot3(&oc, &r->dir);
+    Cyb_F4 c = Cyb_F4Sub(Cyb_F4Dot3(&oc, &oc), 
+        Cyb_F4Set1(s->radius * s->radius));
+    Cyb_F4 disc = Cyb_F4Sub(Cyb_F4Mul(b, b), Cyb_F4Mul(a, c));
+    Cyb_F4 zero = Cyb_F4Set1(0.0f);
+    Cyb_F4 root = Cyb_F4Sqrt(Cyb_F4Max(disc, zero));
+    Cyb_F4 nb = Cyb_F4Sub(zero, b);
+    
+    //Hit if the far root is ahead of the origin
+    *t = Cyb_F4Max(Cyb_F4Div(Cyb_F4Sub(nb, root), a), zero);
+    return Cyb_F4And(Cyb_F4CmpGe(disc, zero), 
+        Cyb_F4CmpGe(Cyb_F4Add(nb, root), zero));
+}
+
+
+static Cyb_F4 Cyb_F4RayHitTriangle(const Cyb_F4Ray *r, const Cyb_F4Vec3 *v0,
+    const Cyb_F4Vec3 *e1, const Cyb_F4Vec3 *e2, Cyb_F4 *t)
+{
+    //Moller-Trumbore
+    Cyb_F4Vec3 p;
+    Cyb_F4Vec3 s;
+    Cyb_F4Vec3 q;
+    Cyb_F4 zero = Cyb_F4Set1(0.0f);
+    Cyb_F4 one = Cyb_F4Set1(1.0f);
+    Cyb_F4Cross3(&p, &r->dir, e2);
+    Cyb_F4 det = Cyb_F4Dot3(e1, &p);
+    Cyb_F4 valid = Cyb_F4CmpGt(Cyb_F4Abs(det), Cyb_F4Set1(CYB_TRI_EPSILON));
+    Cyb_F4 invDet = Cyb_F4Div(one, Cyb_F4Select(valid, det, one));
+    s.x = Cyb_F4Sub(r->origin.x, v0->x);
+    s.y = Cyb_F4Sub(r->origin.y, v0->y);
+    s.z = Cyb_F4Sub(r->origin.z, v0->z);
+    Cyb_F4 u = Cyb_F4Mul(Cyb_F4Dot3(&s, &p), invDet);
+    Cyb_F4Cross3(&q, &s, e1);
+    Cyb_F4 v = Cyb_F4Mul(Cyb_F4Dot3(&r->dir, &q), invDet);
+    *t = Cyb_F4Mul(Cyb_F4Dot3(e2, &q), invDet);
+    valid = Cyb_F4And(valid, Cyb_F4CmpGe(u, zero));
+    valid = Cyb_F4And(valid, Cyb_F4CmpGe(v, zero));
+    valid = Cyb_F4And(valid, Cyb_F4CmpLe(Cyb_F4Add(u, v), one));
+    return Cyb_F4And(valid, Cyb_F4CmpGe(*t, zero));
+}
+
+
+static void Cyb_SplatTriangle(Cyb_F4Vec3 *v0, Cyb_F4Vec3 *e1, Cyb_F4Vec3 *e2,
+    const Cyb_Vec3 *a, const Cyb_Vec3 *b, const Cyb_Vec3 *c)
+{
+    v0->x = Cyb_F4Set1(a->x);
+    v0->y = Cyb_F4Set1(a->y);
+    v0->z = Cyb_F4Set1(a->z);
+    e1->x = Cyb_F4Set1(b->x - a->x);
+    e1->y = Cyb_F4Set1(b->y - a->y);
+    e1->z = Cyb_F4Set1(b->z - a->z);
+    e2->x = Cyb_F4Set1(c->x - a->x);
+    e2->y = Cyb_F4Set1(c->y - a->y);
+    e2->z = Cyb_F4Set1(c->z - a->z);
+}
+
+
+static int Cyb_F4RayHitTriangles(const Cyb_F4Ray *r, const Cyb_Vec3 *verts,
+    const unsigned int *indices, int triCount, float *t, int *tris)
+{
+    Cyb_F4 best = Cyb_F4Load(t);
+    int hitMask = 0;
+    
+    for(int i = 0; i < triCount; i++)
+    {
+        Cyb_F4Vec3 v0;
+        Cyb_F4Vec3 e1;
+        Cyb_F4Vec3 e2;
+        Cyb_F4 tt;
+        Cyb_SplatTriangle(&v0, &e1, &e2, &verts[indices[i * 3]], 
+            &verts[indices[i * 3 + 1]], &verts[indices[i * 3 + 2]]);
+        Cyb_F4 hit = Cyb_F4RayHitTriangle(r, &v0, &e1, &e2, &tt);
+        hit = Cyb_F4And(hit, Cyb_F4CmpLt(tt, best));
+        int bits = Cyb_F4MoveMask(hit);
+        
+        //Record closer hits
+        if(bits)
+        {
+            best = Cyb_F4Select(hit, tt, best);
+            hitMask |= bits;
+            
+            for(int lane = 0; tris && lane < 4; lane++)
+            {
+                if(bits & (1 << lane))
+                {
+                    tris[lane] = i;
+                }
+            }
+        }
+    }
+    
+    Cyb_F4Store(t, best);
+    return hitMask;
+}
+
+
+void Cyb_PointOnRay(Cyb_Vec3 *point, const Cyb_Ray *ray, float t)
+{
+    point->x = ray->origin.x + ray->dir.x * t;
+    point->y = ray->origin.y + ray->dir.y * t;
+    point->z = ray->origin.z + ray->dir.z * t;
+}
+
+
+int Cyb_RayHitBox(const Cyb_Ray *a, const Cyb_Box *b, float *t)
+{
+    //Clip the ray against each pair of slabs
+    float tmin = 0.0f;
+    float tmax = INFINITY;
+    const float *origin = &a->origin.x;
+    const float *dir = &a->dir.x;
+    const float *center = &b->center.x;
+    const float *size = &b->size.x;
+    
+    for(int i = 0; i < 3; i++)
+    {
+        float lo = center[i] - size[i] / 2.0f;
+        float hi = center[i] + size[i] / 2.0f;
+        
+        //Ray parallel to slab?
+        if(dir[i] == 0.0f)
+        {
+            if(origin[i] < lo || origin[i] > hi)
+            {
+                return FALSE;
+            }
+            
+            continue;
+        }
+        
+        float invDir = 1.0f / dir[i];
+        float t0 = (lo - origin[i]) * invDir;
+        float t1 = (hi - origin[i]) * invDir;
+        
+        if(t0 > t1)
+        {
+            float tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+        
+        tmin = t0 > tmin ? t0 : tmin;
+        tmax = t1 < tmax ? t1 : tmax;
+        
+        if(tmin > tmax)
+        {
+            return FALSE;
+        }
+    }
+    
+    if(t)
+    {
+        *t = tmin;
+    }
+    
+    return TRUE;
+}
+
+
+int Cyb_RayHitOBB(const Cyb_Ray *a, const Cyb_OBB *b, float *t)
+{
+    //Move the ray into the box's frame. The axes are orthonormal, so distances
+    //along the ray are unchanged.
+    Cyb_Vec3 d = {a->origin.x - b->center.x, a->origin.y - b->center.y,
+        a->origin.z - b->center.z};
+    Cyb_Ray local;
+    Cyb_Box box = {{0.0f, 0.0f, 0.0f}, b->size};
+    
+    for(int i = 0; i < 3; i++)
+    {
+        const Cyb_Vec3 *axis = &b->axes[i];
+        (&local.origin.x)[i] = d.x * axis->x + d.y * axis->y + d.z * axis->z;
+        (&local.dir.x)[i] = a->dir.x * axis->x + a->dir.y * axis->y + 
+            a->dir.z * axis->z;
+    }
+    
+    return Cyb_RayHitBox(&local, &box, t);
+}
+
+
+int Cyb_RayHitSphere(const Cyb_Ray *a, const Cyb_Sphere *b, float *t)
+{
+    //Solve |o + d * t - c|^2 = r^2
+    float ocx = a->origin.x - b->center.x;
+    float ocy = a->origin.y - b->center.y;
+    float ocz = a->origin.z - b->center.z;
+    float qa = a->dir.x * a->dir.x + a->dir.y * a->dir.y + a->dir.z * a->dir.z;
+    float qb = ocx * a->dir.x + ocy * a->dir.y + ocz * a->dir.z;
+    float qc = ocx * ocx + ocy * ocy + ocz * ocz - b->radius * b->radius;
+    float disc = qb * qb - qa * qc;
+    
+    if(disc < 0.0f)
+    {
+        return FALSE;
+    }
+    
+    //Is the sphere behind the ray?
+    float root = sqrtf(disc);
+    
+    if(-qb + root < 0.0f)
+    {
+        return FALSE;
+    }
+    
+    if(t)
+    {
+        float tnear = (-qb - root) / qa;
+        *t = tnear > 0.0f ? tnear : 0.0f;
+    }
+    
+    return TRUE;
+}
+
+
+int Cyb_RayHitTriangle(const Cyb_Ray *a, const Cyb_Vec3 *v0, 
+    const Cyb_Vec3 *v1, const Cyb_Vec3 *v2, float *t)
+{
+    //Calculate edges
+    float e1x = v1->x - v0->x;
+    float e1y = v1->y - v0->y;
+    float e1z = v1->z - v0->z;
+    float e2x = v2->x - v0->x;
+    float e2y = v2->y - v0->y;
+    float e2z = v2->z - v0->z;
+    
+    //Ray parallel to triangle?
+    float px = a->dir.y * e2z - a->dir.z * e2y;
+    float py = a->dir.z * e2x - a->dir.x * e2z;
+    float pz = a->dir.x * e2y - a->dir.y * e2x;
+    float det = e1x * px + e1y * py + e1z * pz;
+    
+    if(fabsf(det) <= CYB_TRI_EPSILON)
+    {
+        return FALSE;
+    }
+    
+    //Calculate barycentric coordinates
+    float invDet = 1.0f / det;
+    float sx = a->origin.x - v0->x;
+    float sy = a->origin.y - v0->y;
+    float sz = a->origin.z - v0->z;
+    float u = (sx * px + sy * py + sz * pz) * invDet;
+    
+    if(u < 0.0f || u > 1.0f)
+    {
+        return FALSE;
+    }
+    
+    float qx = sy * e1z - sz * e1y;
+    float qy = sz * e1x - sx * e1z;
+    float qz = sx * e1y - sy * e1x;
+    float v = (a->dir.x * qx + a->dir.y * qy + a->dir.z * qz) * invDet;
+    
+    if(v < 0.0f || u + v > 1.0f)
+    {
+        return FALSE;
+    }
+    
+    //Is the triangle behind the ray?
+    float dist = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+    
+    if(dist < 0.0f)
+    {
+        return FALSE;
+    }
+    
+    if(t)
+    {
+        *t = dist;
+    }
+    
+    return TRUE;
+}
+
+
+int Cyb_RayHitTriangles(const Cyb_Ray *a, const Cyb_Vec3 *verts,
+    const unsigned int *indices, int triCount, float *t)
+{
+    Cyb_F4Ray r;
+    Cyb_SplatF4Ray(&r, a);
+    Cyb_F4 best = Cyb_F4Set1(*t);
+    int bestTri[4] = {-1, -1, -1, -1};
+    int i = 0;
+    
+    //Test 4 triangles at a time
+    for(; i + 4 <= triCount; i += 4)
+    {
+        const unsigned int *tri = &indices[i * 3];
+        const Cyb_Vec3 *v0[4] = {&verts[tri[0]], &verts[tri[3]], 
+            &verts[tri[6]], &verts[tri[9]]};
+        const Cyb_Vec3 *v1[4] = {&verts[tri[1]], &verts[tri[4]], 
+            &verts[tri[7]], &verts[tri[10]]};
+        const Cyb_Vec3 *v2[4] = {&verts[tri[2]], &verts[tri[5]], 
+            &verts[tri[8]], &verts[tri[11]]};
+        Cyb_F4Vec3 p0;
+        Cyb_F4Vec3 e1;
+        Cyb_F4Vec3 e2;
+        Cyb_F4 tt;
+        p0.x = Cyb_F4Set(v0[0]->x, v0[1]->x, v0[2]->x, v0[3]->x);
+        p0.y = Cyb_F4Set(v0[0]->y, v0[1]->y, v0[2]->y, v0[3]->y);
+        p0.z = Cyb_F4Set(v0[0]->z, v0[1]->z, v0[2]->z, v0[3]->z);
+        e1.x = Cyb_F4Sub(Cyb_F4Set(v1[0]->x, v1[1]->x, v1[2]->x, v1[3]->x), 
+            p0.x);
+        e1.y = Cyb_F4Sub(Cyb_F4Set(v1[0]->y, v1[1]->y, v1[2]->y, v1[3]->y), 
+            p0.y);
+        e1.z = Cyb_F4Sub(Cyb_F4Set(v1[0]->z, v1[1]->z, v1[2]->z, v1[3]->z), 
+            p0.z);
+        e2.x = Cyb_F4Sub(Cyb_F4Set(v2[0]->x, v2[1]->x, v2[2]->x, v2[3]->x), 
+            p0.x);
+        e2.y = Cyb_F4Sub(Cyb_F4Set(v2[0]->y, v2[1]->y, v2[2]->y, v2[3]->y), 
+            p0.y);
+        e2.z = Cyb_F4Sub(Cyb_F4Set(v2[0]->z, v2[1]->z, v2[2]->z, v2[3]->z), 
+            p0.z);
+        Cyb_F4 hit = Cyb_F4RayHitTriangle(&r, &p0, &e1, &e2, &tt);
+        hit = Cyb_F4And(hit, Cyb_F4CmpLt(tt, best));
+        int bits = Cyb_F4MoveMask(hit);
+        
+        if(bits)
+        {
+            best = Cyb_F4Select(hit, tt, best);
+            
+            for(int lane = 0; lane < 4; lane++)
+            {
+                if(bits & (1 << lane))
+                {
+                    bestTri[lane] = i + lane;
+                }
+            }
+        }
+    }
+    
+    //Pick the closest lane
+    float dists[4];
+    float closest = *t;
+    int closestTri = -1;
+    Cyb_F4Store(dists, best);
+    
+    for(int lane = 0; lane < 4; lane++)
+    {
+        if(bestTri[lane] >= 0 && dists[lane] < closest)
+        {
+            closest = dists[lane];
+            closestTri = bestTri[lane];
+        }
+    }
+    
+    //Test remaining triangles
+    for(; i < triCount; i++)
+    {
+        float dist;
+        
+        if(Cyb_RayHitTriangle(a, &verts[indices[i * 3]], 
+            &verts[indices[i * 3 + 1]], &verts[indices[i * 3 + 2]], &dist) &&
+            dist < closest)
+        {
+            closest = dist;
+            closestTri = i;
+        }
+    }
+    
+    *t = closest;
+    return closestTri;
+}
+
+
+void Cyb_MakeRayPacket4(Cyb_RayPacket4 *packet, const Cyb_Ray *rays)
+{
+    for(int i = 0; i < 4; i++)
+    {
+        packet->ox[i] = rays[i].origin.x;
+        packet->oy[i] = rays[i].origin.y;
+        packet->oz[i] = rays[i].origin.z;
+        packet->dx[i] = rays[i].dir.x;
+        packet->dy[i] = rays[i].dir.y;
+        packet->dz[i] = rays[i].dir.z;
+    }
+}
+
+
+void Cyb_MakeRayPacket8(Cyb_RayPacket8 *packet, const Cyb_Ray *rays)
+{
+    for(int i = 0; i < 8; i++)
+    {
+        packet->ox[i] = rays[i].origin.x;
+        packet->oy[i] = rays[i].origin.y;
+        packet->oz[i] = rays[i].origin.z;
+        packet->dx[i] = rays[i].dir.x;
+        packet->dy[i] = rays[i].dir.y;
+        packet->dz[i] = rays[i].dir.z;
+    }
+}
+
+
+int Cyb_RayPacket4HitBox(const Cyb_RayPacket4 *a, const Cyb_Box *b, float *t)
+{
+    Cyb_F4Ray r;
+    Cyb_F4 tt;
+    Cyb_LoadF4Ray(&r, a->ox, a->oy, a->oz, a->dx, a->dy, a->dz);
+    int bits = Cyb_F4MoveMask(Cyb_F4RayHitBox(&r, b, &tt));
+    
+    if(t)
+    {
+        Cyb_F4Store(t, tt);
+    }
+    
+    return bits;
+}
+
+
+int Cyb_RayPacket8HitBox(const Cyb_RayPacket8 *a, const Cyb_Box *b, float *t)
+{
+    int bits = 0;
+    
+    //Test each half of the packet
+    for(int i = 0; i < 8; i += 4)
+    {
+        Cyb_F4Ray r;
+        Cyb_F4 tt;
+        Cyb_LoadF4Ray(&r, &a->ox[i], &a->oy[i], &a->oz[i], &a->dx[i], 
+            &a->dy[i], &a->dz[i]);
+        bits |= Cyb_F4MoveMask(Cyb_F4RayHitBox(&r, b, &tt)) << i;
+        
+        if(t)
+        {
+            Cyb_F4Store(&t[i], tt);
+        }
+    }
+    
+    return bits;
+}
+
+
+int Cyb_RayPacket4HitSphere(const Cyb_RayPacket4 *a, 
+    const Cyb_Sphere *b, float *t)
+{
+    Cyb_F4Ray r;
+    Cyb_F4 tt;
+    Cyb_LoadF4Ray(&r, a->ox, a->oy, a->oz, a->dx, a->dy, a->dz);
+    int bits = Cyb_F4MoveMask(Cyb_F4RayHitSphere(&r, b, &tt));
+    
+    if(t)
+    {
+        Cyb_F4Store(t, tt);
+    }
+    
+    return bits;
+}
+
+
+int Cyb_RayPacket8HitSphere(const Cyb_RayPacket8 *a, 
+    const Cyb_Sphere *b, float *t)
+{
+    int bits = 0;
+    
+    //Test each half of the packet
+    for(int i = 0; i < 8; i += 4)
+    {
+        Cyb_F4Ray r;
+        Cyb_F4 tt;
+        Cyb_LoadF4Ray(&r, &a->ox[i], &a->oy[i], &a->oz[i], &a->dx[i], 
+            &a->dy[i], &a->dz[i]);
+        bits |= Cyb_F4MoveMask(Cyb_F4RayHitSphere(&r, b, &tt)) << i;
+        
+        if(t)
+        {
+            Cyb_F4Store(&t[i], tt);
+        }
+    }
+    
+    return bits;
+}
+
+
+int Cyb_RayPacket4HitTriangle(const Cyb_RayPacket4 *a, 
+    const Cyb_Vec3 *v0, const Cyb_Vec3 *v1, const Cyb_Vec3 *v2, float *t)
+{
+    Cyb_F4Ray r;
+    Cyb_F4Vec3 p0;
+    Cyb_F4Vec3 e1;
+    Cyb_F4Vec3 e2;
+    Cyb_F4 tt;
+    Cyb_LoadF4Ray(&r, a->ox, a->oy, a->oz, a->dx, a->dy, a->dz);
+    Cyb_SplatTriangle(&p0, &e1, &e2, v0, v1, v2);
+    int bits = Cyb_F4MoveMask(Cyb_F4RayHitTriangle(&r, &p0, &e1, &e2, &tt));
+    
+    if(t)
+    {
+        Cyb_F4Store(t, tt);
+    }
+    
+    return bits;
+}
+
+
+int Cyb_RayPacket8HitTriangle(const Cyb_RayPacket8 *a, 
+    const Cyb_Vec3 *v0, const Cyb_Vec3 *v1, const Cyb_Vec3 *v2, float *t)
+{
+    Cyb_F4Vec3 p0;
+    Cyb_F4Vec3 e1;
+    Cyb_F4Vec3 e2;
+    int bits = 0;
+    Cyb_SplatTriangle(&p0, &e1, &e2, v0, v1, v2);
+    
+    //Test each half of the packet
+    for(int i = 0; i < 8; i += 4)
+    {
+        Cyb_F4Ray r;
+        Cyb_F4 tt;
+        Cyb_LoadF4Ray(&r, &a->ox[i], &a->oy[i], &a->oz[i], &a->dx[i], 
+            &a->dy[i], &a->dz[i]);
+        bits |= Cyb_F4MoveMask(Cyb_F4RayHitTriangle(&r, &p0, &e1, &e2, 
+            &tt)) << i;
+        
+        if(t)
+        {
+            Cyb_F4Store(&t[i], tt);
+        }
+    }
+    
+    return bits;
+}
+
+
+int Cyb_RayPacket4HitTriangles(const Cyb_RayPacket4 *a, 
+    const Cyb_Vec3 *verts, const unsigned int *indices, int triCount, 
+    float *t, int *tris)
+{
+    Cyb_F4Ray r;
+    Cyb_LoadF4Ray(&r, a->ox, a->oy, a->oz, a->dx, a->dy, a->dz);
+    
+    for(int i = 0; tris && i < 4; i++)
+    {
+        tris[i] = -1;
+    }
+    
+    return Cyb_F4RayHitTriangles(&r, verts, indices, triCount, t, tris);
+}
+
+
+int Cyb_RayPacket8HitTriangles(const Cyb_RayPacket8 *a, 
+    const Cyb_Vec3 *verts, const unsigned int *indices, int triCount, 
+    float *t, int *tris)
+{
+    int bits = 0;
+    
+    for(int i = 0; tris && i < 8; i++)
+    {
+        tris[i] = -1;
+    }
+    
+    //Test each half of the packet
+    for(int i = 0; i < 8; i += 4)
+    {
+        Cyb_F4Ray r;
+        Cyb_LoadF4Ray(&r, &a->ox[i], &a->oy[i], &a->oz[i], &a->dx[i], 
+            &a->dy[i], &a->dz[i]);
+        bits |= Cyb_F4RayHitTriangles(&r, verts, indices, triCount, &t[i], 
+            tris ? &tris[i] : NULL) << i;
+    }
+    
+    return bits;
+}
\ No newline at end of file
@@ -3,12 +3,192 @@ CybMath - Sphere API
 */
 
 #include <math.h>
+#include <string.h>
 
 #include "CybSphere.h"
 
 
+//Globals
+//=================================================================================
+static const float eposDirs[13][3] = {
+    //Coordinate axes
+    {1, 0, 0}, {0, 1, 0}, {0, 0, 1},
+    
+    //Corner diagonals
+    {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1},
+    
+    //Edge diagonals
+    {1, 1, 0}, {1, -1, 0}, {1, 0, 1}, {1, 0, -1}, {0, 1, 1}, {0, 1, -1}
+};
+
+
 //Functions
 //=================================================================================
+static const Cyb_Vec3 *Cyb_GetVert(const void *verts, int stride, int i)
+{
+    return (const Cyb_Vec3*)((const char*)verts + i * stride);
+}
+
+
+static float Cyb_DistSq(const Cyb_Vec3 *a, const Cyb_Vec3 *b)
+{
+    float dx = a->x - b->x;
+    float dy = a->y - b->y;
+    float dz = a->z - b->z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+
+static const Cyb_Vec3 *Cyb_FindFarthest(const Cyb_Vec3 *p, const void *verts,
+    int stride, int count)
+{
+    const Cyb_Vec3 *farthest = p;
+    float best = -1.0f;
+    
+    for(int i = 0; i < count; i++)
+    {
+        const Cyb_Vec3 *vert = Cyb_GetVert(verts, stride, i);
+        float d = Cyb_DistSq(p, vert);
+        
+        if(d > best)
+        {
+            best = d;
+            farthest = vert;
+        }
+    }
+    
+    return farthest;
+}
+
+
+static void Cyb_FindExtremalPair(const Cyb_Vec3 **a, const Cyb_Vec3 **b,
+    const void *verts, int stride, int count, int dirCount)
+{
+    //Find the minimum and maximum vertex along each direction
+    const Cyb_Vec3 *lo[13];
+    const Cyb_Vec3 *hi[13];
+    float loDist[13];
+    float hiDist[13];
+    
+    for(int j = 0; j < dirCount; j++)
+    {
+        lo[j] = hi[j] = Cyb_GetVert(verts, stride, 0);
+        loDist[j] = hiDist[j] = eposDirs[j][0] * lo[j]->x + 
+            eposDirs[j][1] * lo[j]->y + eposDirs[j][2] * lo[j]->z;
+    }
+    
+    for(int i = 1; i < count; i++)
+    {
+        const Cyb_Vec3 *vert = Cyb_GetVert(verts, stride, i);
+        
+        for(int j = 0; j < dirCount; j++)
+        {
+            float d = eposDirs[j][0] * vert->x + eposDirs[j][1] * vert->y + 
+                eposDirs[j][2] * vert->z;
+            
+            if(d < loDist[j])
+            {
+                loDist[j] = d;
+                lo[j] = vert;
+            }
+            else if(d > hiDist[j])
+            {
+                hiDist[j] = d;
+                hi[j] = vert;
+            }
+        }
+    }
+    
+    //Pick the most distant pair
+    float best = -1.0f;
+    
+    for(int j = 0; j < dirCount; j++)
+    {
+        float d = Cyb_DistSq(lo[j], hi[j]);
+        
+        if(d > best)
+        {
+            best = d;
+            *a = lo[j];
+            *b = hi[j];
+        }
+    }
+}
+
+
+void Cyb_SphereFromGeometry(Cyb_Sphere *sphere, const void *verts,
+    int stride, int count, int method)
+{
+    //No vertices?
+    if(count <= 0)
+    {
+        memset(sphere, 0, sizeof(Cyb_Sphere));
+        return;
+    }
+    
+    //Find 2 distant points to seed the sphere
+    const Cyb_Vec3 *a;
+    const Cyb_Vec3 *b;
+    
+    switch(method)
+    {
+    case CYB_SPHERE_EPOS6:
+        Cyb_FindExtremalPair(&a, &b, verts, stride, count, 3);
+        break;
+        
+    case CYB_SPHERE_EPOS14:
+        Cyb_FindExtremalPair(&a, &b, verts, stride, count, 7);
+        break;
+        
+    case CYB_SPHERE_EPOS26:
+        Cyb_FindExtremalPair(&a, &b, verts, stride, count, 13);
+        break;
+        
+    default:
+        //Ritter's method: the farthest point from an arbitrary point and the
+        //farthest point from that
+        a = Cyb_FindFarthest(Cyb_GetVert(verts, stride, 0), verts, stride, 
+            count);
+        b = Cyb_FindFarthest(a, verts, stride, count);
+        break;
+    }
+    
+    float cx = (a->x + b->x) * .5f;
+    float cy = (a->y + b->y) * .5f;
+    float cz = (a->z + b->z) * .5f;
+    float r = sqrtf(Cyb_DistSq(a, b)) * .5f;
+    float r2 = r * r;
+    
+    //Grow the sphere to include every vertex
+    for(int i = 0; i < count; i++)
+    {
+        const Cyb_Vec3 *vert = Cyb_GetVert(verts, stride, i);
+        float dx = vert->x - cx;
+        float dy = vert->y - cy;
+        float dz = vert->z - cz;
+        float d2 = dx * dx + dy * dy + dz * dz;
+        
+        if(d2 > r2)
+        {
+            //Move the center toward the vertex so the far side stays put
+            float d = sqrtf(d2);
+            float newR = (r + d) * .5f;
+            float k = (newR - r) / d;
+            cx += dx * k;
+            cy += dy * k;
+            cz += dz * k;
+            r = newR;
+            r2 = r * r;
+        }
+    }
+    
+    sphere->center.x = cx;
+    sphere->center.y = cy;
+    sphere->center.z = cz;
+    sphere->radius = r;
+}
+
+
 int Cyb_PointInSphere(const Cyb_Vec3 *a, const Cyb_Sphere *b)
 {
     float xdist = fabs(b->center.x - a->x);
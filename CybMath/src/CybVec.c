@@ -2,6 +2,10 @@
 CybMath - Mathematical Vector API
 */
 
+//The exported functions wrap the inline versions
+#undef CYB_MATH_INLINE
+
+#include "CybMathInline.h"
 #include "CybVec.h"
 
 
@@ -9,110 +13,78 @@ CybMath - Mathematical Vector API
 //=================================================================================
 void Cyb_AddVec2(Cyb_Vec2 *c, const Cyb_Vec2 *a, const Cyb_Vec2 *b)
 {
-    c->x = a->x + b->x;
-    c->y = a->y + b->y;
+    Cyb_InlineAddVec2(c, a, b);
 }
 
 
 void Cyb_SubVec2(Cyb_Vec2 *c, const Cyb_Vec2 *a, const Cyb_Vec2 *b)
 {
-    c->x = a->x - b->x;
-    c->y = a->y - b->y;
+    Cyb_InlineSubVec2(c, a, b);
 }
 
 
 void Cyb_MulVec2(Cyb_Vec2 *c, const Cyb_Vec2 *a, const Cyb_Vec2 *b)
 {
-    c->x = a->x * b->x;
-    c->y = a->y * b->y;
+    Cyb_InlineMulVec2(c, a, b);
 }
 
 
 void Cyb_DivVec2(Cyb_Vec2 *c, const Cyb_Vec2 *a, const Cyb_Vec2 *b)
 {
-    c->x = a->x / b->x;
-    c->y = a->y / b->y;
+    Cyb_InlineDivVec2(c, a, b);
 }
 
 
 void Cyb_AddVec3(Cyb_Vec3 *c, const Cyb_Vec3 *a, const Cyb_Vec3 *b)
 {
-    c->x = a->x + b->x;
-    c->y = a->y + b->y;
-    c->z = a->z + b->z;
+    Cyb_InlineAddVec3(c, a, b);
 }
 
 
 void Cyb_SubVec3(Cyb_Vec3 *c, const Cyb_Vec3 *a, const Cyb_Vec3 *b)
 {
-    c->x = a->x - b->x;
-    c->y = a->y - b->y;
-    c->z = a->z - b->z;
+    Cyb_InlineSubVec3(c, a, b);
 }
 
 
 void Cyb_MulVec3(Cyb_Vec3 *c, const Cyb_Vec3 *a, const Cyb_Vec3 *b)
 {
-    c->x = a->x * b->x;
-    c->y = a->y * b->y;
-    c->z = a->z * b->z;
+    Cyb_InlineMulVec3(c, a, b);
 }
 
 
 void Cyb_DivVec3(Cyb_Vec3 *c, const Cyb_Vec3 *a, const Cyb_Vec3 *b)
 {
-    c->x = a->x / b->x;
-    c->y = a->y / b->y;
-    c->z = a->z / b->z;
+    Cyb_InlineDivVec3(c, a, b);
 }
 
 
 void Cyb_Lerp(Cyb_Vec3 *c, const Cyb_Vec3 *a, const Cyb_Vec3 *b,
     double progress)
 {
-    //Calculate increment
-    Cyb_Vec3 inc;
-    Cyb_SubVec3(&inc, b, a);
-    inc.x *= progress;
-    inc.y *= progress;
-    inc.z *= progress;
-    
-    //Calculate current position
-    Cyb_AddVec3(c, a, &inc);
+    Cyb_InlineLerp(c, a, b, progress);
 }
 
 
 void Cyb_AddVec4(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b)
 {
-    c->x = a->x + b->x;
-    c->y = a->y + b->y;
-    c->z = a->z + b->z;
-    c->w = a->w + b->w;
+    Cyb_InlineAddVec4(c, a, b);
 }
 
 
 void Cyb_SubVec4(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b)
 {
-    c->x = a->x - b->x;
-    c->y = a->y - b->y;
-    c->z = a->z - b->z;
-    c->w = a->w - b->w;
+    Cyb_InlineSubVec4(c, a, b);
 }
 
 
 void Cyb_MulVec4(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b)
 {
-    c->x = a->x * b->x;
-    c->y = a->y * b->y;
-    c->z = a->z * b->z;
-    c->w = a->w * b->w;
+    Cyb_InlineMulVec4(c, a, b);
 }
 
 
 void Cyb_DivVec4(Cyb_Vec4 *c, const Cyb_Vec4 *a, const Cyb_Vec4 *b)
 {
-    c->x = a->x / b->x;
-    c->y = a->y / b->y;
-    c->z = a->z / b->z;
-    c->w = a->w / b->w;
+    Cyb_InlineDivVec4(c, a, b);
 }
\ No newline at end of file
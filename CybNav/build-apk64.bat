@@ -0,0 +1,14 @@
+@echo off
+
+rem Build CybObjects
+cd ../CybObjects
+call build-apk64
+
+rem Build CybMath
+cd ../CybMath
+call build-apk64
+
+rem Build CybNav
+cd ../CybNav
+set NDK_PROJECT_PATH=.
+ndk-build NDK_APPLICATION_MK=./Application64.mk
\ No newline at end of file
@@ -0,0 +1,14 @@
+#!/usr/bin/bash
+
+#Build CybObjects
+cd ../CybObjects
+source ./build-apk64.sh
+
+#Build CybMath
+cd ../CybMath
+source ./build-apk64.sh
+
+#Build CybNav
+cd ../CybNav
+export NDK_PROJECT_PATH=.
+ndk-build NDK_APPLICATION_MK=./Application64.mk
@@ -0,0 +1,11 @@
+#ifndef CYBNAV_H
+#define CYBNAV_H
+
+/** @file
+ * @brief CybNav - Main API
+ */
+
+#include "CybNavMesh.h"
+#include "CybPathfinder.h"
+
+#endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef CYBNAVMESH_H
+#define CYBNAVMESH_H
+
+/** @file
+ * @brief CybNav - Navigation Mesh API
+ */
+
+#include <sqlite3.h>
+
+#include "CybCommon.h"
+#include "CybMath.h"
+#include "CybObjects.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybNav
+ * @brief Cybermals Engine - Navigation Library
+ * @{
+ */
+
+//Structures
+//=================================================================================
+/** @brief Navigation mesh structure and type.
+ *
+ * The walkable surface is stored as triangles which are counter-clockwise
+ * when seen from above. Neighbor i of a triangle shares its edge from vertex
+ * i to vertex i + 1.
+ */
+typedef struct
+{
+    Cyb_Object base;   /**< Base object. (read-only) */
+    int vertCount;     /**< Number of vertices. (read-only) */
+    Cyb_Vec3 *verts;   /**< Vertex positions. (read-only) */
+    int triCount;      /**< Number of triangles. (read-only) */
+    int *tris;         /**< Vertex indices (3 per triangle). (read-only) */
+    int *neighbors;    /**< Neighboring triangles (3 per triangle). -1 marks an edge without a neighbor. (read-only) */
+    Cyb_Vec3 *centers; /**< Triangle centers. (read-only) */
+    Cyb_BVH *bvh;      /**< Hierarchy of the triangle bounds. (read-only) */
+} Cyb_NavMesh;
+
+
+//Functions
+//=================================================================================
+/** @brief Build a navigation mesh from mesh geometry.
+ *
+ * Takes the same vertex positions and indices as Cyb_UpdateMesh. Vertices at
+ * the same position are welded so that triangles connect across split
+ * normals and uvs. Triangles which face down or are steeper than the maximum
+ * slope are dropped.
+ *
+ * @param vertCount The number of vertices.
+ * @param verts The vertex positions.
+ * @param indexCount The number of indices (3 per triangle).
+ * @param indices The element indices.
+ * @param maxSlope The steepest walkable slope in radians.
+ *
+ * @return Pointer to the navigation mesh or NULL.
+ */
+CYBAPI Cyb_NavMesh *Cyb_CreateNavMesh(int vertCount, const Cyb_Vec3 *verts,
+    int indexCount, const unsigned int *indices, float maxSlope);
+
+/** @brief Load a navigation mesh from an asset database.
+ *
+ * @param filename The path to the asset database.
+ * @param name The name of the navigation mesh.
+ *
+ * @return Pointer to the navigation mesh or NULL.
+ */
+CYBAPI Cyb_NavMesh *Cyb_LoadNavMesh(const char *filename, const char *name);
+
+/** @brief Load a navigation mesh from an open asset database.
+ *
+ * @param db Pointer to the open asset database.
+ * @param name The name of the navigation mesh.
+ *
+ * @return Pointer to the navigation mesh or NULL.
+ */
+CYBAPI Cyb_NavMesh *Cyb_LoadNavMesh_DB(sqlite3 *db, const char *name);
+
+/** @brief Save a navigation mesh to an asset database.
+ *
+ * The database is created if it does not exist yet. A navigation mesh with
+ * the same name is replaced.
+ *
+ * @param nav Pointer to the navigation mesh.
+ * @param filename The path to the asset database.
+ * @param name The name of the navigation mesh.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_SaveNavMesh(const Cyb_NavMesh *nav, const char *filename,
+    const char *name);
+
+/** @brief Save a navigation mesh to an open asset database.
+ *
+ * @param nav Pointer to the navigation mesh.
+ * @param db Pointer to the open asset database.
+ * @param name The name of the navigation mesh.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_SaveNavMesh_DB(const Cyb_NavMesh *nav, sqlite3 *db,
+    const char *name);
+
+/** @brief Find the point on a triangle of a navigation mesh closest to a point.
+ *
+ * @param nav Pointer to the navigation mesh.
+ * @param tri The index of the triangle.
+ * @param point Pointer to the point.
+ * @param closest Pointer to the resulting closest point.
+ */
+CYBAPI void Cyb_ClosestPointOnNavTriangle(const Cyb_NavMesh *nav, int tri,
+    const Cyb_Vec3 *point, Cyb_Vec3 *closest);
+
+/** @brief Find the triangle of a navigation mesh closest to a point.
+ *
+ * @param nav Pointer to the navigation mesh.
+ * @param point Pointer to the point.
+ * @param maxDist Triangles further away than this are ignored.
+ * @param closest Pointer to the resulting closest point on the triangle. May
+ * be NULL.
+ *
+ * @return The index of the triangle or -1 if none is close enough.
+ */
+CYBAPI int Cyb_FindNavTriangle(const Cyb_NavMesh *nav, const Cyb_Vec3 *point,
+    float maxDist, Cyb_Vec3 *closest);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
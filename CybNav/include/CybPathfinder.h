@@ -0,0 +1,131 @@
+#ifndef CYBPATHFINDER_H
+#define CYBPATHFINDER_H
+
+/** @file
+ * @brief CybNav - Pathfinder API
+ */
+
+#include "CybCommon.h"
+#include "CybMath.h"
+#include "CybObjects.h"
+#include "CybNavMesh.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybNav
+ * @brief Cybermals Engine - Navigation Library
+ * @{
+ */
+
+//Enums
+//=================================================================================
+/** @brief Path query status.
+ */
+enum Cyb_PathStatus
+{
+    CYB_PATH_PENDING, /**< The query has not been run yet. */
+    CYB_PATH_FOUND,   /**< The path reaches the end point. */
+    CYB_PATH_PARTIAL, /**< The end point is unreachable. The path leads as close
+                           to it as possible. */
+    CYB_PATH_FAILED   /**< The start or end point is not on the navigation
+                           mesh. */
+};
+
+
+//Types
+//=================================================================================
+/** @brief Path query queue object.
+ */
+typedef struct Cyb_PathQueue Cyb_PathQueue;
+
+
+//Structures
+//=================================================================================
+/** @brief Path query.
+ */
+typedef struct
+{
+    Cyb_Vec3 start;   /**< The start point. */
+    Cyb_Vec3 end;     /**< The end point. */
+    Cyb_Vec3 *points; /**< Array which receives the corners of the path,
+                           including the start and end points. */
+    int maxPoints;    /**< The size of the points array. Longer paths are cut
+                           short. */
+    int pointCount;   /**< The number of points in the path. (read-only) */
+    int status;       /**< The query status. (read-only) */
+} Cyb_PathQuery;
+
+
+//Functions
+//=================================================================================
+/** @brief Find a path across a navigation mesh.
+ *
+ * Runs A* over the triangles of the navigation mesh and then pulls the
+ * resulting corridor tight with the funnel algorithm. The start and end
+ * points are moved onto the closest triangles.
+ *
+ * @param nav Pointer to the navigation mesh.
+ * @param query Pointer to the path query.
+ *
+ * @return The status of the query.
+ */
+CYBAPI int Cyb_FindPath(const Cyb_NavMesh *nav, Cyb_PathQuery *query);
+
+/** @brief Create a new path query queue.
+ *
+ * The queue keeps a reference to the navigation mesh and a search buffer for
+ * each thread of the job system.
+ *
+ * @param nav Pointer to the navigation mesh.
+ * @param jobs Pointer to a job system which is used to run queries in
+ * parallel. Can be NULL.
+ *
+ * @return Pointer to the queue or NULL.
+ */
+CYBAPI Cyb_PathQueue *Cyb_CreatePathQueue(Cyb_NavMesh *nav,
+    Cyb_JobSystem *jobs);
+
+/** @brief Add a path query to a queue.
+ *
+ * The query must stay valid until its status is no longer CYB_PATH_PENDING.
+ *
+ * @param queue Pointer to the queue.
+ * @param query Pointer to the path query.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_SubmitPathQuery(Cyb_PathQueue *queue, Cyb_PathQuery *query);
+
+/** @brief Run queued path queries until they are done or the time is up.
+ *
+ * Queries are run in the order they were submitted. Each query runs to
+ * completion, so the budget can be exceeded by about one query per thread.
+ * Queries that did not get to run stay queued for the next update.
+ *
+ * @param queue Pointer to the queue.
+ * @param budget The time budget in milliseconds. 0 runs every query.
+ *
+ * @return The number of queries that were run.
+ */
+CYBAPI int Cyb_UpdatePathQueue(Cyb_PathQueue *queue, float budget);
+
+/** @brief Get the number of queries waiting in a queue.
+ *
+ * @param queue Pointer to the queue.
+ *
+ * @return The number of pending queries.
+ */
+CYBAPI int Cyb_GetPendingPathCount(const Cyb_PathQueue *queue);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
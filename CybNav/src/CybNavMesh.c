@@ -0,0 +1,705 @@
+/*
+CybNav - Navigation Mesh API
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CybNavMesh.h"
+
+
+//Macros
+//=================================================================================
+#define CYB_NAV_WELD_DIST 0.001f   //vertices closer than this are merged
+#define CYB_NAV_MAX_CANDIDATES 256 //triangles tested when locating a point
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    int v0;
+    int v1;
+    int tri;
+    int edge;
+} Cyb_NavEdge;
+
+
+//Constants
+//=================================================================================
+const char *createNavMeshTableSQL = "CREATE TABLE IF NOT EXISTS navmeshes(id INTEGER PRIMARY KEY, name varchar(256) UNIQUE, vert_count INT, vertices BLOB, tri_count INT, triangles BLOB, neighbors BLOB);";
+const char *loadNavMeshSQL = "SELECT vert_count, vertices, tri_count, triangles, neighbors FROM navmeshes WHERE name = ?;";
+const char *saveNavMeshSQL = "INSERT OR REPLACE INTO navmeshes(name, vert_count, vertices, tri_count, triangles, neighbors) VALUES (?, ?, ?, ?, ?, ?);";
+
+
+//Functions
+//=================================================================================
+static Cyb_Vec3 Cyb_V3(float x, float y, float z)
+{
+    Cyb_Vec3 v = {x, y, z};
+    return v;
+}
+
+
+static Cyb_Vec3 Cyb_V3Sub(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return Cyb_V3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+
+static Cyb_Vec3 Cyb_V3MulAdd(Cyb_Vec3 a, Cyb_Vec3 b, float s)
+{
+    return Cyb_V3(a.x + b.x * s, a.y + b.y * s, a.z + b.z * s);
+}
+
+
+static float Cyb_V3Dot(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+
+static Cyb_Vec3 Cyb_V3Cross(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return Cyb_V3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+        a.x * b.y - a.y * b.x);
+}
+
+
+static int Cyb_CompareNavEdges(const void *a, const void *b)
+{
+    const Cyb_NavEdge *ea = (const Cyb_NavEdge*)a;
+    const Cyb_NavEdge *eb = (const Cyb_NavEdge*)b;
+    
+    if(ea->v0 != eb->v0)
+    {
+        return ea->v0 < eb->v0 ? -1 : 1;
+    }
+    
+    if(ea->v1 != eb->v1)
+    {
+        return ea->v1 < eb->v1 ? -1 : 1;
+    }
+    
+    return ea->tri - eb->tri;
+}
+
+
+void Cyb_FreeNavMesh(Cyb_NavMesh *nav)
+{
+    //Free the mesh data
+    SDL_free(nav->verts);
+    SDL_free(nav->tris);
+    SDL_free(nav->neighbors);
+    SDL_free(nav->centers);
+    
+    if(nav->bvh)
+    {
+        Cyb_FreeBVH(nav->bvh);
+    }
+}
+
+
+static Cyb_NavMesh *Cyb_AllocNavMesh(int vertCount, int triCount)
+{
+    //Allocate new navigation mesh
+    Cyb_NavMesh *nav = (Cyb_NavMesh*)Cyb_CreateObject(sizeof(Cyb_NavMesh),
+        (Cyb_FreeProc)&Cyb_FreeNavMesh, CYB_NAVMESH);
+    
+    if(!nav)
+    {
+        return NULL;
+    }
+    
+    //Allocate the mesh data
+    memset((char*)nav + sizeof(Cyb_Object), 0,
+        sizeof(Cyb_NavMesh) - sizeof(Cyb_Object));
+    nav->vertCount = vertCount;
+    nav->triCount = triCount;
+    nav->verts = (Cyb_Vec3*)SDL_malloc(sizeof(Cyb_Vec3) * max(vertCount, 1));
+    nav->tris = (int*)SDL_malloc(sizeof(int) * 3 * max(triCount, 1));
+    nav->neighbors = (int*)SDL_malloc(sizeof(int) * 3 * max(triCount, 1));
+    nav->centers = (Cyb_Vec3*)SDL_malloc(sizeof(Cyb_Vec3) * max(triCount, 1));
+    
+    if(!nav->verts || !nav->tris || !nav->neighbors || !nav->centers)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Out of Memory");
+        Cyb_FreeObject((Cyb_Object**)&nav);
+        return NULL;
+    }
+    
+    return nav;
+}
+
+
+static int Cyb_FinishNavMesh(Cyb_NavMesh *nav)
+{
+    //Calculate the center and bounds of each triangle
+    Cyb_Box *boxes = (Cyb_Box*)SDL_malloc(sizeof(Cyb_Box) *
+        max(nav->triCount, 1));
+    
+    if(!boxes)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    for(int i = 0; i < nav->triCount; i++)
+    {
+        const Cyb_Vec3 *a = &nav->verts[nav->tris[i * 3]];
+        const Cyb_Vec3 *b = &nav->verts[nav->tris[i * 3 + 1]];
+        const Cyb_Vec3 *c = &nav->verts[nav->tris[i * 3 + 2]];
+        Cyb_Vec3 lo = Cyb_V3(min(min(a->x, b->x), c->x),
+            min(min(a->y, b->y), c->y), min(min(a->z, b->z), c->z));
+        Cyb_Vec3 hi = Cyb_V3(max(max(a->x, b->x), c->x),
+            max(max(a->y, b->y), c->y), max(max(a->z, b->z), c->z));
+        nav->centers[i] = Cyb_V3((a->x + b->x + c->x) / 3.0f,
+            (a->y + b->y + c->y) / 3.0f, (a->z + b->z + c->z) / 3.0f);
+        boxes[i].center = Cyb_V3((lo.x + hi.x) * 0.5f, (lo.y + hi.y) * 0.5f,
+            (lo.z + hi.z) * 0.5f);
+        boxes[i].size = Cyb_V3Sub(hi, lo);
+    }
+    
+    //Build a hierarchy for locating points
+    nav->bvh = Cyb_CreateBVH(boxes, nav->triCount);
+    SDL_free(boxes);
+    
+    if(!nav->bvh)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_WeldVerts(int vertCount, const Cyb_Vec3 *verts, int *remap,
+    Cyb_Vec3 *welded)
+{
+    //Hash the quantized position of each vertex
+    int capacity = 16;
+    
+    while(capacity < vertCount * 2)
+    {
+        capacity *= 2;
+    }
+    
+    int *table = (int*)SDL_malloc(sizeof(int) * capacity);
+    int (*keys)[3] = (int(*)[3])SDL_malloc(sizeof(int) * 3 * max(vertCount, 1));
+    
+    if(!table || !keys)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Out of Memory");
+        SDL_free(table);
+        SDL_free(keys);
+        return -1;
+    }
+    
+    memset(table, 0xff, sizeof(int) * capacity);
+    int count = 0;
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        int key[3] = {
+            (int)floorf(verts[i].x / CYB_NAV_WELD_DIST + 0.5f),
+            (int)floorf(verts[i].y / CYB_NAV_WELD_DIST + 0.5f),
+            (int)floorf(verts[i].z / CYB_NAV_WELD_DIST + 0.5f)
+        };
+        unsigned int slot = ((unsigned int)key[0] * 73856093u ^
+            (unsigned int)key[1] * 19349663u ^
+            (unsigned int)key[2] * 83492791u) & (capacity - 1);
+        
+        //Find an earlier vertex with the same key or an empty slot
+        while(table[slot] >= 0 && memcmp(keys[table[slot]], key, sizeof(key)))
+        {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        
+        if(table[slot] < 0)
+        {
+            table[slot] = count;
+            memcpy(keys[count], key, sizeof(key));
+            welded[count++] = verts[i];
+        }
+        
+        remap[i] = table[slot];
+    }
+    
+    SDL_free(table);
+    SDL_free(keys);
+    return count;
+}
+
+
+static int Cyb_LinkNavTriangles(Cyb_NavMesh *nav)
+{
+    //Sort the edges so that shared edges end up next to each other
+    Cyb_NavEdge *edges = (Cyb_NavEdge*)SDL_malloc(sizeof(Cyb_NavEdge) * 3 *
+        max(nav->triCount, 1));
+    
+    if(!edges)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    int edgeCount = nav->triCount * 3;
+    
+    for(int i = 0; i < edgeCount; i++)
+    {
+        int a = nav->tris[i];
+        int b = nav->tris[i - i % 3 + (i + 1) % 3];
+        edges[i].v0 = min(a, b);
+        edges[i].v1 = max(a, b);
+        edges[i].tri = i / 3;
+        edges[i].edge = i % 3;
+        nav->neighbors[i] = -1;
+    }
+    
+    qsort(edges, edgeCount, sizeof(Cyb_NavEdge), &Cyb_CompareNavEdges);
+    
+    //Connect the first 2 triangles sharing each edge
+    for(int i = 0; i + 1 < edgeCount; i++)
+    {
+        Cyb_NavEdge *a = &edges[i];
+        Cyb_NavEdge *b = &edges[i + 1];
+        
+        if(a->v0 == b->v0 && a->v1 == b->v1)
+        {
+            nav->neighbors[a->tri * 3 + a->edge] = b->tri;
+            nav->neighbors[b->tri * 3 + b->edge] = a->tri;
+            
+            //Skip any further triangles on the same edge
+            while(i + 1 < edgeCount && edges[i + 1].v0 == a->v0 &&
+                edges[i + 1].v1 == a->v1)
+            {
+                i++;
+            }
+        }
+    }
+    
+    SDL_free(edges);
+    return CYB_NO_ERROR;
+}
+
+
+Cyb_NavMesh *Cyb_CreateNavMesh(int vertCount, const Cyb_Vec3 *verts,
+    int indexCount, const unsigned int *indices, float maxSlope)
+{
+    //Weld the vertices
+    int triCount = indexCount / 3;
+    int *remap = (int*)SDL_malloc(sizeof(int) * max(vertCount, 1));
+    int *tris = (int*)SDL_malloc(sizeof(int) * 3 * max(triCount, 1));
+    Cyb_Vec3 *welded = (Cyb_Vec3*)SDL_malloc(sizeof(Cyb_Vec3) *
+        max(vertCount, 1));
+    
+    if(!remap || !tris || !welded)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Out of Memory");
+        SDL_free(remap);
+        SDL_free(tris);
+        SDL_free(welded);
+        return NULL;
+    }
+    
+    int weldedCount = Cyb_WeldVerts(vertCount, verts, remap, welded);
+    
+    if(weldedCount < 0)
+    {
+        SDL_free(remap);
+        SDL_free(tris);
+        SDL_free(welded);
+        return NULL;
+    }
+    
+    //Keep the walkable triangles
+    float minNormalY = cosf(maxSlope);
+    int walkableCount = 0;
+    
+    for(int i = 0; i < triCount; i++)
+    {
+        if(indices[i * 3] >= (unsigned int)vertCount ||
+            indices[i * 3 + 1] >= (unsigned int)vertCount ||
+            indices[i * 3 + 2] >= (unsigned int)vertCount)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybNav] Vertex index out of range.");
+            SDL_free(remap);
+            SDL_free(tris);
+            SDL_free(welded);
+            return NULL;
+        }
+        
+        int a = remap[indices[i * 3]];
+        int b = remap[indices[i * 3 + 1]];
+        int c = remap[indices[i * 3 + 2]];
+        
+        if(a == b || b == c || c == a)
+        {
+            continue;
+        }
+        
+        //Skip triangles which are degenerate, face down, or are too steep
+        Cyb_Vec3 n = Cyb_V3Cross(Cyb_V3Sub(welded[b], welded[a]),
+            Cyb_V3Sub(welded[c], welded[a]));
+        float len = sqrtf(Cyb_V3Dot(n, n));
+        
+        if(len < 1e-12f || n.y < minNormalY * len)
+        {
+            continue;
+        }
+        
+        tris[walkableCount * 3] = a;
+        tris[walkableCount * 3 + 1] = b;
+        tris[walkableCount * 3 + 2] = c;
+        walkableCount++;
+    }
+    
+    //Drop the vertices which are not used by a walkable triangle
+    memset(remap, 0xff, sizeof(int) * max(vertCount, 1));
+    int usedCount = 0;
+    
+    for(int i = 0; i < walkableCount * 3; i++)
+    {
+        if(remap[tris[i]] < 0)
+        {
+            remap[tris[i]] = usedCount++;
+        }
+    }
+    
+    Cyb_NavMesh *nav = Cyb_AllocNavMesh(usedCount, walkableCount);
+    
+    if(!nav)
+    {
+        SDL_free(remap);
+        SDL_free(tris);
+        SDL_free(welded);
+        return NULL;
+    }
+    
+    for(int i = 0; i < weldedCount; i++)
+    {
+        if(remap[i] >= 0)
+        {
+            nav->verts[remap[i]] = welded[i];
+        }
+    }
+    
+    for(int i = 0; i < walkableCount * 3; i++)
+    {
+        nav->tris[i] = remap[tris[i]];
+    }
+    
+    SDL_free(remap);
+    SDL_free(tris);
+    SDL_free(welded);
+    
+    //Connect neighboring triangles
+    if(Cyb_LinkNavTriangles(nav) || Cyb_FinishNavMesh(nav))
+    {
+        Cyb_FreeObject((Cyb_Object**)&nav);
+        return NULL;
+    }
+    
+    return nav;
+}
+
+
+Cyb_NavMesh *Cyb_LoadNavMesh(const char *filename, const char *name)
+{
+    //Open SQL database
+    sqlite3 *db;
+    
+    if(sqlite3_open_v2(filename, &db, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "[CybNav] Failed to open asset database '%s'.", filename);
+        sqlite3_close_v2(db);
+        return NULL;
+    }
+    
+    //Load the navigation mesh
+    Cyb_NavMesh *nav = Cyb_LoadNavMesh_DB(db, name);
+    
+    //Close SQL database
+    sqlite3_close_v2(db);
+    return nav;
+}
+
+
+Cyb_NavMesh *Cyb_LoadNavMesh_DB(sqlite3 *db, const char *name)
+{
+    //Compile SQL statements
+    sqlite3_stmt *loadNavMeshStmt = NULL;
+    
+    if(sqlite3_prepare_v2(db, loadNavMeshSQL, -1, &loadNavMeshStmt, NULL) !=
+        SQLITE_OK)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Failed to compile an SQL statement.");
+        return NULL;
+    }
+    
+    //Load the navigation mesh
+    sqlite3_bind_text(loadNavMeshStmt, 1, name, -1, NULL);
+    
+    if(sqlite3_step(loadNavMeshStmt) != SQLITE_ROW)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "[CybNav] Failed to locate navigation mesh '%s' in the asset database.",
+            name);
+        sqlite3_finalize(loadNavMeshStmt);
+        return NULL;
+    }
+    
+    int vertCount = sqlite3_column_int(loadNavMeshStmt, 0);
+    int triCount = sqlite3_column_int(loadNavMeshStmt, 2);
+    
+    //Make sure the blobs match the counts
+    if(vertCount < 0 || triCount < 0 ||
+        sqlite3_column_bytes(loadNavMeshStmt, 1) !=
+        (int)sizeof(Cyb_Vec3) * vertCount ||
+        sqlite3_column_bytes(loadNavMeshStmt, 3) !=
+        (int)sizeof(int) * 3 * triCount ||
+        sqlite3_column_bytes(loadNavMeshStmt, 4) !=
+        (int)sizeof(int) * 3 * triCount)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "[CybNav] Navigation mesh '%s' is corrupt.", name);
+        sqlite3_finalize(loadNavMeshStmt);
+        return NULL;
+    }
+    
+    Cyb_NavMesh *nav = Cyb_AllocNavMesh(vertCount, triCount);
+    
+    if(!nav)
+    {
+        sqlite3_finalize(loadNavMeshStmt);
+        return NULL;
+    }
+    
+    if(vertCount)
+    {
+        memcpy(nav->verts, sqlite3_column_blob(loadNavMeshStmt, 1),
+            sizeof(Cyb_Vec3) * vertCount);
+    }
+    
+    if(triCount)
+    {
+        memcpy(nav->tris, sqlite3_column_blob(loadNavMeshStmt, 3),
+            sizeof(int) * 3 * triCount);
+        memcpy(nav->neighbors, sqlite3_column_blob(loadNavMeshStmt, 4),
+            sizeof(int) * 3 * triCount);
+    }
+    
+    //Finalize SQL statements
+    sqlite3_finalize(loadNavMeshStmt);
+    
+    //Validate the indices
+    for(int i = 0; i < triCount * 3; i++)
+    {
+        if(nav->tris[i] < 0 || nav->tris[i] >= vertCount ||
+            nav->neighbors[i] < -1 || nav->neighbors[i] >= triCount)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                "[CybNav] Navigation mesh '%s' is corrupt.", name);
+            Cyb_FreeObject((Cyb_Object**)&nav);
+            return NULL;
+        }
+    }
+    
+    if(Cyb_FinishNavMesh(nav))
+    {
+        Cyb_FreeObject((Cyb_Object**)&nav);
+        return NULL;
+    }
+    
+    return nav;
+}
+
+
+int Cyb_SaveNavMesh(const Cyb_NavMesh *nav, const char *filename,
+    const char *name)
+{
+    //Open SQL database
+    sqlite3 *db;
+    
+    if(sqlite3_open_v2(filename, &db,
+        SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL) != SQLITE_OK)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "[CybNav] Failed to open asset database '%s'.", filename);
+        sqlite3_close_v2(db);
+        return CYB_ERROR;
+    }
+    
+    //Save the navigation mesh
+    int result = Cyb_SaveNavMesh_DB(nav, db, name);
+    
+    //Close SQL database
+    sqlite3_close_v2(db);
+    return result;
+}
+
+
+int Cyb_SaveNavMesh_DB(const Cyb_NavMesh *nav, sqlite3 *db, const char *name)
+{
+    //Create the navigation mesh table
+    if(sqlite3_exec(db, createNavMeshTableSQL, NULL, NULL, NULL) != SQLITE_OK)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "[CybNav] Failed to create the navigation mesh table: %s",
+            sqlite3_errmsg(db));
+        return CYB_ERROR;
+    }
+    
+    //Compile SQL statements
+    sqlite3_stmt *saveNavMeshStmt = NULL;
+    
+    if(sqlite3_prepare_v2(db, saveNavMeshSQL, -1, &saveNavMeshStmt, NULL) !=
+        SQLITE_OK)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Failed to compile an SQL statement.");
+        return CYB_ERROR;
+    }
+    
+    //Save the navigation mesh
+    sqlite3_bind_text(saveNavMeshStmt, 1, name, -1, NULL);
+    sqlite3_bind_int(saveNavMeshStmt, 2, nav->vertCount);
+    sqlite3_bind_blob(saveNavMeshStmt, 3, nav->verts,
+        sizeof(Cyb_Vec3) * nav->vertCount, NULL);
+    sqlite3_bind_int(saveNavMeshStmt, 4, nav->triCount);
+    sqlite3_bind_blob(saveNavMeshStmt, 5, nav->tris,
+        sizeof(int) * 3 * nav->triCount, NULL);
+    sqlite3_bind_blob(saveNavMeshStmt, 6, nav->neighbors,
+        sizeof(int) * 3 * nav->triCount, NULL);
+    
+    if(sqlite3_step(saveNavMeshStmt) != SQLITE_DONE)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "[CybNav] Failed to save navigation mesh '%s': %s", name,
+            sqlite3_errmsg(db));
+        sqlite3_finalize(saveNavMeshStmt);
+        return CYB_ERROR;
+    }
+    
+    //Finalize SQL statements
+    sqlite3_finalize(saveNavMeshStmt);
+    return CYB_NO_ERROR;
+}
+
+
+void Cyb_ClosestPointOnNavTriangle(const Cyb_NavMesh *nav, int tri,
+    const Cyb_Vec3 *point, Cyb_Vec3 *closest)
+{
+    //Find the Voronoi region of the triangle that contains the point
+    Cyb_Vec3 a = nav->verts[nav->tris[tri * 3]];
+    Cyb_Vec3 b = nav->verts[nav->tris[tri * 3 + 1]];
+    Cyb_Vec3 c = nav->verts[nav->tris[tri * 3 + 2]];
+    Cyb_Vec3 ab = Cyb_V3Sub(b, a);
+    Cyb_Vec3 ac = Cyb_V3Sub(c, a);
+    Cyb_Vec3 ap = Cyb_V3Sub(*point, a);
+    float d1 = Cyb_V3Dot(ab, ap);
+    float d2 = Cyb_V3Dot(ac, ap);
+    
+    if(d1 <= 0.0f && d2 <= 0.0f)
+    {
+        *closest = a;
+        return;
+    }
+    
+    Cyb_Vec3 bp = Cyb_V3Sub(*point, b);
+    float d3 = Cyb_V3Dot(ab, bp);
+    float d4 = Cyb_V3Dot(ac, bp);
+    
+    if(d3 >= 0.0f && d4 <= d3)
+    {
+        *closest = b;
+        return;
+    }
+    
+    float vc = d1 * d4 - d3 * d2;
+    
+    if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+    {
+        *closest = Cyb_V3MulAdd(a, ab, d1 / (d1 - d3));
+        return;
+    }
+    
+    Cyb_Vec3 cp = Cyb_V3Sub(*point, c);
+    float d5 = Cyb_V3Dot(ab, cp);
+    float d6 = Cyb_V3Dot(ac, cp);
+    
+    if(d6 >= 0.0f && d5 <= d6)
+    {
+        *closest = c;
+        return;
+    }
+    
+    float vb = d5 * d2 - d1 * d6;
+    
+    if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+    {
+        *closest = Cyb_V3MulAdd(a, ac, d2 / (d2 - d6));
+        return;
+    }
+    
+    float va = d3 * d6 - d5 * d4;
+    
+    if(va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+    {
+        *closest = Cyb_V3MulAdd(b, Cyb_V3Sub(c, b),
+            (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        return;
+    }
+    
+    float denom = 1.0f / (va + vb + vc);
+    *closest = Cyb_V3MulAdd(Cyb_V3MulAdd(a, ab, vb * denom), ac, vc * denom);
+}
+
+
+int Cyb_FindNavTriangle(const Cyb_NavMesh *nav, const Cyb_Vec3 *point,
+    float maxDist, Cyb_Vec3 *closest)
+{
+    //Find the triangles near the point
+    Cyb_Box box;
+    box.center = *point;
+    box.size = Cyb_V3(maxDist * 2.0f, maxDist * 2.0f, maxDist * 2.0f);
+    int hits[CYB_NAV_MAX_CANDIDATES];
+    int hitCount = min(Cyb_QueryBVH(nav->bvh, &box, hits,
+        CYB_NAV_MAX_CANDIDATES), CYB_NAV_MAX_CANDIDATES);
+    
+    //Pick the closest one
+    int best = -1;
+    float bestDist = maxDist * maxDist;
+    
+    for(int i = 0; i < hitCount; i++)
+    {
+        Cyb_Vec3 p;
+        Cyb_ClosestPointOnNavTriangle(nav, hits[i], point, &p);
+        Cyb_Vec3 d = Cyb_V3Sub(p, *point);
+        float dist = Cyb_V3Dot(d, d);
+        
+        if(dist < bestDist || (dist == bestDist && hits[i] < best))
+        {
+            best = hits[i];
+            bestDist = dist;
+            
+            if(closest)
+            {
+                *closest = p;
+            }
+        }
+    }
+    
+    return best;
+}
\ No newline at end of file
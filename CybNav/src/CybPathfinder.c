@@ -0,0 +1,617 @@
+/*
+CybNav - Pathfinder API
+*/
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "CybPathfinder.h"
+
+
+//Macros
+//=================================================================================
+#define CYB_NAV_SEARCH_DIST 2.0f //how far the end points may be off the mesh
+#define CYB_NAV_HEURISTIC 1.2f   //weight of the distance estimate
+                                 //(the funnel straightens the corridor anyway)
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    int capacity;
+    unsigned int stamp;
+    unsigned int *stamps;
+    float *costs;
+    float *totals;
+    int *parents;
+    int *heapIndices;
+    Cyb_Vec3 *nodePos;
+    int *heap;
+    int heapCount;
+    int *corridor;
+    Cyb_Vec3 *lefts;
+    Cyb_Vec3 *rights;
+} Cyb_PathScratch;
+
+
+struct Cyb_PathQueue
+{
+    Cyb_Object base;
+    Cyb_NavMesh *nav;
+    Cyb_JobSystem *jobs;
+    int scratchCount;
+    Cyb_PathScratch *scratches;
+    int count;
+    int capacity;
+    Cyb_PathQuery **queries;
+    SDL_atomic_t next;
+    Uint64 deadline;
+};
+
+
+//Functions
+//=================================================================================
+static float Cyb_Dist(const Cyb_Vec3 *a, const Cyb_Vec3 *b)
+{
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+    float dz = b->z - a->z;
+    return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+
+static float Cyb_TriArea2D(const Cyb_Vec3 *a, const Cyb_Vec3 *b,
+    const Cyb_Vec3 *c)
+{
+    //Twice the signed area of a triangle projected onto the XZ plane
+    return (c->x - a->x) * (b->z - a->z) - (b->x - a->x) * (c->z - a->z);
+}
+
+
+static int Cyb_SamePoint(const Cyb_Vec3 *a, const Cyb_Vec3 *b)
+{
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+    float dz = b->z - a->z;
+    return dx * dx + dy * dy + dz * dz < 1e-8f;
+}
+
+
+static void Cyb_FiniPathScratch(Cyb_PathScratch *scratch)
+{
+    SDL_free(scratch->stamps);
+    SDL_free(scratch->costs);
+    SDL_free(scratch->totals);
+    SDL_free(scratch->parents);
+    SDL_free(scratch->heapIndices);
+    SDL_free(scratch->nodePos);
+    SDL_free(scratch->heap);
+    SDL_free(scratch->corridor);
+    SDL_free(scratch->lefts);
+    SDL_free(scratch->rights);
+}
+
+
+static int Cyb_InitPathScratch(Cyb_PathScratch *scratch, int triCount)
+{
+    //Allocate the search state for every triangle
+    int n = max(triCount, 1);
+    memset(scratch, 0, sizeof(Cyb_PathScratch));
+    scratch->capacity = triCount;
+    scratch->stamps = (unsigned int*)SDL_malloc(sizeof(unsigned int) * n);
+    scratch->costs = (float*)SDL_malloc(sizeof(float) * n);
+    scratch->totals = (float*)SDL_malloc(sizeof(float) * n);
+    scratch->parents = (int*)SDL_malloc(sizeof(int) * n);
+    scratch->heapIndices = (int*)SDL_malloc(sizeof(int) * n);
+    scratch->nodePos = (Cyb_Vec3*)SDL_malloc(sizeof(Cyb_Vec3) * n);
+    scratch->heap = (int*)SDL_malloc(sizeof(int) * n);
+    scratch->corridor = (int*)SDL_malloc(sizeof(int) * n);
+    scratch->lefts = (Cyb_Vec3*)SDL_malloc(sizeof(Cyb_Vec3) * (n + 1));
+    scratch->rights = (Cyb_Vec3*)SDL_malloc(sizeof(Cyb_Vec3) * (n + 1));
+    
+    if(!scratch->stamps || !scratch->costs || !scratch->totals ||
+        !scratch->parents || !scratch->heapIndices || !scratch->nodePos ||
+        !scratch->heap || !scratch->corridor || !scratch->lefts ||
+        !scratch->rights)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Out of Memory");
+        Cyb_FiniPathScratch(scratch);
+        memset(scratch, 0, sizeof(Cyb_PathScratch));
+        return CYB_ERROR;
+    }
+    
+    memset(scratch->stamps, 0, sizeof(unsigned int) * n);
+    return CYB_NO_ERROR;
+}
+
+
+static void Cyb_SiftUp(Cyb_PathScratch *scratch, int i)
+{
+    //Move a heap entry towards the root until its parent is cheaper
+    int tri = scratch->heap[i];
+    float total = scratch->totals[tri];
+    
+    while(i > 0)
+    {
+        int parent = (i - 1) / 2;
+        int parentTri = scratch->heap[parent];
+        
+        if(scratch->totals[parentTri] <= total)
+        {
+            break;
+        }
+        
+        scratch->heap[i] = parentTri;
+        scratch->heapIndices[parentTri] = i;
+        i = parent;
+    }
+    
+    scratch->heap[i] = tri;
+    scratch->heapIndices[tri] = i;
+}
+
+
+static int Cyb_PopHeap(Cyb_PathScratch *scratch)
+{
+    //Remove the cheapest entry and move the last entry down from the root
+    int top = scratch->heap[0];
+    int tri = scratch->heap[--scratch->heapCount];
+    float total = scratch->totals[tri];
+    int i = 0;
+    scratch->heapIndices[top] = -1;
+    
+    if(!scratch->heapCount)
+    {
+        return top;
+    }
+    
+    for(;;)
+    {
+        int child = i * 2 + 1;
+        
+        if(child >= scratch->heapCount)
+        {
+            break;
+        }
+        
+        if(child + 1 < scratch->heapCount &&
+            scratch->totals[scratch->heap[child + 1]] <
+            scratch->totals[scratch->heap[child]])
+        {
+            child++;
+        }
+        
+        if(scratch->totals[scratch->heap[child]] >= total)
+        {
+            break;
+        }
+        
+        scratch->heap[i] = scratch->heap[child];
+        scratch->heapIndices[scratch->heap[i]] = i;
+        i = child;
+    }
+    
+    scratch->heap[i] = tri;
+    scratch->heapIndices[tri] = i;
+    return top;
+}
+
+
+static int Cyb_SearchCorridor(const Cyb_NavMesh *nav,
+    Cyb_PathScratch *scratch, int startTri, const Cyb_Vec3 *start,
+    int endTri, const Cyb_Vec3 *end)
+{
+    //Start a new search without clearing the per triangle state
+    if(++scratch->stamp == 0)
+    {
+        memset(scratch->stamps, 0, sizeof(unsigned int) * scratch->capacity);
+        scratch->stamp = 1;
+    }
+    
+    unsigned int stamp = scratch->stamp;
+    scratch->stamps[startTri] = stamp;
+    scratch->costs[startTri] = 0.0f;
+    scratch->totals[startTri] = Cyb_Dist(start, end) * CYB_NAV_HEURISTIC;
+    scratch->parents[startTri] = -1;
+    scratch->nodePos[startTri] = *start;
+    scratch->heap[0] = startTri;
+    scratch->heapIndices[startTri] = 0;
+    scratch->heapCount = 1;
+    int best = startTri;
+    float bestDist = Cyb_Dist(start, end);
+    
+    //Each triangle is entered at the middle of the edge it was reached through
+    while(scratch->heapCount)
+    {
+        int tri = Cyb_PopHeap(scratch);
+        
+        if(tri == endTri)
+        {
+            best = endTri;
+            break;
+        }
+        
+        for(int i = 0; i < 3; i++)
+        {
+            int next = nav->neighbors[tri * 3 + i];
+            
+            if(next < 0 || (scratch->stamps[next] == stamp &&
+                scratch->heapIndices[next] < 0))
+            {
+                continue;
+            }
+            
+            const Cyb_Vec3 *a = &nav->verts[nav->tris[tri * 3 + i]];
+            const Cyb_Vec3 *b = &nav->verts[nav->tris[tri * 3 + (i + 1) % 3]];
+            Cyb_Vec3 pos;
+            pos.x = (a->x + b->x) * 0.5f;
+            pos.y = (a->y + b->y) * 0.5f;
+            pos.z = (a->z + b->z) * 0.5f;
+            float cost = scratch->costs[tri] +
+                Cyb_Dist(&scratch->nodePos[tri], &pos);
+            
+            if(scratch->stamps[next] != stamp)
+            {
+                scratch->stamps[next] = stamp;
+                scratch->heap[scratch->heapCount] = next;
+                scratch->heapIndices[next] = scratch->heapCount++;
+            }
+            else if(cost >= scratch->costs[next])
+            {
+                continue;
+            }
+            
+            float dist = Cyb_Dist(&pos, end);
+            scratch->costs[next] = cost;
+            scratch->totals[next] = cost + dist * CYB_NAV_HEURISTIC;
+            scratch->parents[next] = tri;
+            scratch->nodePos[next] = pos;
+            Cyb_SiftUp(scratch, scratch->heapIndices[next]);
+            
+            //Remember the triangle closest to the end in case it is unreachable
+            if(dist < bestDist)
+            {
+                best = next;
+                bestDist = dist;
+            }
+        }
+    }
+    
+    return best;
+}
+
+
+static int Cyb_AddPathPoint(Cyb_PathQuery *query, const Cyb_Vec3 *point)
+{
+    //Returns FALSE once the points array is full
+    if(query->pointCount &&
+        Cyb_SamePoint(&query->points[query->pointCount - 1], point))
+    {
+        return TRUE;
+    }
+    
+    if(query->pointCount >= query->maxPoints)
+    {
+        return FALSE;
+    }
+    
+    query->points[query->pointCount++] = *point;
+    return TRUE;
+}
+
+
+static void Cyb_PullPath(Cyb_PathScratch *scratch, int portalCount,
+    Cyb_PathQuery *query)
+{
+    //Simple stupid funnel algorithm
+    const Cyb_Vec3 *lefts = scratch->lefts;
+    const Cyb_Vec3 *rights = scratch->rights;
+    Cyb_Vec3 apex = lefts[0];
+    Cyb_Vec3 left = lefts[0];
+    Cyb_Vec3 right = rights[0];
+    int apexIndex = 0;
+    int leftIndex = 0;
+    int rightIndex = 0;
+    
+    if(!Cyb_AddPathPoint(query, &apex))
+    {
+        return;
+    }
+    
+    for(int i = 1; i < portalCount; i++)
+    {
+        //Narrow the funnel from the right
+        if(Cyb_TriArea2D(&apex, &right, &rights[i]) <= 0.0f)
+        {
+            if(Cyb_SamePoint(&apex, &right) ||
+                Cyb_TriArea2D(&apex, &left, &rights[i]) > 0.0f)
+            {
+                right = rights[i];
+                rightIndex = i;
+            }
+            else
+            {
+                //The right side crossed the left side, so the left is a corner
+                if(!Cyb_AddPathPoint(query, &left))
+                {
+                    return;
+                }
+                
+                apex = left;
+                apexIndex = leftIndex;
+                right = apex;
+                rightIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+        
+        //Narrow the funnel from the left
+        if(Cyb_TriArea2D(&apex, &left, &lefts[i]) >= 0.0f)
+        {
+            if(Cyb_SamePoint(&apex, &left) ||
+                Cyb_TriArea2D(&apex, &right, &lefts[i]) < 0.0f)
+            {
+                left = lefts[i];
+                leftIndex = i;
+            }
+            else
+            {
+                //The left side crossed the right side, so the right is a corner
+                if(!Cyb_AddPathPoint(query, &right))
+                {
+                    return;
+                }
+                
+                apex = right;
+                apexIndex = rightIndex;
+                left = apex;
+                leftIndex = apexIndex;
+                i = apexIndex;
+                continue;
+            }
+        }
+    }
+    
+    Cyb_AddPathPoint(query, &lefts[portalCount - 1]);
+}
+
+
+static int Cyb_SolvePath(const Cyb_NavMesh *nav, Cyb_PathScratch *scratch,
+    Cyb_PathQuery *query)
+{
+    //Move the end points onto the navigation mesh
+    Cyb_Vec3 start;
+    Cyb_Vec3 end;
+    int startTri = Cyb_FindNavTriangle(nav, &query->start, CYB_NAV_SEARCH_DIST,
+        &start);
+    int endTri = Cyb_FindNavTriangle(nav, &query->end, CYB_NAV_SEARCH_DIST,
+        &end);
+    query->pointCount = 0;
+    
+    if(startTri < 0 || endTri < 0)
+    {
+        query->status = CYB_PATH_FAILED;
+        return query->status;
+    }
+    
+    //Find the corridor of triangles
+    int lastTri = Cyb_SearchCorridor(nav, scratch, startTri, &start, endTri,
+        &end);
+    query->status = CYB_PATH_FOUND;
+    
+    if(lastTri != endTri)
+    {
+        Cyb_ClosestPointOnNavTriangle(nav, lastTri, &query->end, &end);
+        query->status = CYB_PATH_PARTIAL;
+    }
+    
+    int length = 0;
+    
+    for(int tri = lastTri; tri >= 0; tri = scratch->parents[tri])
+    {
+        length++;
+    }
+    
+    for(int tri = lastTri, i = length - 1; tri >= 0;
+        tri = scratch->parents[tri], i--)
+    {
+        scratch->corridor[i] = tri;
+    }
+    
+    //Collect the shared edges along the corridor
+    scratch->lefts[0] = start;
+    scratch->rights[0] = start;
+    
+    for(int i = 0; i + 1 < length; i++)
+    {
+        int tri = scratch->corridor[i];
+        int next = scratch->corridor[i + 1];
+        int edge = 0;
+        
+        while(edge < 2 && nav->neighbors[tri * 3 + edge] != next)
+        {
+            edge++;
+        }
+        
+        //Triangles are counter-clockwise, so edges run from left to right
+        scratch->lefts[i + 1] = nav->verts[nav->tris[tri * 3 + edge]];
+        scratch->rights[i + 1] = nav->verts[nav->tris[tri * 3 +
+            (edge + 1) % 3]];
+    }
+    
+    scratch->lefts[length] = end;
+    scratch->rights[length] = end;
+    
+    //Pull the path tight
+    Cyb_PullPath(scratch, length + 1, query);
+    return query->status;
+}
+
+
+int Cyb_FindPath(const Cyb_NavMesh *nav, Cyb_PathQuery *query)
+{
+    //Search with a temporary scratch buffer
+    Cyb_PathScratch scratch;
+    
+    if(Cyb_InitPathScratch(&scratch, nav->triCount))
+    {
+        query->pointCount = 0;
+        query->status = CYB_PATH_FAILED;
+        return query->status;
+    }
+    
+    Cyb_SolvePath(nav, &scratch, query);
+    Cyb_FiniPathScratch(&scratch);
+    return query->status;
+}
+
+
+void Cyb_FreePathQueue(Cyb_PathQueue *queue)
+{
+    //Free the scratch buffers and release the navigation mesh
+    for(int i = 0; i < queue->scratchCount; i++)
+    {
+        Cyb_FiniPathScratch(&queue->scratches[i]);
+    }
+    
+    SDL_free(queue->scratches);
+    SDL_free(queue->queries);
+    Cyb_FreeObject((Cyb_Object**)&queue->nav);
+}
+
+
+Cyb_PathQueue *Cyb_CreatePathQueue(Cyb_NavMesh *nav, Cyb_JobSystem *jobs)
+{
+    //Allocate new path queue
+    Cyb_PathQueue *queue = (Cyb_PathQueue*)Cyb_CreateObject(
+        sizeof(Cyb_PathQueue), (Cyb_FreeProc)&Cyb_FreePathQueue,
+        CYB_PATHQUEUE);
+    
+    if(!queue)
+    {
+        return NULL;
+    }
+    
+    //Initialize the path queue
+    memset((char*)queue + sizeof(Cyb_Object), 0,
+        sizeof(Cyb_PathQueue) - sizeof(Cyb_Object));
+    queue->nav = (Cyb_NavMesh*)Cyb_NewObjectRef((Cyb_Object*)nav);
+    queue->jobs = jobs;
+    
+    //Each thread searches with its own scratch buffer
+    int scratchCount = jobs ? jobs->threadCount + 1 : 1;
+    queue->scratches = (Cyb_PathScratch*)SDL_malloc(sizeof(Cyb_PathScratch) *
+        scratchCount);
+    
+    if(!queue->scratches)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybNav] Out of Memory");
+        Cyb_FreeObject((Cyb_Object**)&queue);
+        return NULL;
+    }
+    
+    for(; queue->scratchCount < scratchCount; queue->scratchCount++)
+    {
+        if(Cyb_InitPathScratch(&queue->scratches[queue->scratchCount],
+            nav->triCount))
+        {
+            Cyb_FreeObject((Cyb_Object**)&queue);
+            return NULL;
+        }
+    }
+    
+    return queue;
+}
+
+
+int Cyb_SubmitPathQuery(Cyb_PathQueue *queue, Cyb_PathQuery *query)
+{
+    //Grow the queue if needed
+    if(queue->count >= queue->capacity)
+    {
+        int capacity = max(queue->capacity * 2, 64);
+        Cyb_PathQuery **queries = (Cyb_PathQuery**)SDL_realloc(queue->queries,
+            sizeof(Cyb_PathQuery*) * capacity);
+        
+        if(!queries)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybNav] Out of Memory");
+            return CYB_ERROR;
+        }
+        
+        queue->queries = queries;
+        queue->capacity = capacity;
+    }
+    
+    //Add the query
+    query->pointCount = 0;
+    query->status = CYB_PATH_PENDING;
+    queue->queries[queue->count++] = query;
+    return CYB_NO_ERROR;
+}
+
+
+static void Cyb_PathJob(void *data, int index)
+{
+    //Take queries in order until they run out or the time is up
+    Cyb_PathQueue *queue = (Cyb_PathQueue*)data;
+    Cyb_PathScratch *scratch = &queue->scratches[index];
+    
+    for(;;)
+    {
+        int i = SDL_AtomicAdd(&queue->next, 1);
+        
+        if(i >= queue->count)
+        {
+            break;
+        }
+        
+        //Check the time after each query so that every update makes progress
+        Cyb_SolvePath(queue->nav, scratch, queue->queries[i]);
+        
+        if(queue->deadline && SDL_GetPerformanceCounter() >= queue->deadline)
+        {
+            break;
+        }
+    }
+}
+
+
+int Cyb_UpdatePathQueue(Cyb_PathQueue *queue, float budget)
+{
+    if(!queue->count)
+    {
+        return 0;
+    }
+    
+    //Run the queries
+    SDL_AtomicSet(&queue->next, 0);
+    queue->deadline = 0;
+    
+    if(budget > 0.0f)
+    {
+        queue->deadline = SDL_GetPerformanceCounter() +
+            (Uint64)(budget / 1000.0f * SDL_GetPerformanceFrequency());
+    }
+    
+    Cyb_RunJobs(queue->jobs, &Cyb_PathJob, queue, queue->scratchCount);
+    
+    //Every query that was taken has finished, so remove them from the front
+    int done = min(SDL_AtomicGet(&queue->next), queue->count);
+    queue->count -= done;
+    memmove(queue->queries, queue->queries + done,
+        sizeof(Cyb_PathQuery*) * queue->count);
+    return done;
+}
+
+
+int Cyb_GetPendingPathCount(const Cyb_PathQueue *queue)
+{
+    return queue->count;
+}
\ No newline at end of file
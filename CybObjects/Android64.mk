@@ -6,6 +6,7 @@ LOCAL_C_INCLUDES := \
     ../CybCommon \
     ../deps/android/arm64-v8a/SDL2/include
 LOCAL_SRC_FILES := \
+    src/CybJobs.c \
     src/CybList.c \
     src/CybObject.c \
     src/CybObjects.c \
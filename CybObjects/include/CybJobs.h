@@ -0,0 +1,85 @@
+#ifndef CYBJOBS_H
+#define CYBJOBS_H
+
+/** @file
+ * @brief CybObjects - Job System API
+ */
+
+#include "CybObject.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybObjects
+ * @brief Cybermals Engine - Objects API
+ * @{
+ */
+
+//Types
+//=================================================================================
+/** @brief Job procedure.
+ *
+ * @param data The data pointer that was passed to Cyb_RunJobs.
+ * @param index The index of the job.
+ */
+typedef void (*Cyb_JobProc)(void *data, int index);
+
+
+//Structures
+//=================================================================================
+/** @brief Job system structure and type.
+ */
+typedef struct
+{
+    Cyb_Object base;      /**< Base object. (read-only) */
+    int threadCount;      /**< Number of worker threads. (read-only) */
+    SDL_Thread **threads; /**< Worker threads. (read-only) */
+    SDL_sem *start;       /**< Wakes the worker threads. (read-only) */
+    SDL_sem *finished;    /**< Posted by each worker when it runs out of jobs. (read-only) */
+    Cyb_JobProc proc;     /**< Current job procedure. (read-only) */
+    void *data;           /**< Current job data. (read-only) */
+    int count;            /**< Current number of jobs. (read-only) */
+    SDL_atomic_t next;    /**< Index of the next job to run. (read-only) */
+    int quit;             /**< Tells the worker threads to exit. (read-only) */
+} Cyb_JobSystem;
+
+
+//Functions
+//=================================================================================
+/** @brief Create a new job system.
+ *
+ * @param threadCount The number of worker threads. Pass a negative value to
+ * create one less than the number of CPU cores, since the calling thread also
+ * runs jobs.
+ *
+ * @return Pointer to the job system or NULL.
+ */
+CYBAPI Cyb_JobSystem *Cyb_CreateJobSystem(int threadCount);
+
+/** @brief Run a batch of jobs and wait for all of them to finish.
+ *
+ * Calls proc once for each index from 0 to count - 1. The jobs are spread over
+ * the worker threads and the calling thread, so they must not depend on each
+ * other. Batches from different threads are run one after the other. Must not
+ * be called from inside a job.
+ *
+ * @param jobs Pointer to the job system. If NULL, the jobs are run on the
+ * calling thread.
+ * @param proc The job procedure.
+ * @param data Pointer to pass to each job.
+ * @param count The number of jobs.
+ */
+CYBAPI void Cyb_RunJobs(Cyb_JobSystem *jobs, Cyb_JobProc proc, void *data,
+    int count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -21,6 +21,8 @@ extern "C" {
 
 //Enums
 //==================================================================================
+//New object types are added at the end, so the values of the existing ones
+//stay the same
 enum Cyb_ObjectTypes
 {
     //Base objects
@@ -48,7 +50,24 @@ enum Cyb_ObjectTypes
     CYB_ARMATURE,    /**< Armature object. */
     CYB_POSE,        /**< Pose object. */
     CYB_ANIMCHANNEL, /**< Animation channel object. */
-    CYB_ANIMATION    /**< Animation object. */
+    CYB_ANIMATION,   /**< Animation object. */
+    
+    //Job objects
+    CYB_JOBSYSTEM,   /**< Job system object. */
+    
+    //Physics objects
+    CYB_PHYSICSWORLD, /**< Physics world object. */
+    
+    //Navigation objects
+    CYB_NAVMESH,     /**< Navigation mesh object. */
+    CYB_PATHQUEUE,   /**< Path query queue object. */
+    
+    //More renderer objects
+    CYB_RENDERQUEUE,   /**< Render queue object. */
+    CYB_GEOMETRYARENA, /**< Geometry arena object. */
+    
+    //Scene objects
+    CYB_SCENEGRAPH   /**< Scene graph object. */
 };
 
 
@@ -6,6 +6,7 @@
  */
  
 #include "CybCommon.h"
+#include "CybJobs.h"
 #include "CybList.h"
 #include "CybObject.h"
 #include "CybQueue.h"
@@ -0,0 +1,178 @@
+/*
+CybObjects - Job System API
+*/
+
+#include "CybJobs.h"
+
+
+//Functions
+//=================================================================================
+static void Cyb_DoJobs(Cyb_JobSystem *jobs)
+{
+    //Grab job indices until there are none left
+    int i;
+    
+    while((i = SDL_AtomicAdd(&jobs->next, 1)) < jobs->count)
+    {
+        jobs->proc(jobs->data, i);
+    }
+}
+
+
+static int Cyb_JobWorker(void *data)
+{
+    Cyb_JobSystem *jobs = (Cyb_JobSystem*)data;
+    
+    while(TRUE)
+    {
+        //Wait for the next batch
+        SDL_SemWait(jobs->start);
+        
+        if(jobs->quit)
+        {
+            return 0;
+        }
+        
+        //Run jobs and report back
+        Cyb_DoJobs(jobs);
+        SDL_SemPost(jobs->finished);
+    }
+}
+
+
+static void Cyb_FreeJobSystem(Cyb_JobSystem *jobs)
+{
+    //Stop the worker threads
+    jobs->quit = TRUE;
+    
+    for(int i = 0; i < jobs->threadCount; i++)
+    {
+        SDL_SemPost(jobs->start);
+    }
+    
+    for(int i = 0; i < jobs->threadCount; i++)
+    {
+        SDL_WaitThread(jobs->threads[i], NULL);
+    }
+    
+    //Free the threads and semaphores
+    if(jobs->threads)
+    {
+        SDL_free(jobs->threads);
+    }
+    
+    if(jobs->start)
+    {
+        SDL_DestroySemaphore(jobs->start);
+    }
+    
+    if(jobs->finished)
+    {
+        SDL_DestroySemaphore(jobs->finished);
+    }
+}
+
+
+Cyb_JobSystem *Cyb_CreateJobSystem(int threadCount)
+{
+    //Allocate a new job system
+    Cyb_JobSystem *jobs = (Cyb_JobSystem*)Cyb_CreateObject(
+        sizeof(Cyb_JobSystem), (Cyb_FreeProc)&Cyb_FreeJobSystem,
+        CYB_JOBSYSTEM);
+    
+    if(!jobs)
+    {
+        return NULL;
+    }
+    
+    //Initialize the job system
+    if(threadCount < 0)
+    {
+        threadCount = SDL_max(SDL_GetCPUCount() - 1, 0);
+    }
+    
+    jobs->threadCount = 0;
+    jobs->threads = (SDL_Thread**)SDL_malloc(sizeof(SDL_Thread*) *
+        (threadCount + 1));
+    jobs->start = SDL_CreateSemaphore(0);
+    jobs->finished = SDL_CreateSemaphore(0);
+    jobs->proc = NULL;
+    jobs->data = NULL;
+    jobs->count = 0;
+    SDL_AtomicSet(&jobs->next, 0);
+    jobs->quit = FALSE;
+    
+    if(!jobs->threads)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybObjects] Out of Memory");
+        Cyb_FreeObject((Cyb_Object**)&jobs);
+        return NULL;
+    }
+    
+    if(!jobs->start || !jobs->finished)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[CybObjects] %s",
+            SDL_GetError());
+        Cyb_FreeObject((Cyb_Object**)&jobs);
+        return NULL;
+    }
+    
+    //Start the worker threads
+    for(int i = 0; i < threadCount; i++)
+    {
+        SDL_Thread *thread = SDL_CreateThread(&Cyb_JobWorker, "CybJobWorker",
+            jobs);
+        
+        if(!thread)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[CybObjects] %s",
+                SDL_GetError());
+            Cyb_FreeObject((Cyb_Object**)&jobs);
+            return NULL;
+        }
+        
+        jobs->threads[jobs->threadCount++] = thread;
+    }
+    
+    return jobs;
+}
+
+
+void Cyb_RunJobs(Cyb_JobSystem *jobs, Cyb_JobProc proc, void *data,
+    int count)
+{
+    //Run the jobs on the calling thread if there are no workers
+    if(!jobs || !jobs->threadCount || count <= 1)
+    {
+        for(int i = 0; i < count; i++)
+        {
+            proc(data, i);
+        }
+        
+        return;
+    }
+    
+    //Publish the batch and wake only as many workers as there are extra jobs
+    Cyb_LockObject((Cyb_Object*)jobs);
+    jobs->proc = proc;
+    jobs->data = data;
+    jobs->count = count;
+    SDL_AtomicSet(&jobs->next, 0);
+    int workers = SDL_min(jobs->threadCount, count - 1);
+    
+    for(int i = 0; i < workers; i++)
+    {
+        SDL_SemPost(jobs->start);
+    }
+    
+    //Help out and wait for the workers to finish
+    Cyb_DoJobs(jobs);
+    
+    for(int i = 0; i < workers; i++)
+    {
+        SDL_SemWait(jobs->finished);
+    }
+    
+    Cyb_UnlockObject((Cyb_Object*)jobs);
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+LOCAL_MODULE := CybPhysics
+LOCAL_C_INCLUDES := \
+    include \
+    ../CybCommon \
+    ../deps/android/armeabi-v7a/SDL2/include \
+    ../deps/android/armeabi-v7a/SDL2/include/SDL2 \
+    ../CybObjects/include \
+    ../CybMath/include
+LOCAL_SRC_FILES := \
+    src/CybCollide.c \
+    src/CybPhysicsWorld.c
+LOCAL_CFLAGS := -DCYB_MATH_INLINE
+LOCAL_LDFLAGS += \
+    -LC:/android-sdk/ndk/19.2.5345600/toolchains/llvm/prebuilt/windows/lib/gcc/arm-linux-androideabi/4.9.x/armv7-a \
+    -LC:/android-sdk/ndk/19.2.5345600/toolchains/llvm/prebuilt/windows/arm-linux-androideabi/lib/armv7-a \
+    -L../deps/android/armeabi-v7a/SDL2/bin \
+    -L../CybObjects/libs/armeabi-v7a \
+    -L../CybMath/libs/armeabi-v7a
+LOCAL_LDLIBS += -lSDL2 -lCybObjects -lCybMath
+include $(BUILD_SHARED_LIBRARY)
\ No newline at end of file
@@ -0,0 +1,4 @@
+APP_ABI := armeabi-v7a
+APP_PLATFORM := android-28
+APP_STL := c++_static
+APP_BUILD_SCRIPT := Android.mk
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef CYBCOLLIDE_H
+#define CYBCOLLIDE_H
+
+/** @file
+ * @brief CybPhysics - Collision API
+ */
+
+#include "CybCommon.h"
+#include "CybMath.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybPhysics
+ * @brief Cybermals Engine - Physics Library
+ * @{
+ */
+
+//Macros
+//=================================================================================
+/** @brief The maximum number of contacts generated for a pair of shapes.
+ */
+#define CYB_MAX_CONTACTS 8
+
+
+//Enums
+//=================================================================================
+/** @brief Collision shape types.
+ */
+enum Cyb_ShapeTypes
+{
+    CYB_SHAPE_SPHERE, /**< Sphere. */
+    CYB_SHAPE_BOX,    /**< Box. */
+    CYB_SHAPE_CAPSULE /**< Capsule along the local Y axis. */
+};
+
+
+//Structures
+//=================================================================================
+/** @brief Collision shape.
+ */
+typedef struct
+{
+    int type;      /**< The shape type. */
+    Cyb_Vec3 size; /**< Sphere: x is the radius. Box: the half extents. Capsule:
+                        x is the radius and y is half the length of the
+                        segment between the 2 caps. */
+} Cyb_Shape;
+
+/** @brief Contact point between 2 shapes.
+ */
+typedef struct
+{
+    Cyb_Vec3 point;  /**< The point midway between the 2 surfaces. */
+    Cyb_Vec3 normal; /**< The contact normal. Points from the first shape to the
+                          second one. */
+    float depth;     /**< The penetration depth. Negative if the shapes are
+                          separated. */
+} Cyb_Contact;
+
+
+//Functions
+//=================================================================================
+/** @brief Calculate the axis-aligned bounding box of a shape.
+ *
+ * @param box Pointer to the resulting box.
+ * @param shape Pointer to the shape.
+ * @param pos Pointer to the position of the shape.
+ * @param rot Pointer to the rotation (quaternion) of the shape.
+ */
+CYBAPI void Cyb_ShapeBounds(Cyb_Box *box, const Cyb_Shape *shape,
+    const Cyb_Vec3 *pos, const Cyb_Vec4 *rot);
+
+/** @brief Generate contact points between 2 shapes.
+ *
+ * Supports every combination of spheres, boxes, and capsules. Boxes use the
+ * separating axis test and clip the incident face against the reference face,
+ * so resting boxes get up to 4 contacts.
+ *
+ * @param a Pointer to the first shape.
+ * @param posA Pointer to the position of the first shape.
+ * @param rotA Pointer to the rotation (quaternion) of the first shape.
+ * @param b Pointer to the second shape.
+ * @param posB Pointer to the position of the second shape.
+ * @param rotB Pointer to the rotation (quaternion) of the second shape.
+ * @param margin Contacts are also generated for shapes which are separated by
+ * less than this distance.
+ * @param contacts Pointer to an array of at least CYB_MAX_CONTACTS contacts.
+ *
+ * @return The number of contacts.
+ */
+CYBAPI int Cyb_CollideShapes(const Cyb_Shape *a, const Cyb_Vec3 *posA,
+    const Cyb_Vec4 *rotA, const Cyb_Shape *b, const Cyb_Vec3 *posB,
+    const Cyb_Vec4 *rotB, float margin, Cyb_Contact *contacts);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+#ifndef CYBPHYSICS_H
+#define CYBPHYSICS_H
+
+/** @file
+ * @brief CybPhysics - Main API
+ */
+ 
+#include "CybCollide.h"
+#include "CybPhysicsWorld.h"
+
+#endif
\ No newline at end of file
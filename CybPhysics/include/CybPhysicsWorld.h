@@ -0,0 +1,220 @@
+#ifndef CYBPHYSICSWORLD_H
+#define CYBPHYSICSWORLD_H
+
+/** @file
+ * @brief CybPhysics - Physics World API
+ */
+
+#include "CybCommon.h"
+#include "CybMath.h"
+#include "CybObjects.h"
+#include "CybCollide.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybPhysics
+ * @brief Cybermals Engine - Physics Library
+ * @{
+ */
+
+//Types
+//=================================================================================
+/** @brief Physics world object.
+ */
+typedef struct Cyb_PhysicsWorld Cyb_PhysicsWorld;
+
+
+//Structures
+//=================================================================================
+/** @brief Rigid body description.
+ */
+typedef struct
+{
+    Cyb_Shape shape;   /**< The collision shape. */
+    Cyb_Vec3 pos;      /**< The initial position. */
+    Cyb_Vec4 rot;      /**< The initial rotation (quaternion). */
+    Cyb_Vec3 linVel;   /**< The initial linear velocity. */
+    Cyb_Vec3 angVel;   /**< The initial angular velocity. */
+    float mass;        /**< The mass. 0 creates a static body. */
+    float friction;    /**< The friction coefficient. */
+    float restitution; /**< The restitution (bounciness) from 0 to 1. */
+} Cyb_BodyDesc;
+
+/** @brief Statistics about the last simulation step.
+ */
+typedef struct
+{
+    int bodyCount;    /**< The number of bodies. */
+    int awakeCount;   /**< The number of dynamic bodies that are awake. */
+    int pairCount;    /**< The number of broad phase pairs. */
+    int contactCount; /**< The number of contact points. */
+    int islandCount;  /**< The number of islands that were solved. */
+} Cyb_PhysicsStats;
+
+
+//Functions
+//=================================================================================
+/** @brief Create a new physics world.
+ *
+ * @param jobs Pointer to a job system which is used to run the narrow phase
+ * and solve independent islands in parallel. Can be NULL.
+ *
+ * @return Pointer to the physics world or NULL.
+ */
+CYBAPI Cyb_PhysicsWorld *Cyb_CreatePhysicsWorld(Cyb_JobSystem *jobs);
+
+/** @brief Set the gravity of a physics world.
+ *
+ * @param world Pointer to the physics world.
+ * @param x The X component of the gravity.
+ * @param y The Y component of the gravity.
+ * @param z The Z component of the gravity.
+ */
+CYBAPI void Cyb_SetPhysicsGravity(Cyb_PhysicsWorld *world, float x, float y,
+    float z);
+
+/** @brief Set the number of solver iterations of a physics world.
+ *
+ * @param world Pointer to the physics world.
+ * @param iterations The number of velocity iterations per step.
+ */
+CYBAPI void Cyb_SetPhysicsIterations(Cyb_PhysicsWorld *world, int iterations);
+
+/** @brief Add a rigid body to a physics world.
+ *
+ * @param world Pointer to the physics world.
+ * @param desc Pointer to the body description.
+ *
+ * @return The ID of the new body or -1 on failure.
+ */
+CYBAPI int Cyb_AddRigidBody(Cyb_PhysicsWorld *world, const Cyb_BodyDesc *desc);
+
+/** @brief Get the number of bodies in a physics world.
+ *
+ * @param world Pointer to the physics world.
+ *
+ * @return The number of bodies.
+ */
+CYBAPI int Cyb_GetBodyCount(Cyb_PhysicsWorld *world);
+
+/** @brief Set the position of a body and wake it up.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ * @param pos Pointer to the new position.
+ */
+CYBAPI void Cyb_SetBodyPos(Cyb_PhysicsWorld *world, int id,
+    const Cyb_Vec3 *pos);
+
+/** @brief Get the position of a body.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ *
+ * @return Pointer to the body position.
+ */
+CYBAPI const Cyb_Vec3 *Cyb_GetBodyPos(Cyb_PhysicsWorld *world, int id);
+
+/** @brief Set the rotation of a body and wake it up.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ * @param rot Pointer to the new rotation (quaternion).
+ */
+CYBAPI void Cyb_SetBodyRot(Cyb_PhysicsWorld *world, int id,
+    const Cyb_Vec4 *rot);
+
+/** @brief Get the rotation of a body.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ *
+ * @return Pointer to the body rotation (quaternion).
+ */
+CYBAPI const Cyb_Vec4 *Cyb_GetBodyRot(Cyb_PhysicsWorld *world, int id);
+
+/** @brief Get the transformation matrix of a body.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ * @param mat Pointer to the resulting matrix.
+ */
+CYBAPI void Cyb_GetBodyTransform(Cyb_PhysicsWorld *world, int id,
+    Cyb_Mat4 *mat);
+
+/** @brief Set the velocity of a body and wake it up.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ * @param linVel Pointer to the new linear velocity.
+ * @param angVel Pointer to the new angular velocity.
+ */
+CYBAPI void Cyb_SetBodyVel(Cyb_PhysicsWorld *world, int id,
+    const Cyb_Vec3 *linVel, const Cyb_Vec3 *angVel);
+
+/** @brief Get the velocity of a body.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ * @param linVel Pointer to the resulting linear velocity.
+ * @param angVel Pointer to the resulting angular velocity.
+ */
+CYBAPI void Cyb_GetBodyVel(Cyb_PhysicsWorld *world, int id, Cyb_Vec3 *linVel,
+    Cyb_Vec3 *angVel);
+
+/** @brief Apply an impulse to a body and wake it up.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ * @param impulse Pointer to the impulse.
+ * @param point Pointer to the point where the impulse is applied (world
+ * space).
+ */
+CYBAPI void Cyb_ApplyBodyImpulse(Cyb_PhysicsWorld *world, int id,
+    const Cyb_Vec3 *impulse, const Cyb_Vec3 *point);
+
+/** @brief Check if a body is asleep.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ *
+ * @return TRUE if the body is asleep or FALSE if it is awake. Static bodies are
+ * always asleep.
+ */
+CYBAPI int Cyb_IsBodyAsleep(Cyb_PhysicsWorld *world, int id);
+
+/** @brief Wake up a body.
+ *
+ * @param world Pointer to the physics world.
+ * @param id The body ID.
+ */
+CYBAPI void Cyb_WakeBody(Cyb_PhysicsWorld *world, int id);
+
+/** @brief Advance a physics world.
+ *
+ * @param world Pointer to the physics world.
+ * @param dt The time step in seconds. A fixed step gives the most stable
+ * results.
+ */
+CYBAPI void Cyb_StepPhysicsWorld(Cyb_PhysicsWorld *world, float dt);
+
+/** @brief Get statistics about the last step of a physics world.
+ *
+ * @param world Pointer to the physics world.
+ * @param stats Pointer to the resulting statistics.
+ */
+CYBAPI void Cyb_GetPhysicsStats(Cyb_PhysicsWorld *world,
+    Cyb_PhysicsStats *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
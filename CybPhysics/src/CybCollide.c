@@ -0,0 +1,803 @@
+/*
+CybPhysics - Collision API
+*/
+
+#include <float.h>
+#include <math.h>
+
+#include "CybCollide.h"
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    Cyb_Vec3 pos;
+    Cyb_Vec3 axes[3];
+} Cyb_Frame;
+
+
+//Functions
+//=================================================================================
+static Cyb_Vec3 Cyb_V3(float x, float y, float z)
+{
+    Cyb_Vec3 v = {x, y, z};
+    return v;
+}
+
+
+static Cyb_Vec3 Cyb_V3Add(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return Cyb_V3(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+
+static Cyb_Vec3 Cyb_V3Sub(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return Cyb_V3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+
+static Cyb_Vec3 Cyb_V3Scale(Cyb_Vec3 a, float s)
+{
+    return Cyb_V3(a.x * s, a.y * s, a.z * s);
+}
+
+
+static Cyb_Vec3 Cyb_V3MulAdd(Cyb_Vec3 a, Cyb_Vec3 b, float s)
+{
+    return Cyb_V3(a.x + b.x * s, a.y + b.y * s, a.z + b.z * s);
+}
+
+
+static float Cyb_V3Dot(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+
+static Cyb_Vec3 Cyb_V3Cross(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return Cyb_V3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+        a.x * b.y - a.y * b.x);
+}
+
+
+static float Cyb_Clamp(float x, float lo, float hi)
+{
+    return x < lo ? lo : (x > hi ? hi : x);
+}
+
+
+static void Cyb_MakeFrame(Cyb_Frame *frame, const Cyb_Vec3 *pos,
+    const Cyb_Vec4 *rot)
+{
+    //The columns of the rotation matrix are the local axes
+    Cyb_Mat4 m;
+    Cyb_QuatToMatrix(&m, rot);
+    frame->pos = *pos;
+    frame->axes[0] = Cyb_V3(m.a, m.e, m.i);
+    frame->axes[1] = Cyb_V3(m.b, m.f, m.j);
+    frame->axes[2] = Cyb_V3(m.c, m.g, m.k);
+}
+
+
+static Cyb_Vec3 Cyb_ToLocal(const Cyb_Frame *frame, Cyb_Vec3 p)
+{
+    Cyb_Vec3 d = Cyb_V3Sub(p, frame->pos);
+    return Cyb_V3(Cyb_V3Dot(d, frame->axes[0]), Cyb_V3Dot(d, frame->axes[1]),
+        Cyb_V3Dot(d, frame->axes[2]));
+}
+
+
+static Cyb_Vec3 Cyb_RotateToWorld(const Cyb_Frame *frame, Cyb_Vec3 v)
+{
+    Cyb_Vec3 r = Cyb_V3Scale(frame->axes[0], v.x);
+    r = Cyb_V3MulAdd(r, frame->axes[1], v.y);
+    return Cyb_V3MulAdd(r, frame->axes[2], v.z);
+}
+
+
+static int Cyb_AddContact(Cyb_Contact *contacts, int count, Cyb_Vec3 point,
+    Cyb_Vec3 normal, float depth)
+{
+    if(count >= CYB_MAX_CONTACTS)
+    {
+        return count;
+    }
+    
+    contacts[count].point = point;
+    contacts[count].normal = normal;
+    contacts[count].depth = depth;
+    return count + 1;
+}
+
+
+static float Cyb_ClosestOnSegment(Cyb_Vec3 p0, Cyb_Vec3 p1, Cyb_Vec3 q)
+{
+    //Returns the parameter of the point on the segment closest to q
+    Cyb_Vec3 d = Cyb_V3Sub(p1, p0);
+    float len2 = Cyb_V3Dot(d, d);
+    
+    if(len2 <= 1e-12f)
+    {
+        return 0.0f;
+    }
+    
+    return Cyb_Clamp(Cyb_V3Dot(Cyb_V3Sub(q, p0), d) / len2, 0.0f, 1.0f);
+}
+
+
+static void Cyb_ClosestSegments(Cyb_Vec3 p1, Cyb_Vec3 q1, Cyb_Vec3 p2,
+    Cyb_Vec3 q2, float *s, float *t)
+{
+    //Find the parameters of the closest points between 2 segments
+    Cyb_Vec3 d1 = Cyb_V3Sub(q1, p1);
+    Cyb_Vec3 d2 = Cyb_V3Sub(q2, p2);
+    Cyb_Vec3 r = Cyb_V3Sub(p1, p2);
+    float a = Cyb_V3Dot(d1, d1);
+    float e = Cyb_V3Dot(d2, d2);
+    float f = Cyb_V3Dot(d2, r);
+    
+    if(a <= 1e-12f && e <= 1e-12f)
+    {
+        *s = *t = 0.0f;
+        return;
+    }
+    
+    if(a <= 1e-12f)
+    {
+        *s = 0.0f;
+        *t = Cyb_Clamp(f / e, 0.0f, 1.0f);
+        return;
+    }
+    
+    float c = Cyb_V3Dot(d1, r);
+    
+    if(e <= 1e-12f)
+    {
+        *t = 0.0f;
+        *s = Cyb_Clamp(-c / a, 0.0f, 1.0f);
+        return;
+    }
+    
+    float b = Cyb_V3Dot(d1, d2);
+    float denom = a * e - b * b;
+    *s = (denom > 1e-12f ? Cyb_Clamp((b * f - c * e) / denom, 0.0f, 1.0f) :
+        0.0f);
+    *t = (b * *s + f) / e;
+    
+    if(*t < 0.0f)
+    {
+        *t = 0.0f;
+        *s = Cyb_Clamp(-c / a, 0.0f, 1.0f);
+    }
+    else if(*t > 1.0f)
+    {
+        *t = 1.0f;
+        *s = Cyb_Clamp((b - c) / a, 0.0f, 1.0f);
+    }
+}
+
+
+static void Cyb_CapsuleSegment(const Cyb_Frame *frame, float halfHeight,
+    Cyb_Vec3 *p0, Cyb_Vec3 *p1)
+{
+    *p0 = Cyb_V3MulAdd(frame->pos, frame->axes[1], -halfHeight);
+    *p1 = Cyb_V3MulAdd(frame->pos, frame->axes[1], halfHeight);
+}
+
+
+static int Cyb_CollideSpheres(Cyb_Vec3 ca, float ra, Cyb_Vec3 cb, float rb,
+    float margin, Cyb_Contact *contacts, int count)
+{
+    //Reject spheres which are too far apart
+    Cyb_Vec3 d = Cyb_V3Sub(cb, ca);
+    float dist2 = Cyb_V3Dot(d, d);
+    float r = ra + rb + margin;
+    
+    if(dist2 > r * r)
+    {
+        return count;
+    }
+    
+    //Concentric spheres are pushed apart along the Y axis
+    float dist = sqrtf(dist2);
+    Cyb_Vec3 n = (dist > 1e-6f ? Cyb_V3Scale(d, 1.0f / dist) :
+        Cyb_V3(0.0f, 1.0f, 0.0f));
+    float depth = ra + rb - dist;
+    return Cyb_AddContact(contacts, count,
+        Cyb_V3MulAdd(ca, n, ra - depth * 0.5f), n, depth);
+}
+
+
+static float Cyb_BoxDistance(Cyb_Vec3 p, Cyb_Vec3 h)
+{
+    //Signed distance from a point to a box in the box's local space
+    float qx = fabsf(p.x) - h.x;
+    float qy = fabsf(p.y) - h.y;
+    float qz = fabsf(p.z) - h.z;
+    Cyb_Vec3 q = Cyb_V3(max(qx, 0.0f), max(qy, 0.0f), max(qz, 0.0f));
+    return sqrtf(Cyb_V3Dot(q, q)) + min(max(qx, max(qy, qz)), 0.0f);
+}
+
+
+static int Cyb_CollideSphereBox(Cyb_Vec3 c, float r, const Cyb_Frame *box,
+    Cyb_Vec3 h, float margin, Cyb_Contact *contacts, int count)
+{
+    //Find the closest point on the box to the sphere center
+    Cyb_Vec3 p = Cyb_ToLocal(box, c);
+    Cyb_Vec3 q = Cyb_V3(Cyb_Clamp(p.x, -h.x, h.x), Cyb_Clamp(p.y, -h.y, h.y),
+        Cyb_Clamp(p.z, -h.z, h.z));
+    Cyb_Vec3 d = Cyb_V3Sub(q, p);
+    float dist2 = Cyb_V3Dot(d, d);
+    Cyb_Vec3 n;
+    float depth;
+    
+    if(dist2 > 1e-12f)
+    {
+        if(dist2 > (r + margin) * (r + margin))
+        {
+            return count;
+        }
+        
+        float dist = sqrtf(dist2);
+        n = Cyb_V3Scale(d, 1.0f / dist);
+        depth = r - dist;
+    }
+    else
+    {
+        //The center is inside the box, so push it out through the nearest face
+        const float *pv = &p.x;
+        const float *hv = &h.x;
+        int axis = 0;
+        
+        for(int i = 1; i < 3; i++)
+        {
+            if(hv[i] - fabsf(pv[i]) < hv[axis] - fabsf(pv[axis]))
+            {
+                axis = i;
+            }
+        }
+        
+        n = Cyb_V3(0.0f, 0.0f, 0.0f);
+        (&n.x)[axis] = (pv[axis] > 0.0f ? -1.0f : 1.0f);
+        depth = r + hv[axis] - fabsf(pv[axis]);
+    }
+    
+    n = Cyb_RotateToWorld(box, n);
+    return Cyb_AddContact(contacts, count, Cyb_V3MulAdd(c, n, r - depth * 0.5f),
+        n, depth);
+}
+
+
+static int Cyb_CollideCapsuleBox(const Cyb_Frame *capsule, float radius,
+    float halfHeight, const Cyb_Frame *box, Cyb_Vec3 h, float margin,
+    Cyb_Contact *contacts)
+{
+    //Test both caps first
+    Cyb_Vec3 p0, p1;
+    Cyb_CapsuleSegment(capsule, halfHeight, &p0, &p1);
+    int count = Cyb_CollideSphereBox(p0, radius, box, h, margin, contacts, 0);
+    count = Cyb_CollideSphereBox(p1, radius, box, h, margin, contacts, count);
+    
+    /* The signed distance from the segment to the box is convex, so a ternary
+     * search finds the deepest point. It only needs its own contact if it is
+     * clearly deeper than both caps.
+     */
+    Cyb_Vec3 l0 = Cyb_ToLocal(box, p0);
+    Cyb_Vec3 l1 = Cyb_ToLocal(box, p1);
+    Cyb_Vec3 dl = Cyb_V3Sub(l1, l0);
+    float lo = 0.0f;
+    float hi = 1.0f;
+    
+    for(int i = 0; i < 24; i++)
+    {
+        float t0 = lo + (hi - lo) / 3.0f;
+        float t1 = hi - (hi - lo) / 3.0f;
+        
+        if(Cyb_BoxDistance(Cyb_V3MulAdd(l0, dl, t0), h) <
+            Cyb_BoxDistance(Cyb_V3MulAdd(l0, dl, t1), h))
+        {
+            hi = t1;
+        }
+        else
+        {
+            lo = t0;
+        }
+    }
+    
+    float t = (lo + hi) * 0.5f;
+    float depth = Cyb_BoxDistance(Cyb_V3MulAdd(l0, dl, t), h);
+    
+    if(depth < min(Cyb_BoxDistance(l0, h), Cyb_BoxDistance(l1, h)) - 0.001f)
+    {
+        count = Cyb_CollideSphereBox(
+            Cyb_V3MulAdd(p0, Cyb_V3Sub(p1, p0), t), radius, box, h, margin,
+            contacts, count);
+    }
+    
+    return count;
+}
+
+
+static int Cyb_CollideCapsules(const Cyb_Frame *a, float ra, float ha,
+    const Cyb_Frame *b, float rb, float hb, float margin, Cyb_Contact *contacts)
+{
+    Cyb_Vec3 a0, a1, b0, b1;
+    Cyb_CapsuleSegment(a, ha, &a0, &a1);
+    Cyb_CapsuleSegment(b, hb, &b0, &b1);
+    int count = 0;
+    
+    /* Parallel capsules get a contact at each end of the overlap so that they
+     * can rest on each other.
+     */
+    float align = Cyb_V3Dot(a->axes[1], b->axes[1]);
+    
+    if(fabsf(align) > 0.99f && ha > 0.0f && hb > 0.0f)
+    {
+        Cyb_Vec3 ends[4] = {a0, a1, b0, b1};
+        
+        for(int i = 0; i < 4; i++)
+        {
+            Cyb_Vec3 s0 = (i < 2 ? b0 : a0);
+            Cyb_Vec3 s1 = (i < 2 ? b1 : a1);
+            Cyb_Vec3 d = Cyb_V3Sub(s1, s0);
+            float t = Cyb_V3Dot(Cyb_V3Sub(ends[i], s0), d) / Cyb_V3Dot(d, d);
+            
+            if(t < 0.0f || t > 1.0f)
+            {
+                continue;
+            }
+            
+            Cyb_Vec3 q = Cyb_V3MulAdd(s0, d, t);
+            count = (i < 2 ?
+                Cyb_CollideSpheres(ends[i], ra, q, rb, margin, contacts, count) :
+                Cyb_CollideSpheres(q, ra, ends[i], rb, margin, contacts, count));
+        }
+        
+        if(count)
+        {
+            return count;
+        }
+    }
+    
+    //Otherwise use the closest points between the segments
+    float s, t;
+    Cyb_ClosestSegments(a0, a1, b0, b1, &s, &t);
+    return Cyb_CollideSpheres(Cyb_V3MulAdd(a0, Cyb_V3Sub(a1, a0), s), ra,
+        Cyb_V3MulAdd(b0, Cyb_V3Sub(b1, b0), t), rb, margin, contacts, count);
+}
+
+
+static int Cyb_ClipPolygon(const Cyb_Vec3 *in, int count, Cyb_Vec3 n,
+    float offset, Cyb_Vec3 *out)
+{
+    //Keep the part of the polygon where dot(n, p) <= offset
+    int outCount = 0;
+    
+    for(int i = 0; i < count; i++)
+    {
+        Cyb_Vec3 p = in[i];
+        Cyb_Vec3 q = in[(i + 1) % count];
+        float dp = Cyb_V3Dot(n, p) - offset;
+        float dq = Cyb_V3Dot(n, q) - offset;
+        
+        if(dp <= 0.0f)
+        {
+            out[outCount++] = p;
+        }
+        
+        if((dp < 0.0f && dq > 0.0f) || (dp > 0.0f && dq < 0.0f))
+        {
+            out[outCount++] = Cyb_V3MulAdd(p, Cyb_V3Sub(q, p), dp / (dp - dq));
+        }
+    }
+    
+    return outCount;
+}
+
+
+static int Cyb_ReduceContacts(Cyb_Contact *contacts, int count, Cyb_Vec3 n)
+{
+    /* Keep the deepest point, the point farthest from it, and the 2 points
+     * which span the largest area on either side of the line between them.
+     */
+    if(count <= 4)
+    {
+        return count;
+    }
+    
+    int keep[4];
+    keep[0] = 0;
+    
+    for(int i = 1; i < count; i++)
+    {
+        if(contacts[i].depth > contacts[keep[0]].depth)
+        {
+            keep[0] = i;
+        }
+    }
+    
+    Cyb_Vec3 p0 = contacts[keep[0]].point;
+    float best = -1.0f;
+    keep[1] = keep[0];
+    
+    for(int i = 0; i < count; i++)
+    {
+        Cyb_Vec3 d = Cyb_V3Sub(contacts[i].point, p0);
+        
+        if(Cyb_V3Dot(d, d) > best)
+        {
+            best = Cyb_V3Dot(d, d);
+            keep[1] = i;
+        }
+    }
+    
+    Cyb_Vec3 edge = Cyb_V3Sub(contacts[keep[1]].point, p0);
+    float maxArea = 0.0f;
+    float minArea = 0.0f;
+    keep[2] = keep[3] = -1;
+    
+    for(int i = 0; i < count; i++)
+    {
+        float area = Cyb_V3Dot(Cyb_V3Cross(edge,
+            Cyb_V3Sub(contacts[i].point, p0)), n);
+        
+        if(area > maxArea)
+        {
+            maxArea = area;
+            keep[2] = i;
+        }
+        else if(area < minArea)
+        {
+            minArea = area;
+            keep[3] = i;
+        }
+    }
+    
+    Cyb_Contact reduced[4];
+    int reducedCount = 0;
+    
+    for(int i = 0; i < 4; i++)
+    {
+        if(keep[i] >= 0 && (i != 1 || keep[1] != keep[0]))
+        {
+            reduced[reducedCount++] = contacts[keep[i]];
+        }
+    }
+    
+    for(int i = 0; i < reducedCount; i++)
+    {
+        contacts[i] = reduced[i];
+    }
+    
+    return reducedCount;
+}
+
+
+static int Cyb_CollideBoxes(const Cyb_Frame *a, Cyb_Vec3 ha,
+    const Cyb_Frame *b, Cyb_Vec3 hb, float margin, Cyb_Contact *contacts)
+{
+    const float *ea = &ha.x;
+    const float *eb = &hb.x;
+    Cyb_Vec3 d = Cyb_V3Sub(b->pos, a->pos);
+    float absR[3][3];
+    
+    for(int i = 0; i < 3; i++)
+    {
+        for(int j = 0; j < 3; j++)
+        {
+            absR[i][j] = fabsf(Cyb_V3Dot(a->axes[i], b->axes[j])) + 1e-6f;
+        }
+    }
+    
+    //Find the axis of least penetration among the face normals
+    float bestSep = -FLT_MAX;
+    int bestAxis = -1;
+    Cyb_Vec3 bestNormal = {0.0f, 1.0f, 0.0f};
+    
+    for(int i = 0; i < 3; i++)
+    {
+        float dist = Cyb_V3Dot(d, a->axes[i]);
+        float sep = fabsf(dist) - (ea[i] + eb[0] * absR[i][0] +
+            eb[1] * absR[i][1] + eb[2] * absR[i][2]);
+        
+        if(sep > margin)
+        {
+            return 0;
+        }
+        
+        if(sep > bestSep)
+        {
+            bestSep = sep;
+            bestAxis = i;
+            bestNormal = Cyb_V3Scale(a->axes[i], dist < 0.0f ? -1.0f : 1.0f);
+        }
+    }
+    
+    /* The faces of b and the edges only win if they are clearly better, which
+     * keeps resting contacts from switching between them every step.
+     */
+    float faceSep = bestSep;
+    
+    for(int i = 0; i < 3; i++)
+    {
+        float dist = Cyb_V3Dot(d, b->axes[i]);
+        float sep = fabsf(dist) - (eb[i] + ea[0] * absR[0][i] +
+            ea[1] * absR[1][i] + ea[2] * absR[2][i]);
+        
+        if(sep > margin)
+        {
+            return 0;
+        }
+        
+        if(sep > bestSep && sep > 0.95f * faceSep + 0.005f)
+        {
+            bestSep = sep;
+            bestAxis = 3 + i;
+            bestNormal = Cyb_V3Scale(b->axes[i], dist < 0.0f ? -1.0f : 1.0f);
+        }
+    }
+    
+    faceSep = bestSep;
+    
+    for(int i = 0; i < 3; i++)
+    {
+        for(int j = 0; j < 3; j++)
+        {
+            Cyb_Vec3 axis = Cyb_V3Cross(a->axes[i], b->axes[j]);
+            float len = sqrtf(Cyb_V3Dot(axis, axis));
+            
+            if(len < 1e-4f)
+            {
+                continue;
+            }
+            
+            axis = Cyb_V3Scale(axis, 1.0f / len);
+            float ra = 0.0f;
+            float rb = 0.0f;
+            
+            for(int k = 0; k < 3; k++)
+            {
+                ra += ea[k] * fabsf(Cyb_V3Dot(a->axes[k], axis));
+                rb += eb[k] * fabsf(Cyb_V3Dot(b->axes[k], axis));
+            }
+            
+            float dist = Cyb_V3Dot(d, axis);
+            float sep = fabsf(dist) - (ra + rb);
+            
+            if(sep > margin)
+            {
+                return 0;
+            }
+            
+            if(sep > bestSep && sep > 0.95f * faceSep + 0.005f)
+            {
+                bestSep = sep;
+                bestAxis = 6 + i * 3 + j;
+                bestNormal = Cyb_V3Scale(axis, dist < 0.0f ? -1.0f : 1.0f);
+            }
+        }
+    }
+    
+    if(bestAxis >= 6)
+    {
+        //Find the closest points between the 2 supporting edges
+        int i = (bestAxis - 6) / 3;
+        int j = (bestAxis - 6) % 3;
+        Cyb_Vec3 pa = a->pos;
+        Cyb_Vec3 pb = b->pos;
+        
+        for(int k = 0; k < 3; k++)
+        {
+            if(k != i)
+            {
+                pa = Cyb_V3MulAdd(pa, a->axes[k], Cyb_V3Dot(a->axes[k],
+                    bestNormal) > 0.0f ? ea[k] : -ea[k]);
+            }
+            
+            if(k != j)
+            {
+                pb = Cyb_V3MulAdd(pb, b->axes[k], Cyb_V3Dot(b->axes[k],
+                    bestNormal) > 0.0f ? -eb[k] : eb[k]);
+            }
+        }
+        
+        Cyb_Vec3 a0 = Cyb_V3MulAdd(pa, a->axes[i], -ea[i]);
+        Cyb_Vec3 a1 = Cyb_V3MulAdd(pa, a->axes[i], ea[i]);
+        Cyb_Vec3 b0 = Cyb_V3MulAdd(pb, b->axes[j], -eb[j]);
+        Cyb_Vec3 b1 = Cyb_V3MulAdd(pb, b->axes[j], eb[j]);
+        float s, t;
+        Cyb_ClosestSegments(a0, a1, b0, b1, &s, &t);
+        Cyb_Vec3 ca = Cyb_V3MulAdd(a0, Cyb_V3Sub(a1, a0), s);
+        Cyb_Vec3 cb = Cyb_V3MulAdd(b0, Cyb_V3Sub(b1, b0), t);
+        return Cyb_AddContact(contacts, 0,
+            Cyb_V3Scale(Cyb_V3Add(ca, cb), 0.5f), bestNormal, -bestSep);
+    }
+    
+    //Pick the reference and incident boxes
+    const Cyb_Frame *ref = (bestAxis < 3 ? a : b);
+    const Cyb_Frame *inc = (bestAxis < 3 ? b : a);
+    const float *refE = (bestAxis < 3 ? ea : eb);
+    const float *incE = (bestAxis < 3 ? eb : ea);
+    int refAxis = bestAxis % 3;
+    Cyb_Vec3 n = (bestAxis < 3 ? bestNormal : Cyb_V3Scale(bestNormal, -1.0f));
+    
+    //The incident face is the one most opposed to the reference normal
+    int incAxis = 0;
+    float incDot = 0.0f;
+    
+    for(int i = 0; i < 3; i++)
+    {
+        float dot = Cyb_V3Dot(inc->axes[i], n);
+        
+        if(fabsf(dot) > fabsf(incDot))
+        {
+            incAxis = i;
+            incDot = dot;
+        }
+    }
+    
+    Cyb_Vec3 incCenter = Cyb_V3MulAdd(inc->pos, inc->axes[incAxis],
+        incDot > 0.0f ? -incE[incAxis] : incE[incAxis]);
+    int u = (incAxis + 1) % 3;
+    int v = (incAxis + 2) % 3;
+    Cyb_Vec3 du = Cyb_V3Scale(inc->axes[u], incE[u]);
+    Cyb_Vec3 dv = Cyb_V3Scale(inc->axes[v], incE[v]);
+    Cyb_Vec3 poly[8];
+    Cyb_Vec3 clipped[8];
+    poly[0] = Cyb_V3Add(Cyb_V3Add(incCenter, du), dv);
+    poly[1] = Cyb_V3Add(Cyb_V3Sub(incCenter, du), dv);
+    poly[2] = Cyb_V3Sub(Cyb_V3Sub(incCenter, du), dv);
+    poly[3] = Cyb_V3Sub(Cyb_V3Add(incCenter, du), dv);
+    int polyCount = 4;
+    
+    //Clip the incident face against the side planes of the reference face
+    for(int i = 1; i < 3 && polyCount; i++)
+    {
+        int k = (refAxis + i) % 3;
+        Cyb_Vec3 side = ref->axes[k];
+        float center = Cyb_V3Dot(side, ref->pos);
+        polyCount = Cyb_ClipPolygon(poly, polyCount, side, center + refE[k],
+            clipped);
+        polyCount = Cyb_ClipPolygon(clipped, polyCount,
+            Cyb_V3Scale(side, -1.0f), -center + refE[k], poly);
+    }
+    
+    //Keep the points below the reference face
+    Cyb_Vec3 normal = (bestAxis < 3 ? n : Cyb_V3Scale(n, -1.0f));
+    float refOffset = Cyb_V3Dot(n, ref->pos) + refE[refAxis];
+    int count = 0;
+    
+    for(int i = 0; i < polyCount; i++)
+    {
+        float sep = Cyb_V3Dot(n, poly[i]) - refOffset;
+        
+        if(sep <= margin)
+        {
+            count = Cyb_AddContact(contacts, count,
+                Cyb_V3MulAdd(poly[i], n, -sep * 0.5f), normal, -sep);
+        }
+    }
+    
+    return Cyb_ReduceContacts(contacts, count, n);
+}
+
+
+void Cyb_ShapeBounds(Cyb_Box *box, const Cyb_Shape *shape,
+    const Cyb_Vec3 *pos, const Cyb_Vec4 *rot)
+{
+    Cyb_Frame frame;
+    Cyb_Vec3 ext;
+    Cyb_MakeFrame(&frame, pos, rot);
+    
+    switch(shape->type)
+    {
+    case CYB_SHAPE_BOX:
+        //Project the half extents onto the world axes
+        ext.x = fabsf(frame.axes[0].x) * shape->size.x +
+            fabsf(frame.axes[1].x) * shape->size.y +
+            fabsf(frame.axes[2].x) * shape->size.z;
+        ext.y = fabsf(frame.axes[0].y) * shape->size.x +
+            fabsf(frame.axes[1].y) * shape->size.y +
+            fabsf(frame.axes[2].y) * shape->size.z;
+        ext.z = fabsf(frame.axes[0].z) * shape->size.x +
+            fabsf(frame.axes[1].z) * shape->size.y +
+            fabsf(frame.axes[2].z) * shape->size.z;
+        break;
+    
+    case CYB_SHAPE_CAPSULE:
+        ext.x = fabsf(frame.axes[1].x) * shape->size.y + shape->size.x;
+        ext.y = fabsf(frame.axes[1].y) * shape->size.y + shape->size.x;
+        ext.z = fabsf(frame.axes[1].z) * shape->size.y + shape->size.x;
+        break;
+    
+    default:
+        ext = Cyb_V3(shape->size.x, shape->size.x, shape->size.x);
+        break;
+    }
+    
+    box->center = *pos;
+    box->size = Cyb_V3Scale(ext, 2.0f);
+}
+
+
+int Cyb_CollideShapes(const Cyb_Shape *a, const Cyb_Vec3 *posA,
+    const Cyb_Vec4 *rotA, const Cyb_Shape *b, const Cyb_Vec3 *posB,
+    const Cyb_Vec4 *rotB, float margin, Cyb_Contact *contacts)
+{
+    //Each pair of shape types is handled in one order only
+    if(a->type > b->type)
+    {
+        int count = Cyb_CollideShapes(b, posB, rotB, a, posA, rotA, margin,
+            contacts);
+        
+        for(int i = 0; i < count; i++)
+        {
+            contacts[i].normal = Cyb_V3Scale(contacts[i].normal, -1.0f);
+        }
+        
+        return count;
+    }
+    
+    Cyb_Frame fa, fb;
+    Cyb_Vec3 p0, p1;
+    Cyb_MakeFrame(&fa, posA, rotA);
+    Cyb_MakeFrame(&fb, posB, rotB);
+    
+    if(a->type == CYB_SHAPE_SPHERE)
+    {
+        switch(b->type)
+        {
+        case CYB_SHAPE_SPHERE:
+            return Cyb_CollideSpheres(*posA, a->size.x, *posB, b->size.x,
+                margin, contacts, 0);
+        
+        case CYB_SHAPE_BOX:
+            return Cyb_CollideSphereBox(*posA, a->size.x, &fb, b->size, margin,
+                contacts, 0);
+        
+        case CYB_SHAPE_CAPSULE:
+            Cyb_CapsuleSegment(&fb, b->size.y, &p0, &p1);
+            return Cyb_CollideSpheres(*posA, a->size.x, Cyb_V3MulAdd(p0,
+                Cyb_V3Sub(p1, p0), Cyb_ClosestOnSegment(p0, p1, *posA)),
+                b->size.x, margin, contacts, 0);
+        
+        default:
+            return 0;
+        }
+    }
+    
+    if(a->type == CYB_SHAPE_BOX)
+    {
+        if(b->type == CYB_SHAPE_BOX)
+        {
+            return Cyb_CollideBoxes(&fa, a->size, &fb, b->size, margin,
+                contacts);
+        }
+        
+        if(b->type == CYB_SHAPE_CAPSULE)
+        {
+            int count = Cyb_CollideCapsuleBox(&fb, b->size.x, b->size.y, &fa,
+                a->size, margin, contacts);
+            
+            for(int i = 0; i < count; i++)
+            {
+                contacts[i].normal = Cyb_V3Scale(contacts[i].normal, -1.0f);
+            }
+            
+            return count;
+        }
+        
+        return 0;
+    }
+    
+    if(a->type == CYB_SHAPE_CAPSULE && b->type == CYB_SHAPE_CAPSULE)
+    {
+        return Cyb_CollideCapsules(&fa, a->size.x, a->size.y, &fb, b->size.x,
+            b->size.y, margin, contacts);
+    }
+    
+    return 0;
+}
\ No newline at end of file
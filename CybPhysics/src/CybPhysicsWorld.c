@@ -0,0 +1,1254 @@
+/*
+CybPhysics - Physics World API
+*/
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "CybPhysicsWorld.h"
+
+
+//Macros
+//=================================================================================
+#define CYB_MANIFOLD_POINTS 4         //contact points kept per pair
+#define CYB_CONTACT_MARGIN 0.02f      //distance at which contacts are created
+#define CYB_PENETRATION_SLOP 0.005f   //penetration which is not corrected
+#define CYB_BAUMGARTE 0.2f            //fraction of penetration fixed per step
+#define CYB_POSITION_ITERATIONS 4
+#define CYB_BOUNCE_THRESHOLD 1.0f     //minimum approach speed for restitution
+#define CYB_WARM_START_DIST 0.05f     //maximum drift of a cached contact
+#define CYB_LINEAR_DAMPING 0.01f
+#define CYB_ANGULAR_DAMPING 0.05f
+#define CYB_SLEEP_LINEAR_VEL 0.05f
+#define CYB_SLEEP_ANGULAR_VEL 0.05f
+#define CYB_TIME_TO_SLEEP 0.5f
+#define CYB_PAIRS_PER_JOB 64
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    Cyb_Vec3 rows[3];
+} Cyb_Mat3;
+
+typedef struct
+{
+    Cyb_Vec3 point;
+    Cyb_Vec3 localA;
+    Cyb_Vec3 normal;
+    Cyb_Vec3 tangents[2];
+    Cyb_Vec3 rA;
+    Cyb_Vec3 rB;
+    float depth;
+    float bias;
+    float positionBias;
+    float normalMass;
+    float tangentMass[2];
+    float normalImpulse;
+    float tangentImpulse[2];
+    float positionImpulse;
+} Cyb_ContactPoint;
+
+typedef struct
+{
+    int a;
+    int b;
+    float friction;
+    float restitution;
+    int pointCount;
+    Cyb_ContactPoint points[CYB_MANIFOLD_POINTS];
+} Cyb_Manifold;
+
+typedef struct
+{
+    int bodyStart;
+    int bodyCount;
+    int manifoldStart;
+    int manifoldCount;
+    float minSleepTime;
+    int state;
+} Cyb_Island;
+
+enum Cyb_IslandStates
+{
+    CYB_ISLAND_ASLEEP,
+    CYB_ISLAND_SLEEPING,
+    CYB_ISLAND_AWAKE
+};
+
+struct Cyb_PhysicsWorld
+{
+    Cyb_Object base;
+    Cyb_JobSystem *jobs;
+    Cyb_Vec3 gravity;
+    int iterations;
+    float dt;
+    
+    //Rigid bodies (structure of arrays)
+    int bodyCount;
+    int bodyCapacity;
+    Cyb_Shape *shapes;
+    Cyb_Vec3 *positions;
+    Cyb_Vec4 *rotations;
+    Cyb_Vec3 *linVels;
+    Cyb_Vec3 *angVels;
+    Cyb_Vec3 *pseudoLinVels;
+    Cyb_Vec3 *pseudoAngVels;
+    float *invMasses;
+    Cyb_Vec3 *invInertias;
+    Cyb_Mat3 *worldInvInertias;
+    float *frictions;
+    float *restitutions;
+    float *sleepTimes;
+    unsigned char *asleep;
+    Cyb_Box *bounds;
+    
+    //Broad phase
+    Cyb_SweepAndPrune *broadPhase;
+    int pairCount;
+    int pairCapacity;
+    Cyb_Pair *pairs;
+    
+    //Contact manifolds from this step and the last one
+    int manifoldCount;
+    int manifoldCapacity;
+    Cyb_Manifold *manifolds;
+    int oldManifoldCount;
+    int oldManifoldCapacity;
+    Cyb_Manifold *oldManifolds;
+    int hashCapacity;
+    int *hash;
+    
+    //Islands (per body scratch arrays share the body capacity)
+    int islandCount;
+    Cyb_Island *islands;
+    int *parents;
+    int *islandIds;
+    int *islandBodies;
+    int islandManifoldCapacity;
+    int *islandManifolds;
+    
+    //Statistics
+    Cyb_PhysicsStats stats;
+};
+
+
+//Functions
+//=================================================================================
+static Cyb_Vec3 Cyb_V3(float x, float y, float z)
+{
+    Cyb_Vec3 v = {x, y, z};
+    return v;
+}
+
+
+static Cyb_Vec3 Cyb_V3Add(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return Cyb_V3(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+
+static Cyb_Vec3 Cyb_V3Sub(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return Cyb_V3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+
+static Cyb_Vec3 Cyb_V3Scale(Cyb_Vec3 a, float s)
+{
+    return Cyb_V3(a.x * s, a.y * s, a.z * s);
+}
+
+
+static Cyb_Vec3 Cyb_V3MulAdd(Cyb_Vec3 a, Cyb_Vec3 b, float s)
+{
+    return Cyb_V3(a.x + b.x * s, a.y + b.y * s, a.z + b.z * s);
+}
+
+
+static float Cyb_V3Dot(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+
+static Cyb_Vec3 Cyb_V3Cross(Cyb_Vec3 a, Cyb_Vec3 b)
+{
+    return Cyb_V3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+        a.x * b.y - a.y * b.x);
+}
+
+
+static Cyb_Vec3 Cyb_Mat3MulVec(const Cyb_Mat3 *m, Cyb_Vec3 v)
+{
+    return Cyb_V3(Cyb_V3Dot(m->rows[0], v), Cyb_V3Dot(m->rows[1], v),
+        Cyb_V3Dot(m->rows[2], v));
+}
+
+
+static Cyb_Vec3 Cyb_RotateByQuat(const Cyb_Vec4 *q, Cyb_Vec3 v, int inverse)
+{
+    //v' = v + 2w(u x v) + 2u x (u x v), where u is the vector part
+    Cyb_Vec3 u = Cyb_V3(q->x, q->y, q->z);
+    float w = (inverse ? -q->w : q->w);
+    Cyb_Vec3 t = Cyb_V3Scale(Cyb_V3Cross(u, v), 2.0f);
+    return Cyb_V3Add(Cyb_V3MulAdd(v, t, w), Cyb_V3Cross(u, t));
+}
+
+
+static int Cyb_IsBodyAwake(const Cyb_PhysicsWorld *world, int id)
+{
+    return world->invMasses[id] > 0.0f && !world->asleep[id];
+}
+
+
+static int Cyb_Reserve(void **buf, int *capacity, int count, size_t size)
+{
+    //Grow an array geometrically
+    if(count <= *capacity)
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    int newCapacity = max(count, *capacity * 2);
+    void *newBuf = SDL_realloc(*buf, newCapacity * size);
+    
+    if(!newBuf)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybPhysics] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    *buf = newBuf;
+    *capacity = newCapacity;
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_ReserveBodies(Cyb_PhysicsWorld *world, int count)
+{
+    if(count <= world->bodyCapacity)
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    //Grow every per body array to the same capacity
+    void **arrays[] = {
+        (void**)&world->shapes, (void**)&world->positions,
+        (void**)&world->rotations, (void**)&world->linVels,
+        (void**)&world->angVels, (void**)&world->pseudoLinVels,
+        (void**)&world->pseudoAngVels, (void**)&world->invMasses,
+        (void**)&world->invInertias, (void**)&world->worldInvInertias,
+        (void**)&world->frictions, (void**)&world->restitutions,
+        (void**)&world->sleepTimes, (void**)&world->asleep,
+        (void**)&world->bounds, (void**)&world->islands,
+        (void**)&world->parents, (void**)&world->islandIds,
+        (void**)&world->islandBodies
+    };
+    size_t sizes[] = {
+        sizeof(Cyb_Shape), sizeof(Cyb_Vec3), sizeof(Cyb_Vec4),
+        sizeof(Cyb_Vec3), sizeof(Cyb_Vec3), sizeof(Cyb_Vec3),
+        sizeof(Cyb_Vec3), sizeof(float), sizeof(Cyb_Vec3),
+        sizeof(Cyb_Mat3), sizeof(float), sizeof(float), sizeof(float),
+        sizeof(unsigned char), sizeof(Cyb_Box), sizeof(Cyb_Island),
+        sizeof(int), sizeof(int), sizeof(int)
+    };
+    int capacity = max(count, world->bodyCapacity * 2);
+    
+    for(int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        void *buf = SDL_realloc(*arrays[i], capacity * sizes[i]);
+        
+        if(!buf)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybPhysics] Out of Memory");
+            return CYB_ERROR;
+        }
+        
+        *arrays[i] = buf;
+    }
+    
+    world->bodyCapacity = capacity;
+    return CYB_NO_ERROR;
+}
+
+
+static void Cyb_UpdateInertia(Cyb_PhysicsWorld *world, int id)
+{
+    //I^-1 = R * diag(I^-1) * R^T
+    Cyb_Mat4 m;
+    Cyb_QuatToMatrix(&m, &world->rotations[id]);
+    Cyb_Vec3 r[3] = {
+        {m.a, m.b, m.c},
+        {m.e, m.f, m.g},
+        {m.i, m.j, m.k}
+    };
+    Cyb_Vec3 inv = world->invInertias[id];
+    Cyb_Mat3 *out = &world->worldInvInertias[id];
+    
+    for(int i = 0; i < 3; i++)
+    {
+        Cyb_Vec3 ri = Cyb_V3(r[i].x * inv.x, r[i].y * inv.y, r[i].z * inv.z);
+        out->rows[i] = Cyb_V3(Cyb_V3Dot(ri, r[0]), Cyb_V3Dot(ri, r[1]),
+            Cyb_V3Dot(ri, r[2]));
+    }
+}
+
+
+static Cyb_Vec3 Cyb_RelativeVel(const Cyb_Vec3 *linVels,
+    const Cyb_Vec3 *angVels, int a, int b, Cyb_Vec3 rA, Cyb_Vec3 rB)
+{
+    Cyb_Vec3 vA = Cyb_V3Add(linVels[a], Cyb_V3Cross(angVels[a], rA));
+    Cyb_Vec3 vB = Cyb_V3Add(linVels[b], Cyb_V3Cross(angVels[b], rB));
+    return Cyb_V3Sub(vB, vA);
+}
+
+
+static void Cyb_ApplyImpulsePair(Cyb_PhysicsWorld *world, Cyb_Vec3 *linVels,
+    Cyb_Vec3 *angVels, int a, int b, Cyb_Vec3 rA, Cyb_Vec3 rB, Cyb_Vec3 p)
+{
+    //Static bodies are shared between islands, so they are never written
+    if(world->invMasses[a] > 0.0f)
+    {
+        linVels[a] = Cyb_V3MulAdd(linVels[a], p, -world->invMasses[a]);
+        angVels[a] = Cyb_V3Sub(angVels[a], Cyb_Mat3MulVec(
+            &world->worldInvInertias[a], Cyb_V3Cross(rA, p)));
+    }
+    
+    if(world->invMasses[b] > 0.0f)
+    {
+        linVels[b] = Cyb_V3MulAdd(linVels[b], p, world->invMasses[b]);
+        angVels[b] = Cyb_V3Add(angVels[b], Cyb_Mat3MulVec(
+            &world->worldInvInertias[b], Cyb_V3Cross(rB, p)));
+    }
+}
+
+
+static float Cyb_EffectiveMass(const Cyb_PhysicsWorld *world, int a, int b,
+    Cyb_Vec3 rA, Cyb_Vec3 rB, Cyb_Vec3 dir)
+{
+    Cyb_Vec3 ca = Cyb_V3Cross(rA, dir);
+    Cyb_Vec3 cb = Cyb_V3Cross(rB, dir);
+    float k = world->invMasses[a] + world->invMasses[b] +
+        Cyb_V3Dot(ca, Cyb_Mat3MulVec(&world->worldInvInertias[a], ca)) +
+        Cyb_V3Dot(cb, Cyb_Mat3MulVec(&world->worldInvInertias[b], cb));
+    return (k > 0.0f ? 1.0f / k : 0.0f);
+}
+
+
+static unsigned int Cyb_HashPair(int a, int b)
+{
+    return (unsigned int)a * 2654435761u ^ (unsigned int)b * 40503u;
+}
+
+
+static const Cyb_Manifold *Cyb_FindOldManifold(const Cyb_PhysicsWorld *world,
+    int a, int b)
+{
+    if(!world->oldManifoldCount)
+    {
+        return NULL;
+    }
+    
+    int mask = world->hashCapacity - 1;
+    
+    for(int i = Cyb_HashPair(a, b) & mask; world->hash[i] >= 0;
+        i = (i + 1) & mask)
+    {
+        const Cyb_Manifold *m = &world->oldManifolds[world->hash[i]];
+        
+        if(m->a == a && m->b == b)
+        {
+            return m;
+        }
+    }
+    
+    return NULL;
+}
+
+
+static int Cyb_BuildManifoldHash(Cyb_PhysicsWorld *world)
+{
+    //Index last step's manifolds by body pair for warm starting
+    int capacity = 16;
+    
+    while(capacity < world->oldManifoldCount * 2)
+    {
+        capacity *= 2;
+    }
+    
+    if(capacity > world->hashCapacity)
+    {
+        int *hash = (int*)SDL_realloc(world->hash, capacity * sizeof(int));
+        
+        if(!hash)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybPhysics] Out of Memory");
+            return CYB_ERROR;
+        }
+        
+        world->hash = hash;
+        world->hashCapacity = capacity;
+    }
+    
+    int mask = world->hashCapacity - 1;
+    memset(world->hash, 0xff, world->hashCapacity * sizeof(int));
+    
+    for(int i = 0; i < world->oldManifoldCount; i++)
+    {
+        const Cyb_Manifold *m = &world->oldManifolds[i];
+        int j = Cyb_HashPair(m->a, m->b) & mask;
+        
+        while(world->hash[j] >= 0)
+        {
+            j = (j + 1) & mask;
+        }
+        
+        world->hash[j] = i;
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+static void Cyb_CollideJob(void *data, int index)
+{
+    Cyb_PhysicsWorld *world = (Cyb_PhysicsWorld*)data;
+    int start = index * CYB_PAIRS_PER_JOB;
+    int end = min(start + CYB_PAIRS_PER_JOB, world->pairCount);
+    
+    for(int i = start; i < end; i++)
+    {
+        Cyb_Manifold *m = &world->manifolds[i];
+        int a = world->pairs[i].a;
+        int b = world->pairs[i].b;
+        m->a = a;
+        m->b = b;
+        m->pointCount = 0;
+        
+        //Pairs without an awake dynamic body don't need contacts
+        if(!Cyb_IsBodyAwake(world, a) && !Cyb_IsBodyAwake(world, b))
+        {
+            continue;
+        }
+        
+        Cyb_Contact contacts[CYB_MAX_CONTACTS];
+        int count = Cyb_CollideShapes(&world->shapes[a], &world->positions[a],
+            &world->rotations[a], &world->shapes[b], &world->positions[b],
+            &world->rotations[b], CYB_CONTACT_MARGIN, contacts);
+        
+        if(!count)
+        {
+            continue;
+        }
+        
+        m->friction = sqrtf(world->frictions[a] * world->frictions[b]);
+        m->restitution = max(world->restitutions[a], world->restitutions[b]);
+        m->pointCount = min(count, CYB_MANIFOLD_POINTS);
+        const Cyb_Manifold *old = Cyb_FindOldManifold(world, a, b);
+        
+        for(int j = 0; j < m->pointCount; j++)
+        {
+            Cyb_ContactPoint *p = &m->points[j];
+            p->point = contacts[j].point;
+            p->normal = contacts[j].normal;
+            p->depth = contacts[j].depth;
+            p->localA = Cyb_RotateByQuat(&world->rotations[a],
+                Cyb_V3Sub(p->point, world->positions[a]), TRUE);
+            p->normalImpulse = 0.0f;
+            p->tangentImpulse[0] = 0.0f;
+            p->tangentImpulse[1] = 0.0f;
+            
+            /* Reuse the normal impulse of the matching contact from the last
+             * step. Friction is not cached, since its impulses are not unique
+             * and cached values make resting stacks sway.
+             */
+            if(!old)
+            {
+                continue;
+            }
+            
+            float best = CYB_WARM_START_DIST * CYB_WARM_START_DIST;
+            
+            for(int k = 0; k < old->pointCount; k++)
+            {
+                Cyb_Vec3 d = Cyb_V3Sub(old->points[k].localA, p->localA);
+                
+                if(Cyb_V3Dot(d, d) < best)
+                {
+                    best = Cyb_V3Dot(d, d);
+                    p->normalImpulse = old->points[k].normalImpulse;
+                }
+            }
+        }
+    }
+}
+
+
+static int Cyb_FindContacts(Cyb_PhysicsWorld *world)
+{
+    //Update the bounds of every body
+    for(int i = 0; i < world->bodyCount; i++)
+    {
+        Cyb_ShapeBounds(&world->bounds[i], &world->shapes[i],
+            &world->positions[i], &world->rotations[i]);
+        world->bounds[i].size.x += CYB_CONTACT_MARGIN;
+        world->bounds[i].size.y += CYB_CONTACT_MARGIN;
+        world->bounds[i].size.z += CYB_CONTACT_MARGIN;
+    }
+    
+    //Find the overlapping pairs
+    if(Cyb_UpdateSweepAndPrune(world->broadPhase, world->bounds,
+        world->bodyCount))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybPhysics] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    int pairCount = Cyb_FindSweepAndPrunePairs(world->broadPhase,
+        world->pairs, world->pairCapacity);
+    
+    if(pairCount > world->pairCapacity)
+    {
+        if(Cyb_Reserve((void**)&world->pairs, &world->pairCapacity, pairCount,
+            sizeof(Cyb_Pair)))
+        {
+            return CYB_ERROR;
+        }
+        
+        pairCount = Cyb_FindSweepAndPrunePairs(world->broadPhase,
+            world->pairs, world->pairCapacity);
+    }
+    
+    world->pairCount = pairCount;
+    
+    //Generate contacts for each pair in parallel
+    if(Cyb_Reserve((void**)&world->manifolds, &world->manifoldCapacity,
+        pairCount, sizeof(Cyb_Manifold)) || Cyb_BuildManifoldHash(world))
+    {
+        return CYB_ERROR;
+    }
+    
+    Cyb_RunJobs(world->jobs, &Cyb_CollideJob, world,
+        (pairCount + CYB_PAIRS_PER_JOB - 1) / CYB_PAIRS_PER_JOB);
+    
+    //Remove the pairs without contacts
+    int count = 0;
+    
+    for(int i = 0; i < pairCount; i++)
+    {
+        if(world->manifolds[i].pointCount)
+        {
+            if(i != count)
+            {
+                world->manifolds[count] = world->manifolds[i];
+            }
+            
+            count++;
+        }
+    }
+    
+    world->manifoldCount = count;
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_FindRoot(int *parents, int i)
+{
+    while(parents[i] != i)
+    {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+    }
+    
+    return i;
+}
+
+
+static int Cyb_CompareIslands(const void *a, const void *b)
+{
+    //Largest islands first so that the small ones fill the gaps at the end
+    const Cyb_Island *ia = (const Cyb_Island*)a;
+    const Cyb_Island *ib = (const Cyb_Island*)b;
+    
+    if(ia->bodyCount != ib->bodyCount)
+    {
+        return ib->bodyCount - ia->bodyCount;
+    }
+    
+    return ia->bodyStart - ib->bodyStart;
+}
+
+
+static int Cyb_BuildIslands(Cyb_PhysicsWorld *world)
+{
+    int *parents = world->parents;
+    int *islandIds = world->islandIds;
+    Cyb_Island *islands = world->islands;
+    
+    //Join bodies which touch each other, ignoring static bodies
+    for(int i = 0; i < world->bodyCount; i++)
+    {
+        parents[i] = i;
+        islandIds[i] = -1;
+    }
+    
+    for(int i = 0; i < world->manifoldCount; i++)
+    {
+        int a = world->manifolds[i].a;
+        int b = world->manifolds[i].b;
+        
+        if(world->invMasses[a] > 0.0f && world->invMasses[b] > 0.0f)
+        {
+            int ra = Cyb_FindRoot(parents, a);
+            int rb = Cyb_FindRoot(parents, b);
+            
+            if(ra != rb)
+            {
+                parents[max(ra, rb)] = min(ra, rb);
+            }
+        }
+    }
+    
+    //Create an island for each set of dynamic bodies
+    int islandCount = 0;
+    
+    for(int i = 0; i < world->bodyCount; i++)
+    {
+        if(world->invMasses[i] <= 0.0f)
+        {
+            continue;
+        }
+        
+        int root = Cyb_FindRoot(parents, i);
+        
+        if(islandIds[root] < 0)
+        {
+            Cyb_Island *island = &islands[islandCount];
+            island->bodyCount = 0;
+            island->manifoldCount = 0;
+            island->minSleepTime = FLT_MAX;
+            island->state = CYB_ISLAND_ASLEEP;
+            islandIds[root] = islandCount++;
+        }
+        
+        Cyb_Island *island = &islands[islandIds[root]];
+        islandIds[i] = islandIds[root];
+        island->bodyCount++;
+        island->minSleepTime = min(island->minSleepTime, world->sleepTimes[i]);
+        
+        if(!world->asleep[i])
+        {
+            island->state = CYB_ISLAND_AWAKE;
+        }
+    }
+    
+    /* An island with an awake body is solved unless all of its bodies have
+     * been resting long enough, in which case it falls asleep. Sleeping bodies
+     * touched by an awake body are woken up.
+     */
+    int bodyStart = 0;
+    
+    for(int i = 0; i < islandCount; i++)
+    {
+        Cyb_Island *island = &islands[i];
+        
+        if(island->state == CYB_ISLAND_AWAKE &&
+            island->minSleepTime >= CYB_TIME_TO_SLEEP)
+        {
+            island->state = CYB_ISLAND_SLEEPING;
+        }
+        
+        island->bodyStart = bodyStart;
+        
+        if(island->state == CYB_ISLAND_AWAKE)
+        {
+            bodyStart += island->bodyCount;
+        }
+        
+        island->bodyCount = 0;
+    }
+    
+    for(int i = 0; i < world->bodyCount; i++)
+    {
+        if(islandIds[i] < 0)
+        {
+            continue;
+        }
+        
+        Cyb_Island *island = &islands[islandIds[i]];
+        
+        if(island->state == CYB_ISLAND_SLEEPING)
+        {
+            world->asleep[i] = TRUE;
+            world->linVels[i] = Cyb_V3(0.0f, 0.0f, 0.0f);
+            world->angVels[i] = Cyb_V3(0.0f, 0.0f, 0.0f);
+        }
+        else if(island->state == CYB_ISLAND_AWAKE)
+        {
+            if(world->asleep[i])
+            {
+                world->asleep[i] = FALSE;
+                world->sleepTimes[i] = 0.0f;
+            }
+            
+            world->islandBodies[island->bodyStart + island->bodyCount++] = i;
+        }
+    }
+    
+    //Assign the contacts to the islands
+    if(Cyb_Reserve((void**)&world->islandManifolds,
+        &world->islandManifoldCapacity, world->manifoldCount, sizeof(int)))
+    {
+        return CYB_ERROR;
+    }
+    
+    for(int i = 0; i < world->manifoldCount; i++)
+    {
+        int a = world->manifolds[i].a;
+        int id = islandIds[world->invMasses[a] > 0.0f ? a :
+            world->manifolds[i].b];
+        islands[id].manifoldCount++;
+    }
+    
+    int manifoldStart = 0;
+    
+    for(int i = 0; i < islandCount; i++)
+    {
+        islands[i].manifoldStart = manifoldStart;
+        
+        if(islands[i].state == CYB_ISLAND_AWAKE)
+        {
+            manifoldStart += islands[i].manifoldCount;
+        }
+        
+        islands[i].manifoldCount = 0;
+    }
+    
+    for(int i = 0; i < world->manifoldCount; i++)
+    {
+        int a = world->manifolds[i].a;
+        Cyb_Island *island = &islands[islandIds[world->invMasses[a] > 0.0f ?
+            a : world->manifolds[i].b]];
+        
+        if(island->state == CYB_ISLAND_AWAKE)
+        {
+            world->islandManifolds[island->manifoldStart +
+                island->manifoldCount++] = i;
+        }
+    }
+    
+    //Keep only the islands which need solving
+    int awakeCount = 0;
+    
+    for(int i = 0; i < islandCount; i++)
+    {
+        if(islands[i].state == CYB_ISLAND_AWAKE)
+        {
+            islands[awakeCount++] = islands[i];
+        }
+    }
+    
+    SDL_qsort(islands, awakeCount, sizeof(Cyb_Island), &Cyb_CompareIslands);
+    world->islandCount = awakeCount;
+    return CYB_NO_ERROR;
+}
+
+
+static void Cyb_PrepareContacts(Cyb_PhysicsWorld *world, Cyb_Manifold *m)
+{
+    float dt = world->dt;
+    
+    for(int i = 0; i < m->pointCount; i++)
+    {
+        Cyb_ContactPoint *p = &m->points[i];
+        Cyb_Vec3 n = p->normal;
+        p->rA = Cyb_V3Sub(p->point, world->positions[m->a]);
+        p->rB = Cyb_V3Sub(p->point, world->positions[m->b]);
+        
+        //Build a tangent basis for friction
+        Cyb_Vec3 t = (fabsf(n.x) >= 0.57735f ? Cyb_V3(n.y, -n.x, 0.0f) :
+            Cyb_V3(0.0f, n.z, -n.y));
+        p->tangents[0] = Cyb_V3Scale(t, 1.0f / sqrtf(Cyb_V3Dot(t, t)));
+        p->tangents[1] = Cyb_V3Cross(n, p->tangents[0]);
+        
+        //Calculate the effective masses
+        p->normalMass = Cyb_EffectiveMass(world, m->a, m->b, p->rA, p->rB, n);
+        p->tangentMass[0] = Cyb_EffectiveMass(world, m->a, m->b, p->rA, p->rB,
+            p->tangents[0]);
+        p->tangentMass[1] = Cyb_EffectiveMass(world, m->a, m->b, p->rA, p->rB,
+            p->tangents[1]);
+        
+        /* Separated bodies may close the gap in one step. Overlapping bodies
+         * are pushed apart separately so that the correction does not add
+         * momentum.
+         */
+        p->bias = min(p->depth / dt, 0.0f);
+        p->positionBias = max(p->depth - CYB_PENETRATION_SLOP, 0.0f) *
+            CYB_BAUMGARTE / dt;
+        p->positionImpulse = 0.0f;
+        float vn = Cyb_V3Dot(Cyb_RelativeVel(world->linVels, world->angVels,
+            m->a, m->b, p->rA, p->rB), n);
+        
+        if(vn < -CYB_BOUNCE_THRESHOLD)
+        {
+            p->bias = max(p->bias, -m->restitution * vn);
+        }
+        
+        //Apply the impulses from the last step
+        Cyb_Vec3 impulse = Cyb_V3Scale(n, p->normalImpulse);
+        impulse = Cyb_V3MulAdd(impulse, p->tangents[0], p->tangentImpulse[0]);
+        impulse = Cyb_V3MulAdd(impulse, p->tangents[1], p->tangentImpulse[1]);
+        Cyb_ApplyImpulsePair(world, world->linVels, world->angVels, m->a, m->b,
+            p->rA, p->rB, impulse);
+    }
+}
+
+
+static void Cyb_SolveContacts(Cyb_PhysicsWorld *world, Cyb_Manifold *m)
+{
+    Cyb_Vec3 *linVels = world->linVels;
+    Cyb_Vec3 *angVels = world->angVels;
+    
+    for(int i = 0; i < m->pointCount; i++)
+    {
+        Cyb_ContactPoint *p = &m->points[i];
+        
+        //Friction is limited by the normal impulse
+        float maxFriction = m->friction * p->normalImpulse;
+        
+        for(int j = 0; j < 2; j++)
+        {
+            Cyb_Vec3 dv = Cyb_RelativeVel(linVels, angVels, m->a, m->b, p->rA,
+                p->rB);
+            float lambda = -p->tangentMass[j] * Cyb_V3Dot(dv, p->tangents[j]);
+            float old = p->tangentImpulse[j];
+            p->tangentImpulse[j] = SDL_max(-maxFriction,
+                SDL_min(old + lambda, maxFriction));
+            Cyb_ApplyImpulsePair(world, linVels, angVels, m->a, m->b, p->rA,
+                p->rB, Cyb_V3Scale(p->tangents[j], p->tangentImpulse[j] - old));
+        }
+        
+        //Contacts can only push
+        Cyb_Vec3 dv = Cyb_RelativeVel(linVels, angVels, m->a, m->b, p->rA,
+            p->rB);
+        float lambda = p->normalMass * (p->bias - Cyb_V3Dot(dv, p->normal));
+        float old = p->normalImpulse;
+        p->normalImpulse = SDL_max(old + lambda, 0.0f);
+        Cyb_ApplyImpulsePair(world, linVels, angVels, m->a, m->b, p->rA, p->rB,
+            Cyb_V3Scale(p->normal, p->normalImpulse - old));
+    }
+}
+
+
+static void Cyb_SolvePenetration(Cyb_PhysicsWorld *world, Cyb_Manifold *m)
+{
+    //Push overlapping bodies apart with pseudo velocities
+    Cyb_Vec3 *linVels = world->pseudoLinVels;
+    Cyb_Vec3 *angVels = world->pseudoAngVels;
+    
+    for(int i = 0; i < m->pointCount; i++)
+    {
+        Cyb_ContactPoint *p = &m->points[i];
+        Cyb_Vec3 dv = Cyb_RelativeVel(linVels, angVels, m->a, m->b, p->rA,
+            p->rB);
+        float lambda = p->normalMass * (p->positionBias -
+            Cyb_V3Dot(dv, p->normal));
+        float old = p->positionImpulse;
+        p->positionImpulse = SDL_max(old + lambda, 0.0f);
+        Cyb_ApplyImpulsePair(world, linVels, angVels, m->a, m->b, p->rA, p->rB,
+            Cyb_V3Scale(p->normal, p->positionImpulse - old));
+    }
+}
+
+
+static void Cyb_SolveIslandJob(void *data, int index)
+{
+    Cyb_PhysicsWorld *world = (Cyb_PhysicsWorld*)data;
+    const Cyb_Island *island = &world->islands[index];
+    const int *bodies = world->islandBodies + island->bodyStart;
+    const int *manifolds = world->islandManifolds + island->manifoldStart;
+    float dt = world->dt;
+    float linDamping = 1.0f / (1.0f + dt * CYB_LINEAR_DAMPING);
+    float angDamping = 1.0f / (1.0f + dt * CYB_ANGULAR_DAMPING);
+    
+    //Apply gravity and damping
+    for(int i = 0; i < island->bodyCount; i++)
+    {
+        int id = bodies[i];
+        world->linVels[id] = Cyb_V3Scale(Cyb_V3MulAdd(world->linVels[id],
+            world->gravity, dt), linDamping);
+        world->angVels[id] = Cyb_V3Scale(world->angVels[id], angDamping);
+        world->pseudoLinVels[id] = Cyb_V3(0.0f, 0.0f, 0.0f);
+        world->pseudoAngVels[id] = Cyb_V3(0.0f, 0.0f, 0.0f);
+        Cyb_UpdateInertia(world, id);
+    }
+    
+    //Solve the contacts
+    for(int i = 0; i < island->manifoldCount; i++)
+    {
+        Cyb_PrepareContacts(world, &world->manifolds[manifolds[i]]);
+    }
+    
+    for(int i = 0; i < world->iterations; i++)
+    {
+        for(int j = 0; j < island->manifoldCount; j++)
+        {
+            Cyb_SolveContacts(world, &world->manifolds[manifolds[j]]);
+        }
+    }
+    
+    for(int i = 0; i < CYB_POSITION_ITERATIONS; i++)
+    {
+        for(int j = 0; j < island->manifoldCount; j++)
+        {
+            Cyb_SolvePenetration(world, &world->manifolds[manifolds[j]]);
+        }
+    }
+    
+    //Integrate the velocities and update the sleep timers
+    for(int i = 0; i < island->bodyCount; i++)
+    {
+        int id = bodies[i];
+        Cyb_Vec3 v = world->linVels[id];
+        Cyb_Vec3 w = Cyb_V3Add(world->angVels[id], world->pseudoAngVels[id]);
+        Cyb_Vec4 *q = &world->rotations[id];
+        world->positions[id] = Cyb_V3MulAdd(world->positions[id],
+            Cyb_V3Add(v, world->pseudoLinVels[id]), dt);
+        
+        //q' = q + dt / 2 * (w, 0) * q
+        float h = dt * 0.5f;
+        Cyb_Vec4 r;
+        r.x = q->x + h * (w.x * q->w + w.y * q->z - w.z * q->y);
+        r.y = q->y + h * (w.y * q->w + w.z * q->x - w.x * q->z);
+        r.z = q->z + h * (w.z * q->w + w.x * q->y - w.y * q->x);
+        r.w = q->w - h * (w.x * q->x + w.y * q->y + w.z * q->z);
+        float len = sqrtf(r.x * r.x + r.y * r.y + r.z * r.z + r.w * r.w);
+        q->x = r.x / len;
+        q->y = r.y / len;
+        q->z = r.z / len;
+        q->w = r.w / len;
+        
+        if(Cyb_V3Dot(v, v) > CYB_SLEEP_LINEAR_VEL * CYB_SLEEP_LINEAR_VEL ||
+            Cyb_V3Dot(world->angVels[id], world->angVels[id]) >
+            CYB_SLEEP_ANGULAR_VEL * CYB_SLEEP_ANGULAR_VEL)
+        {
+            world->sleepTimes[id] = 0.0f;
+        }
+        else
+        {
+            world->sleepTimes[id] += dt;
+        }
+    }
+}
+
+
+void Cyb_FreePhysicsWorld(Cyb_PhysicsWorld *world)
+{
+    //Free the body arrays
+    SDL_free(world->shapes);
+    SDL_free(world->positions);
+    SDL_free(world->rotations);
+    SDL_free(world->linVels);
+    SDL_free(world->angVels);
+    SDL_free(world->pseudoLinVels);
+    SDL_free(world->pseudoAngVels);
+    SDL_free(world->invMasses);
+    SDL_free(world->invInertias);
+    SDL_free(world->worldInvInertias);
+    SDL_free(world->frictions);
+    SDL_free(world->restitutions);
+    SDL_free(world->sleepTimes);
+    SDL_free(world->asleep);
+    SDL_free(world->bounds);
+    
+    //Free the broad phase, contacts, and islands
+    Cyb_FreeSweepAndPrune(world->broadPhase);
+    SDL_free(world->pairs);
+    SDL_free(world->manifolds);
+    SDL_free(world->oldManifolds);
+    SDL_free(world->hash);
+    SDL_free(world->islands);
+    SDL_free(world->parents);
+    SDL_free(world->islandIds);
+    SDL_free(world->islandBodies);
+    SDL_free(world->islandManifolds);
+}
+
+
+Cyb_PhysicsWorld *Cyb_CreatePhysicsWorld(Cyb_JobSystem *jobs)
+{
+    //Allocate new physics world
+    Cyb_PhysicsWorld *world = (Cyb_PhysicsWorld*)Cyb_CreateObject(
+        sizeof(Cyb_PhysicsWorld), (Cyb_FreeProc)&Cyb_FreePhysicsWorld,
+        CYB_PHYSICSWORLD);
+    
+    if(!world)
+    {
+        return NULL;
+    }
+    
+    //Initialize the physics world
+    memset((char*)world + sizeof(Cyb_Object), 0,
+        sizeof(Cyb_PhysicsWorld) - sizeof(Cyb_Object));
+    world->jobs = jobs;
+    world->gravity = Cyb_V3(0.0f, -9.81f, 0.0f);
+    world->iterations = 10;
+    world->broadPhase = Cyb_CreateSweepAndPrune();
+    
+    if(!world->broadPhase)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybPhysics] Out of Memory");
+        Cyb_FreeObject((Cyb_Object**)&world);
+        return NULL;
+    }
+    
+    return world;
+}
+
+
+void Cyb_SetPhysicsGravity(Cyb_PhysicsWorld *world, float x, float y,
+    float z)
+{
+    world->gravity = Cyb_V3(x, y, z);
+}
+
+
+void Cyb_SetPhysicsIterations(Cyb_PhysicsWorld *world, int iterations)
+{
+    world->iterations = max(iterations, 1);
+}
+
+
+int Cyb_AddRigidBody(Cyb_PhysicsWorld *world, const Cyb_BodyDesc *desc)
+{
+    //Make room for the body
+    if(Cyb_ReserveBodies(world, world->bodyCount + 1))
+    {
+        return -1;
+    }
+    
+    int id = world->bodyCount++;
+    world->shapes[id] = desc->shape;
+    world->positions[id] = desc->pos;
+    world->rotations[id] = desc->rot;
+    world->linVels[id] = desc->linVel;
+    world->angVels[id] = desc->angVel;
+    world->pseudoLinVels[id] = Cyb_V3(0.0f, 0.0f, 0.0f);
+    world->pseudoAngVels[id] = Cyb_V3(0.0f, 0.0f, 0.0f);
+    world->frictions[id] = desc->friction;
+    world->restitutions[id] = desc->restitution;
+    world->sleepTimes[id] = 0.0f;
+    world->asleep[id] = FALSE;
+    
+    //Calculate the inverse mass and inverse inertia
+    float m = desc->mass;
+    float r = desc->shape.size.x;
+    Cyb_Vec3 inertia;
+    
+    switch(desc->shape.type)
+    {
+    case CYB_SHAPE_BOX:
+    {
+        Cyb_Vec3 h = desc->shape.size;
+        inertia.x = m / 3.0f * (h.y * h.y + h.z * h.z);
+        inertia.y = m / 3.0f * (h.x * h.x + h.z * h.z);
+        inertia.z = m / 3.0f * (h.x * h.x + h.y * h.y);
+        break;
+    }
+    
+    case CYB_SHAPE_CAPSULE:
+    {
+        //Split the mass between the cylinder and the 2 caps by volume
+        float len = desc->shape.size.y * 2.0f;
+        float cylVol = len * r * r;
+        float capVol = 4.0f / 3.0f * r * r * r;
+        float mc = m * cylVol / (cylVol + capVol);
+        float ms = m - mc;
+        inertia.y = mc * r * r * 0.5f + ms * r * r * 0.4f;
+        inertia.x = inertia.z = mc * (r * r * 0.25f + len * len / 12.0f) +
+            ms * (r * r * 0.4f + len * len * 0.25f + len * r * 0.375f);
+        break;
+    }
+    
+    default:
+        inertia.x = inertia.y = inertia.z = m * r * r * 0.4f;
+        break;
+    }
+    
+    if(m > 0.0f)
+    {
+        world->invMasses[id] = 1.0f / m;
+        world->invInertias[id] = Cyb_V3(1.0f / inertia.x, 1.0f / inertia.y,
+            1.0f / inertia.z);
+    }
+    else
+    {
+        //Static bodies never move
+        world->invMasses[id] = 0.0f;
+        world->invInertias[id] = Cyb_V3(0.0f, 0.0f, 0.0f);
+        world->linVels[id] = Cyb_V3(0.0f, 0.0f, 0.0f);
+        world->angVels[id] = Cyb_V3(0.0f, 0.0f, 0.0f);
+        world->asleep[id] = TRUE;
+    }
+    
+    Cyb_UpdateInertia(world, id);
+    return id;
+}
+
+
+int Cyb_GetBodyCount(Cyb_PhysicsWorld *world)
+{
+    return world->bodyCount;
+}
+
+
+void Cyb_SetBodyPos(Cyb_PhysicsWorld *world, int id, const Cyb_Vec3 *pos)
+{
+    world->positions[id] = *pos;
+    Cyb_WakeBody(world, id);
+}
+
+
+const Cyb_Vec3 *Cyb_GetBodyPos(Cyb_PhysicsWorld *world, int id)
+{
+    return &world->positions[id];
+}
+
+
+void Cyb_SetBodyRot(Cyb_PhysicsWorld *world, int id, const Cyb_Vec4 *rot)
+{
+    world->rotations[id] = *rot;
+    Cyb_UpdateInertia(world, id);
+    Cyb_WakeBody(world, id);
+}
+
+
+const Cyb_Vec4 *Cyb_GetBodyRot(Cyb_PhysicsWorld *world, int id)
+{
+    return &world->rotations[id];
+}
+
+
+void Cyb_GetBodyTransform(Cyb_PhysicsWorld *world, int id, Cyb_Mat4 *mat)
+{
+    Cyb_QuatToMatrix(mat, &world->rotations[id]);
+    mat->d = world->positions[id].x;
+    mat->h = world->positions[id].y;
+    mat->l = world->positions[id].z;
+}
+
+
+void Cyb_SetBodyVel(Cyb_PhysicsWorld *world, int id, const Cyb_Vec3 *linVel,
+    const Cyb_Vec3 *angVel)
+{
+    if(world->invMasses[id] <= 0.0f)
+    {
+        return;
+    }
+    
+    world->linVels[id] = *linVel;
+    world->angVels[id] = *angVel;
+    Cyb_WakeBody(world, id);
+}
+
+
+void Cyb_GetBodyVel(Cyb_PhysicsWorld *world, int id, Cyb_Vec3 *linVel,
+    Cyb_Vec3 *angVel)
+{
+    *linVel = world->linVels[id];
+    *angVel = world->angVels[id];
+}
+
+
+void Cyb_ApplyBodyImpulse(Cyb_PhysicsWorld *world, int id,
+    const Cyb_Vec3 *impulse, const Cyb_Vec3 *point)
+{
+    if(world->invMasses[id] <= 0.0f)
+    {
+        return;
+    }
+    
+    Cyb_Vec3 r = Cyb_V3Sub(*point, world->positions[id]);
+    world->linVels[id] = Cyb_V3MulAdd(world->linVels[id], *impulse,
+        world->invMasses[id]);
+    world->angVels[id] = Cyb_V3Add(world->angVels[id], Cyb_Mat3MulVec(
+        &world->worldInvInertias[id], Cyb_V3Cross(r, *impulse)));
+    Cyb_WakeBody(world, id);
+}
+
+
+int Cyb_IsBodyAsleep(Cyb_PhysicsWorld *world, int id)
+{
+    return world->asleep[id];
+}
+
+
+void Cyb_WakeBody(Cyb_PhysicsWorld *world, int id)
+{
+    if(world->invMasses[id] > 0.0f)
+    {
+        world->asleep[id] = FALSE;
+        world->sleepTimes[id] = 0.0f;
+    }
+}
+
+
+void Cyb_StepPhysicsWorld(Cyb_PhysicsWorld *world, float dt)
+{
+    if(dt <= 0.0f)
+    {
+        return;
+    }
+    
+    //Generate contacts and group the bodies into islands
+    world->dt = dt;
+    
+    if(Cyb_FindContacts(world) || Cyb_BuildIslands(world))
+    {
+        return;
+    }
+    
+    //Solve the islands in parallel
+    Cyb_RunJobs(world->jobs, &Cyb_SolveIslandJob, world, world->islandCount);
+    
+    //Update the statistics
+    world->stats.bodyCount = world->bodyCount;
+    world->stats.awakeCount = 0;
+    world->stats.pairCount = world->pairCount;
+    world->stats.contactCount = 0;
+    world->stats.islandCount = world->islandCount;
+    
+    for(int i = 0; i < world->bodyCount; i++)
+    {
+        world->stats.awakeCount += Cyb_IsBodyAwake(world, i);
+    }
+    
+    for(int i = 0; i < world->manifoldCount; i++)
+    {
+        world->stats.contactCount += world->manifolds[i].pointCount;
+    }
+    
+    //Keep the contacts for warm starting the next step
+    Cyb_Manifold *manifolds = world->manifolds;
+    int capacity = world->manifoldCapacity;
+    world->manifolds = world->oldManifolds;
+    world->manifoldCapacity = world->oldManifoldCapacity;
+    world->oldManifolds = manifolds;
+    world->oldManifoldCapacity = capacity;
+    world->oldManifoldCount = world->manifoldCount;
+    world->manifoldCount = 0;
+}
+
+
+void Cyb_GetPhysicsStats(Cyb_PhysicsWorld *world, Cyb_PhysicsStats *stats)
+{
+    *stats = world->stats;
+}
\ No newline at end of file
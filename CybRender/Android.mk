@@ -19,10 +19,13 @@ LOCAL_SRC_FILES := \
     src/CybLight.c \
     src/CybMaterial.c \
     src/CybMesh.c \
+    src/CybMeshOptimizer.c \
     src/CybRenderer.c \
+    src/CybRenderQueue.c \
     src/CybShader.c \
     src/CybTexture.c \
     src/CybTimer.c
+LOCAL_CFLAGS := -DCYB_MATH_INLINE
 LOCAL_LDFLAGS += \
     -LC:/android-sdk/ndk/19.2.5345600/toolchains/llvm/prebuilt/windows/lib/gcc/arm-linux-androideabi/4.9.x/armv7-a \
     -LC:/android-sdk/ndk/19.2.5345600/toolchains/llvm/prebuilt/windows/arm-linux-androideabi/lib/armv7-a \
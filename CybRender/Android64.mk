@@ -19,10 +19,13 @@ LOCAL_SRC_FILES := \
     src/CybLight.c \
     src/CybMaterial.c \
     src/CybMesh.c \
+    src/CybMeshOptimizer.c \
     src/CybRenderer.c \
+    src/CybRenderQueue.c \
     src/CybShader.c \
     src/CybTexture.c \
     src/CybTimer.c
+LOCAL_CFLAGS := -DCYB_MATH_INLINE
 LOCAL_LDFLAGS += \
     -LC:/android-sdk/ndk/19.2.5345600/toolchains/llvm/prebuilt/windows/lib/gcc/aarch64-linux-android/4.9.x \
     -LC:/android-sdk/ndk/19.2.5345600/toolchains/llvm/prebuilt/windows/aarch64-linux-android/lib64 \
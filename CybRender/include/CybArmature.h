@@ -93,14 +93,28 @@ CYBAPI int Cyb_GetBoneID(Cyb_Pose *pose, const char *name);
 CYBAPI void Cyb_UpdateBone(Cyb_Pose *pose, int boneID, const Cyb_Mat4 *matrix);
 
 /** @brief Select the pose to use when rendering a mesh.
+ *
+ * The armature of the pose is used by every mesh drawn until another pose is
+ * selected.
  *
  * @param renderer Pointer to the renderer.
  * @param shader Pointer to the shader.
- * @param pose Pointer to the pose.
+ * @param pose Pointer to the pose or NULL to draw meshes without an armature.
  */
 CYBAPI void Cyb_SelectPose(Cyb_Renderer *renderer, Cyb_Shader *shader, 
     Cyb_Pose *pose);
     
+
+/** @brief Setup the vertex group and weight attribs of an armature.
+ *
+ * Applies to the bound vertex array object. Used by Cyb_DrawMeshes.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param armature Pointer to the armature or NULL to disable the attribs.
+ */
+CYBAPI void Cyb_SetupArmatureAttribs(Cyb_Renderer *renderer, 
+    Cyb_Armature *armature);
+    
 /**
  * @}
  */
@@ -11,6 +11,8 @@
 
 #define Cyb_DrawMesh(renderer, mesh) Cyb_DrawMeshes(renderer, mesh, 1)
 
+#define CYB_MAX_MESH_LODS 8
+
  
 #ifdef __cplusplus
 extern "C" {
@@ -24,6 +26,8 @@ extern "C" {
 //Enums
 //=================================================================================
 /** @brief Vertex attribute indices.
+ *
+ * The instance matrices are mat4 attributes and take up 4 indices each.
  */
 enum Cyb_VertexAttribs
 {
@@ -35,7 +39,7 @@ enum Cyb_VertexAttribs
     CYB_ATTRIB_GROUP,              /**< Vertex group attrib. */
     CYB_ATTRIB_WEIGHT,             /**< Vertex weight attrib. */
     CYB_ATTRIB_INSTANCE_MAT_MODEL, /**< Instance model matrix. */
-    CYB_ATTRIB_INSTANCE_MAT_NORM   /**< Instance normal matrix. */
+    CYB_ATTRIB_INSTANCE_MAT_NORM = CYB_ATTRIB_INSTANCE_MAT_MODEL + 4 /**< Instance normal matrix. */
 };
 
 
@@ -46,6 +50,11 @@ enum Cyb_VertexAttribs
 typedef struct Cyb_Mesh Cyb_Mesh;
 
 
+/** @brief Geometry arena object.
+ */
+typedef struct Cyb_GeometryArena Cyb_GeometryArena;
+
+
 //Structures
 //=================================================================================
 /** @brief Vertex.
@@ -115,6 +124,87 @@ enum Cyb_VertexType
 };
 
 
+/** @brief Buffer usage hints.
+ */
+enum Cyb_BufferUsage
+{
+    CYB_BUFFER_STATIC,  /**< Geometry is set once and drawn many times. */
+    CYB_BUFFER_DYNAMIC, /**< Geometry is changed now and then. */
+    CYB_BUFFER_STREAM   /**< Geometry is rewritten about once per frame. */
+};
+
+
+/** @brief Vertex attrib packing.
+ */
+enum Cyb_VertexPacking
+{
+    CYB_PACK_FLOAT,          /**< 32-bit floats. */
+    CYB_PACK_HALF,           /**< 16-bit floats. */
+    CYB_PACK_SNORM16,        /**< Signed normalized 16-bit integers. */
+    CYB_PACK_UNORM8,         /**< Unsigned normalized 8-bit integers. */
+    CYB_PACK_SNORM10_10_10_2 /**< Signed normalized 10:10:10:2 integers packed into 32 bits. */
+};
+
+
+//Structures
+//=================================================================================
+/** @brief Vertex layout.
+ *
+ * Selects the packing of each kind of vertex data. Positions may use 
+ * CYB_PACK_FLOAT, CYB_PACK_HALF, or CYB_PACK_SNORM16. Normals and tangents may
+ * use CYB_PACK_FLOAT, CYB_PACK_HALF, CYB_PACK_SNORM16, or 
+ * CYB_PACK_SNORM10_10_10_2. Colors may use CYB_PACK_FLOAT, CYB_PACK_HALF, or 
+ * CYB_PACK_UNORM8. Uvs may use CYB_PACK_FLOAT or CYB_PACK_HALF. Packings that
+ * are not allowed or not supported by the driver fall back to CYB_PACK_FLOAT.
+ *
+ * Positions packed as CYB_PACK_SNORM16 are scaled to the bounds of the mesh.
+ * The scale and offset are folded into the instance model matrices, so 
+ * shaders must transform positions with the "instanceM" attribute instead of
+ * a model matrix uniform, and skinned meshes should use CYB_PACK_HALF 
+ * positions instead.
+ */
+typedef struct
+{
+    int pos;   /**< Packing of the vertex positions. */
+    int norm;  /**< Packing of the vertex normals and tangent vectors. */
+    int color; /**< Packing of the vertex colors. */
+    int uv;    /**< Packing of the vertex texture coordinates. */
+} Cyb_VertexLayout;
+
+
+/** @brief Interleaved vertex data descriptor.
+ *
+ * Each vertex holds its position, normal, tangent vector, color, and texture
+ * coordinate in that order. Normals and tangent vectors are present in every
+ * vertex type except CYB_VERTEX_V and colors and texture coordinates depend 
+ * on the vertex type. Each attrib starts on a 4 byte boundary. With 32-bit 
+ * floats the vertices match Cyb_VertexV to Cyb_VertexVNCT. Packings that are
+ * not allowed by Cyb_VertexLayout are invalid.
+ */
+typedef struct
+{
+    int vFormat;             /**< The vertex type (see Cyb_VertexType). */
+    Cyb_VertexLayout layout; /**< The packing of each kind of vertex data. */
+    Cyb_Vec3 posCenter;      /**< The center of CYB_PACK_SNORM16 positions. */
+    float posScale;          /**< The scale of CYB_PACK_SNORM16 positions. */
+} Cyb_VertexDesc;
+
+
+/** @brief Mesh level of detail.
+ *
+ * Each level is a range of the indices of the mesh and shares the vertices
+ * of the mesh with the other levels. A level is drawn while the screen size
+ * of the mesh (see Cyb_GetLODScreenSize) is at least its minimum size. The 
+ * last level is drawn below that.
+ */
+typedef struct
+{
+    int firstIndex; /**< The first index of the level. */
+    int indexCount; /**< The number of indices of the level. */
+    float minSize;  /**< The smallest screen size the level is drawn at. */
+} Cyb_MeshLOD;
+
+
 //Functions
 //=================================================================================
 /** @brief Create a new mesh.
@@ -126,6 +216,9 @@ enum Cyb_VertexType
 CYBAPI Cyb_Mesh *Cyb_CreateMesh(Cyb_Renderer *renderer);
 
 /** @brief Update mesh data.
+ *
+ * Meshes with fewer than 65536 vertices store their indices as 16-bit 
+ * integers.
  *
  * @param renderer Pointer to the renderer.
  * @param mesh Pointer to the mesh.
@@ -145,7 +238,223 @@ CYBAPI int Cyb_UpdateMesh(Cyb_Renderer *renderer, Cyb_Mesh *mesh, int vertCount,
     const Cyb_Vec4 *colors, const Cyb_Vec2 *uvs, int indexCount, 
     const unsigned int *indices);
     
+/** @brief Update mesh data from interleaved vertex data.
+ *
+ * The vertex data is uploaded as it is if the driver supports its packings
+ * and converted to supported packings otherwise. The vertex layout of the 
+ * mesh is not used or changed. Cyb_UpdateMeshRange takes data in separate 
+ * arrays as usual.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param mesh Pointer to the mesh.
+ * @param desc Pointer to the descriptor of the vertex data.
+ * @param vertCount The number of vertices.
+ * @param vertData The interleaved vertex data.
+ * @param indexCount The number of indices.
+ * @param indices The element indices.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_UpdateMeshInterleaved(Cyb_Renderer *renderer, Cyb_Mesh *mesh, 
+    const Cyb_VertexDesc *desc, int vertCount, const void *vertData, 
+    int indexCount, const unsigned int *indices);
+    
+/** @brief Get the size of one vertex of interleaved vertex data.
+ *
+ * @param desc Pointer to the descriptor of the vertex data.
+ *
+ * @return The size in bytes or 0 if the descriptor is invalid.
+ */
+CYBAPI int Cyb_GetVertexSize(const Cyb_VertexDesc *desc);
+
+/** @brief Interleave and pack vertex data.
+ *
+ * Works without a renderer so that tools can store meshes pre-interleaved. 
+ * The packings are taken from the layout of the descriptor and the vertex 
+ * type, the packings used, and the bounds of the positions are written back 
+ * to it.
+ *
+ * @param desc Pointer to the descriptor of the vertex data.
+ * @param vertCount The number of vertices.
+ * @param verts The vertex positions (required).
+ * @param norms The vertex normals (optional; required if colors or uvs are given).
+ * @param tangents The tangent vectors (optional).
+ * @param colors The vertex colors (optional).
+ * @param uvs The vertex texture coordinates (optional).
+ *
+ * @return The vertex data (free it with SDL_free) or NULL on failure.
+ */
+CYBAPI void *Cyb_InterleaveVertices(Cyb_VertexDesc *desc, int vertCount,
+    const Cyb_Vec3 *verts, const Cyb_Vec3 *norms, const Cyb_Vec3 *tangents, 
+    const Cyb_Vec4 *colors, const Cyb_Vec2 *uvs);
+
+/** @brief Set how often the geometry of a mesh is expected to change.
+ *
+ * Takes effect at the next call to Cyb_UpdateMesh. Dynamic and streaming 
+ * meshes reuse their buffers and orphan them when they are rewritten instead 
+ * of waiting for the GPU to finish drawing the old geometry. Streaming meshes
+ * write their vertices into a ring of persistently mapped buffer segments 
+ * guarded by fences when the driver supports it.
+ *
+ * @param mesh Pointer to the mesh.
+ * @param usage The buffer usage hint (CYB_BUFFER_STATIC by default).
+ */
+CYBAPI void Cyb_SetMeshUsage(Cyb_Mesh *mesh, int usage);
+
+/** @brief Set the vertex layout of a mesh.
+ *
+ * Takes effect at the next call to Cyb_UpdateMesh.
+ *
+ * @param mesh Pointer to the mesh.
+ * @param layout Pointer to the vertex layout or NULL for 32-bit floats.
+ */
+CYBAPI void Cyb_SetMeshVertexLayout(Cyb_Mesh *mesh, 
+    const Cyb_VertexLayout *layout);
+
+/** @brief Create a new geometry arena.
+ *
+ * A geometry arena stores the geometry of many meshes in a few large buffers.
+ * Meshes with the same vertex format and index type share a pool of buffers
+ * and a VAO and are drawn from their own base vertex, so drawing one after
+ * another does not rebind any buffers. A new pool is created when the pools 
+ * of a format are full.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param vertCap The number of vertices per pool or 0 for the default.
+ * @param indexCap The number of indices per pool or 0 for the default.
+ *
+ * @return Pointer to the geometry arena.
+ */
+CYBAPI Cyb_GeometryArena *Cyb_CreateGeometryArena(Cyb_Renderer *renderer,
+    int vertCap, int indexCap);
+
+/** @brief Set the geometry arena of a mesh.
+ *
+ * Takes effect at the next call to Cyb_UpdateMesh or 
+ * Cyb_UpdateMeshInterleaved. The mesh keeps its own buffers if the driver 
+ * cannot draw with a base vertex. Updates which fit into the block of the
+ * mesh reuse it and return the rest of it to the arena.
+ *
+ * @param mesh Pointer to the mesh.
+ * @param arena Pointer to the geometry arena or NULL for buffers of its own.
+ */
+CYBAPI void Cyb_SetMeshArena(Cyb_Mesh *mesh, Cyb_GeometryArena *arena);
+
+/** @brief Defragment a geometry arena.
+ *
+ * Frees the pools which no longer hold any meshes and moves the blocks of the
+ * other pools together on the GPU, so the free space of each pool is in one 
+ * piece. This is best done at loading screens after many meshes were freed.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param arena Pointer to the geometry arena.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_DefragGeometryArena(Cyb_Renderer *renderer, 
+    Cyb_GeometryArena *arena);
+
+/** @brief Get the number of buffer pools of a geometry arena.
+ *
+ * @param arena Pointer to the geometry arena.
+ *
+ * @return The number of pools.
+ */
+CYBAPI int Cyb_GetGeometryArenaPoolCount(Cyb_GeometryArena *arena);
+
+/** @brief Update a range of the vertices of a mesh.
+ *
+ * The vertex count, the kinds of vertex data, and the vertex layout of the 
+ * last call to Cyb_UpdateMesh are kept. Positions packed as CYB_PACK_SNORM16
+ * are clamped to the bounds of that call. Streaming meshes with a ring buffer 
+ * write all of their vertices into the next segment.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param mesh Pointer to the mesh.
+ * @param firstVert The index of the first vertex to update.
+ * @param vertCount The number of vertices to update.
+ * @param verts The vertex positions (required).
+ * @param norms The vertex normals (required if the mesh has normals).
+ * @param tangents The tangent vectors (optional).
+ * @param colors The vertex colors (required if the mesh has colors).
+ * @param uvs The vertex texture coordinates (required if the mesh has uvs).
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_UpdateMeshRange(Cyb_Renderer *renderer, Cyb_Mesh *mesh, 
+    int firstVert, int vertCount, const Cyb_Vec3 *verts, const Cyb_Vec3 *norms,
+    const Cyb_Vec3 *tangents, const Cyb_Vec4 *colors, const Cyb_Vec2 *uvs);
+    
+/** @brief Set the per-instance matrices of a mesh.
+ *
+ * Shaders read them from the "instanceM" and "instanceN" mat4 attributes.
+ * The data is kept until it is replaced or removed.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param mesh Pointer to the mesh.
+ * @param count The number of instances (0 removes the instance data).
+ * @param models The model matrix of each instance.
+ * @param norms The normal matrix of each instance (optional; calculated from
+ * the model matrices if NULL).
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_SetInstanceData(Cyb_Renderer *renderer, Cyb_Mesh *mesh, 
+    int count, const Cyb_Mat4 *models, const Cyb_Mat4 *norms);
+    
+/** @brief Set the levels of detail of a mesh.
+ *
+ * The levels are ordered from the most to the least detailed. They are 
+ * removed by the next call to Cyb_UpdateMesh or Cyb_UpdateMeshInterleaved.
+ *
+ * @param mesh Pointer to the mesh.
+ * @param lodCount The number of levels (up to CYB_MAX_MESH_LODS) or 0 to 
+ * always draw all indices.
+ * @param lods The levels.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_SetMeshLODs(Cyb_Mesh *mesh, int lodCount, 
+    const Cyb_MeshLOD *lods);
+
+/** @brief Get the number of levels of detail of a mesh.
+ *
+ * @param mesh Pointer to the mesh.
+ *
+ * @return The number of levels.
+ */
+CYBAPI int Cyb_GetMeshLODCount(const Cyb_Mesh *mesh);
+
+/** @brief Get the level of detail a mesh would be drawn at.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param mesh Pointer to the mesh.
+ * @param model Pointer to the model matrix of the mesh or NULL.
+ *
+ * @return The level (0 if no LOD camera is set or the mesh has no levels).
+ */
+CYBAPI int Cyb_GetMeshLOD(Cyb_Renderer *renderer, const Cyb_Mesh *mesh,
+    const Cyb_Mat4 *model);
+
+/** @brief Get the bounding sphere of a mesh.
+ *
+ * The sphere is found by the last call to Cyb_UpdateMesh or 
+ * Cyb_UpdateMeshInterleaved and is not changed by Cyb_UpdateMeshRange.
+ *
+ * @param mesh Pointer to the mesh.
+ * @param sphere Pointer to the resulting sphere in mesh space.
+ */
+CYBAPI void Cyb_GetMeshBounds(const Cyb_Mesh *mesh, Cyb_Sphere *sphere);
+
 /** @brief Draw multiple instances of the same mesh.
+ *
+ * Uses hardware instancing when it is supported and otherwise draws the 
+ * instances one at a time. The count is limited to the number of instances 
+ * given to Cyb_SetInstanceData. Meshes without instance data use identity 
+ * instance matrices and choose their level of detail as if their model matrix
+ * was the identity (see Cyb_DrawMeshTransformed). The vertex array object of
+ * the mesh stays bound afterwards. Meshes with levels of detail draw all 
+ * instances at the level of the instance with the largest screen size.
  *
  * @param renderer Pointer to the renderer.
  * @param mesh Pointer to the mesh.
@@ -153,6 +462,65 @@ CYBAPI int Cyb_UpdateMesh(Cyb_Renderer *renderer, Cyb_Mesh *mesh, int vertCount,
  */
 CYBAPI void Cyb_DrawMeshes(Cyb_Renderer *renderer, Cyb_Mesh *mesh, int count);
 
+/** @brief Draw a single copy of a mesh with a model matrix.
+ *
+ * The matrices are passed to the "instanceM" and "instanceN" attributes 
+ * without using the instance data of the mesh, and the level of detail is 
+ * chosen from the screen size of the transformed mesh.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param mesh Pointer to the mesh.
+ * @param model Pointer to the model matrix.
+ * @param norm Pointer to the normal matrix (optional; calculated from the 
+ * model matrix if NULL).
+ */
+CYBAPI void Cyb_DrawMeshTransformed(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    const Cyb_Mat4 *model, const Cyb_Mat4 *norm);
+    
+/** @brief Draw instances of a mesh with their own per-instance matrices.
+ *
+ * Works like Cyb_SetInstanceData followed by Cyb_DrawMeshes, but the matrices
+ * are uploaded to a separate instance buffer of the mesh, so the instance 
+ * data given to Cyb_SetInstanceData is kept.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param mesh Pointer to the mesh.
+ * @param count The number of instances to draw.
+ * @param models The model matrix of each instance.
+ * @param norms The normal matrix of each instance (optional; calculated from
+ * the model matrices if NULL).
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_DrawMeshInstances(Cyb_Renderer *renderer, Cyb_Mesh *mesh, 
+    int count, const Cyb_Mat4 *models, const Cyb_Mat4 *norms);
+
+/** @brief Keep a CPU copy of the vertex positions and indices of a mesh.
+ *
+ * The copy is made by the next call to Cyb_UpdateMesh and is used by 
+ * Cyb_RayHitMesh.
+ *
+ * @param mesh Pointer to the mesh.
+ * @param retain TRUE to keep a copy or FALSE to free it.
+ */
+CYBAPI void Cyb_RetainMeshGeometry(Cyb_Mesh *mesh, int retain);
+
+/** @brief Find the closest triangle of a mesh hit by a ray.
+ *
+ * Requires a CPU copy of the geometry (see Cyb_RetainMeshGeometry).
+ *
+ * @param ray Pointer to the ray in world space.
+ * @param mesh Pointer to the mesh.
+ * @param model Pointer to the model matrix of the mesh or NULL if the ray is
+ * already in mesh space.
+ * @param t Pointer to a float. On entry it holds the maximum distance. On 
+ * exit it holds the distance to the closest hit.
+ *
+ * @return The index of the closest triangle or -1 if nothing was hit.
+ */
+CYBAPI int Cyb_RayHitMesh(const Cyb_Ray *ray, const Cyb_Mesh *mesh, 
+    const Cyb_Mat4 *model, float *t);
+
 /**
  * @}
  */
@@ -0,0 +1,84 @@
+#ifndef CYBMESHOPTIMIZER_H
+#define CYBMESHOPTIMIZER_H
+
+/** @file
+ * @brief CybRender - Mesh Optimizer API
+ */
+
+#include "CybCommon.h"
+#include "CybMath.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybRender
+ * @brief Cybermals Engine - Renderer Subsystem
+ * @{
+ */
+
+//Functions
+//=================================================================================
+/** @brief Reorder the triangles of a mesh for the vertex cache and overdraw.
+ *
+ * The triangles are first ordered for the post-transform vertex cache (Tom
+ * Forsyth's linear-speed algorithm). If vertex positions are given, the result
+ * is then split into clusters at the points where the cache would be cold
+ * anyway and the clusters are sorted so that the outer, outward-facing ones
+ * are drawn first, which lets the depth test reject more hidden fragments.
+ * The winding of each triangle is kept. The indices are reordered in place.
+ *
+ * @param indices The indices of the triangles.
+ * @param indexCount The number of indices (a multiple of 3).
+ * @param verts The vertex positions (optional).
+ * @param vertCount The number of vertices.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_OptimizeMeshIndices(unsigned int *indices, int indexCount,
+    const Cyb_Vec3 *verts, int vertCount);
+
+/** @brief Reorder the vertices of a mesh in the order the indices use them.
+ *
+ * Fills in the new position of each vertex and rewrites the indices to match,
+ * so the vertex data can be moved with "dest[remap[i]] = src[i]". Vertices
+ * the indices don't use are moved to the end. Call this after reordering the
+ * triangles.
+ *
+ * @param remap Receives the new position of each vertex (vertCount entries).
+ * @param indices The indices of the triangles.
+ * @param indexCount The number of indices.
+ * @param vertCount The number of vertices.
+ *
+ * @return The number of vertices the indices use.
+ */
+CYBAPI int Cyb_OptimizeVertexFetch(int *remap, unsigned int *indices,
+    int indexCount, int vertCount);
+
+/** @brief Measure how well a mesh uses a FIFO vertex cache.
+ *
+ * The ACMR is the average number of cache misses per triangle (0.5 to 3.0)
+ * and the ATVR is the number of misses per vertex used (1.0 is ideal).
+ *
+ * @param indices The indices of the triangles.
+ * @param indexCount The number of indices.
+ * @param vertCount The number of vertices.
+ * @param cacheSize The number of vertices in the cache.
+ * @param acmr Receives the average cache miss ratio.
+ * @param atvr Receives the average transformed vertex ratio.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_GetVertexCacheStats(const unsigned int *indices, int indexCount,
+    int vertCount, int cacheSize, float *acmr, float *atvr);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
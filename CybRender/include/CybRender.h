@@ -13,7 +13,9 @@
 #include "CybLight.h"
 #include "CybMaterial.h"
 #include "CybMesh.h"
+#include "CybMeshOptimizer.h"
 #include "CybRenderer.h"
+#include "CybRenderQueue.h"
 #include "CybShader.h"
 #include "CybTexture.h"
 #include "CybTimer.h"
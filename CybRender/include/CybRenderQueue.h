@@ -0,0 +1,118 @@
+#ifndef CYBRENDERQUEUE_H
+#define CYBRENDERQUEUE_H
+
+/** @file
+ * @brief CybRender - Render Queue API
+ */
+
+#include "CybArmature.h"
+#include "CybCommon.h"
+#include "CybMaterial.h"
+#include "CybMath.h"
+#include "CybMesh.h"
+#include "CybObjects.h"
+#include "CybRenderer.h"
+#include "CybShader.h"
+#include "CybTexture.h"
+
+#define CYB_MAX_DRAW_TEXTURES 4
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybRender
+ * @brief Cybermals Engine - Renderer Subsystem
+ * @{
+ */
+
+//Types
+//=================================================================================
+/** @brief A render queue.
+ */
+typedef struct Cyb_RenderQueue Cyb_RenderQueue;
+
+
+//Structures
+//=================================================================================
+/** @brief A draw item.
+ *
+ * The model matrix reaches the shader through the "instanceM" and "instanceN"
+ * attributes and the material through the "mat" uniform. Unused texture slots
+ * and the material and pose may be NULL.
+ */
+typedef struct
+{
+    Cyb_Mesh *mesh;                                /**< The mesh to draw. */
+    Cyb_Shader *shader;                            /**< The shader to draw it with. */
+    Cyb_Material *material;                        /**< The material (optional). */
+    Cyb_Texture *textures[CYB_MAX_DRAW_TEXTURES];  /**< The textures bound to "tex0" to "tex3" (optional). */
+    Cyb_Pose *pose;                                /**< The armature pose (optional). */
+    Cyb_Mat4 model;                                /**< The model matrix. */
+    float depth;                                   /**< The distance from the camera. */
+    int transparent;                               /**< TRUE if the item is blended. */
+} Cyb_DrawItem;
+
+
+//Functions
+//=================================================================================
+/** @brief Create a new render queue.
+ *
+ * @return Pointer to the render queue.
+ */
+CYBAPI Cyb_RenderQueue *Cyb_CreateRenderQueue(void);
+
+/** @brief Submit a draw item to a render queue.
+ *
+ * The item is copied. The objects it points to are not referenced and must
+ * stay alive until the queue is flushed.
+ *
+ * @param queue Pointer to the render queue.
+ * @param item Pointer to the draw item.
+ *
+ * @return CYB_NO_ERROR on success.
+ */
+CYBAPI int Cyb_SubmitDraw(Cyb_RenderQueue *queue, const Cyb_DrawItem *item);
+
+/** @brief Get the number of draw items in a render queue.
+ *
+ * @param queue Pointer to the render queue.
+ *
+ * @return The number of draw items.
+ */
+CYBAPI int Cyb_GetDrawItemCount(Cyb_RenderQueue *queue);
+
+/** @brief Remove all draw items from a render queue without drawing them.
+ *
+ * @param queue Pointer to the render queue.
+ */
+CYBAPI void Cyb_ClearRenderQueue(Cyb_RenderQueue *queue);
+
+/** @brief Sort and draw all draw items in a render queue and clear it.
+ *
+ * Opaque items are drawn first, grouped by shader, texture, material, and
+ * mesh and front-to-back within each group. Transparent items are drawn
+ * back-to-front afterwards with GL_BLEND enabled, which is disabled again at
+ * the end. Consecutive items which share all of their state and the level of
+ * detail of their mesh are drawn with one call to Cyb_DrawMeshInstances, so
+ * the instance data set on a mesh with Cyb_SetInstanceData is not used by the
+ * queue and is kept. View, projection, and light uniforms and the blend 
+ * function are left to the caller.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param queue Pointer to the render queue.
+ *
+ * @return The number of draw calls made.
+ */
+CYBAPI int Cyb_FlushRenderQueue(Cyb_Renderer *renderer, Cyb_RenderQueue *queue);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
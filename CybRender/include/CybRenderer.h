@@ -9,6 +9,12 @@
 #include <SDL2/SDL_opengl.h>
  
 #include "CybCommon.h"
+#include "CybMath.h"
+
+#define CYB_MAX_CACHED_TEXTURE_UNITS 16
+#define CYB_ACTIVE_TEXTURE_UNIT -1
+#define CYB_MAX_GPU_SCOPES 16
+#define CYB_MAX_GPU_SCOPE_NAME 32
 
  
 #ifdef __cplusplus
@@ -26,10 +32,24 @@ extern "C" {
  */
 typedef struct Cyb_Renderer Cyb_Renderer;
 
+/** @brief Armature type (see CybArmature.h).
+ */
+struct Cyb_Armature;
+
 
 //Structures
 //=================================================================================
 /** @brief OpenGL extension functions interface.
+ *
+ * DrawElementsInstanced and VertexAttribDivisor are NULL when the driver does
+ * not support hardware instancing. The vertex array functions are NULL when
+ * the driver does not support vertex array objects. The buffer storage
+ * functions are NULL when the driver does not support persistently mapped
+ * buffers and fences. The base vertex functions are NULL when the driver
+ * does not support drawing with a base vertex or copying between buffers.
+ * The timer query functions are NULL when the driver does not support
+ * GL_TIME_ELAPSED queries. The vertex types are 0 when the driver does not
+ * support them as vertex attrib types.
  */
 typedef struct
 {
@@ -62,21 +82,101 @@ typedef struct
     PFNGLDELETEBUFFERSPROC DeleteBuffers;
     PFNGLBINDBUFFERPROC BindBuffer;
     PFNGLBUFFERDATAPROC BufferData;
+    PFNGLBUFFERSUBDATAPROC BufferSubData;
+    
+    //Buffer Storage Functions
+    PFNGLBUFFERSTORAGEPROC BufferStorage;
+    PFNGLMAPBUFFERRANGEPROC MapBufferRange;
+    PFNGLUNMAPBUFFERPROC UnmapBuffer;
+    PFNGLFENCESYNCPROC FenceSync;
+    PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
+    PFNGLDELETESYNCPROC DeleteSync;
     
     //Vertex Attrib Functions
     PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray;
     PFNGLDISABLEVERTEXATTRIBARRAYPROC DisableVertexAttribArray;
     PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer;
+    PFNGLVERTEXATTRIB4FVPROC VertexAttrib4fv;
+    
+    //Vertex Array Functions
+    PFNGLGENVERTEXARRAYSPROC GenVertexArrays;
+    PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays;
+    PFNGLBINDVERTEXARRAYPROC BindVertexArray;
     
     //Texture Functions
     PFNGLACTIVETEXTUREPROC ActiveTexture;
     
-    /* //Instanced Drawing Functions
+    //Instanced Drawing Functions
     PFNGLDRAWELEMENTSINSTANCEDPROC DrawElementsInstanced;
-    PFNGLVERTEXATTRIBDIVISORPROC VertexAttribDivisor; */
+    PFNGLVERTEXATTRIBDIVISORPROC VertexAttribDivisor;
+    
+    //Base Vertex Functions
+    PFNGLDRAWELEMENTSBASEVERTEXPROC DrawElementsBaseVertex;
+    PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC DrawElementsInstancedBaseVertex;
+    PFNGLCOPYBUFFERSUBDATAPROC CopyBufferSubData;
+    
+    //Timer Query Functions
+    PFNGLGENQUERIESPROC GenQueries;
+    PFNGLBEGINQUERYPROC BeginQuery;
+    PFNGLENDQUERYPROC EndQuery;
+    PFNGLGETQUERYOBJECTUIVPROC GetQueryObjectuiv;
+    PFNGLGETQUERYOBJECTUI64VPROC GetQueryObjectui64v;
+    
+    //Vertex Types
+    GLenum HalfFloatType;
+    GLenum Int2101010Type;
 } Cyb_GLExtAPI;
 
 
+/** @brief Statistics of the OpenGL state cache.
+ *
+ * Each pair counts the state changes passed to OpenGL and the redundant ones
+ * which were skipped.
+ */
+typedef struct
+{
+    int programBinds;  /**< Programs bound. */
+    int programSkips;  /**< Redundant program binds skipped. */
+    int bufferBinds;   /**< Buffers bound. */
+    int bufferSkips;   /**< Redundant buffer binds skipped. */
+    int vaoBinds;      /**< Vertex array objects bound. */
+    int vaoSkips;      /**< Redundant vertex array object binds skipped. */
+    int textureBinds;  /**< Texture unit changes and textures bound. */
+    int textureSkips;  /**< Redundant texture unit changes and binds skipped. */
+    int capChanges;    /**< Capabilities enabled or disabled. */
+    int capSkips;      /**< Redundant capability changes skipped. */
+} Cyb_StateCacheStats;
+
+
+/** @brief GPU time of a named scope.
+ */
+typedef struct
+{
+    char name[CYB_MAX_GPU_SCOPE_NAME]; /**< The name of the scope. */
+    float time;                        /**< The GPU time in milliseconds. */
+} Cyb_GPUScopeTime;
+
+
+/** @brief Statistics of the last frame presented by a renderer.
+ *
+ * The GPU times are measured with timer queries, which are read a few frames
+ * later so the CPU never waits for the GPU. They belong to the newest frame
+ * whose results were available.
+ */
+typedef struct
+{
+    int drawCalls;       /**< Draw calls made. */
+    int instances;       /**< Instances drawn. */
+    Uint64 triangles;    /**< Triangles drawn (all instances). */
+    int programSwitches; /**< Programs bound. */
+    int textureBinds;    /**< Textures bound. */
+    Uint64 uploadBytes;  /**< Bytes of vertex, index, instance, and texture data uploaded. */
+    float gpuTime;       /**< GPU time of the whole frame in milliseconds or -1 if it is not known. */
+    int scopeCount;      /**< Number of GPU scopes. */
+    Cyb_GPUScopeTime scopes[CYB_MAX_GPU_SCOPES]; /**< GPU time of each scope. */
+} Cyb_RenderStats;
+
+
 //Functions
 //=================================================================================
 /** @brief Create a new renderer for a window.
@@ -118,9 +218,219 @@ CYBAPI void Cyb_RenderClear(Cyb_Renderer *renderer);
  */
 CYBAPI Cyb_GLExtAPI *Cyb_GetGLExtAPI(Cyb_Renderer *renderer);
 
+/** @brief Use a shader program unless it is already in use.
+ *
+ * The state cache functions act on the selected renderer. State that is 
+ * changed by calling OpenGL directly must be reported with 
+ * Cyb_InvalidateStateCache.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param program The shader program.
+ */
+CYBAPI void Cyb_UseProgram(Cyb_Renderer *renderer, GLuint program);
+
+/** @brief Bind a buffer unless it is already bound.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param target GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER.
+ * @param buffer The buffer.
+ */
+CYBAPI void Cyb_BindBuffer(Cyb_Renderer *renderer, GLenum target, GLuint buffer);
+
+/** @brief Bind a vertex array object unless it is already bound.
+ *
+ * The element buffer binding is part of the vertex array object, so it is no
+ * longer known to the cache after the vertex array object changes.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param vao The vertex array object.
+ */
+CYBAPI void Cyb_BindVertexArray(Cyb_Renderer *renderer, GLuint vao);
+
+/** @brief Bind a 2D texture to a texture unit unless it is already bound.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param texUnit The texture unit or CYB_ACTIVE_TEXTURE_UNIT.
+ * @param texture The texture.
+ */
+CYBAPI void Cyb_BindTexture(Cyb_Renderer *renderer, int texUnit, 
+    GLuint texture);
+    
+/** @brief Enable or disable an OpenGL capability unless it already is.
+ *
+ * Only GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_SCISSOR_TEST, and 
+ * GL_STENCIL_TEST are cached. Other capabilities are always changed.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param cap The capability.
+ * @param enable TRUE to enable it or FALSE to disable it.
+ */
+CYBAPI void Cyb_SetRenderCap(Cyb_Renderer *renderer, GLenum cap, int enable);
+
+/** @brief Delete buffers and remove them from the state cache.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param count The number of buffers.
+ * @param buffers The buffers.
+ */
+CYBAPI void Cyb_DeleteBuffers(Cyb_Renderer *renderer, int count, 
+    const GLuint *buffers);
+    
+/** @brief Delete vertex array objects and remove them from the state cache.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param count The number of vertex array objects.
+ * @param vaos The vertex array objects.
+ */
+CYBAPI void Cyb_DeleteVertexArrays(Cyb_Renderer *renderer, int count, 
+    const GLuint *vaos);
+    
+/** @brief Delete textures and remove them from the state cache.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param count The number of textures.
+ * @param textures The textures.
+ */
+CYBAPI void Cyb_DeleteTextures(Cyb_Renderer *renderer, int count, 
+    const GLuint *textures);
+    
+/** @brief Delete a shader program and remove it from the state cache.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param program The shader program.
+ */
+CYBAPI void Cyb_DeleteProgram(Cyb_Renderer *renderer, GLuint program);
+
+/** @brief Forget all cached OpenGL state.
+ *
+ * Call this after changing bindings or capabilities with OpenGL directly.
+ *
+ * @param renderer Pointer to the renderer.
+ */
+CYBAPI void Cyb_InvalidateStateCache(Cyb_Renderer *renderer);
+
+/** @brief Get the statistics of the OpenGL state cache.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param stats Pointer to the resulting statistics.
+ */
+CYBAPI void Cyb_GetStateCacheStats(Cyb_Renderer *renderer, 
+    Cyb_StateCacheStats *stats);
+    
+/** @brief Reset the statistics of the OpenGL state cache (ex. once per frame).
+ *
+ * @param renderer Pointer to the renderer.
+ */
+CYBAPI void Cyb_ResetStateCacheStats(Cyb_Renderer *renderer);
+
+/** @brief Set the armature used by the meshes drawn with a renderer.
+ *
+ * Used by Cyb_SelectPose.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param armature Pointer to the armature or NULL to draw meshes without one.
+ */
+CYBAPI void Cyb_SetSelectedArmature(Cyb_Renderer *renderer, 
+    struct Cyb_Armature *armature);
+    
+/** @brief Get the armature of the selected pose.
+ *
+ * @param renderer Pointer to the renderer.
+ *
+ * @return Pointer to the armature or NULL if no pose is selected.
+ */
+CYBAPI struct Cyb_Armature *Cyb_GetSelectedArmature(Cyb_Renderer *renderer);
+
+/** @brief Set the camera used to select the level of detail of meshes.
+ *
+ * Meshes are drawn at full detail until a camera is set.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param view Pointer to the view matrix or NULL to always use full detail.
+ * @param proj Pointer to the projection matrix.
+ */
+CYBAPI void Cyb_SetLODCamera(Cyb_Renderer *renderer, const Cyb_Mat4 *view,
+    const Cyb_Mat4 *proj);
+
+/** @brief Set the global level of detail bias.
+ *
+ * Each step of the bias halves the screen size at which meshes switch to 
+ * their next level.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param bias The bias (0 by default, higher values lower the detail).
+ */
+CYBAPI void Cyb_SetLODBias(Cyb_Renderer *renderer, float bias);
+
+/** @brief Get the screen size of a sphere for level of detail selection.
+ *
+ * The size is the fraction of the viewport height covered by the sphere as
+ * seen from the LOD camera, scaled by the LOD bias.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param center Pointer to the center of the sphere in world space.
+ * @param radius The radius of the sphere.
+ *
+ * @return The screen size or -1 if no LOD camera is set.
+ */
+CYBAPI float Cyb_GetLODScreenSize(Cyb_Renderer *renderer, 
+    const Cyb_Vec3 *center, float radius);
+
+/** @brief Add a draw call to the frame statistics of a renderer.
+ *
+ * Draws made by CybRender are counted already. Call this for draws made with
+ * OpenGL directly.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param triangles The number of triangles per instance.
+ * @param instances The number of instances.
+ */
+CYBAPI void Cyb_AddDrawStats(Cyb_Renderer *renderer, int triangles, 
+    int instances);
+
+/** @brief Add uploaded data to the frame statistics of a renderer.
+ *
+ * Uploads made by CybRender are counted already. Call this for uploads made
+ * with OpenGL directly.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param bytes The number of bytes uploaded.
+ */
+CYBAPI void Cyb_AddUploadStats(Cyb_Renderer *renderer, size_t bytes);
+
+/** @brief Get the statistics of the last frame presented by a renderer.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param stats Pointer to the resulting statistics.
+ */
+CYBAPI void Cyb_GetRenderStats(Cyb_Renderer *renderer, Cyb_RenderStats *stats);
+
+/** @brief Start measuring the GPU time of a named scope.
+ *
+ * Scopes can't be nested, so this ends the scope which is still open. A scope
+ * which is opened more than once per frame adds up its times. Each frame can
+ * have up to CYB_MAX_GPU_SCOPES different scopes and open scopes up to
+ * CYB_MAX_GPU_SCOPES times. After that, the scope is not changed and the time
+ * goes to the scope which is still open. This does nothing if the driver does
+ * not support timer queries.
+ *
+ * @param renderer Pointer to the renderer.
+ * @param name The name of the scope.
+ */
+CYBAPI void Cyb_BeginGPUScope(Cyb_Renderer *renderer, const char *name);
+
+/** @brief Stop measuring the GPU time of the open scope.
+ *
+ * @param renderer Pointer to the renderer.
+ */
+CYBAPI void Cyb_EndGPUScope(Cyb_Renderer *renderer);
+
 /** @brief Present the content that has been rendered by swapping the front and
  * back buffers.
  *
+ * This ends the frame. Its counters become the render statistics and the
+ * next frame starts counting from 0.
+ *
  * @param renderer Pointer to the renderer.
  */
 CYBAPI void Cyb_RenderPresent(Cyb_Renderer *renderer);
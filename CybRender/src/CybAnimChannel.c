@@ -205,7 +205,7 @@ int Cyb_ApplyAnimChannel(Cyb_AnimChannel *animChannel, Cyb_Pose *pose,
         {
             //Calculate progression between keys and interpolate
             double progress =  (time - a->time) / (b->time - a->time);
-            Cyb_Slerp(&rot, &a->value, &b->value, progress);
+            Cyb_FastSlerp(&rot, &a->value, &b->value, (float)progress);
             animOver = FALSE;
         }
     }
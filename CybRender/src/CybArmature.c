@@ -34,11 +34,16 @@ struct Cyb_Pose
 //================================================================================
 static void Cyb_FreeArmature(Cyb_Armature *armature)
 {
+    //Ensure that this armature is not selected
+    if(Cyb_GetSelectedArmature(armature->renderer) == armature)
+    {
+        Cyb_SetSelectedArmature(armature->renderer, NULL);
+    }
+    
     //Free the VBO
     if(armature->vbo)
     {
-        Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(armature->renderer);
-        glExtAPI->DeleteBuffers(1, &armature->vbo);
+        Cyb_DeleteBuffers(armature->renderer, 1, &armature->vbo);
     }
     
     //Free the bone array
@@ -121,9 +126,10 @@ void Cyb_UpdateArmature(Cyb_Renderer *renderer, Cyb_Armature *armature,
     
     //Bind VBO, upload geometry data, and free temp buffer
     Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
-    glExtAPI->BindBuffer(GL_ARRAY_BUFFER, armature->vbo);
+    Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, armature->vbo);
     glExtAPI->BufferData(GL_ARRAY_BUFFER, sizeof(Cyb_VertexGW) * vertCount, buf,
         GL_STATIC_DRAW);
+    Cyb_AddUploadStats(renderer, sizeof(Cyb_VertexGW) * vertCount);
     SDL_free(buf);
     
     //Copy the bones
@@ -268,14 +274,38 @@ void Cyb_UpdateBone(Cyb_Pose *pose, int boneID, const Cyb_Mat4 *matrix)
 
 
 void Cyb_SelectPose(Cyb_Renderer *renderer, Cyb_Shader *shader, Cyb_Pose *pose)
+{
+    //Deselect the armature? (poses of other renderers can't be drawn)
+    if(!pose || pose->armature->renderer != renderer)
+    {
+        Cyb_SetSelectedArmature(renderer, NULL);
+        return;
+    }
+    
+    //Select the armature (its attribs are setup by Cyb_DrawMeshes)
+    Cyb_SetSelectedArmature(renderer, pose->armature);
+    
+    //Setup bone matrices
+    Cyb_SetMatrices(renderer, shader, "bones", pose->boneCount, pose->bones);
+}
+
+
+void Cyb_SetupArmatureAttribs(Cyb_Renderer *renderer, Cyb_Armature *armature)
 {
     //Select renderer
-    Cyb_Armature *armature = pose->armature;
     Cyb_SelectRenderer(renderer);
     Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
     
+    //Disable the attribs?
+    if(!armature)
+    {
+        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_GROUP);
+        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_WEIGHT);
+        return;
+    }
+    
     //Bind armature VBO
-    glExtAPI->BindBuffer(GL_ARRAY_BUFFER, armature->vbo);
+    Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, armature->vbo);
     
     //Setup vertex attrib pointers
     glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_GROUP);
@@ -284,7 +314,4 @@ void Cyb_SelectPose(Cyb_Renderer *renderer, Cyb_Shader *shader, Cyb_Pose *pose)
         sizeof(Cyb_VertexGW), (void*)offsetof(Cyb_VertexGW, group));
     glExtAPI->VertexAttribPointer(CYB_ATTRIB_WEIGHT, 4, GL_FLOAT, GL_FALSE, 
         sizeof(Cyb_VertexGW), (void*)offsetof(Cyb_VertexGW, weight));
-        
-    //Setup bone matrices
-    Cyb_SetMatrices(renderer, shader, "bones", pose->boneCount, pose->bones);
 }
\ No newline at end of file
@@ -15,7 +15,9 @@ CybRender - Asset Loader API
 
 //Constants
 //=================================================================================
-const char *loadMeshSQL = "SELECT vert_count, vertices, normals, tangents, colors, uvs, index_count, indices FROM meshes WHERE name = ?;";
+const char *loadMeshSQL = "SELECT vert_count, vertices, normals, tangents, colors, uvs, index_count, indices, vertex_desc, vertex_data, lods FROM meshes WHERE name = ?;";
+const char *loadInterleavedMeshSQL = "SELECT vert_count, vertices, normals, tangents, colors, uvs, index_count, indices, vertex_desc, vertex_data FROM meshes WHERE name = ?;";
+const char *loadLegacyMeshSQL = "SELECT vert_count, vertices, normals, tangents, colors, uvs, index_count, indices FROM meshes WHERE name = ?;";
 const char *loadMaterialSQL = "SELECT ambient, diffuse, specular, shininess FROM materials WHERE name = ?;";
 const char *loadTextureSQL = "SELECT width, height, format, data FROM textures WHERE name = ?;";
 const char *loadArmatureSQL = "SELECT vert_count, vgroups, vweights, bone_count, bones FROM armatures WHERE name = ?;";
@@ -56,11 +58,14 @@ Cyb_Object *Cyb_LoadAsset_DB(Cyb_Renderer *renderer, sqlite3 *db,
         //Mesh asset?
     case CYB_MESH_ASSET:
     {
-        //Compile SQL statements
+        //Compile SQL statements (older asset databases have no levels of 
+        //detail or interleaved vertex data)
         sqlite3_stmt *loadMeshStmt = NULL;
         
         if(sqlite3_prepare_v2(db, loadMeshSQL, -1, &loadMeshStmt, NULL) != 
-            SQLITE_OK)
+            SQLITE_OK && sqlite3_prepare_v2(db, loadInterleavedMeshSQL, -1,
+            &loadMeshStmt, NULL) != SQLITE_OK && sqlite3_prepare_v2(db, 
+            loadLegacyMeshSQL, -1, &loadMeshStmt, NULL) != SQLITE_OK)
         {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
                 "[CybRender] Failed to compile an SQL statement.");
@@ -86,18 +91,65 @@ Cyb_Object *Cyb_LoadAsset_DB(Cyb_Renderer *renderer, sqlite3 *db,
             return NULL;
         }
         
-        Cyb_UpdateMesh(
-            renderer,
-            mesh,
-            sqlite3_column_int(loadMeshStmt, 0),
-            sqlite3_column_blob(loadMeshStmt, 1),
-            sqlite3_column_blob(loadMeshStmt, 2),
-            sqlite3_column_blob(loadMeshStmt, 3),
-            sqlite3_column_blob(loadMeshStmt, 4),
-            sqlite3_column_blob(loadMeshStmt, 5),
-            sqlite3_column_int(loadMeshStmt, 6),
-            sqlite3_column_blob(loadMeshStmt, 7)
-        );
+        //Upload interleaved vertex data as it is
+        int vertCount = sqlite3_column_int(loadMeshStmt, 0);
+        Cyb_VertexDesc desc;
+        const void *vertData = NULL;
+        
+        if(sqlite3_column_count(loadMeshStmt) > 9 && 
+            sqlite3_column_bytes(loadMeshStmt, 8) == sizeof(Cyb_VertexDesc))
+        {
+            memcpy(&desc, sqlite3_column_blob(loadMeshStmt, 8), 
+                sizeof(Cyb_VertexDesc));
+            vertData = sqlite3_column_blob(loadMeshStmt, 9);
+            
+            if(sqlite3_column_bytes(loadMeshStmt, 9) != 
+                Cyb_GetVertexSize(&desc) * vertCount)
+            {
+                vertData = NULL;
+            }
+        }
+        
+        if(vertData)
+        {
+            Cyb_UpdateMeshInterleaved(
+                renderer,
+                mesh,
+                &desc,
+                vertCount,
+                vertData,
+                sqlite3_column_int(loadMeshStmt, 6),
+                sqlite3_column_blob(loadMeshStmt, 7)
+            );
+        }
+        //Interleave the separate vertex arrays
+        else
+        {
+            Cyb_UpdateMesh(
+                renderer,
+                mesh,
+                vertCount,
+                sqlite3_column_blob(loadMeshStmt, 1),
+                sqlite3_column_blob(loadMeshStmt, 2),
+                sqlite3_column_blob(loadMeshStmt, 3),
+                sqlite3_column_blob(loadMeshStmt, 4),
+                sqlite3_column_blob(loadMeshStmt, 5),
+                sqlite3_column_int(loadMeshStmt, 6),
+                sqlite3_column_blob(loadMeshStmt, 7)
+            );
+        }
+        
+        //Set the levels of detail
+        if(sqlite3_column_count(loadMeshStmt) > 10)
+        {
+            int lodBytes = sqlite3_column_bytes(loadMeshStmt, 10);
+            
+            if(lodBytes && lodBytes % sizeof(Cyb_MeshLOD) == 0)
+            {
+                Cyb_SetMeshLODs(mesh, lodBytes / sizeof(Cyb_MeshLOD), 
+                    sqlite3_column_blob(loadMeshStmt, 10));
+            }
+        }
         
         //Finalize SQL statements
         sqlite3_finalize(loadMeshStmt);
@@ -100,8 +100,11 @@ void Cyb_MoveCamera(Cyb_Camera *cam, float velocity)
     }
 
     //Update camera pos
-    cam->pos.x += -velocity * sinf(radians(cam->rot.y));
-    cam->pos.z += -velocity * cosf(radians(cam->rot.y));
+    float s;
+    float c;
+    Cyb_FastSinCos(radians(cam->rot.y), &s, &c);
+    cam->pos.x += -velocity * s;
+    cam->pos.z += -velocity * c;
     cam->isDirty = TRUE;
 }
 
@@ -114,10 +117,13 @@ void Cyb_StrafeCamera(Cyb_Camera *cam, float velocity)
         return;
     }
     
-    //Update camera pos
-    float theta = cam->rot.y + 90.0f;
-    cam->pos.x += -velocity * sinf(radians(theta));
-    cam->pos.z += -velocity * cosf(radians(theta));
+    //Update camera pos. Strafing is 90 degrees from the view direction, so
+    //sin(theta + 90) = cos(theta) and cos(theta + 90) = -sin(theta).
+    float s;
+    float c;
+    Cyb_FastSinCos(radians(cam->rot.y), &s, &c);
+    cam->pos.x += -velocity * c;
+    cam->pos.z += velocity * s;
     cam->isDirty = TRUE;
 }
 
@@ -2,392 +2,2738 @@
 CybRender - Mesh API
 */
 
+#include <math.h>
 #include <string.h>
 
+#include "CybArmature.h"
 #include "CybMesh.h"
 #include "CybObject.h"
 
+#define CYB_STREAM_SEGMENTS 3
+#define CYB_STREAM_WAIT_TIMEOUT 1000000 //nanoseconds
+#define CYB_MESH_ATTRIB_COUNT (CYB_ATTRIB_UV + 1)
+#define CYB_ARENA_VERT_CAP 65536
+#define CYB_ARENA_INDEX_CAP 196608
+
 
 //Structures
 //=================================================================================
+typedef struct
+{
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    int packing;
+    int comps;
+    int offset;
+} Cyb_AttribFormat;
+
+
+typedef struct
+{
+    int vFormat;
+    int vertSize;
+    Cyb_AttribFormat attribs[CYB_MESH_ATTRIB_COUNT];
+    Cyb_Mat4 dequant;
+} Cyb_VertexFormat;
+
+
+typedef struct
+{
+    Cyb_Mat4 model;
+    Cyb_Mat4 norm;
+} Cyb_InstanceData;
+
+
+typedef struct
+{
+    int start;
+    int count;
+} Cyb_Range;
+
+
+typedef struct
+{
+    int count;
+    int cap;
+    Cyb_Range *ranges;
+} Cyb_RangeList;
+
+
+typedef struct
+{
+    Cyb_GeometryArena *arena;
+    Cyb_VertexFormat format;
+    GLenum indexType;
+    int indexSize;
+    GLuint vbo;
+    GLuint ebo;
+    GLuint vao;
+    int vertCap;
+    int indexCap;
+    Cyb_RangeList freeVerts;
+    Cyb_RangeList freeIndices;
+    int meshCount;
+    int meshCap;
+    Cyb_Mesh **meshes;
+} Cyb_ArenaPool;
+
+
+struct Cyb_GeometryArena
+{
+    Cyb_Object base;
+    Cyb_Renderer *renderer;
+    int vertCap;
+    int indexCap;
+    int poolCount;
+    Cyb_ArenaPool **pools;
+};
+
+
 struct Cyb_Mesh
 {
     Cyb_Object base;
     Cyb_Renderer *renderer;
-    int vFormat;
+    Cyb_VertexLayout layout;
+    Cyb_VertexFormat format;
+    int usage;
+    int bufVertCount;
     int indexCount;
+    GLenum indexType;
     GLuint vbo;
     GLuint ebo;
+    GLsizeiptr vboSize;
+    GLsizeiptr eboSize;
+    GLintptr vboOffset;
+    GLintptr indexOffset;
+    Cyb_GeometryArena *arena;
+    Cyb_ArenaPool *pool;
+    int firstVert;
+    int vertCap;
+    int firstIndex;
+    int indexCap;
+    void *streamData;
+    void *streamMap;
+    GLsizeiptr streamSegSize;
+    int streamSegment;
+    GLsync streamFences[CYB_STREAM_SEGMENTS];
+    GLuint vao;
+    GLuint skinVAO;
+    Cyb_Armature *skinArmature;
+    int retainGeometry;
+    int vertCount;
+    Cyb_Vec3 *verts;
+    unsigned int *indices;
+    Cyb_Sphere bounds;
+    int lodCount;
+    Cyb_MeshLOD lods[CYB_MAX_MESH_LODS];
+    GLuint instanceVBO;
+    GLsizeiptr instanceVBOSize;
+    int instanceCount;
+    int instanceCap;
+    Cyb_InstanceData *instances;
+    GLuint tempInstanceVBO;
+    GLsizeiptr tempInstanceVBOSize;
+    int tempInstanceCap;
+    Cyb_InstanceData *tempInstances;
+};
+
+
+//Globals
+//=================================================================================
+static const Cyb_Mat4 identity = {
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f
 };
 
 
 //Functions
 //=================================================================================
-void Cyb_FreeMesh(Cyb_Mesh *mesh)
+static void Cyb_SetInstanceAttribs(Cyb_GLExtAPI *glExtAPI, const Cyb_Mat4 *model,
+    const Cyb_Mat4 *norm)
 {
-    //Unbind VBO and EBO
-    Cyb_SelectRenderer(mesh->renderer);
-    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(mesh->renderer);
-    glExtAPI->BindBuffer(GL_ARRAY_BUFFER, 0);
-    glExtAPI->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    
-    //Free VBO
-    if(mesh->vbo)
+    //Set the constant value of each matrix column
+    for(int i = 0; i < 4; i++)
     {
-        glExtAPI->DeleteBuffers(1, &mesh->vbo);
+        glExtAPI->VertexAttrib4fv(CYB_ATTRIB_INSTANCE_MAT_MODEL + i, 
+            (const float*)model + i * 4);
+        glExtAPI->VertexAttrib4fv(CYB_ATTRIB_INSTANCE_MAT_NORM + i, 
+            (const float*)norm + i * 4);
     }
+}
+
+
+static void Cyb_SetupAttribPointers(Cyb_Renderer *renderer, 
+    const Cyb_VertexFormat *format, GLuint vbo, GLuint ebo, GLintptr base)
+{
+    //Bind VBO and EBO
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, vbo);
+    Cyb_BindBuffer(renderer, GL_ELEMENT_ARRAY_BUFFER, ebo);
     
-    //Free EBO
-    if(mesh->ebo)
+    //Setup vertex attrib pointers
+    for(int i = 0; i < CYB_MESH_ATTRIB_COUNT; i++)
     {
-        glExtAPI->DeleteBuffers(1, &mesh->ebo);
+        const Cyb_AttribFormat *attrib = &format->attribs[i];
+        
+        if(!attrib->size)
+        {
+            glExtAPI->DisableVertexAttribArray(i);
+            continue;
+        }
+        
+        glExtAPI->EnableVertexAttribArray(i);
+        glExtAPI->VertexAttribPointer(i, attrib->size, attrib->type, 
+            attrib->normalized, format->vertSize, 
+            (void*)(base + attrib->offset));
     }
 }
 
 
-Cyb_Mesh *Cyb_CreateMesh(Cyb_Renderer *renderer)
+static void Cyb_SetupVertexAttribs(Cyb_Renderer *renderer, Cyb_Mesh *mesh)
 {
-    //Allocate new mesh
-    Cyb_Mesh *mesh = (Cyb_Mesh*)Cyb_CreateObject(sizeof(Cyb_Mesh),
-        (Cyb_FreeProc)&Cyb_FreeMesh, CYB_MESH);
-        
-    if(!mesh)
+    //The vertices start at the offset of the current segment of a ring 
+    //buffer or of the block of a geometry arena
+    if(mesh->pool)
     {
-        return NULL;
+        Cyb_SetupAttribPointers(renderer, &mesh->format, mesh->pool->vbo, 
+            mesh->pool->ebo, mesh->vboOffset);
+        return;
     }
     
-    //Initialize the mesh
-    mesh->vFormat = CYB_VERTEX_UNKNOWN;
-    mesh->renderer = renderer;
-    Cyb_SelectRenderer(renderer);
-    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
-    glExtAPI->GenBuffers(1, &mesh->vbo);
+    Cyb_SetupAttribPointers(renderer, &mesh->format, mesh->vbo, mesh->ebo, 
+        mesh->vboOffset);
+}
+
+
+static void Cyb_BuildVAO(Cyb_Renderer *renderer, Cyb_Mesh *mesh, GLuint vao, 
+    Cyb_Armature *armature)
+{
+    //Record the attrib setup of the mesh and armature in the VAO
+    Cyb_BindVertexArray(renderer, vao);
+    Cyb_SetupVertexAttribs(renderer, mesh);
+    Cyb_SetupArmatureAttribs(renderer, armature);
+    Cyb_BindVertexArray(renderer, 0);
+}
+
+
+static void Cyb_RebuildVAOs(Cyb_Renderer *renderer, Cyb_Mesh *mesh)
+{
+    //Rebuild the VAOs for a new vertex format or buffer offset
+    if(mesh->vao)
+    {
+        Cyb_BuildVAO(renderer, mesh, mesh->vao, NULL);
+    }
     
-    if(!mesh->vbo)
+    if(mesh->skinVAO)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
-            "[CybRender] Failed to allocate VBO.");
-        Cyb_FreeObject((Cyb_Object**)&mesh);
-        return NULL;
+        Cyb_BuildVAO(renderer, mesh, mesh->skinVAO, mesh->skinArmature);
     }
+}
 
-    glExtAPI->GenBuffers(1, &mesh->ebo);
-    
-    if(!mesh->ebo)
+
+static GLenum Cyb_GetGLUsage(int usage)
+{
+    switch(usage)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
-            "[CybRender] Failed to allocate EBO.");
-        Cyb_FreeObject((Cyb_Object**)&mesh);
-        return NULL;
+    case CYB_BUFFER_DYNAMIC:
+        return GL_DYNAMIC_DRAW;
+        
+    case CYB_BUFFER_STREAM:
+        return GL_STREAM_DRAW;
+        
+    default:
+        return GL_STATIC_DRAW;
     }
+}
 
-    return mesh;
+
+static int Cyb_GetIndexSize(GLenum indexType)
+{
+    return indexType == GL_UNSIGNED_SHORT ? sizeof(Uint16) : 
+        sizeof(unsigned int);
 }
 
 
-int Cyb_UpdateMesh(Cyb_Renderer *renderer, Cyb_Mesh *mesh, int vertCount, 
-    const Cyb_Vec3 *verts, const Cyb_Vec3 *norms, const Cyb_Vec3 *tangents, 
-    const Cyb_Vec4 *colors, const Cyb_Vec2 *uvs, int indexCount, 
-    const unsigned int *indices)
+static Uint16 Cyb_FloatToHalf(float f)
 {
-    //Ensure that vertices and indices were given
-    if(!verts || !indices)
+    //Get the bits of the float
+    union
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
-            "[CybRender] Function 'Cyb_UpdateMesh' requires at least an array of vertices and indices.");
-        return CYB_ERROR;
+        float f;
+        Uint32 u;
+    } bits;
+    
+    bits.f = f;
+    Uint32 sign = (bits.u >> 16) & 0x8000;
+    int exp = (int)((bits.u >> 23) & 0xFF) - 127 + 15;
+    Uint32 mantissa = bits.u & 0x7FFFFF;
+    
+    //Infinity or NaN?
+    if(exp - 15 + 127 == 0xFF)
+    {
+        return (Uint16)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
     }
     
-    //Select the renderer
-    Cyb_SelectRenderer(renderer);
-    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    //Too big (round to infinity)?
+    if(exp >= 0x1F)
+    {
+        return (Uint16)(sign | 0x7C00);
+    }
     
-    //Choose the vertex data format
-    if(norms)
+    //Too small (subnormal or zero)?
+    if(exp <= 0)
     {
-        if(!colors && !uvs)
+        if(exp < -10)
         {
-            //Assemble geometry data
-            Cyb_VertexVN *buf = (Cyb_VertexVN*)SDL_malloc(
-                sizeof(Cyb_VertexVN) * vertCount);
-            
-            if(!buf)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
-                    "[CybRender] Out of Memory");
-                return CYB_ERROR;
-            }
+            return (Uint16)sign;
+        }
         
-            for(int i = 0; i < vertCount; i++)
-            {
-                memcpy(&buf[i].pos, &verts[i], sizeof(verts[i]));
-                memcpy(&buf[i].norm, &norms[i], sizeof(norms[i]));
-                
-                if(tangents)
-                {
-                    memcpy(&buf[i].tangent, &tangents[i], sizeof(tangents[i]));
-                }
-            }
+        mantissa |= 0x800000;
+        int shift = 14 - exp;
+        Uint32 half = mantissa >> shift;
+        Uint32 rest = mantissa & ((1u << shift) - 1);
+        Uint32 mid = 1u << (shift - 1);
+        half += rest > mid || (rest == mid && (half & 1));
+        return (Uint16)(sign | half);
+    }
+    
+    //Round to nearest even (a carry into the exponent is still correct)
+    Uint32 half = ((Uint32)exp << 10) | (mantissa >> 13);
+    Uint32 rest = mantissa & 0x1FFF;
+    half += rest > 0x1000 || (rest == 0x1000 && (half & 1));
+    return (Uint16)(sign | half);
+}
+
+
+static float Cyb_ClampUnit(float f, float min)
+{
+    return f < min ? min : (f > 1.0f ? 1.0f : f);
+}
+
+
+static void Cyb_PackAttrib(void *dest, const float *src, int comps, 
+    int packing)
+{
+    //Write one attrib in its packed format
+    switch(packing)
+    {
+    case CYB_PACK_HALF:
+        for(int i = 0; i < comps; i++)
+        {
+            ((Uint16*)dest)[i] = Cyb_FloatToHalf(src[i]);
+        }
         
-            //Bind VBO, upload geometry data, and free temp buffer
-            glExtAPI->BindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
-            glExtAPI->BufferData(GL_ARRAY_BUFFER, sizeof(Cyb_VertexVN) * vertCount,
-                buf, GL_STATIC_DRAW);
-            SDL_free(buf);
+        break;
         
-            //Set vertex format
-            mesh->vFormat = CYB_VERTEX_VN;
-        }
-        else if(colors && !uvs)
+    case CYB_PACK_SNORM16:
+        for(int i = 0; i < comps; i++)
         {
-            //Assemble geometry data
-            Cyb_VertexVNC *buf = (Cyb_VertexVNC*)SDL_malloc(
-                sizeof(Cyb_VertexVNC) * vertCount);
-            
-            if(!buf)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
-                    "[CybRender] Out of Memory");
-                return CYB_ERROR;
-            }
-        
-            for(int i = 0; i < vertCount; i++)
-            {
-                memcpy(&buf[i].pos, &verts[i], sizeof(verts[i]));
-                memcpy(&buf[i].norm, &norms[i], sizeof(norms[i]));
-                
-                if(tangents)
-                {
-                    memcpy(&buf[i].tangent, &tangents[i], sizeof(tangents[i]));
-                }
-                
-                memcpy(&buf[i].color, &colors[i], sizeof(colors[i]));
-            }
+            ((Sint16*)dest)[i] = (Sint16)floorf(
+                Cyb_ClampUnit(src[i], -1.0f) * 32767.0f + 0.5f);
+        }
         
-            //Bind VBO, upload geometry data, and free temp buffer
-            glExtAPI->BindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
-            glExtAPI->BufferData(GL_ARRAY_BUFFER, sizeof(Cyb_VertexVNC) * vertCount,
-                buf, GL_STATIC_DRAW);
-            SDL_free(buf);
+        break;
         
-            //Set vertex format
-            mesh->vFormat = CYB_VERTEX_VNC;
+    case CYB_PACK_UNORM8:
+        for(int i = 0; i < comps; i++)
+        {
+            ((Uint8*)dest)[i] = (Uint8)(Cyb_ClampUnit(src[i], 0.0f) * 255.0f + 
+                0.5f);
         }
-        else if(uvs && !colors)
+        
+        break;
+        
+    case CYB_PACK_SNORM10_10_10_2:
         {
-            //Assemble geometry data
-            Cyb_VertexVNT *buf = (Cyb_VertexVNT*)SDL_malloc(
-                sizeof(Cyb_VertexVNT) * vertCount);
+            //X, Y, and Z take 10 bits each from the lowest bit up and W is 0
+            Uint32 packed = 0;
             
-            if(!buf)
+            for(int i = 0; i < comps && i < 3; i++)
             {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
-                    "[CybRender] Out of Memory");
-                return CYB_ERROR;
+                int value = (int)floorf(Cyb_ClampUnit(src[i], -1.0f) * 
+                    511.0f + 0.5f);
+                packed |= ((Uint32)value & 0x3FF) << (i * 10);
             }
+            
+            memcpy(dest, &packed, sizeof(packed));
+        }
+        break;
         
-            for(int i = 0; i < vertCount; i++)
-            {
-                memcpy(&buf[i].pos, &verts[i], sizeof(verts[i]));
-                memcpy(&buf[i].norm, &norms[i], sizeof(norms[i]));
-                
-                if(tangents)
-                {
-                    memcpy(&buf[i].tangent, &tangents[i], sizeof(tangents[i]));
-                }
-                
-                memcpy(&buf[i].uv, &uvs[i], sizeof(uvs[i]));
-            }
+    default:
+        memcpy(dest, src, sizeof(float) * comps);
+        break;
+    }
+}
+
+
+static float Cyb_HalfToFloat(Uint16 h)
+{
+    //Rebuild the bits of the float
+    union
+    {
+        float f;
+        Uint32 u;
+    } bits;
+    
+    Uint32 sign = (Uint32)(h & 0x8000) << 16;
+    int exp = (h >> 10) & 0x1F;
+    Uint32 mantissa = h & 0x3FF;
+    
+    //Zero or subnormal?
+    if(exp == 0)
+    {
+        bits.f = mantissa * (1.0f / 16777216.0f);
+        bits.u |= sign;
+        return bits.f;
+    }
+    
+    //Infinity or NaN?
+    if(exp == 0x1F)
+    {
+        bits.u = sign | 0x7F800000 | (mantissa << 13);
+        return bits.f;
+    }
+    
+    bits.u = sign | ((Uint32)(exp - 15 + 127) << 23) | (mantissa << 13);
+    return bits.f;
+}
+
+
+static void Cyb_UnpackAttrib(float *dest, const void *src, int comps, 
+    int packing)
+{
+    //Read one attrib from its packed format
+    switch(packing)
+    {
+    case CYB_PACK_HALF:
+        for(int i = 0; i < comps; i++)
+        {
+            Uint16 h;
+            memcpy(&h, (const Uint16*)src + i, sizeof(h));
+            dest[i] = Cyb_HalfToFloat(h);
+        }
         
-            //Bind VBO, upload geometry data, and free temp buffer
-            glExtAPI->BindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
-            glExtAPI->BufferData(GL_ARRAY_BUFFER, sizeof(Cyb_VertexVNT) * vertCount,
-                buf, GL_STATIC_DRAW);
-            SDL_free(buf);
+        break;
         
-            //Set vertex format
-            mesh->vFormat = CYB_VERTEX_VNT;
+    case CYB_PACK_SNORM16:
+        for(int i = 0; i < comps; i++)
+        {
+            Sint16 value;
+            memcpy(&value, (const Sint16*)src + i, sizeof(value));
+            dest[i] = value < -32767 ? -1.0f : value / 32767.0f;
         }
-        else if(colors && uvs)
+        
+        break;
+        
+    case CYB_PACK_UNORM8:
+        for(int i = 0; i < comps; i++)
         {
-            //Assemble geometry data
-            Cyb_VertexVNCT *buf = (Cyb_VertexVNCT*)SDL_malloc(
-                sizeof(Cyb_VertexVNCT) * vertCount);
-            
-            if(!buf)
-            {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
-                    "[CybRender] Out of Memory");
-                return CYB_ERROR;
-            }
+            dest[i] = ((const Uint8*)src)[i] / 255.0f;
+        }
         
-            for(int i = 0; i < vertCount; i++)
+        break;
+        
+    case CYB_PACK_SNORM10_10_10_2:
+        {
+            Uint32 packed;
+            memcpy(&packed, src, sizeof(packed));
+            
+            for(int i = 0; i < comps && i < 3; i++)
             {
-                memcpy(&buf[i].pos, &verts[i], sizeof(verts[i]));
-                memcpy(&buf[i].norm, &norms[i], sizeof(norms[i]));
-                
-                if(tangents)
-                {
-                    memcpy(&buf[i].tangent, &tangents[i], sizeof(tangents[i]));
-                }
-                
-                memcpy(&buf[i].color, &colors[i], sizeof(colors[i]));
-                memcpy(&buf[i].uv, &uvs[i], sizeof(uvs[i]));
+                int value = (int)((packed >> (i * 10)) & 0x3FF);
+                value = value >= 512 ? value - 1024 : value;
+                dest[i] = value < -511 ? -1.0f : value / 511.0f;
             }
-        
-            //Bind VBO, upload geometry data, and free temp buffer
-            glExtAPI->BindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
-            glExtAPI->BufferData(GL_ARRAY_BUFFER, 
-                sizeof(Cyb_VertexVNCT) * vertCount, buf, GL_STATIC_DRAW);
-            SDL_free(buf);
-        
-            //Set vertex format
-            mesh->vFormat = CYB_VERTEX_VNCT;
         }
+        break;
+        
+    default:
+        memcpy(dest, src, sizeof(float) * comps);
+        break;
     }
-    else
+}
+
+
+static int Cyb_ChooseVertexType(const Cyb_Vec3 *norms, const Cyb_Vec4 *colors,
+    const Cyb_Vec2 *uvs)
+{
+    //Colors and uvs are only used together with normals
+    if(!norms)
     {
-        //Assemble geometry data
-        Cyb_VertexV *buf = (Cyb_VertexV*)SDL_malloc(
-            sizeof(Cyb_VertexV) * vertCount);
-            
-        if(!buf)
+        return CYB_VERTEX_V;
+    }
+    
+    if(colors && uvs)
+    {
+        return CYB_VERTEX_VNCT;
+    }
+    else if(colors)
+    {
+        return CYB_VERTEX_VNC;
+    }
+    else if(uvs)
+    {
+        return CYB_VERTEX_VNT;
+    }
+    
+    return CYB_VERTEX_VN;
+}
+
+
+static void Cyb_BuildVertexFormat(Cyb_GLExtAPI *glExtAPI, 
+    const Cyb_VertexLayout *layout, int vFormat, Cyb_VertexFormat *format)
+{
+    //Which attribs does the vertex format have and how are they packed?
+    int hasNorm = vFormat != CYB_VERTEX_V;
+    int hasColor = vFormat == CYB_VERTEX_VNC || vFormat == CYB_VERTEX_VNCT;
+    int hasUV = vFormat == CYB_VERTEX_VNT || vFormat == CYB_VERTEX_VNCT;
+    int present[CYB_MESH_ATTRIB_COUNT] = {TRUE, hasNorm, hasNorm, hasColor, 
+        hasUV};
+    int comps[CYB_MESH_ATTRIB_COUNT] = {3, 3, 3, 4, 2};
+    int packings[CYB_MESH_ATTRIB_COUNT] = {layout->pos, layout->norm,
+        layout->norm, layout->color, layout->uv};
+    
+    //Bitmask of the packings each attrib may use
+    int allowed[CYB_MESH_ATTRIB_COUNT] = {
+        1 << CYB_PACK_HALF | 1 << CYB_PACK_SNORM16,
+        1 << CYB_PACK_HALF | 1 << CYB_PACK_SNORM16 | 1 << CYB_PACK_SNORM10_10_10_2,
+        1 << CYB_PACK_HALF | 1 << CYB_PACK_SNORM16 | 1 << CYB_PACK_SNORM10_10_10_2,
+        1 << CYB_PACK_HALF | 1 << CYB_PACK_UNORM8,
+        1 << CYB_PACK_HALF
+    };
+    
+    //Lay out the attribs one after another on 4 byte boundaries
+    int offset = 0;
+    
+    for(int i = 0; i < CYB_MESH_ATTRIB_COUNT; i++)
+    {
+        Cyb_AttribFormat *attrib = &format->attribs[i];
+        attrib->size = 0;
+        attrib->packing = CYB_PACK_FLOAT;
+        
+        if(!present[i])
         {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
-                "[CybRender] Out of Memory");
-            return CYB_ERROR;
+            continue;
         }
         
-        for(int i = 0; i < vertCount; i++)
+        //Fall back to floats if the packing is not allowed or not supported
+        //(without a GL extension API every packing counts as supported)
+        int packing = packings[i];
+        
+        if(packing < 0 || packing > CYB_PACK_SNORM10_10_10_2 || 
+            !(allowed[i] & (1 << packing)) || (glExtAPI &&
+            ((packing == CYB_PACK_HALF && !glExtAPI->HalfFloatType) ||
+            (packing == CYB_PACK_SNORM10_10_10_2 && !glExtAPI->Int2101010Type))))
         {
-            memcpy(&buf[i].pos, &verts[i], sizeof(verts[i]));
+            packing = CYB_PACK_FLOAT;
         }
         
-        //Bind VBO, upload geometry data, and free temp buffer
-        glExtAPI->BindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
-        glExtAPI->BufferData(GL_ARRAY_BUFFER, sizeof(Cyb_VertexV) * vertCount,
-            buf, GL_STATIC_DRAW);
-        SDL_free(buf);
+        attrib->packing = packing;
+        attrib->comps = comps[i];
+        attrib->size = comps[i];
+        attrib->offset = offset;
         
-        //Set vertex format
-        mesh->vFormat = CYB_VERTEX_V;
+        switch(packing)
+        {
+        case CYB_PACK_HALF:
+            attrib->type = glExtAPI ? glExtAPI->HalfFloatType : GL_HALF_FLOAT;
+            attrib->normalized = GL_FALSE;
+            offset += (2 * comps[i] + 3) & ~3;
+            break;
+            
+        case CYB_PACK_SNORM16:
+            attrib->type = GL_SHORT;
+            attrib->normalized = GL_TRUE;
+            offset += (2 * comps[i] + 3) & ~3;
+            break;
+            
+        case CYB_PACK_UNORM8:
+            attrib->type = GL_UNSIGNED_BYTE;
+            attrib->normalized = GL_TRUE;
+            offset += (comps[i] + 3) & ~3;
+            break;
+            
+        case CYB_PACK_SNORM10_10_10_2:
+            attrib->type = glExtAPI ? glExtAPI->Int2101010Type : 
+                GL_INT_2_10_10_10_REV;
+            attrib->normalized = GL_TRUE;
+            attrib->size = 4;
+            offset += 4;
+            break;
+            
+        default:
+            attrib->type = GL_FLOAT;
+            attrib->normalized = GL_FALSE;
+            offset += 4 * comps[i];
+            break;
+        }
     }
     
-    //Bind and fill EBO
-    glExtAPI->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ebo);
-    glExtAPI->BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indexCount,
-        indices, GL_STATIC_DRAW);
-        
-    //Set index count
-    mesh->indexCount = indexCount;
-    return CYB_NO_ERROR;
+    format->vFormat = vFormat;
+    format->vertSize = offset;
+    Cyb_Identity(&format->dequant);
 }
 
 
-void Cyb_DrawMeshes(Cyb_Renderer *renderer, Cyb_Mesh *mesh, int count)
+static void Cyb_GetDequantMatrix(Cyb_Mat4 *dequant, int vertCount,
+    const Cyb_Vec3 *verts)
 {
-    //Select renderer
-    Cyb_SelectRenderer(renderer);
-    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
-    
-    //Bind VBO and EBO
-    glExtAPI->BindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
-    glExtAPI->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ebo);
+    //Find the bounding box of the positions
+    Cyb_Vec3 min = {0.0f, 0.0f, 0.0f};
+    Cyb_Vec3 max = {0.0f, 0.0f, 0.0f};
     
-    //Setup vertex attrib pointers
-    switch(mesh->vFormat)
-    {
-        //Position only
-    case CYB_VERTEX_V:
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_POS);
-        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_NORM);
-        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_TANGENT);
-        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_COLOR);
-        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_UV);
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_POS, 3, GL_FLOAT, GL_FALSE, 
-            sizeof(Cyb_VertexV), (void*)offsetof(Cyb_VertexV, pos));
-        break;
-        
-        //Position and normal
-    case CYB_VERTEX_VN:
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_POS);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_NORM);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_TANGENT);
-        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_COLOR);
-        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_UV);
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_POS, 3, GL_FLOAT, GL_FALSE, 
-            sizeof(Cyb_VertexVN), (void*)offsetof(Cyb_VertexVN, pos));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_NORM, 3, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVN), (void*)offsetof(Cyb_VertexVN, norm));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_TANGENT, 3, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVN), (void*)offsetof(Cyb_VertexVN, tangent));
-        break;
-        
-        //Position, normal, and color
-    case CYB_VERTEX_VNC:
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_POS);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_NORM);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_TANGENT);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_COLOR);
-        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_UV);
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_POS, 3, GL_FLOAT, GL_FALSE, 
-            sizeof(Cyb_VertexVNC), (void*)offsetof(Cyb_VertexVNC, pos));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_NORM, 3, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNC), (void*)offsetof(Cyb_VertexVNC, norm));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_TANGENT, 3, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNC), (void*)offsetof(Cyb_VertexVNC, tangent));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_COLOR, 4, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNC), (void*)offsetof(Cyb_VertexVNC, color));
-        break;
-        
-        //Position, normal, and texcoord
-    case CYB_VERTEX_VNT:
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_POS);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_NORM);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_TANGENT);
-        glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_COLOR);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_UV);
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_POS, 3, GL_FLOAT, GL_FALSE, 
-            sizeof(Cyb_VertexVNT), (void*)offsetof(Cyb_VertexVNT, pos));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_NORM, 3, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNT), (void*)offsetof(Cyb_VertexVNT, norm));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_TANGENT, 3, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNT), (void*)offsetof(Cyb_VertexVNT, tangent));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_UV, 2, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNT), (void*)offsetof(Cyb_VertexVNT, uv));
-        break;
-        
-        //Position, normal, color, and texcoord
-    case CYB_VERTEX_VNCT:
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_POS);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_NORM);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_TANGENT);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_COLOR);
-        glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_UV);
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_POS, 3, GL_FLOAT, GL_FALSE, 
-            sizeof(Cyb_VertexVNCT), (void*)offsetof(Cyb_VertexVNCT, pos));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_NORM, 3, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNCT), (void*)offsetof(Cyb_VertexVNCT, norm));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_TANGENT, 3, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNCT), (void*)offsetof(Cyb_VertexVNCT, tangent));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_COLOR, 4, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNCT), (void*)offsetof(Cyb_VertexVNCT, color));
-        glExtAPI->VertexAttribPointer(CYB_ATTRIB_UV, 2, GL_FLOAT, GL_FALSE,
-            sizeof(Cyb_VertexVNCT), (void*)offsetof(Cyb_VertexVNCT, uv));
-        break;
+    for(int i = 0; i < vertCount; i++)
+    {
+        if(i == 0 || verts[i].x < min.x) min.x = verts[i].x;
+        if(i == 0 || verts[i].y < min.y) min.y = verts[i].y;
+        if(i == 0 || verts[i].z < min.z) min.z = verts[i].z;
+        if(i == 0 || verts[i].x > max.x) max.x = verts[i].x;
+        if(i == 0 || verts[i].y > max.y) max.y = verts[i].y;
+        if(i == 0 || verts[i].z > max.z) max.z = verts[i].z;
     }
     
-    //Draw the mesh
-    if(count == 1)
+    //Use one scale for all axes so that directions transformed by the model
+    //matrix keep their angles
+    float scale = (max.x - min.x) * 0.5f;
+    scale = (max.y - min.y) * 0.5f > scale ? (max.y - min.y) * 0.5f : scale;
+    scale = (max.z - min.z) * 0.5f > scale ? (max.z - min.z) * 0.5f : scale;
+    
+    if(scale <= 0.0f)
     {
-        glDrawElements(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT, NULL);
+        scale = 1.0f;
     }
-    //Draw multiple mesh instances
-    else
+    
+    //The dequantization matrix maps [-1, 1] back onto the bounds
+    Cyb_Scale(dequant, scale, scale, scale);
+    dequant->d = (min.x + max.x) * 0.5f;
+    dequant->h = (min.y + max.y) * 0.5f;
+    dequant->l = (min.z + max.z) * 0.5f;
+}
+
+
+static void *Cyb_AssembleVertices(const Cyb_VertexFormat *format, int vertCount,
+    const Cyb_Vec3 *verts, const Cyb_Vec3 *norms, const Cyb_Vec3 *tangents, 
+    const Cyb_Vec4 *colors, const Cyb_Vec2 *uvs)
+{
+    //Allocate temp buffer (padding bytes and missing tangents are zeroed)
+    void *buf = SDL_calloc(vertCount, format->vertSize);
+    
+    if(!buf)
     {
-        /* glExtAPI->DrawElementsInstanced(GL_TRIANGLES, mesh->indexCount,
-            GL_UNSIGNED_INT, NULL, count); */
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
-            "[CybRender] Hardware instancing not supported at this time!");
+            "[CybRender] Out of Memory");
+        return NULL;
     }
+    
+    //Positions are quantized relative to the bounds of the mesh
+    const Cyb_AttribFormat *attribs = format->attribs;
+    const Cyb_Mat4 *dequant = &format->dequant;
+    float invScale = 1.0f / dequant->a;
+    
+    //Interleave and pack the vertex data
+    for(int i = 0; i < vertCount; i++)
+    {
+        char *vert = (char*)buf + format->vertSize * i;
+        
+        if(attribs[CYB_ATTRIB_POS].packing == CYB_PACK_SNORM16)
+        {
+            float pos[3] = {
+                (verts[i].x - dequant->d) * invScale,
+                (verts[i].y - dequant->h) * invScale,
+                (verts[i].z - dequant->l) * invScale
+            };
+            Cyb_PackAttrib(vert + attribs[CYB_ATTRIB_POS].offset, pos, 3, 
+                CYB_PACK_SNORM16);
+        }
+        else
+        {
+            Cyb_PackAttrib(vert + attribs[CYB_ATTRIB_POS].offset, 
+                &verts[i].x, 3, attribs[CYB_ATTRIB_POS].packing);
+        }
+        
+        if(attribs[CYB_ATTRIB_NORM].size)
+        {
+            Cyb_PackAttrib(vert + attribs[CYB_ATTRIB_NORM].offset,
+                &norms[i].x, 3, attribs[CYB_ATTRIB_NORM].packing);
+            
+            if(tangents)
+            {
+                Cyb_PackAttrib(vert + attribs[CYB_ATTRIB_TANGENT].offset,
+                    &tangents[i].x, 3, attribs[CYB_ATTRIB_TANGENT].packing);
+            }
+        }
+        
+        if(attribs[CYB_ATTRIB_COLOR].size)
+        {
+            Cyb_PackAttrib(vert + attribs[CYB_ATTRIB_COLOR].offset,
+                &colors[i].x, 4, attribs[CYB_ATTRIB_COLOR].packing);
+        }
+        
+        if(attribs[CYB_ATTRIB_UV].size)
+        {
+            Cyb_PackAttrib(vert + attribs[CYB_ATTRIB_UV].offset,
+                &uvs[i].x, 2, attribs[CYB_ATTRIB_UV].packing);
+        }
+    }
+    
+    return buf;
+}
+
+
+static void *Cyb_RepackVertices(const Cyb_VertexFormat *src, 
+    const Cyb_VertexFormat *dest, int vertCount, const void *data)
+{
+    //Allocate temp buffer (padding bytes are zeroed)
+    void *buf = SDL_calloc(vertCount, dest->vertSize);
+    
+    if(!buf)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        return NULL;
+    }
+    
+    //Convert each attrib through floats (normalized positions keep their 
+    //dequantization matrix)
+    for(int i = 0; i < vertCount; i++)
+    {
+        const char *srcVert = (const char*)data + src->vertSize * i;
+        char *destVert = (char*)buf + dest->vertSize * i;
+        
+        for(int j = 0; j < CYB_MESH_ATTRIB_COUNT; j++)
+        {
+            const Cyb_AttribFormat *srcAttrib = &src->attribs[j];
+            const Cyb_AttribFormat *destAttrib = &dest->attribs[j];
+            float value[4];
+            
+            if(srcAttrib->size)
+            {
+                Cyb_UnpackAttrib(value, srcVert + srcAttrib->offset, 
+                    srcAttrib->comps, srcAttrib->packing);
+                Cyb_PackAttrib(destVert + destAttrib->offset, value, 
+                    destAttrib->comps, destAttrib->packing);
+            }
+        }
+    }
+    
+    return buf;
+}
+
+
+static void Cyb_UnpackPositions(const Cyb_VertexFormat *format, int vertCount,
+    const void *data, Cyb_Vec3 *verts)
+{
+    //Read the positions back and undo their quantization
+    const Cyb_AttribFormat *attrib = &format->attribs[CYB_ATTRIB_POS];
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        float pos[3];
+        Cyb_UnpackAttrib(pos, (const char*)data + format->vertSize * i + 
+            attrib->offset, 3, attrib->packing);
+        verts[i].x = pos[0] * format->dequant.a + format->dequant.d;
+        verts[i].y = pos[1] * format->dequant.f + format->dequant.h;
+        verts[i].z = pos[2] * format->dequant.k + format->dequant.l;
+    }
+}
+
+
+static int Cyb_GetDescFormat(const Cyb_VertexDesc *desc, 
+    Cyb_VertexFormat *format)
+{
+    //Ensure that the vertex descriptor is valid
+    if(desc->vFormat < CYB_VERTEX_V || desc->vFormat > CYB_VERTEX_VNCT ||
+        (desc->layout.pos == CYB_PACK_SNORM16 && desc->posScale <= 0.0f))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Invalid vertex descriptor.");
+        return CYB_ERROR;
+    }
+    
+    //Lay out the vertex data as if every packing was supported
+    Cyb_BuildVertexFormat(NULL, &desc->layout, desc->vFormat, format);
+    
+    if(format->attribs[CYB_ATTRIB_POS].packing == CYB_PACK_SNORM16)
+    {
+        Cyb_Scale(&format->dequant, desc->posScale, desc->posScale, 
+            desc->posScale);
+        format->dequant.d = desc->posCenter.x;
+        format->dequant.h = desc->posCenter.y;
+        format->dequant.l = desc->posCenter.z;
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+static void Cyb_WaitFence(Cyb_GLExtAPI *glExtAPI, GLsync *fence)
+{
+    //Wait until the GPU has passed the fence and delete it
+    if(!*fence)
+    {
+        return;
+    }
+    
+    GLenum result;
+    
+    do
+    {
+        result = glExtAPI->ClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT, 
+            CYB_STREAM_WAIT_TIMEOUT);
+    }
+    while(result == GL_TIMEOUT_EXPIRED);
+    
+    glExtAPI->DeleteSync(*fence);
+    *fence = NULL;
+}
+
+
+static int Cyb_ReplaceVBO(Cyb_Renderer *renderer, Cyb_Mesh *mesh)
+{
+    //Delete the fences of the ring buffer
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    for(int i = 0; i < CYB_STREAM_SEGMENTS; i++)
+    {
+        if(mesh->streamFences[i])
+        {
+            glExtAPI->DeleteSync(mesh->streamFences[i]);
+            mesh->streamFences[i] = NULL;
+        }
+    }
+    
+    //Buffers with immutable storage cannot be resized, so replace the VBO 
+    //(deleting a buffer also unmaps it)
+    Cyb_DeleteBuffers(renderer, 1, &mesh->vbo);
+    glExtAPI->GenBuffers(1, &mesh->vbo);
+    mesh->vboSize = 0;
+    mesh->vboOffset = 0;
+    mesh->streamMap = NULL;
+    mesh->streamSegSize = 0;
+    
+    if(!mesh->vbo)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
+            "[CybRender] Failed to allocate VBO.");
+        return CYB_ERROR;
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_WriteStreamVertices(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    const void *data, GLsizeiptr size)
+{
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    //Allocate a bigger ring buffer?
+    if(!mesh->streamMap || size > mesh->streamSegSize)
+    {
+        //Never shrink the segments
+        GLsizeiptr segSize = size > mesh->streamSegSize ? size : 
+            mesh->streamSegSize;
+        
+        if(mesh->streamMap && Cyb_ReplaceVBO(renderer, mesh))
+        {
+            return CYB_ERROR;
+        }
+        
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | 
+            GL_MAP_COHERENT_BIT;
+        Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, mesh->vbo);
+        glExtAPI->BufferStorage(GL_ARRAY_BUFFER, 
+            segSize * CYB_STREAM_SEGMENTS, NULL, flags);
+        mesh->streamMap = glExtAPI->MapBufferRange(GL_ARRAY_BUFFER, 0,
+            segSize * CYB_STREAM_SEGMENTS, flags);
+        
+        if(!mesh->streamMap)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Failed to map the ring buffer of a streaming mesh.");
+            Cyb_ReplaceVBO(renderer, mesh);
+            return CYB_ERROR;
+        }
+        
+        mesh->streamSegSize = segSize;
+        mesh->streamSegment = 0;
+    }
+    //Move on to the next segment once the GPU is done with it
+    else
+    {
+        mesh->streamFences[mesh->streamSegment] = glExtAPI->FenceSync(
+            GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        mesh->streamSegment = (mesh->streamSegment + 1) % CYB_STREAM_SEGMENTS;
+        Cyb_WaitFence(glExtAPI, &mesh->streamFences[mesh->streamSegment]);
+    }
+    
+    //Write the vertices (the mapping is coherent so no flush is needed)
+    mesh->vboOffset = mesh->streamSegSize * mesh->streamSegment;
+    memcpy((char*)mesh->streamMap + mesh->vboOffset, data, size);
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_UploadVertices(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    const void *data, GLsizeiptr size)
+{
+    //Use a ring buffer for streaming meshes if possible
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    Cyb_AddUploadStats(renderer, size);
+    
+    if(mesh->usage == CYB_BUFFER_STREAM && glExtAPI->BufferStorage &&
+        !Cyb_WriteStreamVertices(renderer, mesh, data, size))
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    //Leave the ring buffer
+    if(mesh->streamMap && Cyb_ReplaceVBO(renderer, mesh))
+    {
+        return CYB_ERROR;
+    }
+    
+    mesh->vboOffset = 0;
+    Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, mesh->vbo);
+    GLenum usage = Cyb_GetGLUsage(mesh->usage);
+    
+    //Dynamic and streaming meshes keep their buffer size and orphan the old
+    //storage so the driver can hand out fresh memory without a sync
+    //(respecifying the whole buffer orphans it as well)
+    if(mesh->usage != CYB_BUFFER_STATIC && size < mesh->vboSize)
+    {
+        glExtAPI->BufferData(GL_ARRAY_BUFFER, mesh->vboSize, NULL, usage);
+        glExtAPI->BufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    }
+    else
+    {
+        glExtAPI->BufferData(GL_ARRAY_BUFFER, size, data, usage);
+        mesh->vboSize = size;
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_UploadInstances(Cyb_Renderer *renderer, Cyb_Mesh *mesh)
+{
+    //The instance data stays on the CPU if instances are drawn one at a time
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    if(!glExtAPI->DrawElementsInstanced)
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    //Allocate instance VBO upon first use
+    if(!mesh->instanceVBO)
+    {
+        glExtAPI->GenBuffers(1, &mesh->instanceVBO);
+        
+        if(!mesh->instanceVBO)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
+                "[CybRender] Failed to allocate instance VBO.");
+            mesh->instanceCount = 0;
+            return CYB_ERROR;
+        }
+    }
+    
+    //Bind instance VBO and upload instance data (orphaning the old storage 
+    //if the new data is smaller)
+    GLsizeiptr size = sizeof(Cyb_InstanceData) * mesh->instanceCount;
+    Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, mesh->instanceVBO);
+    Cyb_AddUploadStats(renderer, size);
+    
+    if(size < mesh->instanceVBOSize)
+    {
+        glExtAPI->BufferData(GL_ARRAY_BUFFER, mesh->instanceVBOSize, NULL,
+            GL_STREAM_DRAW);
+        glExtAPI->BufferSubData(GL_ARRAY_BUFFER, 0, size, mesh->instances);
+    }
+    else
+    {
+        glExtAPI->BufferData(GL_ARRAY_BUFFER, size, mesh->instances, 
+            GL_STREAM_DRAW);
+        mesh->instanceVBOSize = size;
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_AllocRange(Cyb_RangeList *list, int count)
+{
+    //Take the range from the first free range that is big enough
+    if(count <= 0)
+    {
+        return 0;
+    }
+    
+    for(int i = 0; i < list->count; i++)
+    {
+        Cyb_Range *range = &list->ranges[i];
+        
+        if(range->count < count)
+        {
+            continue;
+        }
+        
+        int start = range->start;
+        range->start += count;
+        range->count -= count;
+        
+        //Remove the free range if it was used up
+        if(!range->count)
+        {
+            memmove(range, range + 1, sizeof(Cyb_Range) * 
+                (list->count - i - 1));
+            list->count--;
+        }
+        
+        return start;
+    }
+    
+    return -1;
+}
+
+
+static void Cyb_FreeRange(Cyb_RangeList *list, int start, int count)
+{
+    if(count <= 0)
+    {
+        return;
+    }
+    
+    //Find the first free range after the range (the list is sorted)
+    int i = 0;
+    
+    while(i < list->count && list->ranges[i].start < start)
+    {
+        i++;
+    }
+    
+    //Merge the range with its neighbors
+    int joinPrev = i > 0 && 
+        list->ranges[i - 1].start + list->ranges[i - 1].count == start;
+    int joinNext = i < list->count && start + count == list->ranges[i].start;
+    
+    if(joinPrev && joinNext)
+    {
+        list->ranges[i - 1].count += count + list->ranges[i].count;
+        memmove(&list->ranges[i], &list->ranges[i + 1], sizeof(Cyb_Range) * 
+            (list->count - i - 1));
+        list->count--;
+        return;
+    }
+    else if(joinPrev)
+    {
+        list->ranges[i - 1].count += count;
+        return;
+    }
+    else if(joinNext)
+    {
+        list->ranges[i].start = start;
+        list->ranges[i].count += count;
+        return;
+    }
+    
+    //Grow the list
+    if(list->count == list->cap)
+    {
+        int cap = list->cap ? list->cap * 2 : 8;
+        Cyb_Range *ranges = (Cyb_Range*)SDL_realloc(list->ranges, 
+            sizeof(Cyb_Range) * cap);
+        
+        //The range is lost until the next defragmentation
+        if(!ranges)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Out of Memory");
+            return;
+        }
+        
+        list->ranges = ranges;
+        list->cap = cap;
+    }
+    
+    //Insert the range
+    memmove(&list->ranges[i + 1], &list->ranges[i], sizeof(Cyb_Range) * 
+        (list->count - i));
+    list->ranges[i].start = start;
+    list->ranges[i].count = count;
+    list->count++;
+}
+
+
+static void Cyb_ResetRanges(Cyb_RangeList *list, int start, int count)
+{
+    //Make the range the only free range
+    list->count = 0;
+    Cyb_FreeRange(list, start, count);
+}
+
+
+static int Cyb_SameVertexFormat(const Cyb_VertexFormat *a, 
+    const Cyb_VertexFormat *b)
+{
+    //The dequantization matrix only affects the instance data
+    if(a->vFormat != b->vFormat || a->vertSize != b->vertSize)
+    {
+        return FALSE;
+    }
+    
+    for(int i = 0; i < CYB_MESH_ATTRIB_COUNT; i++)
+    {
+        const Cyb_AttribFormat *attribA = &a->attribs[i];
+        const Cyb_AttribFormat *attribB = &b->attribs[i];
+        
+        if(attribA->size != attribB->size || attribA->type != attribB->type ||
+            attribA->normalized != attribB->normalized ||
+            attribA->offset != attribB->offset)
+        {
+            return FALSE;
+        }
+    }
+    
+    return TRUE;
+}
+
+
+static GLuint Cyb_AllocPoolBuffer(Cyb_Renderer *renderer, GLsizeiptr size)
+{
+    //Allocate the storage through the copy target so that the element 
+    //buffer binding of the current VAO is left alone
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    GLuint buf = 0;
+    glExtAPI->GenBuffers(1, &buf);
+    
+    if(!buf)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
+            "[CybRender] Failed to allocate geometry arena buffer.");
+        return 0;
+    }
+    
+    Cyb_BindBuffer(renderer, GL_COPY_WRITE_BUFFER, buf);
+    glExtAPI->BufferData(GL_COPY_WRITE_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+    return buf;
+}
+
+
+static void Cyb_BuildPoolVAO(Cyb_Renderer *renderer, Cyb_ArenaPool *pool)
+{
+    //Every mesh in the pool is drawn with this VAO and a base vertex
+    Cyb_BindVertexArray(renderer, pool->vao);
+    Cyb_SetupAttribPointers(renderer, &pool->format, pool->vbo, pool->ebo, 0);
+    Cyb_BindVertexArray(renderer, 0);
+}
+
+
+static void Cyb_FreeArenaPool(Cyb_Renderer *renderer, Cyb_ArenaPool *pool)
+{
+    //Free the buffers and VAO
+    if(pool->vao)
+    {
+        Cyb_DeleteVertexArrays(renderer, 1, &pool->vao);
+    }
+    
+    if(pool->vbo)
+    {
+        Cyb_DeleteBuffers(renderer, 1, &pool->vbo);
+    }
+    
+    if(pool->ebo)
+    {
+        Cyb_DeleteBuffers(renderer, 1, &pool->ebo);
+    }
+    
+    //Free the free lists and mesh list
+    SDL_free(pool->freeVerts.ranges);
+    SDL_free(pool->freeIndices.ranges);
+    SDL_free(pool->meshes);
+    SDL_free(pool);
+}
+
+
+static Cyb_ArenaPool *Cyb_CreateArenaPool(Cyb_Renderer *renderer, 
+    Cyb_GeometryArena *arena, const Cyb_VertexFormat *format, 
+    GLenum indexType, int vertCount, int indexCount)
+{
+    //Grow the pool list
+    Cyb_ArenaPool **pools = (Cyb_ArenaPool**)SDL_realloc(arena->pools, 
+        sizeof(Cyb_ArenaPool*) * (arena->poolCount + 1));
+    
+    if(!pools)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
+            "[CybRender] Out of Memory");
+        return NULL;
+    }
+    
+    arena->pools = pools;
+    
+    //Allocate new pool
+    Cyb_ArenaPool *pool = (Cyb_ArenaPool*)SDL_calloc(1, sizeof(Cyb_ArenaPool));
+    
+    if(!pool)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
+            "[CybRender] Out of Memory");
+        return NULL;
+    }
+    
+    //Meshes which are bigger than the pool size get a pool of their own size
+    pool->arena = arena;
+    pool->format = *format;
+    pool->indexType = indexType;
+    pool->indexSize = Cyb_GetIndexSize(indexType);
+    pool->vertCap = vertCount > arena->vertCap ? vertCount : arena->vertCap;
+    pool->indexCap = indexCount > arena->indexCap ? indexCount : 
+        arena->indexCap;
+    pool->vbo = Cyb_AllocPoolBuffer(renderer, 
+        (GLsizeiptr)format->vertSize * pool->vertCap);
+    pool->ebo = Cyb_AllocPoolBuffer(renderer, 
+        (GLsizeiptr)pool->indexSize * pool->indexCap);
+    Cyb_GetGLExtAPI(renderer)->GenVertexArrays(1, &pool->vao);
+    
+    if(!pool->vbo || !pool->ebo || !pool->vao)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
+            "[CybRender] Failed to create geometry arena pool.");
+        Cyb_FreeArenaPool(renderer, pool);
+        return NULL;
+    }
+    
+    Cyb_BuildPoolVAO(renderer, pool);
+    Cyb_ResetRanges(&pool->freeVerts, 0, pool->vertCap);
+    Cyb_ResetRanges(&pool->freeIndices, 0, pool->indexCap);
+    
+    //Add the pool to the arena
+    arena->pools[arena->poolCount++] = pool;
+    return pool;
+}
+
+
+static void Cyb_ReleaseArenaBlock(Cyb_Mesh *mesh)
+{
+    //Is the mesh in a geometry arena?
+    Cyb_ArenaPool *pool = mesh->pool;
+    
+    if(!pool)
+    {
+        return;
+    }
+    
+    //Return the block to the pool
+    Cyb_FreeRange(&pool->freeVerts, mesh->firstVert, mesh->vertCap);
+    Cyb_FreeRange(&pool->freeIndices, mesh->firstIndex, mesh->indexCap);
+    
+    for(int i = 0; i < pool->meshCount; i++)
+    {
+        if(pool->meshes[i] == mesh)
+        {
+            pool->meshes[i] = pool->meshes[--pool->meshCount];
+            break;
+        }
+    }
+    
+    mesh->pool = NULL;
+    mesh->firstVert = 0;
+    mesh->vertCap = 0;
+    mesh->firstIndex = 0;
+    mesh->indexCap = 0;
+    mesh->vboOffset = 0;
+    mesh->indexOffset = 0;
+    
+    //Release the reference to the arena held by the block
+    Cyb_GeometryArena *arena = pool->arena;
+    Cyb_FreeObject((Cyb_Object**)&arena);
+}
+
+
+static int Cyb_AllocArenaBlock(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    const Cyb_VertexFormat *format, GLenum indexType, int vertCount, 
+    int indexCount)
+{
+    //Keep the current block if it is big enough and return the rest of it
+    Cyb_GeometryArena *arena = mesh->arena;
+    Cyb_ArenaPool *pool = mesh->pool;
+    
+    if(pool && pool->arena == arena && pool->indexType == indexType &&
+        Cyb_SameVertexFormat(&pool->format, format) && 
+        vertCount <= mesh->vertCap && indexCount <= mesh->indexCap)
+    {
+        Cyb_FreeRange(&pool->freeVerts, mesh->firstVert + vertCount, 
+            mesh->vertCap - vertCount);
+        Cyb_FreeRange(&pool->freeIndices, mesh->firstIndex + indexCount,
+            mesh->indexCap - indexCount);
+        mesh->vertCap = vertCount;
+        mesh->indexCap = indexCount;
+        return CYB_NO_ERROR;
+    }
+    
+    //Keep the arena alive while the old block is released
+    arena = (Cyb_GeometryArena*)Cyb_NewObjectRef((Cyb_Object*)arena);
+    Cyb_ReleaseArenaBlock(mesh);
+    
+    //Find a pool with the same format that has room for the mesh
+    int firstVert = -1;
+    int firstIndex = -1;
+    pool = NULL;
+    
+    for(int i = 0; i < arena->poolCount; i++)
+    {
+        Cyb_ArenaPool *candidate = arena->pools[i];
+        
+        if(candidate->indexType != indexType || 
+            !Cyb_SameVertexFormat(&candidate->format, format))
+        {
+            continue;
+        }
+        
+        firstVert = Cyb_AllocRange(&candidate->freeVerts, vertCount);
+        
+        if(firstVert < 0)
+        {
+            continue;
+        }
+        
+        firstIndex = Cyb_AllocRange(&candidate->freeIndices, indexCount);
+        
+        if(firstIndex < 0)
+        {
+            Cyb_FreeRange(&candidate->freeVerts, firstVert, vertCount);
+            continue;
+        }
+        
+        pool = candidate;
+        break;
+    }
+    
+    //Create a new pool?
+    if(!pool)
+    {
+        pool = Cyb_CreateArenaPool(renderer, arena, format, indexType, 
+            vertCount, indexCount);
+        
+        if(!pool)
+        {
+            Cyb_FreeObject((Cyb_Object**)&arena);
+            return CYB_ERROR;
+        }
+        
+        firstVert = Cyb_AllocRange(&pool->freeVerts, vertCount);
+        firstIndex = Cyb_AllocRange(&pool->freeIndices, indexCount);
+    }
+    
+    //Add the mesh to the pool
+    if(pool->meshCount == pool->meshCap)
+    {
+        int cap = pool->meshCap ? pool->meshCap * 2 : 16;
+        Cyb_Mesh **meshes = (Cyb_Mesh**)SDL_realloc(pool->meshes, 
+            sizeof(Cyb_Mesh*) * cap);
+        
+        if(!meshes)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
+                "[CybRender] Out of Memory");
+            Cyb_FreeRange(&pool->freeVerts, firstVert, vertCount);
+            Cyb_FreeRange(&pool->freeIndices, firstIndex, indexCount);
+            Cyb_FreeObject((Cyb_Object**)&arena);
+            return CYB_ERROR;
+        }
+        
+        pool->meshes = meshes;
+        pool->meshCap = cap;
+    }
+    
+    pool->meshes[pool->meshCount++] = mesh;
+    
+    //The block keeps the reference to the arena
+    mesh->pool = pool;
+    mesh->firstVert = firstVert;
+    mesh->vertCap = vertCount;
+    mesh->firstIndex = firstIndex;
+    mesh->indexCap = indexCount;
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_CreateMeshBuffers(Cyb_Renderer *renderer, Cyb_Mesh *mesh)
+{
+    //Allocate the buffers which are missing
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    if(!mesh->vbo)
+    {
+        glExtAPI->GenBuffers(1, &mesh->vbo);
+        
+        if(!mesh->vbo)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", 
+                "[CybRender] Failed to allocate VBO.");
+            return CYB_ERROR;
+        }
+    }
+    
+    if(!mesh->ebo)
+    {
+        glExtAPI->GenBuffers(1, &mesh->ebo);
+        
+        if(!mesh->ebo)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Failed to allocate EBO.");
+            return CYB_ERROR;
+        }
+    }
+    
+    //Allocate VAO if supported
+    if(glExtAPI->GenVertexArrays && !mesh->vao)
+    {
+        glExtAPI->GenVertexArrays(1, &mesh->vao);
+        
+        if(!mesh->vao)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Failed to allocate VAO.");
+            return CYB_ERROR;
+        }
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+static void Cyb_DeleteMeshBuffers(Cyb_Renderer *renderer, Cyb_Mesh *mesh)
+{
+    //Free VAO
+    if(mesh->vao)
+    {
+        Cyb_DeleteVertexArrays(renderer, 1, &mesh->vao);
+        mesh->vao = 0;
+    }
+    
+    //Free fences of the ring buffer
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    for(int i = 0; i < CYB_STREAM_SEGMENTS; i++)
+    {
+        if(mesh->streamFences[i])
+        {
+            glExtAPI->DeleteSync(mesh->streamFences[i]);
+            mesh->streamFences[i] = NULL;
+        }
+    }
+    
+    //Free VBO (this also unmaps the ring buffer)
+    if(mesh->vbo)
+    {
+        Cyb_DeleteBuffers(renderer, 1, &mesh->vbo);
+        mesh->vbo = 0;
+    }
+    
+    //Free EBO
+    if(mesh->ebo)
+    {
+        Cyb_DeleteBuffers(renderer, 1, &mesh->ebo);
+        mesh->ebo = 0;
+    }
+    
+    mesh->vboSize = 0;
+    mesh->eboSize = 0;
+    mesh->streamMap = NULL;
+    mesh->streamSegSize = 0;
+}
+
+
+void Cyb_FreeMesh(Cyb_Mesh *mesh)
+{
+    //Unbind the VAO
+    Cyb_Renderer *renderer = mesh->renderer;
+    Cyb_SelectRenderer(renderer);
+    Cyb_BindVertexArray(renderer, 0);
+    
+    //Free the buffers of the mesh
+    Cyb_DeleteMeshBuffers(renderer, mesh);
+    
+    if(mesh->skinVAO)
+    {
+        Cyb_DeleteVertexArrays(renderer, 1, &mesh->skinVAO);
+    }
+    
+    Cyb_FreeObject((Cyb_Object**)&mesh->skinArmature);
+    
+    //Free instance VBOs
+    if(mesh->instanceVBO)
+    {
+        Cyb_DeleteBuffers(renderer, 1, &mesh->instanceVBO);
+    }
+    
+    if(mesh->tempInstanceVBO)
+    {
+        Cyb_DeleteBuffers(renderer, 1, &mesh->tempInstanceVBO);
+    }
+    
+    //Leave the geometry arena
+    Cyb_ReleaseArenaBlock(mesh);
+    Cyb_FreeObject((Cyb_Object**)&mesh->arena);
+    
+    //Free CPU geometry copy and instance data
+    SDL_free(mesh->verts);
+    SDL_free(mesh->indices);
+    SDL_free(mesh->instances);
+    SDL_free(mesh->tempInstances);
+    SDL_free(mesh->streamData);
+}
+
+
+Cyb_Mesh *Cyb_CreateMesh(Cyb_Renderer *renderer)
+{
+    //Allocate new mesh
+    Cyb_Mesh *mesh = (Cyb_Mesh*)Cyb_CreateObject(sizeof(Cyb_Mesh),
+        (Cyb_FreeProc)&Cyb_FreeMesh, CYB_MESH);
+        
+    if(!mesh)
+    {
+        return NULL;
+    }
+    
+    //Initialize the mesh
+    Cyb_SetMeshVertexLayout(mesh, NULL);
+    memset(&mesh->format, 0, sizeof(Cyb_VertexFormat));
+    mesh->format.vFormat = CYB_VERTEX_UNKNOWN;
+    Cyb_Identity(&mesh->format.dequant);
+    mesh->indexType = GL_UNSIGNED_INT;
+    mesh->usage = CYB_BUFFER_STATIC;
+    mesh->bufVertCount = 0;
+    mesh->renderer = renderer;
+    mesh->vboSize = 0;
+    mesh->eboSize = 0;
+    mesh->vboOffset = 0;
+    mesh->indexOffset = 0;
+    mesh->arena = NULL;
+    mesh->pool = NULL;
+    mesh->firstVert = 0;
+    mesh->vertCap = 0;
+    mesh->firstIndex = 0;
+    mesh->indexCap = 0;
+    mesh->vbo = 0;
+    mesh->ebo = 0;
+    mesh->streamData = NULL;
+    mesh->streamMap = NULL;
+    mesh->streamSegSize = 0;
+    mesh->streamSegment = 0;
+
+    mesh->retainGeometry = FALSE;
+    mesh->vertCount = 0;
+    mesh->verts = NULL;
+    mesh->indices = NULL;
+    memset(&mesh->bounds, 0, sizeof(Cyb_Sphere));
+    mesh->lodCount = 0;
+    mesh->instanceVBO = 0;
+    mesh->instanceVBOSize = 0;
+    mesh->instanceCount = 0;
+    mesh->instanceCap = 0;
+    mesh->instances = NULL;
+    mesh->tempInstanceVBO = 0;
+    mesh->tempInstanceVBOSize = 0;
+    mesh->tempInstanceCap = 0;
+    mesh->tempInstances = NULL;
+    mesh->vao = 0;
+    mesh->skinVAO = 0;
+    mesh->skinArmature = NULL;
+    
+    for(int i = 0; i < CYB_STREAM_SEGMENTS; i++)
+    {
+        mesh->streamFences[i] = NULL;
+    }
+    
+    //Allocate the buffers
+    Cyb_SelectRenderer(renderer);
+    
+    if(Cyb_CreateMeshBuffers(renderer, mesh))
+    {
+        Cyb_FreeObject((Cyb_Object**)&mesh);
+        return NULL;
+    }
+
+    return mesh;
+}
+
+
+static int Cyb_UploadMeshGeometry(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    const Cyb_VertexFormat *format, int vertCount, const void *data,
+    GLenum indexType, int indexCount, const void *indexData)
+{
+    //Leave the geometry arena
+    Cyb_ReleaseArenaBlock(mesh);
+    
+    if(Cyb_CreateMeshBuffers(renderer, mesh))
+    {
+        return CYB_ERROR;
+    }
+    
+    //Upload vertex data
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    if(Cyb_UploadVertices(renderer, mesh, data, 
+        (GLsizeiptr)format->vertSize * vertCount))
+    {
+        return CYB_ERROR;
+    }
+    
+    //Bind and fill EBO (outside of any VAO)
+    GLsizeiptr indexSize = (GLsizeiptr)Cyb_GetIndexSize(indexType) * 
+        indexCount;
+    GLenum usage = Cyb_GetGLUsage(mesh->usage);
+    Cyb_BindVertexArray(renderer, 0);
+    Cyb_BindBuffer(renderer, GL_ELEMENT_ARRAY_BUFFER, mesh->ebo);
+    Cyb_AddUploadStats(renderer, indexSize);
+    
+    if(mesh->usage != CYB_BUFFER_STATIC && indexSize < mesh->eboSize)
+    {
+        glExtAPI->BufferData(GL_ELEMENT_ARRAY_BUFFER, mesh->eboSize, NULL, 
+            usage);
+        glExtAPI->BufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexSize, 
+            indexData);
+    }
+    else
+    {
+        glExtAPI->BufferData(GL_ELEMENT_ARRAY_BUFFER, indexSize, indexData, 
+            usage);
+        mesh->eboSize = indexSize;
+    }
+    
+    mesh->indexOffset = 0;
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_UploadArenaGeometry(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    const Cyb_VertexFormat *format, int vertCount, const void *data,
+    GLenum indexType, int indexCount, const void *indexData)
+{
+    //Get a block of a pool of the geometry arena
+    if(Cyb_AllocArenaBlock(renderer, mesh, format, indexType, vertCount, 
+        indexCount))
+    {
+        return CYB_ERROR;
+    }
+    
+    //The buffers of the mesh are no longer needed
+    Cyb_DeleteMeshBuffers(renderer, mesh);
+    
+    //Write the vertices and indices into the block (outside of any VAO)
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    Cyb_ArenaPool *pool = mesh->pool;
+    mesh->vboOffset = (GLintptr)format->vertSize * mesh->firstVert;
+    mesh->indexOffset = (GLintptr)pool->indexSize * mesh->firstIndex;
+    Cyb_BindVertexArray(renderer, 0);
+    Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, pool->vbo);
+    glExtAPI->BufferSubData(GL_ARRAY_BUFFER, mesh->vboOffset, 
+        (GLsizeiptr)format->vertSize * vertCount, data);
+    Cyb_BindBuffer(renderer, GL_ELEMENT_ARRAY_BUFFER, pool->ebo);
+    glExtAPI->BufferSubData(GL_ELEMENT_ARRAY_BUFFER, mesh->indexOffset,
+        (GLsizeiptr)pool->indexSize * indexCount, indexData);
+    Cyb_AddUploadStats(renderer, (size_t)format->vertSize * vertCount + 
+        (size_t)pool->indexSize * indexCount);
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_SetMeshData(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    const Cyb_VertexFormat *format, int vertCount, const void *data, 
+    void *ownedData, const Cyb_Vec3 *verts, int indexCount, 
+    const unsigned int *indices)
+{
+    //The mesh takes ownership of the owned data (which must be given if the
+    //mesh may use a ring buffer) and the positions are read back from the 
+    //vertex data if they are not given
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    //Meshes with fewer than 65536 vertices use 16-bit indices
+    const void *indexData = indices;
+    Uint16 *shortIndices = NULL;
+    GLenum indexType = GL_UNSIGNED_INT;
+    
+    if(vertCount < 65536)
+    {
+        shortIndices = (Uint16*)SDL_malloc(sizeof(Uint16) * indexCount);
+        
+        if(shortIndices)
+        {
+            for(int i = 0; i < indexCount; i++)
+            {
+                shortIndices[i] = (Uint16)indices[i];
+            }
+            
+            indexData = shortIndices;
+            indexType = GL_UNSIGNED_SHORT;
+        }
+    }
+    
+    //Upload the geometry into the geometry arena if the driver supports it
+    int result;
+    
+    if(mesh->arena && glExtAPI->DrawElementsBaseVertex && 
+        glExtAPI->GenVertexArrays)
+    {
+        result = Cyb_UploadArenaGeometry(renderer, mesh, format, vertCount, 
+            data, indexType, indexCount, indexData);
+    }
+    //Upload the geometry into the buffers of the mesh
+    else
+    {
+        result = Cyb_UploadMeshGeometry(renderer, mesh, format, vertCount, 
+            data, indexType, indexCount, indexData);
+    }
+    
+    SDL_free(shortIndices);
+    
+    if(result)
+    {
+        SDL_free(ownedData);
+        return CYB_ERROR;
+    }
+    
+    //Ring buffers keep the vertex data for range updates (otherwise it is
+    //freed at the end)
+    void *tempData = NULL;
+    SDL_free(mesh->streamData);
+    mesh->streamData = NULL;
+    
+    if(mesh->streamMap)
+    {
+        mesh->streamData = ownedData;
+    }
+    else
+    {
+        tempData = ownedData;
+    }
+    
+    //Move the instances to the new dequantization matrix
+    if(mesh->instanceCount && 
+        memcmp(&format->dequant, &mesh->format.dequant, sizeof(Cyb_Mat4)))
+    {
+        Cyb_Mat4 change;
+        Cyb_Mat4 tmp;
+        Cyb_Invert(&tmp, &mesh->format.dequant);
+        Cyb_MulMat4(&change, &tmp, &format->dequant);
+        
+        for(int i = 0; i < mesh->instanceCount; i++)
+        {
+            tmp = mesh->instances[i].model;
+            Cyb_MulMat4(&mesh->instances[i].model, &tmp, &change);
+        }
+        
+        Cyb_UploadInstances(renderer, mesh);
+    }
+    
+    //Set vertex format and index type
+    mesh->format = *format;
+    mesh->bufVertCount = vertCount;
+    mesh->indexType = indexType;
+    
+    //Set index count (the levels of detail refer to the old indices)
+    mesh->indexCount = indexCount;
+    mesh->lodCount = 0;
+    
+    //Rebuild the VAOs for the new vertex format
+    Cyb_RebuildVAOs(renderer, mesh);
+    
+    //Find the bounding sphere (the positions are read back from the vertex
+    //data if they are not given)
+    Cyb_Vec3 *unpacked = NULL;
+    
+    if(!verts && vertCount)
+    {
+        unpacked = (Cyb_Vec3*)SDL_malloc(sizeof(Cyb_Vec3) * vertCount);
+        
+        if(unpacked)
+        {
+            Cyb_UnpackPositions(format, vertCount, data, unpacked);
+        }
+    }
+    
+    memset(&mesh->bounds, 0, sizeof(Cyb_Sphere));
+    
+    if(verts || unpacked)
+    {
+        Cyb_SphereFromGeometry(&mesh->bounds, verts ? verts : unpacked, 
+            sizeof(Cyb_Vec3), vertCount, CYB_SPHERE_EPOS6);
+    }
+    
+    //Keep a CPU copy of the geometry for ray casts?
+    if(mesh->retainGeometry)
+    {
+        Cyb_Vec3 *vertCopy = (Cyb_Vec3*)SDL_realloc(mesh->verts, 
+            sizeof(Cyb_Vec3) * vertCount);
+        
+        if(vertCopy)
+        {
+            mesh->verts = vertCopy;
+        }
+        
+        unsigned int *indexCopy = (unsigned int*)SDL_realloc(mesh->indices,
+            sizeof(unsigned int) * indexCount);
+            
+        if(indexCopy)
+        {
+            mesh->indices = indexCopy;
+        }
+        
+        if(!vertCopy || !indexCopy)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Out of Memory");
+            mesh->vertCount = 0;
+            SDL_free(unpacked);
+            SDL_free(tempData);
+            return CYB_ERROR;
+        }
+        
+        if(verts || unpacked)
+        {
+            memcpy(mesh->verts, verts ? verts : unpacked, 
+                sizeof(Cyb_Vec3) * vertCount);
+        }
+        else
+        {
+            Cyb_UnpackPositions(format, vertCount, data, mesh->verts);
+        }
+        
+        memcpy(mesh->indices, indices, sizeof(unsigned int) * indexCount);
+        mesh->vertCount = vertCount;
+    }
+    
+    SDL_free(unpacked);
+    SDL_free(tempData);
+    return CYB_NO_ERROR;
+}
+
+
+int Cyb_UpdateMesh(Cyb_Renderer *renderer, Cyb_Mesh *mesh, int vertCount, 
+    const Cyb_Vec3 *verts, const Cyb_Vec3 *norms, const Cyb_Vec3 *tangents, 
+    const Cyb_Vec4 *colors, const Cyb_Vec2 *uvs, int indexCount, 
+    const unsigned int *indices)
+{
+    //Ensure that vertices and indices were given
+    if(!verts || !indices)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Function 'Cyb_UpdateMesh' requires at least an array of vertices and indices.");
+        return CYB_ERROR;
+    }
+    
+    //Select the renderer
+    Cyb_SelectRenderer(renderer);
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    //Choose the vertex data format and lay out the vertex data
+    int vFormat = Cyb_ChooseVertexType(norms, colors, uvs);
+    Cyb_VertexFormat format;
+    Cyb_BuildVertexFormat(glExtAPI, &mesh->layout, vFormat, &format);
+    
+    if(format.attribs[CYB_ATTRIB_POS].packing == CYB_PACK_SNORM16)
+    {
+        Cyb_GetDequantMatrix(&format.dequant, vertCount, verts);
+    }
+    
+    //Assemble and upload geometry data
+    void *buf = Cyb_AssembleVertices(&format, vertCount, verts, norms, 
+        tangents, colors, uvs);
+        
+    if(!buf)
+    {
+        return CYB_ERROR;
+    }
+    
+    return Cyb_SetMeshData(renderer, mesh, &format, vertCount, buf, buf, verts,
+        indexCount, indices);
+}
+
+
+int Cyb_GetVertexSize(const Cyb_VertexDesc *desc)
+{
+    Cyb_VertexFormat format;
+    
+    if(Cyb_GetDescFormat(desc, &format))
+    {
+        return 0;
+    }
+    
+    return format.vertSize;
+}
+
+
+void *Cyb_InterleaveVertices(Cyb_VertexDesc *desc, int vertCount,
+    const Cyb_Vec3 *verts, const Cyb_Vec3 *norms, const Cyb_Vec3 *tangents, 
+    const Cyb_Vec4 *colors, const Cyb_Vec2 *uvs)
+{
+    //Ensure that vertices were given
+    if(!verts)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Function 'Cyb_InterleaveVertices' requires at least an array of vertices.");
+        return NULL;
+    }
+    
+    //Lay out the vertex data as if every packing was supported
+    Cyb_VertexFormat format;
+    desc->vFormat = Cyb_ChooseVertexType(norms, colors, uvs);
+    Cyb_BuildVertexFormat(NULL, &desc->layout, desc->vFormat, &format);
+    
+    //Record the packings that were used
+    desc->layout.pos = format.attribs[CYB_ATTRIB_POS].packing;
+    desc->layout.norm = format.attribs[CYB_ATTRIB_NORM].packing;
+    desc->layout.color = format.attribs[CYB_ATTRIB_COLOR].packing;
+    desc->layout.uv = format.attribs[CYB_ATTRIB_UV].packing;
+    
+    //Record the bounds of normalized positions
+    if(desc->layout.pos == CYB_PACK_SNORM16)
+    {
+        Cyb_GetDequantMatrix(&format.dequant, vertCount, verts);
+    }
+    
+    desc->posCenter.x = format.dequant.d;
+    desc->posCenter.y = format.dequant.h;
+    desc->posCenter.z = format.dequant.l;
+    desc->posScale = format.dequant.a;
+    
+    //Assemble the vertex data
+    return Cyb_AssembleVertices(&format, vertCount, verts, norms, tangents, 
+        colors, uvs);
+}
+
+
+int Cyb_UpdateMeshInterleaved(Cyb_Renderer *renderer, Cyb_Mesh *mesh, 
+    const Cyb_VertexDesc *desc, int vertCount, const void *vertData, 
+    int indexCount, const unsigned int *indices)
+{
+    //Ensure that vertices and indices were given
+    if(!vertData || !indices)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Function 'Cyb_UpdateMeshInterleaved' requires vertex data and indices.");
+        return CYB_ERROR;
+    }
+    
+    //Get the layout of the vertex data
+    Cyb_VertexFormat srcFormat;
+    
+    if(Cyb_GetDescFormat(desc, &srcFormat))
+    {
+        return CYB_ERROR;
+    }
+    
+    //Select the renderer
+    Cyb_SelectRenderer(renderer);
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    //Get the layout the driver supports
+    Cyb_VertexFormat format;
+    Cyb_BuildVertexFormat(glExtAPI, &desc->layout, desc->vFormat, &format);
+    format.dequant = srcFormat.dequant;
+    int supported = TRUE;
+    
+    for(int i = 0; i < CYB_MESH_ATTRIB_COUNT; i++)
+    {
+        if(format.attribs[i].packing != srcFormat.attribs[i].packing)
+        {
+            supported = FALSE;
+        }
+    }
+    
+    //Convert the packings the driver does not support
+    void *buf = NULL;
+    
+    if(!supported)
+    {
+        buf = Cyb_RepackVertices(&srcFormat, &format, vertCount, vertData);
+        
+        if(!buf)
+        {
+            return CYB_ERROR;
+        }
+    }
+    //Ring buffers need their own copy of the vertex data
+    else if(mesh->usage == CYB_BUFFER_STREAM && glExtAPI->BufferStorage)
+    {
+        buf = SDL_malloc(format.vertSize * vertCount);
+        
+        if(!buf)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Out of Memory");
+            return CYB_ERROR;
+        }
+        
+        memcpy(buf, vertData, format.vertSize * vertCount);
+    }
+    
+    //Upload the vertex data as it is if possible
+    return Cyb_SetMeshData(renderer, mesh, &format, vertCount, 
+        buf ? buf : vertData, buf, NULL, indexCount, indices);
+}
+
+
+void Cyb_SetMeshUsage(Cyb_Mesh *mesh, int usage)
+{
+    mesh->usage = usage;
+}
+
+
+void Cyb_SetMeshVertexLayout(Cyb_Mesh *mesh, const Cyb_VertexLayout *layout)
+{
+    //Use 32-bit floats for everything?
+    if(!layout)
+    {
+        mesh->layout.pos = CYB_PACK_FLOAT;
+        mesh->layout.norm = CYB_PACK_FLOAT;
+        mesh->layout.color = CYB_PACK_FLOAT;
+        mesh->layout.uv = CYB_PACK_FLOAT;
+        return;
+    }
+    
+    mesh->layout = *layout;
+}
+
+
+int Cyb_UpdateMeshRange(Cyb_Renderer *renderer, Cyb_Mesh *mesh, 
+    int firstVert, int vertCount, const Cyb_Vec3 *verts, const Cyb_Vec3 *norms,
+    const Cyb_Vec3 *tangents, const Cyb_Vec4 *colors, const Cyb_Vec2 *uvs)
+{
+    //Ensure that the range is valid
+    if(firstVert < 0 || vertCount < 0 || 
+        firstVert + vertCount > mesh->bufVertCount)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Function 'Cyb_UpdateMeshRange' was given an invalid vertex range.");
+        return CYB_ERROR;
+    }
+    
+    //Ensure that the vertex data matches the vertex format
+    int vFormat = mesh->format.vFormat;
+    
+    if(!verts || (vFormat != CYB_VERTEX_V && !norms) ||
+        ((vFormat == CYB_VERTEX_VNC || vFormat == CYB_VERTEX_VNCT) && !colors) ||
+        ((vFormat == CYB_VERTEX_VNT || vFormat == CYB_VERTEX_VNCT) && !uvs))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Function 'Cyb_UpdateMeshRange' requires the same kinds of vertex data as the mesh.");
+        return CYB_ERROR;
+    }
+    
+    //Assemble geometry data
+    void *buf = Cyb_AssembleVertices(&mesh->format, vertCount, verts, norms, 
+        tangents, colors, uvs);
+        
+    if(!buf)
+    {
+        return CYB_ERROR;
+    }
+    
+    //Select the renderer
+    Cyb_SelectRenderer(renderer);
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    int vertSize = mesh->format.vertSize;
+    int result = CYB_NO_ERROR;
+    
+    //Write all vertices into the next segment of the ring buffer
+    if(mesh->streamMap)
+    {
+        memcpy((char*)mesh->streamData + vertSize * firstVert, buf, 
+            vertSize * vertCount);
+        result = Cyb_UploadVertices(renderer, mesh, mesh->streamData,
+            (GLsizeiptr)vertSize * mesh->bufVertCount);
+        
+        if(!mesh->streamMap)
+        {
+            SDL_free(mesh->streamData);
+            mesh->streamData = NULL;
+        }
+        
+        Cyb_RebuildVAOs(renderer, mesh);
+    }
+    //Update the range in place (in the block of a geometry arena or the VBO
+    //of the mesh)
+    else
+    {
+        Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, 
+            mesh->pool ? mesh->pool->vbo : mesh->vbo);
+        glExtAPI->BufferSubData(GL_ARRAY_BUFFER, 
+            mesh->vboOffset + (GLintptr)vertSize * firstVert,
+            (GLsizeiptr)vertSize * vertCount, buf);
+        Cyb_AddUploadStats(renderer, (size_t)vertSize * vertCount);
+    }
+    
+    SDL_free(buf);
+    
+    //Update the CPU copy of the vertex positions
+    if(mesh->verts && mesh->vertCount == mesh->bufVertCount)
+    {
+        memcpy(&mesh->verts[firstVert], verts, sizeof(Cyb_Vec3) * vertCount);
+    }
+    
+    return result;
+}
+
+
+int Cyb_SetInstanceData(Cyb_Renderer *renderer, Cyb_Mesh *mesh, 
+    int count, const Cyb_Mat4 *models, const Cyb_Mat4 *norms)
+{
+    //Remove the instance data?
+    if(count <= 0 || !models)
+    {
+        mesh->instanceCount = 0;
+        return CYB_NO_ERROR;
+    }
+    
+    //Grow the instance data
+    if(count > mesh->instanceCap)
+    {
+        Cyb_InstanceData *instances = (Cyb_InstanceData*)SDL_realloc(
+            mesh->instances, sizeof(Cyb_InstanceData) * count);
+            
+        if(!instances)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Out of Memory");
+            return CYB_ERROR;
+        }
+        
+        mesh->instances = instances;
+        mesh->instanceCap = count;
+    }
+    
+    //Assemble instance data (the model matrices include the dequantization
+    //of packed positions but the normal matrices do not)
+    for(int i = 0; i < count; i++)
+    {
+        Cyb_MulMat4(&mesh->instances[i].model, &models[i], 
+            &mesh->format.dequant);
+        
+        if(norms)
+        {
+            mesh->instances[i].norm = norms[i];
+        }
+        else
+        {
+            //A singular model keeps its transpose as the normal matrix
+            Cyb_Mat4 tmp;
+            Cyb_Transpose(&tmp, &models[i]);
+            mesh->instances[i].norm = tmp;
+            Cyb_Invert(&mesh->instances[i].norm, &tmp);
+        }
+    }
+    
+    mesh->instanceCount = count;
+    Cyb_SelectRenderer(renderer);
+    return Cyb_UploadInstances(renderer, mesh);
+}
+
+
+void Cyb_RetainMeshGeometry(Cyb_Mesh *mesh, int retain)
+{
+    mesh->retainGeometry = retain;
+    
+    //Free the current copy?
+    if(!retain)
+    {
+        SDL_free(mesh->verts);
+        SDL_free(mesh->indices);
+        mesh->verts = NULL;
+        mesh->indices = NULL;
+        mesh->vertCount = 0;
+    }
+}
+
+
+int Cyb_RayHitMesh(const Cyb_Ray *ray, const Cyb_Mesh *mesh, 
+    const Cyb_Mat4 *model, float *t)
+{
+    //No CPU geometry copy?
+    if(!mesh->vertCount)
+    {
+        return -1;
+    }
+    
+    //Transform the ray into mesh space (distances along the ray are kept)
+    Cyb_Ray local = *ray;
+    
+    if(model)
+    {
+        //A singular model (like a zero scale) flattens the mesh, which
+        //can't be hit
+        if(Cyb_Determinant(model) == 0.0f)
+        {
+            return -1;
+        }
+        
+        Cyb_Mat4 inv;
+        Cyb_Invert(&inv, model);
+        Cyb_Transform(&local.origin, &inv, &ray->origin);
+        local.dir.x = inv.a * ray->dir.x + inv.b * ray->dir.y + 
+            inv.c * ray->dir.z;
+        local.dir.y = inv.e * ray->dir.x + inv.f * ray->dir.y + 
+            inv.g * ray->dir.z;
+        local.dir.z = inv.i * ray->dir.x + inv.j * ray->dir.y + 
+            inv.k * ray->dir.z;
+    }
+    
+    //Only the most detailed level is hit
+    const Cyb_MeshLOD *lod = mesh->lodCount ? &mesh->lods[0] : NULL;
+    return Cyb_RayHitTriangles(&local, mesh->verts, 
+        lod ? mesh->indices + lod->firstIndex : mesh->indices, 
+        (lod ? lod->indexCount : mesh->indexCount) / 3, t);
+}
+
+
+int Cyb_SetMeshLODs(Cyb_Mesh *mesh, int lodCount, const Cyb_MeshLOD *lods)
+{
+    //Ensure that the levels are valid
+    if(lodCount < 0 || lodCount > CYB_MAX_MESH_LODS)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Function 'Cyb_SetMeshLODs' was given too many levels of detail.");
+        return CYB_ERROR;
+    }
+    
+    for(int i = 0; i < lodCount; i++)
+    {
+        if(lods[i].firstIndex < 0 || lods[i].indexCount < 0 ||
+            lods[i].firstIndex + lods[i].indexCount > mesh->indexCount)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Function 'Cyb_SetMeshLODs' was given an invalid index range.");
+            return CYB_ERROR;
+        }
+    }
+    
+    //Copy the levels
+    memcpy(mesh->lods, lods, sizeof(Cyb_MeshLOD) * lodCount);
+    mesh->lodCount = lodCount;
+    return CYB_NO_ERROR;
+}
+
+
+int Cyb_GetMeshLODCount(const Cyb_Mesh *mesh)
+{
+    return mesh->lodCount;
+}
+
+
+static float Cyb_GetSphereScreenSize(Cyb_Renderer *renderer, 
+    const Cyb_Sphere *sphere, const Cyb_Mat4 *model)
+{
+    //Move the sphere into world space (the radius grows with the largest
+    //scale of the model matrix)
+    Cyb_Vec3 center;
+    Cyb_Transform(&center, model, &sphere->center);
+    float scale = model->a * model->a + model->e * model->e + 
+        model->i * model->i;
+    float scaleY = model->b * model->b + model->f * model->f + 
+        model->j * model->j;
+    float scaleZ = model->c * model->c + model->g * model->g + 
+        model->k * model->k;
+    scale = scaleY > scale ? scaleY : scale;
+    scale = scaleZ > scale ? scaleZ : scale;
+    return Cyb_GetLODScreenSize(renderer, &center, 
+        sphere->radius * sqrtf(scale));
+}
+
+
+static int Cyb_PickLOD(const Cyb_Mesh *mesh, float size)
+{
+    //Use the first level the screen size is big enough for
+    if(size < 0.0f)
+    {
+        return 0;
+    }
+    
+    for(int i = 0; i < mesh->lodCount - 1; i++)
+    {
+        if(size >= mesh->lods[i].minSize)
+        {
+            return i;
+        }
+    }
+    
+    return mesh->lodCount ? mesh->lodCount - 1 : 0;
+}
+
+
+static int Cyb_SelectDrawLOD(Cyb_Renderer *renderer, const Cyb_Mesh *mesh,
+    int count, const Cyb_Mat4 *model)
+{
+    //Nothing to choose from?
+    if(mesh->lodCount < 2)
+    {
+        return 0;
+    }
+    
+    //The instance matrices (and the constant model matrix of draws without
+    //instance data) include the dequantization of packed positions, so they
+    //transform the bounds from buffer space
+    const Cyb_Mat4 *dequant = &mesh->format.dequant;
+    Cyb_Sphere bufBounds;
+    bufBounds.center.x = (mesh->bounds.center.x - dequant->d) / dequant->a;
+    bufBounds.center.y = (mesh->bounds.center.y - dequant->h) / dequant->a;
+    bufBounds.center.z = (mesh->bounds.center.z - dequant->l) / dequant->a;
+    bufBounds.radius = mesh->bounds.radius / dequant->a;
+    
+    //Use the constant model matrix?
+    if(model)
+    {
+        return Cyb_PickLOD(mesh, 
+            Cyb_GetSphereScreenSize(renderer, &bufBounds, model));
+    }
+    
+    //Draw all instances at the level of the biggest one
+    float size = -1.0f;
+    
+    for(int i = 0; i < count; i++)
+    {
+        float instSize = Cyb_GetSphereScreenSize(renderer, &bufBounds, 
+            &mesh->instances[i].model);
+        size = instSize > size ? instSize : size;
+    }
+    
+    return Cyb_PickLOD(mesh, size);
+}
+
+
+int Cyb_GetMeshLOD(Cyb_Renderer *renderer, const Cyb_Mesh *mesh,
+    const Cyb_Mat4 *model)
+{
+    //Nothing to choose from?
+    if(mesh->lodCount < 2)
+    {
+        return 0;
+    }
+    
+    return Cyb_PickLOD(mesh, Cyb_GetSphereScreenSize(renderer, &mesh->bounds,
+        model ? model : &identity));
+}
+
+
+void Cyb_GetMeshBounds(const Cyb_Mesh *mesh, Cyb_Sphere *sphere)
+{
+    *sphere = mesh->bounds;
+}
+
+
+static void Cyb_DrawMeshElements(Cyb_Renderer *renderer, const Cyb_Mesh *mesh,
+    int lod, GLint baseVertex, int count)
+{
+    //Draw the indices of the level of detail once or the given number of 
+    //instances (meshes in a geometry arena start at their base vertex and 
+    //index offset)
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    int firstIndex = mesh->lodCount ? mesh->lods[lod].firstIndex : 0;
+    int indexCount = mesh->lodCount ? mesh->lods[lod].indexCount : 
+        mesh->indexCount;
+    const void *indices = (const void*)(mesh->indexOffset + 
+        (GLintptr)Cyb_GetIndexSize(mesh->indexType) * firstIndex);
+    Cyb_AddDrawStats(renderer, indexCount / 3, count ? count : 1);
+    
+    if(!count && baseVertex)
+    {
+        glExtAPI->DrawElementsBaseVertex(GL_TRIANGLES, indexCount, 
+            mesh->indexType, indices, baseVertex);
+    }
+    else if(!count)
+    {
+        glDrawElements(GL_TRIANGLES, indexCount, mesh->indexType, indices);
+    }
+    else if(baseVertex)
+    {
+        glExtAPI->DrawElementsInstancedBaseVertex(GL_TRIANGLES, indexCount,
+            mesh->indexType, indices, count, baseVertex);
+    }
+    else
+    {
+        glExtAPI->DrawElementsInstanced(GL_TRIANGLES, indexCount,
+            mesh->indexType, indices, count);
+    }
+}
+
+
+static void Cyb_DrawMeshCopies(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    int count, const Cyb_Mat4 *model, const Cyb_Mat4 *norm)
+{
+    //Select renderer
+    Cyb_SelectRenderer(renderer);
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    
+    //Bind the shared VAO of the pool of a geometry arena (the mesh is drawn
+    //from its base vertex)
+    Cyb_Armature *armature = Cyb_GetSelectedArmature(renderer);
+    GLint baseVertex = 0;
+    
+    if(mesh->pool && !armature)
+    {
+        Cyb_BindVertexArray(renderer, mesh->pool->vao);
+        baseVertex = mesh->firstVert;
+    }
+    //Bind the VAO of the mesh
+    else if(mesh->vao && !armature)
+    {
+        Cyb_BindVertexArray(renderer, mesh->vao);
+    }
+    //Bind the VAO of the mesh and armature pair (the bone data is not in the
+    //arena, so the attrib pointers start at the block instead)
+    else if(mesh->vao || mesh->pool)
+    {
+        //Build the VAO again if the armature changed
+        if(mesh->skinArmature != armature)
+        {
+            if(!mesh->skinVAO)
+            {
+                glExtAPI->GenVertexArrays(1, &mesh->skinVAO);
+            }
+            
+            Cyb_FreeObject((Cyb_Object**)&mesh->skinArmature);
+            mesh->skinArmature = (Cyb_Armature*)Cyb_NewObjectRef(
+                (Cyb_Object*)armature);
+            Cyb_BuildVAO(renderer, mesh, mesh->skinVAO, armature);
+        }
+        
+        Cyb_BindVertexArray(renderer, mesh->skinVAO);
+    }
+    //Setup vertex attribs for this draw call
+    else
+    {
+        Cyb_SetupVertexAttribs(renderer, mesh);
+        Cyb_SetupArmatureAttribs(renderer, armature);
+    }
+    
+    
+    //Meshes without instance data and meshes drawn with a model matrix use
+    //constant instance matrices (the model matrix includes the 
+    //dequantization of packed positions)
+    int instanced = mesh->instanceCount && !model;
+    Cyb_Mat4 constModel = mesh->format.dequant;
+    
+    if(model)
+    {
+        Cyb_MulMat4(&constModel, model, &mesh->format.dequant);
+    }
+    
+    //Limit the count to the instance data
+    if(instanced && count > mesh->instanceCount)
+    {
+        count = mesh->instanceCount;
+    }
+    
+    //Select the level of detail
+    int lod = Cyb_SelectDrawLOD(renderer, mesh, count, 
+        instanced ? NULL : &constModel);
+    
+    //Draw the mesh with constant instance matrices
+    if(!instanced)
+    {
+        Cyb_SetInstanceAttribs(glExtAPI, &constModel, norm);
+        
+        if(count == 1)
+        {
+            Cyb_DrawMeshElements(renderer, mesh, lod, baseVertex, 0);
+        }
+        else if(glExtAPI->DrawElementsInstanced)
+        {
+            Cyb_DrawMeshElements(renderer, mesh, lod, baseVertex, count);
+        }
+        else
+        {
+            for(int i = 0; i < count; i++)
+            {
+                Cyb_DrawMeshElements(renderer, mesh, lod, baseVertex, 0);
+            }
+        }
+    }
+    //Draw all mesh instances at once
+    else if(glExtAPI->DrawElementsInstanced)
+    {
+        //Setup instance attrib pointers (one per matrix column)
+        Cyb_BindBuffer(renderer, GL_ARRAY_BUFFER, mesh->instanceVBO);
+        
+        for(int i = 0; i < 4; i++)
+        {
+            glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_INSTANCE_MAT_MODEL + i);
+            glExtAPI->EnableVertexAttribArray(CYB_ATTRIB_INSTANCE_MAT_NORM + i);
+            glExtAPI->VertexAttribPointer(CYB_ATTRIB_INSTANCE_MAT_MODEL + i, 4, 
+                GL_FLOAT, GL_FALSE, sizeof(Cyb_InstanceData), 
+                (void*)(offsetof(Cyb_InstanceData, model) + sizeof(float) * 4 * i));
+            glExtAPI->VertexAttribPointer(CYB_ATTRIB_INSTANCE_MAT_NORM + i, 4, 
+                GL_FLOAT, GL_FALSE, sizeof(Cyb_InstanceData), 
+                (void*)(offsetof(Cyb_InstanceData, norm) + sizeof(float) * 4 * i));
+            glExtAPI->VertexAttribDivisor(CYB_ATTRIB_INSTANCE_MAT_MODEL + i, 1);
+            glExtAPI->VertexAttribDivisor(CYB_ATTRIB_INSTANCE_MAT_NORM + i, 1);
+        }
+        
+        Cyb_DrawMeshElements(renderer, mesh, lod, baseVertex, count);
+            
+        //Disable instance attrib pointers so other draws use constant values
+        for(int i = 0; i < 4; i++)
+        {
+            glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_INSTANCE_MAT_MODEL + i);
+            glExtAPI->DisableVertexAttribArray(CYB_ATTRIB_INSTANCE_MAT_NORM + i);
+        }
+    }
+    //Draw mesh instances one at a time
+    else
+    {
+        for(int i = 0; i < count; i++)
+        {
+            Cyb_SetInstanceAttribs(glExtAPI, &mesh->instances[i].model,
+                &mesh->instances[i].norm);
+            Cyb_DrawMeshElements(renderer, mesh, lod, baseVertex, 0);
+        }
+    }
+}
+
+
+void Cyb_DrawMeshes(Cyb_Renderer *renderer, Cyb_Mesh *mesh, int count)
+{
+    Cyb_DrawMeshCopies(renderer, mesh, count, NULL, &identity);
+}
+
+
+void Cyb_DrawMeshTransformed(Cyb_Renderer *renderer, Cyb_Mesh *mesh,
+    const Cyb_Mat4 *model, const Cyb_Mat4 *norm)
+{
+    //Calculate the normal matrix?
+    Cyb_Mat4 normMat = identity;
+    
+    if(!norm)
+    {
+        Cyb_Mat4 tmp;
+        Cyb_Transpose(&tmp, model);
+        Cyb_Invert(&normMat, &tmp);
+        norm = &normMat;
+    }
+    
+    Cyb_DrawMeshCopies(renderer, mesh, 1, model, norm);
+}
+
+
+static void Cyb_SwapInstanceData(Cyb_Mesh *mesh)
+{
+    //Exchange the instance data with the temporary instance data
+    GLuint vbo = mesh->instanceVBO;
+    GLsizeiptr vboSize = mesh->instanceVBOSize;
+    int cap = mesh->instanceCap;
+    Cyb_InstanceData *instances = mesh->instances;
+    mesh->instanceVBO = mesh->tempInstanceVBO;
+    mesh->instanceVBOSize = mesh->tempInstanceVBOSize;
+    mesh->instanceCap = mesh->tempInstanceCap;
+    mesh->instances = mesh->tempInstances;
+    mesh->tempInstanceVBO = vbo;
+    mesh->tempInstanceVBOSize = vboSize;
+    mesh->tempInstanceCap = cap;
+    mesh->tempInstances = instances;
+}
+
+
+int Cyb_DrawMeshInstances(Cyb_Renderer *renderer, Cyb_Mesh *mesh, 
+    int count, const Cyb_Mat4 *models, const Cyb_Mat4 *norms)
+{
+    //Nothing to draw?
+    if(count <= 0 || !models)
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    //Draw from the temporary instance data, so the instance data of the mesh
+    //is kept
+    int instanceCount = mesh->instanceCount;
+    Cyb_SwapInstanceData(mesh);
+    int result = Cyb_SetInstanceData(renderer, mesh, count, models, norms);
+    
+    if(result == CYB_NO_ERROR)
+    {
+        Cyb_DrawMeshes(renderer, mesh, count);
+    }
+    
+    Cyb_SwapInstanceData(mesh);
+    mesh->instanceCount = instanceCount;
+    return result;
+}
+
+
+void Cyb_FreeGeometryArena(Cyb_GeometryArena *arena)
+{
+    //Meshes keep the arena alive while they are in it, so the pools are empty
+    Cyb_Renderer *renderer = arena->renderer;
+    Cyb_SelectRenderer(renderer);
+    Cyb_BindVertexArray(renderer, 0);
+    
+    for(int i = 0; i < arena->poolCount; i++)
+    {
+        Cyb_FreeArenaPool(renderer, arena->pools[i]);
+    }
+    
+    SDL_free(arena->pools);
+}
+
+
+Cyb_GeometryArena *Cyb_CreateGeometryArena(Cyb_Renderer *renderer,
+    int vertCap, int indexCap)
+{
+    //Allocate new geometry arena
+    Cyb_GeometryArena *arena = (Cyb_GeometryArena*)Cyb_CreateObject(
+        sizeof(Cyb_GeometryArena), (Cyb_FreeProc)&Cyb_FreeGeometryArena, 
+        CYB_GEOMETRYARENA);
+    
+    if(!arena)
+    {
+        return NULL;
+    }
+    
+    //Initialize the arena (the pools are created as they are needed)
+    arena->renderer = renderer;
+    arena->vertCap = vertCap > 0 ? vertCap : CYB_ARENA_VERT_CAP;
+    arena->indexCap = indexCap > 0 ? indexCap : CYB_ARENA_INDEX_CAP;
+    arena->poolCount = 0;
+    arena->pools = NULL;
+    return arena;
+}
+
+
+void Cyb_SetMeshArena(Cyb_Mesh *mesh, Cyb_GeometryArena *arena)
+{
+    Cyb_FreeObject((Cyb_Object**)&mesh->arena);
+    
+    if(arena)
+    {
+        mesh->arena = (Cyb_GeometryArena*)Cyb_NewObjectRef(
+            (Cyb_Object*)arena);
+    }
+}
+
+
+static int Cyb_CompareBlocks(const void *a, const void *b)
+{
+    const Cyb_Mesh *meshA = *(const Cyb_Mesh**)a;
+    const Cyb_Mesh *meshB = *(const Cyb_Mesh**)b;
+    return meshA->firstVert - meshB->firstVert;
+}
+
+
+static int Cyb_CompactArenaPool(Cyb_Renderer *renderer, Cyb_ArenaPool *pool)
+{
+    //Allocate new buffers
+    GLsizeiptr vertSize = pool->format.vertSize;
+    GLuint vbo = Cyb_AllocPoolBuffer(renderer, vertSize * pool->vertCap);
+    GLuint ebo = Cyb_AllocPoolBuffer(renderer, 
+        (GLsizeiptr)pool->indexSize * pool->indexCap);
+    
+    if(!vbo || !ebo)
+    {
+        if(vbo)
+        {
+            Cyb_DeleteBuffers(renderer, 1, &vbo);
+        }
+        
+        if(ebo)
+        {
+            Cyb_DeleteBuffers(renderer, 1, &ebo);
+        }
+        
+        return CYB_ERROR;
+    }
+    
+    //Copy the blocks to the front of the new buffers in order
+    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
+    int firstVert = 0;
+    int firstIndex = 0;
+    SDL_qsort(pool->meshes, pool->meshCount, sizeof(Cyb_Mesh*), 
+        &Cyb_CompareBlocks);
+    
+    for(int i = 0; i < pool->meshCount; i++)
+    {
+        Cyb_Mesh *mesh = pool->meshes[i];
+        Cyb_BindBuffer(renderer, GL_COPY_READ_BUFFER, pool->vbo);
+        Cyb_BindBuffer(renderer, GL_COPY_WRITE_BUFFER, vbo);
+        glExtAPI->CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            vertSize * mesh->firstVert, vertSize * firstVert, 
+            vertSize * mesh->vertCap);
+        Cyb_BindBuffer(renderer, GL_COPY_READ_BUFFER, pool->ebo);
+        Cyb_BindBuffer(renderer, GL_COPY_WRITE_BUFFER, ebo);
+        glExtAPI->CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            (GLintptr)pool->indexSize * mesh->firstIndex, 
+            (GLintptr)pool->indexSize * firstIndex, 
+            (GLsizeiptr)pool->indexSize * mesh->indexCap);
+        mesh->firstVert = firstVert;
+        mesh->firstIndex = firstIndex;
+        firstVert += mesh->vertCap;
+        firstIndex += mesh->indexCap;
+    }
+    
+    //Replace the old buffers
+    Cyb_DeleteBuffers(renderer, 1, &pool->vbo);
+    Cyb_DeleteBuffers(renderer, 1, &pool->ebo);
+    pool->vbo = vbo;
+    pool->ebo = ebo;
+    Cyb_BuildPoolVAO(renderer, pool);
+    Cyb_ResetRanges(&pool->freeVerts, firstVert, pool->vertCap - firstVert);
+    Cyb_ResetRanges(&pool->freeIndices, firstIndex, 
+        pool->indexCap - firstIndex);
+    
+    //Move the meshes to their new blocks
+    for(int i = 0; i < pool->meshCount; i++)
+    {
+        Cyb_Mesh *mesh = pool->meshes[i];
+        mesh->vboOffset = vertSize * mesh->firstVert;
+        mesh->indexOffset = (GLintptr)pool->indexSize * mesh->firstIndex;
+        Cyb_RebuildVAOs(renderer, mesh);
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+int Cyb_DefragGeometryArena(Cyb_Renderer *renderer, Cyb_GeometryArena *arena)
+{
+    //Select the renderer
+    Cyb_SelectRenderer(renderer);
+    Cyb_BindVertexArray(renderer, 0);
+    int result = CYB_NO_ERROR;
+    int poolCount = 0;
+    
+    for(int i = 0; i < arena->poolCount; i++)
+    {
+        Cyb_ArenaPool *pool = arena->pools[i];
+        
+        //Free empty pools
+        if(!pool->meshCount)
+        {
+            Cyb_FreeArenaPool(renderer, pool);
+            continue;
+        }
+        
+        //Compact the other pools
+        if(Cyb_CompactArenaPool(renderer, pool))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybRender] Failed to defragment geometry arena pool.");
+            result = CYB_ERROR;
+        }
+        
+        arena->pools[poolCount++] = pool;
+    }
+    
+    arena->poolCount = poolCount;
+    return result;
+}
+
+
+int Cyb_GetGeometryArenaPoolCount(Cyb_GeometryArena *arena)
+{
+    return arena->poolCount;
 }
\ No newline at end of file
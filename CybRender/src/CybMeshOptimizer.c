@@ -0,0 +1,562 @@
+/*
+CybRender - Mesh Optimizer API
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include <SDL2/SDL.h>
+
+#include "CybMeshOptimizer.h"
+
+
+//Macros
+//=================================================================================
+#define CYB_FORSYTH_CACHE_SIZE 32     //the LRU cache modelled while ordering
+#define CYB_FORSYTH_MAX_VALENCE 64    //valence scores are looked up below this
+#define CYB_OVERDRAW_CACHE_SIZE 16    //the FIFO cache modelled for clustering
+#define CYB_OVERDRAW_THRESHOLD 1.05f  //the cache efficiency clusters may lose
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    float key;
+    int first;
+    int count;
+} Cyb_Cluster;
+
+
+//Globals
+//=================================================================================
+static float cacheScores[CYB_FORSYTH_CACHE_SIZE];
+static float valenceScores[CYB_FORSYTH_MAX_VALENCE];
+
+
+//Functions
+//=================================================================================
+static void Cyb_InitForsythScores(void)
+{
+    //The last triangle's vertices score the same so it isn't reused at once
+    for(int i = 0; i < CYB_FORSYTH_CACHE_SIZE; i++)
+    {
+        cacheScores[i] = i < 3 ? 0.75f : powf(1.0f - (float)(i - 3) /
+            (CYB_FORSYTH_CACHE_SIZE - 3), 1.5f);
+    }
+    
+    //Vertices with few triangles left are finished first
+    valenceScores[0] = 0.0f;
+    
+    for(int i = 1; i < CYB_FORSYTH_MAX_VALENCE; i++)
+    {
+        valenceScores[i] = 2.0f / sqrtf((float)i);
+    }
+}
+
+
+static float Cyb_GetVertexScore(int cachePos, int valence)
+{
+    //No triangles left?
+    if(!valence)
+    {
+        return -1.0f;
+    }
+    
+    float score = cachePos >= 0 ? cacheScores[cachePos] : 0.0f;
+    return score + (valence < CYB_FORSYTH_MAX_VALENCE ? valenceScores[valence] :
+        2.0f / sqrtf((float)valence));
+}
+
+
+static int Cyb_OptimizeVertexCache(unsigned int *dest,
+    const unsigned int *indices, int indexCount, int vertCount)
+{
+    //Allocate the work buffers
+    int triCount = indexCount / 3;
+    int *valences = (int*)SDL_calloc(vertCount, sizeof(int));
+    int *adjOffsets = (int*)SDL_malloc(sizeof(int) * (vertCount + 1));
+    int *adjTris = (int*)SDL_malloc(sizeof(int) * indexCount);
+    int *cachePos = (int*)SDL_malloc(sizeof(int) * vertCount);
+    float *vertScores = (float*)SDL_malloc(sizeof(float) * vertCount);
+    char *emitted = (char*)SDL_calloc(triCount, 1);
+    
+    if(!valences || !adjOffsets || !adjTris || !cachePos || !vertScores ||
+        !emitted)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        SDL_free(valences);
+        SDL_free(adjOffsets);
+        SDL_free(adjTris);
+        SDL_free(cachePos);
+        SDL_free(vertScores);
+        SDL_free(emitted);
+        return CYB_ERROR;
+    }
+    
+    //Build the list of triangles around each vertex (the first "valence"
+    //entries of each list are the triangles which haven't been emitted)
+    for(int i = 0; i < indexCount; i++)
+    {
+        valences[indices[i]]++;
+    }
+    
+    adjOffsets[0] = 0;
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        adjOffsets[i + 1] = adjOffsets[i] + valences[i];
+        valences[i] = 0;
+    }
+    
+    for(int i = 0; i < indexCount; i++)
+    {
+        unsigned int v = indices[i];
+        adjTris[adjOffsets[v] + valences[v]++] = i / 3;
+    }
+    
+    //Calculate the initial scores
+    Cyb_InitForsythScores();
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        cachePos[i] = -1;
+        vertScores[i] = Cyb_GetVertexScore(-1, valences[i]);
+    }
+    
+    //Emit the best triangle around the cached vertices until none are left
+    unsigned int cache[CYB_FORSYTH_CACHE_SIZE + 3];
+    int cacheCount = 0;
+    int cursor = 0;
+    int best = -1;
+    
+    for(int out = 0; out < triCount; out++)
+    {
+        //Continue with the next triangle in the original order if none of
+        //the cached vertices have triangles left
+        if(best < 0)
+        {
+            while(emitted[cursor])
+            {
+                cursor++;
+            }
+            
+            best = cursor;
+        }
+        
+        //Emit the triangle
+        const unsigned int *tri = &indices[best * 3];
+        memcpy(&dest[out * 3], tri, sizeof(unsigned int) * 3);
+        emitted[best] = TRUE;
+        
+        for(int i = 0; i < 3; i++)
+        {
+            //Remove the triangle from the vertex
+            unsigned int v = tri[i];
+            int *list = &adjTris[adjOffsets[v]];
+            
+            for(int j = 0; j < valences[v]; j++)
+            {
+                if(list[j] == best)
+                {
+                    list[j] = list[--valences[v]];
+                    break;
+                }
+            }
+        }
+        
+        //Move the vertices of the triangle to the front of the cache
+        unsigned int newCache[CYB_FORSYTH_CACHE_SIZE + 3];
+        int newCount = 0;
+        
+        for(int i = 0; i < 3; i++)
+        {
+            if(!i || (tri[i] != tri[0] && (i < 2 || tri[i] != tri[1])))
+            {
+                newCache[newCount++] = tri[i];
+            }
+        }
+        
+        for(int i = 0; i < cacheCount; i++)
+        {
+            unsigned int v = cache[i];
+            
+            if(v != tri[0] && v != tri[1] && v != tri[2])
+            {
+                newCache[newCount++] = v;
+            }
+        }
+        
+        //Update the scores of the vertices which moved or dropped out
+        for(int i = 0; i < newCount; i++)
+        {
+            unsigned int v = newCache[i];
+            cachePos[v] = i < CYB_FORSYTH_CACHE_SIZE ? i : -1;
+            vertScores[v] = Cyb_GetVertexScore(cachePos[v], valences[v]);
+        }
+        
+        //Rescore their triangles and find the best one
+        float bestScore = -1.0f;
+        best = -1;
+        
+        for(int i = 0; i < newCount; i++)
+        {
+            unsigned int v = newCache[i];
+            const int *list = &adjTris[adjOffsets[v]];
+            
+            for(int j = 0; j < valences[v]; j++)
+            {
+                int t = list[j];
+                const unsigned int *other = &indices[t * 3];
+                float score = vertScores[other[0]] + vertScores[other[1]] +
+                    vertScores[other[2]];
+                
+                if(score > bestScore)
+                {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+        
+        cacheCount = newCount < CYB_FORSYTH_CACHE_SIZE ? newCount :
+            CYB_FORSYTH_CACHE_SIZE;
+        memcpy(cache, newCache, sizeof(unsigned int) * cacheCount);
+    }
+    
+    //Free the work buffers
+    SDL_free(valences);
+    SDL_free(adjOffsets);
+    SDL_free(adjTris);
+    SDL_free(cachePos);
+    SDL_free(vertScores);
+    SDL_free(emitted);
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_SimulateFIFO(unsigned int *cacheTimes, unsigned int *time,
+    const unsigned int *tri, int cacheSize)
+{
+    //A vertex is cached if fewer than cacheSize misses happened since it was
+    //last loaded
+    int misses = 0;
+    
+    for(int i = 0; i < 3; i++)
+    {
+        if(*time - cacheTimes[tri[i]] >= (unsigned int)cacheSize)
+        {
+            cacheTimes[tri[i]] = (*time)++;
+            misses++;
+        }
+    }
+    
+    return misses;
+}
+
+
+static int Cyb_FindClusters(int *starts, int *hardStarts,
+    const unsigned int *indices, int triCount, unsigned int *cacheTimes)
+{
+    //Split where a triangle misses all of its vertices, since the cache is
+    //cold there anyway (the first cluster always starts at the first
+    //triangle, which can be degenerate and miss fewer vertices)
+    unsigned int time = CYB_OVERDRAW_CACHE_SIZE + 1;
+    int hardCount = 0;
+    
+    for(int i = 0; i < triCount; i++)
+    {
+        if(Cyb_SimulateFIFO(cacheTimes, &time, &indices[i * 3],
+            CYB_OVERDRAW_CACHE_SIZE) == 3 || i == 0)
+        {
+            hardStarts[hardCount++] = i;
+        }
+    }
+    
+    //Split each of those again wherever the part so far is at most slightly
+    //less cache efficient than the whole
+    int count = 0;
+    
+    for(int i = 0; i < hardCount; i++)
+    {
+        int first = hardStarts[i];
+        int end = i + 1 < hardCount ? hardStarts[i + 1] : triCount;
+        int misses = 0;
+        time += CYB_OVERDRAW_CACHE_SIZE + 1;
+        
+        for(int j = first; j < end; j++)
+        {
+            misses += Cyb_SimulateFIFO(cacheTimes, &time, &indices[j * 3],
+                CYB_OVERDRAW_CACHE_SIZE);
+        }
+        
+        float threshold = CYB_OVERDRAW_THRESHOLD * misses / (end - first);
+        int start = first;
+        misses = 0;
+        time += CYB_OVERDRAW_CACHE_SIZE + 1;
+        starts[count++] = first;
+        
+        for(int j = first; j < end - 1; j++)
+        {
+            misses += Cyb_SimulateFIFO(cacheTimes, &time, &indices[j * 3],
+                CYB_OVERDRAW_CACHE_SIZE);
+            
+            if((float)misses / (j - start + 1) <= threshold)
+            {
+                start = j + 1;
+                misses = 0;
+                time += CYB_OVERDRAW_CACHE_SIZE + 1;
+                starts[count++] = start;
+            }
+        }
+    }
+    
+    return count;
+}
+
+
+static int Cyb_CompareClusters(const void *a, const void *b)
+{
+    //Outer clusters first
+    float keyA = ((const Cyb_Cluster*)a)->key;
+    float keyB = ((const Cyb_Cluster*)b)->key;
+    return keyA > keyB ? -1 : keyA < keyB;
+}
+
+
+static int Cyb_OptimizeOverdraw(unsigned int *dest,
+    const unsigned int *indices, int indexCount, const Cyb_Vec3 *verts,
+    int vertCount)
+{
+    //Allocate the work buffers
+    int triCount = indexCount / 3;
+    unsigned int *cacheTimes = (unsigned int*)SDL_calloc(vertCount,
+        sizeof(unsigned int));
+    int *starts = (int*)SDL_malloc(sizeof(int) * triCount);
+    int *hardStarts = (int*)SDL_malloc(sizeof(int) * triCount);
+    Cyb_Cluster *clusters = (Cyb_Cluster*)SDL_malloc(sizeof(Cyb_Cluster) *
+        triCount);
+    
+    if(!cacheTimes || !starts || !hardStarts || !clusters)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        SDL_free(cacheTimes);
+        SDL_free(starts);
+        SDL_free(hardStarts);
+        SDL_free(clusters);
+        return CYB_ERROR;
+    }
+    
+    //Find the area weighted centroid of the mesh
+    int count = Cyb_FindClusters(starts, hardStarts, indices, triCount,
+        cacheTimes);
+    float center[3] = {0.0f, 0.0f, 0.0f};
+    float totalArea = 0.0f;
+    
+    for(int i = 0; i < triCount; i++)
+    {
+        const Cyb_Vec3 *a = &verts[indices[i * 3]];
+        const Cyb_Vec3 *b = &verts[indices[i * 3 + 1]];
+        const Cyb_Vec3 *c = &verts[indices[i * 3 + 2]];
+        Cyb_Vec3 e1 = {b->x - a->x, b->y - a->y, b->z - a->z};
+        Cyb_Vec3 e2 = {c->x - a->x, c->y - a->y, c->z - a->z};
+        float nx = e1.y * e2.z - e1.z * e2.y;
+        float ny = e1.z * e2.x - e1.x * e2.z;
+        float nz = e1.x * e2.y - e1.y * e2.x;
+        float area = sqrtf(nx * nx + ny * ny + nz * nz);
+        center[0] += (a->x + b->x + c->x) * area;
+        center[1] += (a->y + b->y + c->y) * area;
+        center[2] += (a->z + b->z + c->z) * area;
+        totalArea += area;
+    }
+    
+    if(totalArea > 0.0f)
+    {
+        center[0] /= totalArea * 3.0f;
+        center[1] /= totalArea * 3.0f;
+        center[2] /= totalArea * 3.0f;
+    }
+    
+    //Rank each cluster by how far out its centroid lies along its normal
+    for(int i = 0; i < count; i++)
+    {
+        Cyb_Cluster *cluster = &clusters[i];
+        cluster->first = starts[i];
+        cluster->count = (i + 1 < count ? starts[i + 1] : triCount) -
+            starts[i];
+        float centroid[3] = {0.0f, 0.0f, 0.0f};
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+        float area = 0.0f;
+        
+        for(int j = cluster->first; j < cluster->first + cluster->count; j++)
+        {
+            const Cyb_Vec3 *a = &verts[indices[j * 3]];
+            const Cyb_Vec3 *b = &verts[indices[j * 3 + 1]];
+            const Cyb_Vec3 *c = &verts[indices[j * 3 + 2]];
+            Cyb_Vec3 e1 = {b->x - a->x, b->y - a->y, b->z - a->z};
+            Cyb_Vec3 e2 = {c->x - a->x, c->y - a->y, c->z - a->z};
+            float nx = e1.y * e2.z - e1.z * e2.y;
+            float ny = e1.z * e2.x - e1.x * e2.z;
+            float nz = e1.x * e2.y - e1.y * e2.x;
+            float triArea = sqrtf(nx * nx + ny * ny + nz * nz);
+            centroid[0] += (a->x + b->x + c->x) * triArea;
+            centroid[1] += (a->y + b->y + c->y) * triArea;
+            centroid[2] += (a->z + b->z + c->z) * triArea;
+            normal[0] += nx;
+            normal[1] += ny;
+            normal[2] += nz;
+            area += triArea;
+        }
+        
+        float len = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] +
+            normal[2] * normal[2]);
+        cluster->key = 0.0f;
+        
+        if(area > 0.0f && len > 0.0f)
+        {
+            cluster->key = ((centroid[0] / (area * 3.0f) - center[0]) *
+                normal[0] + (centroid[1] / (area * 3.0f) - center[1]) *
+                normal[1] + (centroid[2] / (area * 3.0f) - center[2]) *
+                normal[2]) / len;
+        }
+    }
+    
+    //Write the triangles cluster by cluster
+    SDL_qsort(clusters, count, sizeof(Cyb_Cluster), &Cyb_CompareClusters);
+    int out = 0;
+    
+    for(int i = 0; i < count; i++)
+    {
+        memcpy(&dest[out], &indices[clusters[i].first * 3],
+            sizeof(unsigned int) * 3 * clusters[i].count);
+        out += clusters[i].count * 3;
+    }
+    
+    //Free the work buffers
+    SDL_free(cacheTimes);
+    SDL_free(starts);
+    SDL_free(hardStarts);
+    SDL_free(clusters);
+    return CYB_NO_ERROR;
+}
+
+
+int Cyb_OptimizeMeshIndices(unsigned int *indices, int indexCount,
+    const Cyb_Vec3 *verts, int vertCount)
+{
+    //Nothing to do?
+    indexCount -= indexCount % 3;
+    
+    if(indexCount < 6)
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    //Allocate a copy of the indices
+    unsigned int *copy = (unsigned int*)SDL_malloc(sizeof(unsigned int) *
+        indexCount);
+    
+    if(!copy)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    //Order the triangles for the vertex cache, then the clusters for overdraw
+    memcpy(copy, indices, sizeof(unsigned int) * indexCount);
+    int result = Cyb_OptimizeVertexCache(indices, copy, indexCount, vertCount);
+    
+    if(result == CYB_NO_ERROR && verts)
+    {
+        memcpy(copy, indices, sizeof(unsigned int) * indexCount);
+        result = Cyb_OptimizeOverdraw(indices, copy, indexCount, verts,
+            vertCount);
+    }
+    
+    SDL_free(copy);
+    return result;
+}
+
+
+int Cyb_OptimizeVertexFetch(int *remap, unsigned int *indices,
+    int indexCount, int vertCount)
+{
+    //Number the vertices in the order they are first used
+    int next = 0;
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        remap[i] = -1;
+    }
+    
+    for(int i = 0; i < indexCount; i++)
+    {
+        unsigned int v = indices[i];
+        
+        if(remap[v] < 0)
+        {
+            remap[v] = next++;
+        }
+        
+        indices[i] = remap[v];
+    }
+    
+    //Move the unused vertices to the end
+    int used = next;
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        if(remap[i] < 0)
+        {
+            remap[i] = next++;
+        }
+    }
+    
+    return used;
+}
+
+
+int Cyb_GetVertexCacheStats(const unsigned int *indices, int indexCount,
+    int vertCount, int cacheSize, float *acmr, float *atvr)
+{
+    //Allocate the cache
+    unsigned int *cacheTimes = (unsigned int*)SDL_calloc(vertCount,
+        sizeof(unsigned int));
+    char *used = (char*)SDL_calloc(vertCount, 1);
+    
+    if(!cacheTimes || !used)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        SDL_free(cacheTimes);
+        SDL_free(used);
+        return CYB_ERROR;
+    }
+    
+    //Count the cache misses and the vertices used
+    unsigned int time = cacheSize + 1;
+    int triCount = indexCount / 3;
+    int misses = 0;
+    int usedCount = 0;
+    
+    for(int i = 0; i < triCount; i++)
+    {
+        misses += Cyb_SimulateFIFO(cacheTimes, &time, &indices[i * 3],
+            cacheSize);
+    }
+    
+    for(int i = 0; i < triCount * 3; i++)
+    {
+        usedCount += !used[indices[i]];
+        used[indices[i]] = TRUE;
+    }
+    
+    *acmr = triCount ? (float)misses / triCount : 0.0f;
+    *atvr = usedCount ? (float)misses / usedCount : 0.0f;
+    SDL_free(cacheTimes);
+    SDL_free(used);
+    return CYB_NO_ERROR;
+}
\ No newline at end of file
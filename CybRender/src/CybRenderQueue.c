@@ -0,0 +1,509 @@
+/*
+CybRender - Render Queue API
+*/
+
+#include <string.h>
+
+#include "CybObject.h"
+#include "CybRenderQueue.h"
+
+
+//Macros
+//=================================================================================
+#define CYB_QUEUE_MIN_CAP 64
+
+//Key field sizes in bits (the top bit selects opaque or transparent)
+#define CYB_KEY_SHADER_BITS 10
+#define CYB_KEY_TEXTURE_BITS 10
+#define CYB_KEY_MATERIAL_BITS 8
+#define CYB_KEY_MESH_BITS 11
+#define CYB_KEY_DEPTH_BITS 24
+
+#define CYB_KEY_MASK(bits) ((1u << (bits)) - 1)
+
+
+//Enums
+//=================================================================================
+enum Cyb_KeyFields
+{
+    CYB_KEY_SHADER,
+    CYB_KEY_TEXTURE,
+    CYB_KEY_MATERIAL,
+    CYB_KEY_MESH,
+    CYB_KEY_FIELD_COUNT
+};
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    Uint64 key;
+    int item;
+} Cyb_SortEntry;
+
+
+typedef struct
+{
+    const void *ptr;
+    Uint32 id;
+} Cyb_IDSlot;
+
+
+struct Cyb_RenderQueue
+{
+    Cyb_Object base;
+    int count;
+    int cap;
+    Cyb_DrawItem *items;
+    Cyb_SortEntry *entries;
+    Cyb_SortEntry *scratch;
+    Cyb_Mat4 *models;
+    int *lods;
+    int tableSize;
+    Cyb_IDSlot *table;
+    Uint32 nextID[CYB_KEY_FIELD_COUNT];
+};
+
+
+//Globals
+//=================================================================================
+static const Uint32 fieldMasks[CYB_KEY_FIELD_COUNT] = {
+    CYB_KEY_MASK(CYB_KEY_SHADER_BITS),
+    CYB_KEY_MASK(CYB_KEY_TEXTURE_BITS),
+    CYB_KEY_MASK(CYB_KEY_MATERIAL_BITS),
+    CYB_KEY_MASK(CYB_KEY_MESH_BITS)
+};
+
+static const char *samplerNames[CYB_MAX_DRAW_TEXTURES] = {
+    "tex0",
+    "tex1",
+    "tex2",
+    "tex3"
+};
+
+
+//Functions
+//=================================================================================
+void Cyb_FreeRenderQueue(Cyb_RenderQueue *queue)
+{
+    SDL_free(queue->items);
+    SDL_free(queue->entries);
+    SDL_free(queue->scratch);
+    SDL_free(queue->models);
+    SDL_free(queue->lods);
+    SDL_free(queue->table);
+}
+
+
+Cyb_RenderQueue *Cyb_CreateRenderQueue(void)
+{
+    //Allocate new render queue
+    Cyb_RenderQueue *queue = (Cyb_RenderQueue*)Cyb_CreateObject(
+        sizeof(Cyb_RenderQueue), (Cyb_FreeProc)&Cyb_FreeRenderQueue,
+        CYB_RENDERQUEUE);
+    
+    if(!queue)
+    {
+        return NULL;
+    }
+    
+    //Initialize the render queue
+    queue->count = 0;
+    queue->cap = 0;
+    queue->items = NULL;
+    queue->entries = NULL;
+    queue->scratch = NULL;
+    queue->models = NULL;
+    queue->lods = NULL;
+    queue->tableSize = 0;
+    queue->table = NULL;
+    return queue;
+}
+
+
+static int Cyb_GrowRenderQueue(Cyb_RenderQueue *queue)
+{
+    //Double the capacity of every per-item array
+    int cap = queue->cap ? queue->cap * 2 : CYB_QUEUE_MIN_CAP;
+    Cyb_DrawItem *items = (Cyb_DrawItem*)SDL_realloc(queue->items,
+        sizeof(Cyb_DrawItem) * cap);
+    
+    if(!items)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    queue->items = items;
+    Cyb_SortEntry *entries = (Cyb_SortEntry*)SDL_realloc(queue->entries,
+        sizeof(Cyb_SortEntry) * cap);
+    
+    if(!entries)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    queue->entries = entries;
+    Cyb_SortEntry *scratch = (Cyb_SortEntry*)SDL_realloc(queue->scratch,
+        sizeof(Cyb_SortEntry) * cap);
+    
+    if(!scratch)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    queue->scratch = scratch;
+    Cyb_Mat4 *models = (Cyb_Mat4*)SDL_realloc(queue->models,
+        sizeof(Cyb_Mat4) * cap);
+    
+    if(!models)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    queue->models = models;
+    int *lods = (int*)SDL_realloc(queue->lods, sizeof(int) * cap);
+    
+    if(!lods)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    queue->lods = lods;
+    
+    //The ID table holds one slot per key field of each item at half load
+    int tableSize = cap * CYB_KEY_FIELD_COUNT * 2;
+    Cyb_IDSlot *table = (Cyb_IDSlot*)SDL_realloc(queue->table,
+        sizeof(Cyb_IDSlot) * tableSize);
+    
+    if(!table)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Out of Memory");
+        return CYB_ERROR;
+    }
+    
+    queue->table = table;
+    queue->tableSize = tableSize;
+    queue->cap = cap;
+    return CYB_NO_ERROR;
+}
+
+
+int Cyb_SubmitDraw(Cyb_RenderQueue *queue, const Cyb_DrawItem *item)
+{
+    //A mesh and a shader are required
+    if(!item->mesh || !item->shader)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybRender] Draw items need a mesh and a shader.");
+        return CYB_ERROR;
+    }
+    
+    //Grow the queue
+    if(queue->count == queue->cap && Cyb_GrowRenderQueue(queue))
+    {
+        return CYB_ERROR;
+    }
+    
+    queue->items[queue->count++] = *item;
+    return CYB_NO_ERROR;
+}
+
+
+int Cyb_GetDrawItemCount(Cyb_RenderQueue *queue)
+{
+    return queue->count;
+}
+
+
+void Cyb_ClearRenderQueue(Cyb_RenderQueue *queue)
+{
+    queue->count = 0;
+}
+
+
+static Uint32 Cyb_GetKeyID(Cyb_RenderQueue *queue, int field, const void *ptr)
+{
+    //NULL always maps to 0
+    if(!ptr)
+    {
+        return 0;
+    }
+    
+    //Look the pointer up with linear probing (the table size is a multiple
+    //of 2 but not always a power of 2)
+    Uint32 hash = (Uint32)(((Uint64)(size_t)ptr * 0x9E3779B97F4A7C15ull) >> 32);
+    int slot = (int)(hash % (Uint32)queue->tableSize);
+    
+    while(queue->table[slot].ptr)
+    {
+        if(queue->table[slot].ptr == ptr)
+        {
+            return queue->table[slot].id;
+        }
+        
+        slot = slot + 1 < queue->tableSize ? slot + 1 : 0;
+    }
+    
+    //Assign the next ID of the field (IDs past the field size share the
+    //largest one, which only costs some extra state changes)
+    Uint32 id = queue->nextID[field];
+    
+    if(id < fieldMasks[field])
+    {
+        queue->nextID[field]++;
+    }
+    
+    queue->table[slot].ptr = ptr;
+    queue->table[slot].id = id;
+    return id;
+}
+
+
+static Uint64 Cyb_GetDepthKey(float depth)
+{
+    //The bits of a positive float sort like the float itself
+    if(!(depth > 0.0f))
+    {
+        return 0;
+    }
+    
+    union
+    {
+        float f;
+        Uint32 u;
+    } bits;
+    
+    bits.f = depth;
+    return (bits.u >> (32 - CYB_KEY_DEPTH_BITS - 1)) &
+        CYB_KEY_MASK(CYB_KEY_DEPTH_BITS);
+}
+
+
+static void Cyb_BuildSortKeys(Cyb_RenderQueue *queue)
+{
+    //IDs are handed out in submission order each flush
+    memset(queue->table, 0, sizeof(Cyb_IDSlot) * queue->tableSize);
+    
+    for(int i = 0; i < CYB_KEY_FIELD_COUNT; i++)
+    {
+        queue->nextID[i] = 1;
+    }
+    
+    for(int i = 0; i < queue->count; i++)
+    {
+        const Cyb_DrawItem *item = &queue->items[i];
+        Uint64 state = Cyb_GetKeyID(queue, CYB_KEY_SHADER, item->shader);
+        state = (state << CYB_KEY_TEXTURE_BITS) |
+            Cyb_GetKeyID(queue, CYB_KEY_TEXTURE, item->textures[0]);
+        state = (state << CYB_KEY_MATERIAL_BITS) |
+            Cyb_GetKeyID(queue, CYB_KEY_MATERIAL, item->material);
+        state = (state << CYB_KEY_MESH_BITS) |
+            Cyb_GetKeyID(queue, CYB_KEY_MESH, item->mesh);
+        Uint64 depth = Cyb_GetDepthKey(item->depth);
+        
+        //Opaque: 0 | shader | texture | material | mesh | depth
+        //Transparent: 1 | inverted depth | shader | texture | material | mesh
+        if(item->transparent)
+        {
+            depth = CYB_KEY_MASK(CYB_KEY_DEPTH_BITS) - depth;
+            queue->entries[i].key = (1ull << 63) |
+                (depth << (63 - CYB_KEY_DEPTH_BITS)) | state;
+        }
+        else
+        {
+            queue->entries[i].key = (state << CYB_KEY_DEPTH_BITS) | depth;
+        }
+        
+        queue->entries[i].item = i;
+    }
+}
+
+
+static void Cyb_SortKeys(Cyb_RenderQueue *queue)
+{
+    //Stable LSD radix sort, 8 bits per pass
+    Cyb_SortEntry *src = queue->entries;
+    Cyb_SortEntry *dest = queue->scratch;
+    int count = queue->count;
+    
+    for(int shift = 0; shift < 64; shift += 8)
+    {
+        int offsets[256];
+        memset(offsets, 0, sizeof(offsets));
+        
+        for(int i = 0; i < count; i++)
+        {
+            offsets[(src[i].key >> shift) & 0xFF]++;
+        }
+        
+        //Skip passes where every key has the same digit
+        if(offsets[(src[0].key >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+        
+        int total = 0;
+        
+        for(int i = 0; i < 256; i++)
+        {
+            int n = offsets[i];
+            offsets[i] = total;
+            total += n;
+        }
+        
+        for(int i = 0; i < count; i++)
+        {
+            dest[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        
+        Cyb_SortEntry *tmp = src;
+        src = dest;
+        dest = tmp;
+    }
+    
+    //Keep the sorted entries in the entry array
+    queue->entries = src;
+    queue->scratch = dest;
+}
+
+
+static int Cyb_IsSameBatch(const Cyb_DrawItem *a, const Cyb_DrawItem *b)
+{
+    return a->mesh == b->mesh && a->shader == b->shader &&
+        a->material == b->material && a->pose == b->pose &&
+        !a->transparent == !b->transparent &&
+        !memcmp(a->textures, b->textures, sizeof(a->textures));
+}
+
+
+int Cyb_FlushRenderQueue(Cyb_Renderer *renderer, Cyb_RenderQueue *queue)
+{
+    //Nothing to draw?
+    if(!queue->count)
+    {
+        return 0;
+    }
+    
+    //Sort the items and gather their model matrices and levels of detail in
+    //draw order
+    Cyb_BuildSortKeys(queue);
+    Cyb_SortKeys(queue);
+    
+    for(int i = 0; i < queue->count; i++)
+    {
+        const Cyb_DrawItem *item = &queue->items[queue->entries[i].item];
+        queue->models[i] = item->model;
+        queue->lods[i] = Cyb_GetMeshLOD(renderer, item->mesh, &item->model);
+    }
+    
+    //Draw the items in batches
+    Cyb_Shader *shader = NULL;
+    Cyb_Material *material = NULL;
+    Cyb_Texture *textures[CYB_MAX_DRAW_TEXTURES] = {NULL};
+    Cyb_Pose *pose = NULL;
+    int blend = FALSE;
+    int drawCalls = 0;
+    int i = 0;
+    
+    while(i < queue->count)
+    {
+        //Find the end of the batch (each level of detail of a mesh is a 
+        //batch of its own)
+        const Cyb_DrawItem *item = &queue->items[queue->entries[i].item];
+        int end = i + 1;
+        
+        while(end < queue->count && queue->lods[end] == queue->lods[i] &&
+            Cyb_IsSameBatch(item, &queue->items[queue->entries[end].item]))
+        {
+            end++;
+        }
+        
+        //Transparent items come last
+        if(item->transparent && !blend)
+        {
+            Cyb_SetRenderCap(renderer, GL_BLEND, TRUE);
+            blend = TRUE;
+        }
+        
+        //Select the shader and assign its samplers to texture units
+        int shaderChanged = item->shader != shader;
+        
+        if(shaderChanged)
+        {
+            shader = item->shader;
+            Cyb_SelectShader(renderer, shader);
+            
+            for(int unit = 0; unit < CYB_MAX_DRAW_TEXTURES; unit++)
+            {
+                Cyb_SetTexture(renderer, shader, samplerNames[unit], unit);
+            }
+        }
+        
+        //Set the material uniforms
+        if(item->material && (shaderChanged || item->material != material))
+        {
+            Cyb_SetVec3(renderer, shader, "mat.ambient",
+                &item->material->ambient);
+            Cyb_SetVec3(renderer, shader, "mat.diffuse",
+                &item->material->diffuse);
+            Cyb_SetVec3(renderer, shader, "mat.specular",
+                &item->material->specular);
+            Cyb_SetFloat(renderer, shader, "mat.shininess",
+                item->material->shininess);
+        }
+        
+        material = item->material;
+        
+        //Bind the textures
+        for(int unit = 0; unit < CYB_MAX_DRAW_TEXTURES; unit++)
+        {
+            if(item->textures[unit] && item->textures[unit] != textures[unit])
+            {
+                Cyb_SelectTexture(renderer, item->textures[unit], unit);
+                textures[unit] = item->textures[unit];
+            }
+        }
+        
+        //Select the pose (bone matrices are per shader)
+        if(shaderChanged || item->pose != pose)
+        {
+            Cyb_SelectPose(renderer, shader, item->pose);
+            pose = item->pose;
+        }
+        
+        //Draw the batch (without touching the instance data of the mesh)
+        if(!Cyb_DrawMeshInstances(renderer, item->mesh, end - i,
+            &queue->models[i], NULL))
+        {
+            drawCalls++;
+        }
+        
+        i = end;
+    }
+    
+    //Restore the blend and armature state
+    if(blend)
+    {
+        Cyb_SetRenderCap(renderer, GL_BLEND, FALSE);
+    }
+    
+    if(pose)
+    {
+        Cyb_SelectPose(renderer, shader, NULL);
+    }
+    
+    queue->count = 0;
+    return drawCalls;
+}
\ No newline at end of file
@@ -2,6 +2,11 @@
 CybRender - Renderer API
 */
 
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
 #include <SDL2/SDL_opengl.h>
 
 #include "CybObjects.h"
@@ -18,14 +23,75 @@ CybRender - Renderer API
     }
 
 
+#define CYB_UNKNOWN_STATE ((GLuint)-1)
+#define CYB_GL_HALF_FLOAT_OES 0x8D61
+#define CYB_CACHED_CAP_COUNT 5
+#define CYB_GL_GPU_DISJOINT_EXT 0x8FBB
+#define CYB_GPU_QUERY_FRAMES 4 //frames in flight before results are read
+#define CYB_MAX_GPU_QUERIES (CYB_MAX_GPU_SCOPES * 2 + 1)
+
+
 //Structures
 //=================================================================================
+typedef struct
+{
+    GLuint program;
+    GLuint arrayBuffer;
+    GLuint elementBuffer;
+    GLuint vao;
+    int texUnit;
+    GLuint textures[CYB_MAX_CACHED_TEXTURE_UNITS];
+    int caps[CYB_CACHED_CAP_COUNT];
+    Cyb_StateCacheStats stats;
+} Cyb_StateCache;
+
+
+typedef struct
+{
+    int enabled;
+    Cyb_Vec3 camPos;
+    float projScale;
+    float projO;
+    float projP;
+    float biasScale;
+} Cyb_LODView;
+
+
+typedef struct
+{
+    int queryCount;
+    GLuint queries[CYB_MAX_GPU_QUERIES];
+    int queryScopes[CYB_MAX_GPU_QUERIES];
+    int scopeCount;
+    char scopeNames[CYB_MAX_GPU_SCOPES][CYB_MAX_GPU_SCOPE_NAME];
+} Cyb_GPUFrame;
+
+
+typedef struct
+{
+    int enabled;
+    int checkDisjoint;
+    int running;
+    int frame;
+    Cyb_GPUFrame frames[CYB_GPU_QUERY_FRAMES];
+    float time;
+    int scopeCount;
+    Cyb_GPUScopeTime scopes[CYB_MAX_GPU_SCOPES];
+} Cyb_GPUTimer;
+
+
 struct Cyb_Renderer
 {
     Cyb_Object base;
     SDL_Window *window;
     SDL_GLContext glCtx;
     Cyb_GLExtAPI glExtAPI;
+    Cyb_StateCache cache;
+    Cyb_LODView lodView;
+    struct Cyb_Armature *armature;
+    Cyb_RenderStats frameStats;
+    Cyb_RenderStats lastStats;
+    Cyb_GPUTimer gpuTimer;
 };
 
 
@@ -56,6 +122,555 @@ static void Cyb_FreeRenderer(Cyb_Renderer *renderer)
 }
 
 
+static int Cyb_GetCapIndex(GLenum cap)
+{
+    //Get the state cache index of a capability
+    switch(cap)
+    {
+    case GL_BLEND:
+        return 0;
+        
+    case GL_CULL_FACE:
+        return 1;
+        
+    case GL_DEPTH_TEST:
+        return 2;
+        
+    case GL_SCISSOR_TEST:
+        return 3;
+        
+    case GL_STENCIL_TEST:
+        return 4;
+        
+    default:
+        return -1;
+    }
+}
+
+
+static void Cyb_GetGLVersion(int *isES, int *major, int *minor)
+{
+    //Parse the OpenGL version
+    const char *version = (const char*)glGetString(GL_VERSION);
+    *isES = version && strncmp(version, "OpenGL ES", 9) == 0;
+    *major = 0;
+    *minor = 0;
+    
+    if(version)
+    {
+        sscanf(*isES ? version + 9 : version, "%d.%d", major, minor);
+    }
+}
+
+
+static void Cyb_InitVertexArrays(Cyb_GLExtAPI *glExtAPI)
+{
+    //Get the OpenGL version
+    int isES;
+    int major;
+    int minor;
+    Cyb_GetGLVersion(&isES, &major, &minor);
+    
+    //Vertex array objects are core in OpenGL 3.0 and OpenGL ES 3.0. Older
+    //versions may provide them through an extension.
+    const char *suffix = NULL;
+    
+    if(major >= 3 || (!isES && 
+        SDL_GL_ExtensionSupported("GL_ARB_vertex_array_object")))
+    {
+        suffix = "";
+    }
+    else if(isES && SDL_GL_ExtensionSupported("GL_OES_vertex_array_object"))
+    {
+        suffix = "OES";
+    }
+    
+    //Import vertex array functions
+    glExtAPI->GenVertexArrays = NULL;
+    glExtAPI->DeleteVertexArrays = NULL;
+    glExtAPI->BindVertexArray = NULL;
+    
+    if(suffix)
+    {
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "glGenVertexArrays%s", suffix);
+        glExtAPI->GenVertexArrays = 
+            (PFNGLGENVERTEXARRAYSPROC)SDL_GL_GetProcAddress(name);
+        SDL_snprintf(name, sizeof(name), "glDeleteVertexArrays%s", suffix);
+        glExtAPI->DeleteVertexArrays = 
+            (PFNGLDELETEVERTEXARRAYSPROC)SDL_GL_GetProcAddress(name);
+        SDL_snprintf(name, sizeof(name), "glBindVertexArray%s", suffix);
+        glExtAPI->BindVertexArray = 
+            (PFNGLBINDVERTEXARRAYPROC)SDL_GL_GetProcAddress(name);
+    }
+    
+    if(!glExtAPI->GenVertexArrays || !glExtAPI->DeleteVertexArrays ||
+        !glExtAPI->BindVertexArray)
+    {
+        glExtAPI->GenVertexArrays = NULL;
+        glExtAPI->DeleteVertexArrays = NULL;
+        glExtAPI->BindVertexArray = NULL;
+        SDL_Log("%s", 
+            "[CybRender] Vertex array objects not supported. Vertex attribs will be set up for each draw call.");
+    }
+}
+
+
+static void Cyb_InitInstancing(Cyb_GLExtAPI *glExtAPI)
+{
+    //Get the OpenGL version
+    int isES;
+    int major;
+    int minor;
+    Cyb_GetGLVersion(&isES, &major, &minor);
+    
+    //Instancing is core in OpenGL 3.3 and OpenGL ES 3.0. Older versions may
+    //provide it through an extension. The version has to be checked first
+    //because some drivers return a function for any name.
+    const char *drawName = NULL;
+    const char *divisorName = NULL;
+    
+    if(isES ? major >= 3 : major > 3 || (major == 3 && minor >= 3))
+    {
+        drawName = "glDrawElementsInstanced";
+        divisorName = "glVertexAttribDivisor";
+    }
+    else if(SDL_GL_ExtensionSupported("GL_ARB_instanced_arrays") &&
+        SDL_GL_ExtensionSupported("GL_ARB_draw_instanced"))
+    {
+        drawName = "glDrawElementsInstancedARB";
+        divisorName = "glVertexAttribDivisorARB";
+    }
+    else if(SDL_GL_ExtensionSupported("GL_EXT_instanced_arrays"))
+    {
+        drawName = "glDrawElementsInstancedEXT";
+        divisorName = "glVertexAttribDivisorEXT";
+    }
+    else if(SDL_GL_ExtensionSupported("GL_ANGLE_instanced_arrays"))
+    {
+        drawName = "glDrawElementsInstancedANGLE";
+        divisorName = "glVertexAttribDivisorANGLE";
+    }
+    
+    //Import instanced drawing functions
+    glExtAPI->DrawElementsInstanced = NULL;
+    glExtAPI->VertexAttribDivisor = NULL;
+    
+    if(drawName)
+    {
+        glExtAPI->DrawElementsInstanced = 
+            (PFNGLDRAWELEMENTSINSTANCEDPROC)SDL_GL_GetProcAddress(drawName);
+        glExtAPI->VertexAttribDivisor = 
+            (PFNGLVERTEXATTRIBDIVISORPROC)SDL_GL_GetProcAddress(divisorName);
+    }
+    
+    if(!glExtAPI->DrawElementsInstanced || !glExtAPI->VertexAttribDivisor)
+    {
+        glExtAPI->DrawElementsInstanced = NULL;
+        glExtAPI->VertexAttribDivisor = NULL;
+        SDL_Log("%s", 
+            "[CybRender] Hardware instancing not supported. Instances will be drawn one at a time.");
+    }
+}
+
+
+static void Cyb_InitBufferStorage(Cyb_GLExtAPI *glExtAPI)
+{
+    //Get the OpenGL version
+    int isES;
+    int major;
+    int minor;
+    Cyb_GetGLVersion(&isES, &major, &minor);
+    
+    //Persistent mapping needs buffer storage (core in OpenGL 4.4), mapped
+    //buffer ranges (core in OpenGL 3.0), and fences (core in OpenGL 3.2).
+    //OpenGL ES 3.0 has the latter two and may provide the first through an 
+    //extension.
+    const char *storageName = NULL;
+    
+    if(isES)
+    {
+        if(major >= 3 && SDL_GL_ExtensionSupported("GL_EXT_buffer_storage"))
+        {
+            storageName = "glBufferStorageEXT";
+        }
+    }
+    else if((major > 4 || (major == 4 && minor >= 4) || 
+        SDL_GL_ExtensionSupported("GL_ARB_buffer_storage")) &&
+        (major > 3 || (major == 3 && minor >= 2) || 
+        (SDL_GL_ExtensionSupported("GL_ARB_sync") && 
+        SDL_GL_ExtensionSupported("GL_ARB_map_buffer_range"))))
+    {
+        storageName = "glBufferStorage";
+    }
+    
+    //Import buffer storage functions
+    glExtAPI->BufferStorage = NULL;
+    glExtAPI->MapBufferRange = NULL;
+    glExtAPI->UnmapBuffer = NULL;
+    glExtAPI->FenceSync = NULL;
+    glExtAPI->ClientWaitSync = NULL;
+    glExtAPI->DeleteSync = NULL;
+    
+    if(storageName)
+    {
+        glExtAPI->BufferStorage = 
+            (PFNGLBUFFERSTORAGEPROC)SDL_GL_GetProcAddress(storageName);
+        glExtAPI->MapBufferRange = 
+            (PFNGLMAPBUFFERRANGEPROC)SDL_GL_GetProcAddress("glMapBufferRange");
+        glExtAPI->UnmapBuffer = 
+            (PFNGLUNMAPBUFFERPROC)SDL_GL_GetProcAddress("glUnmapBuffer");
+        glExtAPI->FenceSync = 
+            (PFNGLFENCESYNCPROC)SDL_GL_GetProcAddress("glFenceSync");
+        glExtAPI->ClientWaitSync = 
+            (PFNGLCLIENTWAITSYNCPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+        glExtAPI->DeleteSync = 
+            (PFNGLDELETESYNCPROC)SDL_GL_GetProcAddress("glDeleteSync");
+    }
+    
+    if(!glExtAPI->BufferStorage || !glExtAPI->MapBufferRange || 
+        !glExtAPI->UnmapBuffer || !glExtAPI->FenceSync || 
+        !glExtAPI->ClientWaitSync || !glExtAPI->DeleteSync)
+    {
+        glExtAPI->BufferStorage = NULL;
+        glExtAPI->MapBufferRange = NULL;
+        glExtAPI->UnmapBuffer = NULL;
+        glExtAPI->FenceSync = NULL;
+        glExtAPI->ClientWaitSync = NULL;
+        glExtAPI->DeleteSync = NULL;
+        SDL_Log("%s", 
+            "[CybRender] Persistently mapped buffers not supported. Streaming meshes will orphan their buffers instead.");
+    }
+}
+
+
+static void Cyb_InitBaseVertex(Cyb_GLExtAPI *glExtAPI)
+{
+    //Get the OpenGL version
+    int isES;
+    int major;
+    int minor;
+    Cyb_GetGLVersion(&isES, &major, &minor);
+    
+    //Drawing with a base vertex is core in OpenGL 3.2 and OpenGL ES 3.2 and
+    //copying between buffers is core in OpenGL 3.1 and OpenGL ES 3.0. Older
+    //versions may provide both through extensions.
+    const char *suffix = NULL;
+    
+    if(isES ? major > 3 || (major == 3 && minor >= 2) : 
+        major > 3 || (major == 3 && minor >= 2) || 
+        (SDL_GL_ExtensionSupported("GL_ARB_draw_elements_base_vertex") &&
+        (major > 3 || (major == 3 && minor >= 1) || 
+        SDL_GL_ExtensionSupported("GL_ARB_copy_buffer"))))
+    {
+        suffix = "";
+    }
+    else if(isES && major >= 3 && 
+        SDL_GL_ExtensionSupported("GL_OES_draw_elements_base_vertex"))
+    {
+        suffix = "OES";
+    }
+    else if(isES && major >= 3 && 
+        SDL_GL_ExtensionSupported("GL_EXT_draw_elements_base_vertex"))
+    {
+        suffix = "EXT";
+    }
+    
+    //Import base vertex functions
+    glExtAPI->DrawElementsBaseVertex = NULL;
+    glExtAPI->DrawElementsInstancedBaseVertex = NULL;
+    glExtAPI->CopyBufferSubData = NULL;
+    
+    if(suffix)
+    {
+        char name[64];
+        SDL_snprintf(name, sizeof(name), "glDrawElementsBaseVertex%s", suffix);
+        glExtAPI->DrawElementsBaseVertex = 
+            (PFNGLDRAWELEMENTSBASEVERTEXPROC)SDL_GL_GetProcAddress(name);
+        SDL_snprintf(name, sizeof(name), "glDrawElementsInstancedBaseVertex%s",
+            suffix);
+        glExtAPI->DrawElementsInstancedBaseVertex = 
+            (PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC)SDL_GL_GetProcAddress(
+            name);
+        glExtAPI->CopyBufferSubData = 
+            (PFNGLCOPYBUFFERSUBDATAPROC)SDL_GL_GetProcAddress(
+            "glCopyBufferSubData");
+    }
+    
+    if(!glExtAPI->DrawElementsBaseVertex || 
+        !glExtAPI->DrawElementsInstancedBaseVertex || 
+        !glExtAPI->CopyBufferSubData)
+    {
+        glExtAPI->DrawElementsBaseVertex = NULL;
+        glExtAPI->DrawElementsInstancedBaseVertex = NULL;
+        glExtAPI->CopyBufferSubData = NULL;
+        SDL_Log("%s", 
+            "[CybRender] Base vertex drawing not supported. Meshes will not share buffers in geometry arenas.");
+    }
+}
+
+
+static void Cyb_InitVertexTypes(Cyb_GLExtAPI *glExtAPI)
+{
+    //Get the OpenGL version
+    int isES;
+    int major;
+    int minor;
+    Cyb_GetGLVersion(&isES, &major, &minor);
+    
+    //Half float attribs are core in OpenGL 3.0 and OpenGL ES 3.0. OpenGL ES 
+    //2.0 may provide them through an extension with a different enum value.
+    glExtAPI->HalfFloatType = 0;
+    
+    if(major >= 3 || (!isES && 
+        SDL_GL_ExtensionSupported("GL_ARB_half_float_vertex")))
+    {
+        glExtAPI->HalfFloatType = GL_HALF_FLOAT;
+    }
+    else if(isES && SDL_GL_ExtensionSupported("GL_OES_vertex_half_float"))
+    {
+        glExtAPI->HalfFloatType = CYB_GL_HALF_FLOAT_OES;
+    }
+    
+    //Packed 10:10:10:2 attribs are core in OpenGL 3.3 and OpenGL ES 3.0
+    glExtAPI->Int2101010Type = 0;
+    
+    if((isES ? major >= 3 : major > 3 || (major == 3 && minor >= 3)) ||
+        (!isES && SDL_GL_ExtensionSupported("GL_ARB_vertex_type_2_10_10_10_rev")))
+    {
+        glExtAPI->Int2101010Type = GL_INT_2_10_10_10_REV;
+    }
+}
+
+
+static void Cyb_InitTimerQueries(Cyb_GLExtAPI *glExtAPI)
+{
+    //Get the OpenGL version
+    int isES;
+    int major;
+    int minor;
+    Cyb_GetGLVersion(&isES, &major, &minor);
+    
+    //GL_TIME_ELAPSED queries are core in OpenGL 3.3. Older versions and 
+    //OpenGL ES may provide them through an extension.
+    const char *suffix = NULL;
+    
+    if(isES)
+    {
+        if(SDL_GL_ExtensionSupported("GL_EXT_disjoint_timer_query"))
+        {
+            suffix = "EXT";
+        }
+    }
+    else if(major > 3 || (major == 3 && minor >= 3) || 
+        SDL_GL_ExtensionSupported("GL_ARB_timer_query"))
+    {
+        suffix = "";
+    }
+    
+    //Import timer query functions
+    glExtAPI->GenQueries = NULL;
+    glExtAPI->BeginQuery = NULL;
+    glExtAPI->EndQuery = NULL;
+    glExtAPI->GetQueryObjectuiv = NULL;
+    glExtAPI->GetQueryObjectui64v = NULL;
+    
+    if(suffix)
+    {
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "glGenQueries%s", suffix);
+        glExtAPI->GenQueries = 
+            (PFNGLGENQUERIESPROC)SDL_GL_GetProcAddress(name);
+        SDL_snprintf(name, sizeof(name), "glBeginQuery%s", suffix);
+        glExtAPI->BeginQuery = 
+            (PFNGLBEGINQUERYPROC)SDL_GL_GetProcAddress(name);
+        SDL_snprintf(name, sizeof(name), "glEndQuery%s", suffix);
+        glExtAPI->EndQuery = 
+            (PFNGLENDQUERYPROC)SDL_GL_GetProcAddress(name);
+        SDL_snprintf(name, sizeof(name), "glGetQueryObjectuiv%s", suffix);
+        glExtAPI->GetQueryObjectuiv = 
+            (PFNGLGETQUERYOBJECTUIVPROC)SDL_GL_GetProcAddress(name);
+        SDL_snprintf(name, sizeof(name), "glGetQueryObjectui64v%s", suffix);
+        glExtAPI->GetQueryObjectui64v = 
+            (PFNGLGETQUERYOBJECTUI64VPROC)SDL_GL_GetProcAddress(name);
+    }
+    
+    if(!glExtAPI->GenQueries || !glExtAPI->BeginQuery || 
+        !glExtAPI->EndQuery || !glExtAPI->GetQueryObjectuiv || 
+        !glExtAPI->GetQueryObjectui64v)
+    {
+        glExtAPI->GenQueries = NULL;
+        glExtAPI->BeginQuery = NULL;
+        glExtAPI->EndQuery = NULL;
+        glExtAPI->GetQueryObjectuiv = NULL;
+        glExtAPI->GetQueryObjectui64v = NULL;
+        SDL_Log("%s", 
+            "[CybRender] Timer queries not supported. GPU times will not be measured.");
+    }
+}
+
+
+static void Cyb_StartGPUQuery(Cyb_Renderer *renderer, int scope)
+{
+    //Start the next query of the frame
+    Cyb_GPUTimer *timer = &renderer->gpuTimer;
+    Cyb_GPUFrame *frame = &timer->frames[timer->frame];
+    renderer->glExtAPI.BeginQuery(GL_TIME_ELAPSED, 
+        frame->queries[frame->queryCount]);
+    frame->queryScopes[frame->queryCount++] = scope;
+    timer->running = TRUE;
+}
+
+
+static void Cyb_StopGPUQuery(Cyb_Renderer *renderer)
+{
+    //Only one GL_TIME_ELAPSED query can run at a time
+    Cyb_GPUTimer *timer = &renderer->gpuTimer;
+    
+    if(timer->running)
+    {
+        renderer->glExtAPI.EndQuery(GL_TIME_ELAPSED);
+        timer->running = FALSE;
+    }
+}
+
+
+static void Cyb_SplitGPUQuery(Cyb_Renderer *renderer, int scope)
+{
+    //Keep the running query once the queries of the frame run out, so the
+    //rest of the frame is still timed
+    Cyb_GPUTimer *timer = &renderer->gpuTimer;
+    
+    if(timer->frames[timer->frame].queryCount == CYB_MAX_GPU_QUERIES)
+    {
+        return;
+    }
+    
+    Cyb_SelectRenderer(renderer);
+    Cyb_StopGPUQuery(renderer);
+    Cyb_StartGPUQuery(renderer, scope);
+}
+
+
+static void Cyb_ReadGPUFrame(Cyb_Renderer *renderer, Cyb_GPUFrame *frame)
+{
+    //Skip the frame if its results are not ready yet instead of waiting (the
+    //last query finishes last)
+    Cyb_GLExtAPI *glExtAPI = &renderer->glExtAPI;
+    Cyb_GPUTimer *timer = &renderer->gpuTimer;
+    GLuint available = GL_FALSE;
+    
+    if(!frame->queryCount)
+    {
+        return;
+    }
+    
+    glExtAPI->GetQueryObjectuiv(frame->queries[frame->queryCount - 1], 
+        GL_QUERY_RESULT_AVAILABLE, &available);
+    
+    if(!available)
+    {
+        return;
+    }
+    
+    //Add up the time of the frame and of each scope
+    float times[CYB_MAX_GPU_SCOPES] = {0.0f};
+    float total = 0.0f;
+    
+    for(int i = 0; i < frame->queryCount; i++)
+    {
+        GLuint64 ns = 0;
+        glExtAPI->GetQueryObjectui64v(frame->queries[i], GL_QUERY_RESULT, &ns);
+        float ms = (float)(ns / 1.0e6);
+        total += ms;
+        
+        if(frame->queryScopes[i] >= 0)
+        {
+            times[frame->queryScopes[i]] += ms;
+        }
+    }
+    
+    //Results are garbage if the GPU was disjoint (OpenGL ES only)
+    if(timer->checkDisjoint)
+    {
+        GLint disjoint = 0;
+        glGetIntegerv(CYB_GL_GPU_DISJOINT_EXT, &disjoint);
+        
+        if(disjoint)
+        {
+            return;
+        }
+    }
+    
+    timer->time = total;
+    timer->scopeCount = frame->scopeCount;
+    
+    for(int i = 0; i < frame->scopeCount; i++)
+    {
+        SDL_strlcpy(timer->scopes[i].name, frame->scopeNames[i], 
+            CYB_MAX_GPU_SCOPE_NAME);
+        timer->scopes[i].time = times[i];
+    }
+}
+
+
+static void Cyb_BeginGPUFrame(Cyb_Renderer *renderer)
+{
+    //Move on to the oldest frame and collect its results
+    Cyb_GPUTimer *timer = &renderer->gpuTimer;
+    
+    if(!timer->enabled)
+    {
+        return;
+    }
+    
+    timer->frame = (timer->frame + 1) % CYB_GPU_QUERY_FRAMES;
+    Cyb_GPUFrame *frame = &timer->frames[timer->frame];
+    Cyb_ReadGPUFrame(renderer, frame);
+    frame->queryCount = 0;
+    frame->scopeCount = 0;
+    
+    //Time everything outside of scopes as well
+    Cyb_StartGPUQuery(renderer, -1);
+}
+
+
+static void Cyb_InitGPUTimer(Cyb_Renderer *renderer)
+{
+    //Create the queries of every frame in flight
+    Cyb_GPUTimer *timer = &renderer->gpuTimer;
+    memset(timer, 0, sizeof(Cyb_GPUTimer));
+    timer->time = -1.0f;
+    
+    if(!renderer->glExtAPI.GenQueries)
+    {
+        return;
+    }
+    
+    for(int i = 0; i < CYB_GPU_QUERY_FRAMES; i++)
+    {
+        renderer->glExtAPI.GenQueries(CYB_MAX_GPU_QUERIES, 
+            timer->frames[i].queries);
+    }
+    
+    int isES;
+    int major;
+    int minor;
+    Cyb_GetGLVersion(&isES, &major, &minor);
+    timer->checkDisjoint = isES;
+    timer->enabled = TRUE;
+    
+    //Clear the disjoint flag and start the first frame
+    if(isES)
+    {
+        GLint disjoint;
+        glGetIntegerv(CYB_GL_GPU_DISJOINT_EXT, &disjoint);
+    }
+    
+    Cyb_BeginGPUFrame(renderer);
+}
+
+
 static int Cyb_InitGLExtAPI(Cyb_GLExtAPI *glExtAPI)
 {
     //Import shader functions
@@ -183,6 +798,11 @@ static int Cyb_InitGLExtAPI(Cyb_GLExtAPI *glExtAPI)
         PFNGLBUFFERDATAPROC,
         "glBufferData"
     );
+    IMPORT_GL_FUNC(
+        glExtAPI->BufferSubData, 
+        PFNGLBUFFERSUBDATAPROC,
+        "glBufferSubData"
+    );
     
     //Import vertex attrib functions
     IMPORT_GL_FUNC(
@@ -200,6 +820,11 @@ static int Cyb_InitGLExtAPI(Cyb_GLExtAPI *glExtAPI)
         PFNGLVERTEXATTRIBPOINTERPROC,
         "glVertexAttribPointer"
     );
+    IMPORT_GL_FUNC(
+        glExtAPI->VertexAttrib4fv,
+        PFNGLVERTEXATTRIB4FVPROC,
+        "glVertexAttrib4fv"
+    );
     
     //Import texture functions
     IMPORT_GL_FUNC(
@@ -208,17 +833,14 @@ static int Cyb_InitGLExtAPI(Cyb_GLExtAPI *glExtAPI)
         "glActiveTexture"
     );
     
-    /* //Import instanced drawing functions
-    IMPORT_GL_FUNC(
-        glExtAPI->DrawElementsInstanced,
-        PFNGLDRAWELEMENTSINSTANCEDPROC,
-        "glDrawElementsInstanced"
-    );
-    IMPORT_GL_FUNC(
-        glExtAPI->VertexAttribDivisor,
-        PFNGLVERTEXATTRIBDIVISORPROC,
-        "glVertexAttribDivisor"
-    ); */
+    //Import vertex array, instanced drawing, buffer storage, base vertex, and
+    //timer query functions (optional) and check for compact vertex types
+    Cyb_InitVertexArrays(glExtAPI);
+    Cyb_InitInstancing(glExtAPI);
+    Cyb_InitBufferStorage(glExtAPI);
+    Cyb_InitBaseVertex(glExtAPI);
+    Cyb_InitTimerQueries(glExtAPI);
+    Cyb_InitVertexTypes(glExtAPI);
     
     return CYB_NO_ERROR;
 }
@@ -243,6 +865,7 @@ Cyb_Renderer *Cyb_CreateRenderer(SDL_Window *window)
     
     //Initialize the renderer
     renderer->window = window;
+    renderer->armature = NULL;
     renderer->glCtx = SDL_GL_CreateContext(window);
     
     if(!renderer->glCtx)
@@ -260,6 +883,16 @@ Cyb_Renderer *Cyb_CreateRenderer(SDL_Window *window)
         Cyb_FreeObject((Cyb_Object**)&renderer);
         return NULL;
     }
+    
+    Cyb_InvalidateStateCache(renderer);
+    Cyb_ResetStateCacheStats(renderer);
+    memset(&renderer->lodView, 0, sizeof(Cyb_LODView));
+    Cyb_SetLODCamera(renderer, NULL, NULL);
+    Cyb_SetLODBias(renderer, 0.0f);
+    memset(&renderer->frameStats, 0, sizeof(Cyb_RenderStats));
+    memset(&renderer->lastStats, 0, sizeof(Cyb_RenderStats));
+    renderer->lastStats.gpuTime = -1.0f;
+    Cyb_InitGPUTimer(renderer);
 
     return renderer;
 }
@@ -300,7 +933,432 @@ Cyb_GLExtAPI *Cyb_GetGLExtAPI(Cyb_Renderer *renderer)
 }
 
 
+void Cyb_UseProgram(Cyb_Renderer *renderer, GLuint program)
+{
+    //Skip redundant program changes
+    Cyb_StateCache *cache = &renderer->cache;
+    
+    if(cache->program == program)
+    {
+        cache->stats.programSkips++;
+        return;
+    }
+    
+    renderer->glExtAPI.UseProgram(program);
+    cache->program = program;
+    cache->stats.programBinds++;
+    renderer->frameStats.programSwitches++;
+}
+
+
+void Cyb_BindBuffer(Cyb_Renderer *renderer, GLenum target, GLuint buffer)
+{
+    //Get the cached binding of the target
+    Cyb_StateCache *cache = &renderer->cache;
+    GLuint *binding = NULL;
+    
+    if(target == GL_ARRAY_BUFFER)
+    {
+        binding = &cache->arrayBuffer;
+    }
+    else if(target == GL_ELEMENT_ARRAY_BUFFER)
+    {
+        binding = &cache->elementBuffer;
+    }
+    
+    //Skip redundant buffer changes
+    if(binding && *binding == buffer)
+    {
+        cache->stats.bufferSkips++;
+        return;
+    }
+    
+    renderer->glExtAPI.BindBuffer(target, buffer);
+    cache->stats.bufferBinds++;
+    
+    if(binding)
+    {
+        *binding = buffer;
+    }
+}
+
+
+void Cyb_BindVertexArray(Cyb_Renderer *renderer, GLuint vao)
+{
+    //Ignore this if vertex array objects are not supported
+    if(!renderer->glExtAPI.BindVertexArray)
+    {
+        return;
+    }
+    
+    //Skip redundant vertex array object changes
+    Cyb_StateCache *cache = &renderer->cache;
+    
+    if(cache->vao == vao)
+    {
+        cache->stats.vaoSkips++;
+        return;
+    }
+    
+    renderer->glExtAPI.BindVertexArray(vao);
+    cache->vao = vao;
+    cache->elementBuffer = CYB_UNKNOWN_STATE;
+    cache->stats.vaoBinds++;
+}
+
+
+void Cyb_BindTexture(Cyb_Renderer *renderer, int texUnit, GLuint texture)
+{
+    //Skip redundant texture unit changes
+    Cyb_StateCache *cache = &renderer->cache;
+    
+    if(texUnit == CYB_ACTIVE_TEXTURE_UNIT)
+    {
+        texUnit = cache->texUnit;
+    }
+    else if(cache->texUnit == texUnit)
+    {
+        cache->stats.textureSkips++;
+    }
+    else
+    {
+        renderer->glExtAPI.ActiveTexture(GL_TEXTURE0 + texUnit);
+        cache->texUnit = texUnit;
+        cache->stats.textureBinds++;
+    }
+    
+    //Skip redundant texture changes (the active unit may be unknown)
+    if(texUnit < 0 || texUnit >= CYB_MAX_CACHED_TEXTURE_UNITS)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        cache->stats.textureBinds++;
+        renderer->frameStats.textureBinds++;
+    }
+    else if(cache->textures[texUnit] == texture)
+    {
+        cache->stats.textureSkips++;
+    }
+    else
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        cache->textures[texUnit] = texture;
+        cache->stats.textureBinds++;
+        renderer->frameStats.textureBinds++;
+    }
+}
+
+
+void Cyb_SetRenderCap(Cyb_Renderer *renderer, GLenum cap, int enable)
+{
+    //Skip redundant capability changes
+    Cyb_StateCache *cache = &renderer->cache;
+    int i = Cyb_GetCapIndex(cap);
+    enable = enable ? TRUE : FALSE;
+    
+    if(i >= 0 && cache->caps[i] == enable)
+    {
+        cache->stats.capSkips++;
+        return;
+    }
+    
+    if(enable)
+    {
+        glEnable(cap);
+    }
+    else
+    {
+        glDisable(cap);
+    }
+    
+    cache->stats.capChanges++;
+    
+    if(i >= 0)
+    {
+        cache->caps[i] = enable;
+    }
+}
+
+
+void Cyb_DeleteBuffers(Cyb_Renderer *renderer, int count, 
+    const GLuint *buffers)
+{
+    //Deleted buffers are unbound by OpenGL
+    Cyb_StateCache *cache = &renderer->cache;
+    
+    for(int i = 0; i < count; i++)
+    {
+        if(cache->arrayBuffer == buffers[i])
+        {
+            cache->arrayBuffer = 0;
+        }
+        
+        if(cache->elementBuffer == buffers[i])
+        {
+            cache->elementBuffer = 0;
+        }
+    }
+    
+    renderer->glExtAPI.DeleteBuffers(count, buffers);
+}
+
+
+void Cyb_DeleteVertexArrays(Cyb_Renderer *renderer, int count, 
+    const GLuint *vaos)
+{
+    //A deleted vertex array object is unbound by OpenGL
+    Cyb_StateCache *cache = &renderer->cache;
+    
+    for(int i = 0; i < count; i++)
+    {
+        if(cache->vao == vaos[i])
+        {
+            cache->vao = 0;
+            cache->elementBuffer = CYB_UNKNOWN_STATE;
+        }
+    }
+    
+    renderer->glExtAPI.DeleteVertexArrays(count, vaos);
+}
+
+
+void Cyb_DeleteTextures(Cyb_Renderer *renderer, int count, 
+    const GLuint *textures)
+{
+    //Deleted textures are unbound from every texture unit by OpenGL
+    Cyb_StateCache *cache = &renderer->cache;
+    
+    for(int i = 0; i < count; i++)
+    {
+        for(int j = 0; j < CYB_MAX_CACHED_TEXTURE_UNITS; j++)
+        {
+            if(cache->textures[j] == textures[i])
+            {
+                cache->textures[j] = 0;
+            }
+        }
+    }
+    
+    glDeleteTextures(count, textures);
+}
+
+
+void Cyb_DeleteProgram(Cyb_Renderer *renderer, GLuint program)
+{
+    //A program in use is only deleted once it is no longer in use, so its
+    //name could be reused after the next program change
+    Cyb_StateCache *cache = &renderer->cache;
+    
+    if(cache->program == program)
+    {
+        cache->program = CYB_UNKNOWN_STATE;
+    }
+    
+    renderer->glExtAPI.DeleteProgram(program);
+}
+
+
+void Cyb_InvalidateStateCache(Cyb_Renderer *renderer)
+{
+    //Mark all cached state as unknown
+    Cyb_StateCache *cache = &renderer->cache;
+    cache->program = CYB_UNKNOWN_STATE;
+    cache->arrayBuffer = CYB_UNKNOWN_STATE;
+    cache->elementBuffer = CYB_UNKNOWN_STATE;
+    cache->vao = CYB_UNKNOWN_STATE;
+    cache->texUnit = -1;
+    
+    for(int i = 0; i < CYB_MAX_CACHED_TEXTURE_UNITS; i++)
+    {
+        cache->textures[i] = CYB_UNKNOWN_STATE;
+    }
+    
+    for(int i = 0; i < CYB_CACHED_CAP_COUNT; i++)
+    {
+        cache->caps[i] = -1;
+    }
+}
+
+
+void Cyb_GetStateCacheStats(Cyb_Renderer *renderer, 
+    Cyb_StateCacheStats *stats)
+{
+    *stats = renderer->cache.stats;
+}
+
+
+void Cyb_ResetStateCacheStats(Cyb_Renderer *renderer)
+{
+    memset(&renderer->cache.stats, 0, sizeof(Cyb_StateCacheStats));
+}
+
+
+void Cyb_SetSelectedArmature(Cyb_Renderer *renderer, 
+    struct Cyb_Armature *armature)
+{
+    renderer->armature = armature;
+}
+
+
+struct Cyb_Armature *Cyb_GetSelectedArmature(Cyb_Renderer *renderer)
+{
+    return renderer->armature;
+}
+
+
+void Cyb_SetLODCamera(Cyb_Renderer *renderer, const Cyb_Mat4 *view,
+    const Cyb_Mat4 *proj)
+{
+    //Disable LOD selection?
+    Cyb_LODView *lodView = &renderer->lodView;
+    
+    if(!view || !proj)
+    {
+        lodView->enabled = FALSE;
+        return;
+    }
+    
+    //The camera position is the translation of the inverse view matrix (the
+    //previous position is kept if the view matrix can't be inverted)
+    Cyb_Mat4 inv;
+    Cyb_Identity(&inv);
+    inv.d = lodView->camPos.x;
+    inv.h = lodView->camPos.y;
+    inv.l = lodView->camPos.z;
+    Cyb_Invert(&inv, view);
+    lodView->camPos.x = inv.d;
+    lodView->camPos.y = inv.h;
+    lodView->camPos.z = inv.l;
+    
+    //A point at distance d straight ahead of the camera ends up with a clip W
+    //of p - o * d (d for perspective and 1 for orthographic projections)
+    lodView->projScale = proj->f;
+    lodView->projO = proj->o;
+    lodView->projP = proj->p;
+    lodView->enabled = TRUE;
+}
+
+
+void Cyb_SetLODBias(Cyb_Renderer *renderer, float bias)
+{
+    renderer->lodView.biasScale = powf(2.0f, -bias);
+}
+
+
+float Cyb_GetLODScreenSize(Cyb_Renderer *renderer, const Cyb_Vec3 *center,
+    float radius)
+{
+    //No LOD camera?
+    Cyb_LODView *lodView = &renderer->lodView;
+    
+    if(!lodView->enabled)
+    {
+        return -1.0f;
+    }
+    
+    //Get the distance to the sphere
+    Cyb_Vec3 offset;
+    Cyb_SubVec3(&offset, center, &lodView->camPos);
+    float dist = sqrtf(offset.x * offset.x + offset.y * offset.y + 
+        offset.z * offset.z);
+    float w = lodView->projP - lodView->projO * dist;
+    
+    //Spheres around the camera cover the whole screen
+    if(dist <= radius || w <= 0.0f)
+    {
+        return FLT_MAX;
+    }
+    
+    return radius * lodView->projScale / w * lodView->biasScale;
+}
+
+
+void Cyb_AddDrawStats(Cyb_Renderer *renderer, int triangles, int instances)
+{
+    Cyb_RenderStats *stats = &renderer->frameStats;
+    stats->drawCalls++;
+    stats->instances += instances;
+    stats->triangles += (Uint64)triangles * instances;
+}
+
+
+void Cyb_AddUploadStats(Cyb_Renderer *renderer, size_t bytes)
+{
+    renderer->frameStats.uploadBytes += bytes;
+}
+
+
+void Cyb_GetRenderStats(Cyb_Renderer *renderer, Cyb_RenderStats *stats)
+{
+    *stats = renderer->lastStats;
+}
+
+
+void Cyb_BeginGPUScope(Cyb_Renderer *renderer, const char *name)
+{
+    //Timer queries not supported?
+    Cyb_GPUTimer *timer = &renderer->gpuTimer;
+    
+    if(!timer->enabled)
+    {
+        return;
+    }
+    
+    //Find the scope or add it to the frame
+    Cyb_GPUFrame *frame = &timer->frames[timer->frame];
+    int scope = 0;
+    
+    while(scope < frame->scopeCount && 
+        SDL_strncmp(frame->scopeNames[scope], name, 
+        CYB_MAX_GPU_SCOPE_NAME - 1) != 0)
+    {
+        scope++;
+    }
+    
+    if(scope == frame->scopeCount)
+    {
+        if(scope == CYB_MAX_GPU_SCOPES)
+        {
+            return;
+        }
+        
+        SDL_strlcpy(frame->scopeNames[scope], name, CYB_MAX_GPU_SCOPE_NAME);
+        frame->scopeCount++;
+    }
+    
+    //Split the frame into a new query
+    Cyb_SplitGPUQuery(renderer, scope);
+}
+
+
+void Cyb_EndGPUScope(Cyb_Renderer *renderer)
+{
+    //Time the rest of the frame outside of scopes
+    if(renderer->gpuTimer.enabled)
+    {
+        Cyb_SplitGPUQuery(renderer, -1);
+    }
+}
+
+
 void Cyb_RenderPresent(Cyb_Renderer *renderer)
 {
+    //End the timer queries of the frame
+    if(renderer->gpuTimer.enabled)
+    {
+        Cyb_SelectRenderer(renderer);
+        Cyb_StopGPUQuery(renderer);
+    }
+    
     SDL_GL_SwapWindow(renderer->window);
+    
+    //Keep the counters of the frame and start the next one
+    Cyb_BeginGPUFrame(renderer);
+    Cyb_RenderStats *stats = &renderer->lastStats;
+    Cyb_GPUTimer *timer = &renderer->gpuTimer;
+    *stats = renderer->frameStats;
+    stats->gpuTime = timer->time;
+    stats->scopeCount = timer->scopeCount;
+    memcpy(stats->scopes, timer->scopes, 
+        sizeof(Cyb_GPUScopeTime) * timer->scopeCount);
+    memset(&renderer->frameStats, 0, sizeof(Cyb_RenderStats));
 }
\ No newline at end of file
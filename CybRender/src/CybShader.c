@@ -65,14 +65,13 @@ static void Cyb_FreeShaderCache(void)
 static void Cyb_FreeShader(Cyb_Shader *shader)
 {
     //Deselect the shader program
-    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(shader->renderer);
     Cyb_SelectRenderer(shader->renderer);
-    glExtAPI->UseProgram(0);
+    Cyb_UseProgram(shader->renderer, 0);
     
     //Delete the shader program
     if(shader->program)
     {
-        glExtAPI->DeleteProgram(shader->program);
+        Cyb_DeleteProgram(shader->renderer, shader->program);
     }
 }
 
@@ -330,6 +329,8 @@ Cyb_Shader *Cyb_LoadShaderRW(Cyb_Renderer *renderer, SDL_RWops *file,
     glExtAPI->BindAttribLocation(prog, CYB_ATTRIB_UV, "uv");
     glExtAPI->BindAttribLocation(prog, CYB_ATTRIB_GROUP, "group");
     glExtAPI->BindAttribLocation(prog, CYB_ATTRIB_WEIGHT, "weight");
+    glExtAPI->BindAttribLocation(prog, CYB_ATTRIB_INSTANCE_MAT_MODEL, "instanceM");
+    glExtAPI->BindAttribLocation(prog, CYB_ATTRIB_INSTANCE_MAT_NORM, "instanceN");
     glExtAPI->LinkProgram(prog);
     int isLinked;
     glExtAPI->GetProgramiv(prog, GL_LINK_STATUS, &isLinked);
@@ -410,7 +411,7 @@ Cyb_Shader *Cyb_LoadShaderRW(Cyb_Renderer *renderer, SDL_RWops *file,
 void Cyb_SelectShader(Cyb_Renderer *renderer, Cyb_Shader *shader)
 {
     Cyb_SelectRenderer(renderer);
-    Cyb_GetGLExtAPI(renderer)->UseProgram(shader->program);
+    Cyb_UseProgram(renderer, shader->program);
 }
 
 
@@ -56,7 +56,7 @@ static void Cyb_FreeTexture(Cyb_Texture *tex)
     //Free the texture
     if(tex->tex)
     {
-        glDeleteTextures(1, &tex->tex);
+        Cyb_DeleteTextures(tex->renderer, 1, &tex->tex);
     }
 }
 
@@ -238,7 +238,7 @@ void Cyb_UpdateTexture(Cyb_Renderer *renderer, Cyb_Texture *tex, int width,
     Cyb_SelectRenderer(renderer);
     
     //Update the texture image
-    glBindTexture(GL_TEXTURE_2D, tex->tex);
+    Cyb_BindTexture(renderer, CYB_ACTIVE_TEXTURE_UNIT, tex->tex);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     GLenum glFormat = 0;
     
@@ -277,6 +277,8 @@ void Cyb_UpdateTexture(Cyb_Renderer *renderer, Cyb_Texture *tex, int width,
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, glFormat, 
         GL_UNSIGNED_BYTE, pixels);
+    Cyb_AddUploadStats(renderer, (size_t)width * height * 
+        (glFormat == GL_RGB || glFormat == GL_BGR ? 3 : 4));
 }
 
 
@@ -316,7 +318,7 @@ void Cyb_SetTextureFilters(Cyb_Renderer *renderer, Cyb_Texture *tex,
         break;
     }
     
-    glBindTexture(GL_TEXTURE_2D, tex->tex);
+    Cyb_BindTexture(renderer, CYB_ACTIVE_TEXTURE_UNIT, tex->tex);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
 }
@@ -329,7 +331,5 @@ void Cyb_SelectTexture(Cyb_Renderer *renderer, Cyb_Texture *tex,
     Cyb_SelectRenderer(renderer);
     
     //Set the texture unit and bind the texture
-    Cyb_GLExtAPI *glExtAPI = Cyb_GetGLExtAPI(renderer);
-    glExtAPI->ActiveTexture(GL_TEXTURE0 + texUnit);
-    glBindTexture(GL_TEXTURE_2D, tex->tex);
+    Cyb_BindTexture(renderer, texUnit, tex->tex);
 }
\ No newline at end of file
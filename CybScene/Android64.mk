@@ -0,0 +1,21 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+LOCAL_MODULE := CybScene
+LOCAL_C_INCLUDES := \
+    include \
+    ../CybCommon \
+    ../deps/android/arm64-v8a/SDL2/include \
+    ../deps/android/arm64-v8a/SDL2/include/SDL2 \
+    ../CybObjects/include \
+    ../CybMath/include
+LOCAL_SRC_FILES := \
+    src/CybSceneGraph.c
+LOCAL_CFLAGS := -DCYB_MATH_INLINE
+LOCAL_LDFLAGS += \
+    -LC:/android-sdk/ndk/19.2.5345600/toolchains/llvm/prebuilt/windows/lib/gcc/aarch64-linux-android/4.9.x \
+    -LC:/android-sdk/ndk/19.2.5345600/toolchains/llvm/prebuilt/windows/aarch64-linux-android/lib64 \
+    -L../deps/android/arm64-v8a/SDL2/bin \
+    -L../CybObjects/libs/arm64-v8a \
+    -L../CybMath/libs/arm64-v8a
+LOCAL_LDLIBS += -lSDL2 -lCybObjects -lCybMath
+include $(BUILD_SHARED_LIBRARY)
\ No newline at end of file
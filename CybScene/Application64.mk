@@ -0,0 +1,4 @@
+APP_ABI := arm64-v8a
+APP_PLATFORM := android-28
+APP_STL := c++_static
+APP_BUILD_SCRIPT := Android64.mk
\ No newline at end of file
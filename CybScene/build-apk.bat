@@ -0,0 +1,14 @@
+@echo off
+
+rem Build CybObjects
+cd ../CybObjects
+call build-apk
+
+rem Build CybMath
+cd ../CybMath
+call build-apk
+
+rem Build CybScene
+cd ../CybScene
+set NDK_PROJECT_PATH=.
+ndk-build NDK_APPLICATION_MK=./Application.mk
\ No newline at end of file
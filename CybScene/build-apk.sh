@@ -0,0 +1,14 @@
+#!/usr/bin/bash
+
+#Build CybObjects
+cd ../CybObjects
+source ./build-apk.sh
+
+#Build CybMath
+cd ../CybMath
+source ./build-apk.sh
+
+#Build CybScene
+cd ../CybScene
+export NDK_PROJECT_PATH=.
+ndk-build NDK_APPLICATION_MK=./Application.mk
@@ -0,0 +1,10 @@
+#ifndef CYBSCENE_H
+#define CYBSCENE_H
+
+/** @file
+ * @brief CybScene - Main API
+ */
+
+#include "CybSceneGraph.h"
+
+#endif
\ No newline at end of file
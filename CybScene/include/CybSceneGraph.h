@@ -0,0 +1,174 @@
+#ifndef CYBSCENEGRAPH_H
+#define CYBSCENEGRAPH_H
+
+/** @file
+ * @brief CybScene - Scene Graph API
+ */
+
+#include "CybCommon.h"
+#include "CybMath.h"
+#include "CybObjects.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup CybScene
+ * @brief Cybermals Engine - Scene Library
+ * @{
+ */
+
+//Types
+//=================================================================================
+/** @brief Scene graph object.
+ */
+typedef struct Cyb_SceneGraph Cyb_SceneGraph;
+
+
+//Functions
+//=================================================================================
+/** @brief Create a new scene graph.
+ *
+ * The nodes of a scene graph form a transform hierarchy. They are stored as
+ * structure of arrays with every parent in front of its children, so each
+ * subtree is a contiguous range which is updated in one pass.
+ *
+ * @param jobs Pointer to a job system which is used to update independent
+ * subtrees in parallel. Can be NULL.
+ *
+ * @return Pointer to the scene graph or NULL.
+ */
+CYBAPI Cyb_SceneGraph *Cyb_CreateSceneGraph(Cyb_JobSystem *jobs);
+
+/** @brief Add a node to a scene graph.
+ *
+ * The IDs of nodes stay the same when other nodes are added, removed, or
+ * moved. The IDs of removed nodes are reused.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param parent The ID of the parent node or -1 for a root node.
+ * @param local Pointer to the local transform or NULL for the identity.
+ *
+ * @return The ID of the new node or -1 on failure.
+ */
+CYBAPI int Cyb_AddSceneNode(Cyb_SceneGraph *graph, int parent,
+    const Cyb_Mat4 *local);
+
+/** @brief Remove a node and all of its descendants from a scene graph.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param id The node ID.
+ */
+CYBAPI void Cyb_RemoveSceneNode(Cyb_SceneGraph *graph, int id);
+
+/** @brief Get the number of nodes in a scene graph.
+ *
+ * @param graph Pointer to the scene graph.
+ *
+ * @return The number of nodes.
+ */
+CYBAPI int Cyb_GetSceneNodeCount(Cyb_SceneGraph *graph);
+
+/** @brief Move a node and its descendants to a new parent.
+ *
+ * The local transform is kept, so the node moves with its new parent.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param id The node ID.
+ * @param parent The ID of the new parent node or -1 to make it a root node.
+ *
+ * @return CYB_NO_ERROR on success or CYB_ERROR if the new parent is the node
+ * itself or one of its descendants.
+ */
+CYBAPI int Cyb_SetSceneNodeParent(Cyb_SceneGraph *graph, int id, int parent);
+
+/** @brief Get the parent of a node.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param id The node ID.
+ *
+ * @return The ID of the parent node or -1 for a root node.
+ */
+CYBAPI int Cyb_GetSceneNodeParent(Cyb_SceneGraph *graph, int id);
+
+/** @brief Set the local transform of a node.
+ *
+ * The world transforms of the node and its descendants are recalculated by
+ * the next call to Cyb_UpdateSceneGraph.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param id The node ID.
+ * @param local Pointer to the new local transform.
+ */
+CYBAPI void Cyb_SetSceneNodeTransform(Cyb_SceneGraph *graph, int id,
+    const Cyb_Mat4 *local);
+
+/** @brief Set the local transform of a node from a position, rotation, and
+ * scale.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param id The node ID.
+ * @param pos Pointer to the position.
+ * @param rot Pointer to the rotation (quaternion).
+ * @param scale Pointer to the scale or NULL for no scaling.
+ */
+CYBAPI void Cyb_SetSceneNodeTRS(Cyb_SceneGraph *graph, int id,
+    const Cyb_Vec3 *pos, const Cyb_Vec4 *rot, const Cyb_Vec3 *scale);
+
+/** @brief Get the local transform of a node.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param id The node ID.
+ *
+ * @return Pointer to the local transform.
+ */
+CYBAPI const Cyb_Mat4 *Cyb_GetSceneNodeTransform(Cyb_SceneGraph *graph,
+    int id);
+
+/** @brief Get the world transform of a node.
+ *
+ * The world transform is the one calculated by the last call to
+ * Cyb_UpdateSceneGraph.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param id The node ID.
+ *
+ * @return Pointer to the world transform.
+ */
+CYBAPI const Cyb_Mat4 *Cyb_GetSceneNodeWorld(Cyb_SceneGraph *graph, int id);
+
+/** @brief Get the normal matrix of a node.
+ *
+ * The normal matrix is the inverse transpose of the world transform and is
+ * calculated together with it.
+ *
+ * @param graph Pointer to the scene graph.
+ * @param id The node ID.
+ *
+ * @return Pointer to the normal matrix.
+ */
+CYBAPI const Cyb_Mat4 *Cyb_GetSceneNodeNormal(Cyb_SceneGraph *graph, int id);
+
+/** @brief Recalculate the world transforms which are out of date.
+ *
+ * Only nodes whose local transform or parent changed since the last update
+ * are recalculated, together with their descendants. Root nodes whose
+ * subtrees did not change are skipped without visiting their descendants and
+ * each changed subtree is updated as a separate job.
+ *
+ * @param graph Pointer to the scene graph.
+ *
+ * @return The number of nodes which were recalculated.
+ */
+CYBAPI int Cyb_UpdateSceneGraph(Cyb_SceneGraph *graph);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,545 @@
+/*
+CybScene - Scene Graph API
+*/
+
+#include <string.h>
+
+#include "CybSceneGraph.h"
+
+
+//Macros
+//=================================================================================
+#define CYB_NODE_DIRTY 1         //the local transform changed
+#define CYB_NODE_SUBTREE_DIRTY 2 //set on roots with a dirty node below them
+#define CYB_NODE_UPDATED 4       //recalculated by the current update
+
+
+//Structures
+//=================================================================================
+typedef struct
+{
+    int start;
+    int updated;
+} Cyb_SubtreeJob;
+
+struct Cyb_SceneGraph
+{
+    Cyb_Object base;
+    Cyb_JobSystem *jobs;
+    
+    //Nodes in parent before child order (structure of arrays)
+    int nodeCount;
+    int nodeCapacity;
+    int *parents;       //index of the parent or -1
+    int *sizes;         //number of nodes in the subtree including the node
+    int *ids;           //ID of the node at each index
+    unsigned char *flags;
+    Cyb_Mat4 *locals;
+    Cyb_Mat4 *worlds;
+    Cyb_Mat4 *normals;
+    
+    //Node IDs (each ID maps to an index which changes as nodes move)
+    int idCount;
+    int idCapacity;
+    int *indices;
+    int freeIdCount;
+    int *freeIds;
+    
+    //Scratch space for moving subtrees and running jobs
+    int scratchCapacity;
+    int *scratchParents;
+    int *scratchSizes;
+    int *scratchIds;
+    unsigned char *scratchFlags;
+    Cyb_Mat4 *scratchLocals;
+    Cyb_Mat4 *scratchWorlds;
+    Cyb_Mat4 *scratchNormals;
+    Cyb_SubtreeJob *subtreeJobs;
+};
+
+
+//Functions
+//=================================================================================
+static int Cyb_GrowArrays(void ***arrays, const size_t *sizes, int arrayCount,
+    int *capacity, int count)
+{
+    if(count <= *capacity)
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    //Grow every array to the same capacity
+    int newCapacity = max(count, *capacity * 2);
+    
+    for(int i = 0; i < arrayCount; i++)
+    {
+        void *buf = SDL_realloc(*arrays[i], newCapacity * sizes[i]);
+        
+        if(!buf)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+                "[CybScene] Out of Memory");
+            return CYB_ERROR;
+        }
+        
+        *arrays[i] = buf;
+    }
+    
+    *capacity = newCapacity;
+    return CYB_NO_ERROR;
+}
+
+
+static int Cyb_ReserveNodes(Cyb_SceneGraph *graph, int count)
+{
+    void **arrays[] = {
+        (void**)&graph->parents, (void**)&graph->sizes,
+        (void**)&graph->ids, (void**)&graph->flags,
+        (void**)&graph->locals, (void**)&graph->worlds,
+        (void**)&graph->normals
+    };
+    size_t sizes[] = {
+        sizeof(int), sizeof(int), sizeof(int), sizeof(unsigned char),
+        sizeof(Cyb_Mat4), sizeof(Cyb_Mat4), sizeof(Cyb_Mat4)
+    };
+    return Cyb_GrowArrays(arrays, sizes, sizeof(sizes) / sizeof(sizes[0]),
+        &graph->nodeCapacity, count);
+}
+
+
+static int Cyb_ReserveScratch(Cyb_SceneGraph *graph, int count)
+{
+    void **arrays[] = {
+        (void**)&graph->scratchParents, (void**)&graph->scratchSizes,
+        (void**)&graph->scratchIds, (void**)&graph->scratchFlags,
+        (void**)&graph->scratchLocals, (void**)&graph->scratchWorlds,
+        (void**)&graph->scratchNormals, (void**)&graph->subtreeJobs
+    };
+    size_t sizes[] = {
+        sizeof(int), sizeof(int), sizeof(int), sizeof(unsigned char),
+        sizeof(Cyb_Mat4), sizeof(Cyb_Mat4), sizeof(Cyb_Mat4),
+        sizeof(Cyb_SubtreeJob)
+    };
+    return Cyb_GrowArrays(arrays, sizes, sizeof(sizes) / sizeof(sizes[0]),
+        &graph->scratchCapacity, count);
+}
+
+
+static int Cyb_AllocNodeID(Cyb_SceneGraph *graph)
+{
+    //Reuse the ID of a removed node if possible
+    if(graph->freeIdCount)
+    {
+        return graph->freeIds[--graph->freeIdCount];
+    }
+    
+    void **arrays[] = {(void**)&graph->indices, (void**)&graph->freeIds};
+    size_t sizes[] = {sizeof(int), sizeof(int)};
+    
+    if(Cyb_GrowArrays(arrays, sizes, 2, &graph->idCapacity,
+        graph->idCount + 1))
+    {
+        return -1;
+    }
+    
+    return graph->idCount++;
+}
+
+
+static void Cyb_CopyNodes(int *dstParents, int *dstSizes, int *dstIds,
+    unsigned char *dstFlags, Cyb_Mat4 *dstLocals, Cyb_Mat4 *dstWorlds,
+    Cyb_Mat4 *dstNormals, const int *srcParents, const int *srcSizes,
+    const int *srcIds, const unsigned char *srcFlags,
+    const Cyb_Mat4 *srcLocals, const Cyb_Mat4 *srcWorlds,
+    const Cyb_Mat4 *srcNormals, int count)
+{
+    //The ranges may overlap when nodes are shifted
+    memmove(dstParents, srcParents, sizeof(int) * count);
+    memmove(dstSizes, srcSizes, sizeof(int) * count);
+    memmove(dstIds, srcIds, sizeof(int) * count);
+    memmove(dstFlags, srcFlags, sizeof(unsigned char) * count);
+    memmove(dstLocals, srcLocals, sizeof(Cyb_Mat4) * count);
+    memmove(dstWorlds, srcWorlds, sizeof(Cyb_Mat4) * count);
+    memmove(dstNormals, srcNormals, sizeof(Cyb_Mat4) * count);
+}
+
+
+static void Cyb_ShiftNodes(Cyb_SceneGraph *graph, int first, int offset)
+{
+    //Move the nodes from the first index to the end of the arrays
+    int count = graph->nodeCount - first;
+    int dst = first + offset;
+    Cyb_CopyNodes(&graph->parents[dst], &graph->sizes[dst], &graph->ids[dst],
+        &graph->flags[dst], &graph->locals[dst], &graph->worlds[dst],
+        &graph->normals[dst], &graph->parents[first], &graph->sizes[first],
+        &graph->ids[first], &graph->flags[first], &graph->locals[first],
+        &graph->worlds[first], &graph->normals[first], count);
+    
+    //Parents always come first, so only parents which moved too change
+    for(int i = dst; i < dst + count; i++)
+    {
+        if(graph->parents[i] >= first)
+        {
+            graph->parents[i] += offset;
+        }
+        
+        graph->indices[graph->ids[i]] = i;
+    }
+    
+    graph->nodeCount += offset;
+}
+
+
+static void Cyb_ResizeAncestors(Cyb_SceneGraph *graph, int parent, int count)
+{
+    for(int i = parent; i >= 0; i = graph->parents[i])
+    {
+        graph->sizes[i] += count;
+    }
+}
+
+
+static void Cyb_MarkDirty(Cyb_SceneGraph *graph, int index)
+{
+    //Flag the node and the root of its subtree
+    graph->flags[index] |= CYB_NODE_DIRTY;
+    
+    while(graph->parents[index] >= 0)
+    {
+        index = graph->parents[index];
+    }
+    
+    graph->flags[index] |= CYB_NODE_SUBTREE_DIRTY;
+}
+
+
+static int Cyb_UpdateSubtree(Cyb_SceneGraph *graph, int start)
+{
+    //Walk the subtree in order so parents are always up to date first
+    int end = start + graph->sizes[start];
+    int updated = 0;
+    graph->flags[start] &= ~CYB_NODE_SUBTREE_DIRTY;
+    
+    for(int i = start; i < end; i++)
+    {
+        int parent = graph->parents[i];
+        unsigned char flags = graph->flags[i] & ~CYB_NODE_UPDATED;
+        
+        if(!(flags & CYB_NODE_DIRTY) && (i == start ||
+            !(graph->flags[parent] & CYB_NODE_UPDATED)))
+        {
+            graph->flags[i] = flags;
+            continue;
+        }
+        
+        if(parent >= 0)
+        {
+            Cyb_MulMat4(&graph->worlds[i], &graph->worlds[parent],
+                &graph->locals[i]);
+        }
+        else
+        {
+            graph->worlds[i] = graph->locals[i];
+        }
+        
+        Cyb_Mat4 transposed;
+        Cyb_Transpose(&transposed, &graph->worlds[i]);
+        Cyb_Invert(&graph->normals[i], &transposed);
+        graph->flags[i] = (flags & ~CYB_NODE_DIRTY) | CYB_NODE_UPDATED;
+        updated++;
+    }
+    
+    return updated;
+}
+
+
+static void Cyb_UpdateSubtreeJob(void *data, int index)
+{
+    Cyb_SceneGraph *graph = (Cyb_SceneGraph*)data;
+    Cyb_SubtreeJob *job = &graph->subtreeJobs[index];
+    job->updated = Cyb_UpdateSubtree(graph, job->start);
+}
+
+
+void Cyb_FreeSceneGraph(Cyb_SceneGraph *graph)
+{
+    //Free the node arrays
+    SDL_free(graph->parents);
+    SDL_free(graph->sizes);
+    SDL_free(graph->ids);
+    SDL_free(graph->flags);
+    SDL_free(graph->locals);
+    SDL_free(graph->worlds);
+    SDL_free(graph->normals);
+    SDL_free(graph->indices);
+    SDL_free(graph->freeIds);
+    
+    //Free the scratch space
+    SDL_free(graph->scratchParents);
+    SDL_free(graph->scratchSizes);
+    SDL_free(graph->scratchIds);
+    SDL_free(graph->scratchFlags);
+    SDL_free(graph->scratchLocals);
+    SDL_free(graph->scratchWorlds);
+    SDL_free(graph->scratchNormals);
+    SDL_free(graph->subtreeJobs);
+}
+
+
+Cyb_SceneGraph *Cyb_CreateSceneGraph(Cyb_JobSystem *jobs)
+{
+    //Allocate new scene graph
+    Cyb_SceneGraph *graph = (Cyb_SceneGraph*)Cyb_CreateObject(
+        sizeof(Cyb_SceneGraph), (Cyb_FreeProc)&Cyb_FreeSceneGraph,
+        CYB_SCENEGRAPH);
+    
+    if(!graph)
+    {
+        return NULL;
+    }
+    
+    //Initialize the scene graph
+    memset((char*)graph + sizeof(Cyb_Object), 0,
+        sizeof(Cyb_SceneGraph) - sizeof(Cyb_Object));
+    graph->jobs = jobs;
+    return graph;
+}
+
+
+int Cyb_AddSceneNode(Cyb_SceneGraph *graph, int parent, const Cyb_Mat4 *local)
+{
+    //Make room for the node
+    if(Cyb_ReserveNodes(graph, graph->nodeCount + 1))
+    {
+        return -1;
+    }
+    
+    int id = Cyb_AllocNodeID(graph);
+    
+    if(id < 0)
+    {
+        return -1;
+    }
+    
+    //Insert the node after the last descendant of its parent
+    int parentIndex = parent >= 0 ? graph->indices[parent] : -1;
+    int index = parentIndex >= 0 ? parentIndex + graph->sizes[parentIndex] :
+        graph->nodeCount;
+    Cyb_ShiftNodes(graph, index, 1);
+    Cyb_ResizeAncestors(graph, parentIndex, 1);
+    graph->parents[index] = parentIndex;
+    graph->sizes[index] = 1;
+    graph->ids[index] = id;
+    graph->flags[index] = 0;
+    graph->indices[id] = index;
+    
+    if(local)
+    {
+        graph->locals[index] = *local;
+    }
+    else
+    {
+        Cyb_Identity(&graph->locals[index]);
+    }
+    
+    Cyb_MarkDirty(graph, index);
+    return id;
+}
+
+
+void Cyb_RemoveSceneNode(Cyb_SceneGraph *graph, int id)
+{
+    //Free the IDs of the whole subtree
+    int index = graph->indices[id];
+    int count = graph->sizes[index];
+    
+    for(int i = index; i < index + count; i++)
+    {
+        graph->indices[graph->ids[i]] = -1;
+        graph->freeIds[graph->freeIdCount++] = graph->ids[i];
+    }
+    
+    //Close the gap
+    Cyb_ResizeAncestors(graph, graph->parents[index], -count);
+    Cyb_ShiftNodes(graph, index + count, -count);
+}
+
+
+int Cyb_GetSceneNodeCount(Cyb_SceneGraph *graph)
+{
+    return graph->nodeCount;
+}
+
+
+int Cyb_SetSceneNodeParent(Cyb_SceneGraph *graph, int id, int parent)
+{
+    //The new parent can't be part of the subtree
+    int index = graph->indices[id];
+    int count = graph->sizes[index];
+    int parentIndex = parent >= 0 ? graph->indices[parent] : -1;
+    
+    if(parentIndex >= index && parentIndex < index + count)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "[CybScene] A node can't become its own descendant.");
+        return CYB_ERROR;
+    }
+    
+    if(parentIndex == graph->parents[index])
+    {
+        return CYB_NO_ERROR;
+    }
+    
+    //Set the subtree aside with parents relative to its start
+    if(Cyb_ReserveScratch(graph, count))
+    {
+        return CYB_ERROR;
+    }
+    
+    Cyb_CopyNodes(graph->scratchParents, graph->scratchSizes,
+        graph->scratchIds, graph->scratchFlags, graph->scratchLocals,
+        graph->scratchWorlds, graph->scratchNormals, &graph->parents[index],
+        &graph->sizes[index], &graph->ids[index], &graph->flags[index],
+        &graph->locals[index], &graph->worlds[index], &graph->normals[index],
+        count);
+    
+    for(int i = 1; i < count; i++)
+    {
+        graph->scratchParents[i] -= index;
+    }
+    
+    //Remove it and insert it after the last descendant of the new parent
+    Cyb_ResizeAncestors(graph, graph->parents[index], -count);
+    Cyb_ShiftNodes(graph, index + count, -count);
+    
+    if(parentIndex > index)
+    {
+        parentIndex -= count;
+    }
+    
+    int newIndex = parentIndex >= 0 ? parentIndex + graph->sizes[parentIndex] :
+        graph->nodeCount;
+    Cyb_ShiftNodes(graph, newIndex, count);
+    Cyb_ResizeAncestors(graph, parentIndex, count);
+    Cyb_CopyNodes(&graph->parents[newIndex], &graph->sizes[newIndex],
+        &graph->ids[newIndex], &graph->flags[newIndex],
+        &graph->locals[newIndex], &graph->worlds[newIndex],
+        &graph->normals[newIndex], graph->scratchParents, graph->scratchSizes,
+        graph->scratchIds, graph->scratchFlags, graph->scratchLocals,
+        graph->scratchWorlds, graph->scratchNormals, count);
+    graph->parents[newIndex] = parentIndex;
+    
+    graph->flags[newIndex] &= ~CYB_NODE_SUBTREE_DIRTY;
+    graph->indices[id] = newIndex;
+    
+    for(int i = newIndex + 1; i < newIndex + count; i++)
+    {
+        graph->parents[i] += newIndex;
+        graph->indices[graph->ids[i]] = i;
+    }
+    
+    //The world transforms of the whole subtree change and pending updates
+    //now belong to the root of the new subtree
+    Cyb_MarkDirty(graph, newIndex);
+    return CYB_NO_ERROR;
+}
+
+
+int Cyb_GetSceneNodeParent(Cyb_SceneGraph *graph, int id)
+{
+    int parent = graph->parents[graph->indices[id]];
+    return parent >= 0 ? graph->ids[parent] : -1;
+}
+
+
+void Cyb_SetSceneNodeTransform(Cyb_SceneGraph *graph, int id,
+    const Cyb_Mat4 *local)
+{
+    int index = graph->indices[id];
+    graph->locals[index] = *local;
+    Cyb_MarkDirty(graph, index);
+}
+
+
+void Cyb_SetSceneNodeTRS(Cyb_SceneGraph *graph, int id, const Cyb_Vec3 *pos,
+    const Cyb_Vec4 *rot, const Cyb_Vec3 *scale)
+{
+    //Build translation * rotation * scale
+    int index = graph->indices[id];
+    Cyb_Mat4 *m = &graph->locals[index];
+    Cyb_QuatToMatrix(m, rot);
+    
+    if(scale)
+    {
+        m->a *= scale->x;
+        m->e *= scale->x;
+        m->i *= scale->x;
+        m->b *= scale->y;
+        m->f *= scale->y;
+        m->j *= scale->y;
+        m->c *= scale->z;
+        m->g *= scale->z;
+        m->k *= scale->z;
+    }
+    
+    m->d = pos->x;
+    m->h = pos->y;
+    m->l = pos->z;
+    Cyb_MarkDirty(graph, index);
+}
+
+
+const Cyb_Mat4 *Cyb_GetSceneNodeTransform(Cyb_SceneGraph *graph, int id)
+{
+    return &graph->locals[graph->indices[id]];
+}
+
+
+const Cyb_Mat4 *Cyb_GetSceneNodeWorld(Cyb_SceneGraph *graph, int id)
+{
+    return &graph->worlds[graph->indices[id]];
+}
+
+
+const Cyb_Mat4 *Cyb_GetSceneNodeNormal(Cyb_SceneGraph *graph, int id)
+{
+    return &graph->normals[graph->indices[id]];
+}
+
+
+int Cyb_UpdateSceneGraph(Cyb_SceneGraph *graph)
+{
+    //Count the root nodes with changes below them
+    int jobCount = 0;
+    
+    for(int i = 0; i < graph->nodeCount; i += graph->sizes[i])
+    {
+        jobCount += (graph->flags[i] & CYB_NODE_SUBTREE_DIRTY) != 0;
+    }
+    
+    if(!jobCount || Cyb_ReserveScratch(graph, jobCount))
+    {
+        return 0;
+    }
+    
+    //Update each changed subtree as a separate job
+    jobCount = 0;
+    
+    for(int i = 0; i < graph->nodeCount; i += graph->sizes[i])
+    {
+        if(graph->flags[i] & CYB_NODE_SUBTREE_DIRTY)
+        {
+            graph->subtreeJobs[jobCount++].start = i;
+        }
+    }
+    
+    Cyb_RunJobs(graph->jobs, &Cyb_UpdateSubtreeJob, graph, jobCount);
+    int updated = 0;
+    
+    for(int i = 0; i < jobCount; i++)
+    {
+        updated += graph->subtreeJobs[i].updated;
+    }
+    
+    return updated;
+}
\ No newline at end of file
@@ -0,0 +1,908 @@
+/*
+CybMath - Benchmark Program
+*/
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "CybMath.h"
+
+
+//Macros
+//===========================================================================
+#define BENCH_COUNT 1024       //number of items processed per pass
+#define BENCH_RUNS 5           //the best run is reported
+#define BENCH_MIN_TIME 20.0e6  //minimum length of a run in nanoseconds
+#define BENCH_IMAGE_SIZE 32    //noise images are BENCH_IMAGE_SIZE squared
+#define BENCH_IMAGE_STEP .05f  //distance between noise image samples
+
+
+//Structures
+//===========================================================================
+typedef struct
+{
+    double maxUlp;
+    int mismatches;
+} Bench_Error;
+
+typedef struct
+{
+    const char *name;
+    void (*run)(void);
+    void (*check)(Bench_Error *error);
+} Bench_Entry;
+
+
+//Globals
+//===========================================================================
+static unsigned int seed = 12345;
+
+static Cyb_Mat4 mats[BENCH_COUNT];
+static Cyb_Mat4 mats2[BENCH_COUNT];
+static Cyb_Mat4 matsOut[BENCH_COUNT];
+static Cyb_Vec3 vecs[BENCH_COUNT];
+static Cyb_Vec3 vecsOut[BENCH_COUNT];
+static Cyb_Vec4 quats[BENCH_COUNT];
+static Cyb_Vec4 quats2[BENCH_COUNT];
+static Cyb_Vec4 quatsOut[BENCH_COUNT];
+static float progress[BENCH_COUNT];
+static float floats[BENCH_COUNT];
+static float floatsOut[BENCH_COUNT];
+static float floatsOut2[BENCH_COUNT];
+static Cyb_Box boxes[BENCH_COUNT];
+static Cyb_Sphere spheres[BENCH_COUNT];
+static Cyb_Frustum frustum;
+static unsigned char visible[BENCH_COUNT];
+static int hits[BENCH_COUNT];
+static Cyb_NoiseParams noiseParams;
+static Cyb_Random rng;
+
+
+//Helpers
+//===========================================================================
+static double Bench_Now(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart * 1.0e9 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1.0e9 + ts.tv_nsec;
+#endif
+}
+
+
+static float Bench_Random(float lo, float hi)
+{
+    //Small LCG so that every platform benchmarks the same data
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (float)(seed >> 8) / 16777216.0f;
+}
+
+
+static void Bench_MatToDouble(double out[4][4], const Cyb_Mat4 *m)
+{
+    const float rows[4][4] = {
+        {m->a, m->b, m->c, m->d},
+        {m->e, m->f, m->g, m->h},
+        {m->i, m->j, m->k, m->l},
+        {m->m, m->n, m->o, m->p}
+    };
+    
+    for(int r = 0; r < 4; r++)
+    {
+        for(int c = 0; c < 4; c++)
+        {
+            out[r][c] = rows[r][c];
+        }
+    }
+}
+
+
+static double Bench_Ulps(const float *result, const double *ref, int count)
+{
+    //Errors are measured in ULPs of the largest reference component, so that
+    //components which cancel out to 0 don't dominate the result
+    double mag = 0.0;
+    
+    for(int i = 0; i < count; i++)
+    {
+        mag = fmax(mag, fabs(ref[i]));
+    }
+    
+    float fmag = (float)mag;
+    double ulp = (double)nextafterf(fmag, FLT_MAX) - (double)fmag;
+    double maxUlp = 0.0;
+    
+    for(int i = 0; i < count; i++)
+    {
+        maxUlp = fmax(maxUlp, fabs(result[i] - ref[i]) / ulp);
+    }
+    
+    return maxUlp;
+}
+
+
+static double Bench_MatUlps(const Cyb_Mat4 *m, double ref[4][4])
+{
+    double r[4][4];
+    float f[16];
+    Bench_MatToDouble(r, m);
+    
+    for(int i = 0; i < 16; i++)
+    {
+        f[i] = (float)r[i / 4][i % 4];
+    }
+    
+    return Bench_Ulps(f, &ref[0][0], 16);
+}
+
+
+static void Bench_RefSlerp(double out[4], const Cyb_Vec4 *a, const Cyb_Vec4 *b,
+    double t, int normalized)
+{
+    const double qa[4] = {a->x, a->y, a->z, a->w};
+    double qb[4] = {b->x, b->y, b->z, b->w};
+    double d = qa[0] * qb[0] + qa[1] * qb[1] + qa[2] * qb[2] + qa[3] * qb[3];
+    
+    //Follow shortest path
+    if(d < 0.0)
+    {
+        d = -d;
+        
+        for(int i = 0; i < 4; i++)
+        {
+            qb[i] = -qb[i];
+        }
+    }
+    
+    double theta = acos(fmin(d, 1.0));
+    double wa = 1.0 - t;
+    double wb = t;
+    
+    if(!normalized && sin(theta) > 1.0e-9)
+    {
+        wa = sin((1.0 - t) * theta) / sin(theta);
+        wb = sin(t * theta) / sin(theta);
+    }
+    
+    double len = 0.0;
+    
+    for(int i = 0; i < 4; i++)
+    {
+        out[i] = wa * qa[i] + wb * qb[i];
+        len += out[i] * out[i];
+    }
+    
+    for(int i = 0; i < 4; i++)
+    {
+        out[i] /= sqrt(len);
+    }
+}
+
+
+static void Bench_Setup(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        //Random transformation matrices
+        Cyb_Mat4 t;
+        Cyb_Mat4 r;
+        Cyb_Mat4 s;
+        Cyb_Mat4 tmp;
+        Cyb_Translate(&t, Bench_Random(-100, 100), Bench_Random(-100, 100),
+            Bench_Random(-100, 100));
+        Cyb_Rotate(&r, Bench_Random(-180, 180), Bench_Random(-180, 180),
+            Bench_Random(-180, 180), CYB_ROT_XYZ);
+        Cyb_Scale(&s, Bench_Random(.5f, 2), Bench_Random(.5f, 2),
+            Bench_Random(.5f, 2));
+        Cyb_MulMat4(&tmp, &t, &r);
+        Cyb_MulMat4(&mats[i], &tmp, &s);
+        Cyb_Rotate(&mats2[i], Bench_Random(-180, 180), Bench_Random(-180, 180),
+            Bench_Random(-180, 180), CYB_ROT_ZYX);
+        
+        //Random vectors, quaternions, and progressions
+        vecs[i].x = Bench_Random(-10, 10);
+        vecs[i].y = Bench_Random(-10, 10);
+        vecs[i].z = Bench_Random(-10, 10);
+        Cyb_QuatFromAxisAndAngle(&quats[i], .6f, .8f, 0,
+            Bench_Random(-180, 180));
+        Cyb_QuatFromAxisAndAngle(&quats2[i], 0, .8f, -.6f,
+            Bench_Random(-180, 180));
+        progress[i] = Bench_Random(0, 1);
+        floats[i] = Bench_Random(-10, 10);
+        
+        //Random boxes and spheres
+        boxes[i].center.x = Bench_Random(-50, 50);
+        boxes[i].center.y = Bench_Random(-50, 50);
+        boxes[i].center.z = Bench_Random(-50, 50);
+        boxes[i].size.x = Bench_Random(1, 20);
+        boxes[i].size.y = Bench_Random(1, 20);
+        boxes[i].size.z = Bench_Random(1, 20);
+        spheres[i].center = boxes[i].center;
+        spheres[i].radius = Bench_Random(1, 10);
+    }
+    
+    //A camera looking down the -Z axis
+    Cyb_Mat4 proj;
+    Cyb_Mat4 view;
+    Cyb_Mat4 viewProj;
+    Cyb_Perspective(&proj, 60, 1.5f, .1f, 100);
+    Cyb_Translate(&view, 0, 0, -20);
+    Cyb_MulMat4(&viewProj, &proj, &view);
+    Cyb_FrustumFromMatrix(&frustum, &viewProj);
+    
+    //Single octave noise so that the timings are per noise sample
+    Cyb_InitNoiseParams(&noiseParams);
+    noiseParams.seed = 1;
+    Cyb_SeedRandom(&rng, 1);
+}
+
+
+//Matrix Benchmarks
+//===========================================================================
+static void Bench_MulMat4(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_MulMat4(&matsOut[i], &mats[i], &mats2[i]);
+    }
+}
+
+
+static void Bench_InlineMulMat4(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_InlineMulMat4(&matsOut[i], &mats[i], &mats2[i]);
+    }
+}
+
+
+static void Check_MulMat4(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        double a[4][4];
+        double b[4][4];
+        double c[4][4];
+        Bench_MatToDouble(a, &mats[i]);
+        Bench_MatToDouble(b, &mats2[i]);
+        
+        for(int r = 0; r < 4; r++)
+        {
+            for(int col = 0; col < 4; col++)
+            {
+                c[r][col] = 0.0;
+                
+                for(int k = 0; k < 4; k++)
+                {
+                    c[r][col] += a[r][k] * b[k][col];
+                }
+            }
+        }
+        
+        error->maxUlp = fmax(error->maxUlp, Bench_MatUlps(&matsOut[i], c));
+    }
+}
+
+
+static void Bench_Invert(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_Invert(&matsOut[i], &mats[i]);
+    }
+}
+
+
+static void Bench_InlineInvert(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_InlineInvert(&matsOut[i], &mats[i]);
+    }
+}
+
+
+static void Check_Invert(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        //Gauss-Jordan elimination with partial pivoting
+        double a[4][4];
+        double inv[4][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0},
+            {0, 0, 0, 1}};
+        Bench_MatToDouble(a, &mats[i]);
+        
+        for(int c = 0; c < 4; c++)
+        {
+            int pivot = c;
+            
+            for(int r = c + 1; r < 4; r++)
+            {
+                if(fabs(a[r][c]) > fabs(a[pivot][c]))
+                {
+                    pivot = r;
+                }
+            }
+            
+            for(int k = 0; k < 4; k++)
+            {
+                double tmp = a[c][k];
+                a[c][k] = a[pivot][k];
+                a[pivot][k] = tmp;
+                tmp = inv[c][k];
+                inv[c][k] = inv[pivot][k];
+                inv[pivot][k] = tmp;
+            }
+            
+            double scale = 1.0 / a[c][c];
+            
+            for(int k = 0; k < 4; k++)
+            {
+                a[c][k] *= scale;
+                inv[c][k] *= scale;
+            }
+            
+            for(int r = 0; r < 4; r++)
+            {
+                double f = a[r][c];
+                
+                if(r == c)
+                {
+                    continue;
+                }
+                
+                for(int k = 0; k < 4; k++)
+                {
+                    a[r][k] -= f * a[c][k];
+                    inv[r][k] -= f * inv[c][k];
+                }
+            }
+        }
+        
+        error->maxUlp = fmax(error->maxUlp, Bench_MatUlps(&matsOut[i], inv));
+    }
+}
+
+
+static void Bench_Transform(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_Transform(&vecsOut[i], &mats[i], &vecs[i]);
+    }
+}
+
+
+static void Bench_InlineTransform(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_InlineTransform(&vecsOut[i], &mats[i], &vecs[i]);
+    }
+}
+
+
+static void Check_Transform(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        double m[4][4];
+        double ref[3];
+        Bench_MatToDouble(m, &mats[i]);
+        
+        for(int r = 0; r < 3; r++)
+        {
+            ref[r] = m[r][0] * vecs[i].x + m[r][1] * vecs[i].y +
+                m[r][2] * vecs[i].z + m[r][3];
+        }
+        
+        error->maxUlp = fmax(error->maxUlp,
+            Bench_Ulps(&vecsOut[i].x, ref, 3));
+    }
+}
+
+
+//Quaternion Benchmarks
+//===========================================================================
+static void Bench_QuatToMatrix(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_QuatToMatrix(&matsOut[i], &quats[i]);
+    }
+}
+
+
+static void Check_QuatToMatrix(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        double x = quats[i].x;
+        double y = quats[i].y;
+        double z = quats[i].z;
+        double w = quats[i].w;
+        double ref[4][4] = {
+            {1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y),
+                0},
+            {2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x),
+                0},
+            {2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y),
+                0},
+            {0, 0, 0, 1}
+        };
+        error->maxUlp = fmax(error->maxUlp, Bench_MatUlps(&matsOut[i], ref));
+    }
+}
+
+
+static void Bench_Slerp(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_Slerp(&quatsOut[i], &quats[i], &quats2[i], progress[i]);
+    }
+}
+
+
+static void Bench_FastSlerp(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_FastSlerp(&quatsOut[i], &quats[i], &quats2[i], progress[i]);
+    }
+}
+
+
+static void Bench_FastSlerpArray(void)
+{
+    Cyb_FastSlerpArray(quatsOut, quats, quats2, progress, BENCH_COUNT);
+}
+
+
+static void Check_Slerp(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        double ref[4];
+        Bench_RefSlerp(ref, &quats[i], &quats2[i], progress[i], FALSE);
+        error->maxUlp = fmax(error->maxUlp,
+            Bench_Ulps(&quatsOut[i].x, ref, 4));
+    }
+}
+
+
+static void Bench_Nlerp(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        Cyb_Nlerp(&quatsOut[i], &quats[i], &quats2[i], progress[i]);
+    }
+}
+
+
+static void Bench_NlerpArray(void)
+{
+    Cyb_NlerpArray(quatsOut, quats, quats2, progress, BENCH_COUNT);
+}
+
+
+static void Check_Nlerp(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        double ref[4];
+        Bench_RefSlerp(ref, &quats[i], &quats2[i], progress[i], TRUE);
+        error->maxUlp = fmax(error->maxUlp,
+            Bench_Ulps(&quatsOut[i].x, ref, 4));
+    }
+}
+
+
+//Fast Math Benchmarks
+//===========================================================================
+static void Bench_FastSinCosArray(void)
+{
+    Cyb_FastSinCosArray(floats, floatsOut, floatsOut2, BENCH_COUNT);
+}
+
+
+static void Check_FastSinCosArray(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        double s = sin(floats[i]);
+        double c = cos(floats[i]);
+        error->maxUlp = fmax(error->maxUlp, Bench_Ulps(&floatsOut[i], &s, 1));
+        error->maxUlp = fmax(error->maxUlp, Bench_Ulps(&floatsOut2[i], &c, 1));
+    }
+}
+
+
+static void Bench_FastRsqrtArray(void)
+{
+    Cyb_FastRsqrtArray(progress, floatsOut, BENCH_COUNT);
+}
+
+
+static void Check_FastRsqrtArray(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        double ref = 1.0 / sqrt(progress[i]);
+        error->maxUlp = fmax(error->maxUlp,
+            Bench_Ulps(&floatsOut[i], &ref, 1));
+    }
+}
+
+
+//Noise Benchmarks
+//===========================================================================
+static void Bench_SimplexNoise3(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        floatsOut[i] = Cyb_SimplexNoise3(vecs[i].x, vecs[i].y, vecs[i].z, 1);
+    }
+}
+
+
+static void Bench_FBMArray3(void)
+{
+    Cyb_FBMArray3(&noiseParams, vecs, floatsOut, BENCH_COUNT);
+}
+
+
+static void Check_Noise3(Bench_Error *error)
+{
+    //All widths must give the same results
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        float ref = Cyb_SimplexNoise3(vecs[i].x, vecs[i].y, vecs[i].z, 1);
+        error->mismatches += floatsOut[i] != ref || fabsf(ref) > 1.0f;
+    }
+}
+
+
+static void Bench_FillFBM2(void)
+{
+    Cyb_FillFBM2(&noiseParams, floatsOut, BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE,
+        0, 0, BENCH_IMAGE_STEP);
+}
+
+
+static void Check_FillFBM2(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_IMAGE_SIZE * BENCH_IMAGE_SIZE; i++)
+    {
+        float x = (i % BENCH_IMAGE_SIZE) * BENCH_IMAGE_STEP;
+        float y = (i / BENCH_IMAGE_SIZE) * BENCH_IMAGE_STEP;
+        error->mismatches += floatsOut[i] != Cyb_FBM2(&noiseParams, x, y);
+    }
+}
+
+
+static void Bench_RandomFloat(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        floatsOut[i] = Cyb_RandomFloat(&rng);
+    }
+}
+
+
+static void Bench_FillRandom(void)
+{
+    Cyb_FillRandom(&rng, floatsOut, BENCH_COUNT, 0, 1);
+}
+
+
+static void Check_Random(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        error->mismatches += floatsOut[i] < 0.0f || floatsOut[i] >= 1.0f;
+    }
+}
+
+
+//Bounding Volume Benchmarks
+//===========================================================================
+static void Bench_BoxHitBox(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        hits[i] = Cyb_BoxHitBox(&boxes[i], &boxes[(i + 1) % BENCH_COUNT]);
+    }
+}
+
+
+static void Check_BoxHitBox(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        const Cyb_Box *a = &boxes[i];
+        const Cyb_Box *b = &boxes[(i + 1) % BENCH_COUNT];
+        int ref = (fabs((double)b->center.x - a->center.x) <
+            ((double)a->size.x + b->size.x) / 2.0 &&
+            fabs((double)b->center.y - a->center.y) <
+            ((double)a->size.y + b->size.y) / 2.0 &&
+            fabs((double)b->center.z - a->center.z) <
+            ((double)a->size.z + b->size.z) / 2.0);
+        error->mismatches += (!hits[i] != !ref);
+    }
+}
+
+
+static void Bench_SphereHitSphere(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        hits[i] = Cyb_SphereHitSphere(&spheres[i],
+            &spheres[(i + 1) % BENCH_COUNT]);
+    }
+}
+
+
+static void Check_SphereHitSphere(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        const Cyb_Sphere *a = &spheres[i];
+        const Cyb_Sphere *b = &spheres[(i + 1) % BENCH_COUNT];
+        double dx = (double)b->center.x - a->center.x;
+        double dy = (double)b->center.y - a->center.y;
+        double dz = (double)b->center.z - a->center.z;
+        int ref = (sqrt(dx * dx + dy * dy + dz * dz) <
+            (double)a->radius + b->radius);
+        error->mismatches += (!hits[i] != !ref);
+    }
+}
+
+
+static double Bench_PlaneDist(const Cyb_Vec4 *plane, const Cyb_Vec3 *p)
+{
+    return (double)plane->x * p->x + (double)plane->y * p->y +
+        (double)plane->z * p->z + plane->w;
+}
+
+
+static void Bench_BoxInFrustum(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        visible[i] = (unsigned char)Cyb_BoxInFrustum(&boxes[i], &frustum);
+    }
+}
+
+
+static void Bench_CullBoxes(void)
+{
+    Cyb_CullBoxes(&frustum, boxes, BENCH_COUNT, visible);
+}
+
+
+static int Bench_RefBoxVisible(const Cyb_Box *box)
+{
+    for(int j = 0; j < 6; j++)
+    {
+        const Cyb_Vec4 *plane = &frustum.planes[j];
+        double r = (fabs(plane->x) * box->size.x +
+            fabs(plane->y) * box->size.y + fabs(plane->z) * box->size.z) * .5;
+        
+        if(Bench_PlaneDist(plane, &box->center) + r < 0.0)
+        {
+            return FALSE;
+        }
+    }
+    
+    return TRUE;
+}
+
+
+static void Check_BoxInFrustum(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        error->mismatches += (!visible[i] != !Bench_RefBoxVisible(&boxes[i]));
+    }
+}
+
+
+static void Check_CullBoxes(Bench_Error *error)
+{
+    //The batch version packs 8 results per byte
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        int bit = (visible[i / 8] >> (i % 8)) & 1;
+        error->mismatches += (!bit != !Bench_RefBoxVisible(&boxes[i]));
+    }
+}
+
+
+static void Bench_SphereInFrustum(void)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        visible[i] = (unsigned char)Cyb_SphereInFrustum(&spheres[i],
+            &frustum);
+    }
+}
+
+
+static void Bench_CullSpheres(void)
+{
+    Cyb_CullSpheres(&frustum, spheres, BENCH_COUNT, visible);
+}
+
+
+static int Bench_RefSphereVisible(const Cyb_Sphere *sphere)
+{
+    for(int j = 0; j < 6; j++)
+    {
+        if(Bench_PlaneDist(&frustum.planes[j], &sphere->center) +
+            sphere->radius < 0.0)
+        {
+            return FALSE;
+        }
+    }
+    
+    return TRUE;
+}
+
+
+static void Check_SphereInFrustum(Bench_Error *error)
+{
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        error->mismatches += (!visible[i] !=
+            !Bench_RefSphereVisible(&spheres[i]));
+    }
+}
+
+
+static void Check_CullSpheres(Bench_Error *error)
+{
+    //The batch version packs 8 results per byte
+    for(int i = 0; i < BENCH_COUNT; i++)
+    {
+        int bit = (visible[i / 8] >> (i % 8)) & 1;
+        error->mismatches += (!bit != !Bench_RefSphereVisible(&spheres[i]));
+    }
+}
+
+
+//Entry Point
+//===========================================================================
+static const Bench_Entry benchmarks[] = {
+    {"Cyb_MulMat4", &Bench_MulMat4, &Check_MulMat4},
+    {"Cyb_InlineMulMat4", &Bench_InlineMulMat4, &Check_MulMat4},
+    {"Cyb_Invert", &Bench_Invert, &Check_Invert},
+    {"Cyb_InlineInvert", &Bench_InlineInvert, &Check_Invert},
+    {"Cyb_Transform", &Bench_Transform, &Check_Transform},
+    {"Cyb_InlineTransform", &Bench_InlineTransform, &Check_Transform},
+    {"Cyb_QuatToMatrix", &Bench_QuatToMatrix, &Check_QuatToMatrix},
+    {"Cyb_Slerp", &Bench_Slerp, &Check_Slerp},
+    {"Cyb_FastSlerp", &Bench_FastSlerp, &Check_Slerp},
+    {"Cyb_FastSlerpArray", &Bench_FastSlerpArray, &Check_Slerp},
+    {"Cyb_Nlerp", &Bench_Nlerp, &Check_Nlerp},
+    {"Cyb_NlerpArray", &Bench_NlerpArray, &Check_Nlerp},
+    {"Cyb_FastSinCosArray", &Bench_FastSinCosArray, &Check_FastSinCosArray},
+    {"Cyb_FastRsqrtArray", &Bench_FastRsqrtArray, &Check_FastRsqrtArray},
+    {"Cyb_SimplexNoise3", &Bench_SimplexNoise3, &Check_Noise3},
+    {"Cyb_FBMArray3", &Bench_FBMArray3, &Check_Noise3},
+    {"Cyb_FillFBM2", &Bench_FillFBM2, &Check_FillFBM2},
+    {"Cyb_RandomFloat", &Bench_RandomFloat, &Check_Random},
+    {"Cyb_FillRandom", &Bench_FillRandom, &Check_Random},
+    {"Cyb_BoxHitBox", &Bench_BoxHitBox, &Check_BoxHitBox},
+    {"Cyb_SphereHitSphere", &Bench_SphereHitSphere, &Check_SphereHitSphere},
+    {"Cyb_BoxInFrustum", &Bench_BoxInFrustum, &Check_BoxInFrustum},
+    {"Cyb_CullBoxes", &Bench_CullBoxes, &Check_CullBoxes},
+    {"Cyb_SphereInFrustum", &Bench_SphereInFrustum,
+        &Check_SphereInFrustum},
+    {"Cyb_CullSpheres", &Bench_CullSpheres, &Check_CullSpheres}
+};
+
+
+int main(int argc, char **argv)
+{
+    //Write the JSON report to the given file or to stdout
+    FILE *out = stdout;
+    
+    if(argc > 1)
+    {
+        out = fopen(argv[1], "w");
+        
+        if(!out)
+        {
+            fprintf(stderr, "Failed to open '%s'.\n", argv[1]);
+            return 1;
+        }
+    }
+
+#if defined(CYB_SIMD_SSE2)
+    const char *simd = "sse2";
+#elif defined(CYB_SIMD_NEON)
+    const char *simd = "neon";
+#else
+    const char *simd = "scalar";
+#endif
+    
+    //Numbers from unoptimized builds are not meaningful, so flag them
+#if defined(__OPTIMIZE__) || (defined(_MSC_VER) && defined(NDEBUG))
+    const char *optimized = "true";
+#else
+    const char *optimized = "false";
+#endif
+    
+    fprintf(out, "{\n    \"simd\": \"%s\",\n    \"optimized\": %s,\n"
+        "    \"count\": %d,\n    \"results\": [\n", simd, optimized,
+        BENCH_COUNT);
+    Bench_Setup();
+    int benchCount = (int)(sizeof(benchmarks) / sizeof(Bench_Entry));
+    
+    for(int i = 0; i < benchCount; i++)
+    {
+        const Bench_Entry *bench = &benchmarks[i];
+        
+        //Time whole passes over the data and keep the best run
+        double best = DBL_MAX;
+        
+        for(int run = 0; run < BENCH_RUNS; run++)
+        {
+            long passes = 0;
+            double start = Bench_Now();
+            double elapsed;
+            
+            do
+            {
+                bench->run();
+                passes++;
+                elapsed = Bench_Now() - start;
+            }
+            while(elapsed < BENCH_MIN_TIME);
+            
+            best = fmin(best, elapsed / ((double)passes * BENCH_COUNT));
+        }
+        
+        //Compare the results of the last pass with the reference
+        Bench_Error error = {0.0, 0};
+        bench->check(&error);
+        
+        if(out != stdout)
+        {
+            printf("%-24s %8.2f ns/op %10.2f Mops/s %10.1f ulp "
+                "%4d mismatches\n", bench->name, best, 1.0e3 / best, error.maxUlp,
+                error.mismatches);
+        }
+        
+        fprintf(out, "        {\"name\": \"%s\", \"nsPerOp\": %.3f, "
+            "\"opsPerSec\": %.0f, \"maxUlp\": %.1f, \"mismatches\": %d}%s\n",
+            bench->name, best, 1.0e9 / best, error.maxUlp, error.mismatches,
+            (i + 1 < benchCount ? "," : ""));
+    }
+    
+    fputs("    ]\n}\n", out);
+    
+    if(out != stdout)
+    {
+        fclose(out);
+    }
+    
+    return 0;
+}
\ No newline at end of file
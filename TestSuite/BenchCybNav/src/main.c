@@ -0,0 +1,301 @@
+/*
+CybNav - Benchmark Program
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CybNav.h>
+
+
+//Macros
+//===========================================================================
+#define BENCH_GRID 128        //cells along each side of the level
+#define BENCH_BLOCKED 25      //percentage of blocked cells
+#define BENCH_QUERIES 2000    //number of path queries per pass
+#define BENCH_MAX_POINTS 256  //size of the path buffers
+#define BENCH_RUNS 3          //the best run is reported
+#define BENCH_BUDGET 2.0f     //time budget per frame in milliseconds
+
+
+//Globals
+//===========================================================================
+static unsigned int seed = 12345;
+static unsigned char blocked[BENCH_GRID][BENCH_GRID];
+static Cyb_PathQuery queries[BENCH_QUERIES];
+static Cyb_Vec3 points[BENCH_QUERIES][BENCH_MAX_POINTS];
+
+
+//Helpers
+//===========================================================================
+static double Bench_Now(void)
+{
+    return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+
+static unsigned int Bench_Rand(void)
+{
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 16) & 0x7fff;
+}
+
+
+static Cyb_NavMesh *Bench_BuildLevel(void)
+{
+    //Block random cells but keep the borders open
+    for(int x = 0; x < BENCH_GRID; x++)
+    {
+        for(int z = 0; z < BENCH_GRID; z++)
+        {
+            blocked[x][z] = x && z && x < BENCH_GRID - 1 &&
+                z < BENCH_GRID - 1 && Bench_Rand() % 100 < BENCH_BLOCKED;
+        }
+    }
+    
+    //Give every open cell its own 4 vertices like a mesh with split normals
+    int cellCount = BENCH_GRID * BENCH_GRID;
+    Cyb_Vec3 *verts = (Cyb_Vec3*)malloc(sizeof(Cyb_Vec3) * cellCount * 4);
+    unsigned int *indices = (unsigned int*)malloc(sizeof(unsigned int) *
+        cellCount * 6);
+    
+    if(!verts || !indices)
+    {
+        free(verts);
+        free(indices);
+        return NULL;
+    }
+    
+    int vertCount = 0;
+    int indexCount = 0;
+    
+    for(int x = 0; x < BENCH_GRID; x++)
+    {
+        for(int z = 0; z < BENCH_GRID; z++)
+        {
+            if(blocked[x][z])
+            {
+                continue;
+            }
+            
+            unsigned int base = vertCount;
+            unsigned int quad[6] = {0, 1, 2, 0, 2, 3};
+            Cyb_Vec3 corners[4] = {
+                {(float)x, 0.0f, (float)z},
+                {(float)x, 0.0f, z + 1.0f},
+                {x + 1.0f, 0.0f, z + 1.0f},
+                {x + 1.0f, 0.0f, (float)z}
+            };
+            
+            for(int i = 0; i < 4; i++)
+            {
+                verts[vertCount++] = corners[i];
+            }
+            
+            for(int i = 0; i < 6; i++)
+            {
+                indices[indexCount++] = base + quad[i];
+            }
+        }
+    }
+    
+    Cyb_NavMesh *nav = Cyb_CreateNavMesh(vertCount, verts, indexCount,
+        indices, 0.8f);
+    free(verts);
+    free(indices);
+    return nav;
+}
+
+
+static void Bench_MakeQueries(void)
+{
+    //Pick random open cells for the end points
+    for(int i = 0; i < BENCH_QUERIES; i++)
+    {
+        Cyb_Vec3 ends[2];
+        
+        for(int j = 0; j < 2; j++)
+        {
+            int x;
+            int z;
+            
+            do
+            {
+                x = Bench_Rand() % BENCH_GRID;
+                z = Bench_Rand() % BENCH_GRID;
+            }
+            while(blocked[x][z]);
+            
+            ends[j].x = x + 0.5f;
+            ends[j].y = 0.0f;
+            ends[j].z = z + 0.5f;
+        }
+        
+        memset(&queries[i], 0, sizeof(Cyb_PathQuery));
+        queries[i].start = ends[0];
+        queries[i].end = ends[1];
+        queries[i].points = points[i];
+        queries[i].maxPoints = BENCH_MAX_POINTS;
+    }
+}
+
+
+static double Bench_RunQueue(Cyb_PathQueue *queue, float budget,
+    int *frames, double *maxFrame)
+{
+    //Returns the total time in milliseconds
+    for(int i = 0; i < BENCH_QUERIES; i++)
+    {
+        Cyb_SubmitPathQuery(queue, &queries[i]);
+    }
+    
+    double start = Bench_Now();
+    *frames = 0;
+    *maxFrame = 0.0;
+    
+    while(Cyb_GetPendingPathCount(queue))
+    {
+        double frameStart = Bench_Now();
+        Cyb_UpdatePathQueue(queue, budget);
+        double frameTime = Bench_Now() - frameStart;
+        *maxFrame = frameTime > *maxFrame ? frameTime : *maxFrame;
+        (*frames)++;
+    }
+    
+    return Bench_Now() - start;
+}
+
+
+//Entry Point
+//===========================================================================
+int main(int argc, char **argv)
+{
+    //Write the JSON report to the given file or to stdout
+    FILE *out = stdout;
+    
+    if(argc > 1)
+    {
+        out = fopen(argv[1], "w");
+        
+        if(!out)
+        {
+            fprintf(stderr, "Failed to open '%s'.\n", argv[1]);
+            return 1;
+        }
+    }
+    
+    //Init CybObjects
+    if(Cyb_InitObjects())
+    {
+        fputs("Failed to initialize CybObjects.\n", stderr);
+        return 1;
+    }
+    
+    //Build the level and the queries
+    double buildStart = Bench_Now();
+    Cyb_NavMesh *nav = Bench_BuildLevel();
+    double buildTime = Bench_Now() - buildStart;
+    Cyb_JobSystem *jobs = Cyb_CreateJobSystem(-1);
+    Cyb_PathQueue *serial = nav ? Cyb_CreatePathQueue(nav, NULL) : NULL;
+    Cyb_PathQueue *parallel = nav && jobs ? Cyb_CreatePathQueue(nav, jobs) :
+        NULL;
+    
+    if(!serial || !parallel)
+    {
+        fputs("Failed to create the navigation mesh.\n", stderr);
+        Cyb_FreeObject((Cyb_Object**)&serial);
+        Cyb_FreeObject((Cyb_Object**)&parallel);
+        Cyb_FreeObject((Cyb_Object**)&nav);
+        Cyb_FreeObject((Cyb_Object**)&jobs);
+        return 1;
+    }
+    
+    Bench_MakeQueries();
+    
+    //Numbers from unoptimized builds are not meaningful, so flag them
+#if defined(__OPTIMIZE__) || (defined(_MSC_VER) && defined(NDEBUG))
+    const char *optimized = "true";
+#else
+    const char *optimized = "false";
+#endif
+    
+    fprintf(out, "{\n    \"optimized\": %s,\n    \"triangles\": %d,\n"
+        "    \"buildMs\": %.3f,\n    \"threads\": %d,\n    \"queries\": %d,\n"
+        "    \"results\": [\n", optimized, nav->triCount, buildTime,
+        jobs->threadCount + 1, BENCH_QUERIES);
+    
+    //Time each configuration and keep the best run
+    struct
+    {
+        const char *name;
+        Cyb_PathQueue *queue;
+        float budget;
+    } configs[] = {
+        {"serial", serial, 0.0f},
+        {"parallel", parallel, 0.0f},
+        {"parallel_budget", parallel, BENCH_BUDGET}
+    };
+    int configCount = (int)(sizeof(configs) / sizeof(configs[0]));
+    
+    for(int i = 0; i < configCount; i++)
+    {
+        double best = 1e30;
+        int frames = 0;
+        double maxFrame = 0.0;
+        
+        for(int run = 0; run < BENCH_RUNS; run++)
+        {
+            int runFrames;
+            double runMaxFrame;
+            double time = Bench_RunQueue(configs[i].queue, configs[i].budget,
+                &runFrames, &runMaxFrame);
+            
+            if(time < best)
+            {
+                best = time;
+                frames = runFrames;
+                maxFrame = runMaxFrame;
+            }
+        }
+        
+        double perSec = BENCH_QUERIES / (best / 1000.0);
+        
+        if(out != stdout)
+        {
+            printf("%-16s %10.0f queries/s %8.2f us/query %6d frames "
+                "%8.3f ms max frame\n", configs[i].name, perSec,
+                best * 1000.0 / BENCH_QUERIES, frames, maxFrame);
+        }
+        
+        fprintf(out, "        {\"name\": \"%s\", \"budgetMs\": %.3f, "
+            "\"queriesPerSec\": %.1f, \"usPerQuery\": %.3f, \"frames\": %d, "
+            "\"maxFrameMs\": %.3f}%s\n", configs[i].name, configs[i].budget,
+            perSec, best * 1000.0 / BENCH_QUERIES, frames, maxFrame,
+            i + 1 < configCount ? "," : "");
+    }
+    
+    //Summarize the paths of the last run
+    int found = 0;
+    int pointTotal = 0;
+    
+    for(int i = 0; i < BENCH_QUERIES; i++)
+    {
+        found += queries[i].status == CYB_PATH_FOUND;
+        pointTotal += queries[i].pointCount;
+    }
+    
+    fprintf(out, "    ],\n    \"found\": %d,\n    \"avgPoints\": %.2f\n}\n",
+        found, (double)pointTotal / BENCH_QUERIES);
+    
+    if(out != stdout)
+    {
+        fclose(out);
+    }
+    
+    Cyb_FreeObject((Cyb_Object**)&serial);
+    Cyb_FreeObject((Cyb_Object**)&parallel);
+    Cyb_FreeObject((Cyb_Object**)&nav);
+    Cyb_FreeObject((Cyb_Object**)&jobs);
+    return 0;
+}
\ No newline at end of file
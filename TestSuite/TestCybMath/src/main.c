@@ -294,7 +294,36 @@ int TestCybMatrices(void)
         i.e, i.f, i.g, i.h,
         i.i, i.j, i.k, i.l,
         i.m, i.n, i.o, i.p);
-
+    
+    //Test inline functions against the exported ones
+    puts("Testing inline matrix functions...");
+    Cyb_Mat4 inl;
+    Cyb_Vec3 v3;
+    Cyb_Vec4 q = {.1f, .2f, .3f, .9f};
+    Cyb_Vec4 q2 = q;
+    Cyb_InlineMulMat4(&inl, &tmp, &s);
+    Cyb_InlineTransform(&v3, &mv, &v);
+    Cyb_Transform(&v2, &mv, &v);
+    Cyb_NormalizeQuat(&q);
+    Cyb_InlineNormalizeQuat(&q2);
+    
+    if(memcmp(&inl, &mv, sizeof(Cyb_Mat4)) || memcmp(&v2, &v3, sizeof(v2)) ||
+        memcmp(&q, &q2, sizeof(q)))
+    {
+        puts("failed");
+        return 1;
+    }
+    
+    //The result may be the same as either operand
+    inl = tmp;
+    Cyb_InlineMulMat4(&inl, &inl, &s);
+    
+    if(memcmp(&inl, &mv, sizeof(Cyb_Mat4)))
+    {
+        puts("failed");
+        return 1;
+    }
+    
     return 0;
 }
 
@@ -308,7 +337,7 @@ int TestCybBoxes(void)
         Cyb_Box b = {{5, 5, 5}, {2, 2, 2}};
         Cyb_Box c = {{-5, -5, -5}, {2, 2, 2}};
         Cyb_Vec3 p = {0, 0, 0};
-    
+        
         if(!Cyb_BoxHitBox(&a, &b) || Cyb_BoxHitBox(&b, &c) ||
             !Cyb_BoxHitBox(&a, &c) || !Cyb_PointInBox(&p, &a) ||
             Cyb_PointInBox(&p, &b))
@@ -316,13 +345,143 @@ int TestCybBoxes(void)
             puts("failed");
             return 1;
         }
-    
+        
         //Test bounding box rotation
         puts("Testing bounding box rotation...");
         Cyb_Box d;
         Cyb_RotateBox(&d, &a, 0, 0, 45, CYB_ROT_XYZ);
         printf("center = (%f, %f, %f)\nsize = (%f, %f, %f)\n", d.center.x, 
             d.center.y, d.center.z, d.size.x, d.size.y, d.size.z);
+        
+        if(fabsf(d.size.x - 14.142136f) > .001f || 
+            fabsf(d.size.y - 14.142136f) > .001f || 
+            fabsf(d.size.z - 10) > .001f || fabsf(d.center.x) > .001f)
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        //Test bounding box generation away from the origin
+        puts("Testing bounding box generation...");
+        Cyb_Vec3 verts[8];
+        Cyb_GenerateBoxGeometry(verts, NULL, &b);
+        Cyb_BoxFromGeometry(&d, verts, sizeof(Cyb_Vec3), 8);
+        
+        if(d.center.x != 5 || d.center.y != 5 || d.center.z != 5 ||
+            d.size.x != 2 || d.size.y != 2 || d.size.z != 2)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    {
+        //Test bounding sphere generation
+        puts("Testing bounding sphere generation...");
+        Cyb_Vec3 verts[500];
+        srand(7);
+        
+        for(int i = 0; i < 500; i++)
+        {
+            verts[i].x = 20 + (rand() % 2001 - 1000) / 100.0f;
+            verts[i].y = -5 + (rand() % 2001 - 1000) / 400.0f;
+            verts[i].z = (rand() % 2001 - 1000) / 200.0f;
+        }
+        
+        for(int method = CYB_SPHERE_RITTER; method <= CYB_SPHERE_EPOS26; 
+            method++)
+        {
+            Cyb_Sphere s;
+            Cyb_SphereFromGeometry(&s, verts, sizeof(Cyb_Vec3), 500, method);
+            
+            for(int i = 0; i < 500; i++)
+            {
+                float dx = verts[i].x - s.center.x;
+                float dy = verts[i].y - s.center.y;
+                float dz = verts[i].z - s.center.z;
+                
+                if(sqrtf(dx * dx + dy * dy + dz * dz) > s.radius * 1.0001f ||
+                    s.radius > 15)
+                {
+                    puts("failed");
+                    return 1;
+                }
+            }
+        }
+    }
+    
+    {
+        //Test oriented boxes
+        puts("Testing oriented box generation...");
+        Cyb_Box box = {{0, 0, 0}, {8, 2, 2}};
+        Cyb_Mat4 r;
+        Cyb_Mat4 t;
+        Cyb_Mat4 m;
+        Cyb_Rotate(&r, 0, 0, 30, CYB_ROT_XYZ);
+        Cyb_Translate(&t, 10, 0, 0);
+        Cyb_MulMat4(&m, &t, &r);
+        Cyb_Vec3 verts[8];
+        Cyb_GenerateBoxGeometry(verts, NULL, &box);
+        
+        for(int i = 0; i < 8; i++)
+        {
+            Cyb_Vec3 tmp;
+            Cyb_Transform(&tmp, &m, &verts[i]);
+            verts[i] = tmp;
+        }
+        
+        Cyb_OBB a;
+        Cyb_OBB b;
+        Cyb_OBBFromGeometry(&a, verts, sizeof(Cyb_Vec3), 8);
+        Cyb_OBBFromBox(&b, &box, &m);
+        
+        if(fabsf(a.size.x * a.size.y * a.size.z - 32) > .01f ||
+            fabsf(a.center.x - 10) > .001f || fabsf(b.size.x - 8) > .001f ||
+            fabsf(b.center.x - 10) > .001f)
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        puts("Testing oriented box collision detection...");
+        Cyb_OBB c = b;
+        Cyb_OBB d = b;
+        Cyb_OBB e = b;
+        Cyb_Vec3 p = {10, 0, 0};
+        c.center.x -= 3.5f;
+        c.center.y -= 2;
+        d.center.x -= 4;
+        d.center.y += 2.5f;
+        e.center.y += 3;
+        Cyb_Box aabb;
+        Cyb_BoxFromOBB(&aabb, &b);
+        
+        if(!Cyb_OBBHitOBB(&b, &c) || Cyb_OBBHitOBB(&b, &d) || 
+            Cyb_OBBHitOBB(&b, &e) || !Cyb_PointInOBB(&p, &b) || 
+            Cyb_PointInOBB(&e.center, &b) || !Cyb_PointInBox(&c.center, &aabb))
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        puts("Testing ray vs oriented box...");
+        Cyb_Ray ray = {{10, -10, 0}, {0, 1, 0}};
+        float dist;
+        
+        if(!Cyb_RayHitOBB(&ray, &b, &dist) || 
+            fabsf(dist - (10 - 1 / cosf(radians(30)))) > .001f)
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        ray.origin.x = 14.5f;
+        
+        if(Cyb_RayHitOBB(&ray, &b, NULL))
+        {
+            puts("failed");
+            return 1;
+        }
     }
     
     {
@@ -345,6 +504,984 @@ int TestCybBoxes(void)
 }
 
 
+int TestCybFrustums(void)
+{
+    //Build a view-projection matrix for a camera at (0, 0, 5) looking down -Z
+    Cyb_Mat4 proj;
+    Cyb_Mat4 view;
+    Cyb_Mat4 viewProj;
+    Cyb_Frustum frustum;
+    Cyb_Perspective(&proj, 45, 800.0f / 600.0f, .1f, 100);
+    Cyb_Translate(&view, 0, 0, -5);
+    Cyb_MulMat4(&viewProj, &proj, &view);
+    Cyb_FrustumFromMatrix(&frustum, &viewProj);
+    
+    {
+        //Test frustum point and sphere tests
+        puts("Testing frustum visibility tests...");
+        Cyb_Vec3 p = {0, 0, 0};
+        Cyb_Vec3 q = {0, 0, 6};
+        Cyb_Sphere a = {{0, 0, -10}, 1};
+        Cyb_Sphere b = {{0, 0, 10}, 1};
+        Cyb_Sphere c = {{100, 0, -10}, 1};
+        Cyb_Sphere d = {{0, 0, -200}, 1};
+        Cyb_Sphere e = {{0, 0, 5.5f}, 1};
+        
+        if(!Cyb_PointInFrustum(&p, &frustum) || 
+            Cyb_PointInFrustum(&q, &frustum) ||
+            !Cyb_SphereInFrustum(&a, &frustum) ||
+            Cyb_SphereInFrustum(&b, &frustum) ||
+            Cyb_SphereInFrustum(&c, &frustum) ||
+            Cyb_SphereInFrustum(&d, &frustum) ||
+            !Cyb_SphereInFrustum(&e, &frustum))
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        Cyb_Box f = {{0, 0, -10}, {2, 2, 2}};
+        Cyb_Box g = {{20, 0, -10}, {2, 2, 2}};
+        Cyb_Box h = {{20, 0, -10}, {30, 2, 2}};
+        
+        if(!Cyb_BoxInFrustum(&f, &frustum) || 
+            Cyb_BoxInFrustum(&g, &frustum) ||
+            !Cyb_BoxInFrustum(&h, &frustum))
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    {
+        //Test batch culling against the single volume tests
+        puts("Testing batch frustum culling...");
+        Cyb_Sphere spheres[37];
+        Cyb_Box boxes[37];
+        unsigned char sphereBits[5];
+        unsigned char boxBits[5];
+        int sphereIndices[37];
+        int boxIndices[37];
+        srand(1);
+        
+        for(int i = 0; i < 37; i++)
+        {
+            spheres[i].center.x = (float)(rand() % 200 - 100);
+            spheres[i].center.y = (float)(rand() % 200 - 100);
+            spheres[i].center.z = (float)(rand() % 200 - 150);
+            spheres[i].radius = (float)(rand() % 20);
+            boxes[i].center = spheres[i].center;
+            boxes[i].size.x = spheres[i].radius;
+            boxes[i].size.y = spheres[i].radius * 2;
+            boxes[i].size.z = spheres[i].radius * .5f;
+        }
+        
+        Cyb_CullSpheres(&frustum, spheres, 37, sphereBits);
+        Cyb_CullBoxes(&frustum, boxes, 37, boxBits);
+        int sphereCount = Cyb_CullSpheresIndexed(&frustum, spheres, 37, 
+            sphereIndices);
+        int boxCount = Cyb_CullBoxesIndexed(&frustum, boxes, 37, boxIndices);
+        int visibleSpheres = 0;
+        int visibleBoxes = 0;
+        
+        for(int i = 0; i < 37; i++)
+        {
+            int sphereVisible = Cyb_SphereInFrustum(&spheres[i], &frustum);
+            int boxVisible = Cyb_BoxInFrustum(&boxes[i], &frustum);
+            
+            if(((sphereBits[i / 8] >> (i % 8)) & 1) != sphereVisible ||
+                ((boxBits[i / 8] >> (i % 8)) & 1) != boxVisible)
+            {
+                puts("failed");
+                return 1;
+            }
+            
+            if(sphereVisible)
+            {
+                if(visibleSpheres >= sphereCount || 
+                    sphereIndices[visibleSpheres] != i)
+                {
+                    puts("failed");
+                    return 1;
+                }
+                
+                visibleSpheres++;
+            }
+            
+            if(boxVisible)
+            {
+                if(visibleBoxes >= boxCount || boxIndices[visibleBoxes] != i)
+                {
+                    puts("failed");
+                    return 1;
+                }
+                
+                visibleBoxes++;
+            }
+        }
+        
+        if(visibleSpheres != sphereCount || visibleBoxes != boxCount)
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        printf("%i of 37 spheres visible\n%i of 37 boxes visible\n", 
+            sphereCount, boxCount);
+    }
+    
+    return 0;
+}
+
+
+int TestCybBVHs(void)
+{
+    //Generate random boxes
+    static Cyb_Box boxes[2000];
+    static int hits[2000];
+    srand(2);
+    
+    for(int i = 0; i < 2000; i++)
+    {
+        boxes[i].center.x = (float)(rand() % 1000 - 500);
+        boxes[i].center.y = (float)(rand() % 1000 - 500);
+        boxes[i].center.z = (float)(rand() % 1000 - 500);
+        boxes[i].size.x = (float)(rand() % 20 + 1);
+        boxes[i].size.y = (float)(rand() % 20 + 1);
+        boxes[i].size.z = (float)(rand() % 20 + 1);
+    }
+    
+    Cyb_BVH *bvh = Cyb_CreateBVH(boxes, 2000);
+    
+    if(!bvh)
+    {
+        puts("failed");
+        return 1;
+    }
+    
+    for(int pass = 0; pass < 2; pass++)
+    {
+        //Test box queries against a linear scan
+        puts(pass ? "Testing refitted BVH box queries..." : 
+            "Testing BVH box queries...");
+        
+        for(int q = 0; q < 50; q++)
+        {
+            Cyb_Box query = {{(float)(rand() % 1000 - 500), 
+                (float)(rand() % 1000 - 500), (float)(rand() % 1000 - 500)}, 
+                {100, 100, 100}};
+            int expected = 0;
+            
+            for(int i = 0; i < 2000; i++)
+            {
+                expected += Cyb_BoxHitBox(&query, &boxes[i]);
+            }
+            
+            int count = Cyb_QueryBVH(bvh, &query, hits, 2000);
+            
+            if(count != expected)
+            {
+                puts("failed");
+                return 1;
+            }
+            
+            for(int i = 0; i < count; i++)
+            {
+                if(!Cyb_BoxHitBox(&query, &boxes[hits[i]]))
+                {
+                    puts("failed");
+                    return 1;
+                }
+            }
+        }
+        
+        //Test ray casts against a linear scan
+        puts(pass ? "Testing refitted BVH ray casts..." : 
+            "Testing BVH ray casts...");
+        
+        for(int q = 0; q < 50; q++)
+        {
+            Cyb_Ray ray = {{(float)(rand() % 1000 - 500), 
+                (float)(rand() % 1000 - 500), -600}, 
+                {(float)(rand() % 100 - 50) / 100.0f, 
+                (float)(rand() % 100 - 50) / 100.0f, 1}};
+            int expected = 0;
+            int closest = -1;
+            float closestT = INFINITY;
+            float t;
+            
+            for(int i = 0; i < 2000; i++)
+            {
+                if(Cyb_RayHitBox(&ray, &boxes[i], &t))
+                {
+                    expected++;
+                    
+                    if(t < closestT)
+                    {
+                        closestT = t;
+                        closest = i;
+                    }
+                }
+            }
+            
+            int count = Cyb_RayCastBVH(bvh, &ray, INFINITY, hits, 2000);
+            int hit = Cyb_RayClosestBVH(bvh, &ray, INFINITY, NULL, NULL, &t);
+            
+            if(count != expected || (hit >= 0) != (closest >= 0) || 
+                (hit >= 0 && fabsf(t - closestT) > .001f))
+            {
+                printf("%i/%i hits, closest %i/%i\n", count, expected, hit, 
+                    closest);
+                puts("failed");
+                return 1;
+            }
+        }
+        
+        //Move the boxes and refit
+        for(int i = 0; i < 2000; i++)
+        {
+            boxes[i].center.x += (float)(rand() % 40 - 20);
+            boxes[i].center.y += (float)(rand() % 40 - 20);
+            boxes[i].center.z += (float)(rand() % 40 - 20);
+        }
+        
+        Cyb_RefitBVH(bvh, boxes);
+    }
+    
+    Cyb_FreeBVH(bvh);
+    return 0;
+}
+
+
+int TestCybRays(void)
+{
+    {
+        //Test single ray tests
+        puts("Testing ray intersection tests...");
+        Cyb_Ray ray = {{0, 0, -10}, {0, 0, 1}};
+        Cyb_Box box = {{0, 0, 0}, {2, 2, 2}};
+        Cyb_Sphere sphere = {{0, 0, 0}, 2};
+        Cyb_Vec3 v0 = {-1, -1, 3};
+        Cyb_Vec3 v1 = {1, -1, 3};
+        Cyb_Vec3 v2 = {0, 1, 3};
+        Cyb_Vec3 v3 = {5, 5, 3};
+        float t1;
+        float t2;
+        float t3;
+        
+        if(!Cyb_RayHitBox(&ray, &box, &t1) || 
+            !Cyb_RayHitSphere(&ray, &sphere, &t2) ||
+            !Cyb_RayHitTriangle(&ray, &v0, &v1, &v2, &t3) ||
+            Cyb_RayHitTriangle(&ray, &v1, &v2, &v3, NULL) ||
+            fabsf(t1 - 9) > .0001f || fabsf(t2 - 8) > .0001f || 
+            fabsf(t3 - 13) > .0001f)
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        ray.dir.z = -1;
+        
+        if(Cyb_RayHitBox(&ray, &box, NULL) || 
+            Cyb_RayHitSphere(&ray, &sphere, NULL) ||
+            Cyb_RayHitTriangle(&ray, &v0, &v1, &v2, NULL))
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    {
+        //Test ray packets against the single ray tests
+        puts("Testing ray packets...");
+        Cyb_Ray rays[8];
+        Cyb_RayPacket4 packet4;
+        Cyb_RayPacket8 packet8;
+        Cyb_Box box = {{0, 0, 0}, {4, 4, 4}};
+        Cyb_Sphere sphere = {{0, 0, 0}, 2};
+        Cyb_Vec3 verts[64];
+        unsigned int indices[90];
+        srand(4);
+        
+        for(int i = 0; i < 64; i++)
+        {
+            verts[i].x = (float)(rand() % 20 - 10);
+            verts[i].y = (float)(rand() % 20 - 10);
+            verts[i].z = (float)(rand() % 20 - 10);
+        }
+        
+        for(int i = 0; i < 90; i++)
+        {
+            indices[i] = rand() % 64;
+        }
+        
+        for(int pass = 0; pass < 20; pass++)
+        {
+            for(int i = 0; i < 8; i++)
+            {
+                rays[i].origin.x = (float)(rand() % 10 - 5);
+                rays[i].origin.y = (float)(rand() % 10 - 5);
+                rays[i].origin.z = -20;
+                rays[i].dir.x = (float)(rand() % 10 - 5) / 20.0f;
+                rays[i].dir.y = (float)(rand() % 10 - 5) / 20.0f;
+                rays[i].dir.z = 1;
+            }
+            
+            Cyb_MakeRayPacket4(&packet4, rays);
+            Cyb_MakeRayPacket8(&packet8, rays);
+            float t4[4];
+            float t8[8];
+            int tris[8];
+            int boxBits4 = Cyb_RayPacket4HitBox(&packet4, &box, NULL);
+            int boxBits8 = Cyb_RayPacket8HitBox(&packet8, &box, NULL);
+            int sphereBits4 = Cyb_RayPacket4HitSphere(&packet4, &sphere, 
+                NULL);
+            int sphereBits8 = Cyb_RayPacket8HitSphere(&packet8, &sphere, 
+                NULL);
+            int triBits4 = Cyb_RayPacket4HitTriangle(&packet4, &verts[0], 
+                &verts[1], &verts[2], NULL);
+            int triBits8 = Cyb_RayPacket8HitTriangle(&packet8, &verts[0], 
+                &verts[1], &verts[2], NULL);
+            
+            for(int i = 0; i < 8; i++)
+            {
+                t8[i] = INFINITY;
+            }
+            
+            int meshBits8 = Cyb_RayPacket8HitTriangles(&packet8, verts, 
+                indices, 30, t8, tris);
+            
+            //Build the expected lane masks from single ray tests and compare 
+            //them after the loop (GCC 12.2 at -O1 and above miscompiles the
+            //per-lane "((bits >> i) & 1) != hit || ..." checks this used to 
+            //do and reports hits as misses)
+            int boxMask = 0;
+            int sphereMask = 0;
+            int triMask = 0;
+            int meshMask = 0;
+            
+            for(int i = 0; i < 8; i++)
+            {
+                float t = INFINITY;
+                int tri = Cyb_RayHitTriangles(&rays[i], verts, indices, 30, 
+                    &t);
+                boxMask |= Cyb_RayHitBox(&rays[i], &box, NULL) << i;
+                sphereMask |= Cyb_RayHitSphere(&rays[i], &sphere, NULL) << i;
+                triMask |= Cyb_RayHitTriangle(&rays[i], &verts[0], &verts[1],
+                    &verts[2], NULL) << i;
+                meshMask |= (tri >= 0) << i;
+                
+                if(tri >= 0 && fabsf(t - t8[i]) > .0001f)
+                {
+                    puts("failed");
+                    return 1;
+                }
+            }
+            
+            if(boxBits8 != boxMask || sphereBits8 != sphereMask ||
+                triBits8 != triMask || meshBits8 != meshMask ||
+                boxBits4 != (boxMask & 15) || 
+                sphereBits4 != (sphereMask & 15) || triBits4 != (triMask & 15))
+            {
+                puts("failed");
+                return 1;
+            }
+            
+            //Test the triangle list against a linear scan
+            for(int i = 0; i < 4; i++)
+            {
+                t4[i] = INFINITY;
+            }
+            
+            Cyb_RayPacket4HitTriangles(&packet4, verts, indices, 30, t4, tris);
+            
+            for(int i = 0; i < 4; i++)
+            {
+                float closest = INFINITY;
+                float t;
+                
+                for(int j = 0; j < 30; j++)
+                {
+                    if(Cyb_RayHitTriangle(&rays[i], &verts[indices[j * 3]], 
+                        &verts[indices[j * 3 + 1]], &verts[indices[j * 3 + 2]],
+                        &t) && t < closest)
+                    {
+                        closest = t;
+                    }
+                }
+                
+                if(closest != t4[i] && fabsf(closest - t4[i]) > .0001f)
+                {
+                    puts("failed");
+                    return 1;
+                }
+            }
+        }
+    }
+    
+    return 0;
+}
+
+
+int ComparePairs(const void *a, const void *b)
+{
+    const Cyb_Pair *pa = (const Cyb_Pair*)a;
+    const Cyb_Pair *pb = (const Cyb_Pair*)b;
+    return pa->a != pb->a ? pa->a - pb->a : pa->b - pb->b;
+}
+
+
+int TestCybBroadPhases(void)
+{
+    //Generate random boxes
+    static Cyb_Box boxes[1500];
+    static Cyb_Pair expected[20000];
+    static Cyb_Pair hashPairs[20000];
+    static Cyb_Pair sapPairs[20000];
+    srand(3);
+    
+    for(int i = 0; i < 1500; i++)
+    {
+        boxes[i].center.x = (float)(rand() % 400 - 200);
+        boxes[i].center.y = (float)(rand() % 400 - 200);
+        boxes[i].center.z = (float)(rand() % 400 - 200);
+        boxes[i].size.x = (float)(rand() % 20 + 1);
+        boxes[i].size.y = (float)(rand() % 20 + 1);
+        boxes[i].size.z = (float)(rand() % 20 + 1);
+    }
+    
+    Cyb_SpatialHash *hash = Cyb_CreateSpatialHash(16);
+    Cyb_SweepAndPrune *sap = Cyb_CreateSweepAndPrune();
+    
+    if(!hash || !sap)
+    {
+        puts("failed");
+        return 1;
+    }
+    
+    for(int pass = 0; pass < 3; pass++)
+    {
+        //Find pairs by brute force
+        puts("Testing broad phase pairs...");
+        int expectedCount = 0;
+        
+        for(int i = 0; i < 1500; i++)
+        {
+            for(int j = i + 1; j < 1500; j++)
+            {
+                if(Cyb_BoxHitBox(&boxes[i], &boxes[j]))
+                {
+                    expected[expectedCount].a = i;
+                    expected[expectedCount++].b = j;
+                }
+            }
+        }
+        
+        //Compare the spatial hash and sort and sweep results
+        if(Cyb_UpdateSpatialHash(hash, boxes, 1500) ||
+            Cyb_UpdateSweepAndPrune(sap, boxes, 1500))
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        int hashCount = Cyb_FindSpatialHashPairs(hash, hashPairs, 20000);
+        int sapCount = Cyb_FindSweepAndPrunePairs(sap, sapPairs, 20000);
+        qsort(hashPairs, hashCount, sizeof(Cyb_Pair), &ComparePairs);
+        qsort(sapPairs, sapCount, sizeof(Cyb_Pair), &ComparePairs);
+        
+        if(hashCount != expectedCount || sapCount != expectedCount ||
+            memcmp(hashPairs, expected, sizeof(Cyb_Pair) * expectedCount) ||
+            memcmp(sapPairs, expected, sizeof(Cyb_Pair) * expectedCount))
+        {
+            printf("%i/%i/%i pairs\n", hashCount, sapCount, expectedCount);
+            puts("failed");
+            return 1;
+        }
+        
+        //Move the boxes
+        for(int i = 0; i < 1500; i++)
+        {
+            boxes[i].center.x += (float)(rand() % 11 - 5);
+            boxes[i].center.y += (float)(rand() % 11 - 5);
+            boxes[i].center.z += (float)(rand() % 11 - 5);
+        }
+    }
+    
+    //Test spatial hash queries and removal
+    puts("Testing spatial hash queries...");
+    int hits[1500];
+    Cyb_UpdateSpatialHash(hash, boxes, 1500);
+    int count = Cyb_QuerySpatialHash(hash, &boxes[0], hits, 1500);
+    int found = FALSE;
+    
+    for(int i = 0; i < count; i++)
+    {
+        found |= hits[i] == 0;
+    }
+    
+    Cyb_RemoveSpatialHashObject(hash, 0);
+    
+    if(!found || Cyb_QuerySpatialHash(hash, &boxes[0], hits, 1500) != 
+        count - 1)
+    {
+        puts("failed");
+        return 1;
+    }
+    
+    Cyb_FreeSpatialHash(hash);
+    Cyb_FreeSweepAndPrune(sap);
+    return 0;
+}
+
+
+int TestCybFastMath(void)
+{
+    {
+        //Test trigonometric functions against libm
+        puts("Testing fast trigonometric functions...");
+        float angles[13];
+        float sines[13];
+        float cosines[13];
+        float values[13];
+        float acosines[13];
+        
+        for(int i = 0; i < 13; i++)
+        {
+            angles[i] = (i - 6) * 1.37f;
+            values[i] = (i - 6) / 6.0f;
+        }
+        
+        Cyb_FastSinCosArray(angles, sines, cosines, 13);
+        Cyb_FastAcosArray(values, acosines, 13);
+        
+        for(int i = 0; i < 13; i++)
+        {
+            if(fabsf(sines[i] - sinf(angles[i])) > 1e-6f ||
+                fabsf(cosines[i] - cosf(angles[i])) > 1e-6f ||
+                fabsf(acosines[i] - acosf(values[i])) > 1e-6f)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+    }
+    
+    {
+        //Test reciprocal square root and normalization
+        puts("Testing fast reciprocal square root...");
+        Cyb_Vec3 v[5] = {
+            {3, 4, 0}, {0, 0, 2}, {1, 1, 1}, {0, 0, 0}, {0, -5, 12}
+        };
+        Cyb_FastNormalizeVec3Array(v, 5);
+        
+        if(fabsf(Cyb_FastRsqrt(16.0f) - .25f) > 1e-6f ||
+            fabsf(v[0].x - .6f) > 1e-6f || fabsf(v[0].y - .8f) > 1e-6f ||
+            fabsf(v[1].z - 1.0f) > 1e-6f || v[3].x != 0 || v[3].z != 0 ||
+            fabsf(v[4].z - 12.0f / 13.0f) > 1e-6f)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    {
+        //Test quaternion functions built on the fast math kernels
+        puts("Testing quaternion interpolation...");
+        Cyb_Vec4 a;
+        Cyb_Vec4 b;
+        Cyb_Vec4 c;
+        Cyb_Vec4 expected;
+        Cyb_QuatFromAxisAndAngle(&a, 0, 1, 0, 0);
+        Cyb_QuatFromAxisAndAngle(&b, 0, 1, 0, 90);
+        Cyb_QuatFromAxisAndAngle(&expected, 0, 1, 0, 30);
+        Cyb_Slerp(&c, &a, &b, 1.0 / 3.0);
+        
+        if(fabsf(c.y - expected.y) > 1e-5f || fabsf(c.w - expected.w) > 1e-5f ||
+            fabsf(expected.w - cosf(radians(15.0f))) > 1e-6f)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    {
+        //Test approximated interpolation against slerp
+        puts("Testing fast quaternion interpolation...");
+        Cyb_Vec4 a[6];
+        Cyb_Vec4 b[6];
+        Cyb_Vec4 c[6];
+        Cyb_Vec4 n[6];
+        float progress[6];
+        
+        for(int i = 0; i < 6; i++)
+        {
+            Cyb_QuatFromAxisAndAngle(&a[i], 0, 0, 1, i * 25.0f);
+            Cyb_QuatFromAxisAndAngle(&b[i], 0, 1, 0, 170.0f - i * 40.0f);
+            progress[i] = i / 5.0f;
+        }
+        
+        Cyb_FastSlerpArray(c, a, b, progress, 6);
+        Cyb_NlerpArray(n, a, b, progress, 6);
+        
+        for(int i = 0; i < 6; i++)
+        {
+            Cyb_Vec4 expected;
+            Cyb_Vec4 single;
+            Cyb_Slerp(&expected, &a[i], &b[i], progress[i]);
+            Cyb_FastSlerp(&single, &a[i], &b[i], progress[i]);
+            
+            if(fabsf(c[i].x - expected.x) > 1e-3f ||
+                fabsf(c[i].y - expected.y) > 1e-3f ||
+                fabsf(c[i].z - expected.z) > 1e-3f ||
+                fabsf(c[i].w - expected.w) > 1e-3f ||
+                memcmp(&single, &c[i], sizeof(Cyb_Vec4)) ||
+                fabsf(n[i].x * n[i].x + n[i].y * n[i].y + n[i].z * n[i].z +
+                n[i].w * n[i].w - 1.0f) > 1e-5f)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+        
+        //Nlerp and slerp agree halfway between the ends
+        Cyb_Vec4 half;
+        Cyb_Vec4 expected;
+        Cyb_Nlerp(&half, &a[1], &b[1], .5f);
+        Cyb_Slerp(&expected, &a[1], &b[1], .5);
+        
+        if(fabsf(half.x - expected.x) > 1e-5f ||
+            fabsf(half.y - expected.y) > 1e-5f ||
+            fabsf(half.z - expected.z) > 1e-5f ||
+            fabsf(half.w - expected.w) > 1e-5f)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+
+int TestCybWideVectors(void)
+{
+    {
+        //Test wide 3D vector functions against the scalar results
+        puts("Testing wide 3D vectors...");
+        Cyb_Vec3 a[8];
+        Cyb_Vec3 b[8];
+        Cyb_Vec3 c[8];
+        float dots[8];
+        
+        for(int i = 0; i < 8; i++)
+        {
+            a[i].x = i - 3.0f;
+            a[i].y = i * .5f + 1.0f;
+            a[i].z = 2.0f - i * i * .25f;
+            b[i].x = 1.0f - i;
+            b[i].y = i * 1.5f;
+            b[i].z = i % 3 - 1.0f;
+        }
+        
+        Cyb_Vec3x8 wa = Cyb_Vec3x8Load(a);
+        Cyb_Vec3x8 wb = Cyb_Vec3x8Load(b);
+        Cyb_Vec3x8Store(c, Cyb_Vec3x8Cross(wa, wb));
+        Cyb_F8Store(dots, Cyb_Vec3x8Dot(wa, wb));
+        
+        for(int i = 0; i < 8; i++)
+        {
+            float dot = a[i].x * b[i].x + a[i].y * b[i].y + a[i].z * b[i].z;
+            
+            if(fabsf(c[i].x - (a[i].y * b[i].z - a[i].z * b[i].y)) > 1e-5f ||
+                fabsf(c[i].y - (a[i].z * b[i].x - a[i].x * b[i].z)) > 1e-5f ||
+                fabsf(c[i].z - (a[i].x * b[i].y - a[i].y * b[i].x)) > 1e-5f ||
+                fabsf(dots[i] - dot) > 1e-5f)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+        
+        //Normalize and select
+        Cyb_Vec3 normals[4];
+        Cyb_Vec3x4 n = Cyb_Vec3x4Normalize(Cyb_Vec3x4Load(a));
+        Cyb_F4 mask = Cyb_F4CmpLt(n.x, Cyb_F4Set1(0.0f));
+        Cyb_Vec3x4Store(normals, n);
+        Cyb_Vec3x4Store(c, Cyb_Vec3x4Select(mask, n, Cyb_Vec3x4Load(b)));
+        
+        if(Cyb_F4MoveMask(mask) != 7 ||
+            Cyb_F4MoveMask(Cyb_F4CmpGt(Cyb_F4Abs(Cyb_F4Sub(
+            Cyb_Vec3x4Length(n), Cyb_F4Set1(1.0f))), Cyb_F4Set1(1e-5f))))
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        for(int i = 0; i < 4; i++)
+        {
+            const Cyb_Vec3 *expected = (i < 3 ? &normals[i] : &b[i]);
+            
+            if(c[i].x != expected->x || c[i].y != expected->y ||
+                c[i].z != expected->z)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+    }
+    
+    {
+        //Test wide quaternion functions against the scalar results
+        puts("Testing wide quaternions...");
+        Cyb_Vec4 a[4];
+        Cyb_Vec4 b[4];
+        Cyb_Vec4 c[4];
+        Cyb_Vec3 v[4] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 2, 3}};
+        Cyb_Vec3 rotated[4];
+        
+        for(int i = 0; i < 4; i++)
+        {
+            Cyb_QuatFromAxisAndAngle(&a[i], 0, 1, 0, i * 30.0f);
+            Cyb_QuatFromAxisAndAngle(&b[i], 1, 0, 0, 90.0f - i * 20.0f);
+        }
+        
+        Cyb_QuatX4 wa = Cyb_QuatX4Load(a);
+        Cyb_QuatX4Store(c, Cyb_QuatX4Normalize(Cyb_QuatX4Mul(wa,
+            Cyb_QuatX4Load(b))));
+        Cyb_Vec3x4Store(rotated, Cyb_QuatX4Rotate(wa, Cyb_Vec3x4Load(v)));
+        
+        for(int i = 0; i < 4; i++)
+        {
+            Cyb_Vec4 expected;
+            Cyb_Mat4 m;
+            Cyb_Vec3 r;
+            Cyb_MulQuat(&expected, &a[i], &b[i]);
+            Cyb_QuatToMatrix(&m, &a[i]);
+            Cyb_Transform(&r, &m, &v[i]);
+            
+            if(fabsf(c[i].x - expected.x) > 1e-5f ||
+                fabsf(c[i].y - expected.y) > 1e-5f ||
+                fabsf(c[i].z - expected.z) > 1e-5f ||
+                fabsf(c[i].w - expected.w) > 1e-5f ||
+                fabsf(rotated[i].x - r.x) > 1e-5f ||
+                fabsf(rotated[i].y - r.y) > 1e-5f ||
+                fabsf(rotated[i].z - r.z) > 1e-5f)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+
+int TestCybNoise(void)
+{
+    {
+        //Test the integer lanes
+        puts("Testing integer lanes...");
+        int ints[4];
+        float floors[4];
+        Cyb_I4 a = Cyb_I4Set1(0x7fffffff);
+        Cyb_I4Store(ints, Cyb_I4Mul(a, Cyb_I4Set1(3)));
+        
+        if(ints[0] != 0x7ffffffd || ints[3] != 0x7ffffffd)
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        Cyb_I4Store(ints, Cyb_I4ShiftRight(Cyb_I4Set1(-1), 28));
+        Cyb_F4Store(floors, Cyb_F4Floor(Cyb_F4Set(-1.5f, -1.0f, .5f, 2.0f)));
+        
+        if(ints[1] != 15 || floors[0] != -2.0f || floors[1] != -1.0f ||
+            floors[2] != 0.0f || floors[3] != 2.0f)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    {
+        //Test the random number generator
+        puts("Testing random numbers...");
+        Cyb_Random rng = {{1, 2, 3, 4}};
+        Cyb_Random rng2;
+        
+        //Known first output of xoshiro128**
+        if(Cyb_NextRandom(&rng) != 11520)
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        //The same seed gives the same sequence
+        Cyb_SeedRandom(&rng, 42);
+        Cyb_SeedRandom(&rng2, 42);
+        
+        for(int i = 0; i < 100; i++)
+        {
+            float f = Cyb_RandomFloat(&rng);
+            
+            if(f != Cyb_RandomFloat(&rng2) || f < 0.0f || f >= 1.0f)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+        
+        //Filled arrays are in range and centered
+        float values[1003];
+        float sum = 0.0f;
+        Cyb_FillRandom(&rng, values, 1003, -2.0f, 2.0f);
+        
+        for(int i = 0; i < 1003; i++)
+        {
+            if(values[i] < -2.0f || values[i] >= 2.0f)
+            {
+                puts("failed");
+                return 1;
+            }
+            
+            sum += values[i];
+        }
+        
+        if(fabsf(sum / 1003) > .2f)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    {
+        //Test that all widths give the same noise and that it stays in range
+        puts("Testing noise...");
+        float x[8];
+        float y[8];
+        float z[8];
+        float w[8];
+        float results[6][8];
+        
+        for(int i = 0; i < 8; i++)
+        {
+            x[i] = i * 1.37f - 4.0f;
+            y[i] = i * -.71f + 2.5f;
+            z[i] = i * .29f;
+            w[i] = 10.0f - i * 2.1f;
+        }
+        
+        Cyb_F8 wx = Cyb_F8Load(x);
+        Cyb_F8 wy = Cyb_F8Load(y);
+        Cyb_F8 wz = Cyb_F8Load(z);
+        Cyb_F8 ww = Cyb_F8Load(w);
+        Cyb_F8Store(results[0], Cyb_F8SimplexNoise2(wx, wy, 7));
+        Cyb_F8Store(results[1], Cyb_F8SimplexNoise3(wx, wy, wz, 7));
+        Cyb_F8Store(results[2], Cyb_F8SimplexNoise4(wx, wy, wz, ww, 7));
+        Cyb_F8Store(results[3], Cyb_F8ValueNoise2(wx, wy, 7));
+        Cyb_F8Store(results[4], Cyb_F8ValueNoise3(wx, wy, wz, 7));
+        Cyb_F8Store(results[5], Cyb_F8ValueNoise4(wx, wy, wz, ww, 7));
+        
+        for(int i = 0; i < 8; i++)
+        {
+            float scalar[6] = {
+                Cyb_SimplexNoise2(x[i], y[i], 7),
+                Cyb_SimplexNoise3(x[i], y[i], z[i], 7),
+                Cyb_SimplexNoise4(x[i], y[i], z[i], w[i], 7),
+                Cyb_ValueNoise2(x[i], y[i], 7),
+                Cyb_ValueNoise3(x[i], y[i], z[i], 7),
+                Cyb_ValueNoise4(x[i], y[i], z[i], w[i], 7)
+            };
+            
+            for(int j = 0; j < 6; j++)
+            {
+                if(results[j][i] != scalar[j] || fabsf(scalar[j]) > 1.0f)
+                {
+                    puts("failed");
+                    return 1;
+                }
+            }
+        }
+        
+        //Simplex noise is 0 at the lattice points and depends on the seed
+        if(Cyb_SimplexNoise2(0.0f, 0.0f, 1) != 0.0f ||
+            Cyb_SimplexNoise3(1.5f, 2.5f, 3.5f, 1) != 0.0f ||
+            Cyb_SimplexNoise3(.3f, 1.7f, -2.2f, 1) ==
+            Cyb_SimplexNoise3(.3f, 1.7f, -2.2f, 2))
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        //Noise is continuous
+        for(int i = 0; i < 1000; i++)
+        {
+            float px = i * .173f - 50.0f;
+            float py = i * .0917f;
+            
+            if(fabsf(Cyb_SimplexNoise2(px, py, 3) -
+                Cyb_SimplexNoise2(px + 1e-3f, py, 3)) > .02f ||
+                fabsf(Cyb_ValueNoise3(px, py, px, 3) -
+                Cyb_ValueNoise3(px + 1e-3f, py, px, 3)) > .02f)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+    }
+    
+    {
+        //Test fBm images and arrays against single points
+        puts("Testing fBm...");
+        Cyb_NoiseParams params;
+        Cyb_InitNoiseParams(&params);
+        params.octaves = 4;
+        params.frequency = .5f;
+        params.seed = 99;
+        float image[13 * 5];
+        Cyb_FillFBM2(&params, image, 13, 5, -2.0f, 1.0f, .25f);
+        
+        for(int i = 0; i < 13 * 5; i++)
+        {
+            float px = -2.0f + (i % 13) * .25f;
+            float py = 1.0f + (i / 13) * .25f;
+            
+            if(image[i] != Cyb_FBM2(&params, px, py) || fabsf(image[i]) > 1.0f)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+        
+        Cyb_Vec3 points[11];
+        float values[11];
+        params.type = CYB_NOISE_VALUE;
+        
+        for(int i = 0; i < 11; i++)
+        {
+            points[i].x = i * .7f;
+            points[i].y = i * -.3f;
+            points[i].z = 2.0f;
+        }
+        
+        Cyb_FBMArray3(&params, points, values, 11);
+        
+        for(int i = 0; i < 11; i++)
+        {
+            if(values[i] != Cyb_FBM3(&params, points[i].x, points[i].y,
+                points[i].z))
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+
 int main(int argc, char **argv)
 {
     //Test vectors
@@ -365,6 +1502,48 @@ int main(int argc, char **argv)
         return 1;
     }
     
+    //Test frustums
+    if(TestCybFrustums())
+    {
+        return 1;
+    }
+    
+    //Test rays
+    if(TestCybRays())
+    {
+        return 1;
+    }
+    
+    //Test bounding volume hierarchies
+    if(TestCybBVHs())
+    {
+        return 1;
+    }
+    
+    //Test broad phases
+    if(TestCybBroadPhases())
+    {
+        return 1;
+    }
+    
+    //Test fast math
+    if(TestCybFastMath())
+    {
+        return 1;
+    }
+    
+    //Test wide vectors
+    if(TestCybWideVectors())
+    {
+        return 1;
+    }
+    
+    //Test noise
+    if(TestCybNoise())
+    {
+        return 1;
+    }
+    
     puts("done");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,460 @@
+/*
+CybNav - Test Program
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CybNav.h>
+
+
+//Macros
+//===========================================================================
+#define GRID_SIZE 10
+#define WALL_X 5
+#define WALL_LENGTH 8
+#define MAX_VERTS 1024
+#define MAX_INDICES 2048
+#define MAX_POINTS 32
+#define QUERY_COUNT 200
+
+
+//Structures
+//===========================================================================
+typedef struct
+{
+    int vertCount;
+    Cyb_Vec3 verts[MAX_VERTS];
+    int indexCount;
+    unsigned int indices[MAX_INDICES];
+} TestGeometry;
+
+
+//Functions
+//===========================================================================
+static void AddQuad(TestGeometry *geom, float x0, float y0, float z0,
+    float x1, float y1, float z1, int vertical)
+{
+    //Every quad gets its own vertices, just like a mesh with split normals
+    unsigned int base = geom->vertCount;
+    Cyb_Vec3 *v = &geom->verts[base];
+    
+    if(vertical)
+    {
+        //Wall in the YZ plane at x0
+        v[0].x = x0; v[0].y = y0; v[0].z = z0;
+        v[1].x = x0; v[1].y = y1; v[1].z = z0;
+        v[2].x = x0; v[2].y = y1; v[2].z = z1;
+        v[3].x = x0; v[3].y = y0; v[3].z = z1;
+    }
+    else
+    {
+        //Floor facing up
+        v[0].x = x0; v[0].y = y0; v[0].z = z0;
+        v[1].x = x0; v[1].y = y0; v[1].z = z1;
+        v[2].x = x1; v[2].y = y0; v[2].z = z1;
+        v[3].x = x1; v[3].y = y0; v[3].z = z0;
+    }
+    
+    unsigned int quad[6] = {0, 1, 2, 0, 2, 3};
+    
+    for(int i = 0; i < 6; i++)
+    {
+        geom->indices[geom->indexCount++] = base + quad[i];
+    }
+    
+    geom->vertCount += 4;
+}
+
+
+static void BuildTestLevel(TestGeometry *geom)
+{
+    //A square floor split by a wall with a gap at the far end
+    geom->vertCount = 0;
+    geom->indexCount = 0;
+    
+    for(int x = 0; x < GRID_SIZE; x++)
+    {
+        for(int z = 0; z < GRID_SIZE; z++)
+        {
+            if(x == WALL_X && z < WALL_LENGTH)
+            {
+                continue;
+            }
+            
+            AddQuad(geom, (float)x, 0.0f, (float)z, x + 1.0f, 0.0f, z + 1.0f,
+                FALSE);
+        }
+    }
+    
+    //Both faces of the wall are too steep to walk on
+    AddQuad(geom, (float)WALL_X, 0.0f, 0.0f, 0.0f, 2.0f, (float)WALL_LENGTH,
+        TRUE);
+    AddQuad(geom, WALL_X + 1.0f, 0.0f, (float)WALL_LENGTH, 0.0f, 2.0f, 0.0f,
+        TRUE);
+    
+    //An island that can't be reached
+    AddQuad(geom, 20.0f, 0.0f, 0.0f, 22.0f, 0.0f, 2.0f, FALSE);
+}
+
+
+static Cyb_PathQuery MakeQuery(float x0, float z0, float x1, float z1,
+    Cyb_Vec3 *points)
+{
+    Cyb_PathQuery query;
+    memset(&query, 0, sizeof(query));
+    query.start.x = x0;
+    query.start.z = z0;
+    query.end.x = x1;
+    query.end.z = z1;
+    query.points = points;
+    query.maxPoints = MAX_POINTS;
+    return query;
+}
+
+
+static float PathLength(const Cyb_PathQuery *query)
+{
+    float length = 0.0f;
+    
+    for(int i = 1; i < query->pointCount; i++)
+    {
+        float dx = query->points[i].x - query->points[i - 1].x;
+        float dy = query->points[i].y - query->points[i - 1].y;
+        float dz = query->points[i].z - query->points[i - 1].z;
+        length += sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+    
+    return length;
+}
+
+
+static void PrintPath(const Cyb_PathQuery *query)
+{
+    printf("Status %i, %i points:", query->status, query->pointCount);
+    
+    for(int i = 0; i < query->pointCount; i++)
+    {
+        printf(" (%.2f, %.2f, %.2f)", query->points[i].x, query->points[i].y,
+            query->points[i].z);
+    }
+    
+    puts("");
+}
+
+
+int TestCybNavMesh(Cyb_NavMesh *nav)
+{
+    //The walls should have been dropped and the floor welded
+    puts("Testing navigation mesh construction...");
+    int floorTris = (GRID_SIZE * GRID_SIZE - WALL_LENGTH) * 2 + 2;
+    
+    if(nav->triCount != floorTris)
+    {
+        printf("Expected %i triangles but got %i.\n", floorTris, nav->triCount);
+        return 1;
+    }
+    
+    //Only the edges along the border, the wall, and the island are open
+    int openEdges = 0;
+    
+    for(int i = 0; i < nav->triCount * 3; i++)
+    {
+        openEdges += nav->neighbors[i] < 0;
+    }
+    
+    int expectedOpen = GRID_SIZE * 4 + WALL_LENGTH * 2 + 4;
+    
+    if(openEdges != expectedOpen)
+    {
+        printf("Expected %i open edges but got %i.\n", expectedOpen, openEdges);
+        return 1;
+    }
+    
+    //Locate points on and off the mesh
+    puts("Testing point location...");
+    Cyb_Vec3 point = {2.5f, 1.0f, 2.5f};
+    Cyb_Vec3 closest;
+    int tri = Cyb_FindNavTriangle(nav, &point, 2.0f, &closest);
+    
+    if(tri < 0 || fabsf(closest.x - 2.5f) > 1e-5f || fabsf(closest.y) > 1e-5f ||
+        fabsf(closest.z - 2.5f) > 1e-5f)
+    {
+        puts("Failed to locate a point above the floor.");
+        return 1;
+    }
+    
+    point.x = 50.0f;
+    
+    if(Cyb_FindNavTriangle(nav, &point, 2.0f, NULL) >= 0)
+    {
+        puts("Located a point far away from the mesh.");
+        return 1;
+    }
+    
+    return 0;
+}
+
+
+int TestCybPathfinder(Cyb_NavMesh *nav)
+{
+    //A straight path has no corners
+    puts("Testing straight paths...");
+    Cyb_Vec3 points[MAX_POINTS];
+    Cyb_PathQuery query = MakeQuery(2.5f, 0.5f, 2.5f, 9.5f, points);
+    
+    if(Cyb_FindPath(nav, &query) != CYB_PATH_FOUND || query.pointCount != 2 ||
+        fabsf(PathLength(&query) - 9.0f) > 1e-4f)
+    {
+        PrintPath(&query);
+        return 1;
+    }
+    
+    //A path around the wall turns at both corners of the gap
+    puts("Testing paths around corners...");
+    query = MakeQuery(2.5f, 2.5f, 8.5f, 2.5f, points);
+    int corners = 0;
+    
+    if(Cyb_FindPath(nav, &query) == CYB_PATH_FOUND)
+    {
+        for(int i = 0; i < query.pointCount; i++)
+        {
+            corners += fabsf(points[i].z - WALL_LENGTH) < 1e-5f &&
+                (fabsf(points[i].x - WALL_X) < 1e-5f ||
+                fabsf(points[i].x - (WALL_X + 1)) < 1e-5f);
+        }
+    }
+    
+    //The corridor follows the triangles, so the path can be a bit longer
+    float shortest = sqrtf(2.5f * 2.5f + 5.5f * 5.5f) * 2.0f + 1.0f;
+    
+    if(corners != 2 || PathLength(&query) > shortest * 1.05f)
+    {
+        PrintPath(&query);
+        return 1;
+    }
+    
+    //Paths to the island end as close to it as possible
+    puts("Testing unreachable end points...");
+    query = MakeQuery(8.5f, 0.5f, 21.0f, 1.0f, points);
+    
+    if(Cyb_FindPath(nav, &query) != CYB_PATH_PARTIAL ||
+        fabsf(points[query.pointCount - 1].x - GRID_SIZE) > 1e-5f)
+    {
+        PrintPath(&query);
+        return 1;
+    }
+    
+    //Points far away from the mesh fail
+    query = MakeQuery(50.0f, 50.0f, 2.5f, 2.5f, points);
+    
+    if(Cyb_FindPath(nav, &query) != CYB_PATH_FAILED || query.pointCount)
+    {
+        PrintPath(&query);
+        return 1;
+    }
+    
+    //Small buffers cut the path short
+    query = MakeQuery(2.5f, 2.5f, 8.5f, 2.5f, points);
+    query.maxPoints = 2;
+    
+    if(Cyb_FindPath(nav, &query) != CYB_PATH_FOUND || query.pointCount != 2)
+    {
+        PrintPath(&query);
+        return 1;
+    }
+    
+    return 0;
+}
+
+
+int TestCybPathQueue(Cyb_NavMesh *nav, Cyb_JobSystem *jobs)
+{
+    //Create random queries and the expected results
+    puts("Testing path query queues...");
+    Cyb_PathQueue *queue = Cyb_CreatePathQueue(nav, jobs);
+    Cyb_PathQuery *queries = (Cyb_PathQuery*)malloc(sizeof(Cyb_PathQuery) *
+        QUERY_COUNT);
+    Cyb_PathQuery *expected = (Cyb_PathQuery*)malloc(sizeof(Cyb_PathQuery) *
+        QUERY_COUNT);
+    Cyb_Vec3 *points = (Cyb_Vec3*)malloc(sizeof(Cyb_Vec3) * MAX_POINTS *
+        QUERY_COUNT * 2);
+    
+    if(!queue || !queries || !expected || !points)
+    {
+        puts("Out of memory.");
+        Cyb_FreeObject((Cyb_Object**)&queue);
+        free(queries);
+        free(expected);
+        free(points);
+        return 1;
+    }
+    
+    srand(1);
+    
+    for(int i = 0; i < QUERY_COUNT; i++)
+    {
+        float x0 = rand() % (GRID_SIZE * 10) / 10.0f;
+        float z0 = rand() % (GRID_SIZE * 10) / 10.0f;
+        float x1 = rand() % (GRID_SIZE * 10) / 10.0f;
+        float z1 = rand() % (GRID_SIZE * 10) / 10.0f;
+        queries[i] = MakeQuery(x0, z0, x1, z1, &points[i * MAX_POINTS]);
+        expected[i] = MakeQuery(x0, z0, x1, z1,
+            &points[(QUERY_COUNT + i) * MAX_POINTS]);
+        Cyb_FindPath(nav, &expected[i]);
+    }
+    
+    //Run every query at once and then with a tiny time budget
+    int result = 0;
+    
+    for(int pass = 0; pass < 2 && !result; pass++)
+    {
+        for(int i = 0; i < QUERY_COUNT; i++)
+        {
+            Cyb_SubmitPathQuery(queue, &queries[i]);
+        }
+        
+        float budget = pass ? 0.001f : 0.0f;
+        int updates = 0;
+        int done = 0;
+        
+        while(Cyb_GetPendingPathCount(queue))
+        {
+            int count = Cyb_UpdatePathQueue(queue, budget);
+            done += count;
+            updates++;
+            
+            //Queries must finish in the order they were submitted
+            if((done < QUERY_COUNT &&
+                queries[done].status != CYB_PATH_PENDING) ||
+                queries[done - 1].status == CYB_PATH_PENDING)
+            {
+                puts("Queries finished out of order.");
+                result = 1;
+                break;
+            }
+        }
+        
+        printf("Ran %i queries in %i updates with a budget of %.3f ms.\n",
+            done, updates, budget);
+        
+        if(!result && (done != QUERY_COUNT || (!pass && updates != 1)))
+        {
+            puts("Wrong number of updates.");
+            result = 1;
+        }
+        
+        //The results should match the ones from Cyb_FindPath
+        for(int i = 0; i < QUERY_COUNT && !result; i++)
+        {
+            if(queries[i].status != expected[i].status ||
+                queries[i].pointCount != expected[i].pointCount ||
+                memcmp(queries[i].points, expected[i].points,
+                sizeof(Cyb_Vec3) * queries[i].pointCount))
+            {
+                printf("Query %i differs from Cyb_FindPath.\n", i);
+                result = 1;
+            }
+        }
+    }
+    
+    Cyb_FreeObject((Cyb_Object**)&queue);
+    free(queries);
+    free(expected);
+    free(points);
+    return result;
+}
+
+
+int TestCybNavDB(Cyb_NavMesh *nav)
+{
+    //Save the navigation mesh to an in-memory database and load it again
+    puts("Testing asset database storage...");
+    sqlite3 *db;
+    
+    if(sqlite3_open(":memory:", &db) != SQLITE_OK)
+    {
+        puts("Failed to open a database.");
+        return 1;
+    }
+    
+    Cyb_NavMesh *loaded = NULL;
+    
+    if(Cyb_SaveNavMesh_DB(nav, db, "level") ||
+        !(loaded = Cyb_LoadNavMesh_DB(db, "level")))
+    {
+        sqlite3_close(db);
+        return 1;
+    }
+    
+    sqlite3_close(db);
+    
+    //The loaded mesh should be identical
+    int result = loaded->vertCount != nav->vertCount ||
+        loaded->triCount != nav->triCount ||
+        memcmp(loaded->verts, nav->verts, sizeof(Cyb_Vec3) * nav->vertCount) ||
+        memcmp(loaded->tris, nav->tris, sizeof(int) * 3 * nav->triCount) ||
+        memcmp(loaded->neighbors, nav->neighbors,
+        sizeof(int) * 3 * nav->triCount);
+    
+    if(result)
+    {
+        puts("The loaded navigation mesh differs.");
+    }
+    
+    Cyb_FreeObject((Cyb_Object**)&loaded);
+    return result;
+}
+
+
+//Entry Point
+//===========================================================================
+int main(int argc, char **argv)
+{
+    //Init CybObjects
+    if(Cyb_InitObjects())
+    {
+        puts("CybNav test failed.");
+        return 1;
+    }
+    
+    //Build the test level
+    static TestGeometry geom;
+    BuildTestLevel(&geom);
+    Cyb_NavMesh *nav = Cyb_CreateNavMesh(geom.vertCount, geom.verts,
+        geom.indexCount, geom.indices, 0.8f);
+    Cyb_JobSystem *jobs = Cyb_CreateJobSystem(-1);
+    
+    if(!nav || !jobs)
+    {
+        puts("CybNav test failed.");
+        Cyb_FreeObject((Cyb_Object**)&nav);
+        Cyb_FreeObject((Cyb_Object**)&jobs);
+        return 1;
+    }
+    
+    //Run navigation mesh test
+    puts("\nNavigation Mesh Test\n====================");
+    int result = TestCybNavMesh(nav) || TestCybNavDB(nav);
+    
+    //Run pathfinder test
+    if(!result)
+    {
+        puts("\nPathfinder Test\n===============");
+        result = TestCybPathfinder(nav) || TestCybPathQueue(nav, jobs);
+    }
+    
+    Cyb_FreeObject((Cyb_Object**)&nav);
+    Cyb_FreeObject((Cyb_Object**)&jobs);
+    
+    if(result)
+    {
+        puts("CybNav test failed.");
+        return 1;
+    }
+    
+    puts("\nCybNav test succeeded.");
+    return 0;
+}
\ No newline at end of file
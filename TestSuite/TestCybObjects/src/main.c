@@ -50,6 +50,13 @@ void TestQueueElmFini(void *elm)
 }
 
 
+void TestJob(void *data, int index)
+{
+    //Count how many times each job runs
+    SDL_AtomicAdd(&((SDL_atomic_t*)data)[index], 1);
+}
+
+
 int TestCybObject(void)
 {
     //Create an object
@@ -409,6 +416,57 @@ int TestCybQueue(void)
 }
 
 
+int TestCybJobs(void)
+{
+    //Create a job system
+    puts("Creating a job system...");
+    Cyb_JobSystem *jobs = Cyb_CreateJobSystem(3);
+    
+    if(!jobs)
+    {
+        puts("Failed to create a job system.");
+        return 1;
+    }
+    
+    //Run a batch of jobs several times
+    puts("Running jobs...");
+    SDL_atomic_t counts[1000];
+    
+    for(int i = 0; i < 1000; i++)
+    {
+        SDL_AtomicSet(&counts[i], 0);
+    }
+    
+    for(int i = 0; i < 10; i++)
+    {
+        Cyb_RunJobs(jobs, &TestJob, counts, 1000);
+    }
+    
+    //Run the same jobs on the calling thread
+    puts("Running jobs without a job system...");
+    Cyb_RunJobs(NULL, &TestJob, counts, 1000);
+    
+    //Each job should have run exactly once per batch
+    for(int i = 0; i < 1000; i++)
+    {
+        int n = SDL_AtomicGet(&counts[i]);
+        
+        if(n != 11)
+        {
+            printf("Job %i ran %i times, however it should have run 11 times.\n",
+                i, n);
+            Cyb_FreeObject((Cyb_Object**)&jobs);
+            return 1;
+        }
+    }
+    
+    //Free the job system
+    puts("Freeing the job system...");
+    Cyb_FreeObject((Cyb_Object**)&jobs);
+    return 0;
+}
+
+
 //Entry Point
 //===========================================================================
 int main(int argc, char **argv)
@@ -456,6 +514,15 @@ int main(int argc, char **argv)
         return 1;
     }
     
+    //Run job system test
+    puts("\nJob System Test\n===============");
+    
+    if(TestCybJobs())
+    {
+        puts("CybObjects job system test failed.");
+        return 1;
+    }
+    
     puts("\nCybObjects test succeeded.");
     return 0;
 }
\ No newline at end of file
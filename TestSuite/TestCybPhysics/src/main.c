@@ -0,0 +1,438 @@
+/*
+CybPhysics - Test Program
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CybPhysics.h>
+
+
+//Macros
+//===========================================================================
+#define PI 3.14159265f
+#define STACK_ROWS 16
+#define STACK_HEIGHT 8
+#define STEP_COUNT 300
+#define DROP_HEIGHT 0.25f
+#define DROP_GAP 0.05f
+#define TIME_STEP (1.0f / 60.0f)
+
+
+//Functions
+//===========================================================================
+static Cyb_BodyDesc MakeBody(int type, float sx, float sy, float sz, float x,
+    float y, float z, float mass)
+{
+    Cyb_BodyDesc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.shape.type = type;
+    desc.shape.size.x = sx;
+    desc.shape.size.y = sy;
+    desc.shape.size.z = sz;
+    desc.pos.x = x;
+    desc.pos.y = y;
+    desc.pos.z = z;
+    desc.rot.w = 1.0f;
+    desc.mass = mass;
+    desc.friction = 0.6f;
+    desc.restitution = 0.0f;
+    return desc;
+}
+
+
+static Cyb_PhysicsWorld *CreateStacks(Cyb_JobSystem *jobs)
+{
+    //Create a world with a static ground box
+    Cyb_PhysicsWorld *world = Cyb_CreatePhysicsWorld(jobs);
+    
+    if(!world)
+    {
+        return NULL;
+    }
+    
+    Cyb_BodyDesc ground = MakeBody(CYB_SHAPE_BOX, 50.0f, 1.0f, 50.0f, 0.0f,
+        -1.0f, 0.0f, 0.0f);
+    Cyb_AddRigidBody(world, &ground);
+    
+    //Drop a grid of box stacks with gaps between the boxes, so they collide
+    //and settle instead of starting at rest
+    for(int i = 0; i < STACK_ROWS; i++)
+    {
+        for(int j = 0; j < STACK_ROWS; j++)
+        {
+            for(int k = 0; k < STACK_HEIGHT; k++)
+            {
+                Cyb_BodyDesc box = MakeBody(CYB_SHAPE_BOX, 0.5f, 0.5f, 0.5f,
+                    (i - STACK_ROWS / 2) * 2.0f,
+                    0.5f + DROP_HEIGHT + k * (1.0f + DROP_GAP),
+                    (j - STACK_ROWS / 2) * 2.0f, 1.0f);
+                
+                if(Cyb_AddRigidBody(world, &box) < 0)
+                {
+                    Cyb_FreeObject((Cyb_Object**)&world);
+                    return NULL;
+                }
+            }
+        }
+    }
+    
+    return world;
+}
+
+
+static double SimulateStacks(Cyb_PhysicsWorld *world, int *steps,
+    double *contacts, double *awake)
+{
+    //Returns the average time in milliseconds of the steps which end with
+    //awake bodies, along with their average contact and awake body counts
+    //(once everything sleeps, a step no longer runs the solver)
+    Uint64 time = 0;
+    *steps = 0;
+    *contacts = 0.0;
+    *awake = 0.0;
+    
+    for(int i = 0; i < STEP_COUNT; i++)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        Cyb_StepPhysicsWorld(world, TIME_STEP);
+        Uint64 end = SDL_GetPerformanceCounter();
+        Cyb_PhysicsStats stats;
+        Cyb_GetPhysicsStats(world, &stats);
+        
+        if(stats.awakeCount)
+        {
+            time += end - start;
+            *contacts += stats.contactCount;
+            *awake += stats.awakeCount;
+            (*steps)++;
+        }
+    }
+    
+    if(!*steps)
+    {
+        return 0.0;
+    }
+    
+    *contacts /= *steps;
+    *awake /= *steps;
+    return time * 1000.0 / SDL_GetPerformanceFrequency() / *steps;
+}
+
+
+int TestCybCollide(void)
+{
+    Cyb_Vec4 identity = {0.0f, 0.0f, 0.0f, 1.0f};
+    Cyb_Contact contacts[CYB_MAX_CONTACTS];
+    
+    //Test a box resting on a box
+    {
+        puts("Testing box-box contacts...");
+        Cyb_Shape box = {CYB_SHAPE_BOX, {0.5f, 0.5f, 0.5f}};
+        Cyb_Vec3 a = {0.0f, 0.0f, 0.0f};
+        Cyb_Vec3 b = {0.1f, 0.99f, 0.0f};
+        int count = Cyb_CollideShapes(&box, &a, &identity, &box, &b,
+            &identity, 0.0f, contacts);
+        
+        if(count != 4)
+        {
+            printf("Got %i contacts, however there should have been 4.\n",
+                count);
+            return 1;
+        }
+        
+        for(int i = 0; i < count; i++)
+        {
+            if(fabsf(contacts[i].normal.y - 1.0f) > 1e-5f ||
+                fabsf(contacts[i].depth - 0.01f) > 1e-5f)
+            {
+                puts("failed");
+                return 1;
+            }
+        }
+    }
+    
+    //Test a sphere touching a box from below
+    {
+        puts("Testing sphere-box contacts...");
+        Cyb_Shape sphere = {CYB_SHAPE_SPHERE, {0.5f, 0.0f, 0.0f}};
+        Cyb_Shape box = {CYB_SHAPE_BOX, {1.0f, 1.0f, 1.0f}};
+        Cyb_Vec3 a = {0.0f, -1.4f, 0.0f};
+        Cyb_Vec3 b = {0.0f, 0.0f, 0.0f};
+        int count = Cyb_CollideShapes(&sphere, &a, &identity, &box, &b,
+            &identity, 0.0f, contacts);
+        
+        if(count != 1 || fabsf(contacts[0].normal.y - 1.0f) > 1e-5f ||
+            fabsf(contacts[0].depth - 0.1f) > 1e-5f)
+        {
+            puts("failed");
+            return 1;
+        }
+        
+        //Test the order of the shapes
+        count = Cyb_CollideShapes(&box, &b, &identity, &sphere, &a,
+            &identity, 0.0f, contacts);
+        
+        if(count != 1 || fabsf(contacts[0].normal.y + 1.0f) > 1e-5f)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    //Test a capsule lying on a box
+    {
+        puts("Testing capsule-box contacts...");
+        Cyb_Shape capsule = {CYB_SHAPE_CAPSULE, {0.25f, 1.0f, 0.0f}};
+        Cyb_Shape box = {CYB_SHAPE_BOX, {2.0f, 0.5f, 2.0f}};
+        Cyb_Vec4 rot = {0.0f, 0.0f, sinf(0.25f * PI), cosf(0.25f * PI)};
+        Cyb_Vec3 a = {0.0f, 0.74f, 0.0f};
+        Cyb_Vec3 b = {0.0f, 0.0f, 0.0f};
+        int count = Cyb_CollideShapes(&capsule, &a, &rot, &box, &b, &identity,
+            0.0f, contacts);
+        
+        if(count != 2 || fabsf(contacts[0].normal.y + 1.0f) > 1e-5f ||
+            fabsf(contacts[0].depth - 0.01f) > 1e-5f)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    //Test crossed capsules
+    {
+        puts("Testing capsule-capsule contacts...");
+        Cyb_Shape capsule = {CYB_SHAPE_CAPSULE, {0.25f, 1.0f, 0.0f}};
+        Cyb_Vec4 rotA = {0.0f, 0.0f, sinf(0.25f * PI),
+            cosf(0.25f * PI)};
+        Cyb_Vec4 rotB = {sinf(0.25f * PI), 0.0f, 0.0f,
+            cosf(0.25f * PI)};
+        Cyb_Vec3 a = {0.0f, 0.0f, 0.0f};
+        Cyb_Vec3 b = {0.0f, 0.4f, 0.0f};
+        int count = Cyb_CollideShapes(&capsule, &a, &rotA, &capsule, &b,
+            &rotB, 0.0f, contacts);
+        
+        if(count != 1 || fabsf(contacts[0].normal.y - 1.0f) > 1e-5f ||
+            fabsf(contacts[0].depth - 0.1f) > 1e-5f)
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    //Test separated shapes
+    {
+        puts("Testing separated shapes...");
+        Cyb_Shape box = {CYB_SHAPE_BOX, {0.5f, 0.5f, 0.5f}};
+        Cyb_Vec4 rot = {0.0f, sinf(0.125f * PI), 0.0f,
+            cosf(0.125f * PI)};
+        Cyb_Vec3 a = {0.0f, 0.0f, 0.0f};
+        Cyb_Vec3 b = {1.0f, 1.1f, 0.0f};
+        
+        if(Cyb_CollideShapes(&box, &a, &identity, &box, &b, &rot, 0.0f,
+            contacts))
+        {
+            puts("failed");
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+
+int TestCybPhysicsWorld(Cyb_JobSystem *jobs)
+{
+    //Drop a sphere and a capsule onto the ground
+    {
+        puts("Testing falling bodies...");
+        Cyb_PhysicsWorld *world = Cyb_CreatePhysicsWorld(jobs);
+        
+        if(!world)
+        {
+            puts("Failed to create a physics world.");
+            return 1;
+        }
+        
+        Cyb_BodyDesc ground = MakeBody(CYB_SHAPE_BOX, 10.0f, 1.0f, 10.0f, 0.0f,
+            -1.0f, 0.0f, 0.0f);
+        Cyb_BodyDesc sphere = MakeBody(CYB_SHAPE_SPHERE, 0.5f, 0.0f, 0.0f,
+            -2.0f, 3.0f, 0.0f, 1.0f);
+        Cyb_BodyDesc capsule = MakeBody(CYB_SHAPE_CAPSULE, 0.25f, 0.5f, 0.0f,
+            2.0f, 3.0f, 0.0f, 1.0f);
+        capsule.rot.z = sinf(0.15f);
+        capsule.rot.w = cosf(0.15f);
+        Cyb_AddRigidBody(world, &ground);
+        int sphereID = Cyb_AddRigidBody(world, &sphere);
+        int capsuleID = Cyb_AddRigidBody(world, &capsule);
+        
+        for(int i = 0; i < STEP_COUNT; i++)
+        {
+            Cyb_StepPhysicsWorld(world, TIME_STEP);
+        }
+        
+        //The capsule should have fallen over
+        const Cyb_Vec3 *spherePos = Cyb_GetBodyPos(world, sphereID);
+        const Cyb_Vec3 *capsulePos = Cyb_GetBodyPos(world, capsuleID);
+        
+        if(fabsf(spherePos->y - 0.5f) > 0.02f ||
+            fabsf(capsulePos->y - 0.25f) > 0.02f ||
+            !Cyb_IsBodyAsleep(world, sphereID) ||
+            !Cyb_IsBodyAsleep(world, capsuleID))
+        {
+            printf("The sphere is at %f and the capsule at %f.\n",
+                spherePos->y, capsulePos->y);
+            Cyb_FreeObject((Cyb_Object**)&world);
+            return 1;
+        }
+        
+        //Knock the sphere over
+        puts("Testing wake up...");
+        Cyb_Vec3 impulse = {2.0f, 0.0f, 0.0f};
+        Cyb_ApplyBodyImpulse(world, sphereID, &impulse, spherePos);
+        Cyb_StepPhysicsWorld(world, TIME_STEP);
+        
+        if(Cyb_IsBodyAsleep(world, sphereID) || spherePos->x <= -2.0f)
+        {
+            puts("failed");
+            Cyb_FreeObject((Cyb_Object**)&world);
+            return 1;
+        }
+        
+        Cyb_FreeObject((Cyb_Object**)&world);
+    }
+    
+    //Simulate stacks of boxes with and without the job system
+    {
+        puts("Testing box stacks...");
+        Cyb_PhysicsWorld *serial = CreateStacks(NULL);
+        Cyb_PhysicsWorld *parallel = CreateStacks(jobs);
+        
+        if(!serial || !parallel)
+        {
+            puts("Failed to create a physics world.");
+            Cyb_FreeObject((Cyb_Object**)&serial);
+            Cyb_FreeObject((Cyb_Object**)&parallel);
+            return 1;
+        }
+        
+        int steps;
+        double contacts;
+        double awake;
+        double serialTime = SimulateStacks(serial, &steps, &contacts, &awake);
+        double parallelTime = SimulateStacks(parallel, &steps, &contacts,
+            &awake);
+        Cyb_PhysicsStats stats;
+        Cyb_GetPhysicsStats(parallel, &stats);
+        printf("%i bodies, %i active steps with %.0f contacts and %.0f awake on average: %.3f ms per step serial, %.3f ms per step with %i worker threads\n",
+            stats.bodyCount, steps, contacts, awake, serialTime, parallelTime,
+            jobs->threadCount);
+        
+        //The timed steps must have exercised the solver
+        if(!steps || contacts < 1.0)
+        {
+            puts("The box stacks never had any active contacts.");
+            Cyb_FreeObject((Cyb_Object**)&serial);
+            Cyb_FreeObject((Cyb_Object**)&parallel);
+            return 1;
+        }
+        
+        //Every box should still be in its stack
+        int result = 0;
+        
+        for(int i = 1; i < stats.bodyCount; i++)
+        {
+            const Cyb_Vec3 *pos = Cyb_GetBodyPos(parallel, i);
+            int row = (i - 1) / (STACK_ROWS * STACK_HEIGHT);
+            int col = (i - 1) / STACK_HEIGHT % STACK_ROWS;
+            int level = (i - 1) % STACK_HEIGHT;
+            
+            if(fabsf(pos->x - (row - STACK_ROWS / 2) * 2.0f) > 0.05f ||
+                fabsf(pos->y - (0.5f + level)) > 0.05f ||
+                fabsf(pos->z - (col - STACK_ROWS / 2) * 2.0f) > 0.05f)
+            {
+                printf("Box %i is at (%f, %f, %f).\n", i, pos->x, pos->y,
+                    pos->z);
+                result = 1;
+                break;
+            }
+        }
+        
+        //Islands are solved independently, so threads must not change the result
+        for(int i = 0; i < stats.bodyCount && !result; i++)
+        {
+            if(memcmp(Cyb_GetBodyPos(serial, i), Cyb_GetBodyPos(parallel, i),
+                sizeof(Cyb_Vec3)))
+            {
+                printf("Body %i differs between the serial and parallel worlds.\n",
+                    i);
+                result = 1;
+            }
+        }
+        
+        //The stacks should be asleep by now
+        if(!result && stats.awakeCount)
+        {
+            printf("%i bodies are still awake.\n", stats.awakeCount);
+            result = 1;
+        }
+        
+        Cyb_FreeObject((Cyb_Object**)&serial);
+        Cyb_FreeObject((Cyb_Object**)&parallel);
+        
+        if(result)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+
+//Entry Point
+//===========================================================================
+int main(int argc, char **argv)
+{
+    //Init CybObjects
+    if(Cyb_InitObjects())
+    {
+        puts("CybPhysics test failed.");
+        return 1;
+    }
+    
+    //Create a job system
+    Cyb_JobSystem *jobs = Cyb_CreateJobSystem(-1);
+    
+    if(!jobs)
+    {
+        puts("CybPhysics test failed.");
+        return 1;
+    }
+    
+    //Run collision test
+    puts("\nCollision Test\n==============");
+    
+    if(TestCybCollide())
+    {
+        puts("CybPhysics collision test failed.");
+        Cyb_FreeObject((Cyb_Object**)&jobs);
+        return 1;
+    }
+    
+    //Run physics world test
+    puts("\nPhysics World Test\n==================");
+    
+    if(TestCybPhysicsWorld(jobs))
+    {
+        puts("CybPhysics physics world test failed.");
+        Cyb_FreeObject((Cyb_Object**)&jobs);
+        return 1;
+    }
+    
+    Cyb_FreeObject((Cyb_Object**)&jobs);
+    puts("\nCybPhysics test succeeded.");
+    return 0;
+}
\ No newline at end of file
@@ -90,6 +90,8 @@ Cyb_Pose *pyramidPose = NULL;
 
 Cyb_Animation *pyramidWiggleAnim = NULL;
 
+Cyb_RenderQueue *renderQueue = NULL;
+
 Cyb_Mat4 m[100];
 Cyb_Mat4 p;
 Cyb_Mat4 n[100];
@@ -161,6 +163,114 @@ void Quit(void)
 }
 
 
+int CompareTriangles(const void *a, const void *b)
+{
+    //Compare 2 triangles index by index
+    const unsigned int *triA = (const unsigned int*)a;
+    const unsigned int *triB = (const unsigned int*)b;
+    
+    for(int i = 0; i < 3; i++)
+    {
+        if(triA[i] != triB[i])
+        {
+            return triA[i] < triB[i] ? -1 : 1;
+        }
+    }
+    
+    return 0;
+}
+
+
+void NormalizeTriangles(unsigned int *indices, int triCount)
+{
+    //Rotate each triangle so it starts with its lowest index (this keeps the
+    //winding), then sort the triangles
+    for(int i = 0; i < triCount; i++)
+    {
+        unsigned int *tri = &indices[i * 3];
+        
+        while(tri[0] > tri[1] || tri[0] > tri[2])
+        {
+            unsigned int first = tri[0];
+            tri[0] = tri[1];
+            tri[1] = tri[2];
+            tri[2] = first;
+        }
+    }
+    
+    qsort(indices, triCount, sizeof(unsigned int) * 3, &CompareTriangles);
+}
+
+
+int TestMeshOptimizer(void)
+{
+    //Build a degenerate triangle followed by a 4x4 quad grid and a separate
+    //quad, so the first cluster doesn't start with a cold cache miss
+    Cyb_Vec3 verts[29];
+    unsigned int indices[3 + 32 * 3 + 2 * 3];
+    unsigned int expected[sizeof(indices) / sizeof(unsigned int)];
+    int indexCount = 0;
+    indices[indexCount++] = 0;
+    indices[indexCount++] = 0;
+    indices[indexCount++] = 1;
+    
+    for(int i = 0; i < 25; i++)
+    {
+        verts[i].x = (float)(i % 5);
+        verts[i].y = (float)(i / 5);
+        verts[i].z = 0.0f;
+    }
+    
+    for(int y = 0; y < 4; y++)
+    {
+        for(int x = 0; x < 4; x++)
+        {
+            unsigned int v = y * 5 + x;
+            indices[indexCount++] = v;
+            indices[indexCount++] = v + 1;
+            indices[indexCount++] = v + 6;
+            indices[indexCount++] = v;
+            indices[indexCount++] = v + 6;
+            indices[indexCount++] = v + 5;
+        }
+    }
+    
+    for(int i = 0; i < 4; i++)
+    {
+        verts[25 + i].x = (float)(i & 1);
+        verts[25 + i].y = (float)(i / 2);
+        verts[25 + i].z = 10.0f;
+    }
+    
+    indices[indexCount++] = 25;
+    indices[indexCount++] = 26;
+    indices[indexCount++] = 28;
+    indices[indexCount++] = 25;
+    indices[indexCount++] = 28;
+    indices[indexCount++] = 27;
+    
+    //The optimized indices must contain the same triangles
+    memcpy(expected, indices, sizeof(indices));
+    
+    if(Cyb_OptimizeMeshIndices(indices, indexCount, verts, 29))
+    {
+        return 1;
+    }
+    
+    NormalizeTriangles(indices, indexCount / 3);
+    NormalizeTriangles(expected, indexCount / 3);
+    
+    if(memcmp(indices, expected, sizeof(indices)))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s",
+            "The mesh optimizer lost or duplicated triangles.");
+        return 1;
+    }
+    
+    return 0;
+}
+
+
 int Init(void)
 {
     //Initialize SDL2
@@ -310,6 +420,14 @@ int Init(void)
     Cyb_SetCameraPos(cam, 0.0f, 2.0f, 5.0f);
     Cyb_SetCameraRot(cam, -20.0f, 0.0f, 0.0f);
     
+    //Create render queue
+    renderQueue = Cyb_CreateRenderQueue();
+    
+    if(!renderQueue)
+    {
+        return 1;
+    }
+    
     //Load shaders
     rainbowShader = Cyb_LoadShader(renderer, "data/shaders/rainbow.glsl");
     textureShader = Cyb_LoadShader(renderer, "data/shaders/texture.glsl");
@@ -544,8 +662,8 @@ void DrawTriangle(void)
     Cyb_Invert(&n[0], &tmp);
     
     //Enable depth testing and disable face culling
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
+    Cyb_SetRenderCap(renderer, GL_DEPTH_TEST, TRUE);
+    Cyb_SetRenderCap(renderer, GL_CULL_FACE, FALSE);
     
     //Textured?
     if(useTextures)
@@ -554,10 +672,8 @@ void DrawTriangle(void)
         Cyb_SelectShader(renderer, textureShader);
     
         //Set matrices
-        Cyb_SetMatrix(renderer, textureShader, "m", &m[0]);
         Cyb_SetMatrix(renderer, textureShader, "v", Cyb_GetViewMatrix(cam));
         Cyb_SetMatrix(renderer, textureShader, "p", &p);
-        Cyb_SetMatrix(renderer, textureShader, "n", &n[0]);
         
         //Set lights
         Cyb_SetVec3(renderer, textureShader, "camPos", Cyb_GetCameraPos(cam));
@@ -579,7 +695,7 @@ void DrawTriangle(void)
         Cyb_SetTexture(renderer, textureShader, "tex1", 1);
     
         //Draw the triangle
-        Cyb_DrawMesh(renderer, texturedTriangle);
+        Cyb_DrawMeshTransformed(renderer, texturedTriangle, &m[0], &n[0]);
     }
     //Rainbow?
     else
@@ -588,10 +704,8 @@ void DrawTriangle(void)
         Cyb_SelectShader(renderer, rainbowShader);
     
         //Set matrices
-        Cyb_SetMatrix(renderer, rainbowShader, "m", &m[0]);
         Cyb_SetMatrix(renderer, rainbowShader, "v", Cyb_GetViewMatrix(cam));
         Cyb_SetMatrix(renderer, rainbowShader, "p", &p);
-        Cyb_SetMatrix(renderer, rainbowShader, "n", &n[0]);
         
         //Set lights
         Cyb_SetVec3(renderer, rainbowShader, "camPos", Cyb_GetCameraPos(cam));
@@ -607,7 +721,7 @@ void DrawTriangle(void)
         Cyb_SetFloat(renderer, rainbowShader, "mat.shininess", defaultMat->shininess);
     
         //Draw the triangle
-        Cyb_DrawMesh(renderer, rainbowTriangle);
+        Cyb_DrawMeshTransformed(renderer, rainbowTriangle, &m[0], &n[0]);
     }
 }
 
@@ -627,8 +741,8 @@ void DrawCube(void)
     Cyb_Invert(&n[0], &tmp);
     
     //Enable depth testing and disable face culling
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
+    Cyb_SetRenderCap(renderer, GL_DEPTH_TEST, TRUE);
+    Cyb_SetRenderCap(renderer, GL_CULL_FACE, FALSE);
     
     //Textured?
     if(useTextures)
@@ -637,10 +751,8 @@ void DrawCube(void)
         Cyb_SelectShader(renderer, textureShader);
     
         //Set matrices
-        Cyb_SetMatrix(renderer, textureShader, "m", &m[0]);
         Cyb_SetMatrix(renderer, textureShader, "v", Cyb_GetViewMatrix(cam));
         Cyb_SetMatrix(renderer, textureShader, "p", &p);
-        Cyb_SetMatrix(renderer, textureShader, "n", &n[0]);
         
         //Set lights
         Cyb_SetVec3(renderer, textureShader, "camPos", Cyb_GetCameraPos(cam));
@@ -662,7 +774,7 @@ void DrawCube(void)
         Cyb_SetTexture(renderer, textureShader, "tex1", 1);
     
         //Draw the cube
-        Cyb_DrawMesh(renderer, texturedCube);
+        Cyb_DrawMeshTransformed(renderer, texturedCube, &m[0], &n[0]);
     }
     //Rainbow?
     else
@@ -671,10 +783,8 @@ void DrawCube(void)
         Cyb_SelectShader(renderer, rainbowShader);
     
         //Set matrices
-        Cyb_SetMatrix(renderer, rainbowShader, "m", &m[0]);
         Cyb_SetMatrix(renderer, rainbowShader, "v", Cyb_GetViewMatrix(cam));
         Cyb_SetMatrix(renderer, rainbowShader, "p", &p);
-        Cyb_SetMatrix(renderer, rainbowShader, "n", &n[0]);
         
         //Set lights
         Cyb_SetVec3(renderer, rainbowShader, "camPos", Cyb_GetCameraPos(cam));
@@ -690,7 +800,7 @@ void DrawCube(void)
         Cyb_SetFloat(renderer, rainbowShader, "mat.shininess", defaultMat->shininess);
     
         //Draw the cube
-        Cyb_DrawMesh(renderer, rainbowCube);
+        Cyb_DrawMeshTransformed(renderer, rainbowCube, &m[0], &n[0]);
     }
 }
 
@@ -708,11 +818,6 @@ void DrawPyramids(int count)
         Cyb_QuatFromAxisAndAngle(&rotY, 0.0f, 1.0f, 0.0f, 0.0f); //angle);
         Cyb_QuatToMatrix(&r, &rotY);
         Cyb_MulMat4(&m[i], &t, &r);
-    
-        //Update normal matrix
-        Cyb_Mat4 tmp;
-        Cyb_Transpose(&tmp, &m[i]);
-        Cyb_Invert(&n[i], &tmp);
     }
     
     //Update pose
@@ -730,17 +835,15 @@ void DrawPyramids(int count)
     }
     
     //Enable depth testing and face culling
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_CULL_FACE);
+    Cyb_SetRenderCap(renderer, GL_DEPTH_TEST, TRUE);
+    Cyb_SetRenderCap(renderer, GL_CULL_FACE, TRUE);
     
     //Select shader
     Cyb_SelectShader(renderer, normMapShader);
     
     //Set matrices
-    //Cyb_SetMatrix(renderer, normMapShader, "m", &m[0]);
     Cyb_SetMatrix(renderer, normMapShader, "v", Cyb_GetViewMatrix(cam));
     Cyb_SetMatrix(renderer, normMapShader, "p", &p);
-    //Cyb_SetMatrix(renderer, normMapShader, "n", &n[0]);
     
     //Set lights
     Cyb_SetVec3(renderer, normMapShader, "camPos", Cyb_GetCameraPos(cam));
@@ -749,28 +852,30 @@ void DrawPyramids(int count)
     Cyb_SetVec3(renderer, normMapShader, "light.diffuse", &light->diffuse);
     Cyb_SetVec3(renderer, normMapShader, "light.specular", &light->specular);
     
-    //Set material
-    Cyb_SetVec3(renderer, normMapShader, "mat.ambient", &pyramidMat->ambient);
-    Cyb_SetVec3(renderer, normMapShader, "mat.diffuse", &pyramidMat->diffuse);
-    Cyb_SetVec3(renderer, normMapShader, "mat.specular", &pyramidMat->specular);
-    Cyb_SetFloat(renderer, normMapShader, "mat.shininess", pyramidMat->shininess);
-    
-    //Set textures
-    Cyb_SelectTexture(renderer, sandstoneBricksTexture, 0);
-    Cyb_SetTexture(renderer, normMapShader, "tex0", 0);
-    Cyb_SelectTexture(renderer, pyramidNormMapTexture, 1);
-    Cyb_SetTexture(renderer, normMapShader, "tex1", 1);
+    //Submit the pyramid(s)
+    Cyb_DrawItem item;
+    memset(&item, 0, sizeof(Cyb_DrawItem));
+    item.mesh = pyramid;
+    item.shader = normMapShader;
+    item.material = pyramidMat;
+    item.textures[0] = sandstoneBricksTexture;
+    item.textures[1] = pyramidNormMapTexture;
+    item.pose = pyramidPose;
+    const Cyb_Vec3 *camPos = Cyb_GetCameraPos(cam);
     
-    //Select pose
-    Cyb_SelectPose(renderer, normMapShader, pyramidPose);
-    
-    //Draw the pyramid(s)
     for(int i = 0; i < count; i++)
     {
-        Cyb_SetMatrix(renderer, normMapShader, "m", &m[i]);
-        Cyb_SetMatrix(renderer, normMapShader, "n", &n[i]);
-        Cyb_DrawMesh(renderer, pyramid);
+        //The squared distance sorts the same as the distance
+        float dx = m[i].d - camPos->x;
+        float dy = m[i].h - camPos->y;
+        float dz = m[i].l - camPos->z;
+        item.model = m[i];
+        item.depth = dx * dx + dy * dy + dz * dz;
+        Cyb_SubmitDraw(renderQueue, &item);
     }
+    
+    //Draw the pyramid(s)
+    Cyb_FlushRenderQueue(renderer, renderQueue);
 }
 
 
@@ -778,6 +883,12 @@ void DrawPyramids(int count)
 //===========================================================================
 int main(int argc, char **argv)
 {
+    //Test the mesh optimizer
+    if(TestMeshOptimizer())
+    {
+        return 1;
+    }
+    
     //Initialize
     if(Init())
     {
@@ -882,6 +993,20 @@ int main(int argc, char **argv)
                 case SDLK_t:
                     useTextures = !useTextures;
                     break;
+                    
+                    //P key (log state cache stats of the last frame)?
+                case SDLK_p:
+                {
+                    Cyb_StateCacheStats stats;
+                    Cyb_GetStateCacheStats(renderer, &stats);
+                    SDL_Log("State cache: programs %d/%d, buffers %d/%d, "
+                        "VAOs %d/%d, textures %d/%d, caps %d/%d (bound/skipped)",
+                        stats.programBinds, stats.programSkips, 
+                        stats.bufferBinds, stats.bufferSkips, stats.vaoBinds,
+                        stats.vaoSkips, stats.textureBinds, stats.textureSkips,
+                        stats.capChanges, stats.capSkips);
+                    break;
+                }
                 }
             }
             //Key up?
@@ -921,8 +1046,9 @@ int main(int argc, char **argv)
             }
         }
         
-        //Clear the window
+        //Clear the window and reset the state cache stats
         Cyb_RenderClear(renderer);
+        Cyb_ResetStateCacheStats(renderer);
         
         //Update camera
         Cyb_MoveCamera(cam, playerVelocity.z);
@@ -0,0 +1,317 @@
+/*
+CybScene - Test Program
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CybScene.h>
+
+
+//Macros
+//===========================================================================
+#define TREE_COUNT 64
+#define TREE_DEPTH 4
+
+
+//Functions
+//===========================================================================
+static void MakeTransform(Cyb_Mat4 *m, float x, float y, float z, float angle)
+{
+    //Rotate about the Y axis and move
+    Cyb_Vec4 rot;
+    Cyb_QuatFromAxisAndAngle(&rot, 0.0f, 1.0f, 0.0f, angle);
+    Cyb_QuatToMatrix(m, &rot);
+    m->d = x;
+    m->h = y;
+    m->l = z;
+}
+
+
+static int MatricesEqual(const Cyb_Mat4 *a, const Cyb_Mat4 *b)
+{
+    const float *fa = &a->a;
+    const float *fb = &b->a;
+    
+    for(int i = 0; i < 16; i++)
+    {
+        if(fabsf(fa[i] - fb[i]) > 1e-4f)
+        {
+            return FALSE;
+        }
+    }
+    
+    return TRUE;
+}
+
+
+static int CheckNode(Cyb_SceneGraph *graph, int id)
+{
+    //Rebuild the world and normal matrices by hand like the apps used to
+    Cyb_Mat4 world = *Cyb_GetSceneNodeTransform(graph, id);
+    
+    for(int p = Cyb_GetSceneNodeParent(graph, id); p >= 0;
+        p = Cyb_GetSceneNodeParent(graph, p))
+    {
+        Cyb_Mat4 tmp = world;
+        Cyb_MulMat4(&world, Cyb_GetSceneNodeTransform(graph, p), &tmp);
+    }
+    
+    Cyb_Mat4 transposed;
+    Cyb_Mat4 normal;
+    Cyb_Transpose(&transposed, &world);
+    Cyb_Invert(&normal, &transposed);
+    
+    if(!MatricesEqual(&world, Cyb_GetSceneNodeWorld(graph, id)) ||
+        !MatricesEqual(&normal, Cyb_GetSceneNodeNormal(graph, id)))
+    {
+        printf("Node %i has the wrong world or normal matrix.\n", id);
+        return 1;
+    }
+    
+    return 0;
+}
+
+
+static int CheckNodes(Cyb_SceneGraph *graph, const int *ids, int count)
+{
+    for(int i = 0; i < count; i++)
+    {
+        if(ids[i] >= 0 && CheckNode(graph, ids[i]))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+
+static int ExpectUpdated(Cyb_SceneGraph *graph, int expected)
+{
+    int updated = Cyb_UpdateSceneGraph(graph);
+    
+    if(updated != expected)
+    {
+        printf("Expected %i updated nodes but got %i.\n", expected, updated);
+        return 1;
+    }
+    
+    return 0;
+}
+
+
+int TestCybSceneHierarchy(void)
+{
+    //Build a root with a chain of 3 nodes and a second root
+    puts("Testing world transforms...");
+    Cyb_SceneGraph *graph = Cyb_CreateSceneGraph(NULL);
+    
+    if(!graph)
+    {
+        return 1;
+    }
+    
+    Cyb_Mat4 m;
+    int ids[6];
+    MakeTransform(&m, 1.0f, 0.0f, 0.0f, 0.5f);
+    ids[0] = Cyb_AddSceneNode(graph, -1, &m);
+    MakeTransform(&m, 0.0f, 2.0f, 0.0f, 0.25f);
+    ids[1] = Cyb_AddSceneNode(graph, ids[0], &m);
+    ids[2] = Cyb_AddSceneNode(graph, ids[1], &m);
+    ids[3] = Cyb_AddSceneNode(graph, -1, NULL);
+    
+    //Insert a node into the middle of the first subtree
+    MakeTransform(&m, 0.0f, 0.0f, -3.0f, 1.0f);
+    ids[4] = Cyb_AddSceneNode(graph, ids[0], &m);
+    ids[5] = Cyb_AddSceneNode(graph, ids[3], &m);
+    
+    if(Cyb_GetSceneNodeCount(graph) != 6 || ExpectUpdated(graph, 6) ||
+        CheckNodes(graph, ids, 6))
+    {
+        Cyb_FreeObject((Cyb_Object**)&graph);
+        return 1;
+    }
+    
+    //Nothing changed, so nothing should be recalculated
+    puts("Testing dirty propagation...");
+    
+    if(ExpectUpdated(graph, 0))
+    {
+        Cyb_FreeObject((Cyb_Object**)&graph);
+        return 1;
+    }
+    
+    //Changing a node only updates it and its descendants
+    Cyb_Vec3 pos = {0.0f, 1.0f, 0.0f};
+    Cyb_Vec4 rot = {0.0f, 0.0f, 0.0f, 1.0f};
+    Cyb_Vec3 scale = {2.0f, 2.0f, 2.0f};
+    Cyb_SetSceneNodeTRS(graph, ids[1], &pos, &rot, &scale);
+    
+    if(ExpectUpdated(graph, 2) || CheckNodes(graph, ids, 6))
+    {
+        Cyb_FreeObject((Cyb_Object**)&graph);
+        return 1;
+    }
+    
+    //Moving a subtree keeps its local transforms
+    puts("Testing reparenting...");
+    
+    if(Cyb_SetSceneNodeParent(graph, ids[0], ids[2]) != CYB_ERROR ||
+        Cyb_SetSceneNodeParent(graph, ids[1], ids[5]) ||
+        Cyb_GetSceneNodeParent(graph, ids[2]) != ids[1] ||
+        Cyb_GetSceneNodeParent(graph, ids[1]) != ids[5] ||
+        ExpectUpdated(graph, 2) || CheckNodes(graph, ids, 6))
+    {
+        Cyb_FreeObject((Cyb_Object**)&graph);
+        return 1;
+    }
+    
+    if(Cyb_SetSceneNodeParent(graph, ids[3], ids[0]) ||
+        Cyb_GetSceneNodeParent(graph, ids[3]) != ids[0] ||
+        ExpectUpdated(graph, 4) || CheckNodes(graph, ids, 6))
+    {
+        Cyb_FreeObject((Cyb_Object**)&graph);
+        return 1;
+    }
+    
+    //Removing a node removes its descendants and frees their IDs
+    puts("Testing node removal...");
+    Cyb_RemoveSceneNode(graph, ids[5]);
+    ids[1] = ids[2] = ids[5] = -1;
+    int id = Cyb_AddSceneNode(graph, ids[4], NULL);
+    
+    if(Cyb_GetSceneNodeCount(graph) != 4 || id < 0 || id >= 6 ||
+        ExpectUpdated(graph, 1) || CheckNodes(graph, ids, 6) ||
+        CheckNode(graph, id))
+    {
+        Cyb_FreeObject((Cyb_Object**)&graph);
+        return 1;
+    }
+    
+    Cyb_FreeObject((Cyb_Object**)&graph);
+    return 0;
+}
+
+
+static int BuildForest(Cyb_SceneGraph *graph, int *ids)
+{
+    //Build many small trees, each a chain of nodes
+    int count = 0;
+    
+    for(int i = 0; i < TREE_COUNT; i++)
+    {
+        int parent = -1;
+        
+        for(int j = 0; j < TREE_DEPTH; j++)
+        {
+            Cyb_Mat4 m;
+            MakeTransform(&m, (float)i, (float)j, 0.0f, i * 0.1f + j * 0.2f);
+            parent = ids[count++] = Cyb_AddSceneNode(graph, parent, &m);
+            
+            if(parent < 0)
+            {
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+
+int TestCybSceneJobs(Cyb_JobSystem *jobs)
+{
+    //Update the same scene with and without a job system
+    puts("Testing parallel updates...");
+    static int ids[TREE_COUNT * TREE_DEPTH];
+    Cyb_SceneGraph *serial = Cyb_CreateSceneGraph(NULL);
+    Cyb_SceneGraph *parallel = Cyb_CreateSceneGraph(jobs);
+    
+    if(!serial || !parallel || BuildForest(serial, ids) ||
+        BuildForest(parallel, ids))
+    {
+        Cyb_FreeObject((Cyb_Object**)&serial);
+        Cyb_FreeObject((Cyb_Object**)&parallel);
+        return 1;
+    }
+    
+    int result = 0;
+    
+    for(int frame = 0; frame < 4 && !result; frame++)
+    {
+        //Animate the roots of every other tree
+        for(int i = frame & 1; i < TREE_COUNT; i += 2)
+        {
+            Cyb_Mat4 m;
+            MakeTransform(&m, (float)i, 0.0f, (float)frame, frame * 0.3f);
+            Cyb_SetSceneNodeTransform(serial, ids[i * TREE_DEPTH], &m);
+            Cyb_SetSceneNodeTransform(parallel, ids[i * TREE_DEPTH], &m);
+        }
+        
+        int a = Cyb_UpdateSceneGraph(serial);
+        int b = Cyb_UpdateSceneGraph(parallel);
+        int expected = frame ? TREE_COUNT / 2 * TREE_DEPTH :
+            TREE_COUNT * TREE_DEPTH;
+        
+        if(a != expected || b != expected)
+        {
+            printf("Expected %i updated nodes but got %i and %i.\n", expected,
+                a, b);
+            result = 1;
+        }
+        
+        for(int i = 0; i < TREE_COUNT * TREE_DEPTH && !result; i++)
+        {
+            if(memcmp(Cyb_GetSceneNodeWorld(serial, ids[i]),
+                Cyb_GetSceneNodeWorld(parallel, ids[i]), sizeof(Cyb_Mat4)) ||
+                CheckNode(parallel, ids[i]))
+            {
+                printf("Node %i differs between serial and parallel updates.\n",
+                    ids[i]);
+                result = 1;
+            }
+        }
+    }
+    
+    Cyb_FreeObject((Cyb_Object**)&serial);
+    Cyb_FreeObject((Cyb_Object**)&parallel);
+    return result;
+}
+
+
+//Entry Point
+//===========================================================================
+int main(int argc, char **argv)
+{
+    //Init CybObjects
+    if(Cyb_InitObjects())
+    {
+        puts("CybScene test failed.");
+        return 1;
+    }
+    
+    Cyb_JobSystem *jobs = Cyb_CreateJobSystem(-1);
+    
+    if(!jobs)
+    {
+        puts("CybScene test failed.");
+        return 1;
+    }
+    
+    //Run scene graph test
+    puts("\nScene Graph Test\n================");
+    int result = TestCybSceneHierarchy() || TestCybSceneJobs(jobs);
+    Cyb_FreeObject((Cyb_Object**)&jobs);
+    
+    if(result)
+    {
+        puts("CybScene test failed.");
+        return 1;
+    }
+    
+    puts("\nCybScene test succeeded.");
+    return 0;
+}
\ No newline at end of file
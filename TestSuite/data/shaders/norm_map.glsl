@@ -9,12 +9,12 @@ attribute vec3 tangent;
 attribute vec2 uv;
 attribute vec4 group;
 attribute vec4 weight;
+attribute mat4 instanceM;
+attribute mat4 instanceN;
 
 //Matrices
-uniform mat4 m;
 uniform mat4 v;
 uniform mat4 p;
-uniform mat4 n;
 uniform mat4 bones[20];
 
 //Shader Outputs
@@ -36,19 +36,19 @@ void main()
     }
     
     //Calculate final vertex position and texture coords
-    gl_Position = (p * v * m) * tmp;
+    gl_Position = (p * v * instanceM) * tmp;
     texCoord0 = uv;
     
     //Calculate TBN matrix
-    vec3 T = normalize(vec3(m * vec4(tangent, 0.0)));
-    vec3 N = normalize(vec3(m * vec4(norm, 0.0)));
+    vec3 T = normalize(vec3(instanceM * vec4(tangent, 0.0)));
+    vec3 N = normalize(vec3(instanceM * vec4(norm, 0.0)));
     T = normalize(T - dot(T, N) * N);
     vec3 B = cross(N, T);
     TBN = mat3(T, B, N);
     
     //Calculate frag pos and normal
-    fragPos = vec3(m * tmp);
-    normal = mat3(n) * norm;
+    fragPos = vec3(instanceM * tmp);
+    normal = mat3(instanceN) * norm;
 }
 //==================================================================================
 //End Vertex Shader
@@ -136,12 +136,12 @@ attribute vec3 tangent;
 attribute vec2 uv;
 attribute vec4 group;
 attribute vec4 weight;
+attribute mat4 instanceM;
+attribute mat4 instanceN;
 
 //Matrices
-uniform mat4 m;
 uniform mat4 v;
 uniform mat4 p;
-uniform mat4 n;
 uniform mat4 bones[20];
 
 //Shader Outputs
@@ -163,19 +163,19 @@ void main()
     }
     
     //Calculate final vertex position and texture coords
-    gl_Position = (p * v * m) * tmp;
+    gl_Position = (p * v * instanceM) * tmp;
     texCoord0 = uv;
     
     //Calculate TBN matrix
-    vec3 T = normalize(vec3(m * vec4(tangent, 0.0)));
-    vec3 N = normalize(vec3(m * vec4(norm, 0.0)));
+    vec3 T = normalize(vec3(instanceM * vec4(tangent, 0.0)));
+    vec3 N = normalize(vec3(instanceM * vec4(norm, 0.0)));
     T = normalize(T - dot(T, N) * N);
     vec3 B = cross(N, T);
     TBN = mat3(T, B, N);
     
     //Calculate frag pos and normal
-    fragPos = vec3(m * tmp);
-    normal = mat3(n) * norm;
+    fragPos = vec3(instanceM * tmp);
+    normal = mat3(instanceN) * norm;
 }
 //==================================================================================
 //End ES Vertex Shader
@@ -6,12 +6,12 @@
 attribute vec3 pos;
 attribute vec3 norm;
 attribute vec2 uv;
+attribute mat4 instanceM;
+attribute mat4 instanceN;
 
 //Matrices
-uniform mat4 m;
 uniform mat4 v;
 uniform mat4 p;
-uniform mat4 n;
 
 //Shader Outputs
 varying vec2 texCoord0;
@@ -23,11 +23,11 @@ varying vec3 normal;
 //Entry Point
 void main()
 {
-    gl_Position = (p * v * m) * vec4(pos, 1.0);
+    gl_Position = (p * v * instanceM) * vec4(pos, 1.0);
     texCoord0 = vec2(uv.x * 4.0, uv.y * 4.0);
     texCoord1 = uv;
-    fragPos = vec3(m * vec4(pos, 1.0));
-    normal = mat3(n) * norm;
+    fragPos = vec3(instanceM * vec4(pos, 1.0));
+    normal = mat3(instanceN) * norm;
 }
 //==================================================================================
 //End Vertex Shader
@@ -115,12 +115,12 @@ precision mediump float;
 attribute vec3 pos;
 attribute vec3 norm;
 attribute vec2 uv;
+attribute mat4 instanceM;
+attribute mat4 instanceN;
 
 //Matrices
-uniform mat4 m;
 uniform mat4 v;
 uniform mat4 p;
-uniform mat4 n;
 
 //Shader Outputs
 varying vec2 texCoord0;
@@ -132,11 +132,11 @@ varying vec3 normal;
 //Entry Point
 void main()
 {
-    gl_Position = (p * v * m) * vec4(pos, 1.0);
+    gl_Position = (p * v * instanceM) * vec4(pos, 1.0);
     texCoord0 = vec2(uv.x * 4.0, uv.y * 4.0);
     texCoord1 = uv;
-    fragPos = vec3(m * vec4(pos, 1.0));
-    normal = mat3(n) * norm;
+    fragPos = vec3(instanceM * vec4(pos, 1.0));
+    normal = mat3(instanceN) * norm;
 }
 //==================================================================================
 //End ES Vertex Shader
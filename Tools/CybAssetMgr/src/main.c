@@ -2,6 +2,8 @@
 Cybermals Engine - Asset Manager Tool
 */
 
+#include <math.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,6 +17,10 @@ Cybermals Engine - Asset Manager Tool
 #include "CybBone.h"
 #include "CybCommon.h"
 #include "CybMath.h"
+#include "CybMesh.h"
+#include "CybMeshOptimizer.h"
+
+#include "simplify.h"
 
 #define APP_TITLE "Cybermals Engine Asset Manager Tool"
 #define APP_VERSION "1.0.0"
@@ -24,6 +30,12 @@ Cybermals Engine - Asset Manager Tool
     #define FALSE 0
 #endif
 
+#define LOD_MAX_LEVELS 5        //the most levels of detail made per mesh
+#define LOD_MIN_INDICES 96      //the fewest indices a level may have
+#define LOD_MAX_ERROR 0.2f      //the largest error relative to the mesh size
+#define LOD_SCREEN_ERROR 0.001f //the error allowed on screen (1/1000 height)
+#define VCACHE_SIZE 16          //the FIFO vertex cache the stats assume
+
 
 //Constants
 //===========================================================================
@@ -50,7 +62,10 @@ const char *initSQL = "PRAGMA foreign_keys=ON;\n"
 "        uvs BLOB,\n"
 "        index_count INT,\n"
 "        indices BLOB,\n"
-"        has_bones BOOL\n"
+"        has_bones BOOL,\n"
+"        vertex_desc BLOB,\n"
+"        vertex_data BLOB,\n"
+"        lods BLOB\n"
 "    );\n"
 "\n"
 "    CREATE TABLE IF NOT EXISTS textures(\n"
@@ -100,14 +115,31 @@ const char *initSQL = "PRAGMA foreign_keys=ON;\n"
 "        scl_keys BLOB,\n"
 "        CONSTRAINT anim_channels_anim_id FOREIGN KEY(anim_id) REFERENCES animations(id) ON DELETE CASCADE"
 "    );\n"
+"\n"
+"    CREATE TABLE IF NOT EXISTS navmeshes(\n"
+"        id INTEGER PRIMARY KEY,\n"
+"        name varchar(256) UNIQUE,\n"
+"        vert_count INT,\n"
+"        vertices BLOB,\n"
+"        tri_count INT,\n"
+"        triangles BLOB,\n"
+"        neighbors BLOB\n"
+"    );\n"
 "END TRANSACTION;";
 
+const char *upgradeSQL[] = {
+    "ALTER TABLE meshes ADD COLUMN vertex_desc BLOB;",
+    "ALTER TABLE meshes ADD COLUMN vertex_data BLOB;",
+    "ALTER TABLE meshes ADD COLUMN lods BLOB;"
+};
+
 const char *listMeshesSQL = "SELECT name, vert_count, index_count FROM meshes ORDER BY name;";
 const char *listTexturesSQL = "SELECT name, width, height, format FROM textures ORDER BY name;";
 const char *listMaterialsSQL = "SELECT name, ambient, diffuse, specular, shininess FROM materials ORDER BY name;";
 const char *listArmaturesSQL = "SELECT name, vert_count, bone_count FROM armatures ORDER BY name;";
 const char *listAnimationsSQL = "SELECT name, channel_count, ticks_per_sec FROM animations ORDER BY name;";
-const char *addMeshSQL = "INSERT OR REPLACE INTO meshes(name, vert_count, vertices, normals, tangents, colors, uvs, index_count, indices) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);";
+const char *listNavMeshesSQL = "SELECT name, vert_count, tri_count FROM navmeshes ORDER BY name;";
+const char *addMeshSQL = "INSERT OR REPLACE INTO meshes(name, vert_count, vertices, normals, tangents, colors, uvs, index_count, indices, vertex_desc, vertex_data, lods) VALUES (?, ?, NULL, NULL, NULL, NULL, NULL, ?, ?, ?, ?, ?);";
 const char *addTextureSQL = "INSERT OR REPLACE INTO textures(name, width, height, format, data) VALUES (?, ?, ?, ?, ?);";
 const char *addMaterialSQL = "INSERT OR REPLACE INTO materials(name, ambient, diffuse, specular, shininess) VALUES (?, ?, ?, ?, ?);";
 const char *addArmatureSQL = "INSERT OR REPLACE INTO armatures(name, vert_count, vgroups, vweights, bone_count, bones) VALUES (?, ?, ?, ?, ?, ?);";
@@ -190,6 +222,271 @@ int OpenAssetDB(const char *filename)
         return CYB_ERROR;
     }
     
+    //Add new columns to older asset databases (this fails harmlessly if the
+    //columns exist)
+    for(int i = 0; i < (int)(sizeof(upgradeSQL) / sizeof(upgradeSQL[0])); i++)
+    {
+        sqlite3_exec(db, upgradeSQL[i], NULL, NULL, NULL);
+    }
+    
+    return CYB_NO_ERROR;
+}
+
+
+void *InterleaveVertices(struct aiMesh *mesh, const Cyb_Vec2 *uvs,
+    Cyb_VertexDesc *desc, int *vertSize)
+{
+    //Choose the vertex type (colors and uvs are only used with normals)
+    const Cyb_Vec4 *colors = (const Cyb_Vec4*)mesh->mColors[0];
+    memset(desc, 0, sizeof(Cyb_VertexDesc));
+    desc->posScale = 1.0f;
+    
+    if(!mesh->mNormals)
+    {
+        desc->vFormat = CYB_VERTEX_V;
+        *vertSize = sizeof(Cyb_VertexV);
+    }
+    else if(colors && uvs)
+    {
+        desc->vFormat = CYB_VERTEX_VNCT;
+        *vertSize = sizeof(Cyb_VertexVNCT);
+    }
+    else if(colors)
+    {
+        desc->vFormat = CYB_VERTEX_VNC;
+        *vertSize = sizeof(Cyb_VertexVNC);
+    }
+    else if(uvs)
+    {
+        desc->vFormat = CYB_VERTEX_VNT;
+        *vertSize = sizeof(Cyb_VertexVNT);
+    }
+    else
+    {
+        desc->vFormat = CYB_VERTEX_VN;
+        *vertSize = sizeof(Cyb_VertexVN);
+    }
+    
+    //Interleave the vertex data as 32-bit floats (missing tangents are zero)
+    char *data = (char*)calloc(mesh->mNumVertices, *vertSize);
+    
+    if(!data)
+    {
+        return NULL;
+    }
+    
+    for(int i = 0; i < mesh->mNumVertices; i++)
+    {
+        char *vert = data + *vertSize * i;
+        memcpy(vert, &mesh->mVertices[i], sizeof(Cyb_Vec3));
+        
+        if(desc->vFormat == CYB_VERTEX_V)
+        {
+            continue;
+        }
+        
+        memcpy(vert + offsetof(Cyb_VertexVN, norm), &mesh->mNormals[i], 
+            sizeof(Cyb_Vec3));
+        
+        if(mesh->mTangents)
+        {
+            memcpy(vert + offsetof(Cyb_VertexVN, tangent), &mesh->mTangents[i],
+                sizeof(Cyb_Vec3));
+        }
+        
+        switch(desc->vFormat)
+        {
+        case CYB_VERTEX_VNC:
+            memcpy(vert + offsetof(Cyb_VertexVNC, color), &colors[i], 
+                sizeof(Cyb_Vec4));
+            break;
+            
+        case CYB_VERTEX_VNT:
+            memcpy(vert + offsetof(Cyb_VertexVNT, uv), &uvs[i], 
+                sizeof(Cyb_Vec2));
+            break;
+            
+        case CYB_VERTEX_VNCT:
+            memcpy(vert + offsetof(Cyb_VertexVNCT, color), &colors[i], 
+                sizeof(Cyb_Vec4));
+            memcpy(vert + offsetof(Cyb_VertexVNCT, uv), &uvs[i], 
+                sizeof(Cyb_Vec2));
+            break;
+        }
+    }
+    
+    return data;
+}
+
+
+int *GenerateLODs(struct aiMesh *mesh, const int *indices, 
+    Cyb_MeshLOD *lods, int *lodCount, int *indexCount)
+{
+    //Allocate room for the original indices (the buffer grows with each 
+    //level)
+    int count = mesh->mNumFaces * 3;
+    int cap = count;
+    int *lodIndices = (int*)malloc(sizeof(int) * cap);
+    
+    if(!lodIndices)
+    {
+        return NULL;
+    }
+    
+    //The first level is the original mesh
+    memcpy(lodIndices, indices, sizeof(int) * count);
+    lods[0].firstIndex = 0;
+    lods[0].indexCount = count;
+    lods[0].minSize = 0.0f;
+    *lodCount = 1;
+    *indexCount = count;
+    
+    //Measure errors relative to the radius of the mesh
+    struct aiVector3D size;
+    size.x = mesh->mAABB.mMax.x - mesh->mAABB.mMin.x;
+    size.y = mesh->mAABB.mMax.y - mesh->mAABB.mMin.y;
+    size.z = mesh->mAABB.mMax.z - mesh->mAABB.mMin.z;
+    float radius = sqrtf(size.x * size.x + size.y * size.y + size.z * size.z) 
+        * 0.5f;
+    
+    if(radius <= 0.0f)
+    {
+        return lodIndices;
+    }
+    
+    //Halve the triangles of each level until the mesh stops getting smaller
+    while(*lodCount < LOD_MAX_LEVELS)
+    {
+        Cyb_MeshLOD *prev = &lods[*lodCount - 1];
+        Cyb_MeshLOD *lod = &lods[*lodCount];
+        int target = prev->indexCount / 6 * 3;
+        
+        if(target < LOD_MIN_INDICES)
+        {
+            break;
+        }
+        
+        //Make room for a copy of the previous level (the simplifier starts 
+        //from it and often stops above its target at seams and borders)
+        if(*indexCount + prev->indexCount > cap)
+        {
+            cap = *indexCount + prev->indexCount;
+            int *newIndices = (int*)realloc(lodIndices, sizeof(int) * cap);
+            
+            if(!newIndices)
+            {
+                break;
+            }
+            
+            lodIndices = newIndices;
+        }
+        
+        float error;
+        lod->firstIndex = *indexCount;
+        lod->indexCount = SimplifyMesh(&lodIndices[lod->firstIndex], 
+            &lodIndices[prev->firstIndex], prev->indexCount, 
+            (const Cyb_Vec3*)mesh->mVertices, mesh->mNumVertices, target, 
+            LOD_MAX_ERROR * radius, &error);
+        
+        if(lod->indexCount > prev->indexCount * 0.85f ||
+            lod->indexCount < LOD_MIN_INDICES)
+        {
+            break;
+        }
+        
+        //The previous level is needed while the error of this one would 
+        //cover more than the allowed part of the screen
+        float relError = error / radius;
+        prev->minSize = 2.0f * LOD_SCREEN_ERROR / 
+            (relError > 1e-6f ? relError : 1e-6f);
+        
+        if(*lodCount > 1 && prev->minSize > lods[*lodCount - 2].minSize)
+        {
+            prev->minSize = lods[*lodCount - 2].minSize;
+        }
+        
+        lod->minSize = 0.0f;
+        Cyb_OptimizeMeshIndices((unsigned int*)&lodIndices[lod->firstIndex],
+            lod->indexCount, (const Cyb_Vec3*)mesh->mVertices, 
+            mesh->mNumVertices);
+        *indexCount += lod->indexCount;
+        (*lodCount)++;
+    }
+    
+    return lodIndices;
+}
+
+
+void ReorderArray(void *array, void *temp, const int *remap, int size, 
+    int count)
+{
+    //Skip missing arrays
+    if(!array)
+    {
+        return;
+    }
+    
+    for(int i = 0; i < count; i++)
+    {
+        memcpy((char*)temp + size * remap[i], (char*)array + size * i, size);
+    }
+    
+    memcpy(array, temp, size * count);
+}
+
+
+int ReorderVertices(struct aiMesh *mesh, int *indices, int indexCount)
+{
+    //Number the vertices in the order the indices use them
+    int *remap = (int*)malloc(sizeof(int) * mesh->mNumVertices);
+    void *temp = malloc(sizeof(struct aiColor4D) * mesh->mNumVertices);
+    
+    if(!remap || !temp)
+    {
+        free(remap);
+        free(temp);
+        return CYB_ERROR;
+    }
+    
+    Cyb_OptimizeVertexFetch(remap, (unsigned int*)indices, indexCount, 
+        mesh->mNumVertices);
+    
+    //Move the vertex attributes
+    int count = mesh->mNumVertices;
+    ReorderArray(mesh->mVertices, temp, remap, sizeof(struct aiVector3D), 
+        count);
+    ReorderArray(mesh->mNormals, temp, remap, sizeof(struct aiVector3D), 
+        count);
+    ReorderArray(mesh->mTangents, temp, remap, sizeof(struct aiVector3D), 
+        count);
+    ReorderArray(mesh->mBitangents, temp, remap, sizeof(struct aiVector3D), 
+        count);
+    
+    for(int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; i++)
+    {
+        ReorderArray(mesh->mColors[i], temp, remap, sizeof(struct aiColor4D),
+            count);
+    }
+    
+    for(int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; i++)
+    {
+        ReorderArray(mesh->mTextureCoords[i], temp, remap, 
+            sizeof(struct aiVector3D), count);
+    }
+    
+    //Update the vertex weights of the bones
+    for(int i = 0; i < mesh->mNumBones; i++)
+    {
+        struct aiBone *bone = mesh->mBones[i];
+        
+        for(int j = 0; j < bone->mNumWeights; j++)
+        {
+            bone->mWeights[j].mVertexId = remap[bone->mWeights[j].mVertexId];
+        }
+    }
+    
+    free(remap);
+    free(temp);
     return CYB_NO_ERROR;
 }
 
@@ -209,6 +506,7 @@ int ListAssets(void)
     sqlite3_stmt *listMaterialsStmt = NULL;
     sqlite3_stmt *listArmaturesStmt = NULL;
     sqlite3_stmt *listAnimationsStmt = NULL;
+    sqlite3_stmt *listNavMeshesStmt = NULL;
     
     if(sqlite3_prepare_v2(db, listMeshesSQL, -1, &listMeshesStmt, NULL) != 
         SQLITE_OK)
@@ -250,6 +548,17 @@ int ListAssets(void)
         return CYB_ERROR;
     }
     
+    if(sqlite3_prepare_v2(db, listNavMeshesSQL, -1, &listNavMeshesStmt, NULL) !=
+        SQLITE_OK)
+    {
+        sqlite3_finalize(listMeshesStmt);
+        sqlite3_finalize(listTexturesStmt);
+        sqlite3_finalize(listMaterialsStmt);
+        sqlite3_finalize(listArmaturesStmt);
+        sqlite3_finalize(listAnimationsStmt);
+        return CYB_ERROR;
+    }
+    
     //List all meshes
     puts("Meshes");
     puts("======");
@@ -334,12 +643,25 @@ int ListAssets(void)
             sqlite3_column_double(listAnimationsStmt, 2));
     }
     
+    //List all navigation meshes
+    puts("");
+    puts("Navigation Meshes");
+    puts("=================");
+    
+    while(sqlite3_step(listNavMeshesStmt) == SQLITE_ROW)
+    {
+        printf("Name: %s\n", sqlite3_column_text(listNavMeshesStmt, 0));
+        printf("Vertex Count: %i\n", sqlite3_column_int(listNavMeshesStmt, 1));
+        printf("Triangle Count: %i\n\n", sqlite3_column_int(listNavMeshesStmt, 2));
+    }
+    
     //Finalize SQL statements
     sqlite3_finalize(listMeshesStmt);
     sqlite3_finalize(listTexturesStmt);
     sqlite3_finalize(listMaterialsStmt);
     sqlite3_finalize(listArmaturesStmt);
     sqlite3_finalize(listAnimationsStmt);
+    sqlite3_finalize(listNavMeshesStmt);
     return CYB_NO_ERROR;
 }
 
@@ -440,6 +762,52 @@ int AddMeshes(const char *filename)
         struct aiMesh *mesh = scene->mMeshes[i];
         printf("Adding mesh '%s' to asset database...", mesh->mName.data);
         
+        //Convert faces to indices
+        int *indices = (int*)malloc(sizeof(int) * mesh->mNumFaces * 3);
+        
+        if(!indices)
+        {
+            puts("failed");
+            continue;
+        }
+        
+        for(int i = 0; i < mesh->mNumFaces; i++)
+        {
+            indices[i * 3] = mesh->mFaces[i].mIndices[0];
+            indices[i * 3 + 1] = mesh->mFaces[i].mIndices[1];
+            indices[i * 3 + 2] = mesh->mFaces[i].mIndices[2];
+        }
+        
+        //Reorder the triangles for the vertex cache and overdraw
+        float oldACMR = 0.0f;
+        float oldATVR = 0.0f;
+        float newACMR = 0.0f;
+        float newATVR = 0.0f;
+        Cyb_GetVertexCacheStats((unsigned int*)indices, mesh->mNumFaces * 3,
+            mesh->mNumVertices, VCACHE_SIZE, &oldACMR, &oldATVR);
+        Cyb_OptimizeMeshIndices((unsigned int*)indices, mesh->mNumFaces * 3,
+            (const Cyb_Vec3*)mesh->mVertices, mesh->mNumVertices);
+        Cyb_GetVertexCacheStats((unsigned int*)indices, mesh->mNumFaces * 3,
+            mesh->mNumVertices, VCACHE_SIZE, &newACMR, &newATVR);
+        
+        //Generate the levels of detail
+        Cyb_MeshLOD lods[LOD_MAX_LEVELS];
+        int lodCount;
+        int indexCount;
+        int *lodIndices = GenerateLODs(mesh, indices, lods, &lodCount, 
+            &indexCount);
+        free(indices);
+        indices = lodIndices;
+        
+        //Reorder the vertices in the order they are used
+        if(!indices || 
+            ReorderVertices(mesh, indices, indexCount) != CYB_NO_ERROR)
+        {
+            puts("failed");
+            free(indices);
+            continue;
+        }
+        
         //Convert UVs to 2D vectors
         Cyb_Vec2 *uvs = NULL;
         
@@ -451,6 +819,7 @@ int AddMeshes(const char *filename)
             if(!uvs)
             {
                 puts("failed");
+                free(indices);
                 continue;
             }
         
@@ -460,74 +829,45 @@ int AddMeshes(const char *filename)
             }
         }
         
-        //Convert faces to indices
-        int *indices = (int*)malloc(sizeof(int) * mesh->mNumFaces * 3);
+        //Interleave the vertex data so it can be uploaded as it is
+        Cyb_VertexDesc desc;
+        int vertSize;
+        void *vertData = InterleaveVertices(mesh, uvs, &desc, &vertSize);
         
-        if(!indices)
+        if(!vertData)
         {
             puts("failed");
-            free(uvs);
+            
+            if(uvs)
+            {
+                free(uvs);
+            }
+            
+            free(indices);
             continue;
         }
         
-        for(int i = 0; i < mesh->mNumFaces; i++)
-        {
-            indices[i * 3] = mesh->mFaces[i].mIndices[0];
-            indices[i * 3 + 1] = mesh->mFaces[i].mIndices[1];
-            indices[i * 3 + 2] = mesh->mFaces[i].mIndices[2];
-        }
-        
         //Add new mesh
         sqlite3_reset(addMeshStmt);
         sqlite3_bind_text(addMeshStmt, 1, mesh->mName.data, -1, NULL);
         sqlite3_bind_int(addMeshStmt, 2, mesh->mNumVertices);
-        sqlite3_bind_blob(addMeshStmt, 3, mesh->mVertices, 
-            sizeof(Cyb_Vec3) * mesh->mNumVertices, NULL);
-            
-        if(mesh->mNormals)
-        {
-            sqlite3_bind_blob(addMeshStmt, 4, mesh->mNormals,
-                sizeof(Cyb_Vec3) * mesh->mNumVertices, NULL);
-        }
-        else
-        {
-            sqlite3_bind_null(addMeshStmt, 4);
-        }
-        
-        if(mesh->mTangents)
-        {
-            sqlite3_bind_blob(addMeshStmt, 5, mesh->mTangents,
-                sizeof(Cyb_Vec3) * mesh->mNumVertices, NULL);
-        }
-        else
-        {
-            sqlite3_bind_null(addMeshStmt, 5);
-        }
-        
-        if(mesh->mColors[0])
-        {
-            sqlite3_bind_blob(addMeshStmt, 6, mesh->mColors[0],
-                sizeof(Cyb_Vec4) * mesh->mNumVertices, NULL);
-        }
-        else
-        {
-            sqlite3_bind_null(addMeshStmt, 6);
-        }
+        sqlite3_bind_int(addMeshStmt, 3, indexCount);
+        sqlite3_bind_blob(addMeshStmt, 4, indices, sizeof(int) * indexCount, 
+            NULL);
+        sqlite3_bind_blob(addMeshStmt, 5, &desc, sizeof(Cyb_VertexDesc), NULL);
+        sqlite3_bind_blob(addMeshStmt, 6, vertData, 
+            vertSize * mesh->mNumVertices, NULL);
         
-        if(uvs)
+        if(lodCount > 1)
         {
-            sqlite3_bind_blob(addMeshStmt, 7, uvs,
-                sizeof(Cyb_Vec2) * mesh->mNumVertices, NULL);
+            sqlite3_bind_blob(addMeshStmt, 7, lods, 
+                sizeof(Cyb_MeshLOD) * lodCount, NULL);
         }
         else
         {
             sqlite3_bind_null(addMeshStmt, 7);
         }
         
-        sqlite3_bind_int(addMeshStmt, 8, mesh->mNumFaces * 3);
-        sqlite3_bind_blob(addMeshStmt, 9, indices, 
-            sizeof(int) * 3 * mesh->mNumFaces, NULL);
-        
         if(sqlite3_step(addMeshStmt) != SQLITE_DONE)
         {
             puts("failed");
@@ -538,17 +878,20 @@ int AddMeshes(const char *filename)
             }
             
             free(indices);
+            free(vertData);
             continue;
         }
         
-        //Free converted UVs and indices
+        //Free converted UVs, indices, and vertex data
         if(uvs)
         {
             free(uvs);
         }
         
         free(indices);
-        puts("ok");
+        free(vertData);
+        printf("ok (ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %i LODs)\n", 
+            oldACMR, newACMR, oldATVR, newATVR, lodCount);
         
         //Does the mesh have bones?
         if(mesh->mNumBones)
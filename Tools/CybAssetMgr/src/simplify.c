@@ -0,0 +1,630 @@
+/*
+Cybermals Engine - Asset Manager Tool - Mesh Simplifier
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "simplify.h"
+
+#define BORDER_WEIGHT 10.0 //weight of the planes which keep borders in place
+
+
+//Structures
+//===========================================================================
+typedef struct
+{
+    double a2, ab, ac, ad;
+    double b2, bc, bd;
+    double c2, cd;
+    double d2;
+    double weight;
+} Quadric;
+
+
+typedef struct
+{
+    int edge[2];
+    int tri;
+    int count;
+} EdgeSlot;
+
+
+typedef struct
+{
+    int from;
+    int to;
+    double cost;
+} Collapse;
+
+
+typedef struct
+{
+    int *roots;       //the first vertex at the position of each vertex
+    int *remap;       //the vertex each vertex collapses onto during a pass
+    int *adjOffsets;  //the first triangle around each vertex in adjTris
+    int *adjFill;
+    int *adjTris;     //the triangles around each vertex
+    int *marks;
+    char *locked;     //vertices which may not move
+    char *collapsed;  //vertices which took part in a collapse during a pass
+    int *posCounts;
+    Quadric *quadrics;
+    Collapse *collapses;
+} Simplifier;
+
+
+//Functions
+//===========================================================================
+static void AddPlane(Quadric *q, double a, double b, double c, double d,
+    double weight)
+{
+    q->a2 += a * a * weight;
+    q->ab += a * b * weight;
+    q->ac += a * c * weight;
+    q->ad += a * d * weight;
+    q->b2 += b * b * weight;
+    q->bc += b * c * weight;
+    q->bd += b * d * weight;
+    q->c2 += c * c * weight;
+    q->cd += c * d * weight;
+    q->d2 += d * d * weight;
+    q->weight += weight;
+}
+
+
+static void AddQuadric(Quadric *q, const Quadric *r)
+{
+    q->a2 += r->a2;
+    q->ab += r->ab;
+    q->ac += r->ac;
+    q->ad += r->ad;
+    q->b2 += r->b2;
+    q->bc += r->bc;
+    q->bd += r->bd;
+    q->c2 += r->c2;
+    q->cd += r->cd;
+    q->d2 += r->d2;
+    q->weight += r->weight;
+}
+
+
+static double EvalQuadric(const Quadric *q, const Cyb_Vec3 *p)
+{
+    //Returns the weighted sum of squared distances to the planes
+    double x = p->x;
+    double y = p->y;
+    double z = p->z;
+    double e = q->a2 * x * x + 2.0 * q->ab * x * y + 2.0 * q->ac * x * z +
+        2.0 * q->ad * x + q->b2 * y * y + 2.0 * q->bc * y * z +
+        2.0 * q->bd * y + q->c2 * z * z + 2.0 * q->cd * z + q->d2;
+    return e > 0.0 ? e : 0.0;
+}
+
+
+static void TriNormal(double *n, const Cyb_Vec3 *a, const Cyb_Vec3 *b,
+    const Cyb_Vec3 *c)
+{
+    //The length of the normal is twice the area of the triangle
+    double e1[3] = {b->x - a->x, b->y - a->y, b->z - a->z};
+    double e2[3] = {c->x - a->x, c->y - a->y, c->z - a->z};
+    n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+
+static unsigned int HashInts(const unsigned int *ints, int count)
+{
+    unsigned int hash = 2166136261u;
+    
+    for(int i = 0; i < count; i++)
+    {
+        hash = (hash ^ ints[i]) * 16777619u;
+    }
+    
+    return hash;
+}
+
+
+static int TableSize(int count)
+{
+    //A power of 2 at most half full
+    int size = 16;
+    
+    while(size < count * 2)
+    {
+        size *= 2;
+    }
+    
+    return size;
+}
+
+
+static int FindRoots(int *roots, const Cyb_Vec3 *verts, int vertCount)
+{
+    //Vertices with the same position map to the first one of them
+    int size = TableSize(vertCount);
+    int *table = (int*)malloc(sizeof(int) * size);
+    
+    if(!table)
+    {
+        return FALSE;
+    }
+    
+    memset(table, -1, sizeof(int) * size);
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        unsigned int bits[3];
+        memcpy(bits, &verts[i], sizeof(bits));
+        int slot = (int)(HashInts(bits, 3) & (size - 1));
+        
+        while(table[slot] >= 0 &&
+            memcmp(&verts[table[slot]], &verts[i], sizeof(Cyb_Vec3)))
+        {
+            slot = (slot + 1) & (size - 1);
+        }
+        
+        if(table[slot] < 0)
+        {
+            table[slot] = i;
+        }
+        
+        roots[i] = table[slot];
+    }
+    
+    free(table);
+    return TRUE;
+}
+
+
+static int FindBorders(Quadric *quadrics, char *locked, const int *roots,
+    const int *indices, int indexCount, const Cyb_Vec3 *verts)
+{
+    //Count the triangles of each edge between positions
+    int size = TableSize(indexCount);
+    EdgeSlot *table = (EdgeSlot*)malloc(sizeof(EdgeSlot) * size);
+    
+    if(!table)
+    {
+        return FALSE;
+    }
+    
+    memset(table, 0, sizeof(EdgeSlot) * size);
+    
+    for(int i = 0; i < indexCount; i++)
+    {
+        int tri = i / 3;
+        int a = roots[indices[i]];
+        int b = roots[indices[tri * 3 + (i + 1) % 3]];
+        
+        if(a == b)
+        {
+            continue;
+        }
+        
+        unsigned int edge[2] = {a < b ? a : b, a < b ? b : a};
+        int slot = (int)(HashInts(edge, 2) & (size - 1));
+        
+        while(table[slot].count && (table[slot].edge[0] != (int)edge[0] ||
+            table[slot].edge[1] != (int)edge[1]))
+        {
+            slot = (slot + 1) & (size - 1);
+        }
+        
+        table[slot].edge[0] = edge[0];
+        table[slot].edge[1] = edge[1];
+        table[slot].tri = tri;
+        table[slot].count++;
+    }
+    
+    //Edges of a single triangle are borders and edges of more than two are
+    //not manifold, so their vertices stay in place
+    for(int i = 0; i < size; i++)
+    {
+        if(!table[i].count || table[i].count == 2)
+        {
+            continue;
+        }
+        
+        int a = table[i].edge[0];
+        int b = table[i].edge[1];
+        locked[a] = TRUE;
+        locked[b] = TRUE;
+        
+        //Keep the neighbors from pulling the border inwards with a plane
+        //through the edge at a right angle to the triangle
+        const int *tri = &indices[table[i].tri * 3];
+        double n[3];
+        TriNormal(n, &verts[tri[0]], &verts[tri[1]], &verts[tri[2]]);
+        double e[3] = {verts[b].x - verts[a].x, verts[b].y - verts[a].y,
+            verts[b].z - verts[a].z};
+        double p[3] = {e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2],
+            e[0] * n[1] - e[1] * n[0]};
+        double len = sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        
+        if(len <= 0.0)
+        {
+            continue;
+        }
+        
+        p[0] /= len;
+        p[1] /= len;
+        p[2] /= len;
+        double d = -(p[0] * verts[a].x + p[1] * verts[a].y +
+            p[2] * verts[a].z);
+        double weight = (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]) *
+            BORDER_WEIGHT;
+        AddPlane(&quadrics[a], p[0], p[1], p[2], d, weight);
+        AddPlane(&quadrics[b], p[0], p[1], p[2], d, weight);
+    }
+    
+    free(table);
+    return TRUE;
+}
+
+
+static int CompareCollapses(const void *a, const void *b)
+{
+    double costA = ((const Collapse*)a)->cost;
+    double costB = ((const Collapse*)b)->cost;
+    return costA < costB ? -1 : costA > costB;
+}
+
+
+static double GetCollapseCost(const Quadric *quadrics, const int *roots,
+    const Cyb_Vec3 *verts, int from, int to)
+{
+    //Error of the merged quadric at the remaining vertex
+    Quadric q = quadrics[roots[from]];
+    AddQuadric(&q, &quadrics[roots[to]]);
+    double cost = EvalQuadric(&q, &verts[to]);
+    return q.weight > 0.0 ? cost / q.weight : cost;
+}
+
+
+static int HasFlips(const int *indices, const int *remap, const int *adjOffsets,
+    const int *adjTris, const Cyb_Vec3 *verts, int from, int to)
+{
+    //Check whether moving the vertex turns any of its triangles over
+    for(int i = adjOffsets[from]; i < adjOffsets[from + 1]; i++)
+    {
+        const int *tri = &indices[adjTris[i] * 3];
+        int v[3] = {remap[tri[0]], remap[tri[1]], remap[tri[2]]};
+        
+        //Triangles of the edge disappear
+        if(v[0] == to || v[1] == to || v[2] == to ||
+            v[0] == v[1] || v[1] == v[2] || v[0] == v[2])
+        {
+            continue;
+        }
+        
+        double before[3];
+        double after[3];
+        TriNormal(before, &verts[v[0]], &verts[v[1]], &verts[v[2]]);
+        
+        for(int j = 0; j < 3; j++)
+        {
+            v[j] = v[j] == from ? to : v[j];
+        }
+        
+        TriNormal(after, &verts[v[0]], &verts[v[1]], &verts[v[2]]);
+        
+        //Turning a triangle further than about 75 degrees counts as a flip
+        double dot = before[0] * after[0] + before[1] * after[1] +
+            before[2] * after[2];
+        double lenSq = (before[0] * before[0] + before[1] * before[1] +
+            before[2] * before[2]) * (after[0] * after[0] +
+            after[1] * after[1] + after[2] * after[2]);
+        
+        if(dot <= 0.0 || dot * dot < 0.0625 * lenSq)
+        {
+            return TRUE;
+        }
+    }
+    
+    return FALSE;
+}
+
+
+static int BreaksTopology(const int *indices, const int *remap,
+    const int *adjOffsets, const int *adjTris, int *marks, int stamp,
+    int from, int to)
+{
+    //Mark the neighbors of the vertex and count the triangles of the edge
+    int edgeTris = 0;
+    
+    for(int i = adjOffsets[from]; i < adjOffsets[from + 1]; i++)
+    {
+        const int *tri = &indices[adjTris[i] * 3];
+        
+        for(int j = 0; j < 3; j++)
+        {
+            marks[remap[tri[j]]] = stamp;
+        }
+        
+        edgeTris += remap[tri[0]] == to || remap[tri[1]] == to ||
+            remap[tri[2]] == to;
+    }
+    
+    //The vertices may only share the neighbors on the triangles of the edge,
+    //otherwise the collapse would fold the surface onto itself
+    int shared = 0;
+    marks[from] = 0;
+    marks[to] = 0;
+    
+    for(int i = adjOffsets[to]; i < adjOffsets[to + 1]; i++)
+    {
+        const int *tri = &indices[adjTris[i] * 3];
+        
+        for(int j = 0; j < 3; j++)
+        {
+            int v = remap[tri[j]];
+            
+            if(marks[v] == stamp)
+            {
+                marks[v] = 0;
+                shared++;
+            }
+        }
+    }
+    
+    return shared > edgeTris;
+}
+
+
+static int Simplify(Simplifier *sim, int *dest, const int *indices,
+    int indexCount, const Cyb_Vec3 *verts, int vertCount, int targetIndexCount,
+    float maxError, float *error)
+{
+    int *roots = sim->roots;
+    int *remap = sim->remap;
+    int *adjOffsets = sim->adjOffsets;
+    int *adjFill = sim->adjFill;
+    int *adjTris = sim->adjTris;
+    int *marks = sim->marks;
+    char *locked = sim->locked;
+    char *collapsed = sim->collapsed;
+    int *posCounts = sim->posCounts;
+    Quadric *quadrics = sim->quadrics;
+    Collapse *collapses = sim->collapses;
+    int count = indexCount;
+    
+    //Vertices which share their position with others are on a seam of the
+    //normals or texture coordinates and stay in place
+    for(int i = 0; i < vertCount; i++)
+    {
+        posCounts[roots[i]]++;
+    }
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        locked[i] = posCounts[roots[i]] > 1;
+    }
+    
+    //Sum the planes of the triangles around each position weighted by area
+    for(int i = 0; i < indexCount; i += 3)
+    {
+        const Cyb_Vec3 *a = &verts[indices[i]];
+        double n[3];
+        TriNormal(n, a, &verts[indices[i + 1]], &verts[indices[i + 2]]);
+        double len = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        
+        if(len <= 0.0)
+        {
+            continue;
+        }
+        
+        n[0] /= len;
+        n[1] /= len;
+        n[2] /= len;
+        double d = -(n[0] * a->x + n[1] * a->y + n[2] * a->z);
+        
+        for(int j = 0; j < 3; j++)
+        {
+            AddPlane(&quadrics[roots[indices[i + j]]], n[0], n[1], n[2], d,
+                len * 0.5);
+        }
+    }
+    
+    //Lock the borders (the lock of a position applies to its vertices)
+    if(!FindBorders(quadrics, collapsed, roots, indices, indexCount, verts))
+    {
+        return count;
+    }
+    
+    for(int i = 0; i < vertCount; i++)
+    {
+        locked[i] |= collapsed[roots[i]];
+    }
+    
+    //Collapse edges in passes, cheapest first
+    double maxCost = (double)maxError * maxError;
+    double worstCost = 0.0;
+    int stamp = 0;
+    
+    while(count > targetIndexCount)
+    {
+        //Find the triangles around each vertex
+        memset(adjOffsets, 0, sizeof(int) * (vertCount + 1));
+        
+        for(int i = 0; i < count; i++)
+        {
+            adjOffsets[dest[i] + 1]++;
+        }
+        
+        for(int i = 0; i < vertCount; i++)
+        {
+            adjOffsets[i + 1] += adjOffsets[i];
+            adjFill[i] = adjOffsets[i];
+        }
+        
+        for(int i = 0; i < count; i++)
+        {
+            adjTris[adjFill[dest[i]]++] = i / 3;
+        }
+        
+        //Pick the cheaper direction of each edge
+        int collapseCount = 0;
+        
+        for(int i = 0; i < count; i++)
+        {
+            int a = dest[i];
+            int b = dest[i - i % 3 + (i + 1) % 3];
+            double costA = locked[a] ? -1.0 :
+                GetCollapseCost(quadrics, roots, verts, a, b);
+            double costB = locked[b] ? -1.0 :
+                GetCollapseCost(quadrics, roots, verts, b, a);
+            
+            if(a == b || (costA < 0.0 && costB < 0.0))
+            {
+                continue;
+            }
+            
+            Collapse *collapse = &collapses[collapseCount++];
+            int useA = costB < 0.0 || (costA >= 0.0 && costA <= costB);
+            collapse->from = useA ? a : b;
+            collapse->to = useA ? b : a;
+            collapse->cost = useA ? costA : costB;
+        }
+        
+        if(!collapseCount)
+        {
+            break;
+        }
+        
+        qsort(collapses, collapseCount, sizeof(Collapse), &CompareCollapses);
+        
+        //Apply the collapses (each vertex takes part in one per pass)
+        for(int i = 0; i < vertCount; i++)
+        {
+            remap[i] = i;
+            collapsed[i] = FALSE;
+        }
+        
+        int removed = 0;
+        int applied = 0;
+        
+        for(int i = 0; i < collapseCount; i++)
+        {
+            const Collapse *collapse = &collapses[i];
+            int from = collapse->from;
+            int to = collapse->to;
+            
+            if(collapse->cost > maxCost)
+            {
+                break;
+            }
+            
+            if(collapsed[from] || collapsed[to] ||
+                BreaksTopology(dest, remap, adjOffsets, adjTris, marks, ++stamp,
+                from, to) ||
+                HasFlips(dest, remap, adjOffsets, adjTris, verts, from, to))
+            {
+                continue;
+            }
+            
+            //Count the triangles of the edge
+            for(int j = adjOffsets[from]; j < adjOffsets[from + 1]; j++)
+            {
+                const int *tri = &dest[adjTris[j] * 3];
+                
+                if(remap[tri[0]] == to || remap[tri[1]] == to ||
+                    remap[tri[2]] == to)
+                {
+                    removed += 3;
+                }
+            }
+            
+            remap[from] = to;
+            AddQuadric(&quadrics[roots[to]], &quadrics[roots[from]]);
+            collapsed[from] = TRUE;
+            collapsed[to] = TRUE;
+            worstCost = collapse->cost > worstCost ? collapse->cost :
+                worstCost;
+            applied++;
+            
+            if(count - removed <= targetIndexCount)
+            {
+                break;
+            }
+        }
+        
+        if(!applied)
+        {
+            break;
+        }
+        
+        //Rewrite the triangles and drop the ones which collapsed
+        int newCount = 0;
+        
+        for(int i = 0; i < count; i += 3)
+        {
+            int a = remap[dest[i]];
+            int b = remap[dest[i + 1]];
+            int c = remap[dest[i + 2]];
+            
+            if(a != b && b != c && a != c)
+            {
+                dest[newCount++] = a;
+                dest[newCount++] = b;
+                dest[newCount++] = c;
+            }
+        }
+        
+        count = newCount;
+    }
+    
+    *error = (float)sqrt(worstCost);
+    return count;
+}
+
+
+int SimplifyMesh(int *dest, const int *indices, int indexCount,
+    const Cyb_Vec3 *verts, int vertCount, int targetIndexCount,
+    float maxError, float *error)
+{
+    //Start with the original triangles
+    memcpy(dest, indices, sizeof(int) * indexCount);
+    *error = 0.0f;
+    
+    //Allocate the work buffers
+    Simplifier sim;
+    sim.roots = (int*)malloc(sizeof(int) * vertCount);
+    sim.remap = (int*)malloc(sizeof(int) * vertCount);
+    sim.adjOffsets = (int*)malloc(sizeof(int) * (vertCount + 1));
+    sim.adjFill = (int*)malloc(sizeof(int) * vertCount);
+    sim.adjTris = (int*)malloc(sizeof(int) * indexCount);
+    sim.marks = (int*)calloc(vertCount, sizeof(int));
+    sim.locked = (char*)calloc(vertCount, 1);
+    sim.collapsed = (char*)calloc(vertCount, 1);
+    sim.posCounts = (int*)calloc(vertCount, sizeof(int));
+    sim.quadrics = (Quadric*)calloc(vertCount, sizeof(Quadric));
+    sim.collapses = (Collapse*)malloc(sizeof(Collapse) * indexCount);
+    int count = indexCount;
+    
+    if(sim.roots && sim.remap && sim.adjOffsets && sim.adjFill &&
+        sim.adjTris && sim.marks && sim.locked && sim.collapsed &&
+        sim.posCounts && sim.quadrics && sim.collapses &&
+        FindRoots(sim.roots, verts, vertCount))
+    {
+        count = Simplify(&sim, dest, indices, indexCount, verts, vertCount,
+            targetIndexCount, maxError, error);
+    }
+    
+    //Free the work buffers
+    free(sim.roots);
+    free(sim.remap);
+    free(sim.adjOffsets);
+    free(sim.adjFill);
+    free(sim.adjTris);
+    free(sim.marks);
+    free(sim.locked);
+    free(sim.collapsed);
+    free(sim.posCounts);
+    free(sim.quadrics);
+    free(sim.collapses);
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef SIMPLIFY_H
+#define SIMPLIFY_H
+
+/*
+Cybermals Engine - Asset Manager Tool - Mesh Simplifier
+*/
+
+#include "CybMath.h"
+
+
+//Functions
+//===========================================================================
+/* Simplify a triangle mesh with quadric error metrics.
+ *
+ * Edges are collapsed onto one of their vertices, so the result uses the
+ * original vertices and can share their buffer. Vertices on open borders
+ * and on seams (vertices that share their position with others) are kept.
+ * Collapsing stops at the target index count, when the error would exceed
+ * the max error, or when no edge can be collapsed any more. Returns the new
+ * index count and stores the largest error (a distance in mesh units) made.
+ */
+int SimplifyMesh(int *dest, const int *indices, int indexCount,
+    const Cyb_Vec3 *verts, int vertCount, int targetIndexCount,
+    float maxError, float *error);
+
+#endif
\ No newline at end of file